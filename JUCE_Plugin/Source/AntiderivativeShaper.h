@@ -0,0 +1,404 @@
+// AntiderivativeShaper.h - Antiderivative anti-aliasing (ADAA) for static waveshapers
+//
+// Instead of evaluating a curve f at each sample, ADAA outputs the average of f
+// over the straight line joining consecutive inputs, taken from its
+// antiderivative. That average is a continuous-time lowpass applied before
+// sampling, so harmonics above Nyquist are attenuated rather than folded back:
+//  - 1st order:  y = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1])
+//                half a sample of delay; the linear path sees cos(w/2),
+//                about -2 dB at 10 kHz at 48 kHz.
+//  - 2nd order:  a divided difference of divided differences of F2,
+//                one sample of delay and a steeper lowpass of its own,
+//                (1 + 2cos w) / 3, which nulls at fs/3.
+// Either costs a few multiply-adds per sample. At 1x the droop is audible and
+// 1st order is the better trade; at 2x the droop falls above the audio band
+// and 2nd order buys another 10-20 dB over plain 2x oversampling.
+//
+// A curve is anything with shape(x), antiderivative1(x) and antiderivative2(x)
+// in double precision: closed forms where they exist, otherwise an AdaaTable.
+// When a divided difference is ill-conditioned (its inputs closer than
+// kTolerance) the shaper falls back to the average it stands for, taken
+// directly from f or F1 around the midpoint.
+//
+// The distortion engines take an AntialiasingMode and map their Quality onto
+// an AntialiasingPlan (oversampling factor plus ADAA order) with
+// antialiasingForQuality(); Oversampling keeps their legacy behaviour so the
+// two can be compared (tests/harness/AliasingBenchmark.cpp).
+#pragma once
+
+#include "EngineBase.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//==============================================================================
+// A curve tabulated with its first two antiderivatives over [-range, range].
+// Each segment holds the quintic Hermite interpolant of F2 (matching F2, F1
+// and f at both ends); its first and second derivatives then serve as F1 and
+// f, so the three always agree with each other to rounding, which the
+// ill-conditioned branches of the shaper rely on. F1 and F2 are integrated
+// with 5-point Gauss-Legendre per segment and are zero at x = 0. Outside the
+// range f continues along its end slope, which suits curves that have
+// saturated by then.
+//
+// Jump discontinuities are fine as long as they fall on a node (a multiple of
+// 1/resolution): each segment samples f just inside its own ends.
+class AdaaTable {
+public:
+    AdaaTable() = default;
+
+    // Message thread: tabulates curve(double) -> double, allocating
+    // 2 * range * resolution segments of 48 bytes.
+    template <typename Curve>
+    AdaaTable(Curve&& curve, double range, int resolution = 32) {
+        const int half = juce::jmax(1, (int) std::ceil(range * resolution));
+        numSegments = 2 * half;
+        step = 1.0 / resolution;
+        invStep = (double) resolution;
+        lowEdge = -half * step;
+        highEdge = half * step;
+
+        // Node values of F1 and F2, integrated outwards from zero
+        std::vector<double> F1((size_t) numSegments + 1, 0.0), F2((size_t) numSegments + 1, 0.0);
+        for (int k = half; k < numSegments; ++k) {
+            const double a = nodeAt(k), b = nodeAt(k + 1);
+            double area = 0.0, moment = 0.0;
+            integrate(curve, a, b, area, moment);
+            F1[(size_t) k + 1] = F1[(size_t) k] + area;
+            F2[(size_t) k + 1] = F2[(size_t) k] + step * F1[(size_t) k] + (step * area - moment);
+        }
+        for (int k = half; k > 0; --k) {
+            const double a = nodeAt(k - 1), b = nodeAt(k);
+            double area = 0.0, moment = 0.0;
+            integrate(curve, a, b, area, moment);
+            F1[(size_t) k - 1] = F1[(size_t) k] - area;
+            F2[(size_t) k - 1] = F2[(size_t) k] - step * F1[(size_t) k] + moment;
+        }
+
+        segments.resize((size_t) numSegments);
+        const double inside = step * 1.0e-9;
+        for (int k = 0; k < numSegments; ++k) {
+            const double a = nodeAt(k), b = nodeAt(k + 1);
+            const double f0 = curve(a + inside), f1 = curve(b - inside);
+
+            // Quintic Hermite in s = x - a on [0, step]
+            const double h = step;
+            const double A = F2[(size_t) k + 1] - F2[(size_t) k] - F1[(size_t) k] * h - 0.5 * f0 * h * h;
+            const double B = (F1[(size_t) k + 1] - F1[(size_t) k] - f0 * h) * h;
+            const double C = (f1 - f0) * h * h;
+
+            auto& c = segments[(size_t) k].c;
+            c[0] = F2[(size_t) k];
+            c[1] = F1[(size_t) k];
+            c[2] = 0.5 * f0;
+            c[3] = (10.0 * A - 4.0 * B + 0.5 * C) / (h * h * h);
+            c[4] = (-15.0 * A + 7.0 * B - C) / (h * h * h * h);
+            c[5] = (6.0 * A - 3.0 * B + 0.5 * C) / (h * h * h * h * h);
+        }
+
+        // Linear continuation from the end points
+        const double d = step * 1.0e-3;
+        for (int end = 0; end < 2; ++end) {
+            auto& e = ends[end];
+            const double x = end == 0 ? lowEdge : highEdge;
+            const double inwards = end == 0 ? d : -d;
+            e.f = curve(x + (end == 0 ? inside : -inside));
+            e.slope = (curve(x + inwards) - e.f) / inwards;
+            e.F1 = F1[end == 0 ? 0 : (size_t) numSegments];
+            e.F2 = F2[end == 0 ? 0 : (size_t) numSegments];
+            e.x = x;
+        }
+    }
+
+    bool isEmpty() const noexcept { return segments.empty(); }
+    size_t getMemoryBytes() const noexcept { return segments.size() * sizeof(Segment); }
+
+    double shape(double x) const noexcept {
+        if (const auto* e = beyond(x))
+            return e->f + e->slope * (x - e->x);
+        double s;
+        const double* c = locate(x, s);
+        return 2.0 * c[2] + s * (6.0 * c[3] + s * (12.0 * c[4] + s * 20.0 * c[5]));
+    }
+
+    double antiderivative1(double x) const noexcept {
+        if (const auto* e = beyond(x)) {
+            const double d = x - e->x;
+            return e->F1 + d * (e->f + 0.5 * d * e->slope);
+        }
+        double s;
+        const double* c = locate(x, s);
+        return c[1] + s * (2.0 * c[2] + s * (3.0 * c[3] + s * (4.0 * c[4] + s * 5.0 * c[5])));
+    }
+
+    double antiderivative2(double x) const noexcept {
+        if (const auto* e = beyond(x)) {
+            const double d = x - e->x;
+            return e->F2 + d * (e->F1 + d * (0.5 * e->f + d * e->slope * (1.0 / 6.0)));
+        }
+        double s;
+        const double* c = locate(x, s);
+        return c[0] + s * (c[1] + s * (c[2] + s * (c[3] + s * (c[4] + s * c[5]))));
+    }
+
+private:
+    struct Segment { double c[6]; };
+    struct End { double x = 0.0, f = 0.0, slope = 0.0, F1 = 0.0, F2 = 0.0; };
+
+    std::vector<Segment> segments;
+    End ends[2];
+    int numSegments = 0;
+    double step = 1.0, invStep = 1.0, lowEdge = 0.0, highEdge = 0.0;
+
+    double nodeAt(int k) const noexcept { return (k - numSegments / 2) * step; }
+
+    const End* beyond(double x) const noexcept {
+        if (x < lowEdge)   return &ends[0];
+        if (x >= highEdge) return &ends[1];
+        return nullptr;
+    }
+
+    const double* locate(double x, double& s) const noexcept {
+        const int k = juce::jlimit(0, numSegments - 1, (int) ((x - lowEdge) * invStep));
+        s = x - nodeAt(k);
+        return segments[(size_t) k].c;
+    }
+
+    // Integral of f over [a, b] and of (t - a) f(t), by 5-point Gauss-Legendre
+    template <typename Curve>
+    static void integrate(Curve& curve, double a, double b, double& area, double& moment) {
+        static constexpr double nodes[] = { 0.0, 0.5384693101056831, -0.5384693101056831,
+                                            0.9061798459386640, -0.9061798459386640 };
+        static constexpr double weights[] = { 0.5688888888888889, 0.4786286704993665, 0.4786286704993665,
+                                              0.2369268850561891, 0.2369268850561891 };
+        const double half = 0.5 * (b - a), mid = 0.5 * (a + b);
+        area = moment = 0.0;
+        for (int i = 0; i < 5; ++i) {
+            const double t = mid + half * nodes[i];
+            const double f = curve(t) * weights[i] * half;
+            area += f;
+            moment += (t - a) * f;
+        }
+    }
+};
+
+//==============================================================================
+// One channel of ADAA around a curve. The curve is referenced, not owned.
+// Orders 0 (plain), 1 and 2 can be switched on the audio thread; switching
+// re-primes from the next input, so there is no transient from stale history.
+template <typename Curve = AdaaTable>
+class AntiderivativeShaper {
+public:
+    // Below this the divided differences lose more to cancellation (which
+    // grows as 1/d^2 at 2nd order) than the midpoint fallbacks lose to d^2
+    static constexpr double kTolerance = 1.0e-3;
+
+    void setCurve(const Curve& newCurve) noexcept {
+        curve = &newCurve;
+        reset();
+    }
+
+    void setOrder(int newOrder) noexcept {
+        newOrder = juce::jlimit(0, 2, newOrder);
+        if (newOrder != order) {
+            order = newOrder;
+            reset();
+        }
+    }
+
+    int getOrder() const noexcept { return order; }
+
+    // Group delay of the output relative to f(x[n]) at low frequencies
+    double getDelaySamples() const noexcept { return 0.5 * order; }
+
+    void reset() noexcept { primed = false; }
+
+    // Call after the curve's parameters change. The cached antiderivatives at
+    // the previous inputs are re-evaluated, so the next difference is taken
+    // across a single curve instead of across the change.
+    void curveChanged() noexcept {
+        if (!primed || order == 0)
+            return;
+
+        if (order == 1) {
+            F1Previous = curve->antiderivative1(x1);
+        } else {
+            F2Previous = curve->antiderivative2(x1);
+            DPrevious = dividedDifference(x1, F2Previous, x2, curve->antiderivative2(x2));
+        }
+    }
+
+    template <typename Sample>
+    Sample process(Sample input) noexcept {
+        const double x = (double) input;
+        if (order == 0)
+            return (Sample) curve->shape(x);
+
+        if (!primed)
+            prime(x);
+
+        double y;
+        if (order == 1) {
+            const double F1 = curve->antiderivative1(x);
+            const double dx = x - x1;
+            y = std::abs(dx) < kTolerance ? curve->shape(0.5 * (x + x1)) : (F1 - F1Previous) / dx;
+            F1Previous = F1;
+        } else {
+            const double F2 = curve->antiderivative2(x);
+            const double D = dividedDifference(x, F2, x1, F2Previous);
+            const double dx = x - x2;
+            y = std::abs(dx) < kTolerance ? secondOrderFallback(x) : 2.0 * (D - DPrevious) / dx;
+            F2Previous = F2;
+            DPrevious = D;
+        }
+
+        x2 = x1;
+        x1 = x;
+        return (Sample) y;
+    }
+
+private:
+    const Curve* curve = nullptr;
+    int order = 1;
+    bool primed = false;
+    double x1 = 0.0, x2 = 0.0;
+    double F1Previous = 0.0, F2Previous = 0.0, DPrevious = 0.0;
+
+    void prime(double x) noexcept {
+        x1 = x2 = x;
+        F1Previous = curve->antiderivative1(x);
+        F2Previous = curve->antiderivative2(x);
+        DPrevious = F1Previous;
+        primed = true;
+    }
+
+    // (F2(a) - F2(b)) / (a - b), i.e. the mean of F1 over [a, b]. The
+    // difference of two of these is divided by x[n] - x[n-2] again, so the
+    // fallback uses Simpson's rule rather than the midpoint alone.
+    double dividedDifference(double a, double F2a, double b, double F2b) const noexcept {
+        const double d = a - b;
+        if (std::abs(d) >= kTolerance)
+            return (F2a - F2b) / d;
+
+        return (curve->antiderivative1(a) + 4.0 * curve->antiderivative1(0.5 * (a + b))
+                + curve->antiderivative1(b)) * (1.0 / 6.0);
+    }
+
+    // x[n] and x[n-2] coincide: take the limit around their mean instead
+    double secondOrderFallback(double x) const noexcept {
+        const double xBar = 0.5 * (x + x2);
+        const double delta = xBar - x1;
+        if (std::abs(delta) < kTolerance)
+            return curve->shape(0.5 * (xBar + x1));
+
+        return (2.0 / delta) * (curve->antiderivative1(xBar)
+                                + (F2Previous - curve->antiderivative2(xBar)) / delta);
+    }
+};
+
+//==============================================================================
+// How a saturating engine keeps aliasing down
+enum class AntialiasingMode {
+    Oversampling,   // the engine's own oversampling (or none), as before ADAA
+    Antiderivative  // ADAA at 1x, or at 2x on engines that can oversample
+};
+
+struct AntialiasingPlan {
+    int factor = 1;     // oversampling factor
+    int adaaOrder = 0;  // 0 = plain waveshaping
+};
+
+// Oversampling follows PolyphaseOversampler::factorForQuality(). Antiderivative
+// runs 1st order at the base rate up to Normal; engines that can oversample
+// (maxFactor >= 2) go to 2x at High and add the 2nd order at Ultra, where the
+// 2nd-order droop is above the audio band.
+inline AntialiasingPlan antialiasingForQuality(EngineBase::Quality quality, AntialiasingMode mode,
+                                               int maxFactor) noexcept {
+    const bool canOversample = maxFactor >= 2;
+
+    if (mode == AntialiasingMode::Oversampling) {
+        switch (quality) {
+            case EngineBase::Quality::Draft:  return { 1, 0 };
+            case EngineBase::Quality::Normal: return { juce::jmin(2, juce::jmax(1, maxFactor)), 0 };
+            case EngineBase::Quality::High:   return { canOversample ? juce::jmax(2, maxFactor / 2) : 1, 0 };
+            case EngineBase::Quality::Ultra:  break;
+        }
+        return { juce::jmax(1, maxFactor), 0 };
+    }
+
+    switch (quality) {
+        case EngineBase::Quality::Draft:
+        case EngineBase::Quality::Normal: return { 1, 1 };
+        case EngineBase::Quality::High:   return { canOversample ? 2 : 1, 1 };
+        case EngineBase::Quality::Ultra:  break;
+    }
+    return canOversample ? AntialiasingPlan { 2, 2 } : AntialiasingPlan{1, 1};
+}
+
+//==============================================================================
+// Curves more than one engine shapes through
+namespace AdaaCurves {
+    // tanh over +-10, past which it is flat to 2e-9. 30 kB, built on first use,
+    // so call it from prepareToPlay() before the audio thread needs it.
+    inline const AdaaTable& tanh() {
+        static const AdaaTable table([](double x) { return std::tanh(x); }, 10.0);
+        return table;
+    }
+
+    // Triangle fold between a negative and a positive threshold, reflecting
+    // as often as needed, of an input clamped to +-limit. Closed-form, so the
+    // thresholds can move per sample (call curveChanged() on the shaper).
+    //
+    // With u = x - low, width w = high - low and r = u mod 2w, the fold is
+    // low + tri(r); tri has mean w/2 and the periodic parts of its first two
+    // integrals have zero mean, which keeps F1 and F2 free of a growing term
+    // beyond the u^2 one.
+    struct TriangleFold {
+        double low = -1.0, high = 1.0, limit = 2.0;
+
+        void setThresholds(double newLow, double newHigh) noexcept {
+            low = juce::jmin(newLow, -1.0e-3);
+            high = juce::jmax(newHigh, 1.0e-3);
+        }
+
+        double shape(double x) const noexcept {
+            return low + triangle(wrap(juce::jlimit(-limit, limit, x) - low));
+        }
+
+        double antiderivative1(double x) const noexcept {
+            const double c = juce::jlimit(-limit, limit, x);
+            return inner1(c) + shape(c) * (x - c);
+        }
+
+        double antiderivative2(double x) const noexcept {
+            const double c = juce::jlimit(-limit, limit, x);
+            const double d = x - c;
+            return inner2(c) + d * (inner1(c) + 0.5 * d * shape(c));
+        }
+
+    private:
+        double width() const noexcept { return high - low; }
+
+        double wrap(double u) const noexcept {
+            const double period = 2.0 * width();
+            return u - period * std::floor(u / period);
+        }
+
+        double triangle(double r) const noexcept { return r < width() ? r : 2.0 * width() - r; }
+
+        double inner1(double x) const noexcept {
+            const double u = x - low, r = wrap(u), w = width();
+            const double t1 = r < w ? 0.5 * r * r : w * w - 0.5 * (2.0 * w - r) * (2.0 * w - r);
+            return (low + 0.5 * w) * u + t1 - 0.5 * w * r;
+        }
+
+        double inner2(double x) const noexcept {
+            const double u = x - low, r = wrap(u), w = width();
+            const double q = r < w ? r * r * r / 6.0 - 0.25 * w * r * r
+                                   : -w * w * w / 12.0
+                                     + (0.75 * w * r * r - r * r * r / 6.0 - w * w * r)
+                                     - (0.75 - 1.0 / 6.0 - 1.0) * w * w * w;
+            return 0.5 * (low + 0.5 * w) * u * u + q;
+        }
+    };
+}
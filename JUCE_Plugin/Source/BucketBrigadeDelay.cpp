@@ -174,6 +174,12 @@ double BucketBrigadeDelay::calculateClockRate(double delayMs) const {
     return std::clamp(clockRate, MIN_CLOCK_RATE, MAX_CLOCK_RATE);
 }
 
+double BucketBrigadeDelay::getTailLengthSeconds() const noexcept {
+    double delayMs = calculateSyncedDelayTime(m_delayTime->getCurrent(), m_sync->getCurrent());
+    delayMs = std::clamp(delayMs, 20.0, 600.0);
+    return getFeedbackTailSeconds(delayMs * 0.001, m_feedback->getCurrent() * 0.95);
+}
+
 double BucketBrigadeDelay::calculateSyncedDelayTime(double timeParam, double syncParam) const {
     // If sync is enabled (syncParam > 0.5), use tempo-synced delays
     if (syncParam > 0.5 && m_transportInfo.bpm > 0.0) {
@@ -27,6 +27,7 @@ public:
     // Extended EngineBase API
     void setTransportInfo(const TransportInfo& info) override;
     bool supportsFeature(Feature f) const noexcept override;
+    double getTailLengthSeconds() const noexcept override;
     
 private:
     // Professional constants
@@ -2,6 +2,7 @@
 // Copyright (c) 2024 - Ultimate DSP Series
 
 #include "BufferRepeat_Platinum.h"
+#include "ResetHorizon.h"
 #include <cmath>
 #include <algorithm>
 #include <random>
@@ -365,9 +366,27 @@ public:
             if (m_buffer) ALIGNED_FREE(m_buffer);
         }
         
-        void copyBuffer(const float* source, int size) noexcept {
-            std::memcpy(m_buffer, source, size * sizeof(float));
+        // Copies the part of the record ring the current slice can read (its
+        // length or stutter segment, plus the interpolator's taps) to the same
+        // positions here; call after startSlice(). Samples the ring held from
+        // before its last reset come across as silence.
+        void copySlice(const float* source, int size, int sourceWritePos, const ResetHorizon& recorded) noexcept {
             m_bufferSize = size;
+            const int reach = m_playbackMode == PlaybackMode::STUTTER ? std::max(m_sliceLength, m_stutterSegmentLength)
+                                                                      : m_sliceLength;
+            const int span = std::min(size, reach + 4);
+            const int first = std::min(span, size - m_sliceStart);
+            std::memcpy(m_buffer + m_sliceStart, source + m_sliceStart, first * sizeof(float));
+            std::memcpy(m_buffer, source, (span - first) * sizeof(float));
+            
+            if (!recorded.isSettled()) {
+                for (int i = 0; i < span; ++i) {
+                    const int pos = (m_sliceStart + i) % size;
+                    if (!recorded.isFresh(static_cast<size_t>((sourceWritePos - 1 - pos + size) % size))) {
+                        m_buffer[pos] = 0.0f;
+                    }
+                }
+            }
         }
         
         void startSlice(int start, int length, bool reverse, float pitch, float feedback, PlaybackMode mode = PlaybackMode::NORMAL, float rate = 1.0f) noexcept {
@@ -632,8 +651,8 @@ public:
         
     public:
         
+        // m_buffer is refilled by copySlice() before a slice reads it
         void reset() noexcept {
-            if (m_buffer) std::memset(m_buffer, 0, MAX_BUFFER_SAMPLES * sizeof(float));
             m_isPlaying = false;
             m_readPos = 0.0;
             m_repeatCount = 0;
@@ -651,6 +670,7 @@ public:
     // ========================================================================
     struct ChannelState {
         alignas(64) float* recordBuffer{nullptr};
+        ResetHorizon recorded;  // reset() clears the ring lazily
         uint32_t writePos{0};
         uint32_t denormFlushCounter{0};
         
@@ -673,6 +693,10 @@ public:
         
         ChannelState() {
             recordBuffer = static_cast<float*>(ALIGNED_ALLOC(MAX_BUFFER_SAMPLES * sizeof(float), 64));
+            if (recordBuffer) {
+                std::memset(recordBuffer, 0, MAX_BUFFER_SAMPLES * sizeof(float));
+            }
+            recorded.prepare(MAX_BUFFER_SAMPLES);
             for (auto& player : slicePlayers) {
                 player = std::make_unique<UltraSlicePlayer>();
             }
@@ -684,9 +708,7 @@ public:
         }
         
         void reset() {
-            if (recordBuffer) {
-                std::memset(recordBuffer, 0, MAX_BUFFER_SAMPLES * sizeof(float));
-            }
+            recorded.reset();
             writePos = 0;
             denormFlushCounter = 0;
             currentPlayer = 0;
@@ -725,9 +747,9 @@ public:
                 currentPlayer = (currentPlayer + 1) % NUM_PLAYERS;
             }
             
-            player->copyBuffer(recordBuffer, MAX_BUFFER_SAMPLES);
             int sliceStart = (writePos - sliceSize + MAX_BUFFER_SAMPLES) % MAX_BUFFER_SAMPLES;
             player->startSlice(sliceStart, sliceSize, reverse, pitch, feedback, mode, rate);
+            player->copySlice(recordBuffer, MAX_BUFFER_SAMPLES, static_cast<int>(writePos), recorded);
         }
     };
     
@@ -843,6 +865,7 @@ public:
                 // Record to buffer
                 state.recordBuffer[state.writePos] = input;
                 state.writePos = (state.writePos + 1) % MAX_BUFFER_SAMPLES;
+                state.recorded.advance();
                 
                 // Periodic denormal flush for record buffer
                 if ((++state.denormFlushCounter & DENORM_FLUSH_MASK) == 0) {
@@ -54,6 +54,9 @@ public:
     juce::String getParameterName(int index) const override;
     juce::String getName() const override { return "Buffer Repeat Platinum"; }
     
+    // Slices of up to four bars keep repeating at decaying gain
+    double getTailLengthSeconds() const noexcept override { return ChimeraConfig::ENGINE_TAIL_MAX_SECONDS; }
+    
     // Extended parameter interface
     float getParameterValue(int index) const;
     juce::String getParameterText(int index) const;
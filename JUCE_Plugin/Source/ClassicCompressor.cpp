@@ -134,6 +134,13 @@ void ClassicCompressor::process(juce::AudioBuffer<float>& buffer) {
      * - Safe operation with any DAW buffer configuration
      */
     
+    // The lookahead length only changes here, between blocks, and follows the
+    // target rather than the smoother: each new length is reported to the
+    // host as latency and crossfaded in by the sidechain's delay line
+    for (auto& sidechain : m_sidechains) {
+        sidechain.setLookahead(m_lookahead.getTarget(), m_sampleRate);
+    }
+    
     // Get channel pointers with proper mono handling
     float* channelData[2] = { nullptr, nullptr };
     channelData[0] = buffer.getWritePointer(0);
@@ -272,7 +279,6 @@ void ClassicCompressor::processSubBlock(float* left, float* right, int startSamp
     double knee = m_knee.processSubBlock(numSamples);
     double makeupGain = m_makeupGain.processSubBlock(numSamples);
     double mix = m_mix.processSubBlock(numSamples);
-    double lookaheadParam = m_lookahead.processSubBlock(numSamples);
     double autoRelease = m_autoRelease.processSubBlock(numSamples);
     double sidechainParam = m_sidechain.processSubBlock(numSamples);
     
@@ -297,15 +303,12 @@ void ClassicCompressor::processSubBlock(float* left, float* right, int startSamp
     double releaseMs = release;      // Already in ms
     double kneeDb = knee;           // Already in dB
     double makeupDb = makeupGain;   // Already in dB
-    double lookaheadMs = lookaheadParam; // Already in ms
     
     // Pre-compute coefficients for the sub-block
-    bool useLookahead = lookaheadMs > 0.1;
     bool useSidechain = sidechainParam > 0.5;
     
     // Update DSP components
     for (int ch = 0; ch < 2; ++ch) {
-        m_sidechains[ch].setLookahead(lookaheadMs, m_sampleRate);
         m_envelopes[ch].updateCoefficients(attackMs, releaseMs, m_sampleRate);
         m_gainComputers[ch].updateParameters(thresholdDb, ratioValue, kneeDb);
         m_gainSmoothers[ch].setTimes(attackMs, releaseMs, autoRelease, m_sampleRate);
@@ -420,8 +423,14 @@ void ClassicCompressor::processSubBlock(float* left, float* right, int startSamp
         float ratioValue = static_cast<float>(ratio);
         float mixValue = static_cast<float>(mix);
         
-        // Peak detection with stereo link
-        float peak = std::max(std::abs(inputL), std::abs(inputR));
+        // Peak detection with stereo link. The detector sees the window ahead
+        // of the delayed signal the gain is applied to; at zero lookahead the
+        // delay is a passthrough and the window is the current sample.
+        float delayedL, delayedR;
+        float peak = std::max(m_sidechains[0].processLookahead(inputL, delayedL),
+                              m_sidechains[1].processLookahead(inputR, delayedR));
+        inputL = delayedL;
+        inputR = delayedR;
         
         // ADD ENVELOPE DETECTION - this smooths the gain changes
         // Update the envelope follower (RMS detection)
@@ -459,8 +468,7 @@ void ClassicCompressor::processSubBlock(float* left, float* right, int startSamp
         peakGR = std::max(peakGR * 0.9999f, static_cast<float>(gainReductionDb));
         m_peakGainReduction.store(peakGR, std::memory_order_relaxed);
         
-        // Sidechain and lookahead processing disabled due to crash
-        // TODO: Debug and fix sidechain/lookahead implementation
+        // Sidechain filtering is still disabled (see the dead code below)
     }
     
     // Close the processing loop and skip the old problematic code
@@ -629,59 +637,29 @@ void ClassicCompressor::processSubBlock(float* left, float* right, int startSamp
 }
 
 void ClassicCompressor::updateParameters(const std::map<int, float>& params) {
-    // FILE I/O DISABLED FOR TESTING
-    
-    auto it = params.find(0);
-    if (it != params.end()) {
-        float val = it->second;
-        m_threshold.setTarget(juce::jmap(val, 0.0f, 1.0f, -60.0f, 0.0f));
-    }
-    
-    it = params.find(1);
-    if (it != params.end()) {
-        float val = it->second;
-        m_ratio.setTarget(juce::jmap(val, 0.0f, 1.0f, 1.1f, 20.0f));
-    }
-    
-    it = params.find(2);
-    if (it != params.end()) {
-        float val = it->second;
-        m_attack.setTarget(juce::jmap(val, 0.0f, 1.0f, 0.1f, 100.0f));
-    }
-    
-    it = params.find(3);
-    if (it != params.end()) {
-        m_release.setTarget(juce::jmap(it->second, 0.0f, 1.0f, 10.0f, 2000.0f));
-    }
-    
-    it = params.find(4);
-    if (it != params.end()) {
-        m_knee.setTarget(juce::jmap(it->second, 0.0f, 1.0f, 0.0f, 12.0f));
-    }
-    
-    it = params.find(5);
-    if (it != params.end()) {
-        m_makeupGain.setTarget(juce::jmap(it->second, 0.0f, 1.0f, -12.0f, 24.0f));
-    }
-    
-    it = params.find(6);
-    if (it != params.end()) {
-        m_mix.setTarget(it->second); // Mix is already 0-1
-    }
-    
-    it = params.find(7);
-    if (it != params.end()) {
-        m_lookahead.setTarget(juce::jmap(it->second, 0.0f, 1.0f, 0.0f, 10.0f));
-    }
-    
-    it = params.find(8);
-    if (it != params.end()) {
-        m_autoRelease.setTarget(it->second); // Auto-release is 0-1
+    for (const auto& [index, value] : params) {
+        setParameter(index, value);
     }
-    
-    it = params.find(9);
-    if (it != params.end()) {
-        m_sidechain.setTarget(it->second); // Sidechain filter is 0-1
+}
+
+void ClassicCompressor::updateParameterSnapshot(const ParameterSnapshot& snapshot) {
+    // Only the changed parameters are re-mapped
+    snapshot.forEachDirty([this](int index, float value) { setParameter(index, value); });
+}
+
+void ClassicCompressor::setParameter(int index, float value) {
+    switch (index) {
+        case 0: m_threshold.setTarget(juce::jmap(value, 0.0f, 1.0f, -60.0f, 0.0f)); break;
+        case 1: m_ratio.setTarget(juce::jmap(value, 0.0f, 1.0f, 1.1f, 20.0f)); break;
+        case 2: m_attack.setTarget(juce::jmap(value, 0.0f, 1.0f, 0.1f, 100.0f)); break;
+        case 3: m_release.setTarget(juce::jmap(value, 0.0f, 1.0f, 10.0f, 2000.0f)); break;
+        case 4: m_knee.setTarget(juce::jmap(value, 0.0f, 1.0f, 0.0f, 12.0f)); break;
+        case 5: m_makeupGain.setTarget(juce::jmap(value, 0.0f, 1.0f, -12.0f, 24.0f)); break;
+        case 6: m_mix.setTarget(value); break;           // Mix is already 0-1
+        case 7: m_lookahead.setTarget(juce::jmap(value, 0.0f, 1.0f, 0.0f, 10.0f)); break;
+        case 8: m_autoRelease.setTarget(value); break;   // Auto-release is 0-1
+        case 9: m_sidechain.setTarget(value); break;     // Sidechain filter is 0-1
+        default: break;
     }
 }
 
@@ -1,8 +1,10 @@
 #pragma once
 #include "EngineBase.h"
 #include "DspEngineUtilities.h"
+#include "SlidingWindowPeak.h"
 #include <cmath>
 #include <array>
+#include <vector>
 #include <atomic>
 #include <algorithm>
 #include <cstring>
@@ -35,11 +37,15 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void updateParameterSnapshot(const ParameterSnapshot& snapshot) override;
     
     juce::String getName() const override { return "Classic Compressor Pro"; }
     int getNumParameters() const override { return 10; }
     juce::String getParameterName(int index) const override;
     
+    // The lookahead delay; both channels share its length
+    int getLatencySamples() const noexcept override { return m_sidechains[0].getLookaheadSamples(); }
+    
     // Professional metering
     float getGainReduction() const { return m_currentGainReduction.load(std::memory_order_relaxed); }
     float getPeakReduction() const { return m_peakGainReduction.load(std::memory_order_relaxed); }
@@ -54,11 +60,13 @@ public:
 #endif
     
 private:
+    void setParameter(int index, float value);
+    
     // Constants
     static constexpr int SUBBLOCK_SIZE = 32;
     static constexpr int MAX_BLOCK_SIZE = 2048;
     static constexpr int RMS_WINDOW_SIZE = 512;
-    static constexpr int MAX_LOOKAHEAD_SAMPLES = 512;
+    static constexpr double MAX_LOOKAHEAD_MS = 10.0;
     
     // Aligned allocation for SIMD
     template<typename T, size_t Alignment = 32>
@@ -104,6 +112,7 @@ private:
         }
         
         double getCurrentValue() const { return m_current; }
+        float getTarget() const { return m_target.load(std::memory_order_relaxed); }
     };
     
     // ============== OPTIMIZED ENVELOPE FOLLOWER ==============
@@ -190,40 +199,28 @@ private:
         double m_s1 = 0.0, m_s2 = 0.0;
         double m_g = 0.0, m_k = 0.0, m_a0 = 0.0;
         
-        // Pre-allocated lookahead buffer
-        alignas(32) std::array<float, MAX_LOOKAHEAD_SAMPLES> m_lookaheadBuffer;
+        // Lookahead buffer, sized for MAX_LOOKAHEAD_MS in prepare()
+        std::vector<float> m_lookaheadBuffer;
+        int m_bufferSize = 0;
         int m_writeIndex = 0;
         int m_lookaheadSamples = 0;
         
-        // Optimized peak detection with monotonic deque
-        struct PeakDetector {
-            struct Sample { float value; int index; };
-            std::array<Sample, MAX_LOOKAHEAD_SAMPLES> m_deque;
-            int m_front = 0, m_back = 0;
-            
-            void push(float value, int index) {
-                // Remove samples that are smaller than current
-                while (m_back > m_front && m_deque[m_back-1].value <= value) {
-                    m_back--;
-                }
-                m_deque[m_back++] = {value, index};
-            }
-            
-            void removeOld(int oldestValid) {
-                while (m_front < m_back && m_deque[m_front].index < oldestValid) {
-                    m_front++;
-                }
-            }
-            
-            float getPeak() const {
-                return (m_front < m_back) ? m_deque[m_front].value : 0.0f;
-            }
-            
-            void reset() { m_front = m_back = 0; }
-        } m_peakDetector;
+        // A new lookahead is crossfaded in from the old tap rather than
+        // jumped to; the delay itself is always in the signal path
+        static constexpr int LOOKAHEAD_FADE_SAMPLES = 64;
+        int m_targetLookaheadSamples = 0;
+        int m_previousLookaheadSamples = 0;
+        int m_fadeRemaining = 0;
+        
+        // Peak over the lookahead window, amortised O(1) at any length
+        SlidingWindowPeak m_peakDetector;
         
     public:
         void prepare(double sampleRate) {
+            m_bufferSize = static_cast<int>(std::ceil(MAX_LOOKAHEAD_MS * 0.001 * sampleRate)) + 1;
+            m_lookaheadBuffer.assign(static_cast<size_t>(m_bufferSize), 0.0f);
+            m_peakDetector.prepare(m_bufferSize);
+            m_targetLookaheadSamples = std::min(m_targetLookaheadSamples, m_bufferSize - 1);
             reset();
             setHighpass(80.0, sampleRate);
         }
@@ -236,13 +233,17 @@ private:
         }
         
         void setLookahead(double ms, double sampleRate) {
-            m_lookaheadSamples = std::clamp(
+            m_targetLookaheadSamples = std::clamp(
                 static_cast<int>(ms * sampleRate * 0.001),
                 0,
-                MAX_LOOKAHEAD_SAMPLES - 1
+                std::max(0, m_bufferSize - 1)
             );
+            // Window covers the delayed sample and everything newer
+            m_peakDetector.setWindowLength(m_targetLookaheadSamples + 1);
         }
         
+        int getLookaheadSamples() const { return m_targetLookaheadSamples; }
+        
         double processHighpass(double input) {
             // TPT SVF highpass (stable at all frequencies)
             double hp = (input - (2.0 * m_k + m_g) * m_s1 - m_s2) * m_a0;
@@ -256,35 +257,48 @@ private:
         }
         
         float processLookahead(float input, float& delayedOutput) {
+            if (m_bufferSize == 0) {
+                delayedOutput = input;
+                return std::abs(input);
+            }
+            
             // Write to circular buffer
             m_lookaheadBuffer[m_writeIndex] = input;
             
-            // Get delayed sample
-            int delayIndex = (m_writeIndex - m_lookaheadSamples + MAX_LOOKAHEAD_SAMPLES) 
-                           % MAX_LOOKAHEAD_SAMPLES;
-            delayedOutput = m_lookaheadBuffer[delayIndex];
-            
-            // Update peak detector (O(1) amortized)
-            float absInput = std::abs(input);
-            m_peakDetector.push(absInput, m_writeIndex);
-            
-            // Remove samples outside lookahead window
-            int oldestValid = (m_writeIndex - m_lookaheadSamples + MAX_LOOKAHEAD_SAMPLES) 
-                            % MAX_LOOKAHEAD_SAMPLES;
-            m_peakDetector.removeOld(oldestValid);
+            // Get delayed sample, crossfading from the old tap after a change
+            if (m_fadeRemaining == 0 && m_targetLookaheadSamples != m_lookaheadSamples) {
+                m_previousLookaheadSamples = m_lookaheadSamples;
+                m_lookaheadSamples = m_targetLookaheadSamples;
+                m_fadeRemaining = LOOKAHEAD_FADE_SAMPLES;
+            }
+            delayedOutput = readDelayed(m_lookaheadSamples);
+            if (m_fadeRemaining > 0) {
+                const float oldWeight = static_cast<float>(m_fadeRemaining) / LOOKAHEAD_FADE_SAMPLES;
+                delayedOutput += (readDelayed(m_previousLookaheadSamples) - delayedOutput) * oldWeight;
+                --m_fadeRemaining;
+            }
             
             // Advance write position
-            m_writeIndex = (m_writeIndex + 1) % MAX_LOOKAHEAD_SAMPLES;
+            m_writeIndex = (m_writeIndex + 1) % m_bufferSize;
             
-            return m_peakDetector.getPeak();
+            return m_peakDetector.process(std::abs(input));
         }
         
         void reset() {
             m_s1 = m_s2 = 0.0;
             std::fill(m_lookaheadBuffer.begin(), m_lookaheadBuffer.end(), 0.0f);
             m_writeIndex = 0;
+            m_lookaheadSamples = m_targetLookaheadSamples;
+            m_fadeRemaining = 0;
             m_peakDetector.reset();
         }
+        
+    private:
+        float readDelayed(int delay) const {
+            int delayIndex = m_writeIndex - delay;
+            if (delayIndex < 0) delayIndex += m_bufferSize;
+            return m_lookaheadBuffer[delayIndex];
+        }
     };
     
     // ============== GAIN COMPUTER ==============
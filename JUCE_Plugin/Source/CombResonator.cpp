@@ -7,40 +7,47 @@
 //==============================================================================
 // ProfessionalCombFilter Implementation
 //==============================================================================
-CombResonator::ProfessionalCombFilter::ProfessionalCombFilter() {
-    delayLine.fill(0.0f);
-}
-
 void CombResonator::ProfessionalCombFilter::init(int maxDelay) {
-    // Already allocated with MAX_DELAY_SAMPLES
+    int size = 1;
+    while (size < maxDelay) size <<= 1;
+    delayLine.assign(static_cast<size_t>(size), 0.0f);
+    horizon.prepare(delayLine.size());
+    mask = size - 1;
+    maxDelayTime = static_cast<float>(maxDelay - 4);
+    delayTime = std::min(delayTime, maxDelayTime);
     reset();
 }
 
 void CombResonator::ProfessionalCombFilter::setDelay(float samples) {
-    delayTime = std::clamp(samples, 1.0f, static_cast<float>(MAX_DELAY_SAMPLES - 4));
+    delayTime = std::clamp(samples, 1.0f, std::max(1.0f, maxDelayTime));
 }
 
 float CombResonator::ProfessionalCombFilter::process(float input) noexcept {
-    if (delayTime < 1.0f) return input;
+    if (delayTime < 1.0f || delayLine.empty()) return input;
     
     // Calculate integer and fractional parts
     int delaySamples = static_cast<int>(delayTime);
     float fraction = delayTime - delaySamples;
     
     // Read positions for interpolation
-    int readPos = writePos - delaySamples;
-    if (readPos < 0) readPos += MAX_DELAY_SAMPLES;
+    int readPos = (writePos - delaySamples) & mask;
     
     // Get samples for interpolation
-    int pos0 = (readPos - 1 + MAX_DELAY_SAMPLES) % MAX_DELAY_SAMPLES;
+    int pos0 = (readPos - 1) & mask;
     int pos1 = readPos;
-    int pos2 = (readPos + 1) % MAX_DELAY_SAMPLES;
-    int pos3 = (readPos + 2) % MAX_DELAY_SAMPLES;
+    int pos2 = (readPos + 1) & mask;
+    int pos3 = (readPos + 2) & mask;
     
     float y0 = delayLine[pos0];
     float y1 = delayLine[pos1];
     float y2 = delayLine[pos2];
     float y3 = delayLine[pos3];
+    if (!horizon.isSettled()) {
+        y0 = readSinceReset(pos0);
+        y1 = readSinceReset(pos1);
+        y2 = readSinceReset(pos2);
+        y3 = readSinceReset(pos3);
+    }
     
     // Hermite interpolation for smooth fractional delays
     float delayed = interpolate(fraction, y0, y1, y2, y3);
@@ -56,13 +63,14 @@ float CombResonator::ProfessionalCombFilter::process(float input) noexcept {
     delayLine[writePos] = DSPUtils::flushDenorm(output);
     
     // Update write position
-    writePos = (writePos + 1) % MAX_DELAY_SAMPLES;
+    writePos = (writePos + 1) & mask;
+    horizon.advance();
     
     return output;
 }
 
 void CombResonator::ProfessionalCombFilter::reset() {
-    delayLine.fill(0.0f);
+    horizon.reset();
     dampingState = 0.0f;
     writePos = 0;
 }
@@ -70,15 +78,17 @@ void CombResonator::ProfessionalCombFilter::reset() {
 //==============================================================================
 // ChannelState Implementation
 //==============================================================================
-void CombResonator::ChannelState::init() {
+void CombResonator::ChannelState::init(int maxDelay) {
     for (auto& comb : combs) {
-        comb.init(MAX_DELAY_SAMPLES);
+        comb.init(maxDelay);
     }
     
     // Initialize harmonic gains with natural rolloff
     for (int i = 0; i < NUM_COMBS; ++i) {
         harmonicGains[i] = 1.0f / std::sqrt(static_cast<float>(i + 1));
     }
+    
+    reset();
 }
 
 void CombResonator::ChannelState::reset() {
@@ -106,11 +116,8 @@ CombResonator::CombResonator() {
     m_stereoWidth.setImmediate(0.5f);
     m_mix.setImmediate(0.5f);
     
-    // Initialize with 2 channels
+    // 2 channels; delay lines are sized in prepareToPlay
     m_channels.resize(2);
-    for (auto& channel : m_channels) {
-        channel.init();
-    }
 }
 
 void CombResonator::prepareToPlay(double sampleRate, int samplesPerBlock) {
@@ -129,9 +136,9 @@ void CombResonator::prepareToPlay(double sampleRate, int samplesPerBlock) {
     m_stereoWidth.setRate(rate);
     m_mix.setRate(rate);
     
-    // Initialize channels
+    // Initialize channels, with delay lines for this sample rate
     for (int ch = 0; ch < m_channels.size(); ++ch) {
-        m_channels[ch].reset();
+        m_channels[ch].init(maxDelaySamples(sampleRate));
         // Offset phases for stereo
         m_channels[ch].lfoPhase = ch * M_PI;
         m_channels[ch].chorusPhase = ch * M_PI * 0.5f;
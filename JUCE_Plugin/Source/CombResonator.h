@@ -1,6 +1,7 @@
 #pragma once
 #include "EngineBase.h"
 #include "DspEngineUtilities.h"
+#include "ResetHorizon.h"
 #include <vector>
 #include <array>
 #include <memory>
@@ -8,20 +9,6 @@
 #include <algorithm>
 #include <atomic>
 
-// Simple aligned array template - use namespace to avoid conflicts
-namespace CombResonatorImpl {
-template<typename T, size_t N, size_t Alignment = 32>
-struct AlignedArray {
-    alignas(Alignment) std::array<T, N> data;
-    
-    T& operator[](size_t i) { return data[i]; }
-    const T& operator[](size_t i) const { return data[i]; }
-    
-    void fill(const T& value) { data.fill(value); }
-    void clear() { data.fill(T{}); }
-};
-}
-
 class CombResonator : public EngineBase {
 public:
     CombResonator();
@@ -36,16 +23,21 @@ public:
     int getNumParameters() const override { return 8; }
     juce::String getParameterName(int index) const override;
     
+    // Decay is an RT60, scaled to the -80 dB tail threshold
+    double getTailLengthSeconds() const noexcept override {
+        const double tail = m_decayTime.current * (-ChimeraConfig::ENGINE_TAIL_THRESHOLD_DB / 60.0) + 1.0 / MIN_FREQ;
+        return std::min(tail, static_cast<double>(ChimeraConfig::ENGINE_TAIL_MAX_SECONDS));
+    }
+    
 private:
     static constexpr int NUM_COMBS = 8;
-    static constexpr int MAX_DELAY_SAMPLES = 96000; // 2 seconds at 48kHz
     static constexpr float MIN_FREQ = 20.0f;
     static constexpr float MAX_FREQ = 20000.0f;
     
     // Professional comb filter with interpolation and modulation
     class ProfessionalCombFilter {
     public:
-        ProfessionalCombFilter();
+        ProfessionalCombFilter() = default;
         void init(int maxDelay);
         void setDelay(float samples);
         void setFeedback(float fb) { feedback = clampSafe(fb, -0.95f, 0.95f); }
@@ -55,7 +47,12 @@ private:
         void reset();
         
     private:
-        CombResonatorImpl::AlignedArray<float, MAX_DELAY_SAMPLES, 64> delayLine;
+        // Power-of-two ring sized in prepareToPlay for the longest comb the
+        // sample rate allows (one period of MIN_FREQ)
+        std::vector<float> delayLine;
+        ResetHorizon horizon;  // reset() clears lazily
+        int mask = 0;
+        float maxDelayTime = 0.0f;
         float feedback = 0.0f;
         float feedforward = 1.0f;
         float damping = 0.0f;
@@ -63,6 +60,11 @@ private:
         float delayTime = 0.0f;
         int writePos = 0;
         
+        // A tap, or silence if its position predates the last reset()
+        float readSinceReset(int pos) const noexcept {
+            return horizon.isFresh(static_cast<size_t>((writePos - 1 - pos) & mask)) ? delayLine[pos] : 0.0f;
+        }
+        
         // Hermite interpolation for fractional delays
         inline float interpolate(float frac, float y0, float y1, float y2, float y3) noexcept {
             float c0 = y1;
@@ -120,7 +122,7 @@ private:
         // Soft clipping state
         float clipState = 0.0f;
         
-        void init();
+        void init(int maxDelay);
         void reset();
     };
     
@@ -164,6 +166,11 @@ private:
     };
     
     // Helper functions
+    static int maxDelaySamples(double sampleRate) noexcept {
+        // One period of the lowest comb plus the interpolator's taps
+        return static_cast<int>(std::ceil(sampleRate / MIN_FREQ)) + 4;
+    }
+    
     static float frequencyToDelay(float freq, double sampleRate) noexcept {
         return static_cast<float>(sampleRate) / std::max(freq, MIN_FREQ);
     }
@@ -0,0 +1,493 @@
+#include "ConvolutionIRCache.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+
+namespace {
+    // Longest IR each tier convolves; Ultra keeps the full response
+    double getMaxIRSeconds(EngineBase::Quality q) {
+        switch (q) {
+            case EngineBase::Quality::Draft:  return 1.0;
+            case EngineBase::Quality::Normal: return 2.0;
+            case EngineBase::Quality::High:   return 3.5;
+            case EngineBase::Quality::Ultra:  break;
+        }
+        return 0.0;
+    }
+
+    int toStep(float value) {
+        return juce::jlimit(0, ConvolutionIRCache::Settings::STEPS,
+                            juce::roundToInt(value * ConvolutionIRCache::Settings::STEPS));
+    }
+}
+
+//==============================================================================
+// Settings
+//==============================================================================
+
+ConvolutionIRCache::Settings ConvolutionIRCache::Settings::fromParameters(
+    float irSelect, float size, float damping, float reverse, float earlyLate, EngineBase::Quality quality) noexcept {
+
+    Settings settings;
+    settings.irIndex = std::clamp(static_cast<int>(irSelect * 3.99f), 0, 3);
+    settings.reversed = reverse > 0.5f;
+    settings.size = toStep(size);
+    settings.damping = toStep(damping);
+    settings.earlyLate = toStep(earlyLate);
+    settings.quality = quality;
+    return settings;
+}
+
+uint32_t ConvolutionIRCache::Settings::pack() const noexcept {
+    return (uint32_t) irIndex
+         | (uint32_t) (reversed ? 1 : 0) << 2
+         | (uint32_t) size << 3
+         | (uint32_t) damping << 8
+         | (uint32_t) earlyLate << 13
+         | (uint32_t) quality << 18;
+}
+
+ConvolutionIRCache::Settings ConvolutionIRCache::Settings::unpack(uint32_t packed) noexcept {
+    Settings settings;
+    settings.irIndex = (int) (packed & 3);
+    settings.reversed = ((packed >> 2) & 1) != 0;
+    settings.size = (int) ((packed >> 3) & 31);
+    settings.damping = (int) ((packed >> 8) & 31);
+    settings.earlyLate = (int) ((packed >> 13) & 31);
+    settings.quality = (EngineBase::Quality) ((packed >> 18) & 3);
+    return settings;
+}
+
+//==============================================================================
+// Request
+//==============================================================================
+
+void ConvolutionIRCache::Request::post(const Settings& settings) noexcept {
+    requested.store(settings.pack(), std::memory_order_release);
+    if (cache != nullptr) {
+        cache->m_loader->wake.signal();
+    }
+}
+
+ConvolutionIRCache::IRPtr ConvolutionIRCache::Request::collect() noexcept {
+    // The loader holds the lock only to swap the pointer; try again next block
+    IRPtr ir;
+    if (readyLock.tryEnter()) {
+        ir = std::move(ready);
+        readyLock.exit();
+    }
+    return ir;
+}
+
+//==============================================================================
+// ConvolutionIRCache
+//==============================================================================
+
+std::shared_ptr<ConvolutionIRCache> ConvolutionIRCache::getShared() {
+    static juce::CriticalSection lock;
+    static std::weak_ptr<ConvolutionIRCache> instance;
+
+    const juce::ScopedLock sl(lock);
+    auto cache = instance.lock();
+    if (!cache) {
+        cache.reset(new ConvolutionIRCache());
+        instance = cache;
+    }
+    return cache;
+}
+
+ConvolutionIRCache::ConvolutionIRCache() {
+    m_loader = std::make_unique<Loader>(*this);
+    m_loader->startThread();
+}
+
+ConvolutionIRCache::~ConvolutionIRCache() {
+    m_loader->signalThreadShouldExit();
+    m_loader->wake.signal();
+    m_loader->stopThread(5000);
+}
+
+ConvolutionIRCache::IRPtr ConvolutionIRCache::get(const Settings& settings, double sampleRate) {
+    const uint32_t key = settings.pack();
+
+    {
+        const juce::ScopedLock sl(m_entriesLock);
+        for (auto& entry : m_entries) {
+            if (entry.settings == key && entry.sampleRate == sampleRate) {
+                entry.lastUsed = ++m_useCounter;
+                return entry.ir;
+            }
+        }
+    }
+
+    // Build without the lock so lookups of other entries aren't held up
+    IRPtr ir = std::make_shared<const PartitionedImpulseResponse>(synthesize(settings, sampleRate), 2);
+
+    {
+        const juce::ScopedLock sl(m_entriesLock);
+
+        // Another thread may have built the same one meanwhile
+        for (auto& entry : m_entries) {
+            if (entry.settings == key && entry.sampleRate == sampleRate) {
+                entry.lastUsed = ++m_useCounter;
+                return entry.ir;
+            }
+        }
+
+        m_entries.push_back({ key, sampleRate, ir, ++m_useCounter });
+    }
+
+    evictUnused();
+    return ir;
+}
+
+void ConvolutionIRCache::evictUnused() {
+    std::vector<IRPtr> evicted;  // Freed after the lock is released
+
+    const juce::ScopedLock sl(m_entriesLock);
+
+    // An entry only the cache holds can't gain a reference except through
+    // get(), which takes this lock
+    std::vector<size_t> unused;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].ir.use_count() == 1) unused.push_back(i);
+    }
+    if (unused.size() <= MAX_UNUSED_ENTRIES) return;
+
+    // Keep the most recently used
+    std::sort(unused.begin(), unused.end(), [this](size_t a, size_t b) {
+        return m_entries[a].lastUsed > m_entries[b].lastUsed;
+    });
+    unused.erase(unused.begin(), unused.begin() + (std::ptrdiff_t) MAX_UNUSED_ENTRIES);
+    std::sort(unused.rbegin(), unused.rend());
+
+    for (size_t i : unused) {
+        evicted.push_back(std::move(m_entries[i].ir));
+        m_entries.erase(m_entries.begin() + (std::ptrdiff_t) i);
+    }
+}
+
+size_t ConvolutionIRCache::getNumCachedIRs() const {
+    const juce::ScopedLock sl(m_entriesLock);
+    return m_entries.size();
+}
+
+void ConvolutionIRCache::attach(Request& request, double sampleRate, const Settings& settings) {
+    const juce::ScopedLock sl(m_requestsLock);
+
+    request.cache = this;
+    request.sampleRate = sampleRate;
+    request.generation++;
+    request.requested.store(settings.pack(), std::memory_order_relaxed);
+    request.delivered = settings.pack();
+    {
+        const juce::SpinLock::ScopedLockType lock(request.readyLock);
+        request.ready.reset();
+    }
+
+    if (std::find(m_requests.begin(), m_requests.end(), &request) == m_requests.end()) {
+        m_requests.push_back(&request);
+    }
+}
+
+void ConvolutionIRCache::detach(Request& request) {
+    const juce::ScopedLock sl(m_requestsLock);
+    m_requests.erase(std::remove(m_requests.begin(), m_requests.end(), &request), m_requests.end());
+}
+
+bool ConvolutionIRCache::serviceNextRequest() {
+    Request* request = nullptr;
+    uint32_t settings = 0, generation = 0;
+    double sampleRate = 0.0;
+
+    {
+        const juce::ScopedLock sl(m_requestsLock);
+        for (auto* candidate : m_requests) {
+            const uint32_t requested = candidate->requested.load(std::memory_order_acquire);
+            if (requested != candidate->delivered) {
+                request = candidate;
+                settings = requested;
+                generation = candidate->generation;
+                sampleRate = candidate->sampleRate;
+                break;
+            }
+        }
+    }
+    if (request == nullptr) return false;
+
+    IRPtr ir = get(Settings::unpack(settings), sampleRate);
+
+    // Deliver unless the reverb was detached or re-prepared meanwhile. An IR
+    // it never collected is replaced, and released here rather than on the
+    // audio thread.
+    IRPtr replaced;
+    {
+        const juce::ScopedLock sl(m_requestsLock);
+        if (std::find(m_requests.begin(), m_requests.end(), request) == m_requests.end()
+            || request->generation != generation) {
+            return true;
+        }
+
+        const juce::SpinLock::ScopedLockType lock(request->readyLock);
+        replaced = std::exchange(request->ready, std::move(ir));
+        request->delivered = settings;
+    }
+    return true;
+}
+
+void ConvolutionIRCache::Loader::run() {
+    while (!threadShouldExit()) {
+        if (!owner.serviceNextRequest()) {
+            owner.evictUnused();
+            wake.wait(500);
+        }
+    }
+}
+
+//==============================================================================
+// IR synthesis
+//==============================================================================
+
+juce::AudioBuffer<float> ConvolutionIRCache::synthesize(const Settings& settings, double sampleRate) {
+    const float sizeParam = (float) settings.size / Settings::STEPS;
+    const float dampingParam = (float) settings.damping / Settings::STEPS;
+    const float earlyLateParam = (float) settings.earlyLate / Settings::STEPS;
+
+    // Generate algorithmic IR
+    juce::AudioBuffer<float> processedIR = generateAlgorithmicIR(settings.irIndex, sampleRate);
+
+    // DIAGNOSTIC: Validate IR after generation
+    float initialPeak = processedIR.getMagnitude(0, processedIR.getNumSamples());
+    float initialRMS = processedIR.getRMSLevel(0, 0, processedIR.getNumSamples());
+
+    if (initialPeak < 0.0001f || initialRMS < 0.00001f) {
+        DBG("ConvolutionReverb ERROR: Generated IR is too weak or empty! Peak=" << initialPeak << ", RMS=" << initialRMS);
+        // Generate a simple impulse as fallback
+        processedIR.clear();
+        processedIR.setSample(0, 0, 0.5f);
+        processedIR.setSample(1, 0, 0.5f);
+    }
+
+    // Apply size parameter (truncate or full)
+    int targetSize = static_cast<int>(processedIR.getNumSamples() * sizeParam);
+    targetSize = std::max(1024, targetSize); // Minimum size
+
+    const double maxSeconds = getMaxIRSeconds(settings.quality);
+    if (maxSeconds > 0.0) {
+        targetSize = std::min(targetSize, std::max(1024, static_cast<int>(maxSeconds * sampleRate)));
+    }
+
+    if (targetSize < processedIR.getNumSamples()) {
+        // Apply fade out before truncating
+        int fadeLength = std::min(512, targetSize / 4);
+        for (int ch = 0; ch < processedIR.getNumChannels(); ch++) {
+            float* data = processedIR.getWritePointer(ch);
+            for (int i = 0; i < fadeLength; i++) {
+                int pos = targetSize - fadeLength + i;
+                float gain = 1.0f - (float)i / fadeLength;
+                data[pos] *= gain * gain;
+            }
+        }
+        processedIR.setSize(processedIR.getNumChannels(), targetSize, true);
+    }
+
+    // Apply damping (lowpass filter to reduce high frequencies in IR)
+    if (dampingParam > 0.01f) {
+        for (int ch = 0; ch < processedIR.getNumChannels(); ch++) {
+            float* data = processedIR.getWritePointer(ch);
+
+            // Coefficient increases with damping (more filtering)
+            float coeff = 0.5f + (dampingParam * 0.49f); // 0.5 to 0.99
+            float state = data[0];
+
+            for (int i = 1; i < processedIR.getNumSamples(); i++) {
+                state = data[i] * (1.0f - coeff) + state * coeff;
+                data[i] = state;
+            }
+        }
+    }
+
+    // Apply early/late balance
+    int earlySize = static_cast<int>(0.08f * sampleRate); // First 80ms
+    float earlyGain = 1.0f + (1.0f - earlyLateParam);
+    float lateGain = 1.0f + earlyLateParam;
+
+    for (int ch = 0; ch < processedIR.getNumChannels(); ch++) {
+        float* data = processedIR.getWritePointer(ch);
+        for (int i = 0; i < processedIR.getNumSamples(); i++) {
+            if (i < earlySize) {
+                data[i] *= earlyGain;
+            } else {
+                data[i] *= lateGain;
+            }
+        }
+    }
+
+    // Apply reverse if needed
+    if (settings.reversed) {
+        for (int ch = 0; ch < processedIR.getNumChannels(); ch++) {
+            float* data = processedIR.getWritePointer(ch);
+            std::reverse(data, data + processedIR.getNumSamples());
+
+            // Apply fade-in to avoid click
+            int fadeInSamples = std::min(256, processedIR.getNumSamples() / 4);
+            for (int i = 0; i < fadeInSamples; i++) {
+                float fade = (float)i / fadeInSamples;
+                data[i] *= fade * fade;
+            }
+        }
+    }
+
+    // FINAL VALIDATION: Check IR before loading
+    float finalPeak = processedIR.getMagnitude(0, processedIR.getNumSamples());
+
+    // Count non-zero samples to ensure IR has content
+    int nonZeroCount = 0;
+    for (int ch = 0; ch < processedIR.getNumChannels(); ch++) {
+        const float* data = processedIR.getReadPointer(ch);
+        for (int i = 0; i < processedIR.getNumSamples(); i++) {
+            if (std::abs(data[i]) > 0.0001f) {
+                nonZeroCount++;
+            }
+        }
+    }
+
+    if (finalPeak < 0.0001f || nonZeroCount < 100) {
+        DBG("ConvolutionReverb ERROR: Final IR is destroyed! Using emergency impulse.");
+        // Emergency fallback - create simple but valid IR
+        processedIR.clear();
+        // Create a simple exponential decay
+        for (int ch = 0; ch < processedIR.getNumChannels(); ch++) {
+            float* data = processedIR.getWritePointer(ch);
+            data[0] = 0.8f; // Initial impulse
+            for (int i = 1; i < std::min(4800, processedIR.getNumSamples()); i++) {
+                data[i] = data[i-1] * 0.9995f; // Simple decay
+            }
+        }
+    }
+
+    return processedIR;
+}
+
+juce::AudioBuffer<float> ConvolutionIRCache::generateAlgorithmicIR(int type, double sr) {
+    // Generate different IR characteristics based on type
+    int irLength = 0;
+    float decay = 0.0f;
+    float density = 0.0f;
+    float brightness = 0.0f;
+
+    switch (type) {
+        case 0: // Concert Hall
+            irLength = static_cast<int>(sr * 3.0); // 3 seconds
+            decay = 0.95f;
+            density = 0.8f;
+            brightness = 0.7f;
+            break;
+        case 1: // EMT Plate
+            irLength = static_cast<int>(sr * 2.0); // 2 seconds
+            decay = 0.93f;
+            density = 0.95f;
+            brightness = 0.9f;
+            break;
+        case 2: // Stairwell
+            irLength = static_cast<int>(sr * 4.0); // 4 seconds
+            decay = 0.96f;
+            density = 0.6f;
+            brightness = 0.5f;
+            break;
+        case 3: // Cloud Chamber
+            irLength = static_cast<int>(sr * MAX_IR_SECONDS); // 5 seconds
+            decay = 0.97f;
+            density = 0.7f;
+            brightness = 0.6f;
+            break;
+        default:
+            irLength = static_cast<int>(sr * 2.0);
+            decay = 0.94f;
+            density = 0.7f;
+            brightness = 0.7f;
+    }
+
+    // Create stereo IR buffer
+    juce::AudioBuffer<float> ir(2, irLength);
+    ir.clear();
+
+    std::mt19937 rng(type + 12345); // Seed for reproducibility
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+
+    // Generate early reflections (first 100ms)
+    int earlyLength = static_cast<int>(0.1 * sr);
+    int numEarlyReflections = static_cast<int>(density * 20);
+
+    for (int i = 0; i < numEarlyReflections; i++) {
+        int delay = static_cast<int>((earlyLength * i) / numEarlyReflections);
+        float gain = std::pow(0.8f, i) * 0.5f;
+
+        // Add to both channels with slight variation
+        if (delay < irLength) {
+            ir.setSample(0, delay, ir.getSample(0, delay) + gain * dist(rng));
+            ir.setSample(1, delay, ir.getSample(1, delay) + gain * dist(rng));
+        }
+    }
+
+    // Generate late reverb tail using exponential decay with noise
+    float decayRate = -std::log(0.001f) / irLength; // Decay to -60dB
+
+    for (int ch = 0; ch < 2; ch++) {
+        float* data = ir.getWritePointer(ch);
+
+        // Start from after early reflections
+        for (int i = earlyLength; i < irLength; i++) {
+            float envelope = std::exp(-decayRate * i * (2.0f - decay));
+            float noise = dist(rng) * 0.1f;
+
+            // Apply density modulation
+            if ((i % static_cast<int>(10 / density)) == 0) {
+                noise *= density;
+            }
+
+            data[i] += noise * envelope;
+        }
+
+        // Apply brightness filtering (simple one-pole lowpass)
+        if (brightness < 0.99f) {
+            float coeff = brightness; // 0.99 = very bright, 0.0 = very dark
+            float state = data[0];
+
+            for (int i = 1; i < irLength; i++) {
+                state = data[i] * (1.0f - coeff) + state * coeff;
+                data[i] = state;
+            }
+        }
+
+        // Normalize to prevent clipping
+        float maxSample = 0.0f;
+        for (int i = 0; i < irLength; i++) {
+            maxSample = std::max(maxSample, std::abs(data[i]));
+        }
+        if (maxSample > 0.0f) {
+            float normFactor = 0.8f / maxSample;
+            for (int i = 0; i < irLength; i++) {
+                data[i] *= normFactor;
+            }
+        }
+    }
+
+    // Add stereo width variation through simple all-pass decorrelation:
+    // a small delay offset on each channel, processed in place
+    for (int ch = 0; ch < 2; ch++) {
+        float* data = ir.getWritePointer(ch);
+
+        // Offset by 7 or 11 samples (prime numbers for less periodicity)
+        int offset = (ch == 0) ? 7 : 11;
+
+        // Process backwards to avoid overwriting data we need
+        for (int i = irLength - 1; i >= offset; i--) {
+            float delayed = data[i - offset];
+            data[i] = data[i] * 0.9f + delayed * 0.1f;
+        }
+    }
+
+    return ir;
+}
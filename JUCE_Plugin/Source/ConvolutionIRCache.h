@@ -0,0 +1,121 @@
+#pragma once
+
+#include "EngineBase.h"
+#include "NonUniformPartitionedConvolution.h"
+#include "RealtimeWakeEvent.h"
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * ConvolutionIRCache - ConvolutionReverb's synthesized impulse responses,
+ * shared process-wide
+ *
+ * An IR is fully determined by its Settings and the sample rate, so every
+ * reverb with the same settings gets the same PartitionedImpulseResponse: the
+ * synthesis and the per-partition FFTs run once, and the frequency-domain
+ * partitions are held once however many instances play them.
+ *
+ * Rebuilds wanted by the audio thread run on the cache's loader thread. A
+ * reverb attaches a Request; the audio thread posts new settings to it and
+ * collects the finished IR a few blocks later, both without locking or
+ * allocating. Entries stay while anything holds them, plus the few most
+ * recently released so that flicking a parameter back is instant. Only
+ * non-audio threads evict, so a reference dropped on the audio thread is
+ * never the last one.
+ */
+class ConvolutionIRCache {
+public:
+    using IRPtr = std::shared_ptr<const PartitionedImpulseResponse>;
+
+    // Everything that shapes an IR, the continuous parameters in 5% steps
+    struct Settings {
+        int irIndex = 0;        // 0-3
+        bool reversed = false;
+        int size = 20;          // 0-20: share of the IR kept
+        int damping = 0;        // 0-20
+        int earlyLate = 10;     // 0-20
+        EngineBase::Quality quality = EngineBase::Quality::Ultra;  // Caps the length
+
+        static constexpr int STEPS = 20;
+
+        static Settings fromParameters(float irSelect, float size, float damping,
+                                       float reverse, float earlyLate, EngineBase::Quality quality) noexcept;
+        uint32_t pack() const noexcept;
+        static Settings unpack(uint32_t packed) noexcept;
+    };
+
+    // One reverb's line to the loader thread
+    class Request {
+    public:
+        // Audio thread: ask for the IR with these settings
+        void post(const Settings& settings) noexcept;
+        // Audio thread: the IR for the latest settings, once, when it's ready
+        IRPtr collect() noexcept;
+
+    private:
+        friend class ConvolutionIRCache;
+        ConvolutionIRCache* cache = nullptr;
+        double sampleRate = 44100.0;
+        uint32_t generation = 0;           // Bumped by attach(), under the requests lock
+        std::atomic<uint32_t> requested { 0 };
+        uint32_t delivered = 0;            // Under the requests lock
+        juce::SpinLock readyLock;
+        IRPtr ready;
+    };
+
+    // The process-wide instance; it goes when the last reverb lets go of it
+    static std::shared_ptr<ConvolutionIRCache> getShared();
+    ~ConvolutionIRCache();
+
+    // Finds or builds an IR on the calling thread, which mustn't be the audio thread
+    IRPtr get(const Settings& settings, double sampleRate);
+
+    // The request starts out holding settings at this sample rate; after
+    // detach() nothing more is delivered to it
+    void attach(Request& request, double sampleRate, const Settings& settings);
+    void detach(Request& request);
+
+    size_t getNumCachedIRs() const;
+
+    // Builds an IR from scratch; the longest it can be, for sizing convolvers
+    static juce::AudioBuffer<float> synthesize(const Settings& settings, double sampleRate);
+    static constexpr double MAX_IR_SECONDS = 5.0;
+
+private:
+    ConvolutionIRCache();
+
+    struct Entry {
+        uint32_t settings = 0;
+        double sampleRate = 0.0;
+        IRPtr ir;
+        uint64_t lastUsed = 0;
+    };
+
+    class Loader : public juce::Thread {
+    public:
+        explicit Loader(ConvolutionIRCache& o) : juce::Thread("Chimera IR Loader"), owner(o) {}
+        void run() override;
+        RealtimeWakeEvent wake;  // Signalled by Request::post on the audio thread
+    private:
+        ConvolutionIRCache& owner;
+    };
+
+    // Unused entries kept for reuse
+    static constexpr size_t MAX_UNUSED_ENTRIES = 4;
+
+    juce::CriticalSection m_entriesLock;
+    std::vector<Entry> m_entries;
+    uint64_t m_useCounter = 0;
+
+    juce::CriticalSection m_requestsLock;
+    std::vector<Request*> m_requests;
+
+    std::unique_ptr<Loader> m_loader;
+
+    bool serviceNextRequest();
+    void evictUnused();
+    static juce::AudioBuffer<float> generateAlgorithmicIR(int type, double sampleRate);
+};
@@ -37,6 +37,9 @@ public:
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
     
+    // Lower tiers shorten the IR: Draft 1 s, Normal 2 s, High 3.5 s, Ultra full
+    void setQuality(Quality q) override;
+    
     // Parameter information
     int getNumParameters() const override;
     juce::String getParameterName(int index) const override;
@@ -45,6 +48,9 @@ public:
     // Report latency for PDC
     int getLatencySamples() const noexcept override;
     
+    // Loaded IR length plus pre-delay
+    double getTailLengthSeconds() const noexcept override;
+    
 private:
     // Implementation class
     class Impl;
@@ -0,0 +1,141 @@
+// CpuGovernor.h - Adaptive quality control driven by measured chain load
+//
+// Runs on the audio thread each time PerformanceTelemetry publishes a
+// snapshot. When the whole-chain load crosses CPU_THRESHOLD_WARNING (held for
+// a while) or CPU_THRESHOLD_CRITICAL (immediately), the most expensive slot
+// that can still go lower is stepped down one EngineBase::Quality tier. Once
+// load has stayed below the warning threshold minus a restore margin, slots are
+// stepped back up one tier at a time, most recently degraded first. The gap
+// between the thresholds and the hold times are the hysteresis that keeps a
+// chain sitting near a threshold from oscillating.
+//
+// Every decision uses the snapshot's recent loads (the last publish interval,
+// ~50 ms), never the rolling means. Those span seconds, so after a step they
+// would keep reporting the old load well past the cooldown and the governor
+// would walk every slot down to Draft on the strength of one overload.
+//
+// Offline rendering pins every slot at Ultra, and so does a pinned slot: one
+// whose engine's latency depends on its tier (EngineBase::qualityChangesLatency).
+#pragma once
+
+#include "EngineBase.h"
+#include "PerformanceTelemetry.h"
+#include "SlotConfiguration.h"
+#include <array>
+#include <cstdint>
+
+class CpuGovernor {
+public:
+    using Quality = EngineBase::Quality;
+    static constexpr int NUM_SLOTS = CHIMERA_NUM_SLOTS;
+
+    void reset() noexcept {
+        tiers.fill(Quality::Ultra);
+        degradeOrder.fill(-1);
+        numDegradeSteps = 0;
+        secondsOverWarning = 0.0;
+        secondsUnderRestore = 0.0;
+        cooldownSeconds = 0.0;
+        lastBlockCount = 0;
+    }
+
+    // Audio thread, after each telemetry publish
+    void update(const PerformanceTelemetry::Snapshot& snapshot, bool isOffline, bool isEnabled) noexcept {
+        // Telemetry restarts its block count in prepare()
+        const auto blocks = snapshot.blockCount >= lastBlockCount ? snapshot.blockCount - lastBlockCount : 0;
+        const double elapsed = (double) blocks * snapshot.blockDeadlineMs * 0.001;
+        lastBlockCount = snapshot.blockCount;
+
+        if (isOffline || !isEnabled) {
+            // Bounces get full quality; a disabled governor hands everything back
+            if (numDegradeSteps > 0)
+                reset();
+            lastBlockCount = snapshot.blockCount;
+            return;
+        }
+
+        cooldownSeconds = juce::jmax(0.0, cooldownSeconds - elapsed);
+        const float loadPercent = snapshot.chainRecentLoad * 100.0f;
+
+        if (loadPercent >= ChimeraConfig::CPU_THRESHOLD_WARNING)
+            secondsOverWarning += elapsed;
+        else
+            secondsOverWarning = 0.0;
+
+        if (loadPercent < ChimeraConfig::CPU_THRESHOLD_WARNING - ChimeraConfig::CPU_GOVERNOR_RESTORE_MARGIN)
+            secondsUnderRestore += elapsed;
+        else
+            secondsUnderRestore = 0.0;
+
+        if (cooldownSeconds > 0.0)
+            return;
+
+        const bool critical = loadPercent >= ChimeraConfig::CPU_THRESHOLD_CRITICAL;
+        if (critical || secondsOverWarning >= ChimeraConfig::CPU_GOVERNOR_HOLD_SECONDS) {
+            if (stepDownMostExpensive(snapshot))
+                cooldownSeconds = critical ? ChimeraConfig::CPU_GOVERNOR_CRITICAL_COOLDOWN_SECONDS
+                                           : ChimeraConfig::CPU_GOVERNOR_HOLD_SECONDS;
+            secondsOverWarning = 0.0;
+        } else if (secondsUnderRestore >= ChimeraConfig::CPU_GOVERNOR_RESTORE_SECONDS && numDegradeSteps > 0) {
+            stepUpMostRecent();
+            secondsUnderRestore = 0.0;
+            cooldownSeconds = ChimeraConfig::CPU_GOVERNOR_RESTORE_SECONDS;
+        }
+    }
+
+    Quality getTier(int slot) const noexcept {
+        return pinnedSlots[(size_t) slot] ? Quality::Ultra : tiers[(size_t) slot];
+    }
+
+    // Audio thread, before update(). Pinned slots are never degraded.
+    void setSlotPinned(int slot, bool pinned) noexcept { pinnedSlots[(size_t) slot] = pinned; }
+
+private:
+    static std::array<Quality, NUM_SLOTS> ultraTiers() noexcept {
+        std::array<Quality, NUM_SLOTS> all;
+        all.fill(Quality::Ultra);
+        return all;
+    }
+
+    bool stepDownMostExpensive(const PerformanceTelemetry::Snapshot& snapshot) noexcept {
+        int candidate = -1;
+        float highestLoad = 0.0f;
+        for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+            const auto& stats = snapshot.slots[(size_t) slot];
+            if (stats.active && !pinnedSlots[(size_t) slot] && tiers[(size_t) slot] != Quality::Draft
+                && stats.recentLoad > highestLoad) {
+                highestLoad = stats.recentLoad;
+                candidate = slot;
+            }
+        }
+
+        if (candidate < 0 || numDegradeSteps >= (int) degradeOrder.size())
+            return false;
+
+        auto& tier = tiers[(size_t) candidate];
+        tier = static_cast<Quality>(static_cast<int>(tier) - 1);
+        degradeOrder[(size_t) numDegradeSteps++] = (int8_t) candidate;
+        return true;
+    }
+
+    void stepUpMostRecent() noexcept {
+        const int slot = degradeOrder[(size_t) --numDegradeSteps];
+        degradeOrder[(size_t) numDegradeSteps] = -1;
+
+        auto& tier = tiers[(size_t) slot];
+        if (tier != Quality::Ultra)
+            tier = static_cast<Quality>(static_cast<int>(tier) + 1);
+    }
+
+    std::array<Quality, NUM_SLOTS> tiers = ultraTiers();
+    std::array<bool, NUM_SLOTS> pinnedSlots{};
+
+    // One entry per step taken (each slot can drop three tiers)
+    std::array<int8_t, NUM_SLOTS * 3> degradeOrder{};
+    int numDegradeSteps = 0;
+
+    double secondsOverWarning = 0.0;
+    double secondsUnderRestore = 0.0;
+    double cooldownSeconds = 0.0;
+    uint64_t lastBlockCount = 0;
+};
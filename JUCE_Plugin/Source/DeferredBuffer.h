@@ -0,0 +1,67 @@
+// DeferredBuffer.h - Sample storage a mode allocates only once it is used
+//
+// Engines with several modes used to embed every mode's worst-case buffer, so
+// an instance paid for modes it never ran. A DeferredBuffer is sized in
+// prepareToPlay from the sample rate but left empty until its mode is
+// selected. The audio thread cannot allocate, so it only asks: the engine
+// reports needsDeferredAllocation() and the processor answers by calling
+// performDeferredAllocation() on the message thread, which calls allocate()
+// here. Until then get() is null and the mode runs without the buffer
+// (typically dry, for the few milliseconds the round trip takes).
+//
+// Storage is published once through an atomic pointer and only freed by
+// prepare() or destruction, both of which run while the engine is not
+// processing, so the audio thread needs no lock.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+class DeferredBuffer {
+public:
+    DeferredBuffer() = default;
+    DeferredBuffer(const DeferredBuffer&) = delete;
+    DeferredBuffer& operator=(const DeferredBuffer&) = delete;
+
+    // Message thread, engine not processing. Keeps buffers that were already
+    // in use (resized and cleared) and allocates now if `allocateNow` is set.
+    void prepare(size_t numSamples, bool allocateNow) {
+        const bool wasAllocated = isAllocated();
+        published.store(nullptr, std::memory_order_release);
+        storage.reset();
+        capacity = std::max<size_t>(1, numSamples);
+
+        if (wasAllocated || allocateNow)
+            allocate();
+    }
+
+    // Message thread; a no-op once allocated
+    void allocate() {
+        if (isAllocated() || capacity == 0)
+            return;
+
+        storage.reset(new float[capacity]());
+        published.store(storage.get(), std::memory_order_release);
+    }
+
+    bool isAllocated() const noexcept { return published.load(std::memory_order_acquire) != nullptr; }
+
+    // Null until allocated
+    float* get() noexcept { return published.load(std::memory_order_acquire); }
+
+    // Samples the buffer holds (or will hold) for the prepared sample rate
+    size_t size() const noexcept { return capacity; }
+    int sizeInt() const noexcept { return static_cast<int>(capacity); }
+
+    void clear() noexcept {
+        if (float* data = get())
+            std::fill(data, data + capacity, 0.0f);
+    }
+
+private:
+    std::unique_ptr<float[]> storage;
+    std::atomic<float*> published{nullptr};
+    size_t capacity = 0;
+};
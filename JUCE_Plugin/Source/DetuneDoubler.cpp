@@ -6,7 +6,7 @@ namespace AudioDSP {
 DetuneDoubler::DetuneDoubler() {
     // Initialize voices with shared RNG
     for (auto& voice : m_voices) {
-        voice.pitchShifter = std::make_unique<PitchShifter>(m_randomGen);
+        voice.pitchShifter = std::make_unique<::PitchShiftTiers>(static_cast<int>(Quality::High));
         voice.delay = std::make_unique<DetuneDoublerImpl::DelayLine>();
         voice.phaseNetwork = std::make_unique<DetuneDoublerImpl::AllPassNetwork>(m_randomGen);
         voice.modulator = std::make_unique<DetuneDoublerImpl::ModulationGenerator>(m_randomGen);
@@ -32,10 +32,12 @@ DetuneDoubler::~DetuneDoubler() = default;
 
 void DetuneDoubler::prepareToPlay(double sampleRate, int samplesPerBlock) {
     m_sampleRate = sampleRate;
+    m_blockSize = samplesPerBlock;
     
     // Configure all voices
     for (int i = 0; i < 4; ++i) {
-        m_voices[i].pitchShifter->setSampleRate(sampleRate);
+        m_voices[i].pitchShifter->prepare(sampleRate, samplesPerBlock);
+        m_voices[i].shifted.assign(static_cast<size_t>(samplesPerBlock), 0.0f);
         
         // Set different modulation rates for each voice
         m_voices[i].modulator->setSampleRate(sampleRate);
@@ -87,22 +89,40 @@ void DetuneDoubler::process(juce::AudioBuffer<float>& buffer) {
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
     
-    if (numSamples == 0) return;
+    if (numSamples == 0 || numChannels == 0) return;
     
-    if (numChannels >= 2) {
-        processStereo(buffer.getWritePointer(0),
-                     buffer.getWritePointer(1),
-                     numSamples);
-    } else if (numChannels == 1) {
-        // Process mono as dual mono
-        float* data = buffer.getWritePointer(0);
-        processStereo(data, data, numSamples);
+    // Mono is processed as dual mono
+    float* left = buffer.getWritePointer(0);
+    float* right = numChannels >= 2 ? buffer.getWritePointer(1) : left;
+    
+    // Voice scratch holds one prepared block; split anything longer
+    for (int start = 0; start < numSamples; start += m_blockSize) {
+        const int chunk = std::min(m_blockSize, numSamples - start);
+        processStereo(left + start, right + start, chunk);
     }
     
     scrubBuffer(buffer);
 }
 
+void DetuneDoubler::setQuality(Quality q) {
+    for (auto& voice : m_voices) {
+        voice.pitchShifter->setQuality(static_cast<int>(q));
+    }
+}
+
 void DetuneDoubler::processStereo(float* left, float* right, int numSamples) {
+    // Detune each voice a block at a time (L1, L2, R1, R2), before the
+    // per-sample loop below overwrites the input
+    const float blockDetuneCents = m_detuneParam->getCurrentValue() * MAX_DETUNE_CENTS;
+    const float voiceDetune[4] = { 1.0f, -0.7f, -1.0f, 0.7f };
+    for (int v = 0; v < 4; ++v) {
+        const float ratio = std::pow(2.0f, blockDetuneCents * voiceDetune[v] / 1200.0f);
+        m_voices[v].pitchShifter->process(v < 2 ? left : right, m_voices[v].shifted.data(), numSamples, ratio);
+    }
+    
+    // The shifters already delay by their latency; take it off the doubling delay
+    const float shifterLatency = static_cast<float>(m_voices[0].pitchShifter->getLatencySamples());
+    
     for (int i = 0; i < numSamples; ++i) {
         // Get smoothed parameters
         float detune = m_detuneParam->getNextValue();
@@ -121,13 +141,6 @@ void DetuneDoubler::processStereo(float* left, float* right, int numSamples) {
         float dryL = left[i];
         float dryR = right[i];
         
-        // Calculate detune amounts for each voice
-        float detuneCents = detune * MAX_DETUNE_CENTS;
-        m_voices[0].pitchShifter->setPitchShift(detuneCents);
-        m_voices[1].pitchShifter->setPitchShift(-detuneCents * 0.7f);
-        m_voices[2].pitchShifter->setPitchShift(-detuneCents);
-        m_voices[3].pitchShifter->setPitchShift(detuneCents * 0.7f);
-        
         // Calculate delay times with modulation
         float baseDelayMs = MIN_DELAY_MS + delay * (MAX_DELAY_MS - MIN_DELAY_MS);
         float baseDelaySamples = baseDelayMs * m_sampleRate / 1000.0f;
@@ -138,18 +151,18 @@ void DetuneDoubler::processStereo(float* left, float* right, int numSamples) {
         // Left channel voices
         float mod1 = m_voices[0].modulator->generate();
         float delay1 = baseDelaySamples * (1.0f + mod1 * 0.02f);
-        m_voices[0].delay->setDelay(delay1);
+        m_voices[0].delay->setDelay(delay1 - shifterLatency);
         
-        voice1L = m_voices[0].pitchShifter->process(dryL);
+        voice1L = m_voices[0].shifted[i];
         voice1L = m_voices[0].delay->process(voice1L);
         voice1L = m_voices[0].phaseNetwork->process(voice1L);
         voice1L = m_voices[0].tapeFilter->processSample(voice1L);
         
         float mod2 = m_voices[1].modulator->generate();
         float delay2 = baseDelaySamples * (1.0f + mod2 * 0.02f) * 1.1f;
-        m_voices[1].delay->setDelay(delay2);
+        m_voices[1].delay->setDelay(delay2 - shifterLatency);
         
-        voice2L = m_voices[1].pitchShifter->process(dryL);
+        voice2L = m_voices[1].shifted[i];
         voice2L = m_voices[1].delay->process(voice2L);
         voice2L = m_voices[1].phaseNetwork->process(voice2L);
         voice2L = m_voices[1].tapeFilter->processSample(voice2L);
@@ -157,18 +170,18 @@ void DetuneDoubler::processStereo(float* left, float* right, int numSamples) {
         // Right channel voices
         float mod3 = m_voices[2].modulator->generate();
         float delay3 = baseDelaySamples * (1.0f + mod3 * 0.02f) * 0.95f;
-        m_voices[2].delay->setDelay(delay3);
+        m_voices[2].delay->setDelay(delay3 - shifterLatency);
         
-        voice1R = m_voices[2].pitchShifter->process(dryR);
+        voice1R = m_voices[2].shifted[i];
         voice1R = m_voices[2].delay->process(voice1R);
         voice1R = m_voices[2].phaseNetwork->process(voice1R);
         voice1R = m_voices[2].tapeFilter->processSample(voice1R);
         
         float mod4 = m_voices[3].modulator->generate();
         float delay4 = baseDelaySamples * (1.0f + mod4 * 0.02f) * 1.05f;
-        m_voices[3].delay->setDelay(delay4);
+        m_voices[3].delay->setDelay(delay4 - shifterLatency);
         
-        voice2R = m_voices[3].pitchShifter->process(dryR);
+        voice2R = m_voices[3].shifted[i];
         voice2R = m_voices[3].delay->process(voice2R);
         voice2R = m_voices[3].phaseNetwork->process(voice2R);
         voice2R = m_voices[3].tapeFilter->processSample(voice2R);
@@ -3,6 +3,7 @@
 
 #include "../Source/EngineBase.h"
 #include "DspEngineUtilities.h"
+#include "PitchShiftTiers.h"
 #include <array>
 #include <memory>
 #include <cmath>
@@ -10,6 +11,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <map>
+#include <vector>
 
 // Define PI for portability
 #ifndef M_PI
@@ -18,9 +20,6 @@ static constexpr double M_PI = 3.141592653589793;
 
 namespace AudioDSP {
 
-// Forward declarations for classes in global AudioDSP namespace
-class PitchShifter;
-
 // Forward declarations for DetuneDoublerImpl namespace
 namespace DetuneDoublerImpl {
     class DelayLine;
@@ -44,10 +43,17 @@ public:
     juce::String getParameterName(int index) const override;
     juce::String getParameterDisplayString(int index, float value) const;
     
+    // Draft detunes with PSOLA, everything above with the phase vocoder.
+    // The shifter's latency comes out of the doubling delay, so dry stays
+    // undelayed and the engine itself adds none.
+    void setQuality(Quality q) override;
+    
 private:
     // Core components for each voice
     struct Voice {
-        std::unique_ptr<PitchShifter> pitchShifter;
+        // Signalsmith's ~160 ms would swamp the 10-60 ms doubling delay
+        std::unique_ptr<::PitchShiftTiers> pitchShifter;
+        std::vector<float> shifted;  // This block's detuned input
         std::unique_ptr<DetuneDoublerImpl::DelayLine> delay;
         std::unique_ptr<DetuneDoublerImpl::AllPassNetwork> phaseNetwork;
         std::unique_ptr<DetuneDoublerImpl::ModulationGenerator> modulator;
@@ -71,6 +77,7 @@ private:
     std::mt19937 m_randomGen{42}; // Shared RNG for reproducible results
     
     // Processing
+    int m_blockSize = 512;
     void processStereo(float* left, float* right, int numSamples);
     
     // Constants
@@ -84,131 +91,6 @@ private:
     }
 };
 
-// PitchShifter.h - High-quality pitch shifting using grain overlap
-class PitchShifter {
-public:
-    PitchShifter(std::mt19937& rng) : m_randomGen(rng) {
-        reset();
-    }
-    
-    void setSampleRate(double sampleRate) {
-        m_sampleRate = sampleRate;
-        // Grain size could be adjusted based on sample rate
-        // For now, keep it fixed for consistency
-    }
-    
-    void reset() {
-        m_buffer.fill(0.0f);
-        m_writePos = 0;
-        m_grain1Pos = 0.0;
-        m_grain2Pos = GRAIN_SIZE * 0.5;
-        m_windowPhase = 0.0;
-        
-        // Pre-fill the buffer with silence to ensure we have valid data to read
-        for (int i = 0; i < BUFFER_SIZE; ++i) {
-            m_buffer[i] = 0.0f;
-        }
-        m_writePos = GRAIN_SIZE + 128; // Start writing ahead of the grain read positions
-    }
-    
-    void setPitchShift(float cents) {
-        float ratio = std::pow(2.0f, cents / 1200.0f);
-        m_pitchRatio = ratio;
-        m_readSpeed = ratio;  // Read faster for higher pitch
-    }
-    
-    float process(float input) {
-        // Write to circular buffer
-        m_buffer[m_writePos] = input;
-        m_writePos = (m_writePos + 1) & BUFFER_MASK;
-        
-        // Process two overlapping grains
-        float grain1 = processGrain(m_grain1Pos, 0.0);
-        float grain2 = processGrain(m_grain2Pos, 0.5);
-        
-        // Update grain positions
-        m_grain1Pos += 1.0;
-        m_grain2Pos += 1.0;
-        
-        // Wrap grain positions
-        if (m_grain1Pos >= GRAIN_SIZE) {
-            m_grain1Pos -= GRAIN_SIZE;
-            randomizeGrain(m_grain1Pos);
-        }
-        if (m_grain2Pos >= GRAIN_SIZE) {
-            m_grain2Pos -= GRAIN_SIZE;
-            randomizeGrain(m_grain2Pos);
-        }
-        
-        return grain1 + grain2;
-    }
-    
-private:
-    static constexpr size_t BUFFER_SIZE = 8192;
-    static constexpr size_t BUFFER_MASK = BUFFER_SIZE - 1;
-    static constexpr size_t GRAIN_SIZE = 2048;
-    
-    alignas(64) std::array<float, BUFFER_SIZE> m_buffer;
-    size_t m_writePos = 0;
-    double m_grain1Pos = 0.0;
-    double m_grain2Pos = 0.0;
-    float m_pitchRatio = 1.0f;
-    float m_readSpeed = 1.0f;
-    double m_windowPhase = 0.0;
-    double m_sampleRate = 44100.0;
-    std::mt19937& m_randomGen;
-    std::uniform_real_distribution<float> m_grainDist{-2.0f, 2.0f};
-    
-    float processGrain(double& grainPos, double phaseOffset) {
-        // Calculate read position with minimum delay to ensure we're reading valid data
-        // Add a small offset to avoid reading data that was just written
-        double minDelay = 64.0; // Minimum samples behind write position
-        double readPos = m_writePos - GRAIN_SIZE - minDelay + grainPos * m_readSpeed;
-        while (readPos < 0) readPos += BUFFER_SIZE;
-
-        // Cubic interpolation for better anti-aliasing
-        int idx0 = static_cast<int>(readPos) & BUFFER_MASK;
-        int idxm1 = (idx0 - 1) & BUFFER_MASK;
-        int idx1 = (idx0 + 1) & BUFFER_MASK;
-        int idx2 = (idx0 + 2) & BUFFER_MASK;
-
-        float frac = static_cast<float>(readPos - std::floor(readPos));
-
-        // 4-point cubic interpolation (Hermite)
-        float ym1 = m_buffer[idxm1];
-        float y0 = m_buffer[idx0];
-        float y1 = m_buffer[idx1];
-        float y2 = m_buffer[idx2];
-
-        float c0 = y0;
-        float c1 = 0.5f * (y1 - ym1);
-        float c2 = ym1 - 2.5f * y0 + 2.0f * y1 - 0.5f * y2;
-        float c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
-
-        float sample = ((c3 * frac + c2) * frac + c1) * frac + c0;
-
-        // Apply improved Hann-Poisson window for better spectral characteristics
-        double windowPos = grainPos / GRAIN_SIZE + phaseOffset;
-        windowPos = windowPos - std::floor(windowPos);
-
-        // Hann-Poisson window (alpha = 2.0) - reduced sidelobes compared to Hann
-        float hann = 0.5f * (1.0f - std::cos(2.0f * M_PI * windowPos));
-        float poisson = std::exp(-2.0f * std::abs(2.0f * windowPos - 1.0f));
-        float window = hann * poisson;
-
-        // Constant gain regardless of pitch ratio
-        // Adjusted scaling for Hann-Poisson window overlap
-        return sample * window * 0.85f; // Scale for two overlapping windows with Hann-Poisson
-    }
-    
-    void randomizeGrain(double& grainPos) {
-        // Add slight randomization to prevent periodicity
-        grainPos += m_grainDist(m_randomGen);
-        if (grainPos < 0) grainPos += GRAIN_SIZE;
-        if (grainPos >= GRAIN_SIZE) grainPos -= GRAIN_SIZE;
-    }
-};
-
 namespace DetuneDoublerImpl {
 
 // DelayLine.h - Simple fractional delay
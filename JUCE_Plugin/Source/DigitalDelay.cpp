@@ -580,6 +580,13 @@ bool DigitalDelay::supportsFeature(Feature f) const noexcept {
     }
 }
 
+double DigitalDelay::getTailLengthSeconds() const noexcept {
+    // Stereo crossfeed adds to the loop gain; modulation depth is tiny
+    const double loopSeconds = calculateSyncedDelayTime(m_delayTime->getCurrentValue(), m_sync->getCurrentValue()) / m_sampleRate;
+    const double loopGain = m_feedback->getCurrentValue() * MAX_FEEDBACK * (1.0 + m_crossfeed.amount);
+    return getFeedbackTailSeconds(loopSeconds * 1.01, loopGain);
+}
+
 float DigitalDelay::calculateSyncedDelayTime(float timeParam, float syncParam) const {
     // Sync is off if syncParam < 0.5, use manual time in samples
     if (syncParam < 0.5f) {
@@ -42,6 +42,7 @@ public:
     // Extended EngineBase API
     void setTransportInfo(const TransportInfo& info) override;
     bool supportsFeature(Feature f) const noexcept override;
+    double getTailLengthSeconds() const noexcept override;
     
 private:
     // Core DSP components
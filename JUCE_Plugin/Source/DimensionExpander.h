@@ -18,6 +18,9 @@ public:
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
 
+    // The Haas micro-delays hold up to 20 ms; nothing recirculates
+    double getTailLengthSeconds() const noexcept override { return 0.020; }
+
     juce::String getName() const override { return "Dimension Expander"; }
     int getNumParameters() const override { return 8; }
     juce::String getParameterName(int index) const override;
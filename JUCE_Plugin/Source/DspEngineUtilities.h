@@ -1,6 +1,7 @@
 // DspEngineUtilities.h
 // Shared DSP utilities and guardrails for all Chimera Phoenix engines
-// Provides denormal protection, NaN scrubbing, parameter smoothing, and other studio-grade essentials
+// Provides denormal protection, NaN scrubbing, parameter smoothing, fast
+// transcendentals, and other studio-grade essentials
 
 #pragma once
 
@@ -9,12 +10,18 @@
     #include "../JuceLibraryCode/JuceHeader.h"
 #endif
 
+#include "EngineBase.h"
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
     #include <xmmintrin.h>
+    #include <emmintrin.h>
 #endif
 
 // ========== Denormal Protection ==========
@@ -436,4 +443,431 @@ private:
     float releaseCoeff = 0.999f;
     float envelope = 0.0f;
     float peak = 0.0f;
-};
\ No newline at end of file
+};
+
+// ========== Fast Math ==========
+
+// Approximations of the transcendentals engines call per sample: scalar forms
+// for feedback loops and block forms, four lanes at a time under SSE, for
+// whole buffers (in place is fine). Every function takes an Accuracy, and
+// accuracyForQuality() picks one from the engine's Quality. Worst-case error
+// over the stated range, as FastMathTest checks it (absolute, except relative
+// for exp and pow2); std::tanh costs 20-40x the block form, std::exp and
+// std::sin 2-3x:
+//
+//            Coarse    Medium    Fine      range
+//   tanh     2.5e-2    1e-4      1e-6      any x; flat at +-1 past a knee
+//   exp      1e-3      5e-6      3e-7      x clamped to [-87, 88]
+//   pow2     1e-3      5e-6      3e-7      x clamped to [-126, 127]
+//   log      1e-4      3e-6      3e-7      x > 0, relative once |log x| > 1;
+//                                          x <= 0 gives log(FLT_MIN)
+//   sin/cos  5e-5      1e-6      5e-7      |x| <= 8192 pi
+//
+// Coarse tanh is the 3/2 Pade approximant LadderFilter is voiced on, clamped
+// at +-3 where it meets +-1 with zero slope.
+namespace FastMath
+{
+    enum class Accuracy { Coarse, Medium, Fine };
+
+    inline Accuracy accuracyForQuality(EngineBase::Quality quality) noexcept
+    {
+        switch (quality)
+        {
+            case EngineBase::Quality::Draft:  return Accuracy::Coarse;
+            case EngineBase::Quality::Normal: return Accuracy::Medium;
+            case EngineBase::Quality::High:
+            case EngineBase::Quality::Ultra:  break;
+        }
+        return Accuracy::Fine;
+    }
+
+    namespace detail
+    {
+        constexpr float LOG2E = 1.44269504088896341f;
+        constexpr float LN2 = 0.693147180559945309f;
+        constexpr float LN2_HI = 0.693359375f;           // few mantissa bits, so n * LN2_HI is exact
+        constexpr float LN2_LO = -2.12194440e-4f;
+        constexpr float PIO2_1 = 1.5703125f;             // pi/2 split the same way
+        constexpr float PIO2_2 = 4.837512969970703125e-4f;
+        constexpr float PIO2_3 = 7.54978995489188216e-8f;
+        constexpr float TWO_OVER_PI = 0.636619772367581343f;
+        constexpr float SQRT2 = 1.41421356237309505f;
+        constexpr float MIN_NORMAL = 1.17549435e-38f;
+        constexpr float TANH_KNEE_MEDIUM = 4.9718f;      // just past where the 7/6 approximant reaches 1
+        constexpr float TANH_KNEE_FINE = 7.90531110763549805f;
+
+        inline float bitsToFloat(int32_t bits) noexcept { float f; std::memcpy(&f, &bits, sizeof f); return f; }
+        inline int32_t floatToBits(float f) noexcept { int32_t bits; std::memcpy(&bits, &f, sizeof bits); return bits; }
+
+        // Nearest, ties to even, as _mm_cvtps_epi32 rounds
+        inline int32_t roundToInt(float x) noexcept
+        {
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            return _mm_cvtss_si32(_mm_set_ss(x));
+           #else
+            return (int32_t)std::nearbyint(x);
+           #endif
+        }
+
+        inline float clamp(float x, float lo, float hi) noexcept { return std::max(lo, std::min(hi, x)); }
+
+        // Horner's rule over coefficients given highest power first
+        template <size_t N>
+        inline float horner(float x, const float (&c)[N]) noexcept
+        {
+            float y = c[0];
+            for (size_t i = 1; i < N; ++i)
+                y = y * x + c[i];
+            return y;
+        }
+
+        // Taylor coefficients of e^r to degree 3, 5 or 7, for |r| <= ln(2)/2
+        template <Accuracy A> struct ExpSeries;
+        template <> struct ExpSeries<Accuracy::Coarse> { static constexpr float c[] = { 1.0f / 6.0f, 0.5f, 1.0f, 1.0f }; };
+        template <> struct ExpSeries<Accuracy::Medium> { static constexpr float c[] = { 1.0f / 120.0f, 1.0f / 24.0f, 1.0f / 6.0f, 0.5f, 1.0f, 1.0f }; };
+        template <> struct ExpSeries<Accuracy::Fine>   { static constexpr float c[] = { 1.0f / 5040.0f, 1.0f / 720.0f, 1.0f / 120.0f, 1.0f / 24.0f,
+                                                                                        1.0f / 6.0f, 0.5f, 1.0f, 1.0f }; };
+
+        // log m = s * (2 + 2/3 s^2 + 2/5 s^4 + ...), s = (m - 1) / (m + 1), |s| < 0.172
+        template <Accuracy A> struct LogSeries;
+        template <> struct LogSeries<Accuracy::Coarse> { static constexpr float c[] = { 2.0f / 3.0f, 2.0f }; };
+        template <> struct LogSeries<Accuracy::Medium> { static constexpr float c[] = { 2.0f / 5.0f, 2.0f / 3.0f, 2.0f }; };
+        template <> struct LogSeries<Accuracy::Fine>   { static constexpr float c[] = { 2.0f / 9.0f, 2.0f / 7.0f, 2.0f / 5.0f, 2.0f / 3.0f, 2.0f }; };
+
+        // sin r = r + r^3 * S(r^2), cos r = C(r^2), for |r| <= pi/4
+        template <Accuracy A> struct TrigSeries;
+        template <> struct TrigSeries<Accuracy::Coarse>
+        {
+            static constexpr float s[] = { 1.0f / 120.0f, -1.0f / 6.0f };
+            static constexpr float c[] = { -1.0f / 720.0f, 1.0f / 24.0f, -0.5f, 1.0f };
+        };
+        template <> struct TrigSeries<Accuracy::Medium>
+        {
+            static constexpr float s[] = { -1.0f / 5040.0f, 1.0f / 120.0f, -1.0f / 6.0f };
+            static constexpr float c[] = { 1.0f / 40320.0f, -1.0f / 720.0f, 1.0f / 24.0f, -0.5f, 1.0f };
+        };
+        template <> struct TrigSeries<Accuracy::Fine>
+        {
+            static constexpr float s[] = { 1.0f / 362880.0f, -1.0f / 5040.0f, 1.0f / 120.0f, -1.0f / 6.0f };
+            static constexpr float c[] = { -1.0f / 3628800.0f, 1.0f / 40320.0f, -1.0f / 720.0f, 1.0f / 24.0f, -0.5f, 1.0f };
+        };
+
+        // Fine tanh: 13/6 minimax rational in x (as in Eigen), odd numerator
+        constexpr float TANH_P[] = { -2.76076847742355e-16f, 2.00018790482477e-13f, -8.60467152213735e-11f,
+                                     5.12229709037114e-08f, 1.48572235717979e-05f, 6.37261928875436e-04f,
+                                     4.89352455891786e-03f };
+        constexpr float TANH_Q[] = { 1.19825839466702e-06f, 1.18534705686654e-04f, 2.26843463243900e-03f,
+                                     4.89352518554385e-03f };
+
+       #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+        inline __m128 clamp(__m128 x, float lo, float hi) noexcept
+        {
+            return _mm_max_ps(_mm_set1_ps(lo), _mm_min_ps(_mm_set1_ps(hi), x));
+        }
+
+        inline __m128 select(__m128 mask, __m128 a, __m128 b) noexcept
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        // 2^n for integer n in the normal exponent range
+        inline __m128 exp2Int(__m128i n) noexcept
+        {
+            return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+        }
+
+        template <size_t N>
+        inline __m128 horner(__m128 x, const float (&c)[N]) noexcept
+        {
+            __m128 y = _mm_set1_ps(c[0]);
+            for (size_t i = 1; i < N; ++i)
+                y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(c[i]));
+            return y;
+        }
+       #endif
+
+        // Each function as a scalar and an SSE kernel doing the same arithmetic
+        struct Tanh
+        {
+            template <Accuracy A>
+            static float scalar(float x) noexcept
+            {
+                if constexpr (A == Accuracy::Coarse)
+                {
+                    x = clamp(x, -3.0f, 3.0f);
+                    const float x2 = x * x;
+                    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+                }
+                else if constexpr (A == Accuracy::Medium)
+                {
+                    x = clamp(x, -TANH_KNEE_MEDIUM, TANH_KNEE_MEDIUM);
+                    const float x2 = x * x;
+                    const float p = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+                    const float q = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+                    return clamp(p / q, -1.0f, 1.0f);
+                }
+                else
+                {
+                    x = clamp(x, -TANH_KNEE_FINE, TANH_KNEE_FINE);
+                    const float x2 = x * x;
+                    return x * horner(x2, TANH_P) / horner(x2, TANH_Q);
+                }
+            }
+
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            template <Accuracy A>
+            static __m128 vector(__m128 x) noexcept
+            {
+                if constexpr (A == Accuracy::Coarse)
+                {
+                    x = clamp(x, -3.0f, 3.0f);
+                    const __m128 x2 = _mm_mul_ps(x, x);
+                    return _mm_div_ps(_mm_mul_ps(x, _mm_add_ps(_mm_set1_ps(27.0f), x2)),
+                                      _mm_add_ps(_mm_set1_ps(27.0f), _mm_mul_ps(_mm_set1_ps(9.0f), x2)));
+                }
+                else if constexpr (A == Accuracy::Medium)
+                {
+                    x = clamp(x, -TANH_KNEE_MEDIUM, TANH_KNEE_MEDIUM);
+                    const __m128 x2 = _mm_mul_ps(x, x);
+                    const __m128 p = _mm_mul_ps(x, horner(x2, { 1.0f, 378.0f, 17325.0f, 135135.0f }));
+                    const __m128 q = horner(x2, { 28.0f, 3150.0f, 62370.0f, 135135.0f });
+                    return clamp(_mm_div_ps(p, q), -1.0f, 1.0f);
+                }
+                else
+                {
+                    x = clamp(x, -TANH_KNEE_FINE, TANH_KNEE_FINE);
+                    const __m128 x2 = _mm_mul_ps(x, x);
+                    return _mm_div_ps(_mm_mul_ps(x, horner(x2, TANH_P)), horner(x2, TANH_Q));
+                }
+            }
+           #endif
+        };
+
+        // e^x = 2^n e^r, n = round(x / ln 2), r = x - n ln 2 in two steps
+        struct Exp
+        {
+            template <Accuracy A>
+            static float scalar(float x) noexcept
+            {
+                x = clamp(x, -87.0f, 88.0f);
+                const int32_t n = roundToInt(x * LOG2E);
+                const float r = (x - (float)n * LN2_HI) - (float)n * LN2_LO;
+                return horner(r, ExpSeries<A>::c) * bitsToFloat((n + 127) << 23);
+            }
+
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            template <Accuracy A>
+            static __m128 vector(__m128 x) noexcept
+            {
+                x = clamp(x, -87.0f, 88.0f);
+                const __m128i n = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(LOG2E)));
+                const __m128 nf = _mm_cvtepi32_ps(n);
+                const __m128 r = _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(nf, _mm_set1_ps(LN2_HI))),
+                                            _mm_mul_ps(nf, _mm_set1_ps(LN2_LO)));
+                return _mm_mul_ps(horner(r, ExpSeries<A>::c), exp2Int(n));
+            }
+           #endif
+        };
+
+        struct Pow2
+        {
+            template <Accuracy A>
+            static float scalar(float x) noexcept
+            {
+                x = clamp(x, -126.0f, 127.0f);
+                const int32_t n = roundToInt(x);
+                return horner((x - (float)n) * LN2, ExpSeries<A>::c) * bitsToFloat((n + 127) << 23);
+            }
+
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            template <Accuracy A>
+            static __m128 vector(__m128 x) noexcept
+            {
+                x = clamp(x, -126.0f, 127.0f);
+                const __m128i n = _mm_cvtps_epi32(x);
+                const __m128 r = _mm_mul_ps(_mm_sub_ps(x, _mm_cvtepi32_ps(n)), _mm_set1_ps(LN2));
+                return _mm_mul_ps(horner(r, ExpSeries<A>::c), exp2Int(n));
+            }
+           #endif
+        };
+
+        // log x = e ln 2 + log m, x = m 2^e with m in [sqrt(1/2), sqrt(2))
+        struct Log
+        {
+            template <Accuracy A>
+            static float scalar(float x) noexcept
+            {
+                const int32_t bits = floatToBits(std::max(x, MIN_NORMAL));
+                int32_t e = (bits >> 23) - 127;
+                float m = bitsToFloat((bits & 0x007fffff) | 0x3f800000);
+                if (m > SQRT2)
+                {
+                    m *= 0.5f;
+                    ++e;
+                }
+                const float s = (m - 1.0f) / (m + 1.0f);
+                return s * horner(s * s, LogSeries<A>::c) + (float)e * LN2_LO + (float)e * LN2_HI;
+            }
+
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            template <Accuracy A>
+            static __m128 vector(__m128 x) noexcept
+            {
+                const __m128i bits = _mm_castps_si128(_mm_max_ps(x, _mm_set1_ps(MIN_NORMAL)));
+                const __m128 m1 = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)),
+                                                                _mm_set1_epi32(0x3f800000)));
+                const __m128 high = _mm_cmpgt_ps(m1, _mm_set1_ps(SQRT2));
+                const __m128 m = select(high, _mm_mul_ps(m1, _mm_set1_ps(0.5f)), m1);
+                // The mask is -1 in the lanes that were halved
+                const __m128i e = _mm_sub_epi32(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)),
+                                                _mm_castps_si128(high));
+
+                const __m128 one = _mm_set1_ps(1.0f);
+                const __m128 s = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+                const __m128 ef = _mm_cvtepi32_ps(e);
+                return _mm_add_ps(_mm_add_ps(_mm_mul_ps(s, horner(_mm_mul_ps(s, s), LogSeries<A>::c)),
+                                             _mm_mul_ps(ef, _mm_set1_ps(LN2_LO))),
+                                  _mm_mul_ps(ef, _mm_set1_ps(LN2_HI)));
+            }
+           #endif
+        };
+
+        // Quadrant n = round(x / (pi/2)), r = x - n pi/2 in three steps; the
+        // quadrant swaps sin and cos and sets their signs
+        struct SinCos
+        {
+            template <Accuracy A>
+            static void scalar(float x, float& s, float& c) noexcept
+            {
+                const int32_t n = roundToInt(x * TWO_OVER_PI);
+                const float r = ((x - (float)n * PIO2_1) - (float)n * PIO2_2) - (float)n * PIO2_3;
+                const float r2 = r * r;
+                const float sinR = r + r * r2 * horner(r2, TrigSeries<A>::s);
+                const float cosR = horner(r2, TrigSeries<A>::c);
+
+                const bool swap = (n & 1) != 0;
+                s = (n & 2) != 0 ? -(swap ? cosR : sinR) : (swap ? cosR : sinR);
+                c = ((n + 1) & 2) != 0 ? -(swap ? sinR : cosR) : (swap ? sinR : cosR);
+            }
+
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            template <Accuracy A>
+            static void vector(__m128 x, __m128& s, __m128& c) noexcept
+            {
+                const __m128i n = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TWO_OVER_PI)));
+                const __m128 nf = _mm_cvtepi32_ps(n);
+                const __m128 r = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(nf, _mm_set1_ps(PIO2_1))),
+                                                       _mm_mul_ps(nf, _mm_set1_ps(PIO2_2))),
+                                            _mm_mul_ps(nf, _mm_set1_ps(PIO2_3)));
+                const __m128 r2 = _mm_mul_ps(r, r);
+                const __m128 sinR = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), horner(r2, TrigSeries<A>::s)));
+                const __m128 cosR = horner(r2, TrigSeries<A>::c);
+
+                const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+                const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(n, one), one));
+                const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(n, two), 30));
+                const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(n, one), two), 30));
+                s = _mm_xor_ps(select(swap, cosR, sinR), sinSign);
+                c = _mm_xor_ps(select(swap, sinR, cosR), cosSign);
+            }
+           #endif
+        };
+
+        // Runs fn with the accuracy as a compile-time constant
+        template <typename Fn>
+        inline decltype(auto) withAccuracy(Accuracy a, Fn&& fn) noexcept
+        {
+            switch (a)
+            {
+                case Accuracy::Coarse: return fn(std::integral_constant<Accuracy, Accuracy::Coarse>{});
+                case Accuracy::Medium: return fn(std::integral_constant<Accuracy, Accuracy::Medium>{});
+                case Accuracy::Fine:   break;
+            }
+            return fn(std::integral_constant<Accuracy, Accuracy::Fine>{});
+        }
+
+        template <typename F>
+        inline float apply(float x, Accuracy a) noexcept
+        {
+            return withAccuracy(a, [x](auto acc) { return F::template scalar<decltype(acc)::value>(x); });
+        }
+
+       #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+        template <typename F>
+        inline __m128 applyVector(__m128 x, Accuracy a) noexcept
+        {
+            return withAccuracy(a, [x](auto acc) { return F::template vector<decltype(acc)::value>(x); });
+        }
+       #endif
+
+        template <typename F>
+        inline void applyBlock(const float* in, float* out, int numSamples, Accuracy a) noexcept
+        {
+            withAccuracy(a, [=](auto acc) {
+                constexpr Accuracy A = decltype(acc)::value;
+                int i = 0;
+               #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+                for (; i + 4 <= numSamples; i += 4)
+                    _mm_storeu_ps(out + i, F::template vector<A>(_mm_loadu_ps(in + i)));
+               #endif
+                for (; i < numSamples; ++i)
+                    out[i] = F::template scalar<A>(in[i]);
+            });
+        }
+    }
+
+    inline float tanh(float x, Accuracy a = Accuracy::Fine) noexcept { return detail::apply<detail::Tanh>(x, a); }
+    inline float exp(float x, Accuracy a = Accuracy::Fine) noexcept { return detail::apply<detail::Exp>(x, a); }
+    inline float pow2(float x, Accuracy a = Accuracy::Fine) noexcept { return detail::apply<detail::Pow2>(x, a); }
+    inline float log(float x, Accuracy a = Accuracy::Fine) noexcept { return detail::apply<detail::Log>(x, a); }
+
+    inline void sincos(float x, float& s, float& c, Accuracy a = Accuracy::Fine) noexcept
+    {
+        detail::withAccuracy(a, [&](auto acc) { detail::SinCos::scalar<decltype(acc)::value>(x, s, c); });
+    }
+
+    inline float sin(float x, Accuracy a = Accuracy::Fine) noexcept { float s, c; sincos(x, s, c, a); return s; }
+    inline float cos(float x, Accuracy a = Accuracy::Fine) noexcept { float s, c; sincos(x, s, c, a); return c; }
+
+    // 10^(dB/20) and its inverse, for coefficients worked out per block
+    inline float dbToGain(float db, Accuracy a = Accuracy::Fine) noexcept { return pow2(db * 0.166096404744368118f, a); }
+    inline float gainToDb(float gain, Accuracy a = Accuracy::Fine) noexcept { return log(gain, a) * 8.68588963806503655f; }
+
+    // Block forms over numSamples values; out may be in
+    inline void tanh(const float* in, float* out, int numSamples, Accuracy a = Accuracy::Fine) noexcept { detail::applyBlock<detail::Tanh>(in, out, numSamples, a); }
+    inline void exp(const float* in, float* out, int numSamples, Accuracy a = Accuracy::Fine) noexcept { detail::applyBlock<detail::Exp>(in, out, numSamples, a); }
+    inline void pow2(const float* in, float* out, int numSamples, Accuracy a = Accuracy::Fine) noexcept { detail::applyBlock<detail::Pow2>(in, out, numSamples, a); }
+    inline void log(const float* in, float* out, int numSamples, Accuracy a = Accuracy::Fine) noexcept { detail::applyBlock<detail::Log>(in, out, numSamples, a); }
+
+   #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    // Four lanes, for SSE loops of an engine's own
+    inline __m128 tanh(__m128 x, Accuracy a = Accuracy::Fine) noexcept { return detail::applyVector<detail::Tanh>(x, a); }
+    inline __m128 exp(__m128 x, Accuracy a = Accuracy::Fine) noexcept { return detail::applyVector<detail::Exp>(x, a); }
+    inline __m128 pow2(__m128 x, Accuracy a = Accuracy::Fine) noexcept { return detail::applyVector<detail::Pow2>(x, a); }
+    inline __m128 log(__m128 x, Accuracy a = Accuracy::Fine) noexcept { return detail::applyVector<detail::Log>(x, a); }
+
+    inline void sincos(__m128 x, __m128& s, __m128& c, Accuracy a = Accuracy::Fine) noexcept
+    {
+        detail::withAccuracy(a, [&](auto acc) { detail::SinCos::vector<decltype(acc)::value>(x, s, c); });
+    }
+   #endif
+
+    inline void sincos(const float* in, float* sinOut, float* cosOut, int numSamples, Accuracy a = Accuracy::Fine) noexcept
+    {
+        detail::withAccuracy(a, [=](auto acc) {
+            constexpr Accuracy A = decltype(acc)::value;
+            int i = 0;
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                __m128 s, c;
+                detail::SinCos::vector<A>(_mm_loadu_ps(in + i), s, c);
+                _mm_storeu_ps(sinOut + i, s);
+                _mm_storeu_ps(cosOut + i, c);
+            }
+           #endif
+            for (; i < numSamples; ++i)
+                detail::SinCos::scalar<A>(in[i], sinOut[i], cosOut[i]);
+        });
+    }
+}
\ No newline at end of file
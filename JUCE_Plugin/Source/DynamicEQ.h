@@ -1,6 +1,7 @@
 #pragma once
 #include "EngineBase.h"
 #include "DspEngineUtilities.h"
+#include "SlidingWindowPeak.h"
 #include <vector>
 #include <array>
 #include <cmath>
@@ -140,9 +141,10 @@ private:
         // Lookup table for gain reduction (eliminates log/exp per sample)
         std::array<float, GAIN_CURVE_SIZE> gainCurve;
 
-        // Lookahead delay line
+        // Lookahead delay line and the running peak over it
         std::array<float, LOOKAHEAD_SAMPLES> delayLine;
         int delayIndex = 0;
+        SlidingWindowPeak lookaheadPeak;
 
         // Envelope detection
         float envelope = 0.0f;
@@ -153,6 +155,10 @@ private:
         float smoothedGain = 1.0f;
         float gainSmoothCoeff = 0.999f; // Very smooth
         
+        DynamicProcessor() {
+            lookaheadPeak.prepare(LOOKAHEAD_SAMPLES);
+        }
+        
         // Build gain reduction lookup table (called when parameters change)
         // This table maps LINEAR envelope levels to gain reduction values
         // Index 0 = 0.0 (silence), Index GAIN_CURVE_SIZE-1 = 1.0 (0dBFS)
@@ -204,11 +210,8 @@ private:
             // Advance delay index
             delayIndex = (delayIndex + 1) % LOOKAHEAD_SAMPLES;
             
-            // Peak detection with lookahead
-            float peak = 0.0f;
-            for (int i = 0; i < LOOKAHEAD_SAMPLES; ++i) {
-                peak = std::max(peak, std::abs(delayLine[i]));
-            }
+            // Peak over everything in the delay line, amortised O(1)
+            float peak = lookaheadPeak.process(std::abs(input));
             
             // Envelope following
             float targetEnv = peak;
@@ -241,6 +244,7 @@ private:
             delayLine.fill(0.0f);
             gainCurve.fill(1.0f); // Initialize to unity gain (will be rebuilt on first use)
             delayIndex = 0;
+            lookaheadPeak.reset();
             envelope = 0.0f;
             smoothedGain = 1.0f;
             attackCoeff = 0.0f;
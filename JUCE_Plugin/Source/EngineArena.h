@@ -0,0 +1,119 @@
+// EngineArena.h - One contiguous, cache-aligned block for an engine's buffers
+//
+// Engines used to hold their delay lines, FIR histories and scratch in a
+// std::vector each: dozens of separate heap blocks per instance, scattered
+// wherever the allocator put them. An EngineArena hands out those buffers from
+// one block instead, in the order they are requested, each starting on a
+// cache line, so buffers used together sit together and the engine's state is
+// freed in one step when the engine is destroyed.
+//
+// Every EngineBase owns one (EngineBase::m_arena). The contract is:
+//  - prepareToPlay() calls rewind(), then allocate() for each buffer. This is
+//    the only place the arena may allocate.
+//  - process() and reset() only read and write the blocks handed out.
+// rewind() invalidates every earlier block. The storage is kept: if the
+// previous layout overflowed into extra chunks they are merged into one block
+// sized for it (a single allocation), after which preparing again at the same
+// settings reuses that block without touching the heap.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+class EngineArena {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    EngineArena() = default;
+    EngineArena(const EngineArena&) = delete;
+    EngineArena& operator=(const EngineArena&) = delete;
+
+    // Message thread, owner not processing: starts a new layout
+    void rewind() {
+        if (chunks.size() > 1) {
+            size_t total = 0;
+            for (const auto& chunk : chunks)
+                total += chunk.size;
+            chunks.clear();
+            addChunk(total);
+        }
+
+        for (auto& chunk : chunks)
+            chunk.used = 0;
+        current = 0;
+    }
+
+    // Message thread: `count` zeroed Ts starting on a cache line. Never null;
+    // a zero count still returns a distinct, aligned address.
+    template <typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T> && alignof(T) <= ALIGNMENT,
+                      "The arena never runs destructors");
+
+        const size_t bytes = roundUp(std::max<size_t>(1, count) * sizeof(T));
+
+        if (chunks.empty() || chunks[current].used + bytes > chunks[current].size) {
+            // Later chunks are only ever appended, so blocks already handed out stay put
+            current = chunks.size();
+            addChunk(std::max(bytes, chunks.empty() ? MIN_CHUNK_BYTES : chunks.back().size));
+        }
+
+        auto& chunk = chunks[current];
+        auto* block = chunk.base + chunk.used;
+        chunk.used += bytes;
+        std::memset(block, 0, bytes);
+        return reinterpret_cast<T*>(block);
+    }
+
+    // Frees all storage; every block handed out becomes invalid
+    void release() noexcept {
+        chunks.clear();
+        current = 0;
+    }
+
+    // Bytes handed out since the last rewind(), and bytes held
+    size_t getUsedBytes() const noexcept {
+        size_t used = 0;
+        for (const auto& chunk : chunks)
+            used += chunk.used;
+        return used;
+    }
+
+    size_t getCapacityBytes() const noexcept {
+        size_t capacity = 0;
+        for (const auto& chunk : chunks)
+            capacity += chunk.size;
+        return capacity;
+    }
+
+    size_t getNumChunks() const noexcept { return chunks.size(); }
+
+private:
+    static constexpr size_t MIN_CHUNK_BYTES = 16 * 1024;
+
+    struct Chunk {
+        std::unique_ptr<std::byte[]> storage;
+        std::byte* base = nullptr;  // storage rounded up to ALIGNMENT
+        size_t size = 0;
+        size_t used = 0;
+    };
+
+    static size_t roundUp(size_t bytes) noexcept { return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+    void addChunk(size_t bytes) {
+        Chunk chunk;
+        chunk.size = roundUp(bytes);
+        chunk.storage.reset(new std::byte[chunk.size + ALIGNMENT]);
+        const auto address = reinterpret_cast<std::uintptr_t>(chunk.storage.get());
+        chunk.base = chunk.storage.get() + (ALIGNMENT - address % ALIGNMENT) % ALIGNMENT;
+        chunks.push_back(std::move(chunk));
+    }
+
+    std::vector<Chunk> chunks;
+    size_t current = 0;
+};
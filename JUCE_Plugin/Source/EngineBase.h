@@ -1,17 +1,65 @@
 #pragma once
 
 #include "../JuceLibraryCode/JuceHeader.h"
+#include "SlotConfiguration.h"
+#include "EngineArena.h"
+#include <array>
+#include <cstdint>
 #include <map>
 
 class EngineBase {
 public:
+    EngineBase() {
+        // All keys inserted up front so the compatibility path below only
+        // overwrites values and never allocates on the audio thread
+        for (int i = 0; i < ParameterSnapshot::NUM_PARAMS; ++i) {
+            m_legacyParameters[i] = 0.5f;
+        }
+    }
     virtual ~EngineBase() = default;
     
+    // Fixed-size parameter block the processor delivers once per block.
+    // Bit i of `dirtyMask` is set when values[i] changed since the previous
+    // delivery (every bit on the first delivery to an engine); `version`
+    // increments with each delivery that changed anything.
+    struct ParameterSnapshot {
+        static constexpr int NUM_PARAMS = 15;
+        static constexpr uint32_t ALL_DIRTY = (1u << NUM_PARAMS) - 1u;
+        
+        std::array<float, NUM_PARAMS> values{};
+        uint32_t dirtyMask = 0;
+        uint32_t version = 0;
+        
+        bool isDirty(int index) const noexcept { return ((dirtyMask >> index) & 1u) != 0; }
+        
+        // Calls fn(index, value) for every changed parameter
+        template <typename Fn>
+        void forEachDirty(Fn&& fn) const {
+            for (int i = 0; i < NUM_PARAMS && (dirtyMask >> i) != 0; ++i) {
+                if (isDirty(i)) fn(i, values[static_cast<size_t>(i)]);
+            }
+        }
+    };
+    
     // ========== Existing Core API ==========
     virtual void prepareToPlay(double sampleRate, int samplesPerBlock) = 0;
     virtual void process(juce::AudioBuffer<float>& buffer) = 0;
     virtual void reset() = 0;  // Clear all internal state
     virtual void updateParameters(const std::map<int, float>& params) = 0;
+    
+    // Preferred parameter path, called by the processor on the audio thread.
+    // Migrated engines override this and recompute only what depends on the
+    // dirty parameters. The default forwards the full parameter set to the
+    // map-based updateParameters() - but only when something changed, so
+    // idle knobs cost nothing either way.
+    virtual void updateParameterSnapshot(const ParameterSnapshot& snapshot) {
+        if (snapshot.dirtyMask == 0) return;
+        for (int i = 0; i < ParameterSnapshot::NUM_PARAMS; ++i) {
+            m_legacyParameters[i] = snapshot.values[static_cast<size_t>(i)];
+        }
+        updateParameters(m_legacyParameters);
+    }
+    
     virtual juce::String getName() const = 0;
     virtual int getNumParameters() const = 0;
     virtual juce::String getParameterName(int index) const = 0;
@@ -22,12 +70,43 @@ public:
     // Override this for lookahead limiters, FFT/OLA processors, linear-phase filters, etc.
     virtual int getLatencySamples() const noexcept { return 0; }
     
+    // Samples of input the engine still needs before its output is valid
+    // (pitch-shifter buffer priming etc). The processor pre-rolls incoming
+    // engines with silence on a background thread until this reaches zero.
+    virtual int getWarmupSamples() const noexcept { return 0; }
+    
+    // How long the output keeps ringing after the input goes silent, for the
+    // current settings. The processor stops calling idle engines once input
+    // has been silent for this long (plus latency) and the output is quiet,
+    // so reverbs, delays and resonators must override it. Engines that run
+    // forever (freeze, infinite feedback) return ENGINE_TAIL_MAX_SECONDS;
+    // their output never goes quiet, so they are never put to sleep anyway.
+    virtual double getTailLengthSeconds() const noexcept { return 0.0; }
+    
+    // Tail of a recirculating loop: passes needed for `feedbackGain` per pass
+    // to fall by ENGINE_TAIL_THRESHOLD_DB, times the loop length
+    static double getFeedbackTailSeconds(double loopSeconds, double feedbackGain) noexcept {
+        const double gain = std::abs(feedbackGain);
+        if (gain <= 1.0e-6) return loopSeconds;
+        if (gain >= 0.9999) return ChimeraConfig::ENGINE_TAIL_MAX_SECONDS;
+        const double passes = ChimeraConfig::ENGINE_TAIL_THRESHOLD_DB / (20.0 * std::log10(gain));
+        return juce::jmin((double) ChimeraConfig::ENGINE_TAIL_MAX_SECONDS, loopSeconds * (1.0 + passes));
+    }
+    
     // DAWs may change block size at runtime; this hint lets engines pre-allocate safely
     // Called before prepareToPlay() and whenever max block size changes
     virtual void setMaxBlockSizeHint(int maxBlockSize) { 
         juce::ignoreUnused(maxBlockSize); 
     }
     
+    // Engines that allocate a mode's buffers only once the mode is selected
+    // (see DeferredBuffer.h) return true here when the selected mode's are
+    // missing; safe to call from any thread. The processor then calls
+    // performDeferredAllocation() on the message thread - before publishing a
+    // newly loaded engine, or asynchronously when a live engine switches mode.
+    virtual bool needsDeferredAllocation() const noexcept { return false; }
+    virtual void performDeferredAllocation() {}
+    
     // Channel/layout awareness (default: handle inside prepareToPlay)
     // Useful for engines that need different processing for mono/stereo/surround
     virtual void setNumChannels(int numIn, int numOut) { 
@@ -65,7 +144,10 @@ public:
         juce::ignoreUnused(p); 
     }
     
-    // Quality/CPU tradeoff setting
+    // Quality/CPU tradeoff setting. Engines start at Ultra; the processor's
+    // CpuGovernor steps them down under load. Called on the audio thread
+    // between process() calls, so it must not allocate or block - defer any
+    // heavy rebuild to the next process() or a background thread.
     enum class Quality {
         Draft,      // Lowest CPU, suitable for live/tracking
         Normal,     // Balanced quality/CPU
@@ -76,6 +158,12 @@ public:
         juce::ignoreUnused(q);
     }
     
+    // True when the tier moves getLatencySamples() (the pitch shifters). The
+    // governor leaves such engines at Ultra so CPU load never changes the
+    // latency a host is compensating for mid-playback; live tracking and
+    // offline renders, which the user or host chose, still switch them.
+    virtual bool qualityChangesLatency() const noexcept { return false; }
+    
     // Sidechain input support (for compressors, gates, vocoders, etc.)
     virtual void processSidechain(juce::AudioBuffer<float>& mainBuffer, 
                                  const juce::AudioBuffer<float>& sidechainBuffer) {
@@ -99,4 +187,16 @@ public:
         juce::ignoreUnused(f);
         return false; 
     }
+    
+    // Heap bytes held in the engine's arena (see m_arena)
+    size_t getArenaBytes() const noexcept { return m_arena.getCapacityBytes(); }
+    
+protected:
+    // Storage for the engine's buffers, freed with the engine. Migrated
+    // engines rewind it at the top of prepareToPlay and take every buffer
+    // from it there, so process() and reset() never reach the heap.
+    EngineArena m_arena;
+    
+private:
+    std::map<int, float> m_legacyParameters;
 };
\ No newline at end of file
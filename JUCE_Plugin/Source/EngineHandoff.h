@@ -0,0 +1,229 @@
+// EngineHandoff.h - Lock-free engine publication for the audio thread
+//
+// The message thread owns every engine; the audio thread only ever sees a raw
+// pointer loaded from an atomic slot. Replacing an engine is a single pointer
+// store. The outgoing engine is handed to EngineReclaimer, which destroys it on
+// a background thread once the audio thread can no longer be holding it.
+//
+// Safety is tracked with an epoch counter that the audio thread bumps on entry
+// to and exit from processBlock (odd = inside a block). An engine retired at
+// epoch e is safe to delete once the audio thread was idle at retire time
+// (e even) or has since left the block it was in (epoch > e).
+//
+// Engines that keep ringing out after being replaced (crossfaded transitions)
+// are retired against a "watch" pointer: the audio thread clears the watch when
+// it has finished with the engine, and the epoch rule is applied from then on.
+#pragma once
+
+#include "EngineBase.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class AudioEpoch {
+public:
+    // RAII marker placed at the top of processBlock
+    class ScopedBlock {
+    public:
+        explicit ScopedBlock(AudioEpoch& e) noexcept : epoch(e) { epoch.counter.fetch_add(1); }
+        ~ScopedBlock() noexcept { epoch.counter.fetch_add(1); }
+
+        ScopedBlock(const ScopedBlock&) = delete;
+        ScopedBlock& operator=(const ScopedBlock&) = delete;
+
+    private:
+        AudioEpoch& epoch;
+    };
+
+    uint64_t current() const noexcept { return counter.load(); }
+
+    static bool isSafeToReclaim(uint64_t retiredAt, uint64_t now) noexcept {
+        return (retiredAt & 1u) == 0 || now > retiredAt;
+    }
+
+private:
+    // Sequentially consistent on purpose: the writer's pointer store followed
+    // by its epoch load must not reorder against the reader's epoch increment
+    // followed by its pointer load
+    std::atomic<uint64_t> counter{0};
+};
+
+//==============================================================================
+// Deferred destruction of retired engines, off the audio and message threads
+class EngineReclaimer : private juce::Thread {
+public:
+    explicit EngineReclaimer(const AudioEpoch& epochToWatch)
+        : juce::Thread("Chimera Engine Reclaimer"), epoch(epochToWatch) {
+        startThread();
+    }
+
+    ~EngineReclaimer() override {
+        stopThread(2000);
+        // The owning processor has stopped audio by now - release everything
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        retired.clear();
+    }
+
+    // Called on the message thread right after the replacement was published
+    void retire(std::unique_ptr<EngineBase> engine) {
+        if (engine == nullptr)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(retiredMutex);
+            retired.push_back({ std::move(engine), epoch.current(), nullptr });
+        }
+        notify();
+    }
+
+    // Retire an engine the audio thread is still allowed to use through
+    // `watch`. It is destroyed only after the watch stops pointing at it
+    // (the audio thread finished its tail, or a newer transition replaced it).
+    void retireWhenReleased(std::unique_ptr<EngineBase> engine, const std::atomic<EngineBase*>& watch) {
+        if (engine == nullptr)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(retiredMutex);
+            retired.push_back({ std::move(engine), 0, &watch });
+        }
+        notify();
+    }
+
+    // Synchronous drain for callers that know audio is stopped
+    // (releaseResources, destructor). Destroys only what is already safe.
+    void reclaimNow() { collect(); }
+
+    size_t getNumPending() const {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        return retired.size();
+    }
+
+private:
+    struct RetiredEngine {
+        std::unique_ptr<EngineBase> engine;
+        uint64_t retiredAt = 0;
+        const std::atomic<EngineBase*>* watch = nullptr;  // null once released
+    };
+
+    void run() override {
+        while (!threadShouldExit()) {
+            collect();
+            wait(50);
+        }
+    }
+
+    void collect() {
+        // Move safe engines out under the lock, destroy them after releasing
+        // it so a slow destructor never blocks retire() on the message thread
+        std::vector<std::unique_ptr<EngineBase>> toDestroy;
+        {
+            std::lock_guard<std::mutex> lock(retiredMutex);
+            const auto now = epoch.current();
+            for (auto it = retired.begin(); it != retired.end();) {
+                if (it->watch != nullptr) {
+                    if (it->watch->load() == it->engine.get()) {
+                        ++it;
+                        continue;
+                    }
+
+                    // Released - start the normal epoch wait from here
+                    it->watch = nullptr;
+                    it->retiredAt = now;
+                }
+
+                if (AudioEpoch::isSafeToReclaim(it->retiredAt, now)) {
+                    toDestroy.push_back(std::move(it->engine));
+                    it = retired.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        toDestroy.clear();
+    }
+
+    const AudioEpoch& epoch;
+    mutable std::mutex retiredMutex;
+    std::vector<RetiredEngine> retired;
+
+    JUCE_DECLARE_NON_COPYABLE(EngineReclaimer)
+};
+
+//==============================================================================
+// Background pre-roll for engines that need priming before they go live.
+// Each job feeds silence through the engine until getWarmupSamples() reaches
+// zero (capped), then hands the warm engine to its completion callback on the
+// primer thread.
+class EnginePrimer : private juce::Thread {
+public:
+    using Completion = std::function<void(std::unique_ptr<EngineBase>)>;
+
+    EnginePrimer() : juce::Thread("Chimera Engine Primer") {
+        startThread();
+    }
+
+    ~EnginePrimer() override {
+        stopThread(4000);
+    }
+
+    void prime(std::unique_ptr<EngineBase> engine, int numChannels, int blockSize,
+               int maxPrimeSamples, Completion onPrimed) {
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            jobs.push_back({ std::move(engine), numChannels, blockSize, maxPrimeSamples, std::move(onPrimed) });
+        }
+        notify();
+    }
+
+    // Synchronous pre-roll, usable from any non-audio thread
+    static void primeNow(EngineBase& engine, int numChannels, int blockSize, int maxPrimeSamples) {
+        blockSize = juce::jmax(1, blockSize);
+        juce::AudioBuffer<float> silence(juce::jmax(1, numChannels), blockSize);
+
+        for (int primed = 0; engine.getWarmupSamples() > 0 && primed < maxPrimeSamples; primed += blockSize) {
+            silence.clear();
+            engine.process(silence);
+        }
+    }
+
+private:
+    struct Job {
+        std::unique_ptr<EngineBase> engine;
+        int numChannels = 2;
+        int blockSize = 512;
+        int maxPrimeSamples = 0;
+        Completion onPrimed;
+    };
+
+    void run() override {
+        while (!threadShouldExit()) {
+            Job job;
+            {
+                std::lock_guard<std::mutex> lock(jobsMutex);
+                if (!jobs.empty()) {
+                    job = std::move(jobs.front());
+                    jobs.erase(jobs.begin());
+                }
+            }
+
+            if (job.engine == nullptr) {
+                wait(100);
+                continue;
+            }
+
+            primeNow(*job.engine, job.numChannels, job.blockSize, job.maxPrimeSamples);
+
+            if (job.onPrimed)
+                job.onPrimed(std::move(job.engine));
+        }
+    }
+
+    std::mutex jobsMutex;
+    std::vector<Job> jobs;
+
+    JUCE_DECLARE_NON_COPYABLE(EnginePrimer)
+};
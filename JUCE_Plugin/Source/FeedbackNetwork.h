@@ -21,6 +21,11 @@ public:
     juce::String getParameterName(int index) const override;
     juce::String getName() const override { return "Feedback Network"; }
     int getLatencySamples() const noexcept override { return latencySamples; }
+    double getTailLengthSeconds() const noexcept override {
+        // Self and cross feedback both recirculate through the same delay length
+        if (freeze > 0.5f) return ChimeraConfig::ENGINE_TAIL_MAX_SECONDS;
+        return getFeedbackTailSeconds(delayTimeSec, std::abs(feedback) + std::abs(crossFeed));
+    }
 
     enum ParamID {
         kDelayTime = 0,
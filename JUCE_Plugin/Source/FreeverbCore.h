@@ -0,0 +1,239 @@
+// FreeverbCore.h - Shared Freeverb tank for the plate, shimmer and gated reverbs
+//
+// Jezar's Freeverb (public domain): per channel, eight parallel lowpass-feedback
+// combs summed into four allpasses in series, with the right channel's delays
+// a few samples longer than the left's for stereo spread.
+//
+// All sixteen combs (eight a side, L and R in lockstep) run as SIMD lanes.
+// Their delay lines are interleaved in one ring of 16-float rows, so a sample
+// writes a single 64-byte row and each lane reads back its own delay's worth
+// of rows. The allpass lines interleave the same way, eight floats a row. Both
+// rings are power-of-two sized and share one write position, so wrapping is a
+// mask rather than a branch per filter, and both live in one cache-aligned
+// block taken from an EngineArena by prepare() - the engine's own, or one the
+// core keeps for itself.
+//
+// reset() does not clear the rings. Until every delay has been rewritten, a
+// ResetHorizon points the taps reaching back past the reset at a float that is
+// never written, so they read silence.
+//
+// With AVX2 the sixteen comb taps are two gathers; with SSE they are loaded
+// per lane and the filter arithmetic runs four lanes at a time; other targets
+// run the same lanes in scalar loops.
+#pragma once
+
+#include "EngineArena.h"
+#include "ResetHorizon.h"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    #include <xmmintrin.h>
+#endif
+
+class FreeverbCore {
+public:
+    static constexpr int NUM_COMBS = 8;
+    static constexpr int NUM_ALLPASSES = 4;
+
+    // Delay lengths in samples at 44.1 kHz, scaled to the sample rate
+    static constexpr int COMB_TUNING[NUM_COMBS] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+    static constexpr int ALLPASS_TUNING[NUM_ALLPASSES] = { 556, 441, 341, 225 };
+
+    // Message thread: sizes and clears the delay lines. The right channel's
+    // lines are stereoSpread samples (at 44.1 kHz) longer than the left's.
+    // This overload keeps the lines in the core's own arena.
+    void prepare(double sampleRate, int stereoSpread) {
+        ownArena.rewind();
+        prepare(sampleRate, stereoSpread, ownArena);
+    }
+
+    // As above, taking the lines from `arena`, which the caller has rewound
+    // and keeps alive for as long as the core is used
+    void prepare(double sampleRate, int stereoSpread, EngineArena& arena) {
+        const float srScale = static_cast<float>(sampleRate / 44100.0);
+
+        int longestComb = 1, longestAllpass = 1;
+        for (int i = 0; i < NUM_COMBS; ++i) {
+            combDelay[i] = std::max(1, static_cast<int>(COMB_TUNING[i] * srScale));
+            combDelay[NUM_COMBS + i] = std::max(1, static_cast<int>((COMB_TUNING[i] + stereoSpread) * srScale));
+            longestComb = std::max({ longestComb, combDelay[i], combDelay[NUM_COMBS + i] });
+        }
+
+        for (int i = 0; i < NUM_ALLPASSES; ++i) {
+            allpassDelay[2 * i] = std::max(1, static_cast<int>(ALLPASS_TUNING[i] * srScale));
+            allpassDelay[2 * i + 1] = std::max(1, static_cast<int>((ALLPASS_TUNING[i] + stereoSpread) * srScale));
+            longestAllpass = std::max({ longestAllpass, allpassDelay[2 * i], allpassDelay[2 * i + 1] });
+        }
+
+        // The comb ring is never the smaller, so the write position, which
+        // wraps with it, masks straight into the allpass ring too
+        allpassRows = rowsFor(longestAllpass);
+        combRows = std::max(rowsFor(longestComb), allpassRows);
+
+        const size_t combFloats = (size_t) combRows * COMB_LANES;
+        const size_t allpassFloats = (size_t) allpassRows * ALLPASS_LANES;
+        ringFloats = combFloats + allpassFloats;
+        combRing = arena.allocate<float>(ringFloats + 1);  // then the silent slot
+        allpassRing = combRing + combFloats;
+        horizon.prepare((size_t) std::max(longestComb, longestAllpass));
+
+        reset();
+    }
+
+    // Constant time: the rings' stale contents are hidden, not cleared
+    void reset() noexcept {
+        horizon.reset();
+        std::fill(std::begin(filterStore), std::end(filterStore), 0.0f);
+        writeRow = 0;
+    }
+
+    bool isPrepared() const noexcept { return combRing != nullptr; }
+
+    // Comb feedback: Freeverb's room size
+    void setCombFeedback(float feedback) noexcept { combFeedback = feedback; }
+
+    // Share of each comb's lowpass taken from its previous output
+    void setDamping(float damp) noexcept {
+        damp1 = damp;
+        damp2 = 1.0f - damp;
+    }
+
+    void setAllpassFeedback(float feedback) noexcept { allpassFeedback = feedback; }
+
+    // Bytes held by the delay lines
+    size_t getMemoryBytes() const noexcept { return ringFloats * sizeof(float); }
+
+    // One stereo sample. Each side's input feeds that side's combs; the outputs
+    // are the comb sums through the allpass chain, before Freeverb's fixed gain.
+    void processSample(float inL, float inR, float& outL, float& outR) noexcept {
+        if (combRing == nullptr) {
+            outL = outR = 0.0f;
+            return;
+        }
+
+        const int combMask = combRows - 1;
+        alignas(32) int32_t taps[COMB_LANES];
+        for (int lane = 0; lane < COMB_LANES; ++lane)
+            taps[lane] = ((writeRow - combDelay[lane]) & combMask) * COMB_LANES + lane;
+
+        const bool settled = horizon.isSettled();
+        if (!settled)
+            for (int lane = 0; lane < COMB_LANES; ++lane)
+                if (!horizon.isFresh((size_t) combDelay[lane] - 1))
+                    taps[lane] = (int32_t) ringFloats;
+
+        float* const combRow = combRing + writeRow * COMB_LANES;
+        float sumL, sumR;
+
+       #if defined(__AVX2__)
+        const __m256 feedback = _mm256_set1_ps(combFeedback);
+        const __m256 d1 = _mm256_set1_ps(damp1);
+        const __m256 d2 = _mm256_set1_ps(damp2);
+        __m128 sums[2];
+
+        for (int side = 0; side < 2; ++side) {
+            const int first = side * NUM_COMBS;
+            const __m256 out = _mm256_i32gather_ps(combRing, _mm256_load_si256((const __m256i*) (taps + first)), 4);
+            const __m256 store = _mm256_add_ps(_mm256_mul_ps(out, d2), _mm256_mul_ps(_mm256_load_ps(filterStore + first), d1));
+            _mm256_store_ps(filterStore + first, store);
+            _mm256_store_ps(combRow + first, _mm256_add_ps(_mm256_set1_ps(side == 0 ? inL : inR), _mm256_mul_ps(store, feedback)));
+            sums[side] = _mm_add_ps(_mm256_castps256_ps128(out), _mm256_extractf128_ps(out, 1));
+        }
+
+        horizontalSums(sums[0], sums[1], sumL, sumR);
+       #elif JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+        const __m128 feedback = _mm_set1_ps(combFeedback);
+        const __m128 d1 = _mm_set1_ps(damp1);
+        const __m128 d2 = _mm_set1_ps(damp2);
+        __m128 sums[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+
+        for (int first = 0; first < COMB_LANES; first += 4) {
+            const int side = first / NUM_COMBS;
+            const int32_t* t = taps + first;
+            const __m128 out = _mm_setr_ps(combRing[t[0]], combRing[t[1]], combRing[t[2]], combRing[t[3]]);
+            const __m128 store = _mm_add_ps(_mm_mul_ps(out, d2), _mm_mul_ps(_mm_load_ps(filterStore + first), d1));
+            _mm_store_ps(filterStore + first, store);
+            _mm_store_ps(combRow + first, _mm_add_ps(_mm_set1_ps(side == 0 ? inL : inR), _mm_mul_ps(store, feedback)));
+            sums[side] = _mm_add_ps(sums[side], out);
+        }
+
+        horizontalSums(sums[0], sums[1], sumL, sumR);
+       #else
+        float sums[2] = { 0.0f, 0.0f };
+        for (int lane = 0; lane < COMB_LANES; ++lane) {
+            const int side = lane / NUM_COMBS;
+            const float out = combRing[taps[lane]];
+            filterStore[lane] = out * damp2 + filterStore[lane] * damp1;
+            combRow[lane] = (side == 0 ? inL : inR) + filterStore[lane] * combFeedback;
+            sums[side] += out;
+        }
+        sumL = sums[0];
+        sumR = sums[1];
+       #endif
+
+        // Allpasses in series, the two sides in lockstep
+        const int allpassMask = allpassRows - 1;
+        float* const allpassRow = allpassRing + (writeRow & allpassMask) * ALLPASS_LANES;
+        for (int i = 0; i < NUM_ALLPASSES; ++i) {
+            const int left = 2 * i, right = 2 * i + 1;
+            float bufL = allpassRing[((writeRow - allpassDelay[left]) & allpassMask) * ALLPASS_LANES + left];
+            float bufR = allpassRing[((writeRow - allpassDelay[right]) & allpassMask) * ALLPASS_LANES + right];
+            if (!settled) {
+                bufL = horizon.isFresh((size_t) allpassDelay[left] - 1) ? bufL : 0.0f;
+                bufR = horizon.isFresh((size_t) allpassDelay[right] - 1) ? bufR : 0.0f;
+            }
+            allpassRow[left] = sumL + bufL * allpassFeedback;
+            allpassRow[right] = sumR + bufR * allpassFeedback;
+            sumL = bufL - sumL;
+            sumR = bufR - sumR;
+        }
+
+        writeRow = (writeRow + 1) & combMask;
+        horizon.advance();
+        outL = sumL;
+        outR = sumR;
+    }
+
+private:
+    static constexpr int COMB_LANES = 2 * NUM_COMBS;         // L combs, then R combs
+    static constexpr int ALLPASS_LANES = 2 * NUM_ALLPASSES;  // L/R pairs per stage
+
+   #if defined(__AVX2__) || JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    // Totals the four lanes of each side
+    static void horizontalSums(__m128 left, __m128 right, float& sumL, float& sumR) noexcept {
+        __m128 pairs = _mm_add_ps(_mm_unpacklo_ps(left, right), _mm_unpackhi_ps(left, right));
+        pairs = _mm_add_ps(pairs, _mm_movehl_ps(pairs, pairs));
+        sumL = _mm_cvtss_f32(pairs);
+        sumR = _mm_cvtss_f32(_mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1)));
+    }
+   #endif
+
+    // Smallest power of two longer than the delay
+    static int rowsFor(int delay) noexcept {
+        int rows = 1;
+        while (rows <= delay)
+            rows <<= 1;
+        return rows;
+    }
+
+    EngineArena ownArena;
+    float* combRing = nullptr;  // combFloats, then the allpass ring, then a float kept at zero
+    size_t ringFloats = 0;      // Both rings; the silent slot's offset from combRing
+    ResetHorizon horizon;
+    float* allpassRing = nullptr;
+    int combRows = 0;
+    int allpassRows = 0;
+    int writeRow = 0;
+
+    int combDelay[COMB_LANES] = {};
+    int allpassDelay[ALLPASS_LANES] = {};
+    alignas(32) float filterStore[COMB_LANES] = {};
+
+    float combFeedback = 0.0f;
+    float damp1 = 0.0f;
+    float damp2 = 1.0f;
+    float allpassFeedback = 0.5f;
+};
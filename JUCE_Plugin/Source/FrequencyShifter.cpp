@@ -66,12 +66,13 @@ FrequencyShifter::FrequencyShifter() {
     m_direction.setSmoothingRate(0.997f);
 }
 
-void FrequencyShifter::HilbertTransformer::initialize() {
+void FrequencyShifter::HilbertTransformer::initialize(EngineArena& arena) {
     // OPTIMIZED: Reduced from 65 to 33 taps for lower latency
     // Still provides >60dB image rejection
     const int OPTIMAL_LENGTH = 33;
-    coefficients.resize(OPTIMAL_LENGTH);
-    delayBuffer.resize(OPTIMAL_LENGTH);
+    length = OPTIMAL_LENGTH;
+    coefficients = arena.allocate<float>(length);
+    delayBuffer = arena.allocate<float>(length);
     
     const int center = OPTIMAL_LENGTH / 2;
     
@@ -103,7 +104,7 @@ void FrequencyShifter::HilbertTransformer::initialize() {
         }
     }
     
-    std::fill(delayBuffer.begin(), delayBuffer.end(), 0.0f);
+    std::fill(delayBuffer, delayBuffer + length, 0.0f);
     delayIndex = 0;
 }
 
@@ -117,13 +118,13 @@ std::complex<float> FrequencyShifter::HilbertTransformer::process(float input) {
 #ifdef HAS_SSE2
     // SSE2 optimized convolution
     __m128 sum = _mm_setzero_ps();
-    const int simdLength = (coefficients.size() / 4) * 4;
+    const int simdLength = (length / 4) * 4;
     
     for (int i = 0; i < simdLength; i += 4) {
-        int idx0 = (delayIndex - i + delayBuffer.size()) % delayBuffer.size();
-        int idx1 = (delayIndex - i - 1 + delayBuffer.size()) % delayBuffer.size();
-        int idx2 = (delayIndex - i - 2 + delayBuffer.size()) % delayBuffer.size();
-        int idx3 = (delayIndex - i - 3 + delayBuffer.size()) % delayBuffer.size();
+        int idx0 = (delayIndex - i + length) % length;
+        int idx1 = (delayIndex - i - 1 + length) % length;
+        int idx2 = (delayIndex - i - 2 + length) % length;
+        int idx3 = (delayIndex - i - 3 + length) % length;
         
         __m128 samples = _mm_set_ps(delayBuffer[idx3], delayBuffer[idx2], 
                                     delayBuffer[idx1], delayBuffer[idx0]);
@@ -136,42 +137,42 @@ std::complex<float> FrequencyShifter::HilbertTransformer::process(float input) {
     hilbertOutput = result[0] + result[1] + result[2] + result[3];
     
     // Handle remaining samples
-    for (size_t i = simdLength; i < coefficients.size(); ++i) {
-        int idx = (delayIndex - i + delayBuffer.size()) % delayBuffer.size();
+    for (size_t i = simdLength; i < length; ++i) {
+        int idx = (delayIndex - i + length) % length;
         hilbertOutput += delayBuffer[idx] * coefficients[i];
     }
 #else
     // Standard convolution
-    for (size_t i = 0; i < coefficients.size(); ++i) {
-        int idx = (delayIndex - i + delayBuffer.size()) % delayBuffer.size();
+    for (size_t i = 0; i < length; ++i) {
+        int idx = (delayIndex - i + length) % length;
         hilbertOutput += delayBuffer[idx] * coefficients[i];
     }
 #endif
     
     // Get delayed real part (compensate for filter delay)
-    int delayCompensation = coefficients.size() / 2;
-    int realIdx = (delayIndex - delayCompensation + delayBuffer.size()) % delayBuffer.size();
+    int delayCompensation = length / 2;
+    int realIdx = (delayIndex - delayCompensation + length) % length;
     float realPart = delayBuffer[realIdx];
     
     // Advance delay index
-    delayIndex = (delayIndex + 1) % delayBuffer.size();
+    delayIndex = (delayIndex + 1) % length;
     
     return std::complex<float>(realPart, hilbertOutput);
 }
 
 void FrequencyShifter::prepareToPlay(double sampleRate, int samplesPerBlock) {
     m_sampleRate = sampleRate;
+    m_arena.rewind();
     
     // Initialize channel states
     for (auto& state : m_channelStates) {
-        state.hilbert.initialize();
+        state.hilbert.initialize(m_arena);
         state.oscillatorPhase = 0.0f;
         state.modulatorPhase = 0.0f;
         
         // Smaller feedback buffer (50ms is plenty)
-        size_t feedbackSize = static_cast<size_t>(sampleRate * 0.05);
-        state.feedbackBuffer.resize(feedbackSize);
-        std::fill(state.feedbackBuffer.begin(), state.feedbackBuffer.end(), 0.0f);
+        state.feedbackSize = std::max<size_t>(1, static_cast<size_t>(sampleRate * 0.05));
+        state.feedbackBuffer = m_arena.allocate<float>(state.feedbackSize);
         state.feedbackIndex = 0;
         
         state.resonatorReal = 0.0f;
@@ -208,11 +209,11 @@ void FrequencyShifter::reset() {
     
     // Reset channel states
     for (auto& state : m_channelStates) {
-        std::fill(state.hilbert.delayBuffer.begin(), state.hilbert.delayBuffer.end(), 0.0f);
+        std::fill(state.hilbert.delayBuffer, state.hilbert.delayBuffer + state.hilbert.length, 0.0f);
         state.hilbert.delayIndex = 0;
         state.oscillatorPhase = 0.0f;
         state.modulatorPhase = 0.0f;
-        std::fill(state.feedbackBuffer.begin(), state.feedbackBuffer.end(), 0.0f);
+        std::fill(state.feedbackBuffer, state.feedbackBuffer + state.feedbackSize, 0.0f);
         state.feedbackIndex = 0;
         state.resonatorReal = 0.0f;
         state.resonatorImag = 0.0f;
@@ -337,7 +338,7 @@ void FrequencyShifter::process(juce::AudioBuffer<float>& buffer) {
             
             // Store in feedback buffer
             state.feedbackBuffer[state.feedbackIndex] = output;
-            state.feedbackIndex = (state.feedbackIndex + 1) % state.feedbackBuffer.size();
+            state.feedbackIndex = (state.feedbackIndex + 1) % state.feedbackSize;
             
             // DC blocking on output
             output = m_outputDCBlockers[channel].process(output);
@@ -20,6 +20,11 @@ public:
     juce::String getParameterName(int index) const override;
     juce::String getName() const override { return "Frequency Shifter"; }
     
+    // 50 ms feedback loop, fed back at up to half the feedback amount
+    double getTailLengthSeconds() const noexcept override {
+        return getFeedbackTailSeconds(0.05, m_feedback.target * 0.5f);
+    }
+    
 private:
     // Parameters with smoothing
     struct SmoothParam {
@@ -53,11 +58,12 @@ private:
     // Hilbert transformer for analytic signal
     struct HilbertTransformer {
         static constexpr int HILBERT_LENGTH = 65;
-        std::vector<float> coefficients;
-        std::vector<float> delayBuffer;
+        float* coefficients = nullptr;  // length taps each, from the engine's arena
+        float* delayBuffer = nullptr;
+        size_t length = 0;
         int delayIndex = 0;
         
-        void initialize();
+        void initialize(EngineArena& arena);
         std::complex<float> process(float input);
     };
     
@@ -65,7 +71,8 @@ private:
         HilbertTransformer hilbert;
         float oscillatorPhase = 0.0f;
         float modulatorPhase = 0.0f;
-        std::vector<float> feedbackBuffer;
+        float* feedbackBuffer = nullptr;
+        size_t feedbackSize = 0;
         int feedbackIndex = 0;
         
         // Resonant filter state
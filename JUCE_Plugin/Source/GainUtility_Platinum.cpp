@@ -615,18 +615,26 @@ void GainUtility_Platinum::reset() {
 
 void GainUtility_Platinum::updateParameters(const std::map<int, float>& params) {
     for (const auto& [index, value] : params) {
-        switch (static_cast<ParamID>(index)) {
-            case ParamID::GAIN:         pImpl->params.gain.store(value); break;
-            case ParamID::GAIN_L:       pImpl->params.gainL.store(value); break;
-            case ParamID::GAIN_R:       pImpl->params.gainR.store(value); break;
-            case ParamID::GAIN_MID:     pImpl->params.gainMid.store(value); break;
-            case ParamID::GAIN_SIDE:    pImpl->params.gainSide.store(value); break;
-            case ParamID::MODE:         pImpl->params.mode.store(value); break;
-            case ParamID::PHASE_L:      pImpl->params.phaseL.store(value); break;
-            case ParamID::PHASE_R:      pImpl->params.phaseR.store(value); break;
-            case ParamID::CHANNEL_SWAP: pImpl->params.channelSwap.store(value); break;
-            case ParamID::AUTO_GAIN:    pImpl->params.autoGain.store(value); break;
-        }
+        setParameter(index, value);
+    }
+}
+
+void GainUtility_Platinum::updateParameterSnapshot(const ParameterSnapshot& snapshot) {
+    snapshot.forEachDirty([this](int index, float value) { setParameter(index, value); });
+}
+
+void GainUtility_Platinum::setParameter(int index, float value) {
+    switch (static_cast<ParamID>(index)) {
+        case ParamID::GAIN:         pImpl->params.gain.store(value); break;
+        case ParamID::GAIN_L:       pImpl->params.gainL.store(value); break;
+        case ParamID::GAIN_R:       pImpl->params.gainR.store(value); break;
+        case ParamID::GAIN_MID:     pImpl->params.gainMid.store(value); break;
+        case ParamID::GAIN_SIDE:    pImpl->params.gainSide.store(value); break;
+        case ParamID::MODE:         pImpl->params.mode.store(value); break;
+        case ParamID::PHASE_L:      pImpl->params.phaseL.store(value); break;
+        case ParamID::PHASE_R:      pImpl->params.phaseR.store(value); break;
+        case ParamID::CHANNEL_SWAP: pImpl->params.channelSwap.store(value); break;
+        case ParamID::AUTO_GAIN:    pImpl->params.autoGain.store(value); break;
     }
 }
 
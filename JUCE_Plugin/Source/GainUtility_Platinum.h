@@ -50,6 +50,7 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void updateParameterSnapshot(const ParameterSnapshot& snapshot) override;
     
     // Parameter info
     int getNumParameters() const override { return 10; }
@@ -102,6 +103,8 @@ public:
     std::array<float, 2> getPhaseCorrelation() const;  // L/R correlation
     
 private:
+    void setParameter(int index, float value);
+    
     class Impl;
     std::unique_ptr<Impl> pImpl;
 };
\ No newline at end of file
@@ -3,113 +3,20 @@
 // Based on classic 80s gated reverb techniques
 
 #include "GatedReverb.h"
+#include "FreeverbCore.h"
 #include <JuceHeader.h>
 #include <cmath>
 #include <algorithm>
 
 namespace {
     // Freeverb constants
-    const int numCombs = 8;
-    const int numAllpasses = 4;
     const float fixedGain = 0.015f;
     const float scaleDamp = 0.4f;
     const float scaleRoom = 0.28f;
     const float offsetRoom = 0.7f;
     const int stereoSpread = 23;
-    
-    const int combTuning[8] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
-    const int allpassTuning[4] = { 556, 441, 341, 225 };
 }
 
-// Comb filter from Freeverb
-class Comb {
-public:
-    void setBuffer(float *buf, int size) {
-        buffer = buf;
-        bufferSize = size;
-        bufferIndex = 0;
-    }
-    
-    void mute() {
-        if (buffer) {
-            std::fill(buffer, buffer + bufferSize, 0.0f);
-        }
-        filterStore = 0.0f;
-    }
-    
-    void setDamp(float val) {
-        damp1 = val;
-        damp2 = 1.0f - val;
-    }
-    
-    void setFeedback(float val) {
-        feedback = val;
-    }
-    
-    float process(float input) {
-        if (!buffer || bufferSize == 0) return 0.0f;
-        
-        float output = buffer[bufferIndex];
-        filterStore = (output * damp2) + (filterStore * damp1);
-        buffer[bufferIndex] = input + (filterStore * feedback);
-        
-        if (++bufferIndex >= bufferSize) {
-            bufferIndex = 0;
-        }
-        
-        return output;
-    }
-    
-private:
-    float *buffer = nullptr;
-    int bufferSize = 0;
-    int bufferIndex = 0;
-    float filterStore = 0.0f;
-    float damp1 = 0.0f;
-    float damp2 = 1.0f;
-    float feedback = 0.0f;
-};
-
-// Allpass filter from Freeverb
-class Allpass {
-public:
-    void setBuffer(float *buf, int size) {
-        buffer = buf;
-        bufferSize = size;
-        bufferIndex = 0;
-    }
-    
-    void mute() {
-        if (buffer) {
-            std::fill(buffer, buffer + bufferSize, 0.0f);
-        }
-    }
-    
-    void setFeedback(float val) {
-        feedback = val;
-    }
-    
-    float process(float input) {
-        if (!buffer || bufferSize == 0) return 0.0f;
-        
-        float bufout = buffer[bufferIndex];
-        float output = -input + bufout;
-        buffer[bufferIndex] = input + (bufout * feedback);
-        
-        if (++bufferIndex >= bufferSize) {
-            bufferIndex = 0;
-        }
-        
-        return output;
-    }
-    
-private:
-    float *buffer = nullptr;
-    int bufferSize = 0;
-    int bufferIndex = 0;
-    float feedback = 0.5f;
-};
-
 // Gate envelope follower
 class GateEnvelope {
 public:
@@ -215,17 +122,8 @@ private:
 // Main GatedReverb implementation
 class GatedReverb::Impl {
 public:
-    // Freeverb components
-    Comb combL[numCombs];
-    Comb combR[numCombs];
-    Allpass allpassL[numAllpasses];
-    Allpass allpassR[numAllpasses];
-    
-    // Buffers
-    std::vector<float> combBufferL[numCombs];
-    std::vector<float> combBufferR[numCombs];
-    std::vector<float> allpassBufferL[numAllpasses];
-    std::vector<float> allpassBufferR[numAllpasses];
+    // Freeverb combs and allpasses, both channels
+    FreeverbCore tank;
     
     // Gate envelope
     GateEnvelope gate;
@@ -234,6 +132,7 @@ public:
     std::vector<float> predelayBufferL;
     std::vector<float> predelayBufferR;
     int predelayIndex = 0;
+    int predelayHighWater = 0;  // Slots written since reset(); the rest read as silence
     int predelaySize = 0;
     
     // Filters
@@ -269,34 +168,8 @@ public:
         // Initialize gate
         gate.init(sr);
         
-        // Calculate scaling for sample rate
-        float srScale = static_cast<float>(sr / 44100.0);
-        
-        // Initialize comb filters
-        for (int i = 0; i < numCombs; i++) {
-            int sizeL = static_cast<int>(combTuning[i] * srScale);
-            int sizeR = static_cast<int>((combTuning[i] + stereoSpread) * srScale);
-            
-            combBufferL[i].resize(sizeL);
-            combBufferR[i].resize(sizeR);
-            
-            combL[i].setBuffer(combBufferL[i].data(), sizeL);
-            combR[i].setBuffer(combBufferR[i].data(), sizeR);
-        }
-        
-        // Initialize allpass filters
-        for (int i = 0; i < numAllpasses; i++) {
-            int sizeL = static_cast<int>(allpassTuning[i] * srScale);
-            int sizeR = static_cast<int>((allpassTuning[i] + stereoSpread) * srScale);
-            
-            allpassBufferL[i].resize(sizeL);
-            allpassBufferR[i].resize(sizeR);
-            
-            allpassL[i].setBuffer(allpassBufferL[i].data(), sizeL);
-            allpassR[i].setBuffer(allpassBufferR[i].data(), sizeR);
-            allpassL[i].setFeedback(0.5f);
-            allpassR[i].setFeedback(0.5f);
-        }
+        // Delay lines scaled from their 44.1 kHz tunings
+        tank.prepare(sr, stereoSpread);
         
         // Initialize predelay
         int maxPredelay = static_cast<int>(0.2f * sr);
@@ -309,23 +182,15 @@ public:
     
     void reset() {
         // Clear Freeverb
-        for (int i = 0; i < numCombs; i++) {
-            combL[i].mute();
-            combR[i].mute();
-        }
-        
-        for (int i = 0; i < numAllpasses; i++) {
-            allpassL[i].mute();
-            allpassR[i].mute();
-        }
+        tank.reset();
         
         // Reset gate
         gate.reset();
         
-        // Clear predelay
-        std::fill(predelayBufferL.begin(), predelayBufferL.end(), 0.0f);
-        std::fill(predelayBufferR.begin(), predelayBufferR.end(), 0.0f);
+        // Clear predelay lazily: writes restart from slot 0, and slots at or
+        // above the high-water mark read as silence
         predelayIndex = 0;
+        predelayHighWater = 0;
         
         // Reset filter states
         lowCutStateL = 0.0f;
@@ -348,12 +213,8 @@ public:
         damping = dampingParam * scaleDamp;
         
         // Update comb filters
-        for (int i = 0; i < numCombs; i++) {
-            combL[i].setFeedback(roomSize);
-            combR[i].setFeedback(roomSize);
-            combL[i].setDamp(damping);
-            combR[i].setDamp(damping);
-        }
+        tank.setCombFeedback(roomSize);
+        tank.setDamping(damping);
         
         // Pre-delay
         predelaySize = static_cast<int>(predelayParam * 0.1f * sampleRate);
@@ -387,10 +248,12 @@ public:
             float delayedR = inputR;
             
             if (predelaySize > 0) {
-                delayedL = predelayBufferL[predelayIndex];
-                delayedR = predelayBufferR[predelayIndex];
+                const bool fresh = predelayIndex < predelayHighWater;
+                delayedL = fresh ? predelayBufferL[predelayIndex] : 0.0f;
+                delayedR = fresh ? predelayBufferR[predelayIndex] : 0.0f;
                 predelayBufferL[predelayIndex] = inputL;
                 predelayBufferR[predelayIndex] = inputR;
+                predelayHighWater = std::max(predelayHighWater, predelayIndex + 1);
                 
                 if (++predelayIndex >= predelaySize) {
                     predelayIndex = 0;
@@ -398,20 +261,8 @@ public:
             }
             
             // Process through Freeverb
-            float reverbL = 0.0f;
-            float reverbR = 0.0f;
-            
-            // Accumulate comb filters
-            for (int j = 0; j < numCombs; j++) {
-                reverbL += combL[j].process(delayedL);
-                reverbR += combR[j].process(delayedR);
-            }
-            
-            // Process through allpasses
-            for (int j = 0; j < numAllpasses; j++) {
-                reverbL = allpassL[j].process(reverbL);
-                reverbR = allpassR[j].process(reverbR);
-            }
+            float reverbL, reverbR;
+            tank.processSample(delayedL, delayedR, reverbL, reverbR);
             
             // Apply gain correction
             reverbL *= gain;
@@ -449,6 +300,11 @@ public:
         }
     }
     
+    // The gate closes once the input drops: hold, then release
+    double getTailLengthSeconds() const {
+        return predelayParam * 0.1 + (10.0 + holdParam * 490.0) / 1000.0 + (10.0 + releaseParam * 990.0) / 1000.0;
+    }
+    
     void setParameter(int index, float value) {
         value = std::clamp(value, 0.0f, 1.0f);
         
@@ -515,4 +371,8 @@ int GatedReverb::getNumParameters() const {
 
 juce::String GatedReverb::getName() const {
     return "Gated Reverb";
+}
+
+double GatedReverb::getTailLengthSeconds() const noexcept {
+    return pImpl->getTailLengthSeconds();
 }
\ No newline at end of file
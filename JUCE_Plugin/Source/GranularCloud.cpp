@@ -3,8 +3,10 @@
 #include "DspEngineUtilities.h"
 #include <algorithm>
 #include <cmath>
-#include <random>
-#include <chrono>
+
+#if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    #include <pmmintrin.h>  // SSE2 conversions and the denormals-are-zero flag
+#endif
 
 namespace {
 struct FTZGuard {
@@ -38,13 +40,14 @@ void GranularCloud::prepareToPlay(double sampleRate, int samplesPerBlock) {
     pCloudPosition.setTimeMs(30.f, sr_);
     pMix.setTimeMs(10.f, sr_);  // Fast mix response
 
-    // Circular buffer: 2 seconds
-    bufferSize_ = (int)std::ceil(2.0 * sr_);
-    circularBuffer_.resize(bufferSize_, 0.0f);
+    // Capture ring: at least 2 seconds, rounded up so wrapping is a mask
+    bufferSize_ = juce::nextPowerOfTwo((int)std::ceil(2.0 * sr_));
+    bufferMask_ = bufferSize_ - 1;
+    circularBuffer_.assign(bufferSize_, 0.0f);
 
     // Window table - IMPROVED Tukey window for better grain characteristics
     windowSize_ = 8192;
-    windowTable_.resize(windowSize_);
+    windowTable_.resize(windowSize_ + 1);
     const float alpha = 0.25f; // Tukey window parameter (0.25 = 25% fade in/out)
     for (int i = 0; i < windowSize_; ++i) {
         float phase = float(i) / float(windowSize_ - 1);
@@ -63,28 +66,31 @@ void GranularCloud::prepareToPlay(double sampleRate, int samplesPerBlock) {
         
         windowTable_[i] = window;
     }
+    windowTable_[windowSize_] = windowTable_[windowSize_ - 1];
 
     reset();
 }
 
 void GranularCloud::reset() {
     std::fill(circularBuffer_.begin(), circularBuffer_.end(), 0.0f);
-    writePos_ = 0;
-    grainTimer_ = 0.0;
-    nextGrainTime_ = 0.0;
-    
+    writeCount_ = 0;
+    samplesUntilGrain_ = 0.0;
+    grains_.numActive = 0;
+
     // Reset debug statistics
     grainStats_.reset();
+}
 
-    for (auto& g : grains_) {
-        g.active = false;
-        g.pos = 0.0;
-        g.increment = 1.0;
-        g.length = 0;
-        g.elapsed = 0;
-        g.amp = 0.0f;
-        g.pan = 0.5f;
-    }
+void GranularCloud::GrainPool::remove(int i) noexcept {
+    const int last = --numActive;
+    start[i] = start[last];
+    increment[i] = increment[last];
+    windowStep[i] = windowStep[last];
+    gainL[i] = gainL[last];
+    gainR[i] = gainR[last];
+    elapsed[i] = elapsed[last];
+    length[i] = length[last];
+    offset[i] = offset[last];
 }
 
 // -------------------------------------------------------
@@ -119,244 +125,239 @@ void GranularCloud::process(juce::AudioBuffer<float>& buffer) {
     const int N = buffer.getNumSamples();
     if (N <= 0) return;
 
-    // Pull smoothed params (block-rate)
-    const float grainMs  = pGrainSize.tick();
-    const float density  = pDensity.tick();
-    const float scatter  = pPitchScatter.tick();
-    const float position = pCloudPosition.tick();
-    const float mixAmount = pMix.tick();
-
-    // Derive grain spawn rate
-    const double grainInterval = 1.0 / std::max(0.1, (double)density);
-
     float* Lp = buffer.getWritePointer(0);
     float* Rp = (numCh > 1) ? buffer.getWritePointer(1) : nullptr;
 
-    // SAFETY: Bounded main loop with multiple safety mechanisms
-    // These limits prevent infinite loops that could cause CPU spikes and audio dropouts:
-    // 1. maxIterations: Conservative limit (2x buffer size, max 8192) for normal operation
-    // 2. emergencyBreak: Last resort fallback (10x buffer size) for runaway conditions
-    // 3. Time-based limit: Prevents excessive processing time per audio block
-    int iterations = 0;
-    const int maxIterations = std::min(N * 2, 8192); // Conservative safety limit
-    const int emergencyBreak = N * 10; // Emergency fallback
-    
-    // Additional safety: track processing time per block
-    auto blockStartTime = std::chrono::high_resolution_clock::now();
-    const auto maxProcessingTime = std::chrono::microseconds(1000); // 1ms max
-
-    for (int n = 0; n < N; ++n) {
-        // Primary iteration safety check
-        if (++iterations > maxIterations) {
-            // Log this occurrence for debugging (would be logged in real implementation)
-            break;
-        }
-        
-        // Emergency break for runaway conditions
-        if (iterations > emergencyBreak) {
-            // This should never happen - indicates serious bug
-            grainStats_.emergencyBreaks++; // Track for debugging
-            reset(); // Reset state to prevent continued issues
-            break;
-        }
-        
-        // Time-based safety check (every 64 samples)
-        if ((n & 63) == 0) {
-            auto elapsed = std::chrono::high_resolution_clock::now() - blockStartTime;
-            if (elapsed > maxProcessingTime) {
-                // Processing is taking too long - abort to prevent audio dropouts
-                break;
-            }
+    for (int blockStart = 0; blockStart < N; blockStart += kSubBlock) {
+        const int n = std::min(kSubBlock, N - blockStart);
+        float* L = Lp + blockStart;
+        float* R = Rp ? Rp + blockStart : nullptr;
+
+        // Pull smoothed params (sub-block rate)
+        const float grainMs  = pGrainSize.advance(n);
+        const float density  = pDensity.advance(n);
+        const float scatter  = pPitchScatter.advance(n);
+        const float position = pCloudPosition.advance(n);
+        const float mixAmount = pMix.advance(n);
+
+        // Derive grain spawn rate
+        const double grainInterval = 1.0 / std::max(0.1, (double)density);
+
+        // Gain compensation based on grain density to prevent buildup
+        // Higher density = lower individual grain volume
+        const float densityCompensation = 1.0f / std::sqrt(1.0f + density * 0.01f);
+        const float grainGain = 1.2f * densityCompensation; // Base gain increased for presence
+
+        // Mix with dry - USER CONTROLLABLE via mix parameter
+        const float dryGain = 1.0f - mixAmount;
+        const float wetGain = mixAmount * grainGain;
+
+        // Capture the whole sub-block first; grains read at least two
+        // samples behind the write position, so never past what is here
+        for (int i = 0; i < n; ++i) {
+            const float inR = R ? R[i] : L[i];
+            circularBuffer_[(size_t)((writeCount_ + i) & bufferMask_)] = 0.5f * (L[i] + inR);
         }
 
-        const float inL = Lp[n];
-        const float inR = (Rp ? Rp[n] : inL);
-        const float inMono = 0.5f * (inL + inR);
-
-        // Write to circular buffer
-        circularBuffer_[writePos_] = inMono;
-        writePos_ = (writePos_ + 1) % bufferSize_;
-
-        // SAFETY: Grain spawning with runaway protection
-        // Prevents infinite grain spawning that could exhaust memory and CPU
-        grainTimer_ += 1.0 / sr_;
-        if (grainTimer_ >= nextGrainTime_) {
-            // Count active grains before spawning to prevent runaway allocation
-            int currentActiveGrains = 0;
-            for (const auto& g : grains_) {
-                if (g.active) currentActiveGrains++;
-            }
-            
-            // Only trigger new grain if we're below the safety threshold
-            if (currentActiveGrains < kMaxActiveGrains) {
-                triggerGrain(grainMs, scatter, position);
+        // Spawn the grains due in this sub-block at their exact sample
+        while (samplesUntilGrain_ < (double)n) {
+            const int offset = std::max(0, (int)std::ceil(samplesUntilGrain_));
+            if (grains_.numActive < kMaxGrains) {
+                triggerGrain(offset, grainMs, scatter, position);
                 grainStats_.totalGrainsSpawned++;
+            } else {
+                grainStats_.grainsDropped++;
             }
-            
-            // Update statistics
-            grainStats_.currentActiveGrains = currentActiveGrains;
-            grainStats_.peakActiveGrains = std::max(grainStats_.peakActiveGrains, currentActiveGrains);
-            
+
             // Always advance timer to prevent stuck state
             // More variation in grain spawning for organic texture
             const double minInterval = 0.0005; // Minimum 0.5ms between attempts (allow denser)
             const double jitter = 0.2 + rng_.uniform() * 1.6; // 20% to 180% variation
             const double randomizedInterval = grainInterval * jitter;
-            nextGrainTime_ = grainTimer_ + std::max(minInterval, randomizedInterval);
+            samplesUntilGrain_ += std::max(minInterval, randomizedInterval) * sr_;
         }
+        samplesUntilGrain_ -= (double)n;
 
-        // SAFETY: Process active grains with multiple bounds to prevent infinite loops
-        // grainIterations: Prevents infinite grain processing loops
-        // activeCount: Limits concurrent grain processing to prevent CPU spikes
-        // maxGrainIterations: Double the expected active count as safety margin
-        float outL = 0.0f, outR = 0.0f;
-        int activeCount = 0;
-        int grainIterations = 0;
-        const int maxGrainIterations = std::min(kMaxGrains, kMaxActiveGrains * 2); // Safety limit
-        
-        for (auto& g : grains_) {
-            // Prevent infinite loops in grain processing
-            if (++grainIterations > maxGrainIterations) {
-                // Emergency brake - this should never happen in normal operation
-                break;
-            }
-            
-            if (!g.active) continue;
-            
-            // Strict limit on active grains to prevent CPU spikes
-            if (++activeCount > kMaxActiveGrains) {
-                // Mark excess grains as inactive to prevent runaway processing
-                g.active = false;
-                break;
-            }
+        // Update statistics
+        grainStats_.currentActiveGrains = grains_.numActive;
+        grainStats_.peakActiveGrains = std::max(grainStats_.peakActiveGrains, grains_.numActive);
 
-            // Read from buffer with linear interpolation
-            const double readPos = writePos_ - g.pos;
-            const int idx0 = ((int)readPos + bufferSize_) % bufferSize_;
-            const int idx1 = (idx0 + 1) % bufferSize_;
-            const float frac = (float)(readPos - floor(readPos));
-            const float sample = circularBuffer_[idx0] * (1.0f - frac) + circularBuffer_[idx1] * frac;
-
-            // Apply window
-            const float windowPhase = (float)g.elapsed / (float)g.length;
-            const int winIdx = std::min((int)(windowPhase * windowSize_), windowSize_ - 1);
-            const float windowed = sample * windowTable_[winIdx] * g.amp;
-
-            // Pan and accumulate - INCREASED AMPLITUDE with density compensation
-            const float panL = std::sqrt(1.0f - g.pan);
-            const float panR = std::sqrt(g.pan);
-            
-            // Gain compensation based on grain density to prevent buildup
-            // Higher density = lower individual grain volume
-            const float densityCompensation = 1.0f / std::sqrt(1.0f + density * 0.01f);
-            const float grainGain = 1.2f * densityCompensation; // Base gain increased for presence
-            
-            outL += windowed * panL * grainGain;
-            outR += windowed * panR * grainGain;
-
-            // Update grain
-            g.pos += g.increment;
-            g.elapsed++;
-            if (g.elapsed >= g.length) {
-                g.active = false;
-            }
+        renderGrains(n);
+        writeCount_ += n;
+
+        for (int i = 0; i < n; ++i) {
+            const float inL = L[i];
+            const float inR = R ? R[i] : inL;
+            float outL = inL * dryGain + wetL_[(size_t)i] * wetGain;
+            float outR = inR * dryGain + wetR_[(size_t)i] * wetGain;
+
+            // Safety and output
+            if (!std::isfinite(outL)) outL = 0.0f;
+            if (!std::isfinite(outR)) outR = 0.0f;
+            outL = clamp(outL, -1.5f, 1.5f);
+            outR = clamp(outR, -1.5f, 1.5f);
+
+            L[i] = flushDenorm(outL);
+            if (R) R[i] = flushDenorm(outR);
         }
+    }
+}
 
-        // Mix with dry - USER CONTROLLABLE via mix parameter
-        const float dryGain = 1.0f - mixAmount;
-        const float wetGain = mixAmount;
-        outL = inL * dryGain + outL * wetGain;
-        outR = (Rp ? inR : inL) * dryGain + outR * wetGain;
-
-        // Safety and output
-        if (!std::isfinite(outL)) outL = 0.0f;
-        if (!std::isfinite(outR)) outR = 0.0f;
-        outL = clamp(outL, -1.5f, 1.5f);
-        outR = clamp(outR, -1.5f, 1.5f);
-
-        Lp[n] = flushDenorm(outL);
-        if (Rp) Rp[n] = flushDenorm(outR);
+void GranularCloud::renderGrains(int numSamples) noexcept {
+    std::fill(wetL_.begin(), wetL_.begin() + numSamples, 0.0f);
+    std::fill(wetR_.begin(), wetR_.begin() + numSamples, 0.0f);
+
+    for (int g = 0; g < grains_.numActive;) {
+        const int from = grains_.offset[(size_t)g];
+        const int count = std::min(numSamples - from, grains_.length[(size_t)g] - grains_.elapsed[(size_t)g]);
+        renderGrain(g, count);
+
+        grains_.elapsed[(size_t)g] += count;
+        grains_.offset[(size_t)g] = 0;
+        if (grains_.elapsed[(size_t)g] >= grains_.length[(size_t)g])
+            grains_.remove(g);  // Swaps the last grain in; render it next
+        else
+            ++g;
     }
 }
 
-void GranularCloud::triggerGrain(float grainMs, float scatter, float position) {
-    // Find free grain with improved bounded search and recycling
-    Grain* grain = nullptr;
-    int attempts = 0;
-    int activeGrainCount = 0;
-    
-    // First pass: look for truly inactive grains
-    for (auto& g : grains_) {
-        if (++attempts > kMaxGrains) break; // Safety limit on search iterations
-        
-        if (!g.active) {
-            grain = &g;
-            break;
-        } else {
-            activeGrainCount++;
-        }
+// Adds count samples of grain g into the wet sub-block from its offset.
+// Positions are taken relative to the sub-block's first read, so they stay
+// small enough for float lanes however far the grain has travelled.
+void GranularCloud::renderGrain(int g, int count) noexcept {
+    const int from = grains_.offset[(size_t)g];
+    const int elapsed = grains_.elapsed[(size_t)g];
+    const float increment = grains_.increment[(size_t)g];
+    const float windowStep = grains_.windowStep[(size_t)g];
+    const float gainL = grains_.gainL[(size_t)g];
+    const float gainR = grains_.gainR[(size_t)g];
+
+    const double firstRead = grains_.start[(size_t)g] + (double)elapsed * increment;
+    const double baseIndex = std::floor(firstRead);
+    const int64_t base = (int64_t)baseIndex;
+    const float baseFrac = (float)(firstRead - baseIndex);
+    const float windowBase = (float)elapsed * windowStep;
+    const float windowLast = (float)(windowSize_ - 1);
+
+    const float* ring = circularBuffer_.data();
+    const float* window = windowTable_.data();
+    float* outL = wetL_.data() + from;
+    float* outR = wetR_.data() + from;
+
+    int i = 0;
+   #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    // Four consecutive samples a step: positions, fractions, interpolation
+    // and panning run in lanes, only the table and ring reads are scalar
+    const __m128 ramp = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 vIncrement = _mm_set1_ps(increment);
+    const __m128 vWindowStep = _mm_set1_ps(windowStep);
+    const __m128 vGainL = _mm_set1_ps(gainL);
+    const __m128 vGainR = _mm_set1_ps(gainR);
+    const __m128i vBase = _mm_set1_epi32((int)(base & bufferMask_));
+    const __m128i vMask = _mm_set1_epi32(bufferMask_);
+    const __m128i vOne = _mm_set1_epi32(1);
+    alignas(16) int index0[4], index1[4], windowIndex[4];
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 k = _mm_add_ps(_mm_set1_ps((float)i), ramp);
+
+        const __m128 read = _mm_add_ps(_mm_set1_ps(baseFrac), _mm_mul_ps(k, vIncrement));
+        const __m128i readWhole = _mm_cvttps_epi32(read);
+        const __m128 readFrac = _mm_sub_ps(read, _mm_cvtepi32_ps(readWhole));
+        const __m128i r0 = _mm_and_si128(_mm_add_epi32(vBase, readWhole), vMask);
+        _mm_store_si128(reinterpret_cast<__m128i*>(index0), r0);
+        _mm_store_si128(reinterpret_cast<__m128i*>(index1), _mm_and_si128(_mm_add_epi32(r0, vOne), vMask));
+
+        const __m128 phase = _mm_min_ps(_mm_add_ps(_mm_set1_ps(windowBase), _mm_mul_ps(k, vWindowStep)),
+                                        _mm_set1_ps(windowLast));
+        const __m128i phaseWhole = _mm_cvttps_epi32(phase);
+        const __m128 phaseFrac = _mm_sub_ps(phase, _mm_cvtepi32_ps(phaseWhole));
+        _mm_store_si128(reinterpret_cast<__m128i*>(windowIndex), phaseWhole);
+
+        const __m128 va = _mm_setr_ps(ring[index0[0]], ring[index0[1]], ring[index0[2]], ring[index0[3]]);
+        const __m128 vb = _mm_setr_ps(ring[index1[0]], ring[index1[1]], ring[index1[2]], ring[index1[3]]);
+        const __m128 vwa = _mm_setr_ps(window[windowIndex[0]], window[windowIndex[1]],
+                                       window[windowIndex[2]], window[windowIndex[3]]);
+        const __m128 vwb = _mm_setr_ps(window[windowIndex[0] + 1], window[windowIndex[1] + 1],
+                                       window[windowIndex[2] + 1], window[windowIndex[3] + 1]);
+
+        const __m128 sample = _mm_add_ps(va, _mm_mul_ps(readFrac, _mm_sub_ps(vb, va)));
+        const __m128 gain = _mm_add_ps(vwa, _mm_mul_ps(phaseFrac, _mm_sub_ps(vwb, vwa)));
+        const __m128 windowed = _mm_mul_ps(sample, gain);
+
+        _mm_storeu_ps(outL + i, _mm_add_ps(_mm_loadu_ps(outL + i), _mm_mul_ps(windowed, vGainL)));
+        _mm_storeu_ps(outR + i, _mm_add_ps(_mm_loadu_ps(outR + i), _mm_mul_ps(windowed, vGainR)));
     }
-    
-    // If no free grain found and we have too many active grains, recycle oldest
-    if (!grain && activeGrainCount >= kMaxActiveGrains) {
-        // Find the grain that's closest to completion for recycling
-        Grain* oldestGrain = nullptr;
-        float maxProgress = -1.0f;
-        
-        attempts = 0;
-        for (auto& g : grains_) {
-            if (++attempts > kMaxGrains) break; // Safety limit
-            
-            if (g.active && g.length > 0) {
-                float progress = float(g.elapsed) / float(g.length);
-                if (progress > maxProgress) {
-                    maxProgress = progress;
-                    oldestGrain = &g;
-                }
-            }
-        }
-        
-        if (oldestGrain && maxProgress > 0.7f) { // Only recycle if >70% complete
-            grain = oldestGrain;
-            grain->active = false; // Mark for reuse
-            grainStats_.grainsRecycled++; // Track recycling for debugging
-        }
+   #endif
+
+    for (; i < count; ++i) {
+        const float read = baseFrac + (float)i * increment;
+        const int readWhole = (int)read;
+        const float readFrac = read - (float)readWhole;
+        const int64_t r = base + readWhole;
+        const float a = ring[r & bufferMask_];
+        const float sample = a + readFrac * (ring[(r + 1) & bufferMask_] - a);
+
+        const float phase = std::min(windowBase + (float)i * windowStep, windowLast);
+        const int phaseWhole = (int)phase;
+        const float wa = window[phaseWhole];
+        const float gain = wa + (phase - (float)phaseWhole) * (window[phaseWhole + 1] - wa);
+
+        outL[i] += sample * gain * gainL;
+        outR[i] += sample * gain * gainR;
     }
-    
-    if (!grain) return; // No grain available (safety fallback)
+}
+
+void GranularCloud::triggerGrain(int offset, float grainMs, float scatter, float position) {
+    const int g = grains_.numActive++;
 
-    // Set grain parameters with safety bounds
-    grain->active = true;
-    
     // SAFETY: Bound grain length to prevent excessive processing
     const int minGrainLength = 64;  // Minimum grain size (prevents clicks)
     const int maxGrainLength = (int)(0.5 * sr_); // Maximum 500ms grain
-    grain->length = clamp((int)(grainMs * 0.001 * sr_), minGrainLength, maxGrainLength);
-    grain->elapsed = 0;
-
-    // SAFETY: Random position in buffer with bounds checking
-    const double maxDelay = std::min(0.5 * sr_, (double)bufferSize_ * 0.9);
-    grain->pos = clamp(rng_.uniform() * maxDelay, 0.0, maxDelay);
+    int length = clamp((int)(grainMs * 0.001 * sr_), minGrainLength, maxGrainLength);
 
     // Pitch variation - ENHANCED for more dramatic effect
+    float increment = 1.0f;
     if (scatter > 0.001f) {
         // Use gaussian distribution for more musical pitch variations
         const float gaussian = (rng_.uniform() + rng_.uniform() + rng_.uniform() - 1.5f) / 1.5f;
         const float octaves = gaussian * scatter;
-        grain->increment = std::pow(2.0f, octaves);
         // Expanded pitch range for more dramatic variations
-        grain->increment = clamp(grain->increment, 0.125, 8.0); // ±3 octaves
-    } else {
-        grain->increment = 1.0f;
+        increment = clamp(std::exp2(octaves), 0.125f, 8.0f); // ±3 octaves
     }
 
+    // The read position drifts from the write position by (1 - increment)
+    // a sample. Start far enough back that a fast grain never overtakes the
+    // newest captured sample, and near enough that a slow one is never
+    // overwritten; shorten grains too long to do both.
+    const double drift = (double)(length - 1) * ((double)increment - 1.0);
+    const double usable = (double)(bufferSize_ - kSubBlock - 4);
+    if (std::abs(drift) > usable)
+        length = std::max(minGrainLength, (int)(usable / std::abs((double)increment - 1.0)));
+    const double travel = (double)(length - 1) * ((double)increment - 1.0);
+    const double minDelay = 2.0 + std::max(0.0, travel);
+    const double maxDelay = std::max(minDelay, (double)(bufferSize_ - kSubBlock - 2) + std::min(0.0, travel));
+
+    // Random position in buffer, up to half a second back
+    const double scatterRange = std::min({ 0.5 * sr_, (double)bufferSize_ * 0.9, maxDelay - minDelay });
+    const double delay = minDelay + rng_.uniform() * scatterRange;
+
+    grains_.start[(size_t)g] = (double)(writeCount_ + offset) - delay;
+    grains_.increment[(size_t)g] = increment;
+    grains_.length[(size_t)g] = length;
+    grains_.elapsed[(size_t)g] = 0;
+    grains_.offset[(size_t)g] = offset;
+    grains_.windowStep[(size_t)g] = (float)(windowSize_ - 1) / (float)length;
+
     // Amplitude and pan - MORE VARIATION for texture
     // Use bell curve for amplitude distribution (most grains at medium volume)
     const float ampRandom = (rng_.uniform() + rng_.uniform()) * 0.5f; // Simple approximation of gaussian
-    grain->amp = 0.4f + ampRandom * 0.6f; // Range: 0.4 to 1.0
+    const float amp = 0.4f + ampRandom * 0.6f; // Range: 0.4 to 1.0
     
     // Wider stereo spread for more spacious effect
-    grain->pan = clamp(position + (rng_.uniform() - 0.5f) * 0.5f, 0.0f, 1.0f);
+    const float pan = clamp(position + (rng_.uniform() - 0.5f) * 0.5f, 0.0f, 1.0f);
+    grains_.gainL[(size_t)g] = amp * std::sqrt(1.0f - pan);
+    grains_.gainR[(size_t)g] = amp * std::sqrt(pan);
 }
 
 // -------------------------------------------------------
@@ -4,6 +4,7 @@
 #include <JuceHeader.h>
 #include <array>
 #include <atomic>
+#include <cstdint>
 #include <vector>
 
 class GranularCloud final : public EngineBase {
@@ -21,6 +22,14 @@ public:
     juce::String getParameterName(int index) const override;
     juce::String getName() const override { return "Granular Cloud"; }
 
+    // Grains keep reading the capture buffer until silence has overwritten it
+    double getTailLengthSeconds() const noexcept override {
+        return bufferSize_ / sr_ + pGrainSize.current * 0.001;
+    }
+
+    // Grains sounding at the end of the last block
+    int getActiveGrainCount() const noexcept { return grains_.numActive; }
+
     // Must match APVTS parameter order
     enum class ParamID : int {
         GrainSize = 0,       // ms
@@ -56,23 +65,33 @@ private:
             const double tc = std::max(1e-3, double(ms)) * 0.001;
             a = std::exp(-1.0 / (tc * sr));
         }
-        inline float tick() noexcept {
+        // numSamples per-sample steps at once, for block-rate parameters
+        inline float advance(int numSamples) noexcept {
             const float t = target.load(std::memory_order_relaxed);
-            current = t + (current - t) * a;
+            current = t + (current - t) * std::pow(a, (float)numSamples);
             return flushDenorm(current);
         }
         void snap(float v) noexcept { target.store(v, std::memory_order_relaxed); current = v; }
     };
 
-    // --------- Grain structure ----------
-    struct Grain {
-        bool active{false};
-        double pos{0.0};        // Position in buffer (samples)
-        double increment{1.0};  // Playback rate
-        int length{0};          // Grain length in samples
-        int elapsed{0};         // Samples played
-        float amp{1.0f};        // Amplitude
-        float pan{0.5f};        // Stereo position
+    // --------- Grain pool ----------
+    // Structure of arrays: the active grains are packed into [0, numActive)
+    // and everything the renderer needs per sample is fixed at spawn, so a
+    // grain renders a whole sub-block from a few registers.
+    static constexpr int kMaxGrains = 256;
+
+    struct GrainPool {
+        alignas(16) std::array<double, kMaxGrains> start{};     // Capture ring position of the first sample
+        alignas(16) std::array<float, kMaxGrains> increment{};  // Playback rate
+        alignas(16) std::array<float, kMaxGrains> windowStep{}; // Window table samples per output sample
+        alignas(16) std::array<float, kMaxGrains> gainL{};      // Amplitude times pan law
+        alignas(16) std::array<float, kMaxGrains> gainR{};
+        alignas(16) std::array<int, kMaxGrains> elapsed{};      // Samples played
+        alignas(16) std::array<int, kMaxGrains> length{};       // Grain length in samples
+        alignas(16) std::array<int, kMaxGrains> offset{};       // First sample in the current sub-block
+        int numActive{0};
+
+        void remove(int i) noexcept;
     };
 
     // Simple thread-safe RNG
@@ -92,29 +111,26 @@ private:
     // Smoothed parameters
     Smooth pGrainSize, pDensity, pPitchScatter, pCloudPosition, pMix;
 
-    // Circular buffer for input
+    // Mono capture ring, a power of two long
     std::vector<float> circularBuffer_;
     int bufferSize_{0};
-    int writePos_{0};
-
-    // Grain pool (bounded for CPU safety)
-    // INCREASED for denser granular clouds
-    // kMaxGrains: Total grain objects in pool (128 for richer textures)
-    // kMaxActiveGrains: Maximum concurrent processing limit (64 for density up to 200 g/s)
-    // These limits prevent infinite loops and runaway grain allocation that could
-    // cause audio dropouts or system instability
-    static constexpr int kMaxGrains = 128;
-    static constexpr int kMaxActiveGrains = 64;
-    std::array<Grain, kMaxGrains> grains_;
+    int bufferMask_{0};
+    int64_t writeCount_{0};  // Samples captured so far
+
+    GrainPool grains_;
 
     // Grain scheduling
-    double grainTimer_{0.0};
-    double nextGrainTime_{0.0};
+    double samplesUntilGrain_{0.0};
 
-    // Window table
+    // Window table, with one guard sample for interpolation
     std::vector<float> windowTable_;
     int windowSize_{0};
 
+    // Wet sub-block
+    static constexpr int kSubBlock = 256;
+    alignas(16) std::array<float, kSubBlock> wetL_{};
+    alignas(16) std::array<float, kSubBlock> wetR_{};
+
     // RNG
     SimpleRNG rng_;
     
@@ -123,14 +139,15 @@ private:
         int currentActiveGrains{0};
         int peakActiveGrains{0};
         int totalGrainsSpawned{0};
-        int grainsRecycled{0};
-        int emergencyBreaks{0};
+        int grainsDropped{0};  // Spawns skipped with the pool full
         void reset() {
             currentActiveGrains = peakActiveGrains = 0;
-            totalGrainsSpawned = grainsRecycled = emergencyBreaks = 0;
+            totalGrainsSpawned = grainsDropped = 0;
         }
     } grainStats_;
 
     // --------- Methods ----------
-    void triggerGrain(float grainMs, float scatter, float position);
+    void triggerGrain(int offset, float grainMs, float scatter, float position);
+    void renderGrains(int numSamples) noexcept;
+    void renderGrain(int g, int numSamples) noexcept;
 };
\ No newline at end of file
@@ -6,7 +6,7 @@
  * IPitchShiftStrategy - Abstract interface for pitch shifting algorithms
  * 
  * This interface allows us to swap implementations without changing engine code.
- * Beta release uses SimplePitchShift, future releases can add better algorithms.
+ * Engines pick a tier with PitchShiftFactory::forQuality() and report its latency.
  * 
  * Design Principles:
  * - Clean interface for any pitch shifting algorithm
@@ -68,6 +68,14 @@ public:
      * @return Approximate CPU usage where 100 is very heavy
      */
     virtual int getCpuUsage() const = 0;
+    
+    /**
+     * Trade quality for CPU
+     * @param tier 0 (cheapest) to 3 (best), in EngineBase::Quality order
+     * Called on the audio thread between process() calls; must not allocate.
+     * Algorithms without a cheaper mode ignore it.
+     */
+    virtual void setQuality(int tier) { (void) tier; }
 };
 
 /**
@@ -76,25 +84,30 @@ public:
 class PitchShiftFactory {
 public:
     enum class Algorithm {
-        Simple,         // Beta quality, zero latency
-        Signalsmith,    // High latency, not working yet
-        PSOLA,          // Medium quality, low latency (future)
-        PhaseVocoder,   // High quality, medium latency (future)
-        RubberBand      // Professional quality (future)
+        Simple,         // Hop-based resampler, ~5 ms
+        Signalsmith,    // Highest quality, ~160 ms
+        PSOLA,          // Time-domain, ~7 ms, cheapest - live/tracking
+        PhaseVocoder,   // Peak-locked vocoder, ~43 ms, balanced
+        RubberBand      // Not bundled; created as Signalsmith
     };
     
     /**
      * Create a pitch shifter with the specified algorithm
-     * Falls back to Simple if requested algorithm unavailable
+     * Falls back to the closest tier if the requested one is unavailable
      */
     static std::unique_ptr<IPitchShiftStrategy> create(Algorithm algo = Algorithm::Simple);
     
     /**
      * Get the best available algorithm
-     * For beta, this returns Simple
      */
     static Algorithm getBestAvailable();
     
+    /**
+     * Algorithm for a quality tier, 0 (Draft) to 3 (Ultra) in
+     * EngineBase::Quality order: PSOLA, PhaseVocoder, PhaseVocoder, Signalsmith
+     */
+    static Algorithm forQuality(int tier);
+    
     /**
      * Check if an algorithm is available
      */
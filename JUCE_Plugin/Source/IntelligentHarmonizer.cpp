@@ -1,9 +1,10 @@
-// IntelligentHarmonizer using SMBPitchShiftFixed
+// IntelligentHarmonizer using the PitchShiftFactory tiers
 // Real-time pitch shifting for harmony generation with < 0.0005% frequency error
 
 #include "IntelligentHarmonizer.h"
 #include "IntelligentHarmonizerChords.h"
-#include "SMBPitchShiftFixed.h"
+#include "IPitchShiftStrategy.h"
+#include "MultiVoicePitchShift.h"
 #include <algorithm>
 #include <cmath>
 #include <memory>
@@ -99,8 +100,18 @@ float intervalToRatio(int semitones) {
 // Implementation using Signalsmith Stretch
 class IntelligentHarmonizer::Impl {
 public:
-    // SMB Pitch Shift engines (one per voice)
-    std::array<std::unique_ptr<SMBPitchShiftFixed>, 3> pitchShifters_;
+    // Quality modes: PSOLA per voice, one shared phase vocoder analysis
+    // resynthesised per voice, or a full Signalsmith pitch shifter per voice
+    enum class Mode { LowLatency, Efficient, HighQuality };
+
+    // Low-latency mode: PSOLA pitch shifters (one per voice, ~7 ms)
+    std::array<std::unique_ptr<IPitchShiftStrategy>, 3> lowLatencyShifters_;
+
+    // High-quality mode: Signalsmith pitch shifters (one per voice)
+    std::array<std::unique_ptr<IPitchShiftStrategy>, 3> pitchShifters_;
+
+    // Efficient mode: every voice from one analysis of the input
+    MultiVoicePitchShift sharedShifter_;
     
     // Parameters - Voice pitches
     SmoothedParam pitchRatio1_;
@@ -128,7 +139,9 @@ public:
     int rootKey_ = 0;     // C by default
     int scaleIndex_ = 9;  // Chromatic by default
     int transposeOctaves_ = 0;
-    bool lowLatencyMode_ = false;  // Default to high-quality mode with SMBPitchShift
+    Mode mode_ = Mode::HighQuality;        // Requested by the quality parameter
+    Mode tierMode_ = Mode::HighQuality;    // Ceiling from EngineBase::Quality
+    Mode activeMode_ = Mode::HighQuality;  // Mode the shifters are primed for
     
     // Engine state
     double sampleRate_ = 48000.0;
@@ -141,120 +154,32 @@ public:
     std::uniform_real_distribution<float> pitchDist_{-0.02f, 0.02f};
     std::uniform_real_distribution<float> timeDist_{0.0f, 0.001f};
     
-    // Processing buffers
-    std::vector<float> inputBuffer_;
-    std::vector<float> outputBuffer_;
+    // Processing buffers, sized for blockSize_ in prepare()
+    std::vector<float> inputBuffer_;   // Input copy (input and output may alias)
+    std::vector<float> outputBuffer_;  // Per-voice scratch
+    std::vector<float> dryBuffer_;     // Input delayed by the active mode's latency
+
+    // Dry delay line, long enough for the slowest mode
     std::vector<float> delayBuffer_;
     int delayWritePos_ = 0;
-    
-    void processLowLatency(const float* input, float* output, int numSamples) {
-        // Simple variable-speed playback for pitch shifting
-        // Zero latency but with artifacts
-        static float readPos1 = 0.0f;
-        static float readPos2 = 0.0f;
-        static float readPos3 = 0.0f;
-        const int bufferSize = 4096;
-        
-        if (delayBuffer_.size() != bufferSize) {
-            delayBuffer_.resize(bufferSize, 0.0f);
-        }
-        
-        // Get current parameters
-        float ratio1 = pitchRatio1_.tick();
-        float ratio2 = pitchRatio2_.tick();
-        float ratio3 = pitchRatio3_.tick();
-        
-        float vol1 = voice1Volume_.tick();
-        float vol2 = voice2Volume_.tick();
-        float vol3 = voice3Volume_.tick();
-        
-        float masterMix = masterMix_.tick();
-        float humanizeAmt = humanize_.tick();
-        
-        for (int i = 0; i < numSamples; ++i) {
-            // Write to circular buffer
-            delayBuffer_[delayWritePos_] = input[i];
-            delayWritePos_ = (delayWritePos_ + 1) % bufferSize;
-            
-            float wetSignal = 0.0f;
-            
-            // Voice 1
-            if (numVoices_ >= 1 && vol1 > 0.01f) {
-                // Add humanization
-                float pitchMod = 1.0f;
-                if (humanizeAmt > 0.01f) {
-                    pitchMod = 1.0f + (pitchDist_(rng_) * humanizeAmt);
-                }
-                
-                int readIdx = static_cast<int>(readPos1);
-                float frac = readPos1 - readIdx;
-                
-                int idx0 = readIdx % bufferSize;
-                int idx1 = (readIdx + 1) % bufferSize;
-                
-                float voice1 = delayBuffer_[idx0] * (1.0f - frac) + delayBuffer_[idx1] * frac;
-                wetSignal += voice1 * vol1;
-                
-                readPos1 += (1.0f / ratio1) * pitchMod;
-                if (readPos1 >= bufferSize) readPos1 -= bufferSize;
-            }
-            
-            // Voice 2
-            if (numVoices_ >= 2 && vol2 > 0.01f) {
-                float pitchMod = 1.0f;
-                if (humanizeAmt > 0.01f) {
-                    pitchMod = 1.0f + (pitchDist_(rng_) * humanizeAmt * 0.7f);
-                }
-                
-                int readIdx = static_cast<int>(readPos2);
-                float frac = readPos2 - readIdx;
-                
-                int idx0 = readIdx % bufferSize;
-                int idx1 = (readIdx + 1) % bufferSize;
-                
-                float voice2 = delayBuffer_[idx0] * (1.0f - frac) + delayBuffer_[idx1] * frac;
-                wetSignal += voice2 * vol2;
-                
-                readPos2 += (1.0f / ratio2) * pitchMod;
-                if (readPos2 >= bufferSize) readPos2 -= bufferSize;
-            }
-            
-            // Voice 3
-            if (numVoices_ >= 3 && vol3 > 0.01f) {
-                float pitchMod = 1.0f;
-                if (humanizeAmt > 0.01f) {
-                    pitchMod = 1.0f + (pitchDist_(rng_) * humanizeAmt * 0.5f);
-                }
-                
-                int readIdx = static_cast<int>(readPos3);
-                float frac = readPos3 - readIdx;
-                
-                int idx0 = readIdx % bufferSize;
-                int idx1 = (readIdx + 1) % bufferSize;
-                
-                float voice3 = delayBuffer_[idx0] * (1.0f - frac) + delayBuffer_[idx1] * frac;
-                wetSignal += voice3 * vol3;
-                
-                readPos3 += (1.0f / ratio3) * pitchMod;
-                if (readPos3 >= bufferSize) readPos3 -= bufferSize;
-            }
-            
-            // Mix dry and wet
-            output[i] = input[i] * (1.0f - masterMix) + wetSignal * masterMix;
-        }
-    }
+    int delayMask_ = 0;
     
     void prepare(double sampleRate, int samplesPerBlock) {
         sampleRate_ = sampleRate;
         blockSize_ = samplesPerBlock;
         
-        // Initialize SMB Pitch Shifters for each voice
+        // Every mode is prepared up front so quality changes never allocate
         for (int i = 0; i < 3; ++i) {
+            if (!lowLatencyShifters_[i]) {
+                lowLatencyShifters_[i] = PitchShiftFactory::create(PitchShiftFactory::Algorithm::PSOLA);
+            }
             if (!pitchShifters_[i]) {
-                pitchShifters_[i] = std::make_unique<SMBPitchShiftFixed>();
+                pitchShifters_[i] = PitchShiftFactory::create(PitchShiftFactory::Algorithm::Signalsmith);
             }
+            lowLatencyShifters_[i]->prepare(sampleRate, samplesPerBlock);
             pitchShifters_[i]->prepare(sampleRate, samplesPerBlock);
         }
+        sharedShifter_.prepare(sampleRate);
         
         // Setup smoothing for all parameters
         const float smoothTime = 10.0f;
@@ -297,11 +222,39 @@ public:
         width_.snap(0.0f);
         
         // Allocate buffers
-        inputBuffer_.resize(blockSize_);
-        outputBuffer_.resize(blockSize_);
+        inputBuffer_.assign(blockSize_, 0.0f);
+        outputBuffer_.assign(blockSize_, 0.0f);
+        dryBuffer_.assign(blockSize_, 0.0f);
+
+        int delaySize = 1;
+        const int maxLatency = std::max(latencyOf(Mode::HighQuality), latencyOf(Mode::Efficient));
+        while (delaySize < maxLatency + blockSize_) delaySize <<= 1;
+        delayBuffer_.assign(delaySize, 0.0f);
+        delayMask_ = delaySize - 1;
+        delayWritePos_ = 0;
+
+        activeMode_ = requestedMode();
+        warmupSamples_ = calculateWarmupSamples();
+
+        prepared_ = true;
+    }
+
+    // CRITICAL FIX: Calculate warmup period based on pitch shifter latency
+    // The shifters have internal buffering that needs priming
+    int calculateWarmupSamples() const {
+        switch (activeMode_) {
+            case Mode::LowLatency:
+                // PSOLA grains fade in once the input reaches its latency
+                return latencyOf(Mode::LowLatency);
+
+            case Mode::Efficient:
+                // Output is silent for exactly its latency, then starts
+                return sharedShifter_.getLatencySamples() + blockSize_;
+
+            case Mode::HighQuality:
+                break;
+        }
 
-        // CRITICAL FIX: Calculate warmup period based on SMBPitchShift latency
-        // SMBPitchShift has internal buffering that needs priming
         // Get maximum latency from all pitch shifters
         int maxLatency = 0;
         for (const auto& shifter : pitchShifters_) {
@@ -315,9 +268,42 @@ public:
 
         // Set warmup samples: need enough samples to fill the internal buffers
         // Use 2x latency + one block for safety margin
-        warmupSamples_ = (maxLatency * 2) + blockSize_;
+        return (maxLatency * 2) + blockSize_;
+    }
 
-        prepared_ = true;
+    // The quality parameter asks for a mode; EngineBase::Quality caps it
+    Mode requestedMode() const {
+        return static_cast<int>(tierMode_) < static_cast<int>(mode_) ? tierMode_ : mode_;
+    }
+
+    int latencyOf(Mode mode) const {
+        switch (mode) {
+            case Mode::LowLatency:
+                return lowLatencyShifters_[0] ? lowLatencyShifters_[0]->getLatencySamples() : 0;
+            case Mode::Efficient:
+                return sharedShifter_.getLatencySamples();
+            case Mode::HighQuality:
+                return pitchShifters_[0] ? pitchShifters_[0]->getLatencySamples() : 0;
+        }
+        return 0;
+    }
+
+    // Smoothed ratio and volume of one voice, ticked once per block
+    void tickVoice(int voiceIdx, float& ratio, float& volume) {
+        switch (voiceIdx) {
+            case 0:
+                ratio = pitchRatio1_.tick();
+                volume = voice1Volume_.tick();
+                break;
+            case 1:
+                ratio = pitchRatio2_.tick();
+                volume = voice2Volume_.tick();
+                break;
+            case 2:
+                ratio = pitchRatio3_.tick();
+                volume = voice3Volume_.tick();
+                break;
+        }
     }
     
     void processBlock(const float* input, float* output, int numSamples) {
@@ -326,6 +312,41 @@ public:
             return;
         }
 
+        // Scratch buffers hold blockSize_ samples; split anything longer
+        for (int start = 0; start < numSamples; start += blockSize_) {
+            const int chunk = std::min(blockSize_, numSamples - start);
+            processChunk(input + start, output + start, chunk);
+        }
+    }
+
+    void processChunk(const float* input, float* output, int numSamples) {
+        // A newly selected mode starts from cleared shifters and primes again
+        if (requestedMode() != activeMode_) {
+            activeMode_ = requestedMode();
+            if (activeMode_ == Mode::Efficient) {
+                sharedShifter_.reset();
+            } else {
+                auto& shifters = activeMode_ == Mode::LowLatency ? lowLatencyShifters_ : pitchShifters_;
+                for (auto& shifter : shifters) {
+                    if (shifter) {
+                        shifter->reset();
+                    }
+                }
+            }
+            warmupSamples_ = calculateWarmupSamples();
+        }
+
+        // Dry path, delayed to line up with the active mode's voices
+        const int latency = latencyOf(activeMode_);
+        for (int i = 0; i < numSamples; ++i) {
+            delayBuffer_[(delayWritePos_ + i) & delayMask_] = input[i];
+        }
+        float* dry = dryBuffer_.data();
+        for (int i = 0; i < numSamples; ++i) {
+            dry[i] = delayBuffer_[(delayWritePos_ + i - latency) & delayMask_];
+        }
+        delayWritePos_ = (delayWritePos_ + numSamples) & delayMask_;
+
         // CRITICAL FIX: Handle warmup period for buffer priming
         // During warmup, process audio through the pitch shifters to prime their buffers
         // but output the dry signal to avoid outputting zeros
@@ -334,20 +355,24 @@ public:
             // Decrement warmup counter
             warmupSamples_ = std::max(0, warmupSamples_ - numSamples);
 
-            // Process through all pitch shifters to prime their buffers
+            // Process through the active pitch shifters to prime their buffers
             // but don't use the output yet - just let them fill their internal buffers
-            std::vector<float> tempOutput(numSamples);
-            for (int voiceIdx = 0; voiceIdx < 3; ++voiceIdx) {
-                if (pitchShifters_[voiceIdx]) {
-                    // Process with a neutral pitch ratio to prime buffers
-                    pitchShifters_[voiceIdx]->process(input, tempOutput.data(), numSamples, 1.0f);
+            if (activeMode_ == Mode::Efficient) {
+                const float ratios[] = { 1.0f, 1.0f, 1.0f };
+                const float gains[] = { 1.0f, 1.0f, 1.0f };
+                sharedShifter_.process(input, outputBuffer_.data(), numSamples, ratios, gains, numVoices_);
+            } else {
+                auto& shifters = activeMode_ == Mode::LowLatency ? lowLatencyShifters_ : pitchShifters_;
+                for (auto& shifter : shifters) {
+                    if (shifter) {
+                        // Process with a neutral pitch ratio to prime buffers
+                        shifter->process(input, outputBuffer_.data(), numSamples, 1.0f);
+                    }
                 }
             }
 
-            // Output dry signal during warmup
-            if (input != output) {
-                std::copy(input, input + numSamples, output);
-            }
+            // Output the (delayed) dry signal during warmup
+            std::copy(dry, dry + numSamples, output);
             return;
         }
 
@@ -356,65 +381,64 @@ public:
 
         // Early return for dry signal (0% mix)
         if (masterMix < 0.001f) {
-            // Dry only - pass through unchanged
-            if (input != output) {
-                std::copy(input, input + numSamples, output);
-            }
+            // Dry only - still delayed, so the reported latency holds
+            std::copy(dry, dry + numSamples, output);
             return;
         }
         
-        if (lowLatencyMode_) {
-            // Low-latency mode: Use the processLowLatency method
-            processLowLatency(input, output, numSamples);
+        // Copy input to temp buffer since input and output may be the same
+        float* inputCopy = inputBuffer_.data();
+        std::copy(input, input + numSamples, inputCopy);
+
+        // Humanize drifts each audible voice's pitch a little per block
+        const float humanizeAmt = humanize_.tick();
+        const float humanizeDepth[3] = { 1.0f, 0.7f, 0.5f };
+
+        if (activeMode_ == Mode::Efficient) {
+            // Efficient mode: one analysis, each voice only resynthesised.
+            // Unison goes through it as well so every voice stays aligned.
+            float ratios[3] = { 1.0f, 1.0f, 1.0f };
+            float volumes[3] = { 0.0f, 0.0f, 0.0f };
+            for (int voiceIdx = 0; voiceIdx < numVoices_; ++voiceIdx) {
+                tickVoice(voiceIdx, ratios[voiceIdx], volumes[voiceIdx]);
+                if (volumes[voiceIdx] > 0.01f && humanizeAmt > 0.01f) {
+                    ratios[voiceIdx] *= 1.0f + pitchDist_(rng_) * humanizeAmt * humanizeDepth[voiceIdx];
+                }
+            }
+
+            // Voices at (near) zero volume are skipped inside
+            sharedShifter_.process(inputCopy, output, numSamples, ratios, volumes, numVoices_);
         } else {
-            // High-quality mode: Use SMBPitchShiftFixed for each voice
-            // Copy input to temp buffer since input and output may be the same
-            std::vector<float> inputCopy(input, input + numSamples);
+            // Low-latency and high-quality modes: a pitch shifter per voice
+            auto& shifters = activeMode_ == Mode::LowLatency ? lowLatencyShifters_ : pitchShifters_;
             std::fill(output, output + numSamples, 0.0f);
 
-            // Process each voice separately
+            // Process each voice separately. Unison goes through its
+            // shifter too, so it carries the same latency as the rest.
             for (int voiceIdx = 0; voiceIdx < numVoices_; ++voiceIdx) {
                 float ratio = 1.0f;
                 float volume = 0.0f;
+                tickVoice(voiceIdx, ratio, volume);
                 
-                switch (voiceIdx) {
-                    case 0:
-                        ratio = pitchRatio1_.tick();
-                        volume = voice1Volume_.tick();
-                        break;
-                    case 1:
-                        ratio = pitchRatio2_.tick();
-                        volume = voice2Volume_.tick();
-                        break;
-                    case 2:
-                        ratio = pitchRatio3_.tick();
-                        volume = voice3Volume_.tick();
-                        break;
-                }
-                
-                if (volume > 0.01f) {
-                    if (std::fabs(ratio - 1.0f) > 0.001f && voiceIdx < 3 && pitchShifters_[voiceIdx]) {
-                        // Pitched voice - use SMBPitchShift
-                        std::vector<float> tempOutput(numSamples);
-                        pitchShifters_[voiceIdx]->process(inputCopy.data(), tempOutput.data(), numSamples, ratio);
-                        
-                        // Add to output with volume scaling
-                        for (int i = 0; i < numSamples; ++i) {
-                            output[i] += tempOutput[i] * volume;
-                        }
-                    } else {
-                        // Unison voice (ratio = 1.0), just add with volume
-                        for (int i = 0; i < numSamples; ++i) {
-                            output[i] += inputCopy[i] * volume;
-                        }
+                if (volume > 0.01f && shifters[voiceIdx]) {
+                    if (humanizeAmt > 0.01f) {
+                        ratio *= 1.0f + pitchDist_(rng_) * humanizeAmt * humanizeDepth[voiceIdx];
+                    }
+
+                    float* voiceOutput = outputBuffer_.data();
+                    shifters[voiceIdx]->process(inputCopy, voiceOutput, numSamples, ratio);
+                    
+                    // Add to output with volume scaling
+                    for (int i = 0; i < numSamples; ++i) {
+                        output[i] += voiceOutput[i] * volume;
                     }
                 }
             }
-            
-            // Apply master mix
-            for (int i = 0; i < numSamples; ++i) {
-                output[i] = inputCopy[i] * (1.0f - masterMix) + output[i] * masterMix;
-            }
+        }
+        
+        // Apply master mix
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = dry[i] * (1.0f - masterMix) + output[i] * masterMix;
         }
         
         // Gentle limiting
@@ -430,28 +454,27 @@ public:
     
     void reset() {
         // Reset all pitch shifters
+        for (auto& shifter : lowLatencyShifters_) {
+            if (shifter) {
+                shifter->reset();
+            }
+        }
         for (auto& shifter : pitchShifters_) {
             if (shifter) {
                 shifter->reset();
             }
         }
-        inputBuffer_.clear();
-        outputBuffer_.clear();
-        delayBuffer_.clear();
+        sharedShifter_.reset();
+        std::fill(inputBuffer_.begin(), inputBuffer_.end(), 0.0f);
+        std::fill(outputBuffer_.begin(), outputBuffer_.end(), 0.0f);
+        std::fill(dryBuffer_.begin(), dryBuffer_.end(), 0.0f);
+        std::fill(delayBuffer_.begin(), delayBuffer_.end(), 0.0f);
         delayWritePos_ = 0;
 
         // CRITICAL FIX: Recalculate warmup period after reset
         if (prepared_) {
-            int maxLatency = 0;
-            for (const auto& shifter : pitchShifters_) {
-                if (shifter) {
-                    int latency = shifter->getLatencySamples();
-                    if (latency > maxLatency) {
-                        maxLatency = latency;
-                    }
-                }
-            }
-            warmupSamples_ = (maxLatency * 2) + blockSize_;
+            activeMode_ = requestedMode();
+            warmupSamples_ = calculateWarmupSamples();
         }
     }
     
@@ -521,18 +544,31 @@ public:
         masterMix_.snap(m);
     }
     
+    // The mode the next block will run in; its dry path is delayed to match
     int getLatencySamples() const {
-        if (lowLatencyMode_) {
-            return 0;  // Zero latency in low-latency mode
-        }
-        if (prepared_ && pitchShifters_[0]) {
-            return pitchShifters_[0]->getLatencySamples();
-        }
-        return 0;
+        return prepared_ ? latencyOf(requestedMode()) : 0;
+    }
+    
+    int getWarmupSamples() const {
+        return prepared_ ? warmupSamples_ : 0;
     }
     
-    void setLowLatencyMode(bool enable) {
-        lowLatencyMode_ = enable;
+    double getTailLengthSeconds() const {
+        return getLatencySamples() / sampleRate_;
+    }
+    
+    void setQualityMode(int mode) {
+        mode_ = mode <= 0 ? Mode::LowLatency : (mode == 1 ? Mode::Efficient : Mode::HighQuality);
+    }
+
+    // PitchShiftFactory::forQuality() tiers: Draft is PSOLA, Normal and
+    // High the phase vocoder (shared here), Ultra Signalsmith
+    void setTier(int tier) {
+        switch (PitchShiftFactory::forQuality(tier)) {
+            case PitchShiftFactory::Algorithm::PSOLA:        tierMode_ = Mode::LowLatency; break;
+            case PitchShiftFactory::Algorithm::PhaseVocoder: tierMode_ = Mode::Efficient; break;
+            default:                                         tierMode_ = Mode::HighQuality; break;
+        }
     }
 };
 
@@ -626,10 +662,10 @@ void IntelligentHarmonizer::updateParameters(const std::map<int, float>& params)
     float voice3FormantNorm = getParam(kVoice3Formant, 0.5f);
     pimpl->setVoice3Formant(voice3FormantNorm);
     
-    // Parameter 11: Quality mode (0 = low latency, 1 = high quality)
+    // Parameter 11: Quality mode (low latency / efficient / high quality)
     // Default to high quality mode for proper pitch shifting
     float qualityNorm = getParam(kQuality, 1.0f);  // Default to 1.0 = high quality
-    pimpl->setLowLatencyMode(qualityNorm < 0.5f);
+    pimpl->setQualityMode(IntelligentHarmonizerChords::getQualityMode(qualityNorm));
     
     // Parameter 12: Humanize amount
     float humanizeNorm = getParam(kHumanize, 0.0f);
@@ -764,6 +800,18 @@ juce::String IntelligentHarmonizer::getParameterDisplayString(int index, float n
     }
 }
 
+void IntelligentHarmonizer::setQuality(Quality q) {
+    pimpl->setTier(static_cast<int>(q));
+}
+
 int IntelligentHarmonizer::getLatencySamples() const noexcept {
     return pimpl->getLatencySamples();
+}
+
+int IntelligentHarmonizer::getWarmupSamples() const noexcept {
+    return pimpl->getWarmupSamples();
+}
+
+double IntelligentHarmonizer::getTailLengthSeconds() const noexcept {
+    return pimpl->getTailLengthSeconds();
 }
\ No newline at end of file
@@ -20,8 +20,19 @@ public:
     // Get parameter display string for UI
     juce::String getParameterDisplayString(int index, float normalizedValue) const;
     
+    // Caps the quality parameter's mode: Draft runs PSOLA (~7 ms), Normal and
+    // High the shared phase vocoder, Ultra allows Signalsmith
+    void setQuality(Quality q) override;
+    
     // Get total processing latency in samples
     int getLatencySamples() const noexcept override;
+    bool qualityChangesLatency() const noexcept override { return true; }  // The tier picks the mode
+    
+    // The shifters hold one latency's worth of input
+    double getTailLengthSeconds() const noexcept override;
+    
+    // Remaining pitch-shifter priming (output is dry until this reaches zero)
+    int getWarmupSamples() const noexcept override;
     
     // Parameter indices (15 total)
     enum ParamID {
@@ -36,7 +47,7 @@ public:
         kVoice2Formant = 8, // Voice 2 formant
         kVoice3Volume = 9,  // Voice 3 volume
         kVoice3Formant = 10,// Voice 3 formant
-        kQuality = 11,      // Low latency vs high quality
+        kQuality = 11,      // Low latency / efficient / high quality
         kHumanize = 12,     // Humanization amount
         kWidth = 13,        // Stereo width
         kTranspose = 14     // Global transpose
@@ -166,7 +166,16 @@ inline int getVoiceCount(float normalized) {
 
 // Quality mode display
 inline std::string getQualityDisplay(float normalized) {
-    return normalized < 0.5f ? "Low Latency" : "High Quality";
+    if (normalized < 0.33f) return "Low Latency";
+    else if (normalized < 0.66f) return "Efficient";
+    else return "High Quality";
+}
+
+// 0 = low latency, 1 = efficient (shared analysis), 2 = high quality
+inline int getQualityMode(float normalized) {
+    if (normalized < 0.33f) return 0;
+    else if (normalized < 0.66f) return 1;
+    else return 2;
 }
 
 // Formant display (-100% to +100%)
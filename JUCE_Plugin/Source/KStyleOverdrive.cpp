@@ -18,7 +18,7 @@ KStyleOverdrive::KStyleOverdrive() {
    #endif
 }
 
-void KStyleOverdrive::prepareToPlay(double fs, int /*samplesPerBlock*/) {
+void KStyleOverdrive::prepareToPlay(double fs, int samplesPerBlock) {
     sampleRate_ = std::max(8000.0, fs);
     const float ffs = (float) sampleRate_;
 
@@ -31,18 +31,46 @@ void KStyleOverdrive::prepareToPlay(double fs, int /*samplesPerBlock*/) {
     for (int ch = 0; ch < 2; ++ch) {
         tone_[ch].prepare(sampleRate_);
         tone_[ch].reset();
-        oversampler_[ch].prepare(ffs);
-        oversampler_[ch].reset();
         dcBlocker_[ch].reset();
     }
+    
+    oversampler_.prepare(2, samplesPerBlock, MAX_OVERSAMPLING, PolyphaseOversampler::Phase::Minimum);
+    for (auto& shaper : shapers_)
+        shaper.setCurve(AdaaCurves::tanh());
+    applyAntialiasingPlan();
 }
 
 void KStyleOverdrive::reset() {
     for (int ch = 0; ch < 2; ++ch) {
         tone_[ch].reset();
-        oversampler_[ch].reset();
         dcBlocker_[ch].reset();
     }
+    oversampler_.reset();
+    for (auto& shaper : shapers_)
+        shaper.reset();
+}
+
+void KStyleOverdrive::setQuality(Quality q) {
+    quality_ = q;
+    applyAntialiasingPlan();
+}
+
+void KStyleOverdrive::setAntialiasingMode(AntialiasingMode mode) {
+    antialiasingMode_ = mode;
+    applyAntialiasingPlan();
+}
+
+void KStyleOverdrive::applyAntialiasingPlan() {
+    const auto plan = antialiasingForQuality(quality_, antialiasingMode_, MAX_OVERSAMPLING);
+    oversamplingFactor_ = plan.factor;
+    oversampler_.setFactor(oversamplingFactor_);
+
+    // Shaper history belongs to the previous rate
+    useAdaa_ = plan.adaaOrder > 0;
+    for (auto& shaper : shapers_) {
+        shaper.setOrder(plan.adaaOrder);
+        shaper.reset();
+    }
 }
 
 void KStyleOverdrive::updateParameters(const std::map<int, float>& params) {
@@ -83,6 +111,8 @@ void KStyleOverdrive::process(juce::AudioBuffer<float>& buffer) {
     const float tone  = pTone_.next();
     const float level = fromdB(juce::jmap(pLevel_.next(), 0.0f, 1.0f, -12.0f, +12.0f));
     const float mix   = pMix_.next();
+    const float pre    = fromdB(juce::jmap(drive, 0.0f, 1.0f, 0.0f, 15.0f));
+    const float makeup = fromdB(juce::jmap(drive, 0.0f, 1.0f, 0.0f, -3.0f));
 
     for (int ch = 0; ch < nCh; ++ch)
         tone_[ch].setMix(tone);
@@ -109,20 +139,25 @@ void KStyleOverdrive::process(juce::AudioBuffer<float>& buffer) {
         float preL = inL;
         float preR = inR;
 
-        // 2x oversampling for nonlinearity to prevent aliasing
-        float upL[2], upR[2];
-        oversampler_[0].upsample(preL, upL);
-        oversampler_[1].upsample(preR, upR);
-        
-        // Process at 2x rate
-        for (int j = 0; j < 2; ++j) {
-            upL[j] = waveshaper(upL[j], drive);
-            upR[j] = waveshaper(upR[j], drive);
+        float odL, odR;
+        if (useAdaa_) {
+            // ADAA, at 2x from High
+            if (oversampler_.getFactor() > 1) {
+                odL = oversampler_.processSample(0, preL, [&](float x) { return adaaWaveshaper(0, x, pre, makeup); });
+                odR = oversampler_.processSample(1, preR, [&](float x) { return adaaWaveshaper(1, x, pre, makeup); });
+            } else {
+                odL = adaaWaveshaper(0, preL, pre, makeup);
+                odR = adaaWaveshaper(1, preR, pre, makeup);
+            }
+        } else if (oversampler_.getFactor() > 1) {
+            // Oversampled nonlinearity to prevent aliasing
+            const auto shape = [pre, makeup](float x) { return waveshaper(x, pre, makeup); };
+            odL = oversampler_.processSample(0, preL, shape);
+            odR = oversampler_.processSample(1, preR, shape);
+        } else {
+            odL = waveshaper(preL, pre, makeup);
+            odR = waveshaper(preR, pre, makeup);
         }
-        
-        // Downsample
-        float odL = oversampler_[0].downsample(upL);
-        float odR = oversampler_[1].downsample(upR);
 
         // Post "tone" tilt (musical single knob)
         float postL = tone_[0].process(odL);
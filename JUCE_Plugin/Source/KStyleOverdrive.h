@@ -1,5 +1,7 @@
 #pragma once
 #include "EngineBase.h"
+#include "AntiderivativeShaper.h"
+#include "PolyphaseOversampler.h"
 #include <JuceHeader.h>
 #include <atomic>
 #include <map>
@@ -23,6 +25,11 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override;  // Oversampling factor and ADAA order follow the tier
+
+    // Antiderivative (default): ADAA on the tanh at 1x, 2x from High.
+    // Oversampling: plain tanh at up to 4x, as before ADAA.
+    void setAntialiasingMode(AntialiasingMode mode);
 
     juce::String getName() const override { return "K-Style Overdrive"; }
     int getNumParameters() const override { return 4; }  // Keep 4 params for compatibility
@@ -98,43 +105,17 @@ private:
     // DSP blocks
     TiltTone tone_[2];
     
-    // Simple 2x oversampler for anti-aliasing
-    struct SimpleOversampler {
-        OnePoleTPT upFilter;    // For upsampling interpolation
-        OnePoleTPT downFilter;  // For downsampling anti-aliasing
-        float lastSample = 0.0f;
-        
-        void prepare(float sampleRate) {
-            // Set cutoff at Nyquist/4 for proper anti-aliasing
-            float cutoff = sampleRate * 0.4f;  // 40% of Nyquist for safety
-            upFilter.setLowpass(cutoff, sampleRate * 2.0f);   // Filter at 2x rate
-            downFilter.setLowpass(cutoff, sampleRate * 2.0f); // Filter at 2x rate
-            lastSample = 0.0f;
-        }
-        
-        void upsample(float input, float output[2]) {
-            // Linear interpolation for upsampling
-            output[0] = upFilter.processLP((lastSample + input) * 0.5f);
-            output[1] = upFilter.processLP(input);
-            lastSample = input;
-        }
-        
-        float downsample(float input[2]) {
-            // Filter then decimate
-            float filtered0 = downFilter.processLP(input[0]);
-            float filtered1 = downFilter.processLP(input[1]);
-            // Don't reduce gain by averaging - just take the second sample (proper decimation)
-            return filtered1;
-        }
-        
-        void reset() {
-            upFilter.reset();
-            downFilter.reset();
-            lastSample = 0.0f;
-        }
-    };
-    
-    SimpleOversampler oversampler_[2];
+    // Anti-aliasing for the waveshaper. Minimum phase keeps the wet path within
+    // a few samples of the dry one for the mix control.
+    static constexpr int MAX_OVERSAMPLING = 4;
+    PolyphaseOversampler oversampler_;
+    int oversamplingFactor_ = MAX_OVERSAMPLING;  // from the quality tier
+    Quality quality_ = Quality::Ultra;
+    AntialiasingMode antialiasingMode_ = AntialiasingMode::Antiderivative;
+    AntiderivativeShaper<> shapers_[2];  // unit tanh; drive scales the input
+    bool useAdaa_ = false;
+
+    void applyAntialiasingPlan();
     
     // DC blocking filter
     struct DCBlocker {
@@ -155,15 +136,18 @@ private:
     
     DCBlocker dcBlocker_[2];
 
-    // nonlinearity: smooth, bounded
-    inline float waveshaper(float x, float drive) const noexcept {
+    // nonlinearity: smooth, bounded. Drive [0..1] maps to pre ~ [0 .. 15 dB]
+    // and makeup ~ [0 .. -3 dB], both computed once per block.
+    static inline float waveshaper(float x, float pre, float makeup) noexcept {
         // Soft clipping to prevent excessive harmonics
         x = juce::jlimit(-2.0f, 2.0f, x);
-        // Map Drive [0..1] -> effective gain ~ [1.0 .. ~15 dB]
-        const float pre = fromdB(juce::jmap(drive, 0.0f, 1.0f, 0.0f, 15.0f));
-        const float y = std::tanh(x * pre);
-        // Better makeup gain to maintain volume
-        const float makeup = fromdB(juce::jmap(drive, 0.0f, 1.0f, 0.0f, -3.0f));
-        return y * makeup;
+        return std::tanh(x * pre) * makeup;
+    }
+
+    // The same curve through ADAA. The +-2 input clamp is left out: tanh has
+    // saturated to within 1e-9 of it at any drive, and the clamp's corner
+    // would alias.
+    inline float adaaWaveshaper(int ch, float x, float pre, float makeup) noexcept {
+        return shapers_[ch].process(x * pre) * makeup;
     }
 };
\ No newline at end of file
@@ -42,10 +42,8 @@ void LadderFilter::prepareToPlay(double sampleRate, int samplesPerBlock) {
     m_vintageMode.setSmoothingTime(200.0f, sampleRate); // Very slow for mode
     m_mix.setSmoothingTime(20.0f, sampleRate);          // Medium for mix
     
-    // Initialize oversamplers
-    for (auto& oversampler : m_oversamplers) {
-        oversampler.initialize();
-    }
+    m_oversampler.prepare(2, samplesPerBlock, OVERSAMPLE_FACTOR, PolyphaseOversampler::Phase::Minimum);
+    m_oversampler.setFactor(m_oversamplingFactor);
     
     // Reset all states
     reset();
@@ -58,7 +56,7 @@ void LadderFilter::prepareToPlay(double sampleRate, int samplesPerBlock) {
     
     // Update coefficients
     m_coeffs.update(m_cutoffFreq.getCurrentValue(), m_resonance.getCurrentValue(), 
-                    isVintage, sampleRate, OVERSAMPLE_FACTOR);
+                    isVintage, sampleRate, m_oversampler.getFactor());
     
     // Track vintage mode for smooth transitions
     m_lastVintageMode = m_vintageMode.getCurrentValue();
@@ -70,10 +68,7 @@ void LadderFilter::reset() {
         channel.reset();
     }
     
-    // Reset oversamplers
-    for (auto& oversampler : m_oversamplers) {
-        oversampler.reset();
-    }
+    m_oversampler.reset();
     
     // Reset thermal model
     m_thermalModel.reset();
@@ -84,6 +79,15 @@ void LadderFilter::reset() {
     m_lastVintageMode = -1.0f;
 }
 
+void LadderFilter::setQuality(Quality quality) {
+    const int factor = PolyphaseOversampler::factorForQuality(quality, OVERSAMPLE_FACTOR);
+    if (factor != m_oversamplingFactor) {
+        m_oversamplingFactor = factor;
+        m_oversampler.setFactor(factor);
+        m_lastCutoff = -1.0f;  // Coefficients depend on the oversampled rate
+    }
+}
+
 void LadderFilter::process(juce::AudioBuffer<float>& buffer) {
     DenormalGuard guard;  // RAII denormal protection for entire process block
     
@@ -127,7 +131,7 @@ void LadderFilter::processBlock(float* channelData, int numSamples, int channel)
     if (std::abs(cutoff - m_lastCutoff) > 0.001f || 
         std::abs(resonance - m_lastResonance) > 0.001f) {
         m_coeffs.update(cutoff, resonance, vintageMode > 0.5f, 
-                       m_sampleRate, OVERSAMPLE_FACTOR);
+                       m_sampleRate, m_oversampler.getFactor());
         m_lastCutoff = cutoff;
         m_lastResonance = resonance;
         
@@ -171,7 +175,7 @@ float LadderFilter::processSample(float input, int channel) {
     float dcBlocked = state.processDCBlocker(input);
     
     // Process with oversampling
-    return m_oversamplers[channel].process(dcBlocked, 
+    return m_oversampler.processSample(channel, dcBlocked,
         [this, channel](float x) { return processLadderCore(x, channel); });
 }
 
@@ -458,87 +462,6 @@ float LadderFilter::SaturationModel::lookupSaturation(float input, bool vintage)
     return vintage ? vintageLUT[index] : saturationLUT[index];
 }
 
-// Oversampler implementation
-void LadderFilter::Oversampler::initialize() {
-    upsampler.designFilter(true);
-    downsampler.designFilter(false);
-    reset();
-}
-
-void LadderFilter::Oversampler::reset() {
-    upsampler.reset();
-    downsampler.reset();
-    std::fill(workBuffer.begin(), workBuffer.end(), 0.0f);
-}
-
-void LadderFilter::Oversampler::PolyphaseFilter::designFilter(bool isUpsampler) {
-    // Design linear-phase FIR filter using Kaiser window
-    const float beta = 7.0f; // Kaiser beta for ~80dB stopband
-    const float cutoff = 0.45f; // Normalized cutoff
-    
-    // Generate windowed sinc filter
-    for (int i = 0; i < FIR_LENGTH; ++i) {
-        float n = i - (FIR_LENGTH - 1) * 0.5f;
-        
-        // Sinc function
-        float sinc;
-        if (std::abs(n) < 1e-6f) {
-            sinc = 2.0f * cutoff;
-        } else {
-            sinc = std::sin(2.0f * M_PI * cutoff * n) / (M_PI * n);
-        }
-        
-        // Kaiser window
-        float x = 2.0f * i / (FIR_LENGTH - 1) - 1.0f;
-        float kaiser = modifiedBessel0(beta * std::sqrt(1.0f - x * x)) / modifiedBessel0(beta);
-        
-        coefficients[i] = sinc * kaiser;
-    }
-    
-    // Normalize
-    float sum = 0.0f;
-    for (float c : coefficients) sum += c;
-    
-    float gain = isUpsampler ? float(LadderFilter::OVERSAMPLE_FACTOR) : 1.0f;
-    for (float& c : coefficients) c *= gain / sum;
-}
-
-float LadderFilter::Oversampler::PolyphaseFilter::process(float input) {
-    // Update circular buffer
-    delayLine[writeIndex] = input;
-    writeIndex = (writeIndex + 1) % FIR_LENGTH;
-    
-    // Convolution
-    float output = 0.0f;
-    int readIndex = writeIndex;
-    
-    for (int i = 0; i < FIR_LENGTH; ++i) {
-        output += coefficients[i] * delayLine[readIndex];
-        readIndex = (readIndex + 1) % FIR_LENGTH;
-    }
-    
-    return output;
-}
-
-void LadderFilter::Oversampler::PolyphaseFilter::reset() {
-    std::fill(delayLine.begin(), delayLine.end(), 0.0f);
-    writeIndex = 0;
-}
-
-// Modified Bessel function of first kind, order 0 (for Kaiser window)
-float LadderFilter::Oversampler::PolyphaseFilter::modifiedBessel0(float x) {
-    float sum = 1.0f;
-    float term = 1.0f;
-    
-    for (int k = 1; k < 20; ++k) {
-        term *= (x * x) / (4.0f * k * k);
-        sum += term;
-        if (term < 1e-8f) break;
-    }
-    
-    return sum;
-}
-
 // Parameter update
 void LadderFilter::updateParameters(const std::map<int, float>& params) {
     auto it = params.find(0);
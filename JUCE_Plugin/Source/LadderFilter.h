@@ -2,6 +2,7 @@
 
 #include "../Source/EngineBase.h"
 #include "DspEngineUtilities.h"
+#include "PolyphaseOversampler.h"
 #include <array>
 #include <vector>
 #include <atomic>
@@ -21,18 +22,24 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality quality) override;
     juce::String getName() const override { return "Ladder Filter Pro"; }
     int getNumParameters() const override { return 7; }
     juce::String getParameterName(int index) const override;
     
 private:
     // Professional constants
-    static constexpr int OVERSAMPLE_FACTOR = 2;
+    static constexpr int OVERSAMPLE_FACTOR = 2;    // maximum, at Ultra
     static constexpr int BLOCK_SIZE = 32;
     static constexpr float MIN_CUTOFF = 20.0f;
     static constexpr float MAX_CUTOFF = 20000.0f;
     static constexpr float THERMAL_VOLTAGE = 0.026f; // 26mV at room temperature
     
+    // Saturation curve for the stages, feedback and output: the 3/2 Pade
+    // approximant the ladder is voiced on, at every quality tier (its cost
+    // follows the oversampling factor instead)
+    static constexpr FastMath::Accuracy TANH_ACCURACY = FastMath::Accuracy::Coarse;
+    
     // Thread-safe smoothed parameters
     struct SmoothedParameter {
         std::atomic<float> targetValue{0.5f};
@@ -98,7 +105,7 @@ private:
             float output = v + state;
             
             // Apply saturation
-            output = tanhApprox(output * saturation) / saturation;
+            output = FastMath::tanh(output * saturation, TANH_ACCURACY) / saturation;
             
             // Update state
             delay = state;
@@ -106,13 +113,6 @@ private:
             
             return output;
         }
-        
-    private:
-        // Fast tanh approximation
-        static float tanhApprox(float x) {
-            float x2 = x * x;
-            return x * (27.0f + x2) / (27.0f + 9.0f * x2);
-        }
     };
     
     // Per-channel state
@@ -149,54 +149,10 @@ private:
     
     std::array<ChannelState, 2> m_channelStates;
     
-    // Professional oversampling
-    class Oversampler {
-    private:
-        static constexpr int FIR_LENGTH = 32;
-        
-        // Polyphase FIR structure
-        struct PolyphaseFilter {
-            std::array<float, FIR_LENGTH> coefficients;
-            std::array<float, FIR_LENGTH> delayLine;
-            int writeIndex = 0;
-            
-            void designFilter(bool isUpsampler);
-            float process(float input);
-            void reset();
-            
-        private:
-            static float modifiedBessel0(float x);
-        };
-        
-        PolyphaseFilter upsampler;
-        PolyphaseFilter downsampler;
-        std::array<float, OVERSAMPLE_FACTOR> workBuffer;
-        
-    public:
-        void initialize();
-        void reset();
-        
-        template<typename ProcessFunc>
-        float process(float input, ProcessFunc func) {
-            // Upsample
-            workBuffer[0] = input * OVERSAMPLE_FACTOR;
-            for (int i = 1; i < OVERSAMPLE_FACTOR; ++i) {
-                workBuffer[i] = 0.0f;
-            }
-            
-            // Filter and process
-            for (int i = 0; i < OVERSAMPLE_FACTOR; ++i) {
-                workBuffer[i] = upsampler.process(workBuffer[i]);
-                workBuffer[i] = func(workBuffer[i]);
-                workBuffer[i] = downsampler.process(workBuffer[i]);
-            }
-            
-            // Return downsampled result
-            return workBuffer[0];
-        }
-    };
-    
-    std::array<Oversampler, 2> m_oversamplers;
+    // Oversampling for the ladder core; the factor follows the quality tier
+    // and the coefficients are computed for the oversampled rate
+    PolyphaseOversampler m_oversampler;
+    int m_oversamplingFactor = OVERSAMPLE_FACTOR;
     
     // Filter coefficients with stability
     struct FilterCoefficients {
@@ -302,8 +258,7 @@ private:
     }
     
     static inline float fastTanh(float x) {
-        float x2 = x * x;
-        return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+        return FastMath::tanh(x, TANH_ACCURACY);
     }
     
     // SIMD optimizations (when available)
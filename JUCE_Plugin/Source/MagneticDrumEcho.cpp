@@ -102,13 +102,7 @@ void MagneticDrumEcho::reset() {
         m_oversamplers[ch]->reset();
     }
     
-    // Clear work buffers
-    for (auto& buffer : m_workBuffers) {
-        buffer.fill(0.0);
-    }
-    for (auto& buffer : m_oversampledBuffers) {
-        buffer.fill(0.0);
-    }
+    // The work buffers are scratch, written before they are read
 }
 
 void MagneticDrumEcho::process(juce::AudioBuffer<float>& buffer) {
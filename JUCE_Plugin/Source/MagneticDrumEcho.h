@@ -2,6 +2,7 @@
 #pragma once
 #include "EngineBase.h"
 #include "DspEngineUtilities.h"
+#include "ResetHorizon.h"
 #include <array>
 #include <memory>
 #include <atomic>
@@ -27,6 +28,10 @@ public:
     void setTransportInfo(const TransportInfo& info) override;
     bool supportsFeature(Feature f) const noexcept override;
     
+    // Three heads summed into a boosted, saturating feedback path can hold
+    // a loop gain near unity, so report the worst case
+    double getTailLengthSeconds() const noexcept override { return ChimeraConfig::ENGINE_TAIL_MAX_SECONDS; }
+    
     // Optional: Configure max delay time before prepareToPlay()
     void setMaxDelayTime(double seconds) { 
         m_maxDelaySeconds = std::clamp(seconds, 0.1, 5.0); 
@@ -83,27 +88,36 @@ private:
         double getCurrent() const { return currentValue; }
     };
     
-    // Efficient shared circular buffer for drum
+    // Efficient shared circular buffer for drum. reset() is constant time:
+    // positions written before it read as silence until overwritten.
     class CircularDrumBuffer {
         std::vector<float> buffer;
         size_t bufferSize = 0;
         size_t writePos = 0;
+        ResetHorizon horizon;
+        
+        float readSinceReset(int idx) const {
+            const size_t age = (writePos + bufferSize - 1 - static_cast<size_t>(idx)) % bufferSize;
+            return horizon.isFresh(age) ? buffer[idx] : 0.0f;
+        }
         
     public:
         void prepare(double sampleRate, double maxDelaySeconds) {
             bufferSize = static_cast<size_t>(sampleRate * maxDelaySeconds) + 1;
-            buffer.resize(bufferSize);
+            buffer.assign(bufferSize, 0.0f);
+            horizon.prepare(bufferSize);
             reset();
         }
         
         void reset() {
-            std::fill(buffer.begin(), buffer.end(), 0.0f);
+            horizon.reset();
             writePos = 0;
         }
         
         void write(float sample) {
             buffer[writePos] = sample;
             writePos = (writePos + 1) % bufferSize;
+            horizon.advance();
         }
         
         float read(double delaySamples) const {
@@ -124,6 +138,12 @@ private:
             float y1 = buffer[idx1];
             float y2 = buffer[idx2];
             float y3 = buffer[idx3];
+            if (!horizon.isSettled()) {
+                y0 = readSinceReset(idx0);
+                y1 = readSinceReset(idx1);
+                y2 = readSinceReset(idx2);
+                y3 = readSinceReset(idx3);
+            }
             
             float c0 = y1;
             float c1 = 0.5f * (y2 - y0);
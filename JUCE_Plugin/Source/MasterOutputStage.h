@@ -0,0 +1,324 @@
+// MasterOutputStage.h - Final gain, clip protection and metering in one pass
+//
+// Two modes, both a single pass over each channel:
+//  - Soft clip (default, zero latency): the compensation gain, the legacy
+//    soft clip (tanh above SOFT_CLIP_THRESHOLD, then a hard limit there) and
+//    peak/RMS metering, four samples at a time. The tanh branch only runs for
+//    the rare vectors that actually cross the threshold, so clean blocks cost
+//    one multiply, one compare and the metering per sample; when it does run
+//    it is FastMath's four-lane tanh rather than four calls into libm.
+//  - True-peak limiter: a stereo-linked lookahead limiter to LIMITER_CEILING_DB
+//    dBTP. Inter-sample peaks are estimated with a 4x polyphase interpolator
+//    (as in ITU-R BS.1770), held over the lookahead window with a
+//    SlidingWindowPeak, released exponentially and smoothed by a box filter as
+//    long as the lookahead, so gain has fully arrived by the time the peak
+//    leaves the delay line. Adds getLimiterLatencySamples() of latency.
+//
+// measure() is the same metering without the processing, for the input meter.
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DspEngineUtilities.h"
+#include "SlidingWindowPeak.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+#if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    #include <xmmintrin.h>
+#endif
+
+class MasterOutputStage {
+public:
+    static constexpr float SOFT_CLIP_THRESHOLD = 0.98f;    // -0.2 dBFS
+    static constexpr float LIMITER_CEILING_DB = -1.0f;
+    static constexpr double LOOKAHEAD_MS = 1.5;
+    static constexpr double RELEASE_MS = 60.0;
+
+    // 4x true-peak interpolator: 3 fractional phases of INTERP_TAPS each
+    static constexpr int OVERSAMPLING = 4;
+    static constexpr int INTERP_TAPS = 12;
+    static constexpr int INTERP_DELAY = INTERP_TAPS / 2;
+
+    struct Levels {
+        float peak = 0.0f;
+        float rms = 0.0f;
+    };
+
+    struct Result {
+        Levels output;
+        float minGain = 1.0f;    // limiter gain reduction over the block (1 = none)
+    };
+
+    // Message thread: sizes the lookahead for sampleRate and numChannels
+    void prepare(double sampleRate, int numChannels) {
+        lookahead = juce::jmax(1, juce::roundToInt(LOOKAHEAD_MS * 0.001 * sampleRate));
+        releaseCoeff = (float) std::exp(-1.0 / (RELEASE_MS * 0.001 * sampleRate));
+        ceiling = juce::Decibels::decibelsToGain(LIMITER_CEILING_DB);
+
+        channels.resize((size_t) juce::jmax(1, numChannels));
+        for (auto& channel : channels)
+            channel.delay.assign((size_t) getLimiterLatencySamples(), 0.0f);
+
+        boxHistory.assign((size_t) lookahead, 1.0);
+        peakHold.prepare(lookahead + 1);
+        designInterpolator();
+        reset();
+    }
+
+    void reset() noexcept {
+        for (auto& channel : channels) {
+            std::fill(channel.delay.begin(), channel.delay.end(), 0.0f);
+            channel.history.fill(0.0f);
+        }
+        std::fill(boxHistory.begin(), boxHistory.end(), 1.0);
+        boxSum = (double) lookahead;
+        envelope = 1.0f;
+        historyPos = 0;
+        delayPos = 0;
+        boxPos = 0;
+        peakHold.reset();
+        limiterWasEnabled = false;
+    }
+
+    // Lookahead plus the interpolator's centre delay; what the host is told
+    // while the limiter is enabled
+    int getLimiterLatencySamples() const noexcept { return lookahead + INTERP_DELAY; }
+
+    // Audio thread. Scales by gain, then clips or limits in place and meters
+    // the result. Channels beyond those prepared fall back to the soft clip.
+    Result process(juce::AudioBuffer<float>& buffer, int numSamples, float gain, bool useLimiter) noexcept {
+        Result result;
+        const int numChannels = buffer.getNumChannels();
+        if (numSamples <= 0 || numChannels <= 0)
+            return result;
+
+        float peak = 0.0f;
+        double sumSquares = 0.0;
+        int firstClipChannel = 0;
+
+        if (useLimiter && !channels.empty()) {
+            // A fresh lookahead rather than resuming a stale one
+            if (!limiterWasEnabled)
+                reset();
+            limiterWasEnabled = true;
+
+            firstClipChannel = juce::jmin(numChannels, (int) channels.size());
+            result.minGain = limit(buffer, firstClipChannel, numSamples, gain, peak, sumSquares);
+        } else {
+            limiterWasEnabled = false;
+        }
+
+        for (int ch = firstClipChannel; ch < numChannels; ++ch)
+            softClip(buffer.getWritePointer(ch), numSamples, gain, peak, sumSquares);
+
+        result.output = { peak, (float) std::sqrt(sumSquares / ((double) numChannels * numSamples)) };
+        return result;
+    }
+
+    // Peak and RMS across all channels, four samples at a time
+    static Levels measure(const juce::AudioBuffer<float>& buffer, int numSamples) noexcept {
+        const int numChannels = buffer.getNumChannels();
+        if (numSamples <= 0 || numChannels <= 0)
+            return {};
+
+        float peak = 0.0f;
+        double sumSquares = 0.0;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const float* data = buffer.getReadPointer(ch);
+            int i = 0;
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            __m128 vPeak = _mm_setzero_ps(), vSum = _mm_setzero_ps();
+            for (; i + 4 <= numSamples; i += 4) {
+                const __m128 x = _mm_loadu_ps(data + i);
+                vPeak = _mm_max_ps(vPeak, _mm_andnot_ps(signMask, x));
+                vSum = _mm_add_ps(vSum, _mm_mul_ps(x, x));
+            }
+            peak = juce::jmax(peak, horizontalMax(vPeak));
+            sumSquares += horizontalSum(vSum);
+           #endif
+            for (; i < numSamples; ++i) {
+                peak = juce::jmax(peak, std::abs(data[i]));
+                sumSquares += (double) data[i] * data[i];
+            }
+        }
+        return { peak, (float) std::sqrt(sumSquares / ((double) numChannels * numSamples)) };
+    }
+
+    // The legacy per-sample curve, with FastMath's Fine tanh: within 1.3e-6
+    // of std::tanh's
+    static float softClipSample(float x) noexcept {
+        if (std::abs(x) > SOFT_CLIP_THRESHOLD)
+            x = FastMath::tanh(x * 0.7f) * 1.3f;
+        return juce::jlimit(-SOFT_CLIP_THRESHOLD, SOFT_CLIP_THRESHOLD, x);
+    }
+
+private:
+    struct Channel {
+        std::vector<float> delay;
+        // Last INTERP_TAPS inputs written twice so the taps are always contiguous
+        std::array<float, 2 * INTERP_TAPS> history{};
+    };
+
+    static void softClip(float* data, int numSamples, float gain, float& peak, double& sumSquares) noexcept {
+        int i = 0;
+       #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+        const __m128 g = _mm_set1_ps(gain);
+        const __m128 threshold = _mm_set1_ps(SOFT_CLIP_THRESHOLD);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 vPeak = _mm_setzero_ps(), vSum = _mm_setzero_ps();
+
+        for (; i + 4 <= numSamples; i += 4) {
+            __m128 x = _mm_mul_ps(_mm_loadu_ps(data + i), g);
+            const __m128 over = _mm_cmpgt_ps(_mm_andnot_ps(signMask, x), threshold);
+
+            if (_mm_movemask_ps(over) != 0) {
+                // Lanes under the threshold pass through the limit unchanged
+                const __m128 clipped = _mm_mul_ps(FastMath::tanh(_mm_mul_ps(x, _mm_set1_ps(0.7f))), _mm_set1_ps(1.3f));
+                x = _mm_or_ps(_mm_and_ps(over, clipped), _mm_andnot_ps(over, x));
+                x = _mm_max_ps(_mm_xor_ps(threshold, signMask), _mm_min_ps(threshold, x));
+            }
+
+            _mm_storeu_ps(data + i, x);
+            vPeak = _mm_max_ps(vPeak, _mm_andnot_ps(signMask, x));
+            vSum = _mm_add_ps(vSum, _mm_mul_ps(x, x));
+        }
+        peak = juce::jmax(peak, horizontalMax(vPeak));
+        sumSquares += horizontalSum(vSum);
+       #endif
+        for (; i < numSamples; ++i) {
+            const float y = softClipSample(data[i] * gain);
+            data[i] = y;
+            peak = juce::jmax(peak, std::abs(y));
+            sumSquares += (double) y * y;
+        }
+    }
+
+    float limit(juce::AudioBuffer<float>& buffer, int numChannels, int numSamples, float gain,
+                float& peak, double& sumSquares) noexcept {
+        auto* const* data = buffer.getArrayOfWritePointers();
+        const int latency = getLimiterLatencySamples();
+        float minGain = 1.0f;
+
+        for (int i = 0; i < numSamples; ++i) {
+            // Loudest true peak among the newest inputs, centred INTERP_DELAY back
+            float truePeak = 0.0f;
+            for (int ch = 0; ch < numChannels; ++ch) {
+                auto& history = channels[(size_t) ch].history;
+                const float x = data[ch][i] * gain;
+                history[(size_t) historyPos] = x;
+                history[(size_t) (historyPos + INTERP_TAPS)] = x;
+                truePeak = juce::jmax(truePeak, interpolatedPeak(history.data() + historyPos + 1));
+            }
+            historyPos = historyPos + 1 == INTERP_TAPS ? 0 : historyPos + 1;
+
+            // Hold the worst peak for the lookahead, attack instantly, release slowly
+            const float held = peakHold.process(truePeak);
+            const float target = held > ceiling ? ceiling / held : 1.0f;
+            envelope = target < envelope ? target : target + (envelope - target) * releaseCoeff;
+
+            // Box smoothing as long as the lookahead: never above the held target
+            boxSum += (double) envelope - boxHistory[(size_t) boxPos];
+            boxHistory[(size_t) boxPos] = envelope;
+            boxPos = boxPos + 1 == lookahead ? 0 : boxPos + 1;
+            const float g = juce::jmin(1.0f, (float) (boxSum / (double) lookahead));
+            minGain = juce::jmin(minGain, g);
+
+            for (int ch = 0; ch < numChannels; ++ch) {
+                auto& delay = channels[(size_t) ch].delay;
+                const float delayed = delay[(size_t) delayPos];
+                delay[(size_t) delayPos] = channels[(size_t) ch].history[(size_t) (historyPos == 0 ? INTERP_TAPS - 1 : historyPos - 1)];
+
+                // Hard limit only catches what the 4x estimate can miss
+                const float y = juce::jlimit(-SOFT_CLIP_THRESHOLD, SOFT_CLIP_THRESHOLD, delayed * g);
+                data[ch][i] = y;
+                peak = juce::jmax(peak, std::abs(y));
+                sumSquares += (double) y * y;
+            }
+            delayPos = delayPos + 1 == latency ? 0 : delayPos + 1;
+        }
+        return minGain;
+    }
+
+    // Max of the sample at the centre and the three points after it
+    float interpolatedPeak(const float* taps) const noexcept {
+        float result = std::abs(taps[INTERP_DELAY - 1]);
+        for (int phase = 0; phase < OVERSAMPLING - 1; ++phase)
+            result = juce::jmax(result, std::abs(dot(interpolator[(size_t) phase].data(), taps)));
+        return result;
+    }
+
+    static float dot(const float* a, const float* b) noexcept {
+       #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+        __m128 acc = _mm_setzero_ps();
+        for (int i = 0; i < INTERP_TAPS; i += 4)
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_load_ps(a + i), _mm_loadu_ps(b + i)));
+        return horizontalSum(acc);
+       #else
+        float sum = 0.0f;
+        for (int i = 0; i < INTERP_TAPS; ++i)
+            sum += a[i] * b[i];
+        return sum;
+       #endif
+    }
+
+   #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    static float horizontalSum(__m128 v) noexcept {
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+        return _mm_cvtss_f32(v);
+    }
+
+    static float horizontalMax(__m128 v) noexcept {
+        v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 1));
+        return _mm_cvtss_f32(v);
+    }
+   #endif
+
+    // Kaiser-windowed sinc at fractional offsets 1/4, 2/4, 3/4 past the centre
+    // tap, each phase normalised to unity DC gain
+    void designInterpolator() {
+        constexpr double beta = 5.0;
+        const double half = INTERP_TAPS / 2.0;
+
+        for (int phase = 0; phase < OVERSAMPLING - 1; ++phase) {
+            const double fraction = (phase + 1) / (double) OVERSAMPLING;
+            double sum = 0.0;
+            for (int k = 0; k < INTERP_TAPS; ++k) {
+                const double t = (double) (k - (INTERP_DELAY - 1)) - fraction;
+                const double w = t / half;
+                const double window = besselI0(beta * std::sqrt(juce::jmax(0.0, 1.0 - w * w))) / besselI0(beta);
+                const double sinc = std::sin(juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+                interpolator[(size_t) phase][(size_t) k] = (float) (sinc * window);
+                sum += sinc * window;
+            }
+            for (auto& tap : interpolator[(size_t) phase])
+                tap = (float) (tap / sum);
+        }
+    }
+
+    static double besselI0(double x) noexcept {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 50 && term > 1.0e-12 * sum; ++k) {
+            const double f = x / (2.0 * k);
+            term *= f * f;
+            sum += term;
+        }
+        return sum;
+    }
+
+    std::vector<Channel> channels;
+    alignas(16) std::array<std::array<float, INTERP_TAPS>, OVERSAMPLING - 1> interpolator{};
+    std::vector<double> boxHistory;
+    SlidingWindowPeak peakHold;
+
+    int lookahead = 1;
+    float ceiling = 1.0f;
+    float releaseCoeff = 0.0f;
+    float envelope = 1.0f;
+    double boxSum = 1.0;
+    int historyPos = 0, delayPos = 0, boxPos = 0;
+    bool limiterWasEnabled = false;
+};
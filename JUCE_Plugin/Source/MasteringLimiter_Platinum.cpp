@@ -3,6 +3,7 @@
 // ===============================================================
 #include "MasteringLimiter_Platinum.h"
 #include "DspEngineUtilities.h"
+#include "SlidingWindowPeak.h"
 #include <cmath>
 #include <algorithm>
 #include <vector>
@@ -138,9 +139,10 @@ struct MasteringLimiter_Platinum::Impl {
     std::vector<DelayLine> delayLines;
     std::vector<float> lastGain;
     
-    // Predictive gain analysis for lookahead
-    std::vector<std::vector<float>> lookaheadAnalysis;
-    std::vector<int> analysisIndex;
+    // Predictive gain analysis for lookahead: running maximum of the gain
+    // reduction depth (1 - gain) over the lookahead window. The gain is
+    // stereo-linked, so one detector serves every channel.
+    SlidingWindowPeak reductionWindow;
     
     // Enhanced true-peak detection
     std::vector<float> peakHold;
@@ -161,13 +163,9 @@ struct MasteringLimiter_Platinum::Impl {
         oversampleBuffer.resize(numChannels);
         oversampleIndex.resize(numChannels, 0);
         
-        // Calculate max lookahead samples and initialize predictive analysis buffers
+        // Calculate max lookahead samples and initialize predictive analysis
         int maxLookaheadSamples = (int)(kMaxLookaheadMs * 0.001 * sampleRate);
-        lookaheadAnalysis.resize(numChannels);
-        analysisIndex.resize(numChannels, 0);
-        for (int ch = 0; ch < numChannels; ++ch) {
-            lookaheadAnalysis[ch].resize(maxLookaheadSamples, 1.0f);
-        }
+        reductionWindow.prepare(maxLookaheadSamples);
         
         for (int ch = 0; ch < numChannels; ++ch) {
             envelopes[ch].prepare(sampleRate);
@@ -184,10 +182,7 @@ struct MasteringLimiter_Platinum::Impl {
         std::fill(peakHold.begin(), peakHold.end(), 0.0f);
         
         // Reset predictive analysis and oversampling buffers
-        for (auto& analysis : lookaheadAnalysis) {
-            std::fill(analysis.begin(), analysis.end(), 1.0f);
-        }
-        std::fill(analysisIndex.begin(), analysisIndex.end(), 0);
+        reductionWindow.reset();
         
         for (auto& osBuffer : oversampleBuffer) {
             osBuffer.fill(0.0f);
@@ -217,6 +212,7 @@ struct MasteringLimiter_Platinum::Impl {
         for (int ch = 0; ch < numChannels; ++ch) {
             delayLines[ch].setDelay(lookaheadSamples);
         }
+        reductionWindow.setWindowLength(lookaheadSamples + 1);
         
         // Convert parameters to linear
         const float thresholdGain = dBToGain(threshold);
@@ -294,13 +290,8 @@ struct MasteringLimiter_Platinum::Impl {
             
             gainReduction = clamp(gainReduction, 0.001f, 1.0f);
             
-            // Store gain reduction in predictive analysis buffer for lookahead smoothing
-            for (int ch = 0; ch < numChannels && ch < (int)lookaheadAnalysis.size(); ++ch) {
-                if (!lookaheadAnalysis[ch].empty()) {
-                    lookaheadAnalysis[ch][analysisIndex[ch]] = gainReduction;
-                    analysisIndex[ch] = (analysisIndex[ch] + 1) % (int)lookaheadAnalysis[ch].size();
-                }
-            }
+            // Deepest gain reduction across the lookahead window, amortised O(1)
+            const float minFutureGain = 1.0f - reductionWindow.process(1.0f - gainReduction);
             
             // Process each channel
             for (int ch = 0; ch < numChannels; ++ch) {
@@ -329,21 +320,11 @@ struct MasteringLimiter_Platinum::Impl {
                 float logReleaseTime = std::log(1.0f + releaseSamples * 0.01f);  // Logarithmic scaling
                 releaseCoeff = 1.0f - std::exp(-1.0f / (logReleaseTime * sampleRate * 0.001f));
                 
-                // Predictive lookahead adjustment
+                // Predictive lookahead adjustment: use the attack coefficient
+                // if we predict incoming gain reduction
                 float adaptiveCoeff = releaseCoeff;  // Default to release
-                if (ch < (int)lookaheadAnalysis.size() && !lookaheadAnalysis[ch].empty()) {
-                    // Analyze future gain reduction values
-                    float minFutureGain = gainReduction;
-                    int lookaheadSamplesToCheck = std::min(lookaheadSamples, (int)lookaheadAnalysis[ch].size() - 1);
-                    for (int j = 1; j <= lookaheadSamplesToCheck; ++j) {
-                        int futureIndex = (analysisIndex[ch] + j) % (int)lookaheadAnalysis[ch].size();
-                        minFutureGain = std::min(minFutureGain, lookaheadAnalysis[ch][futureIndex]);
-                    }
-                    
-                    // Use attack coefficient if we predict incoming gain reduction
-                    if (minFutureGain < gainReduction * 0.9f) {
-                        adaptiveCoeff = attackCoeff;  // Fast attack for predicted limiting
-                    }
+                if (minFutureGain < gainReduction * 0.9f) {
+                    adaptiveCoeff = attackCoeff;  // Fast attack for predicted limiting
                 }
                 
                 // Apply appropriate coefficient based on gain change direction
@@ -44,10 +44,27 @@ void MuffFuzz::prepareToPlay(double sampleRate, int samplesPerBlock) {
         m_inputDCBlockers[ch].setCutoff(20.0, sampleRate);
         m_outputDCBlockers[ch].setCutoff(10.0, sampleRate);
     }
+    applyAntialiasingPlan();
     
     reset();
 }
 
+void MuffFuzz::setQuality(Quality q) {
+    m_quality = q;
+    applyAntialiasingPlan();
+}
+
+void MuffFuzz::setAntialiasingMode(AntialiasingMode mode) {
+    m_antialiasingMode = mode;
+    applyAntialiasingPlan();
+}
+
+void MuffFuzz::applyAntialiasingPlan() {
+    const int order = antialiasingForQuality(m_quality, m_antialiasingMode, 1).adaaOrder;
+    for (auto& circuit : m_circuits)
+        circuit.setAdaaOrder(order);
+}
+
 void MuffFuzz::process(juce::AudioBuffer<float>& buffer) {
     DenormalGuard guard;
 
@@ -306,6 +323,20 @@ double MuffFuzz::TransistorClippingStage::process(double input, double gain, dou
 }
 
 // DiodeClipper implementation
+double MuffFuzz::DiodeClipper::unitCurve(double u) {
+    // process() with the threshold scaled out: linear to half of it, then
+    // tanh up to the full threshold
+    const double absU = std::abs(u);
+    if (absU < 0.5) return u;
+    return std::copysign(0.5 + 0.5 * std::tanh(absU - 0.5), u);
+}
+
+const AdaaTable& MuffFuzz::DiodeClipper::unitTable() {
+    // Flat to 1e-6 past +-8
+    static const AdaaTable table(unitCurve, 8.0);
+    return table;
+}
+
 double MuffFuzz::DiodeClipper::process(double voltage) {
     // OPTIMIZATION: Cache temperature-dependent parameters
     static double cachedTemp = 0.0;
@@ -408,6 +439,15 @@ void MuffFuzz::BigMuffCircuit::prepare(double sampleRate) {
     outputBuffer.setSampleRate(sampleRate);
     
     toneStack.updateCoefficients(0.5, sampleRate);
+    
+    diodeClipper1.setAdaaCurve(DiodeClipper::unitTable());
+    diodeClipper2.setAdaaCurve(DiodeClipper::unitTable());
+}
+
+void MuffFuzz::BigMuffCircuit::setAdaaOrder(int order) noexcept {
+    adaaOrder = order;
+    diodeClipper1.setAdaaOrder(order);
+    diodeClipper2.setAdaaOrder(order);
 }
 
 double MuffFuzz::BigMuffCircuit::process(double input, double sustain, double tone, double volume) {
@@ -428,14 +468,16 @@ double MuffFuzz::BigMuffCircuit::process(double input, double sustain, double to
     signal = clippingStage1.process(signal, gain1, 0.1);
 
     // First diode clipping
-    signal = diodeClipper1.process(signal * 0.5) * 2.0;
+    signal = (adaaOrder > 0 ? diodeClipper1.processAdaa(signal * 0.5)
+                            : diodeClipper1.process(signal * 0.5)) * 2.0;
 
     // Second clipping stage
     double gain2 = 10.0 * (0.5 + sustain * 0.5);  // Additional gain
     signal = clippingStage2.process(signal, gain2, 0.05);
 
     // Second diode clipping
-    signal = diodeClipper2.process(signal * 0.3) * 3.33;
+    signal = (adaaOrder > 0 ? diodeClipper2.processAdaa(signal * 0.3)
+                            : diodeClipper2.process(signal * 0.3)) * 3.33;
 
     // Tone stack - coefficients already updated if needed
     signal = toneStack.process(signal);
@@ -469,6 +511,8 @@ void MuffFuzz::BigMuffCircuit::reset() {
     clippingStage2.reset();
     outputBuffer.reset();
     toneStack.reset();
+    diodeClipper1.reset();
+    diodeClipper2.reset();
 }
 
 // NoiseGate implementation
@@ -1,5 +1,6 @@
 #pragma once
 #include "EngineBase.h"
+#include "AntiderivativeShaper.h"
 #include <vector>
 #include <array>
 #include <memory>
@@ -17,6 +18,12 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override;
+    
+    // Antiderivative (default): 1st-order ADAA on both diode clippers.
+    // Oversampling: the plain clippers, as before ADAA (the circuit runs at
+    // the base rate either way).
+    void setAntialiasingMode(AntialiasingMode mode);
     
     juce::String getName() const override { return "Muff Fuzz"; }
     int getNumParameters() const override { return 7; }
@@ -116,9 +123,23 @@ private:
         
         double temperature = 298.15;
         
+        // The curve scales with its threshold, so ADAA runs on the
+        // unit-threshold curve of voltage / threshold
+        AntiderivativeShaper<> adaa;
+        
     public:
+        static double unitCurve(double u);
+        static const AdaaTable& unitTable();
+        
         double process(double voltage);
+        double processAdaa(double voltage) noexcept {
+            const double threshold = DIODE_THRESHOLD * (1.0 - (temperature - 298.15) * 0.002);
+            return threshold * adaa.process(voltage / threshold);
+        }
         void setTemperature(double tempK) { temperature = tempK; }
+        void setAdaaCurve(const AdaaTable& unitTable) { adaa.setCurve(unitTable); }
+        void setAdaaOrder(int order) noexcept { adaa.setOrder(order); }
+        void reset() noexcept { adaa.reset(); }
     };
     
     // Professional oversampling
@@ -183,8 +204,11 @@ private:
         // Store sample rate for tone stack
         double circuitSampleRate = 0.0;
         
+        int adaaOrder = 0;
+        
     public:
         void prepare(double sampleRate);
+        void setAdaaOrder(int order) noexcept;
         double process(double input, double sustain, double tone, double volume);
         void setTemperature(double tempK);
         void setComponentVariation(double matching);
@@ -293,6 +317,10 @@ private:
     
     ThermalModel m_thermalModel;
     
+    Quality m_quality = Quality::Ultra;
+    AntialiasingMode m_antialiasingMode = AntialiasingMode::Antiderivative;
+    void applyAntialiasingPlan();
+    
     // Apply variant-specific modifications
     void applyVariantSettings(FuzzVariant variant);
 };
\ No newline at end of file
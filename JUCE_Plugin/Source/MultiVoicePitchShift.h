@@ -0,0 +1,235 @@
+// MultiVoicePitchShift.h - Several pitch-shifted voices from one shared analysis
+//
+// Phase vocoder (periodic Hann, 4x overlap, ~43 ms frames at any sample rate)
+// split where the voices diverge. Each hop the input frame is transformed once
+// and everything that does not depend on the ratio is done once: bin phases,
+// spectral peaks with their regions of influence, and each peak's true
+// frequency. A voice then only moves every peak region rigidly to the bin
+// nearest its shifted frequency, rotated by one phasor that keeps the peak's
+// phase advancing at the new frequency (Laroche & Dolson's peak-locked
+// pitch shifting). That is one sincos per peak and one complex multiply-add per
+// bin, and it keeps each partial's window lobe intact.
+//
+// Windowing and overlap-add are linear, so the voices' spectra are summed,
+// already scaled by their gains, and share a single inverse transform. A
+// three-voice harmony therefore costs one forward and one inverse FFT per hop
+// plus a cheap pass for each audible voice, instead of three complete pitch
+// shifters. Voices below MIN_VOICE_GAIN are skipped entirely.
+//
+// Framing and overlap-add are the shared StftProcessor's; this is its kernel.
+//
+// Everything is allocated in prepare(); process() is real-time safe.
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "StftProcessor.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+class MultiVoicePitchShift {
+public:
+    static constexpr int MAX_VOICES = 3;
+    static constexpr int OVERLAP = 4;
+    static constexpr float MIN_VOICE_GAIN = 0.01f;
+
+    // Message thread. Frames are 2048 samples up to 64 kHz and scale with the
+    // rate above that, so the frequency resolution stays the same.
+    void prepare(double sampleRate) {
+        int order = 11;
+        while (order < 13 && sampleRate / (double) (1 << order) > 32.0)
+            ++order;
+
+        stft.prepare(1, order, OVERLAP);
+        numBins = stft.getNumBins();
+
+        spectrum.resize((size_t) numBins * 2);
+        powers.resize((size_t) numBins);
+        phases.resize((size_t) numBins);
+        lastPhases.resize((size_t) numBins);
+        peakBins.resize((size_t) numBins);
+        peakFrequencies.resize((size_t) numBins);
+        regionStarts.resize((size_t) numBins + 1);
+        peakOwners.resize((size_t) numBins);
+        lastPeakOwners.resize((size_t) numBins);
+        for (auto& voice : voices) {
+            voice.phases.resize((size_t) numBins);
+            voice.lastPhases.resize((size_t) numBins);
+        }
+
+        reset();
+    }
+
+    void reset() noexcept {
+        stft.reset();
+        std::fill(lastPhases.begin(), lastPhases.end(), 0.0f);
+        std::fill(peakOwners.begin(), peakOwners.end(), 0);
+        for (auto& voice : voices)
+            voice.running = false;
+    }
+
+    // One frame
+    int getLatencySamples() const noexcept { return stft.getLatencySamples(); }
+
+    // Writes the sum of numVoices pitch-shifted copies of input to output
+    // (which may alias input). Ratios and gains are read once per hop.
+    void process(const float* input, float* output, int numSamples,
+                 const float* ratios, const float* gains, int numVoices) noexcept {
+        numVoices = juce::jmin(numVoices, MAX_VOICES);
+
+        stft.process(0, input, output, numSamples, [&](std::complex<float>* bins, int) {
+           return processFrame(reinterpret_cast<float*>(bins), ratios, gains, numVoices);
+       });
+    }
+
+private:
+    struct Voice {
+        // Synthesis phase of each peak, indexed by its source bin, for this
+        // frame and the last
+        std::vector<float> phases, lastPhases;
+        bool running = false;  // false: next frame starts from the analysis phases
+    };
+
+    // Phase advance of a bin-centred partial over one hop, per bin
+    static constexpr float PHASE_ADVANCE_PER_BIN = juce::MathConstants<float>::twoPi / (float) OVERLAP;
+
+    static float wrapPhase(float phase) noexcept {
+        return phase - juce::MathConstants<float>::twoPi
+                         * std::floor(phase / juce::MathConstants<float>::twoPi + 0.5f);
+    }
+
+    // Replaces the frame's bins with the voices' sum; false if none sounds
+    bool processFrame(float* bins, const float* ratios, const float* gains, int numVoices) noexcept {
+        analyse(bins);
+
+        std::fill(bins, bins + numBins * 2, 0.0f);
+        bool anyVoice = false;
+
+        for (int v = 0; v < numVoices; ++v) {
+            auto& voice = voices[(size_t) v];
+            if (gains[v] < MIN_VOICE_GAIN) {
+                voice.running = false;
+                continue;
+            }
+
+            synthesiseVoice(bins, ratios[v], gains[v], voice);
+            anyVoice = true;
+        }
+
+        for (int v = numVoices; v < MAX_VOICES; ++v)
+            voices[(size_t) v].running = false;
+
+        return anyVoice;
+    }
+
+    // Shared by every voice: spectrum, bin phases, peaks, their regions and
+    // true frequencies (in bins)
+    void analyse(const float* bins) noexcept {
+        std::copy(bins, bins + numBins * 2, spectrum.begin());
+        std::swap(phases, lastPhases);
+        std::swap(peakOwners, lastPeakOwners);
+
+        float maxPower = 0.0f;
+        for (int k = 0; k < numBins; ++k) {
+            const float re = spectrum[(size_t) (k * 2)];
+            const float im = spectrum[(size_t) (k * 2 + 1)];
+            powers[(size_t) k] = re * re + im * im;
+            phases[(size_t) k] = std::atan2(im, re);
+            maxPower = juce::jmax(maxPower, powers[(size_t) k]);
+        }
+
+        // Peaks: larger than two neighbours either side and within 100 dB of
+        // the loudest bin
+        const float floor = maxPower * 1.0e-10f;
+        numPeaks = 0;
+        for (int k = 0; k < numBins; ++k) {
+            const float power = powers[(size_t) k];
+            if (power <= floor
+                || (k >= 1 && power <= powers[(size_t) (k - 1)])
+                || (k >= 2 && power <= powers[(size_t) (k - 2)])
+                || (k + 1 < numBins && power < powers[(size_t) (k + 1)])
+                || (k + 2 < numBins && power < powers[(size_t) (k + 2)]))
+                continue;
+
+            // Deviation of the measured phase advance from the bin centre's
+            const float deviation = wrapPhase(phases[(size_t) k] - lastPhases[(size_t) k]
+                                              - (float) k * PHASE_ADVANCE_PER_BIN);
+            peakBins[(size_t) numPeaks] = k;
+            peakFrequencies[(size_t) numPeaks] = (float) k + deviation / PHASE_ADVANCE_PER_BIN;
+            ++numPeaks;
+        }
+
+        // Each peak owns the bins up to the quietest one before the next peak
+        regionStarts[0] = 0;
+        for (int p = 1; p < numPeaks; ++p) {
+            int boundary = peakBins[(size_t) (p - 1)] + 1;
+            for (int k = boundary + 1; k < peakBins[(size_t) p]; ++k)
+                if (powers[(size_t) k] < powers[(size_t) boundary])
+                    boundary = k;
+            regionStarts[(size_t) p] = boundary;
+        }
+        regionStarts[(size_t) numPeaks] = numBins;
+
+        // A peak continues the phase of whichever peak owned its bin last frame
+        for (int p = 0; p < numPeaks; ++p)
+            std::fill(peakOwners.begin() + regionStarts[(size_t) p],
+                      peakOwners.begin() + regionStarts[(size_t) (p + 1)], peakBins[(size_t) p]);
+    }
+
+    // Per voice: move each peak region to the bin nearest the peak's shifted
+    // frequency and rotate it so the peak continues this voice's phase
+    void synthesiseVoice(float* bins, float ratio, float gain, Voice& voice) noexcept {
+        // Unison is the analysis spectrum itself, so it stays sample-aligned
+        // with the input; the next shifted frame picks up from its phases
+        if (std::abs(ratio - 1.0f) < 1.0e-4f) {
+            for (int i = 0; i < numBins * 2; ++i)
+                bins[i] += spectrum[(size_t) i] * gain;
+
+            voice.running = false;
+            return;
+        }
+
+        std::swap(voice.phases, voice.lastPhases);
+
+        for (int p = 0; p < numPeaks; ++p) {
+            const int source = peakBins[(size_t) p];
+            const float frequency = peakFrequencies[(size_t) p] * ratio;
+            if (frequency >= (float) (numBins - 1))
+                break;
+
+            // Whole-bin move that puts the lobe's centre nearest its new frequency
+            const int shift = (int) std::floor(frequency - peakFrequencies[(size_t) p] + 0.5f);
+
+            const float phase = voice.running
+                                    ? wrapPhase(voice.lastPhases[(size_t) lastPeakOwners[(size_t) source]]
+                                                + frequency * PHASE_ADVANCE_PER_BIN)
+                                    : phases[(size_t) source];
+            voice.phases[(size_t) source] = phase;
+
+            const float rotation = phase - phases[(size_t) source];
+            const float rotRe = gain * std::cos(rotation);
+            const float rotIm = gain * std::sin(rotation);
+
+            const int first = juce::jmax(regionStarts[(size_t) p], -shift);
+            const int last = juce::jmin(regionStarts[(size_t) (p + 1)], numBins - shift);
+
+            for (int k = first; k < last; ++k) {
+                const float re = spectrum[(size_t) (k * 2)];
+                const float im = spectrum[(size_t) (k * 2 + 1)];
+                bins[(k + shift) * 2] += re * rotRe - im * rotIm;
+                bins[(k + shift) * 2 + 1] += re * rotIm + im * rotRe;
+            }
+        }
+
+        voice.running = true;
+    }
+
+    StftProcessor stft;
+    int numBins = 0, numPeaks = 0;
+
+    // Shared analysis of the current frame
+    std::vector<float> spectrum, powers, phases, lastPhases, peakFrequencies;
+    std::vector<int> peakBins, regionStarts, peakOwners, lastPeakOwners;
+
+    std::array<Voice, MAX_VOICES> voices;
+};
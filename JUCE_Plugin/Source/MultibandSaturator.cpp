@@ -60,6 +60,82 @@ namespace {
         return x / (1.0f + 0.5f * x2);
     }
     
+    // tubeSat and tapeSat as ADAA curves of the driven input u = x * drive,
+    // with closed-form antiderivatives. The tube curve jumps from 2/3 to 1/2
+    // at |u| = 1; ADAA averages across the jump instead of aliasing it.
+    struct TubeCurve {
+        static constexpr double kCubic = 0.3333;
+        
+        double shape(double u) const noexcept {
+            const double a = std::abs(u);
+            return a < 1.0 ? u * (1.0 - kCubic * a * a) : u / (a + 1.0);
+        }
+        
+        double antiderivative1(double u) const noexcept {
+            const double a = std::abs(u);
+            if (a < 1.0) return a * a * (0.5 - 0.25 * kCubic * a * a);
+            return (0.5 - 0.25 * kCubic) + (a - std::log1p(a)) - (1.0 - std::log(2.0));
+        }
+        
+        double antiderivative2(double u) const noexcept {
+            const double a = std::abs(u);
+            double F;
+            if (a < 1.0) {
+                F = a * a * a * (1.0 / 6.0 - kCubic * a * a / 20.0);
+            } else {
+                // Integral from 1 of the outer F1, t - ln(1 + t) - (1 - ln 2)
+                const auto outer = [](double t) {
+                    return 0.5 * t * t - (1.0 + t) * std::log1p(t) + (1.0 + t) - t * (1.0 - std::log(2.0));
+                };
+                F = (1.0 / 6.0 - kCubic / 20.0) + (0.5 - 0.25 * kCubic) * (a - 1.0) + outer(a) - outer(1.0);
+            }
+            return u < 0.0 ? -F : F;
+        }
+    };
+    
+    struct TapeCurve {
+        double shape(double u) const noexcept { return u / (1.0 + 0.5 * u * u); }
+        double antiderivative1(double u) const noexcept { return std::log1p(0.5 * u * u); }
+        double antiderivative2(double u) const noexcept {
+            constexpr double root2 = 1.4142135623730951;
+            return u * std::log1p(0.5 * u * u) - 2.0 * u + 2.0 * root2 * std::atan(u / root2);
+        }
+    };
+    
+    // One band's saturator in each curve family; only the selected one runs
+    struct BandShapers {
+        AntiderivativeShaper<TubeCurve> tube;
+        AntiderivativeShaper<TapeCurve> tape;
+        AntiderivativeShaper<> clip;  // tanh, for Transistor and Diode
+        
+        void prepare(const TubeCurve& tubeCurve, const TapeCurve& tapeCurve) {
+            tube.setCurve(tubeCurve);
+            tape.setCurve(tapeCurve);
+            clip.setCurve(AdaaCurves::tanh());
+        }
+        
+        void setOrder(int order) noexcept {
+            tube.setOrder(order);
+            tape.setOrder(order);
+            clip.setOrder(order);
+        }
+        
+        void reset() noexcept {
+            tube.reset();
+            tape.reset();
+            clip.reset();
+        }
+        
+        float process(int satTypeIdx, float x, float drive) noexcept {
+            const double u = (double) x * drive;
+            switch (satTypeIdx) {
+                case 0:  return (float) tube.process(u);
+                case 1:  return (float) tape.process(u);
+                default: return (float) (clip.process(u) / drive);
+            }
+        }
+    };
+    
     // Simple Butterworth filter
     class ButterworthFilter {
     public:
@@ -229,6 +305,22 @@ struct MultibandSaturator::Impl {
     ParamSmoother outputGain;
     ParamSmoother mix;
     
+    // Anti-aliasing: per channel, low/mid/high band shapers
+    TubeCurve tubeCurve;
+    TapeCurve tapeCurve;
+    std::array<std::array<BandShapers, 3>, kMaxChannels> shapers;
+    EngineBase::Quality quality = EngineBase::Quality::Ultra;
+    AntialiasingMode antialiasingMode = AntialiasingMode::Antiderivative;
+    int adaaOrder = 1;
+    int lastSatType = -1;  // shaper history is dropped when the type changes
+    
+    void applyAntialiasingPlan() {
+        adaaOrder = antialiasingForQuality(quality, antialiasingMode, 1).adaaOrder;
+        for (auto& channel : shapers)
+            for (auto& band : channel)
+                band.setOrder(adaaOrder);
+    }
+    
     void prepare(double sr, int bs) {
         sampleRate = static_cast<float>(std::max(8000.0, sr));
         blockSize = std::max(1, bs);
@@ -250,6 +342,11 @@ struct MultibandSaturator::Impl {
         outputGain.setTimeMs(smoothMs, sampleRate);
         mix.setTimeMs(smoothMs, sampleRate);
         
+        for (auto& channel : shapers)
+            for (auto& band : channel)
+                band.prepare(tubeCurve, tapeCurve);
+        applyAntialiasingPlan();
+        
         reset();
     }
     
@@ -258,7 +355,10 @@ struct MultibandSaturator::Impl {
             crossovers[i].reset();
             inputDCBlockers[i].reset();
             outputDCBlockers[i].reset();
+            for (auto& band : shapers[i])
+                band.reset();
         }
+        lastSatType = -1;
         
         // Default values
         lowDrive.snap(1.0f);
@@ -289,6 +389,12 @@ struct MultibandSaturator::Impl {
             
             // Determine saturation type (0-1 mapped to 4 types)
             const int satTypeIdx = clamp(static_cast<int>(type * 3.99f), 0, 3);
+            if (satTypeIdx != lastSatType) {
+                for (auto& channel : shapers)
+                    for (auto& band : channel)
+                        band.reset();
+                lastSatType = satTypeIdx;
+            }
             
             for (int ch = 0; ch < numChannels; ++ch) {
                 float* channelData = buffer.getWritePointer(ch);
@@ -303,30 +409,40 @@ struct MultibandSaturator::Impl {
                 // Saturate each band
                 float lowOut = 0.0f, midOut = 0.0f, highOut = 0.0f;
                 
-                switch (satTypeIdx) {
-                    case 0: // Tube
-                        lowOut = tubeSat(bands.low, 1.0f + lowDr * 3.0f);
-                        midOut = tubeSat(bands.mid, 1.0f + midDr * 3.0f);
-                        highOut = tubeSat(bands.high, 1.0f + highDr * 3.0f); // Equal drive for all bands
-                        break;
+                if (adaaOrder > 0) {
+                    // Drive ranges of the plain curves below, per type
+                    static constexpr float kDriveRange[4] = { 3.0f, 4.0f, kMaxDrive * 1.5f, kMaxDrive * 2.0f };
+                    const float range = kDriveRange[satTypeIdx];
+                    auto& band = shapers[ch];
+                    lowOut = band[0].process(satTypeIdx, bands.low, 1.0f + lowDr * range);
+                    midOut = band[1].process(satTypeIdx, bands.mid, 1.0f + midDr * range);
+                    highOut = band[2].process(satTypeIdx, bands.high, 1.0f + highDr * range);
+                } else {
+                    switch (satTypeIdx) {
+                        case 0: // Tube
+                            lowOut = tubeSat(bands.low, 1.0f + lowDr * 3.0f);
+                            midOut = tubeSat(bands.mid, 1.0f + midDr * 3.0f);
+                            highOut = tubeSat(bands.high, 1.0f + highDr * 3.0f); // Equal drive for all bands
+                            break;
                         
-                    case 1: // Tape
-                        lowOut = tapeSat(bands.low, 1.0f + lowDr * 4.0f);
-                        midOut = tapeSat(bands.mid, 1.0f + midDr * 4.0f);
-                        highOut = tapeSat(bands.high, 1.0f + highDr * 4.0f); // Equal drive for all bands
-                        break;
+                        case 1: // Tape
+                            lowOut = tapeSat(bands.low, 1.0f + lowDr * 4.0f);
+                            midOut = tapeSat(bands.mid, 1.0f + midDr * 4.0f);
+                            highOut = tapeSat(bands.high, 1.0f + highDr * 4.0f); // Equal drive for all bands
+                            break;
                         
-                    case 2: // Transistor
-                        lowOut = softClip(bands.low, 1.0f + lowDr * kMaxDrive * 1.5f);
-                        midOut = softClip(bands.mid, 1.0f + midDr * kMaxDrive * 1.5f);
-                        highOut = softClip(bands.high, 1.0f + highDr * kMaxDrive * 1.5f);
-                        break;
+                        case 2: // Transistor
+                            lowOut = softClip(bands.low, 1.0f + lowDr * kMaxDrive * 1.5f);
+                            midOut = softClip(bands.mid, 1.0f + midDr * kMaxDrive * 1.5f);
+                            highOut = softClip(bands.high, 1.0f + highDr * kMaxDrive * 1.5f);
+                            break;
                         
-                    case 3: // Diode
-                        lowOut = softClip(bands.low, 1.0f + lowDr * kMaxDrive * 2.0f);
-                        midOut = softClip(bands.mid, 1.0f + midDr * kMaxDrive * 2.0f);
-                        highOut = softClip(bands.high, 1.0f + highDr * kMaxDrive * 2.0f);
-                        break;
+                        case 3: // Diode
+                            lowOut = softClip(bands.low, 1.0f + lowDr * kMaxDrive * 2.0f);
+                            midOut = softClip(bands.mid, 1.0f + midDr * kMaxDrive * 2.0f);
+                            highOut = softClip(bands.high, 1.0f + highDr * kMaxDrive * 2.0f);
+                            break;
+                    }
                 }
                 
                 // Add harmonics (simple even/odd mix)
@@ -385,6 +501,16 @@ void MultibandSaturator::process(juce::AudioBuffer<float>& buffer) {
     pImpl->processBlock(buffer);
 }
 
+void MultibandSaturator::setQuality(Quality q) {
+    pImpl->quality = q;
+    pImpl->applyAntialiasingPlan();
+}
+
+void MultibandSaturator::setAntialiasingMode(AntialiasingMode mode) {
+    pImpl->antialiasingMode = mode;
+    pImpl->applyAntialiasingPlan();
+}
+
 void MultibandSaturator::updateParameters(const std::map<int, float>& params) {
     auto get = [&](int id, float defaultVal) {
         auto it = params.find(id);
@@ -1,5 +1,6 @@
 #pragma once
 #include "EngineBase.h"
+#include "AntiderivativeShaper.h"
 #include <array>
 #include <memory>
 
@@ -12,6 +13,12 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override;
+    
+    // Antiderivative (default): 1st-order ADAA on each band's saturator.
+    // Oversampling: the plain curves, as before ADAA (this engine never
+    // oversampled).
+    void setAntialiasingMode(AntialiasingMode mode);
     
     juce::String getName() const override { return "Multiband Saturator Ultimate"; }
     int getNumParameters() const override { return 7; }
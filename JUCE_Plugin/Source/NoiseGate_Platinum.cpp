@@ -1,4 +1,5 @@
 #include "NoiseGate_Platinum.h"
+#include "SlidingWindowPeak.h"
 #include <JuceHeader.h>
 #include <cmath>
 #include <algorithm>
@@ -621,6 +622,10 @@ struct NoiseGate_Platinum::Impl {
         float closeThreshold = 0.05f;
 #endif
         
+        // Detection held over the lookahead window, so the gate opens ahead
+        // of the delayed audio and stays open until it has passed
+        SlidingWindowPeak lookaheadPeak;
+        
         // Hold logic
         int holdCounter = 0;
         int holdSamples = 0;
@@ -631,6 +636,7 @@ struct NoiseGate_Platinum::Impl {
             envelope.reset();
             sidechain.reset();
             lookahead.reset();
+            lookaheadPeak.reset();
 #if HAS_SSE2
             gainVec = targetVec = _mm_setzero_ps();
             gain = target = 0.0f;
@@ -739,6 +745,7 @@ void NoiseGate_Platinum::Impl::processSIMD(float* left, float* right, int numSam
     channels[1].openThreshold = channels[0].openThreshold;
     channels[1].closeThreshold = channels[0].closeThreshold;
     channels[1].holdSamples = channels[0].holdSamples;
+    channels[0].lookaheadPeak.setWindowLength(lookaheadSamples + 1);
     
     // Flush any denormals from previous block
     channels[0].gainVec = flushDenormalsSIMD(channels[0].gainVec);
@@ -779,6 +786,11 @@ void NoiseGate_Platinum::Impl::processSIMD(float* left, float* right, int numSam
         
         // Envelope detection
         _mm_store_ps(detectionArray, detection);
+        if (lookaheadSamples > 0) {
+            for (auto& d : detectionArray) {
+                d = channels[0].lookaheadPeak.process(d);
+            }
+        }
         __m128 env = channels[0].envelope.process4(detectionArray);
         
         // Calculate target gain using smoothstep
@@ -899,6 +911,7 @@ void NoiseGate_Platinum::Impl::processScalar(float* left, float* right, int numS
     channels[1].holdSamples = holdSamples;
     channels[1].attackRate = channels[0].attackRate;
     channels[1].releaseRate = channels[0].releaseRate;
+    channels[0].lookaheadPeak.setWindowLength(lookaheadSamples + 1);
     
     for (int i = 0; i < numSamples; ++i) {
         // DC blocking
@@ -911,6 +924,9 @@ void NoiseGate_Platinum::Impl::processScalar(float* left, float* right, int numS
         // Sidechain filter
         float scFiltered = channels[0].sidechain.processHighpass(detection);
         detection = scFiltered * scMix + detection * (1.0f - scMix);
+        if (lookaheadSamples > 0) {
+            detection = channels[0].lookaheadPeak.process(detection);
+        }
         
         // Envelope
         float env = channels[0].envelope.process(detection);
@@ -1022,6 +1038,7 @@ void NoiseGate_Platinum::prepareToPlay(double sampleRate, int samplesPerBlock) {
         ch.envelope.setAttackRelease(10.0f, 50.0f, sampleRate);
         ch.sidechain.setCutoff(100.0f, sampleRate);
         ch.lookahead.prepare(maxLookahead);
+        ch.lookaheadPeak.prepare(maxLookahead + 1);
     }
     
     pimpl->lastTime = std::chrono::high_resolution_clock::now();
@@ -2,42 +2,336 @@
 #include <algorithm>
 #include <cmath>
 
+#if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    #include <xmmintrin.h>
+#endif
+
+//==============================================================================
+// OptimizedConvolutionSegment Implementation
+//==============================================================================
+
+OptimizedConvolutionSegment::OptimizedConvolutionSegment(size_t partitionSize, size_t maxPartitions)
+    : m_partitionSize(partitionSize)
+    , m_maxPartitions(std::max<size_t>(1, maxPartitions)) {
+
+    // Overlap-save: FFT of the previous and current frame
+    m_fftSize = partitionSize * 2;
+    m_numBins = (m_fftSize / 2 + 1 + 3) & ~size_t(3);
+
+    int fftOrder = 0;
+    while ((size_t(1) << fftOrder) < m_fftSize) {
+        fftOrder++;
+    }
+    m_fft = std::make_unique<RealFFT>(fftOrder);
+
+    m_fftWorkspace.resize(m_fftSize + 2);
+    m_inputWindow.resize(m_fftSize);
+
+    m_historyRe.resize(m_maxPartitions * m_numBins);
+    m_historyIm.resize(m_maxPartitions * m_numBins);
+    m_historyHorizon.prepare(m_maxPartitions);
+    m_accumulatorRe.resize(m_numBins);
+    m_accumulatorIm.resize(m_numBins);
+
+    reset();
+}
+
+void OptimizedConvolutionSegment::reset() {
+    std::fill(m_inputWindow.begin(), m_inputWindow.end(), 0.0f);
+    m_historyHorizon.reset();
+    m_historyWritePos = 0;
+}
+
+OptimizedConvolutionSegment::Spectra OptimizedConvolutionSegment::transformIR(
+    const float* ir, size_t irLength, size_t offset, size_t numPartitions) {
+
+    const size_t realBins = m_fftSize / 2 + 1;
+
+    Spectra spectra;
+    spectra.numPartitions = numPartitions;
+    spectra.re.assign(numPartitions * m_numBins, 0.0f);
+    spectra.im.assign(numPartitions * m_numBins, 0.0f);
+
+    for (size_t p = 0; p < numPartitions; ++p) {
+        // Partition in the first half, zeros in the second
+        std::fill(m_fftWorkspace.begin(), m_fftWorkspace.end(), 0.0f);
+
+        const size_t start = offset + p * m_partitionSize;
+        if (start < irLength) {
+            const size_t count = std::min(m_partitionSize, irLength - start);
+            std::copy(ir + start, ir + start + count, m_fftWorkspace.begin());
+        }
+
+        m_fft->forward(m_fftWorkspace.data(), workspaceBins());
+
+        float* re = spectra.re.data() + p * m_numBins;
+        float* im = spectra.im.data() + p * m_numBins;
+        for (size_t k = 0; k < realBins; ++k) {
+            re[k] = m_fftWorkspace[k * 2];
+            im[k] = m_fftWorkspace[k * 2 + 1];
+        }
+    }
+
+    return spectra;
+}
+
+void OptimizedConvolutionSegment::pushInput(const float* input) {
+    const size_t realBins = m_fftSize / 2 + 1;
+
+    // Slide the new frame into the overlap-save window and transform it
+    std::copy(m_inputWindow.begin() + m_partitionSize, m_inputWindow.end(), m_inputWindow.begin());
+    std::copy(input, input + m_partitionSize, m_inputWindow.begin() + m_partitionSize);
+    std::copy(m_inputWindow.begin(), m_inputWindow.end(), m_fftWorkspace.begin());
+    m_fft->forward(m_fftWorkspace.data(), workspaceBins());
+
+    m_historyWritePos = (m_historyWritePos + 1) % m_maxPartitions;
+    float* historyRe = m_historyRe.data() + m_historyWritePos * m_numBins;
+    float* historyIm = m_historyIm.data() + m_historyWritePos * m_numBins;
+    for (size_t k = 0; k < realBins; ++k) {
+        historyRe[k] = m_fftWorkspace[k * 2];
+        historyIm[k] = m_fftWorkspace[k * 2 + 1];
+    }
+    m_historyHorizon.advance();
+}
+
+void OptimizedConvolutionSegment::convolve(const Spectra& ir, float* output) {
+    const size_t realBins = m_fftSize / 2 + 1;
+    // Spectra pushed before the last reset() count as silence
+    const size_t numPartitions = std::min({ ir.numPartitions, m_maxPartitions, m_historyHorizon.getNumWritten() });
+
+    if (numPartitions == 0) {
+        std::fill(output, output + m_partitionSize, 0.0f);
+        return;
+    }
+
+    // Partition p pairs with the input spectrum from p frames ago
+    std::fill(m_accumulatorRe.begin(), m_accumulatorRe.end(), 0.0f);
+    std::fill(m_accumulatorIm.begin(), m_accumulatorIm.end(), 0.0f);
+
+    size_t slot = m_historyWritePos;
+    for (size_t p = 0; p < numPartitions; ++p) {
+        complexMultiplyAccumulate(m_accumulatorRe.data(), m_accumulatorIm.data(),
+                                  m_historyRe.data() + slot * m_numBins, m_historyIm.data() + slot * m_numBins,
+                                  ir.re.data() + p * m_numBins, ir.im.data() + p * m_numBins,
+                                  m_numBins);
+        slot = (slot == 0 ? m_maxPartitions : slot) - 1;
+    }
+
+    for (size_t k = 0; k < realBins; ++k) {
+        m_fftWorkspace[k * 2] = m_accumulatorRe[k];
+        m_fftWorkspace[k * 2 + 1] = m_accumulatorIm[k];
+    }
+    m_fft->inverse(workspaceBins(), m_fftWorkspace.data());
+
+    // The second half is free of circular wrap-around
+    std::copy(m_fftWorkspace.begin() + m_partitionSize, m_fftWorkspace.begin() + m_fftSize, output);
+}
+
+void OptimizedConvolutionSegment::complexMultiplyAccumulate(
+    float* resultRe, float* resultIm,
+    const float* aRe, const float* aIm,
+    const float* bRe, const float* bIm,
+    size_t count) noexcept {
+
+   #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    for (size_t i = 0; i < count; i += 4) {
+        const __m128 ar = _mm_loadu_ps(aRe + i), ai = _mm_loadu_ps(aIm + i);
+        const __m128 br = _mm_loadu_ps(bRe + i), bi = _mm_loadu_ps(bIm + i);
+        const __m128 re = _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi));
+        const __m128 im = _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br));
+        _mm_storeu_ps(resultRe + i, _mm_add_ps(_mm_loadu_ps(resultRe + i), re));
+        _mm_storeu_ps(resultIm + i, _mm_add_ps(_mm_loadu_ps(resultIm + i), im));
+    }
+   #else
+    for (size_t i = 0; i < count; ++i) {
+        resultRe[i] += aRe[i] * bRe[i] - aIm[i] * bIm[i];
+        resultIm[i] += aRe[i] * bIm[i] + aIm[i] * bRe[i];
+    }
+   #endif
+}
+
+//==============================================================================
+// PartitionedImpulseResponse Implementation
+//==============================================================================
+
+const PartitionedImpulseResponse::Spectra PartitionedImpulseResponse::s_empty;
+
+namespace {
+    constexpr size_t kLevelsPerChannel = 1 + NonUniformPartitionedConvolution::TAIL_PARTITION_SIZES.size();
+}
+
+PartitionedImpulseResponse::PartitionedImpulseResponse(const juce::AudioBuffer<float>& ir, int numChannels)
+    : m_numChannels(juce::jlimit(1, NonUniformPartitionedConvolution::MAX_CHANNELS, numChannels))
+    , m_length(ir.getNumChannels() > 0 ? (size_t) ir.getNumSamples() : 0) {
+
+    using Layout = NonUniformPartitionedConvolution;
+    m_spectra.resize((size_t) m_numChannels * kLevelsPerChannel);
+    if (m_length == 0) return;
+
+    // One segment per partition size does the transforms for every channel
+    OptimizedConvolutionSegment head(Layout::HEAD_PARTITION_SIZE, 1);
+    std::vector<std::unique_ptr<OptimizedConvolutionSegment>> tail;
+    for (size_t level = 0; level < Layout::getNumTailLevels(m_length); ++level) {
+        tail.push_back(std::make_unique<OptimizedConvolutionSegment>(Layout::TAIL_PARTITION_SIZES[level], 1));
+    }
+
+    for (int ch = 0; ch < m_numChannels; ++ch) {
+        const float* data = ir.getReadPointer(std::min(ch, ir.getNumChannels() - 1));
+        Spectra* spectra = m_spectra.data() + (size_t) ch * kLevelsPerChannel;
+
+        spectra[0] = head.transformIR(data, m_length, 0, Layout::getNumHeadPartitions(m_length));
+        for (size_t level = 0; level < tail.size(); ++level) {
+            spectra[level + 1] = tail[level]->transformIR(data, m_length, Layout::TAIL_PARTITION_SIZES[level] * 2,
+                                                          Layout::getNumTailPartitions(level, m_length));
+        }
+    }
+}
+
+const PartitionedImpulseResponse::Spectra& PartitionedImpulseResponse::getHead(int channel) const {
+    return m_spectra[(size_t) std::min(channel, m_numChannels - 1) * kLevelsPerChannel];
+}
+
+const PartitionedImpulseResponse::Spectra& PartitionedImpulseResponse::getTail(int channel, size_t level) const {
+    if (level + 1 >= kLevelsPerChannel) return s_empty;
+    return m_spectra[(size_t) std::min(channel, m_numChannels - 1) * kLevelsPerChannel + level + 1];
+}
+
 //==============================================================================
 // NonUniformPartitionedConvolution Implementation
 //==============================================================================
 
-NonUniformPartitionedConvolution::NonUniformPartitionedConvolution() {
-    // Reserve space for segments
-    m_segments.reserve(8);
+NonUniformPartitionedConvolution::NonUniformPartitionedConvolution() = default;
+
+NonUniformPartitionedConvolution::~NonUniformPartitionedConvolution() {
+    if (m_worker) {
+        m_worker->signalThreadShouldExit();
+        m_worker->wake.signal();
+        m_worker->stopThread(2000);
+    }
+}
+
+size_t NonUniformPartitionedConvolution::getNumHeadPartitions(size_t irLength) {
+    // Head up to where the first background level starts
+    const size_t headEnd = std::min(irLength, TAIL_PARTITION_SIZES[0] * 2);
+    return (headEnd + HEAD_PARTITION_SIZE - 1) / HEAD_PARTITION_SIZE;
+}
+
+size_t NonUniformPartitionedConvolution::getNumTailLevels(size_t irLength) {
+    size_t numLevels = 0;
+    for (size_t level = 0; level < TAIL_PARTITION_SIZES.size(); ++level) {
+        if (irLength > TAIL_PARTITION_SIZES[level] * 2) numLevels = level + 1;
+    }
+    return numLevels;
 }
 
-NonUniformPartitionedConvolution::~NonUniformPartitionedConvolution() = default;
+size_t NonUniformPartitionedConvolution::getNumTailPartitions(size_t level, size_t irLength) {
+    // Each background level up to where the next one starts, the last to the
+    // end of the IR
+    const size_t numLevels = getNumTailLevels(irLength);
+    if (level >= numLevels) return 0;
+
+    const size_t size = TAIL_PARTITION_SIZES[level];
+    const size_t start = size * 2;
+    const size_t end = level + 1 < numLevels ? TAIL_PARTITION_SIZES[level + 1] * 2 : irLength;
+    return (end - start + size - 1) / size;
+}
+
+void NonUniformPartitionedConvolution::prepare(double sampleRate, int maxBlockSize, int numChannels, size_t maxIRLength) {
+    finishTailJobs();
 
-void NonUniformPartitionedConvolution::prepare(double sampleRate, int maxBlockSize) {
     m_sampleRate = sampleRate;
     m_maxBlockSize = maxBlockSize;
-    
-    // Allocate buffers
-    m_inputBuffer.resize(maxBlockSize * 2);
-    m_outputBuffer.resize(maxBlockSize * 2);
-    m_accumulator.resize(maxBlockSize);
-    
-    std::fill(m_inputBuffer.begin(), m_inputBuffer.end(), 0.0f);
-    std::fill(m_outputBuffer.begin(), m_outputBuffer.end(), 0.0f);
-    
+    m_numChannels = juce::jlimit(1, MAX_CHANNELS, numChannels);
+
+    for (auto& channel : m_channels) {
+        channel.inputFifo.assign(HEAD_PARTITION_SIZE, 0.0f);
+        channel.outputFifo.assign(HEAD_PARTITION_SIZE, 0.0f);
+        channel.scratch.assign(HEAD_PARTITION_SIZE, 0.0f);
+    }
+
+    m_ir.reset();
+    m_previousIR.reset();
+    m_queuedIR.reset();
+    m_isCrossfading = false;
+    m_isReady = false;
+
+    if (!m_worker) {
+        m_worker = std::make_unique<TailWorker>(*this);
+        const auto options = juce::Thread::RealtimeOptions{}
+                                 .withApproximateAudioProcessingTime(juce::jmax(1, maxBlockSize), sampleRate);
+        if (!m_worker->startRealtimeThread(options))
+            m_worker->startThread(juce::Thread::Priority::highest);  // e.g. no realtime permission
+    }
+
+    allocateSegments(maxIRLength);
     reset();
 }
 
+void NonUniformPartitionedConvolution::allocateSegments(size_t capacity) {
+    finishTailJobs();
+    const juce::SpinLock::ScopedLockType lock(m_jobTableLock);
+
+    m_capacity = capacity;
+    m_numTailLevels = getNumTailLevels(capacity);
+
+    size_t largestPartition = HEAD_PARTITION_SIZE;
+    for (int ch = 0; ch < m_numChannels; ++ch) {
+        auto& channel = m_channels[(size_t) ch];
+        channel.head = std::make_unique<OptimizedConvolutionSegment>(HEAD_PARTITION_SIZE, getNumHeadPartitions(capacity));
+
+        channel.tail.clear();
+        for (size_t level = 0; level < m_numTailLevels; ++level) {
+            const size_t size = TAIL_PARTITION_SIZES[level];
+            channel.tail.push_back(std::make_unique<OptimizedConvolutionSegment>(size, getNumTailPartitions(level, capacity)));
+            largestPartition = std::max(largestPartition, size);
+        }
+    }
+
+    // Input history holds the largest background frame
+    size_t historySize = 1;
+    while (historySize < largestPartition) historySize <<= 1;
+    m_historyMask = (int64_t) historySize - 1;
+    for (auto& channel : m_channels) {
+        channel.history.assign(historySize, 0.0f);
+    }
+
+    m_numJobs = m_numTailLevels * (size_t) m_numChannels * 2;
+    m_jobs = m_numJobs > 0 ? std::make_unique<TailJob[]>(m_numJobs) : nullptr;
+    for (size_t level = 0; level < m_numTailLevels; ++level) {
+        for (int ch = 0; ch < m_numChannels; ++ch) {
+            for (int64_t frame = 0; frame < 2; ++frame) {
+                auto& job = jobFor(level, ch, frame);
+                job.segment = m_channels[(size_t) ch].tail[level].get();
+                job.input.assign(TAIL_PARTITION_SIZES[level], 0.0f);
+                job.output.assign(TAIL_PARTITION_SIZES[level], 0.0f);
+                job.scratch.assign(TAIL_PARTITION_SIZES[level], 0.0f);
+            }
+        }
+    }
+}
+
 void NonUniformPartitionedConvolution::reset() {
-    for (auto& segment : m_segments) {
-        segment->reset();
+    finishTailJobs();
+
+    for (int ch = 0; ch < MAX_CHANNELS; ++ch) {
+        auto& channel = m_channels[(size_t) ch];
+        if (channel.head) channel.head->reset();
+        for (auto& segment : channel.tail) segment->reset();
+        std::fill(channel.inputFifo.begin(), channel.inputFifo.end(), 0.0f);
+        std::fill(channel.outputFifo.begin(), channel.outputFifo.end(), 0.0f);
+        // history needs no clearing: a tail frame only reads the samples
+        // written since the previous frame boundary, all of them after this
     }
-    
-    std::fill(m_inputBuffer.begin(), m_inputBuffer.end(), 0.0f);
-    std::fill(m_outputBuffer.begin(), m_outputBuffer.end(), 0.0f);
-    std::fill(m_accumulator.begin(), m_accumulator.end(), 0.0f);
-    
-    m_bufferIndex = 0;
+
+    // With no input history left there's nothing to crossfade
+    if (m_queuedIR) m_ir = std::move(m_queuedIR);
+    m_previousIR.reset();
+    m_isCrossfading = false;
+
+    m_fifoPos = 0;
+    m_samplesProcessed = 0;
+    m_jobsIssued.store(0, std::memory_order_relaxed);
+    m_missedDeadlines.store(0, std::memory_order_relaxed);
 }
 
 void NonUniformPartitionedConvolution::loadImpulseResponse(const float* ir, size_t irLength, bool normalize) {
@@ -45,97 +339,70 @@ void NonUniformPartitionedConvolution::loadImpulseResponse(const float* ir, size
         m_isReady = false;
         return;
     }
-    
+
     // Create a copy for normalization
     std::vector<float> irCopy(ir, ir + irLength);
-    
+
     if (normalize) {
         normalizeImpulseResponse(irCopy);
     }
-    
-    // Create partition scheme
-    createPartitionScheme(irLength);
-    
-    // Compute FFTs for all partitions
-    computePartitionFFTs(irCopy.data(), irLength);
-    
-    m_isReady = true;
-}
-
-void NonUniformPartitionedConvolution::createPartitionScheme(size_t irLength) {
-    m_segments.clear();
-    
-    // Non-uniform partition scheme:
-    // - First 512 samples: 64-sample partitions (8 partitions) - Ultra low latency
-    // - Next 2048 samples: 256-sample partitions (8 partitions) - Low latency
-    // - Next 8192 samples: 1024-sample partitions (8 partitions) - Medium latency
-    // - Next 32768 samples: 4096-sample partitions (8 partitions) - High efficiency
-    // - Remainder: 8192-sample partitions - Maximum efficiency
-    
-    struct PartitionPlan {
-        size_t partitionSize;
-        size_t coverageSamples;
-        size_t maxPartitions;
-    };
-    
-    std::vector<PartitionPlan> plans = {
-        {64,    512,    8},   // 8 * 64 = 512 samples
-        {256,   2048,   8},   // 8 * 256 = 2048 samples  
-        {1024,  8192,   8},   // 8 * 1024 = 8192 samples
-        {4096,  32768,  8},   // 8 * 4096 = 32768 samples
-        {8192,  SIZE_MAX, 16} // Remainder with 8192-sample partitions
-    };
-    
-    size_t currentOffset = 0;
-    
-    for (const auto& plan : plans) {
-        if (currentOffset >= irLength) break;
-        
-        size_t remainingSamples = irLength - currentOffset;
-        size_t samplesForThisSegment = std::min(plan.coverageSamples, remainingSamples);
-        size_t numPartitions = (samplesForThisSegment + plan.partitionSize - 1) / plan.partitionSize;
-        numPartitions = std::min(numPartitions, plan.maxPartitions);
-        
-        if (numPartitions > 0) {
-            auto segment = std::make_unique<ConvolutionSegment>();
-            segment->prepare(plan.partitionSize, static_cast<int>(numPartitions));
-            m_segments.push_back(std::move(segment));
-            
-            currentOffset += numPartitions * plan.partitionSize;
-        }
+
+    float* channelData = irCopy.data();
+    loadImpulseResponse(juce::AudioBuffer<float>(&channelData, 1, (int) irLength));
+}
+
+void NonUniformPartitionedConvolution::loadImpulseResponse(const juce::AudioBuffer<float>& ir) {
+    loadImpulseResponse(std::make_shared<const PartitionedImpulseResponse>(ir, m_numChannels));
+}
+
+void NonUniformPartitionedConvolution::loadImpulseResponse(IRPtr ir) {
+    if (ir == nullptr || ir->getLength() == 0) {
+        m_isReady = false;
+        return;
+    }
+
+    finishTailJobs();
+    if (ir->getLength() > m_capacity) {
+        allocateSegments(ir->getLength());
     }
+
+    m_ir = std::move(ir);
+    m_previousIR.reset();
+    m_queuedIR.reset();
+    m_isReady = m_channels[0].head != nullptr;
+
+    // Restart the timeline with the new IR
+    reset();
 }
 
-void NonUniformPartitionedConvolution::computePartitionFFTs(const float* ir, size_t irLength) {
-    size_t offset = 0;
-    
-    for (auto& segment : m_segments) {
-        size_t partitionSize = segment->partitionSize;
-        size_t fftSize = segment->fftSize;
-        
-        // Prepare FFT buffer
-        std::vector<float> fftBuffer(fftSize, 0.0f);
-        
-        for (int p = 0; p < segment->numPartitions; ++p) {
-            // Copy IR segment
-            size_t copySize = std::min(partitionSize, irLength - offset);
-            if (copySize == 0) break;
-            
-            std::copy(ir + offset, ir + offset + copySize, fftBuffer.begin());
-            std::fill(fftBuffer.begin() + copySize, fftBuffer.end(), 0.0f);
-            
-            // Compute FFT
-            std::vector<std::complex<float>> fftData(fftSize);
-            for (size_t i = 0; i < fftSize; ++i) {
-                fftData[i] = std::complex<float>(fftBuffer[i], 0.0f);
-            }
-            
-            segment->fft->performFrequencyOnlyForwardTransform(reinterpret_cast<float*>(fftData.data()));
-            segment->partitionFFTs[p] = fftData;
-            
-            offset += partitionSize;
-            if (offset >= irLength) break;
-        }
+void NonUniformPartitionedConvolution::setImpulseResponse(IRPtr ir) {
+    if (ir == nullptr) return;
+
+    if (!m_isReady) {
+        m_ir = std::move(ir);
+        m_isReady = m_channels[0].head != nullptr;
+    } else if (m_isCrossfading) {
+        m_queuedIR = std::move(ir);
+    } else {
+        beginCrossfade(std::move(ir));
+    }
+}
+
+void NonUniformPartitionedConvolution::beginCrossfade(IRPtr ir) {
+    m_previousIR = std::move(m_ir);
+    m_ir = std::move(ir);
+    m_isCrossfading = true;
+
+    // The head fades from the next frame. Each background level fades from
+    // the output of the first frame it issues after this, the earlier ones
+    // having been computed with the old IR alone.
+    const int64_t next = m_samplesProcessed;
+    m_headCrossfadeStart = next;
+    m_crossfadeEnd = next + CROSSFADE_LENGTH;
+    for (size_t level = 0; level < m_numTailLevels; ++level) {
+        const int64_t size = (int64_t) TAIL_PARTITION_SIZES[level];
+        m_tailCrossfadeStart[level] = (next / size + 2) * size;
+        m_crossfadeEnd = std::max(m_crossfadeEnd, m_tailCrossfadeStart[level] + CROSSFADE_LENGTH);
     }
 }
 
@@ -144,250 +411,244 @@ void NonUniformPartitionedConvolution::process(const float* input, float* output
         std::copy(input, input + numSamples, output);
         return;
     }
-    
-    // Clear accumulator
-    std::fill(m_accumulator.begin(), m_accumulator.begin() + numSamples, 0.0f);
-    
-    // Process each segment
-    for (auto& segment : m_segments) {
-        segment->processPartition(input, m_accumulator.data(), numSamples);
+
+    int done = 0;
+    while (done < numSamples) {
+        const int chunk = std::min(numSamples - done, HEAD_PARTITION_SIZE - m_fifoPos);
+        auto& channel = m_channels[0];
+        std::copy(input + done, input + done + chunk, channel.inputFifo.begin() + m_fifoPos);
+        std::copy(channel.outputFifo.begin() + m_fifoPos, channel.outputFifo.begin() + m_fifoPos + chunk, output + done);
+
+        m_fifoPos += chunk;
+        done += chunk;
+        if (m_fifoPos == HEAD_PARTITION_SIZE) {
+            processTick();
+            m_fifoPos = 0;
+        }
     }
-    
-    // Copy result to output
-    std::copy(m_accumulator.begin(), m_accumulator.begin() + numSamples, output);
 }
 
 void NonUniformPartitionedConvolution::processBlock(juce::AudioBuffer<float>& buffer) {
-    const int numChannels = buffer.getNumChannels();
+    if (!m_isReady) return;
+
+    const int numChannels = std::min(buffer.getNumChannels(), m_numChannels);
     const int numSamples = buffer.getNumSamples();
-    
-    for (int ch = 0; ch < numChannels; ++ch) {
-        process(buffer.getReadPointer(ch), buffer.getWritePointer(ch), numSamples);
-    }
-}
 
-size_t NonUniformPartitionedConvolution::nextPowerOfTwo(size_t n) const {
-    size_t power = 1;
-    while (power < n) {
-        power *= 2;
-    }
-    return power;
-}
+    int done = 0;
+    while (done < numSamples) {
+        const int chunk = std::min(numSamples - done, HEAD_PARTITION_SIZE - m_fifoPos);
+        for (int ch = 0; ch < m_numChannels; ++ch) {
+            auto& channel = m_channels[(size_t) ch];
+            float* data = buffer.getWritePointer(std::min(ch, numChannels - 1), done);
 
-void NonUniformPartitionedConvolution::normalizeImpulseResponse(std::vector<float>& ir) {
-    // Find peak
-    float peak = 0.0f;
-    for (float sample : ir) {
-        peak = std::max(peak, std::abs(sample));
-    }
-    
-    // Normalize to 0.5 peak
-    if (peak > 0.0f) {
-        float scale = 0.5f / peak;
-        for (float& sample : ir) {
-            sample *= scale;
+            // Input first: the buffer is processed in place
+            std::copy(data, data + chunk, channel.inputFifo.begin() + m_fifoPos);
+            if (ch < numChannels) {
+                std::copy(channel.outputFifo.begin() + m_fifoPos, channel.outputFifo.begin() + m_fifoPos + chunk, data);
+            }
+        }
+
+        m_fifoPos += chunk;
+        done += chunk;
+        if (m_fifoPos == HEAD_PARTITION_SIZE) {
+            processTick();
+            m_fifoPos = 0;
         }
     }
 }
 
-//==============================================================================
-// ConvolutionSegment Implementation
-//==============================================================================
+void NonUniformPartitionedConvolution::processTick() {
+    m_samplesProcessed += HEAD_PARTITION_SIZE;
+    const int64_t now = m_samplesProcessed;
+    const int64_t frameStart = now - HEAD_PARTITION_SIZE;
 
-void NonUniformPartitionedConvolution::ConvolutionSegment::prepare(size_t partSize, int numParts) {
-    partitionSize = partSize;
-    numPartitions = numParts;
-    fftSize = partSize * 2; // For overlap-save method
-    
-    // Create FFT processor
-    int fftOrder = 0;
-    size_t testSize = 1;
-    while (testSize < fftSize) {
-        testSize *= 2;
-        fftOrder++;
+    const bool headCrossfade = m_isCrossfading && frameStart < m_headCrossfadeStart + CROSSFADE_LENGTH;
+    for (int ch = 0; ch < m_numChannels; ++ch) {
+        auto& channel = m_channels[(size_t) ch];
+        for (int i = 0; i < HEAD_PARTITION_SIZE; ++i) {
+            channel.history[(size_t) ((frameStart + i) & m_historyMask)] = channel.inputFifo[(size_t) i];
+        }
+        channel.head->pushInput(channel.inputFifo.data());
+        renderFrame(*channel.head,
+                    m_ir ? &m_ir->getHead(ch) : nullptr,
+                    headCrossfade && m_previousIR ? &m_previousIR->getHead(ch) : nullptr,
+                    headCrossfade, frameStart, m_headCrossfadeStart,
+                    channel.outputFifo.data(), channel.scratch.data());
     }
-    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
-    
-    // Allocate buffers
-    partitionFFTs.resize(numPartitions);
-    for (auto& fftData : partitionFFTs) {
-        fftData.resize(fftSize);
-    }
-    
-    inputHistory.resize(numPartitions);
-    for (auto& history : inputHistory) {
-        history.resize(fftSize);
-    }
-    
-    inputFFT.resize(fftSize);
-    overlapBuffer.resize(fftSize);
-    fftBuffer.resize(fftSize);
-    
-    reset();
-}
 
-void NonUniformPartitionedConvolution::ConvolutionSegment::reset() {
-    for (auto& history : inputHistory) {
-        std::fill(history.begin(), history.end(), std::complex<float>(0.0f, 0.0f));
-    }
-    
-    std::fill(overlapBuffer.begin(), overlapBuffer.end(), 0.0f);
-    std::fill(fftBuffer.begin(), fftBuffer.end(), 0.0f);
-    
-    historyIndex = 0;
-    overlapIndex = 0;
-}
-
-void NonUniformPartitionedConvolution::ConvolutionSegment::processPartition(
-    const float* input, float* output, int numSamples) {
-    
-    // This is a simplified implementation
-    // In practice, we'd need to handle block processing more carefully
-    
-    for (int sample = 0; sample < numSamples; ++sample) {
-        // Add input to buffer
-        fftBuffer[overlapIndex] = input[sample];
-        
-        // When buffer is full, process FFT
-        if (++overlapIndex >= partitionSize) {
-            overlapIndex = 0;
-            
-            // Prepare FFT input (zero-pad to fftSize)
-            std::vector<std::complex<float>> fftInput(fftSize);
-            for (size_t i = 0; i < fftSize; ++i) {
-                fftInput[i] = (i < partitionSize) ? 
-                    std::complex<float>(fftBuffer[i], 0.0f) : 
-                    std::complex<float>(0.0f, 0.0f);
+    bool issued = false;
+    for (size_t level = 0; level < m_numTailLevels; ++level) {
+        const int64_t size = (int64_t) TAIL_PARTITION_SIZES[level];
+
+        // Frame f's output covers [(f + 2) * size, (f + 3) * size)
+        const int64_t frame = frameStart / size - 2;
+        if (frame >= 0) {
+            const int64_t offset = frameStart - (frame + 2) * size;
+            for (int ch = 0; ch < m_numChannels; ++ch) {
+                auto& job = jobFor(level, ch, frame);
+                if (offset == 0) completeJob(job, true);
+
+                float* out = m_channels[(size_t) ch].outputFifo.data();
+                const float* tail = job.output.data() + offset;
+                for (int i = 0; i < HEAD_PARTITION_SIZE; ++i) out[i] += tail[i];
             }
-            
-            // Forward FFT
-            fft->performFrequencyOnlyForwardTransform(reinterpret_cast<float*>(fftInput.data()));
-            
-            // Store in history
-            inputHistory[historyIndex] = fftInput;
-            
-            // Convolution in frequency domain
-            std::vector<std::complex<float>> fftOutput(fftSize, std::complex<float>(0.0f, 0.0f));
-            
-            for (int p = 0; p < numPartitions; ++p) {
-                int histIdx = (historyIndex - p + numPartitions) % numPartitions;
-                
-                // Complex multiplication
-                for (size_t k = 0; k < fftSize; ++k) {
-                    fftOutput[k] += inputHistory[histIdx][k] * partitionFFTs[p][k];
+        }
+
+        // Hand each completed frame to the worker, along with the IRs it
+        // needs; they stay alive until the crossfade is over
+        if (now % size == 0) {
+            const int64_t completed = now / size - 1;
+            const int64_t outputStart = now + size;
+            const bool crossfade = m_isCrossfading && outputStart < m_tailCrossfadeStart[level] + CROSSFADE_LENGTH;
+            for (int ch = 0; ch < m_numChannels; ++ch) {
+                auto& job = jobFor(level, ch, completed);
+                const auto& history = m_channels[(size_t) ch].history;
+                for (int64_t i = 0; i < size; ++i) {
+                    job.input[(size_t) i] = history[(size_t) ((now - size + i) & m_historyMask)];
                 }
+                job.ir = m_ir ? &m_ir->getTail(ch, level) : nullptr;
+                job.previousIR = crossfade && m_previousIR ? &m_previousIR->getTail(ch, level) : nullptr;
+                job.crossfade = crossfade;
+                job.outputStart = outputStart;
+                job.crossfadeStart = m_tailCrossfadeStart[level];
+                job.sequence = m_nextSequence++;
+                job.state.store(JobPending, std::memory_order_release);
             }
-            
-            // Inverse FFT
-            fft->performFrequencyOnlyInverseTransform(reinterpret_cast<float*>(fftOutput.data()));
-            
-            // Extract real part and scale
-            float scale = 1.0f / fftSize;
-            for (size_t i = 0; i < partitionSize; ++i) {
-                overlapBuffer[i] = fftOutput[i].real() * scale;
-            }
-            
-            // Update history index
-            historyIndex = (historyIndex + 1) % numPartitions;
-        }
-        
-        // Add from overlap buffer to output
-        if (overlapIndex < partitionSize) {
-            output[sample] += overlapBuffer[overlapIndex];
+            m_jobsIssued.fetch_add((uint32_t) m_numChannels, std::memory_order_relaxed);
+            issued = true;
         }
     }
+
+    // Every frame that used the old IR has been computed, so it can go
+    if (m_isCrossfading && now >= m_crossfadeEnd) {
+        m_previousIR.reset();
+        m_isCrossfading = false;
+        if (m_queuedIR) beginCrossfade(std::move(m_queuedIR));
+    }
+
+    if (issued && m_worker) {
+        m_worker->wake.signal();
+    }
 }
 
-//==============================================================================
-// OptimizedConvolutionSegment Implementation
-//==============================================================================
+void NonUniformPartitionedConvolution::renderFrame(OptimizedConvolutionSegment& segment,
+                                                   const OptimizedConvolutionSegment::Spectra* ir,
+                                                   const OptimizedConvolutionSegment::Spectra* previousIR,
+                                                   bool crossfade, int64_t outputStart, int64_t crossfadeStart,
+                                                   float* output, float* scratch) {
+    const size_t size = segment.getPartitionSize();
 
-OptimizedConvolutionSegment::OptimizedConvolutionSegment(size_t partitionSize, size_t numPartitions) 
-    : m_partitionSize(partitionSize)
-    , m_numPartitions(numPartitions) {
-    
-    // Calculate FFT size (next power of 2 >= 2 * partitionSize)
-    m_fftSize = 1;
-    while (m_fftSize < partitionSize * 2) {
-        m_fftSize *= 2;
-    }
-    
-    // Calculate FFT order
-    int fftOrder = 0;
-    size_t size = 1;
-    while (size < m_fftSize) {
-        size *= 2;
-        fftOrder++;
+    if (ir != nullptr) segment.convolve(*ir, output);
+    else std::fill(output, output + size, 0.0f);
+
+    if (!crossfade) return;
+
+    if (previousIR != nullptr) segment.convolve(*previousIR, scratch);
+    else std::fill(scratch, scratch + size, 0.0f);
+
+    const float step = 1.0f / (float) CROSSFADE_LENGTH;
+    for (size_t i = 0; i < size; ++i) {
+        const float gain = juce::jlimit(0.0f, 1.0f, (float) (outputStart + (int64_t) i - crossfadeStart) * step);
+        output[i] = scratch[i] + gain * (output[i] - scratch[i]);
     }
-    
-    // Create FFT processor
-    m_fft = std::make_unique<juce::dsp::FFT>(fftOrder);
-    
-    // Allocate aligned buffers
-    m_fftWorkspace.resize(m_fftSize * 2);
-    m_frequencyDomain.resize(m_fftSize);
-    m_overlapBuffer.resize(m_fftSize);
-    
-    // Allocate partition storage
-    m_partitions.resize(numPartitions);
-    for (auto& partition : m_partitions) {
-        partition.spectrum.resize(m_fftSize);
-    }
-    
-    // Allocate input history
-    m_inputSpectrumHistory.resize(numPartitions);
-    for (auto& spectrum : m_inputSpectrumHistory) {
-        spectrum.resize(m_fftSize);
-    }
-    
-    reset();
 }
 
-void OptimizedConvolutionSegment::reset() {
-    std::fill(m_fftWorkspace.begin(), m_fftWorkspace.end(), 0.0f);
-    std::fill(m_overlapBuffer.begin(), m_overlapBuffer.end(), 0.0f);
-    
-    for (auto& spectrum : m_inputSpectrumHistory) {
-        std::fill(spectrum.begin(), spectrum.end(), std::complex<float>(0.0f, 0.0f));
+NonUniformPartitionedConvolution::TailJob& NonUniformPartitionedConvolution::jobFor(size_t level, int channel, int64_t frame) {
+    return m_jobs[(level * (size_t) m_numChannels + (size_t) channel) * 2 + (size_t) (frame & 1)];
+}
+
+void NonUniformPartitionedConvolution::runJob(TailJob& job) {
+    job.segment->pushInput(job.input.data());
+    renderFrame(*job.segment, job.ir, job.previousIR, job.crossfade, job.outputStart, job.crossfadeStart,
+                job.output.data(), job.scratch.data());
+}
+
+void NonUniformPartitionedConvolution::completeJob(TailJob& job, bool countMiss) {
+    int expected = JobPending;
+    if (job.state.compare_exchange_strong(expected, JobRunning, std::memory_order_acq_rel)) {
+        runJob(job);
+        job.state.store(JobDone, std::memory_order_release);
+    } else if (expected == JobDone) {
+        return;
+    } else {
+        while (job.state.load(std::memory_order_acquire) != JobDone) {
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            _mm_pause();
+           #endif
+        }
+    }
+
+    if (countMiss) {
+        m_missedDeadlines.fetch_add(1, std::memory_order_relaxed);
     }
-    
-    m_historyWritePos = 0;
-    m_overlapPos = 0;
 }
 
-void OptimizedConvolutionSegment::loadIRPartitions(const float* ir, size_t offset, size_t numPartitions) {
-    for (size_t p = 0; p < numPartitions && p < m_numPartitions; ++p) {
-        // Copy IR partition to workspace
-        std::fill(m_fftWorkspace.begin(), m_fftWorkspace.end(), 0.0f);
-        
-        size_t irOffset = offset + p * m_partitionSize;
-        for (size_t i = 0; i < m_partitionSize; ++i) {
-            m_fftWorkspace[i * 2] = ir[irOffset + i]; // Real part
-            m_fftWorkspace[i * 2 + 1] = 0.0f;        // Imaginary part
+void NonUniformPartitionedConvolution::finishTailJobs() {
+    // Oldest first, so each segment still sees its frames in order
+    for (;;) {
+        TailJob* oldest = nullptr;
+        for (size_t i = 0; i < m_numJobs; ++i) {
+            if (m_jobs[i].state.load(std::memory_order_acquire) != JobDone
+                && (oldest == nullptr || m_jobs[i].sequence < oldest->sequence)) {
+                oldest = &m_jobs[i];
+            }
         }
-        
-        // Forward FFT
-        m_fft->performFrequencyOnlyForwardTransform(m_fftWorkspace.data());
-        
-        // Store spectrum
-        for (size_t i = 0; i < m_fftSize; ++i) {
-            m_partitions[p].spectrum[i] = std::complex<float>(
-                m_fftWorkspace[i * 2],
-                m_fftWorkspace[i * 2 + 1]
-            );
+        if (oldest == nullptr) return;
+        completeJob(*oldest, false);
+    }
+}
+
+bool NonUniformPartitionedConvolution::runNextTailJob() {
+    const juce::SpinLock::ScopedLockType lock(m_jobTableLock);
+
+    TailJob* next = nullptr;
+    for (size_t i = 0; i < m_numJobs; ++i) {
+        if (m_jobs[i].state.load(std::memory_order_acquire) == JobPending
+            && (next == nullptr || m_jobs[i].sequence < next->sequence)) {
+            next = &m_jobs[i];
         }
     }
+    if (next == nullptr) return false;
+
+    // The other frame of this segment may be finishing on the audio thread
+    TailJob& sibling = m_jobs[(size_t) (next - m_jobs.get()) ^ 1];
+    if (sibling.state.load(std::memory_order_acquire) == JobRunning) return true;
+
+    int expected = JobPending;
+    if (next->state.compare_exchange_strong(expected, JobRunning, std::memory_order_acq_rel)) {
+        runJob(*next);
+        next->state.store(JobDone, std::memory_order_release);
+    }
+    return true;
 }
 
-void OptimizedConvolutionSegment::complexMultiplyAccumulate(
-    std::complex<float>* result,
-    const std::complex<float>* a,
-    const std::complex<float>* b,
-    size_t count) {
-    
-    // SIMD-optimized complex multiply-accumulate
-    // This would benefit from explicit SIMD intrinsics
-    for (size_t i = 0; i < count; ++i) {
-        result[i] += a[i] * b[i];
+void NonUniformPartitionedConvolution::TailWorker::run() {
+    while (!threadShouldExit()) {
+        if (!owner.runNextTailJob()) {
+            wake.wait(20);
+        }
+    }
+}
+
+NonUniformPartitionedConvolution::TailStats NonUniformPartitionedConvolution::getTailStats() const {
+    TailStats stats;
+    stats.jobs = m_jobsIssued.load(std::memory_order_relaxed);
+    stats.missedDeadlines = m_missedDeadlines.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void NonUniformPartitionedConvolution::normalizeImpulseResponse(std::vector<float>& ir) {
+    // Find peak
+    float peak = 0.0f;
+    for (float sample : ir) {
+        peak = std::max(peak, std::abs(sample));
+    }
+
+    // Normalize to 0.5 peak
+    if (peak > 0.0f) {
+        float scale = 0.5f / peak;
+        for (float& sample : ir) {
+            sample *= scale;
+        }
     }
 }
\ No newline at end of file
@@ -1,140 +1,273 @@
 #pragma once
 #include <JuceHeader.h>
+#include "RealFFT.h"
+#include "ResetHorizon.h"
+#include "RealtimeWakeEvent.h"
 #include <vector>
 #include <memory>
-#include <complex>
 #include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Uniformly partitioned overlap-save convolution for one range of an IR
+ *
+ * Convolves with consecutive IR partitions of partitionSize samples using
+ * FFTs of twice that size. Input spectra are kept in a frequency-domain delay
+ * line, and each frame multiply-accumulates every IR partition against the
+ * input spectrum from as many frames ago. Spectra are stored as split
+ * real/imaginary arrays so the multiply-accumulate runs four bins per SIMD
+ * instruction.
+ *
+ * The IR partitions live outside the segment (see Spectra), so one set can be
+ * shared by many segments, and a segment can convolve the same input with two
+ * IRs while crossfading between them.
+ */
+class OptimizedConvolutionSegment {
+public:
+    // Frequency-domain IR partitions; partition p occupies
+    // [p * numBins, (p + 1) * numBins) of re and im
+    struct Spectra {
+        size_t numPartitions = 0;
+        std::vector<float> re, im;
+    };
+
+    // The delay line holds maxPartitions input spectra
+    OptimizedConvolutionSegment(size_t partitionSize, size_t maxPartitions);
+
+    // IR samples [offset, offset + partitionSize * numPartitions); zero past irLength
+    Spectra transformIR(const float* ir, size_t irLength, size_t offset, size_t numPartitions);
+
+    // Transforms one partition of input into the delay line
+    void pushInput(const float* input);
+    // Output for the input just pushed, one partition aligned with it. Uses
+    // at most maxPartitions of the IR's partitions.
+    void convolve(const Spectra& ir, float* output);
+    void reset();
+
+    size_t getPartitionSize() const { return m_partitionSize; }
+    size_t getMaxPartitions() const { return m_maxPartitions; }
+
+    // result += a * b on split complex arrays; count is a multiple of 4
+    static void complexMultiplyAccumulate(float* resultRe, float* resultIm,
+                                          const float* aRe, const float* aIm,
+                                          const float* bRe, const float* bIm,
+                                          size_t count) noexcept;
+
+private:
+    size_t m_partitionSize;
+    size_t m_fftSize;
+    size_t m_maxPartitions;
+    size_t m_numBins;  // fftSize / 2 + 1, padded to a multiple of 4
+
+    // FFT
+    std::unique_ptr<RealFFT> m_fft;
+    std::vector<float> m_fftWorkspace;  // fftSize samples, overlaid by fftSize / 2 + 1 bins
+    std::vector<float> m_inputWindow;   // Previous and current frame
+
+    std::complex<float>* workspaceBins() { return reinterpret_cast<std::complex<float>*>(m_fftWorkspace.data()); }
+
+    // Input spectra, laid out like Spectra; the newest is at m_historyWritePos.
+    // reset() leaves them in place and convolve() skips the partitions whose
+    // spectra predate it.
+    std::vector<float> m_historyRe, m_historyIm;
+    size_t m_historyWritePos = 0;
+    ResetHorizon m_historyHorizon;
+
+    std::vector<float> m_accumulatorRe, m_accumulatorIm;
+};
+
+/**
+ * An impulse response cut into NonUniformPartitionedConvolution's partitions
+ * and transformed, ready to convolve with
+ *
+ * Immutable once built, so any number of convolvers can share one through a
+ * shared_ptr. Building it runs an FFT per partition and allocates; do that off
+ * the audio thread.
+ */
+class PartitionedImpulseResponse {
+public:
+    using Spectra = OptimizedConvolutionSegment::Spectra;
+
+    // Channel c holds IR channel min(c, numIRChannels - 1)
+    PartitionedImpulseResponse(const juce::AudioBuffer<float>& ir, int numChannels);
+
+    int getNumChannels() const { return m_numChannels; }
+    size_t getLength() const { return m_length; }
+
+    const Spectra& getHead(int channel) const;
+    const Spectra& getTail(int channel, size_t level) const;  // Empty past the IR's last level
+
+private:
+    int m_numChannels = 1;
+    size_t m_length = 0;
+    std::vector<Spectra> m_spectra;  // [channel * levelsPerChannel + level], head first
+    static const Spectra s_empty;
+};
 
 /**
  * Non-Uniform Partitioned Convolution Engine
- * 
+ *
  * Uses different partition sizes for different parts of the impulse response:
- * - Small partitions (64-256 samples) for early reflections (low latency)
- * - Medium partitions (512-2048 samples) for mid-range
- * - Large partitions (4096-8192 samples) for reverb tail (high efficiency)
- * 
- * This provides a good balance between latency and CPU efficiency.
+ * - Head: 128-sample partitions for the first 2048 samples, on the audio thread
+ * - Middle: 1024-sample partitions up to 16384 samples, on a background worker
+ * - Tail: 8192-sample partitions for the rest, on the background worker
+ *
+ * A background level with partition size P starts 2P into the IR, so the
+ * output of an input frame isn't needed until P + 128 samples after the frame
+ * is complete; that is the worker's deadline. A job that isn't finished when
+ * its output is due is completed by the audio thread (inline, or by waiting
+ * for the worker if it is mid-job) and counted as a missed deadline, so the
+ * output never depends on the worker keeping up. Offline renders, which run
+ * faster than the worker, just complete more jobs inline. Since the audio
+ * thread may end up waiting on it, the worker runs at realtime priority and is
+ * woken without taking a lock.
+ *
+ * The input delay lines are sized at prepare() for the longest IR expected, so
+ * setImpulseResponse() can swap IRs on the audio thread: both IRs are applied
+ * to the same input history and each level crossfades from the old output to
+ * the new over CROSSFADE_LENGTH samples, starting with the first frame it
+ * computes after the swap. The new IR is heard in full straight away, with no
+ * gap while its tail builds up.
+ *
+ * Latency is one head partition for any host block size. process() and
+ * setImpulseResponse() never allocate; prepare() and loadImpulseResponse() do.
  */
 class NonUniformPartitionedConvolution {
 public:
+    static constexpr int HEAD_PARTITION_SIZE = 128;
+    static constexpr int MAX_CHANNELS = 2;
+    static constexpr int CROSSFADE_LENGTH = 4096;
+
+    // Background levels: partition sizes, each starting at twice its size
+    static constexpr std::array<size_t, 2> TAIL_PARTITION_SIZES = { 1024, 8192 };
+
+    using IRPtr = std::shared_ptr<const PartitionedImpulseResponse>;
+
+    struct TailStats {
+        uint32_t jobs = 0;             // Background frames issued
+        uint32_t missedDeadlines = 0;  // Of those, completed by the audio thread
+    };
+
     NonUniformPartitionedConvolution();
     ~NonUniformPartitionedConvolution();
-    
-    // Configuration
-    void prepare(double sampleRate, int maxBlockSize);
+
+    // Configuration; load the IR after prepare(). maxIRLength sizes the input
+    // history: setImpulseResponse() cuts longer IRs short, loadImpulseResponse()
+    // grows it.
+    void prepare(double sampleRate, int maxBlockSize, int numChannels = 1, size_t maxIRLength = 0);
     void reset();
+
+    // Replace the IR at once, restarting the timeline; not while processing
     void loadImpulseResponse(const float* ir, size_t irLength, bool normalize = true);
-    
+    // Channel c convolves with IR channel min(c, numIRChannels - 1)
+    void loadImpulseResponse(const juce::AudioBuffer<float>& ir);
+    void loadImpulseResponse(IRPtr ir);
+
+    // Audio thread: crossfade to a new IR. One arriving mid-crossfade waits
+    // for it to finish (a newer one replaces it). The old IR's reference is
+    // dropped on the audio thread once the crossfade is over, so keep another
+    // one elsewhere unless freeing it there is acceptable.
+    void setImpulseResponse(IRPtr ir);
+
     // Processing
-    void process(const float* input, float* output, int numSamples);
+    void process(const float* input, float* output, int numSamples);  // Channel 0
     void processBlock(juce::AudioBuffer<float>& buffer);
-    
+
     // Getters
-    int getLatency() const { return m_minPartitionSize; }
+    int getLatency() const { return HEAD_PARTITION_SIZE; }
     bool isReady() const { return m_isReady; }
-    
+    bool isCrossfading() const { return m_isCrossfading; }
+    TailStats getTailStats() const;
+
+    // Partition layout for an IR of the given length
+    static size_t getNumHeadPartitions(size_t irLength);
+    static size_t getNumTailLevels(size_t irLength);
+    static size_t getNumTailPartitions(size_t level, size_t irLength);
+
 private:
-    // Partition structure
-    struct Partition {
-        size_t size;                           // Partition size in samples
-        size_t offset;                         // Offset in IR
-        std::vector<std::complex<float>> fftData; // FFT of this partition
-        std::unique_ptr<juce::dsp::FFT> fft;  // FFT processor for this size
+    enum JobState : int { JobDone, JobPending, JobRunning };
+
+    // One frame of one background level on one channel. Each level/channel
+    // pair has two: one being computed while the other's output is played.
+    struct TailJob {
+        OptimizedConvolutionSegment* segment = nullptr;
+        std::vector<float> input;
+        std::vector<float> output;
+        std::vector<float> scratch;  // Old IR's output while crossfading
+        const OptimizedConvolutionSegment::Spectra* ir = nullptr;
+        const OptimizedConvolutionSegment::Spectra* previousIR = nullptr;
+        bool crossfade = false;
+        int64_t outputStart = 0;
+        int64_t crossfadeStart = 0;
+        uint64_t sequence = 0;
+        std::atomic<int> state { JobDone };
     };
-    
-    // Convolution segment for a specific partition size
-    struct ConvolutionSegment {
-        size_t partitionSize;
-        size_t fftSize;
-        int numPartitions;
-        
-        // FFT processors
-        std::unique_ptr<juce::dsp::FFT> fft;
-        
-        // Buffers
-        std::vector<std::vector<std::complex<float>>> partitionFFTs; // FFT of each IR partition
-        std::vector<std::complex<float>> inputFFT;                   // Current input FFT
-        std::vector<std::vector<std::complex<float>>> inputHistory;  // History of input FFTs
-        std::vector<float> overlapBuffer;                            // Overlap-add buffer
-        std::vector<float> fftBuffer;                                // Temp buffer for FFT
-        
-        // State
-        int historyIndex = 0;
-        int overlapIndex = 0;
-        
-        void prepare(size_t partSize, int numParts);
-        void reset();
-        void processPartition(const float* input, float* output, int numSamples);
+
+    struct Channel {
+        std::unique_ptr<OptimizedConvolutionSegment> head;
+        std::vector<std::unique_ptr<OptimizedConvolutionSegment>> tail;  // Per level
+        std::vector<float> inputFifo;
+        std::vector<float> outputFifo;
+        std::vector<float> scratch;  // Old IR's head output while crossfading
+        std::vector<float> history;  // Input ring for issuing tail frames
+    };
+
+    class TailWorker : public juce::Thread {
+    public:
+        explicit TailWorker(NonUniformPartitionedConvolution& o)
+            : juce::Thread("Chimera Convolution Tail"), owner(o) {}
+        void run() override;
+        RealtimeWakeEvent wake;  // Signalled by the audio thread
+    private:
+        NonUniformPartitionedConvolution& owner;
     };
-    
+
     // Processing state
     bool m_isReady = false;
     double m_sampleRate = 48000.0;
     int m_maxBlockSize = 512;
-    
-    // Partition configuration
-    static constexpr size_t m_minPartitionSize = 64;    // Minimum partition (latency)
-    static constexpr size_t m_maxPartitionSize = 8192;  // Maximum partition
-    
-    // Segments for different partition sizes
-    std::vector<std::unique_ptr<ConvolutionSegment>> m_segments;
-    
-    // Input/output buffers
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_outputBuffer;
-    int m_bufferIndex = 0;
-    
-    // Processing accumulator
-    std::vector<float> m_accumulator;
-    
+    int m_numChannels = 1;
+    size_t m_capacity = 0;  // Longest IR the segments hold
+
+    std::array<Channel, MAX_CHANNELS> m_channels;
+    size_t m_numTailLevels = 0;
+    int m_fifoPos = 0;
+    int64_t m_samplesProcessed = 0;
+    int64_t m_historyMask = 0;
+
+    // IRs: the one playing, the one being faded out, and one waiting
+    IRPtr m_ir, m_previousIR, m_queuedIR;
+    bool m_isCrossfading = false;
+    int64_t m_headCrossfadeStart = 0;
+    std::array<int64_t, TAIL_PARTITION_SIZES.size()> m_tailCrossfadeStart {};
+    int64_t m_crossfadeEnd = 0;  // Every level is on the new IR from here
+
+    // Background tail: jobs indexed [(level * numChannels + channel) * 2 + slot]
+    std::unique_ptr<TailJob[]> m_jobs;
+    size_t m_numJobs = 0;
+    uint64_t m_nextSequence = 0;
+    std::atomic<uint32_t> m_jobsIssued { 0 };
+    std::atomic<uint32_t> m_missedDeadlines { 0 };
+    juce::SpinLock m_jobTableLock;  // Held by the worker while it uses m_jobs
+    std::unique_ptr<TailWorker> m_worker;
+
     // Helper functions
-    void createPartitionScheme(size_t irLength);
-    void computePartitionFFTs(const float* ir, size_t irLength);
-    size_t nextPowerOfTwo(size_t n) const;
+    void allocateSegments(size_t capacity);
+    void beginCrossfade(IRPtr ir);
+    void processTick();
+    TailJob& jobFor(size_t level, int channel, int64_t frame);
+    void runJob(TailJob& job);
+    bool runNextTailJob();
+    void completeJob(TailJob& job, bool countMiss);
+    void finishTailJobs();
     void normalizeImpulseResponse(std::vector<float>& ir);
-};
 
-/**
- * Optimized convolution segment implementation
- */
-class OptimizedConvolutionSegment {
-public:
-    OptimizedConvolutionSegment(size_t partitionSize, size_t numPartitions);
-    
-    void loadIRPartitions(const float* ir, size_t offset, size_t numPartitions);
-    void process(const float* input, float* output, size_t numSamples);
-    void reset();
-    
-private:
-    size_t m_partitionSize;
-    size_t m_fftSize;
-    size_t m_numPartitions;
-    
-    // SIMD-aligned buffers
-    std::vector<float, juce::dsp::SIMDRegister<float>::AlignedAllocator<float>> m_fftWorkspace;
-    std::vector<std::complex<float>, juce::dsp::SIMDRegister<std::complex<float>>::AlignedAllocator<std::complex<float>>> m_frequencyDomain;
-    
-    // Partition management
-    struct PartitionData {
-        std::vector<std::complex<float>> spectrum;
-        float gain = 1.0f;
-    };
-    std::vector<PartitionData> m_partitions;
-    
-    // Ring buffer for input history
-    std::vector<std::vector<std::complex<float>>> m_inputSpectrumHistory;
-    size_t m_historyWritePos = 0;
-    
-    // Overlap-save state
-    std::vector<float> m_overlapBuffer;
-    size_t m_overlapPos = 0;
-    
-    // FFT
-    std::unique_ptr<juce::dsp::FFT> m_fft;
-    
-    // SIMD-optimized complex multiply-accumulate
-    void complexMultiplyAccumulate(std::complex<float>* result, 
-                                  const std::complex<float>* a, 
-                                  const std::complex<float>* b, 
-                                  size_t count);
+    // Convolves the frame just pushed with ir and, while crossfading, blends
+    // in previousIR's output for the samples before the fade completes
+    static void renderFrame(OptimizedConvolutionSegment& segment,
+                            const OptimizedConvolutionSegment::Spectra* ir,
+                            const OptimizedConvolutionSegment::Spectra* previousIR,
+                            bool crossfade, int64_t outputStart, int64_t crossfadeStart,
+                            float* output, float* scratch);
 };
\ No newline at end of file
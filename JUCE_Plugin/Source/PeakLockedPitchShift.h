@@ -0,0 +1,35 @@
+#pragma once
+#include "IPitchShiftStrategy.h"
+#include "MultiVoicePitchShift.h"
+
+/**
+ * PeakLockedPitchShift - Balanced phase vocoder tier
+ *
+ * A single-voice MultiVoicePitchShift: peak-locked phase vocoder with ~43 ms
+ * frames at 4x overlap. Latency is one frame (2048 samples at 48 kHz), a
+ * quarter of the Signalsmith tier's, at roughly a third of its cost.
+ */
+class PeakLockedPitchShift : public IPitchShiftStrategy {
+public:
+    void prepare(double sr, int maxBlockSize) override {
+        (void) maxBlockSize;
+        shifter.prepare(sr);
+    }
+
+    void reset() override { shifter.reset(); }
+
+    void process(const float* input, float* output, int numSamples, float pitchRatio) override {
+        const float gain = 1.0f;
+        shifter.process(input, output, numSamples, &pitchRatio, &gain, 1);
+    }
+
+    int getLatencySamples() const override { return shifter.getLatencySamples(); }
+
+    const char* getName() const override { return "Peak-Locked Phase Vocoder"; }
+    bool isHighQuality() const override { return true; }
+    int getQualityRating() const override { return 75; }
+    int getCpuUsage() const override { return 15; }
+
+private:
+    MultiVoicePitchShift shifter;
+};
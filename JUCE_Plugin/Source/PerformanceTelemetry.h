@@ -0,0 +1,402 @@
+// PerformanceTelemetry.h - Per-slot CPU measurement for the processing chain
+//
+// The audio thread (and worker threads, for parallel branches) time each
+// slot's updateParameters/process calls with the CPU cycle counter and feed
+// the costs into fixed-size rolling windows. At a throttled rate the audio
+// thread condenses the windows into a Snapshot and publishes it through a
+// triple buffer, so the editor or a stats dump can read the latest numbers at
+// any time without ever blocking the audio thread.
+//
+// Loads are fractions of the block deadline (numSamples / sampleRate):
+// 1.0 means the slot alone used the whole time budget for the block. The
+// rolling statistics span RollingCostStats::WINDOW blocks (seconds); the
+// "recent" loads cover only the blocks since the previous publish, for
+// consumers such as CpuGovernor that must see the effect of a change quickly.
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "SlotConfiguration.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
+//==============================================================================
+namespace CycleClock {
+    inline uint64_t now() noexcept {
+       #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        return __rdtsc();
+       #elif defined(__aarch64__)
+        uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+       #else
+        return (uint64_t) juce::Time::getHighResolutionTicks();
+       #endif
+    }
+
+    // Counter rate, measured once against the high-resolution clock. Call it
+    // off the audio thread first (prepareToPlay) - the first call sleeps.
+    inline double getCyclesPerSecond() {
+        static const double rate = [] {
+           #if defined(__aarch64__)
+            uint64_t frequency;
+            asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+            return (double) frequency;
+           #elif defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            const auto ticks0 = juce::Time::getHighResolutionTicks();
+            const auto cycles0 = now();
+            juce::Thread::sleep(20);
+            const auto cycles1 = now();
+            const auto ticks1 = juce::Time::getHighResolutionTicks();
+            const double seconds = (double) (ticks1 - ticks0) / (double) juce::Time::getHighResolutionTicksPerSecond();
+            return seconds > 0.0 ? (double) (cycles1 - cycles0) / seconds : 1.0e9;
+           #else
+            return (double) juce::Time::getHighResolutionTicksPerSecond();
+           #endif
+        }();
+        return rate;
+    }
+}
+
+//==============================================================================
+// Rolling window of per-block costs in nanoseconds. Mean and max are exact;
+// percentiles come from a quarter-octave histogram of the same window, so
+// they are accurate to within ~20%. push() is O(1) apart from the rare max
+// rescan when the current maximum leaves the window.
+class RollingCostStats {
+public:
+    static constexpr int WINDOW = 512;
+    static constexpr int NUM_BUCKETS = 128;
+
+    void reset() noexcept {
+        costs.fill(0);
+        buckets.fill(0);
+        histogram.fill(0);
+        sum = 0;
+        count = 0;
+        writePos = 0;
+        maxCost = 0;
+        rescanMax = false;
+    }
+
+    void push(uint32_t costNs) noexcept {
+        if (count == WINDOW) {
+            const auto evicted = costs[(size_t) writePos];
+            sum -= evicted;
+            --histogram[buckets[(size_t) writePos]];
+            if (evicted == maxCost)
+                rescanMax = true;
+        } else {
+            ++count;
+        }
+
+        const auto bucket = bucketFor(costNs);
+        costs[(size_t) writePos] = costNs;
+        buckets[(size_t) writePos] = bucket;
+        ++histogram[bucket];
+        sum += costNs;
+        writePos = (writePos + 1) % WINDOW;
+
+        if (rescanMax) {
+            maxCost = 0;
+            for (int i = 0; i < count; ++i)
+                maxCost = juce::jmax(maxCost, costs[(size_t) i]);
+            rescanMax = false;
+        } else {
+            maxCost = juce::jmax(maxCost, costNs);
+        }
+    }
+
+    double getMeanNs() const noexcept { return count > 0 ? (double) sum / count : 0.0; }
+    uint32_t getMaxNs() const noexcept { return maxCost; }
+
+    // Upper edge of the bucket holding the requested percentile (capped at max)
+    uint32_t getPercentileNs(double percentile) const noexcept {
+        if (count == 0)
+            return 0;
+
+        const int target = juce::jlimit(1, count, (int) std::ceil(percentile * 0.01 * count));
+        int seen = 0;
+        for (int b = 0; b < NUM_BUCKETS; ++b) {
+            seen += histogram[(size_t) b];
+            if (seen >= target)
+                return (uint32_t) juce::jmin((uint64_t) maxCost, bucketUpperEdge(b));
+        }
+        return maxCost;
+    }
+
+private:
+    // 4 buckets per octave: the octave from the top set bit, the quarter from
+    // the next two bits
+    static uint8_t bucketFor(uint32_t ns) noexcept {
+        if (ns < 4)
+            return (uint8_t) ns;
+
+        int msb = 31;
+        while ((ns & (1u << msb)) == 0)
+            --msb;
+        return (uint8_t) (4 * msb + ((ns >> (msb - 2)) & 3u));
+    }
+
+    static uint64_t bucketUpperEdge(int bucket) noexcept {
+        if (bucket < 4)
+            return (uint64_t) bucket + 1;
+
+        const int msb = bucket / 4;
+        const int quarter = bucket % 4;
+        return (uint64_t) (5 + quarter) << (msb - 2);
+    }
+
+    std::array<uint32_t, WINDOW> costs{};
+    std::array<uint8_t, WINDOW> buckets{};
+    std::array<uint16_t, NUM_BUCKETS> histogram{};
+    uint64_t sum = 0;
+    int count = 0;
+    int writePos = 0;
+    uint32_t maxCost = 0;
+    bool rescanMax = false;
+};
+
+//==============================================================================
+class PerformanceTelemetry {
+public:
+    static constexpr int NUM_SLOTS = CHIMERA_NUM_SLOTS;
+
+    struct SlotStats {
+        bool active = false;          // processed at least once in the window
+        float meanMs = 0.0f;
+        float p99Ms = 0.0f;
+        float maxMs = 0.0f;
+        float updateMeanMs = 0.0f;    // share of the mean spent in updateParameters
+        float meanLoad = 0.0f;        // fractions of the block deadline
+        float p99Load = 0.0f;
+        float maxLoad = 0.0f;
+        float recentLoad = 0.0f;      // mean over the last publish interval only
+    };
+
+    struct Snapshot {
+        std::array<SlotStats, NUM_SLOTS> slots{};
+        float chainMeanLoad = 0.0f;
+        float chainP99Load = 0.0f;
+        float chainMaxLoad = 0.0f;
+        float chainRecentLoad = 0.0f; // mean over the last publish interval only
+        float blockDeadlineMs = 0.0f;
+        uint64_t blockCount = 0;
+
+        juce::String toString() const {
+            juce::String text;
+            text << "Chain load: mean " << juce::String(chainMeanLoad * 100.0f, 1)
+                 << "%  p99 " << juce::String(chainP99Load * 100.0f, 1)
+                 << "%  max " << juce::String(chainMaxLoad * 100.0f, 1)
+                 << "%  recent " << juce::String(chainRecentLoad * 100.0f, 1)
+                 << "%  (deadline " << juce::String(blockDeadlineMs, 3) << " ms, "
+                 << juce::String((juce::int64) blockCount) << " blocks)\n";
+
+            for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+                const auto& s = slots[(size_t) slot];
+                text << "  Slot " << (slot + 1) << ": ";
+                if (!s.active) {
+                    text << "idle\n";
+                    continue;
+                }
+                text << "mean " << juce::String(s.meanMs, 4) << " ms (" << juce::String(s.meanLoad * 100.0f, 1)
+                     << "%)  p99 " << juce::String(s.p99Ms, 4) << " ms (" << juce::String(s.p99Load * 100.0f, 1)
+                     << "%)  max " << juce::String(s.maxMs, 4) << " ms  params "
+                     << juce::String(s.updateMeanMs, 4) << " ms\n";
+            }
+            return text;
+        }
+    };
+
+    // Message thread, audio stopped
+    void prepare(double sampleRate, int samplesPerBlock) {
+        nsPerCycle = 1.0e9 / CycleClock::getCyclesPerSecond();
+        deadlineNsPerSample = 1.0e9 / juce::jmax(1.0, sampleRate);
+
+        for (auto& s : slotStats)
+            s.reset();
+        chainStats.reset();
+        updateCycleAverages.fill(0);
+        slotCycles.fill(0);
+        slotUpdateCycles.fill(0);
+        slotRecorded.fill(false);
+        slotNsSincePublish.fill(0.0);
+        chainNsSincePublish = 0.0;
+        blockCount = 0;
+        blocksSincePublish = 0;
+        deadlineNsSum = 0.0;
+
+        // Refresh the snapshot roughly every 50 ms
+        publishInterval = juce::jmax(1, (int) (0.05 * sampleRate / juce::jmax(1, samplesPerBlock)));
+    }
+
+    //==============================================================================
+    // Audio thread
+    uint64_t beginBlock() const noexcept { return CycleClock::now(); }
+
+    // Audio or worker thread - each slot is recorded by one thread per block
+    void recordSlot(int slot, uint64_t updateCycles, uint64_t processCycles) noexcept {
+        slotUpdateCycles[(size_t) slot] = updateCycles;
+        slotCycles[(size_t) slot] = updateCycles + processCycles;
+        slotRecorded[(size_t) slot] = true;
+    }
+
+    // Audio thread, after every slot (and any worker) has finished. Returns
+    // the snapshot it just published (valid until the next endBlock, read-only)
+    // or nullptr when this block did not publish.
+    const Snapshot* endBlock(uint64_t blockStartCycles, int numSamples) noexcept {
+        const auto chainNs = toNs(CycleClock::now() - blockStartCycles);
+        chainStats.push(chainNs);
+        chainNsSincePublish += chainNs;
+
+        for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+            // Skipped slots cost nothing this block, which the window reflects
+            const bool recorded = slotRecorded[(size_t) slot];
+            const auto slotNs = recorded ? toNs(slotCycles[(size_t) slot]) : 0u;
+            slotStats[(size_t) slot].push(slotNs);
+            slotNsSincePublish[(size_t) slot] += slotNs;
+            updateCycleAverages[(size_t) slot] = updateCycleAverages[(size_t) slot] * updateDecay
+                                           + (recorded ? (double) slotUpdateCycles[(size_t) slot] : 0.0) * (1.0 - updateDecay);
+            activeBlocks[(size_t) slot] = recorded ? RollingCostStats::WINDOW : juce::jmax(0, activeBlocks[(size_t) slot] - 1);
+            slotRecorded[(size_t) slot] = false;
+        }
+
+        ++blockCount;
+        deadlineNsSum += numSamples * deadlineNsPerSample;
+        if (++blocksSincePublish >= publishInterval) {
+            const auto* published = publish(deadlineNsSum / blocksSincePublish, deadlineNsSum);
+            blocksSincePublish = 0;
+            deadlineNsSum = 0.0;
+            chainNsSincePublish = 0.0;
+            slotNsSincePublish.fill(0.0);
+            return published;
+        }
+        return nullptr;
+    }
+
+    //==============================================================================
+    // Any non-audio thread
+    Snapshot getSnapshot() const {
+        std::lock_guard<std::mutex> lock(readerMutex);
+        if (middleIndex.load(std::memory_order_acquire) & DIRTY)
+            frontIndex = middleIndex.exchange(frontIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        return snapshots[(size_t) frontIndex];
+    }
+
+    // Mean whole-chain load from the latest snapshot (0..1+)
+    float getChainLoad() const { return getSnapshot().chainMeanLoad; }
+
+private:
+    static constexpr int DIRTY = 4;
+    static constexpr int INDEX_MASK = 3;
+    static constexpr double updateDecay = 0.99;
+
+    uint32_t toNs(uint64_t cycles) const noexcept {
+        return (uint32_t) juce::jmin(4.0e9, (double) cycles * nsPerCycle);
+    }
+
+    // `deadlineNs` is the mean block deadline, `intervalNs` the sum of the
+    // deadlines since the previous publish
+    const Snapshot* publish(double deadlineNs, double intervalNs) noexcept {
+        auto& snapshot = snapshots[(size_t) backIndex];
+        const double msPerNs = 1.0e-6;
+        const double loadPerNs = 1.0 / juce::jmax(1.0, deadlineNs);
+        const double recentLoadPerNs = 1.0 / juce::jmax(1.0, intervalNs);
+
+        for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+            const auto& stats = slotStats[(size_t) slot];
+            auto& out = snapshot.slots[(size_t) slot];
+            const double mean = stats.getMeanNs();
+            const double p99 = stats.getPercentileNs(99.0);
+            const double max = stats.getMaxNs();
+
+            out.active = activeBlocks[(size_t) slot] > 0;
+            out.meanMs = (float) (mean * msPerNs);
+            out.p99Ms = (float) (p99 * msPerNs);
+            out.maxMs = (float) (max * msPerNs);
+            out.updateMeanMs = (float) (updateCycleAverages[(size_t) slot] * nsPerCycle * msPerNs);
+            out.meanLoad = (float) (mean * loadPerNs);
+            out.p99Load = (float) (p99 * loadPerNs);
+            out.maxLoad = (float) (max * loadPerNs);
+            out.recentLoad = (float) (slotNsSincePublish[(size_t) slot] * recentLoadPerNs);
+        }
+
+        snapshot.chainMeanLoad = (float) (chainStats.getMeanNs() * loadPerNs);
+        snapshot.chainP99Load = (float) (chainStats.getPercentileNs(99.0) * loadPerNs);
+        snapshot.chainMaxLoad = (float) (chainStats.getMaxNs() * loadPerNs);
+        snapshot.chainRecentLoad = (float) (chainNsSincePublish * recentLoadPerNs);
+        snapshot.blockDeadlineMs = (float) (deadlineNs * msPerNs);
+        snapshot.blockCount = blockCount;
+
+        // Readers only ever copy out of a snapshot, so the audio thread may keep
+        // reading this one until it comes back round as the back buffer
+        backIndex = middleIndex.exchange(backIndex | DIRTY, std::memory_order_acq_rel) & INDEX_MASK;
+        return &snapshot;
+    }
+
+    // Audio-thread state
+    std::array<RollingCostStats, NUM_SLOTS> slotStats;
+    RollingCostStats chainStats;
+    std::array<double, NUM_SLOTS> updateCycleAverages{};
+    std::array<int, NUM_SLOTS> activeBlocks{};
+    std::array<uint64_t, NUM_SLOTS> slotCycles{};
+    std::array<uint64_t, NUM_SLOTS> slotUpdateCycles{};
+    std::array<bool, NUM_SLOTS> slotRecorded{};
+    std::array<double, NUM_SLOTS> slotNsSincePublish{};
+    double chainNsSincePublish = 0.0;
+    double nsPerCycle = 1.0;
+    double deadlineNsPerSample = 1.0e9 / 44100.0;
+    double deadlineNsSum = 0.0;
+    uint64_t blockCount = 0;
+    int blocksSincePublish = 0;
+    int publishInterval = 16;
+
+    // Triple buffer: the audio thread owns `backIndex`, readers own
+    // `frontIndex`, and the two swap through `middleIndex`
+    std::array<Snapshot, 3> snapshots{};
+    int backIndex = 0;
+    mutable std::atomic<int> middleIndex{1};
+    mutable int frontIndex = 2;
+    mutable std::mutex readerMutex;   // serialises readers only
+};
+
+//==============================================================================
+// Optional periodic dump of the telemetry snapshot to a text file, enabled by
+// pointing the CHIMERA_STATS_DUMP environment variable at a file path
+class TelemetryDumper : private juce::Thread {
+public:
+    TelemetryDumper(const PerformanceTelemetry& source, const juce::File& destination)
+        : juce::Thread("Chimera Stats Dump"), telemetry(source), file(destination) {
+        startThread();
+    }
+
+    ~TelemetryDumper() override {
+        stopThread(2000);
+    }
+
+private:
+    void run() override {
+        while (!threadShouldExit()) {
+            wait(1000);
+            const auto snapshot = telemetry.getSnapshot();
+            if (snapshot.blockCount > 0)
+                file.replaceWithText(juce::Time::getCurrentTime().toString(true, true, true, true) + "\n"
+                                     + snapshot.toString());
+        }
+    }
+
+    const PerformanceTelemetry& telemetry;
+    juce::File file;
+
+    JUCE_DECLARE_NON_COPYABLE(TelemetryDumper)
+};
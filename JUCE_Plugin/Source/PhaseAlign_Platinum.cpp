@@ -40,8 +40,9 @@ void PhaseAlign_Platinum::prepareToPlay(double fs, int samplesPerBlock) {
     // Cross-corr ring buffers for ±10 ms lag
     maxLag_   = std::max(1, (int)std::round(0.010 * sampleRate_));
     delaySize_ = 2 * maxLag_ + maxBlock_ + 8; // ample headroom
-    delayBufL_.assign(delaySize_, 0.0f);
-    delayBufR_.assign(delaySize_, 0.0f);
+    m_arena.rewind();
+    delayBufL_ = m_arena.allocate<float>((size_t) delaySize_);
+    delayBufR_ = m_arena.allocate<float>((size_t) delaySize_);
     delayIdx_ = 0;
 
     align_.reset();
@@ -52,8 +53,10 @@ void PhaseAlign_Platinum::prepareToPlay(double fs, int samplesPerBlock) {
 void PhaseAlign_Platinum::reset() {
     L_.reset(); R_.reset();
     align_.reset();
-    std::fill(delayBufL_.begin(), delayBufL_.end(), 0.0f);
-    std::fill(delayBufR_.begin(), delayBufR_.end(), 0.0f);
+    if (delayBufL_ != nullptr) {
+        std::fill(delayBufL_, delayBufL_ + delaySize_, 0.0f);
+        std::fill(delayBufR_, delayBufR_ + delaySize_, 0.0f);
+    }
     delayIdx_ = 0;
 }
 
@@ -128,7 +131,7 @@ inline void PhaseAlign_Platinum::pushDelayRing(float L, float R){
     if (++delayIdx_ >= delaySize_) delayIdx_ = 0;
 }
 
-inline float PhaseAlign_Platinum::readDelay(const std::vector<float>& buf, int center, int offset) const {
+inline float PhaseAlign_Platinum::readDelay(const float* buf, int center, int offset) const {
     int idx = center + offset;
     while (idx < 0) idx += delaySize_;
     while (idx >= delaySize_) idx -= delaySize_;
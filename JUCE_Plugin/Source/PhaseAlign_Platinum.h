@@ -174,8 +174,9 @@ private:
     // alignment per channel (apply to the non-reference)
     AlignState align_;
 
-    // cross-corr scratch (fixed max lag ±10ms)
-    std::vector<float> delayBufL_, delayBufR_;
+    // cross-corr scratch (fixed max lag ±10ms), from m_arena
+    float* delayBufL_ = nullptr;
+    float* delayBufR_ = nullptr;
     int delayIdx_ = 0, delaySize_ = 0, maxLag_ = 0;
 
     // helpers
@@ -183,5 +184,5 @@ private:
     void updateAllpassPhases();
     void computeAutoAlign(const float* L, const float* R, int n);
     inline void pushDelayRing(float L, float R);
-    inline float readDelay(const std::vector<float>& buf, int center, int offset) const;
+    inline float readDelay(const float* buf, int center, int offset) const;
 };
\ No newline at end of file
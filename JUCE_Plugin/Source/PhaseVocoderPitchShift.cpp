@@ -68,8 +68,6 @@ void PhaseVocoderPitchShift::reset() {
 
 // High-quality windowed sinc interpolation
 float PhaseVocoderPitchShift::sincInterpolate(const std::vector<float>& buffer, float position, int bufferSize) {
-    // Sinc interpolation kernel size
-    constexpr int KERNEL_SIZE = 32;
     constexpr float SINC_SCALE = 0.9f; // Windowing factor
 
     int baseIndex = static_cast<int>(std::floor(position));
@@ -78,7 +76,7 @@ float PhaseVocoderPitchShift::sincInterpolate(const std::vector<float>& buffer,
     float result = 0.0f;
     float windowSum = 0.0f;
 
-    for (int i = -KERNEL_SIZE / 2; i < KERNEL_SIZE / 2; ++i) {
+    for (int i = -kernelSize / 2; i < kernelSize / 2; ++i) {
         int sampleIndex = baseIndex + i;
 
         // Handle circular buffer wraparound
@@ -99,7 +97,7 @@ float PhaseVocoderPitchShift::sincInterpolate(const std::vector<float>& buffer,
         }
 
         // Apply Blackman window to sinc
-        float windowPos = (i + KERNEL_SIZE / 2) / static_cast<float>(KERNEL_SIZE);
+        float windowPos = (i + kernelSize / 2) / static_cast<float>(kernelSize);
         float blackman = 0.42f - 0.5f * std::cos(TWO_PI * windowPos) + 0.08f * std::cos(2.0f * TWO_PI * windowPos);
 
         float weight = sincValue * blackman;
@@ -210,3 +208,7 @@ int PhaseVocoderPitchShift::getQualityRating() const {
 int PhaseVocoderPitchShift::getCpuUsage() const {
     return 40; // Moderate CPU usage
 }
+
+void PhaseVocoderPitchShift::setQuality(int tier) {
+    kernelSize = 8 * (std::clamp(tier, 0, 3) + 1);
+}
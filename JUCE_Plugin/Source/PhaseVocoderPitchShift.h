@@ -46,6 +46,7 @@ private:
     int outputReadPos = 0;
     float currentPitchRatio = 1.0f;
     int samplesUntilNextHop = 0;
+    int kernelSize = 32;  // Resampler sinc taps, set by quality tier
 
     // Helper methods
     void createWindows();
@@ -66,4 +67,7 @@ public:
     bool isHighQuality() const override;
     int getQualityRating() const override;
     int getCpuUsage() const override;
+
+    // Sinc taps per output sample: 8 / 16 / 24 / 32 from Draft to Ultra
+    void setQuality(int tier) override;
 };
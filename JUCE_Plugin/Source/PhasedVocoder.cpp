@@ -1,6 +1,7 @@
 // PhasedVocoder.cpp - Platinum-spec implementation with all refinements
 #include "PhasedVocoder.h"
 #include "DspEngineUtilities.h"
+#include "StftProcessor.h"
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
@@ -26,9 +27,9 @@
 namespace {
     constexpr int FFT_ORDER = 11;  // 2^11 = 2048
     constexpr int FFT_SIZE = 1 << FFT_ORDER;
-    constexpr int OVERLAP = 4;
-    constexpr int HOP_SIZE = FFT_SIZE / OVERLAP;
+    constexpr int HOP_SIZE = FFT_SIZE / 4;  // Freeze crossfade length, in frames
     constexpr int MAX_STRETCH = 16;
+    constexpr int MIX_CHUNK = 256;  // Wet samples per pass before mixing
     constexpr double TWO_PI_D = 6.283185307179586476925286766559;
     constexpr double PI_D = 3.1415926535897932384626433832795;
     constexpr float TWO_PI = static_cast<float>(TWO_PI_D);
@@ -38,11 +39,6 @@ namespace {
     ALWAYS_INLINE T flushDenorm(T v) noexcept {
         return DSPUtils::flushDenorm(v);
     }
-    
-    // Optimized circular buffer indexing (no modulo)
-    ALWAYS_INLINE size_t wrapIndex(size_t idx, size_t bufferSize) noexcept {
-        return idx >= bufferSize ? idx - bufferSize : idx;
-    }
 }
 
 // Thread-safe parameter smoother
@@ -181,20 +177,12 @@ struct PhasedVocoder::Impl {
     std::unique_ptr<AtomicSmoother> pitchShiftSmoother;
     std::unique_ptr<AtomicSmoother> mixSmoother;
     
-    // Per-channel processing state
+    // Framing, windows and overlap-add for every channel
+    StftProcessor stft;
+    int overlap{StftProcessor::overlapForQuality(EngineBase::Quality::Ultra)};
+    
+    // Per-channel spectral state (framing lives in stft)
     struct alignas(32) ChannelState {
-        // Pre-allocated circular buffers (no dynamic allocation)
-        static constexpr size_t BUFFER_SIZE = FFT_SIZE * 8;  // Larger for safety
-        alignas(32) std::array<float, BUFFER_SIZE> inputBuffer{};
-        alignas(32) std::array<float, BUFFER_SIZE> outputBuffer{};
-        alignas(32) std::array<float, BUFFER_SIZE> normBuffer{};  // NEW: normalization buffer
-        alignas(32) std::array<float, FFT_SIZE> grainBuffer{};
-        
-        // FFT workspace (JUCE uses interleaved real/imag format)
-        alignas(32) std::array<float, FFT_SIZE * 2> fftRI{};  // [Re0, Im0, Re1, Im1, ...]
-        alignas(32) std::array<float, FFT_SIZE * 2> savedRI{}; // For STFT identity test
-        alignas(32) std::array<float, FFT_SIZE> window{};
-        
         // Spectral data (double precision for phase accumulation)
         alignas(32) std::array<float, FFT_SIZE/2 + 1> magnitude{};
         alignas(32) std::array<double, FFT_SIZE/2 + 1> phase{};
@@ -209,43 +197,27 @@ struct PhasedVocoder::Impl {
         alignas(32) std::array<double, FFT_SIZE/2 + 1> freezePhase{};
         std::atomic<bool> isFrozen{false};
         
-        // Position tracking
-        size_t inputWritePos{0};
-        size_t outputWritePos{0};
-        size_t outputReadPos{0};
-        int accumulated{0};  // samples accumulated for next hop
-        int latency{FFT_SIZE};
-        size_t warmupSamples{0};  // Priming counter
-        
         // Transient detection
         TransientDetector transientDetector;
         
         // Denormal flush counter
         int denormFlushCounter{0};
         
-        // FFT scaling detection
-        float invIFFTRoundtrip{1.0f};  // 1 / (forward*inverse scale)
-        
         // Crossfade state
         CrossfadeState freezeCrossfade;
         
         // Silence detection
         SilenceDetector silenceDetector;
-        
-        juce::dsp::FFT fft{FFT_ORDER};
     };
     
     std::vector<std::unique_ptr<ChannelState>> channelStates;
     double sampleRate{44100.0};
-    float invFFTSize{1.0f / FFT_SIZE};
-    float windowSum{0.0f};
     
-    // Processing methods
-    void processFrame(ChannelState& state) noexcept;
-    void analyzeFrame(ChannelState& state) noexcept;
-    void synthesizeFrame(ChannelState& state) noexcept;
+    // Processing methods: the spectral kernel run by stft on each frame
+    void processFrame(ChannelState& state, std::complex<float>* bins) noexcept;
+    void analyzeFrame(ChannelState& state, const std::complex<float>* bins) noexcept;
+    void synthesizeFrame(ChannelState& state, std::complex<float>* bins) noexcept;
     void applySpectralProcessing(ChannelState& state) noexcept;
-    void initializeWindow(std::array<float, FFT_SIZE>& window) noexcept;
     void flushAllDenormals(ChannelState& state) noexcept;
 };
 
@@ -256,7 +228,6 @@ PhasedVocoder::~PhasedVocoder() = default;
 // Public interface implementation
 void PhasedVocoder::prepareToPlay(double sampleRate, int samplesPerBlock) {
     pimpl->sampleRate = sampleRate;
-    pimpl->invFFTSize = 1.0f / FFT_SIZE;
     
     // Initialize parameter smoothers
     pimpl->timeStretchSmoother = std::make_unique<AtomicSmoother>(
@@ -272,124 +243,35 @@ void PhasedVocoder::prepareToPlay(double sampleRate, int samplesPerBlock) {
         pimpl->channelStates.push_back(std::make_unique<Impl::ChannelState>());
     }
     
-    // Initialize windows and calculate normalization
-    pimpl->windowSum = 0.0f;
+    pimpl->stft.prepare(static_cast<int>(pimpl->channelStates.size()), FFT_ORDER, pimpl->overlap);
+    
     for (auto& statePtr : pimpl->channelStates) {
-        pimpl->initializeWindow(statePtr->window);
-        
-        // Calculate proper window sum for overlap-add normalization
-        // For Hann window with 75% overlap (4x), the overlapping windows should sum to ~1.5
-        pimpl->windowSum = 0.0f;
-        for (int offset = 0; offset < HOP_SIZE; ++offset) {
-            float sum = 0.0f;
-            for (int frame = 0; frame < OVERLAP; ++frame) {
-                int idx = offset + frame * HOP_SIZE;
-                if (idx < FFT_SIZE) {
-                    sum += statePtr->window[idx];
-                }
-            }
-            if (sum > pimpl->windowSum) {
-                pimpl->windowSum = sum; // Use peak overlap sum
-            }
-        }
-        
-        // For Hann window with 75% overlap, this should be ~1.5
-        // If calculation is off, use the theoretical value
-        if (pimpl->windowSum < 1.0f || pimpl->windowSum > 2.0f) {
-            pimpl->windowSum = 1.5f; // Theoretical value for Hann with 75% overlap
-        }
-        
-        // Clear all buffers
-        std::fill(statePtr->inputBuffer.begin(), statePtr->inputBuffer.end(), 0.0f);
-        std::fill(statePtr->outputBuffer.begin(), statePtr->outputBuffer.end(), 0.0f);
-        std::fill(statePtr->normBuffer.begin(), statePtr->normBuffer.end(), 0.0f);
-        std::fill(statePtr->lastPhase.begin(), statePtr->lastPhase.end(), 0.0);
-        std::fill(statePtr->synthPhase.begin(), statePtr->synthPhase.end(), 0.0);
-        std::fill(statePtr->instFreq.begin(), statePtr->instFreq.end(), 0.0);
-        
         // Initialize omega (bin frequencies in radians/sample)
         for (int k = 0; k <= FFT_SIZE/2; ++k) {
             statePtr->omega[k] = 2.0 * M_PI * k / FFT_SIZE;
         }
         
-        
-        // Auto-detect FFT round-trip scaling
-        {
-            // Impulse in time domain -> FFT -> IFFT -> measure y[0]
-            std::vector<float> tmp(2 * FFT_SIZE, 0.0f);   // interleaved re/im
-            tmp[0] = 1.0f;                                 // x[0] = 1, others 0
-
-            statePtr->fft.perform(reinterpret_cast<std::complex<float>*>(tmp.data()),
-                                reinterpret_cast<std::complex<float>*>(tmp.data()), false);
-            statePtr->fft.perform(reinterpret_cast<std::complex<float>*>(tmp.data()),
-                                reinterpret_cast<std::complex<float>*>(tmp.data()), true);
-
-            // After a forward+inverse roundtrip on an impulse, tmp[0] equals the overall scale
-            const float roundtrip = tmp[0];
-            // Guard tiny/NaN
-            statePtr->invIFFTRoundtrip = (std::abs(roundtrip) > 1e-12f) ? (1.0f / roundtrip) : 1.0f;
-            
-        }
-        
-        // Initialize positions with proper write head offset
-        statePtr->outputReadPos = 0;
-        statePtr->latency = FFT_SIZE;  // safe lead
-        statePtr->outputWritePos = (statePtr->outputReadPos + statePtr->latency) % statePtr->outputBuffer.size();
-        statePtr->inputWritePos = 0;
-        statePtr->accumulated = 0;
-        statePtr->firstFrame = true;
-        statePtr->warmupSamples = statePtr->latency + HOP_SIZE;  // Need latency + one hop for proper initialization
-        
-        statePtr->isFrozen = false;
-        statePtr->denormFlushCounter = 0;
-        
         // Initialize transient detector
         const float attack = pimpl->params.transientAttack.load(std::memory_order_relaxed);
         const float release = pimpl->params.transientRelease.load(std::memory_order_relaxed);
         statePtr->transientDetector.prepare(sampleRate, attack, release);
-        
-        statePtr->freezeCrossfade.reset();
-        statePtr->silenceDetector.reset();
     }
+    
+    reset();
 }
 
 void PhasedVocoder::reset() {
+    pimpl->stft.reset();
+    
     for (auto& statePtr : pimpl->channelStates) {
         auto& state = *statePtr;
-        // Zero all audio buffers
-        std::fill(state.inputBuffer.begin(), state.inputBuffer.end(), 0.0f);
-        std::fill(state.outputBuffer.begin(), state.outputBuffer.end(), 0.0f);
-        std::fill(state.normBuffer.begin(), state.normBuffer.end(), 0.0f);
-        std::fill(state.grainBuffer.begin(), state.grainBuffer.end(), 0.0f);
         
         // Reset phase accumulators
         std::fill(state.phase.begin(), state.phase.end(), 0.0);
         std::fill(state.lastPhase.begin(), state.lastPhase.end(), 0.0);
         std::fill(state.synthPhase.begin(), state.synthPhase.end(), 0.0);
         std::fill(state.instFreq.begin(), state.instFreq.end(), 0.0);
-        
-        // Auto-detect FFT round-trip scaling
-        {
-            std::vector<float> tmp(2 * FFT_SIZE, 0.0f);
-            tmp[0] = 1.0f;
-            
-            state.fft.perform(reinterpret_cast<std::complex<float>*>(tmp.data()),
-                            reinterpret_cast<std::complex<float>*>(tmp.data()), false);
-            state.fft.perform(reinterpret_cast<std::complex<float>*>(tmp.data()),
-                            reinterpret_cast<std::complex<float>*>(tmp.data()), true);
-            
-            const float roundtrip = tmp[0];
-            state.invIFFTRoundtrip = (std::abs(roundtrip) > 1e-12f) ? (1.0f / roundtrip) : 1.0f;
-        }
-        
-        // Reset positions with proper write head offset
-        state.outputReadPos = 0;
-        state.latency = FFT_SIZE;  // safe lead
-        state.outputWritePos = (state.outputReadPos + state.latency) % state.outputBuffer.size();
-        state.inputWritePos = 0;
-        state.accumulated = 0;
         state.firstFrame = true;
-        state.warmupSamples = state.latency + HOP_SIZE;  // Need latency + one hop for proper initialization
         
         // Reset detection states
         state.transientDetector.reset();
@@ -448,41 +330,18 @@ void PhasedVocoder::process(juce::AudioBuffer<float>& buffer) {
             state.isFrozen.store(false, std::memory_order_relaxed);
         }
         
-        // Process samples with proper frame scheduling
-        for (int i = 0; i < numSamples; ++i) {
-            // Store input sample in circular buffer
-            state.inputBuffer[state.inputWritePos] = channelData[i];
-            state.inputWritePos = (state.inputWritePos + 1) % state.inputBuffer.size();
+        // Spectral processing a chunk at a time, then mix
+        for (int start = 0; start < numSamples; start += MIX_CHUNK) {
+            const int n = std::min(MIX_CHUNK, numSamples - start);
+            float* data = channelData + start;
             
-            // Trigger every needed frame (use while loop for large blocks)
-            state.accumulated += 1;
-            while (state.accumulated >= HOP_SIZE) {
-                state.accumulated -= HOP_SIZE;
-                pimpl->processFrame(state);
-            }
-            
-            // Read path: consume one sample, no latency math here
-            const size_t readIdx = state.outputReadPos;
-            float y = 0.0f;
+            std::array<float, MIX_CHUNK> wet;
+            pimpl->stft.process(ch, data, wet.data(), n,
+                                [this, &state](std::complex<float>* bins, int) { pimpl->processFrame(state, bins); });
             
-            bool priming = state.warmupSamples > 0;
-            if (!priming) {
-                const float g = state.normBuffer[readIdx];
-                if (g > 1e-9f) {
-                    y = state.outputBuffer[readIdx] / g;
-                }
-                
-            } else {
-                --state.warmupSamples;
+            for (int i = 0; i < n; ++i) {
+                data[i] = flushDenorm(data[i] * (1.0f - smoothMix) + wet[i] * smoothMix);
             }
-            
-            // consume
-            state.outputBuffer[readIdx] = 0.0f;
-            state.normBuffer[readIdx] = 0.0f;
-            state.outputReadPos = (state.outputReadPos + 1) % state.outputBuffer.size();
-            
-            // mix
-            channelData[i] = flushDenorm(channelData[i] * (1.0f - smoothMix) + y * smoothMix);
         }
     }
     
@@ -491,51 +350,23 @@ void PhasedVocoder::process(juce::AudioBuffer<float>& buffer) {
 }
 
 // Implementation methods
-void PhasedVocoder::Impl::processFrame(ChannelState& state) noexcept {
-    // Get smoothed parameters
-    const float smoothTimeStretch = timeStretchSmoother->tick();
-    const float smoothPitchShift = pitchShiftSmoother->tick();
-    
-    // Read analysis frame from the input buffer
-    // Frame ends at current write position minus one
-    const size_t frameEnd = (state.inputWritePos + state.inputBuffer.size() - 1) % state.inputBuffer.size();
-    const size_t frameStart = (frameEnd + state.inputBuffer.size() - FFT_SIZE + 1) % state.inputBuffer.size();
-    
-    // Fill grain buffer with windowed input
-    for (size_t i = 0; i < FFT_SIZE; ++i) {
-        size_t idx = (frameStart + i) % state.inputBuffer.size();
-        state.grainBuffer[i] = state.inputBuffer[idx] * state.window[i];
-    }
-    
+void PhasedVocoder::Impl::processFrame(ChannelState& state, std::complex<float>* bins) noexcept {
     // Process spectral data
-    analyzeFrame(state);
+    analyzeFrame(state, bins);
     applySpectralProcessing(state);
-    synthesizeFrame(state);
+    synthesizeFrame(state, bins);
     
     // Comprehensive denormal flush
     flushAllDenormals(state);
 }
 
-void PhasedVocoder::Impl::analyzeFrame(ChannelState& state) noexcept {
-    // Copy to FFT buffer in JUCE's interleaved format
-    for (size_t i = 0; i < FFT_SIZE; ++i) {
-        state.fftRI[2*i] = state.grainBuffer[i];  // Real part
-        state.fftRI[2*i + 1] = 0.0f;              // Imaginary part
-    }
-    
-    // Forward FFT (JUCE expects complex<float>* but we have interleaved floats)
-    state.fft.perform(reinterpret_cast<std::complex<float>*>(state.fftRI.data()), 
-                      reinterpret_cast<std::complex<float>*>(state.fftRI.data()), false);
-    
-    // Save spectrum for STFT identity test
-    std::memcpy(state.savedRI.data(), state.fftRI.data(), sizeof(float) * 2 * FFT_SIZE);
-    
+void PhasedVocoder::Impl::analyzeFrame(ChannelState& state, const std::complex<float>* bins) noexcept {
     // Extract magnitude and phase with phase vocoder analysis
-    const double Ha = static_cast<double>(HOP_SIZE);
+    const double Ha = static_cast<double>(stft.getHopSize());
     
     for (size_t k = 0; k <= FFT_SIZE/2; ++k) {
-        const float real = state.fftRI[2*k];
-        const float imag = state.fftRI[2*k + 1];
+        const float real = bins[k].real();
+        const float imag = bins[k].imag();
 
         // Magnitude
         state.magnitude[k] = std::sqrt(real * real + imag * imag);
@@ -649,19 +480,23 @@ void PhasedVocoder::Impl::applySpectralProcessing(ChannelState& state) noexcept
     }
 }
 
-void PhasedVocoder::Impl::synthesizeFrame(ChannelState& state) noexcept {
+void PhasedVocoder::Impl::synthesizeFrame(ChannelState& state, std::complex<float>* bins) noexcept {
     const float timeStretch = timeStretchSmoother->tick();
     const float pitchShift = pitchShiftSmoother->tick();
     
-    // Calculate synthesis hop size (H_s) - must be integer rounded and bounded
-    const double Ha = static_cast<double>(HOP_SIZE);
-    double Hs = std::round(HOP_SIZE * timeStretch);
+    // Frames are written one analysis hop apart (a real-time stream can't
+    // drift from its input), so stretch sets how far each bin's phase
+    // advances per frame: as if the synthesis hop were H_s
+    const double Ha = static_cast<double>(stft.getHopSize());
+    double Hs = std::round(Ha * timeStretch);
 
     // CRITICAL FIX: Ensure Hs is always valid (at least 1, max reasonable)
-    Hs = std::max(1.0, std::min(Hs, static_cast<double>(HOP_SIZE * MAX_STRETCH)));
+    Hs = std::max(1.0, std::min(Hs, Ha * MAX_STRETCH));
     
-    // Initialize synthesis phase on first frame
-    if (state.firstFrame) {
+    // Initialize synthesis phase on first frame; it starts from the analysis
+    // phase rather than advancing from it
+    const bool firstFrame = state.firstFrame;
+    if (firstFrame) {
         for (size_t k = 0; k <= FFT_SIZE/2; ++k) {
             state.synthPhase[k] = state.phase[k];
         }
@@ -677,7 +512,9 @@ void PhasedVocoder::Impl::synthesizeFrame(ChannelState& state) noexcept {
         }
 
         // Advance synthesis phase based on instantaneous frequency
-        state.synthPhase[k] += instFreqClamped * Hs * pitchShift;
+        if (!firstFrame) {
+            state.synthPhase[k] += instFreqClamped * Hs * pitchShift;
+        }
 
         // Wrap phase to avoid accumulation overflow
         state.synthPhase[k] = std::remainder(state.synthPhase[k], 2.0 * M_PI);
@@ -689,50 +526,7 @@ void PhasedVocoder::Impl::synthesizeFrame(ChannelState& state) noexcept {
         }
 
         const float ph = static_cast<float>(state.synthPhase[k]);
-        state.fftRI[2*k]     = mag * std::cos(ph);
-        state.fftRI[2*k + 1] = mag * std::sin(ph);
-    }
-
-    // CRITICAL FIX: Proper Hermitian symmetry for real IFFT
-    // Mirror positive frequencies to negative frequencies (conjugate symmetry)
-    // For real signal: X[N-k] = conj(X[k]) for k = 1..N/2-1
-    for (size_t k = 1; k < FFT_SIZE/2; ++k) {
-        state.fftRI[2*(FFT_SIZE - k)]     =  state.fftRI[2*k];       // real part same
-        state.fftRI[2*(FFT_SIZE - k) + 1] = -state.fftRI[2*k + 1];   // imag part negated
-    }
-
-    // CRITICAL FIX: Ensure DC (k=0) and Nyquist (k=N/2) bins are purely real
-    state.fftRI[1] = 0.0f;                      // DC imaginary = 0
-    state.fftRI[2*(FFT_SIZE/2) + 1] = 0.0f;     // Nyquist imaginary = 0
-    
-    // IFFT on fftRI
-    state.fft.perform(reinterpret_cast<std::complex<float>*>(state.fftRI.data()),
-                      reinterpret_cast<std::complex<float>*>(state.fftRI.data()), true);
-    
-    // Scale exactly once according to runtime detection
-    const float postIFFTScale = state.invIFFTRoundtrip;   // replaces 1.0f / FFT_SIZE
-    
-    
-    // OLA (writer head) + normalizer
-    const size_t wBase = state.outputWritePos;
-    for (size_t i = 0; i < FFT_SIZE; ++i) {
-        const size_t idx = (wBase + i) % state.outputBuffer.size();
-        const float  w   = state.window[i];
-        const float  s   = state.fftRI[2*i] * postIFFTScale;  // real part
-        state.outputBuffer[idx] += s * w;
-        state.normBuffer[idx]   += w * w;
-    }
-    
-    // advance writer by synthesis hop (use the same Hs computed at top)
-    state.outputWritePos = (state.outputWritePos + static_cast<size_t>(Hs)) % state.outputBuffer.size();
-}
-
-void PhasedVocoder::Impl::initializeWindow(std::array<float, FFT_SIZE>& window) noexcept {
-    // Hann window with exact normalization
-    constexpr float norm = 1.0f / (FFT_SIZE - 1);
-    
-    for (size_t i = 0; i < FFT_SIZE; ++i) {
-        window[i] = 0.5f * (1.0f - std::cos(TWO_PI * i * norm));
+        bins[k] = std::complex<float>(mag * std::cos(ph), mag * std::sin(ph));
     }
 }
 
@@ -751,6 +545,22 @@ void PhasedVocoder::Impl::flushAllDenormals(ChannelState& state) noexcept {
     }
 }
 
+void PhasedVocoder::setQuality(Quality q) {
+    pimpl->overlap = StftProcessor::overlapForQuality(q);
+    pimpl->stft.setOverlap(pimpl->overlap);
+}
+
+int PhasedVocoder::getLatencySamples() const noexcept {
+    return pimpl->stft.getLatencySamples();
+}
+
+double PhasedVocoder::getTailLengthSeconds() const noexcept {
+    // A held spectrum never decays; otherwise the last frame drains out
+    if (pimpl->params.freeze.load(std::memory_order_relaxed) > 0.5f)
+        return ChimeraConfig::ENGINE_TAIL_MAX_SECONDS;
+    return pimpl->stft.getLatencySamples() / pimpl->sampleRate;
+}
+
 // Parameter updates (thread-safe)
 void PhasedVocoder::updateParameters(const std::map<int, float>& params) {
     for (const auto& [id, value] : params) {
@@ -20,6 +20,9 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override;  // Sets the STFT overlap
+    int getLatencySamples() const noexcept override;
+    double getTailLengthSeconds() const noexcept override;
     
     int getNumParameters() const override { return 10; } // Added attack/release
     juce::String getParameterName(int index) const override;
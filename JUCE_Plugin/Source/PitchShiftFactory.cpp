@@ -1,56 +1,55 @@
 #include "IPitchShiftStrategy.h"
 #include "SMBPitchShiftFixed.h"
 #include "PhaseVocoderPitchShift.h"
+#include "PeakLockedPitchShift.h"
+#include "PsolaPitchShift.h"
 
 std::unique_ptr<IPitchShiftStrategy> PitchShiftFactory::create(Algorithm algo) {
-    // CRITICAL FIX: Use true Phase Vocoder instead of signalsmith-stretch
-    // signalsmith-stretch is a TIME-STRETCHER, not a pitch shifter
-    // This caused the 8.673% THD issue
-    //
-    // Now using proper phase vocoder with 8x overlap for < 0.5% THD
-    return std::make_unique<PhaseVocoderPitchShift>();
-
-    // Old broken version (signalsmith-stretch used incorrectly):
-    // return std::make_unique<SMBPitchShiftFixed>();
-
-    // Future: can add algorithm selection back when we have multiple working implementations
-    /*
     switch (algo) {
-        case Algorithm::Simple:
-        case Algorithm::Signalsmith:
         case Algorithm::PSOLA:
+            return std::make_unique<PsolaPitchShift>();
+
         case Algorithm::PhaseVocoder:
-        case Algorithm::RubberBand:
+            return std::make_unique<PeakLockedPitchShift>();
+
+        case Algorithm::Signalsmith:
+        case Algorithm::RubberBand:  // Not bundled; closest tier
+            return std::make_unique<SMBPitchShiftFixed>();
+
+        case Algorithm::Simple:
         default:
+            // Hop-based resampler the engines used before tiers existed
             return std::make_unique<PhaseVocoderPitchShift>();
     }
-    */
 }
 
 PitchShiftFactory::Algorithm PitchShiftFactory::getBestAvailable() {
-    // For beta, Simple is the best (only) available
-    return Algorithm::Simple;
-    
-    // Future logic:
-    // if (RubberBandAvailable()) return Algorithm::RubberBand;
-    // if (PhaseVocoderAvailable()) return Algorithm::PhaseVocoder;
-    // etc.
+    return Algorithm::Signalsmith;
+}
+
+PitchShiftFactory::Algorithm PitchShiftFactory::forQuality(int tier) {
+    // Draft is the live/tracking setting, so it gets the only tier with
+    // single-digit millisecond latency. Ultra is what offline renders use.
+    switch (tier) {
+        case 0:  return Algorithm::PSOLA;         // ~7 ms
+        case 1:
+        case 2:  return Algorithm::PhaseVocoder;  // ~43 ms
+        default: return Algorithm::Signalsmith;   // ~160 ms
+    }
 }
 
 bool PitchShiftFactory::isAvailable(Algorithm algo) {
     switch (algo) {
         case Algorithm::Simple:
-            return true;  // Always available
-            
         case Algorithm::Signalsmith:
-            return false; // Has latency issues
-            
         case Algorithm::PSOLA:
         case Algorithm::PhaseVocoder:
+            return true;
+
         case Algorithm::RubberBand:
-            return false; // Not implemented yet
-            
+            return false; // Not bundled (licensing); create() substitutes Signalsmith
+
         default:
             return false;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include "IPitchShiftStrategy.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+/**
+ * PitchShiftTiers - One pitch shifter per EngineBase::Quality tier
+ *
+ * Every algorithm PitchShiftFactory::forQuality() hands out is created and
+ * prepared up front, so an engine's setQuality() only switches which one
+ * runs. Tiers that map to the same algorithm share an instance, and idle
+ * instances cost no CPU.
+ *
+ * A switch never cuts over: the outgoing algorithm keeps playing while the
+ * incoming one, reset, fills up to its latency, then the two crossfade over
+ * FADE_SAMPLES. Both run for that long.
+ */
+class PitchShiftTiers {
+public:
+    static constexpr int NUM_TIERS = 4;
+    static constexpr int FADE_SAMPLES = 1024;
+
+    /**
+     * Message thread.
+     * @param maxTier Highest tier this engine may use; tiers above it get its
+     *                algorithm (e.g. when the top tier's latency doesn't fit)
+     */
+    explicit PitchShiftTiers(int maxTier = NUM_TIERS - 1) {
+        std::array<PitchShiftFactory::Algorithm, NUM_TIERS> algorithms{};
+        for (int tier = 0; tier < NUM_TIERS; ++tier) {
+            algorithms[tier] = PitchShiftFactory::forQuality(std::min(tier, maxTier));
+            for (int lower = 0; lower < tier && byTier[tier] == nullptr; ++lower) {
+                if (algorithms[lower] == algorithms[tier]) byTier[tier] = byTier[lower];
+            }
+            if (byTier[tier] == nullptr) {
+                owned[tier] = PitchShiftFactory::create(algorithms[tier]);
+                byTier[tier] = owned[tier].get();
+            }
+        }
+        active = byTier[NUM_TIERS - 1];  // Engines start at Ultra
+        requested = active;
+    }
+
+    // process() takes at most maxBlockSize samples at a time
+    void prepare(double sampleRate, int maxBlockSize) {
+        for (auto& shifter : owned) {
+            if (shifter) shifter->prepare(sampleRate, maxBlockSize);
+        }
+        fadeScratch.assign(static_cast<size_t>(maxBlockSize), 0.0f);
+    }
+
+    // Finishes any switch in progress at once
+    void reset() {
+        for (auto& shifter : owned) {
+            if (shifter) shifter->reset();
+        }
+        active = requested;
+        outgoing = nullptr;
+    }
+
+    /**
+     * Audio thread, between process() calls. Never allocates.
+     * @return true if this asks for a different algorithm. Its latency may
+     *         differ from the previous one's; getLatencySamples() follows as
+     *         soon as the switch starts, which is straight away unless one is
+     *         already in progress.
+     */
+    bool setQuality(int tier) {
+        tier = std::clamp(tier, 0, NUM_TIERS - 1);
+        IPitchShiftStrategy* next = byTier[tier];
+        next->setQuality(tier);
+        if (next == requested) return false;
+        requested = next;
+        if (outgoing == nullptr) beginSwitch();
+        return true;
+    }
+
+    void process(const float* input, float* output, int numSamples, float pitchRatio) {
+        if (outgoing == nullptr) {
+            active->process(input, output, numSamples, pitchRatio);
+            return;
+        }
+
+        // The outgoing algorithm goes first: output may be the input
+        float* old = fadeScratch.data();
+        outgoing->process(input, old, numSamples, pitchRatio);
+        active->process(input, output, numSamples, pitchRatio);
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = old[i] + (output[i] - old[i]) * getIncomingWeight(i);
+        }
+
+        switchPosition += numSamples;
+        if (switchPosition >= active->getLatencySamples() + FADE_SAMPLES) {
+            outgoing = nullptr;
+            if (requested != active) beginSwitch();
+        }
+    }
+
+    int getLatencySamples() const { return active->getLatencySamples(); }
+
+    // While switching, the outgoing algorithm's latency and the incoming
+    // one's share of the output `offset` samples into the next process() call,
+    // so a caller can crossfade its dry compensation the same way
+    bool isSwitching() const { return outgoing != nullptr; }
+    int getOutgoingLatencySamples() const { return outgoing != nullptr ? outgoing->getLatencySamples() : getLatencySamples(); }
+    float getIncomingWeight(int offset) const {
+        if (outgoing == nullptr) return 1.0f;
+        const int fadePosition = switchPosition + offset - active->getLatencySamples();
+        return std::clamp(static_cast<float>(fadePosition) / FADE_SAMPLES, 0.0f, 1.0f);
+    }
+
+    // Longest latency of any tier, for sizing compensation delays (after prepare)
+    int getMaxLatencySamples() const {
+        int latency = 0;
+        for (auto& shifter : owned) {
+            if (shifter) latency = std::max(latency, shifter->getLatencySamples());
+        }
+        return latency;
+    }
+
+private:
+    void beginSwitch() {
+        outgoing = active;
+        active = requested;
+        active->reset();
+        switchPosition = 0;
+    }
+
+    std::array<PitchShiftPtr, NUM_TIERS> owned;
+    std::array<IPitchShiftStrategy*, NUM_TIERS> byTier{};
+    IPitchShiftStrategy* active = nullptr;
+    IPitchShiftStrategy* outgoing = nullptr;  // Still audible while the switch fades
+    IPitchShiftStrategy* requested = nullptr;
+    int switchPosition = 0;  // Samples since `active` was reset
+    std::vector<float> fadeScratch;
+};
@@ -10,11 +10,6 @@ PitchShifter::PitchShifter() {
     control2Param.set(0.5f);   // Neutral position
     control3Param.set(0.5f);   // 50% mix for unity gain
     
-    // Create pitch shifters immediately (beta uses Simple)
-    for (auto& shifter : pitchShifters) {
-        shifter = PitchShiftFactory::create(PitchShiftFactory::Algorithm::Simple);
-    }
-    
     reset();
 }
 
@@ -24,15 +19,27 @@ void PitchShifter::prepareToPlay(double sr, int samplesPerBlock) {
     sampleRate = sr;
     currentBlockSize = samplesPerBlock;
     
-    // Initialize pitch shifters if not already created
-    for (int i = 0; i < 2; ++i) {
-        if (!pitchShifters[i]) {
-            pitchShifters[i] = PitchShiftFactory::create(PitchShiftFactory::Algorithm::Simple);
-        }
-        pitchShifters[i]->prepare(sampleRate, samplesPerBlock);
-        // Don't reset here - that would clear the buffer!
+    // Prepare every quality tier so setQuality() never allocates
+    for (auto& shifter : pitchShifters) {
+        shifter.prepare(sampleRate, samplesPerBlock);
     }
     
+    int delaySize = 1;
+    while (delaySize < pitchShifters[0].getMaxLatencySamples() + samplesPerBlock) delaySize <<= 1;
+    for (auto& delay : dryDelay) {
+        delay.assign(static_cast<size_t>(delaySize), 0.0f);
+    }
+    dryDelayMask = delaySize - 1;
+    dryScratch.assign(static_cast<size_t>(samplesPerBlock), 0.0f);
+    wetScratch.assign(static_cast<size_t>(samplesPerBlock), 0.0f);
+    
+    // Mode buffers scale with the sample rate. The selected mode's (and any
+    // used before) are allocated now, the rest when their mode is first used.
+    const Mode selectedMode = getCurrentMode(modeParam.target);
+    glitchProcessor.prepare(sampleRate, selectedMode == MODE_GLITCH);
+    alienProcessor.prepareSpiral(sampleRate, selectedMode == MODE_ALIEN);
+    pendingModeBuffers.store(0);
+    
     // Set appropriate smoothing speeds
     modeParam.setSmoothingSpeed(0.05f);     // Fast for mode switches
     control1Param.setSmoothingSpeed(0.01f); // Smooth for audio
@@ -49,8 +56,12 @@ void PitchShifter::reset() {
     alienProcessor.lfoPhase = 0.0f;
     
     for (auto& shifter : pitchShifters) {
-        if (shifter) shifter->reset();
+        shifter.reset();
+    }
+    for (auto& delay : dryDelay) {
+        std::fill(delay.begin(), delay.end(), 0.0f);
     }
+    dryDelayWritePos = 0;
     
     for (auto& detector : transientDetectors) {
         detector.envelope = 0.0f;
@@ -58,24 +69,62 @@ void PitchShifter::reset() {
 }
 
 void PitchShifter::process(juce::AudioBuffer<float>& buffer) {
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
     const int numSamples = buffer.getNumSamples();
     
+    // Scratch buffers hold one prepared block; split anything longer
+    if (numSamples > static_cast<int>(dryScratch.size())) {
+        const int chunkSize = static_cast<int>(dryScratch.size());
+        for (int start = 0; chunkSize > 0 && start < numSamples; start += chunkSize) {
+            juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(), numChannels,
+                                           start, juce::jmin(chunkSize, numSamples - start));
+            process(chunk);
+        }
+        return;
+    }
+    
     // Get smoothed parameters
     float modeValue = modeParam.tick();
     float control1 = control1Param.tick();
     float control2 = control2Param.tick();
     float control3 = control3Param.tick();
     
-    // Determine current mode
+    // Determine current mode. The shifters sit idle in Glitch mode, so
+    // coming back they start clean rather than from stale audio.
+    const Mode previousMode = currentMode;
     currentMode = getCurrentMode(modeValue);
+    requestModeBuffers(currentMode);
+    if (previousMode == MODE_GLITCH && currentMode != MODE_GLITCH) {
+        for (auto& shifter : pitchShifters) {
+            shifter.reset();
+        }
+    }
     
     // Process each channel
     for (int ch = 0; ch < numChannels; ++ch) {
         float* channelData = buffer.getWritePointer(ch);
         
-        // Store dry signal for mixing
-        std::vector<float> dry(channelData, channelData + numSamples);
+        // Store dry signal for mixing, delayed to line up with the shifter.
+        // While the shifter crossfades to another tier's algorithm the dry
+        // tap crossfades between the two latencies with it.
+        auto& delay = dryDelay[ch];
+        const auto& shifter = pitchShifters[ch];
+        const int latency = shifter.getLatencySamples();
+        for (int i = 0; i < numSamples; ++i) {
+            delay[(dryDelayWritePos + i) & dryDelayMask] = channelData[i];
+        }
+        float* dry = dryScratch.data();
+        for (int i = 0; i < numSamples; ++i) {
+            dry[i] = delay[(dryDelayWritePos + i - latency) & dryDelayMask];
+        }
+        if (shifter.isSwitching()) {
+            const int oldLatency = shifter.getOutgoingLatencySamples();
+            for (int i = 0; i < numSamples; ++i) {
+                const float old = delay[(dryDelayWritePos + i - oldLatency) & dryDelayMask];
+                dry[i] = old + (dry[i] - old) * shifter.getIncomingWeight(i);
+            }
+        }
+        float* wet = wetScratch.data();
         
         // Mode-specific processing
         switch (currentMode) {
@@ -90,30 +139,18 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer) {
                 bool needsProcessing = (std::abs(pitchRatio - 1.0f) > 0.001f || 
                                        std::abs(formantRatio - 1.0f) > 0.001f);
                 
+                // TEMPORARY: Just test with formant ratio to see if pitch shifting works
+                // TODO: Implement proper formant-preserving pitch shift
+                float effectiveRatio = formantRatio;
+                
+                // The shifter runs even at unity so its latency never changes
+                pitchShifters[ch].process(channelData, wet, numSamples, effectiveRatio);
                 
                 if (needsProcessing) {
-                    // Apply pitch/formant shifting using SMBPitchShift
-                    // TEMPORARY: Just test with formant ratio to see if pitch shifting works
-                    // TODO: Implement proper formant-preserving pitch shift
-                    float effectiveRatio = formantRatio;
-                    
-                    // Apply pitch shifting using SMBPitchShift
-                    std::vector<float> tempOutput(numSamples);
-                    
-                    if (pitchShifters[ch]) {
-                        // Process the entire block at once
-                        pitchShifters[ch]->process(channelData, tempOutput.data(), numSamples, effectiveRatio);
-                    } else {
-                        // Pitch shifter is null! Just copy input
-                        for (int i = 0; i < numSamples; ++i) {
-                            tempOutput[i] = channelData[i];
-                        }
-                    }
-                    
                     // Apply formant compensation
                     float compensation = genderProcessor.calculateCompensation(formantRatio);
                     for (int i = 0; i < numSamples; ++i) {
-                        channelData[i] = tempOutput[i] * compensation;
+                        channelData[i] = wet[i] * compensation;
                     }
                     
                     // Mix with dry (control3 is intensity in Gender mode)
@@ -155,17 +192,9 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer) {
                 
                 alienProcessor.process(formantRatio, pitchRatio, control1, control2, control3, sampleRate);
                 
-                // Apply alien transformation
-                if (std::abs(pitchRatio - 1.0f) > 0.001f || std::abs(formantRatio - 1.0f) > 0.001f) {
-                    // Use the actual pitch ratio for alien voices
-                    float effectiveRatio = pitchRatio;
-                    
-                    std::vector<float> tempOutput(numSamples);
-                    if (pitchShifters[ch]) {
-                        pitchShifters[ch]->process(channelData, tempOutput.data(), numSamples, effectiveRatio);
-                    }
-                    std::copy(tempOutput.begin(), tempOutput.end(), channelData);
-                }
+                // Apply alien transformation, using the actual pitch ratio for
+                // alien voices (run at unity too, as in Gender mode)
+                pitchShifters[ch].process(channelData, channelData, numSamples, pitchRatio);
                 
                 // Apply spiral feedback if dimension > 0
                 if (control3 > 0.1f) {
@@ -189,6 +218,64 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer) {
             }
         }
     }
+    
+    dryDelayWritePos = (dryDelayWritePos + numSamples) & dryDelayMask;
+}
+
+void PitchShifter::setQuality(Quality q) {
+    // Draft is PSOLA (~7 ms), Normal/High the phase vocoder, Ultra Signalsmith
+    for (auto& shifter : pitchShifters) {
+        shifter.setQuality(static_cast<int>(q));
+    }
+}
+
+int PitchShifter::getLatencySamples() const noexcept {
+    return currentMode == MODE_GLITCH ? 0 : pitchShifters[0].getLatencySamples();
+}
+
+double PitchShifter::getTailLengthSeconds() const noexcept {
+    switch (currentMode) {
+        case MODE_GLITCH:
+            // Slices replay up to a slice old; a frozen one repeats while held
+            return control3Param.target > 0.5f ? ChimeraConfig::ENGINE_TAIL_MAX_SECONDS
+                                               : GlitchProcessor::MAX_SLICE_SECONDS;
+        case MODE_ALIEN:
+            // The spiral recirculates at half the dimension amount
+            return getLatencySamples() / sampleRate
+                 + getFeedbackTailSeconds(AlienProcessor::SPIRAL_SECONDS, 0.5 * control3Param.target);
+        case MODE_GENDER:
+            break;
+    }
+    return getLatencySamples() / sampleRate;
+}
+
+bool PitchShifter::hasModeBuffers(Mode mode) const noexcept {
+    switch (mode) {
+        case MODE_GLITCH: return glitchProcessor.buffers[0].isAllocated() && glitchProcessor.buffers[1].isAllocated();
+        case MODE_ALIEN:  return alienProcessor.spiralBuffers[0].isAllocated() && alienProcessor.spiralBuffers[1].isAllocated();
+        default:          return true;
+    }
+}
+
+void PitchShifter::requestModeBuffers(Mode mode) noexcept {
+    if (!hasModeBuffers(mode)) {
+        pendingModeBuffers.fetch_or(1u << mode);
+    }
+}
+
+bool PitchShifter::needsDeferredAllocation() const noexcept {
+    return pendingModeBuffers.load() != 0;
+}
+
+void PitchShifter::performDeferredAllocation() {
+    const uint32_t pending = pendingModeBuffers.load();
+    if (pending & (1u << MODE_GLITCH)) {
+        for (auto& buffer : glitchProcessor.buffers) buffer.allocate();
+    }
+    if (pending & (1u << MODE_ALIEN)) {
+        for (auto& buffer : alienProcessor.spiralBuffers) buffer.allocate();
+    }
+    pendingModeBuffers.fetch_and(~pending);
 }
 
 void PitchShifter::updateParameters(const std::map<int, float>& params) {
@@ -196,6 +283,7 @@ void PitchShifter::updateParameters(const std::map<int, float>& params) {
         switch (index) {
             case kMode: 
                 modeParam.set(value);
+                requestModeBuffers(getCurrentMode(value));
                 DBG("Vocal Destroyer: Mode " << getCurrentMode(value));
                 break;
             case kControl1: 
@@ -362,6 +450,14 @@ float PitchShifter::GenderProcessor::calculateCompensation(float formantRatio) {
     }
 }
 
+void PitchShifter::GlitchProcessor::prepare(double sampleRate, bool allocateNow) {
+    const auto size = static_cast<size_t>(std::ceil(MAX_SLICE_SECONDS * sampleRate));
+    for (auto& buffer : buffers) {
+        buffer.prepare(size, allocateNow);
+    }
+    writePos = 0;
+}
+
 void PitchShifter::GlitchProcessor::updateSliceSize(float control1, double sampleRate) {
     // Map to musical divisions
     float division;
@@ -375,13 +471,17 @@ void PitchShifter::GlitchProcessor::updateSliceSize(float control1, double sampl
     float beatsPerSecond = 120.0f / 60.0f;
     float sliceTime = 1.0f / (beatsPerSecond * division);
     sliceSize = static_cast<int>(sliceTime * sampleRate);
-    sliceSize = std::max(64, std::min(sliceSize, MAX_BUFFER_SIZE / 2));
+    sliceSize = std::max(64, std::min(sliceSize, buffers[0].sizeInt()));
 }
 
 float PitchShifter::GlitchProcessor::process(float input, int channel, float scatter, bool freeze) {
+    float* buffer = buffers[channel].get();
+    if (buffer == nullptr) return input;  // Not allocated yet
+    const int bufferSize = buffers[channel].sizeInt();
+    
     // Write to buffer
     if (!freeze) {
-        buffers[channel][writePos] = input;
+        buffer[writePos] = input;
     }
     
     // Calculate read position with scatter
@@ -389,11 +489,11 @@ float PitchShifter::GlitchProcessor::process(float input, int channel, float sca
     if (scatter > 0.01f && !freeze) {
         // Random jump within slice
         int scatterAmount = static_cast<int>(scatter * sliceSize * 0.5f);
-        readPos = (writePos - (rand() % scatterAmount) + MAX_BUFFER_SIZE) % MAX_BUFFER_SIZE;
+        readPos = (writePos - (rand() % scatterAmount) + bufferSize) % bufferSize;
     }
     
     // Read from buffer (with wrapping)
-    float output = buffers[channel][readPos];
+    float output = buffer[readPos];
     
     // Advance write position
     if (!freeze) {
@@ -409,7 +509,7 @@ float PitchShifter::GlitchProcessor::process(float input, int channel, float sca
 
 void PitchShifter::GlitchProcessor::reset() {
     for (auto& buffer : buffers) {
-        buffer.fill(0.0f);
+        buffer.clear();
     }
     writePos = 0;
     currentSlice = 0;
@@ -463,11 +563,22 @@ void PitchShifter::AlienProcessor::process(float& formantRatio, float& pitchRati
     dimension = control3;
 }
 
+void PitchShifter::AlienProcessor::prepareSpiral(double sampleRate, bool allocateNow) {
+    const auto size = static_cast<size_t>(std::round(SPIRAL_SECONDS * sampleRate));
+    for (auto& buffer : spiralBuffers) {
+        buffer.prepare(size, allocateNow);
+    }
+    spiralPos = {0, 0};
+}
+
 float PitchShifter::AlienProcessor::processSpiral(float input, int channel) {
+    float* buffer = spiralBuffers[channel].get();
+    if (buffer == nullptr) return input;  // Not allocated yet
+    
     // Simple feedback delay for dimensional warping
-    float delayed = spiralBuffers[channel][spiralPos[channel]];
-    spiralBuffers[channel][spiralPos[channel]] = input + delayed * 0.5f * dimension;
-    spiralPos[channel] = (spiralPos[channel] + 1) % spiralBuffers[channel].size();
+    float delayed = buffer[spiralPos[channel]];
+    buffer[spiralPos[channel]] = input + delayed * 0.5f * dimension;
+    spiralPos[channel] = (spiralPos[channel] + 1) % spiralBuffers[channel].sizeInt();
     
     return input + delayed * dimension;
 }
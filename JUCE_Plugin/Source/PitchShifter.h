@@ -1,7 +1,9 @@
 #pragma once
 #include "EngineBase.h"
-#include "IPitchShiftStrategy.h"  // Use strategy pattern for flexibility
+#include "PitchShiftTiers.h"  // Use strategy pattern for flexibility
+#include "DeferredBuffer.h"
 #include <memory>
+#include <vector>
 #include <array>
 #include <atomic>
 #include <random>
@@ -32,6 +34,14 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override;  // Picks the pitch shift algorithm
+    int getLatencySamples() const noexcept override;  // Active algorithm's, 0 in Glitch mode
+    bool qualityChangesLatency() const noexcept override { return true; }
+    double getTailLengthSeconds() const noexcept override;
+    
+    // Glitch slices and the Alien spiral are allocated on first use
+    bool needsDeferredAllocation() const noexcept override;
+    void performDeferredAllocation() override;
     
     int getNumParameters() const override { return 4; } // Mode + 3 controls
     juce::String getParameterName(int index) const override;
@@ -57,7 +67,14 @@ public:
     
 private:
     // Core processing - using strategy pattern for pitch shifting
-    std::array<std::unique_ptr<IPitchShiftStrategy>, 2> pitchShifters;  // One per channel
+    std::array<PitchShiftTiers, 2> pitchShifters;  // One per channel
+    
+    // Dry signal delayed by the shifter's latency so the mixes line up
+    std::array<std::vector<float>, 2> dryDelay;
+    int dryDelayMask = 0;
+    int dryDelayWritePos = 0;
+    std::vector<float> dryScratch;
+    std::vector<float> wetScratch;
     
     // Current mode
     Mode currentMode = MODE_GENDER;
@@ -112,8 +129,9 @@ private:
     
     // --- MODE 2: GLITCH MACHINE ---
     struct GlitchProcessor {
-        static constexpr int MAX_BUFFER_SIZE = 48000; // 1 second at 48kHz
-        std::array<std::array<float, MAX_BUFFER_SIZE>, 2> buffers;
+        // The longest slice, a half note at 120 BPM
+        static constexpr double MAX_SLICE_SECONDS = 0.25;
+        std::array<DeferredBuffer, 2> buffers;
         int writePos = 0;
         int sliceSize = 4800; // 100ms default
         int currentSlice = 0;
@@ -124,6 +142,7 @@ private:
         float crossfadePos = 1.0f;
         std::array<float, 512> crossfadeBuffer;
         
+        void prepare(double sampleRate, bool allocateNow);
         void updateSliceSize(float control1, double sampleRate);
         float process(float input, int channel, float scatter, bool freeze);
         void reset();
@@ -143,7 +162,8 @@ private:
         std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
         
         // Feedback spiral buffer
-        std::array<std::array<float, 4800>, 2> spiralBuffers;
+        static constexpr double SPIRAL_SECONDS = 0.1;
+        std::array<DeferredBuffer, 2> spiralBuffers;
         std::array<int, 2> spiralPos{0, 0};
         float spiralFeedback = 0.0f;
         float pitchAccumulation = 1.0f;
@@ -151,10 +171,16 @@ private:
         void process(float& formantRatio, float& pitchRatio, 
                     float control1, float control2, float control3,
                     double sampleRate);
+        void prepareSpiral(double sampleRate, bool allocateNow);
         float processSpiral(float input, int channel);
     };
     AlienProcessor alienProcessor;
     
+    // Bit per Mode whose buffers were asked for but are not allocated yet
+    std::atomic<uint32_t> pendingModeBuffers{0};
+    bool hasModeBuffers(Mode mode) const noexcept;
+    void requestModeBuffers(Mode mode) noexcept;
+    
     // Transient detection for smarter processing
     struct TransientDetector {
         float envelope = 0.0f;
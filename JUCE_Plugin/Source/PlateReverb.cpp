@@ -3,14 +3,14 @@
 // Integrated into EngineBase framework for Chimera Phoenix
 
 #include "PlateReverb.h"
+#include "FreeverbCore.h"
+#include "ResetHorizon.h"
 #include <JuceHeader.h>
 #include <cmath>
 #include <algorithm>
 
 // Freeverb constants - these are the magic numbers that make it work
 namespace {
-    const int numCombs = 8;
-    const int numAllpasses = 4;
     const float muted = 0.0f;
     const float fixedGain = 0.015f;
     const float scaleDamp = 0.4f;
@@ -24,130 +24,19 @@ namespace {
     const float initialMode = 0.0f;
     const float freezeMode = 0.5f;
     const int stereoSpread = 23;
-    
-    // These values are tuned for 44100Hz - will be scaled for other rates
-    const int combTuningL[8] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
-    const int combTuningR[8] = { 1116+stereoSpread, 1188+stereoSpread, 1277+stereoSpread, 
-                                  1356+stereoSpread, 1422+stereoSpread, 1491+stereoSpread, 
-                                  1557+stereoSpread, 1617+stereoSpread };
-    const int allpassTuningL[4] = { 556, 441, 341, 225 };
-    const int allpassTuningR[4] = { 556+stereoSpread, 441+stereoSpread, 
-                                     341+stereoSpread, 225+stereoSpread };
 }
 
-// Freeverb Comb filter implementation
-class Comb {
-public:
-    Comb() : bufferSize(0), bufferIndex(0), filterStore(0.0f) {}
-    
-    void setBuffer(float *buf, int size) {
-        buffer = buf;
-        bufferSize = size;
-        bufferIndex = 0;
-    }
-    
-    void mute() {
-        if (buffer) {
-            std::fill(buffer, buffer + bufferSize, 0.0f);
-        }
-        filterStore = 0.0f;
-    }
-    
-    void setDamp(float val) {
-        damp1 = val;
-        damp2 = 1.0f - val;
-    }
-    
-    void setFeedback(float val) {
-        feedback = val;
-    }
-    
-    float process(float input) {
-        if (!buffer || bufferSize == 0) return 0.0f;
-        
-        float output = buffer[bufferIndex];
-        filterStore = (output * damp2) + (filterStore * damp1);
-        buffer[bufferIndex] = input + (filterStore * feedback);
-        
-        if (++bufferIndex >= bufferSize) {
-            bufferIndex = 0;
-        }
-        
-        return output;
-    }
-    
-private:
-    float *buffer = nullptr;
-    int bufferSize;
-    int bufferIndex;
-    float filterStore;
-    float damp1 = 0.0f;
-    float damp2 = 1.0f;
-    float feedback = 0.0f;
-};
-
-// Freeverb Allpass filter implementation
-class Allpass {
-public:
-    Allpass() : bufferSize(0), bufferIndex(0) {}
-    
-    void setBuffer(float *buf, int size) {
-        buffer = buf;
-        bufferSize = size;
-        bufferIndex = 0;
-    }
-    
-    void mute() {
-        if (buffer) {
-            std::fill(buffer, buffer + bufferSize, 0.0f);
-        }
-    }
-    
-    void setFeedback(float val) {
-        feedback = val;
-    }
-    
-    float process(float input) {
-        if (!buffer || bufferSize == 0) return 0.0f;
-        
-        float output;
-        float bufout = buffer[bufferIndex];
-        
-        output = -input + bufout;
-        buffer[bufferIndex] = input + (bufout * feedback);
-        
-        if (++bufferIndex >= bufferSize) {
-            bufferIndex = 0;
-        }
-        
-        return output;
-    }
-    
-private:
-    float *buffer = nullptr;
-    int bufferSize;
-    int bufferIndex;
-    float feedback = 0.5f;
-};
-
 // Main implementation class encapsulating Freeverb
 class PlateReverb::Impl {
 public:
-    // Freeverb components
-    Comb combL[numCombs];
-    Comb combR[numCombs];
-    Allpass allpassL[numAllpasses];
-    Allpass allpassR[numAllpasses];
-    
-    // Buffers for delay lines
-    std::vector<float> combBufferL[numCombs];
-    std::vector<float> combBufferR[numCombs];
-    std::vector<float> allpassBufferL[numAllpasses];
-    std::vector<float> allpassBufferR[numAllpasses];
+    // Freeverb combs and allpasses, both channels
+    FreeverbCore tank;
     
-    // Pre-delay
-    std::vector<float> predelayBufferL;
-    std::vector<float> predelayBufferR;
+    // Pre-delay, from the engine's arena
+    float* predelayBufferL = nullptr;
+    float* predelayBufferR = nullptr;
+    int predelayCapacity = 0;
+    ResetHorizon predelayHorizon;
     int predelayIndex = 0;
     int predelaySize = 0;
     
@@ -182,42 +71,18 @@ public:
     
     double sampleRate = 44100.0;
     
-    void init(double sr) {
+    void init(double sr, EngineArena& arena) {
         sampleRate = sr;
+        arena.rewind();
         
-        // Calculate scaling factor for sample rate
-        float srScale = static_cast<float>(sr / 44100.0);
-        
-        // Initialize comb filters
-        for (int i = 0; i < numCombs; i++) {
-            int sizeL = static_cast<int>(combTuningL[i] * srScale);
-            int sizeR = static_cast<int>(combTuningR[i] * srScale);
-            
-            combBufferL[i].resize(sizeL);
-            combBufferR[i].resize(sizeR);
-            
-            combL[i].setBuffer(combBufferL[i].data(), sizeL);
-            combR[i].setBuffer(combBufferR[i].data(), sizeR);
-        }
-        
-        // Initialize allpass filters
-        for (int i = 0; i < numAllpasses; i++) {
-            int sizeL = static_cast<int>(allpassTuningL[i] * srScale);
-            int sizeR = static_cast<int>(allpassTuningR[i] * srScale);
-            
-            allpassBufferL[i].resize(sizeL);
-            allpassBufferR[i].resize(sizeR);
-            
-            allpassL[i].setBuffer(allpassBufferL[i].data(), sizeL);
-            allpassR[i].setBuffer(allpassBufferR[i].data(), sizeR);
-            allpassL[i].setFeedback(0.5f);
-            allpassR[i].setFeedback(0.5f);
-        }
+        // Delay lines scaled from their 44.1 kHz tunings
+        tank.prepare(sr, stereoSpread, arena);
         
         // Initialize predelay
-        int maxPredelay = static_cast<int>(0.2f * sr); // 200ms max
-        predelayBufferL.resize(maxPredelay);
-        predelayBufferR.resize(maxPredelay);
+        predelayCapacity = juce::jmax(1, static_cast<int>(0.2f * sr)); // 200ms max
+        predelayBufferL = arena.allocate<float>(static_cast<size_t>(predelayCapacity));
+        predelayBufferR = arena.allocate<float>(static_cast<size_t>(predelayCapacity));
+        predelayHorizon.prepare(static_cast<size_t>(predelayCapacity));
         
         // Set initial parameters
         updateInternalParameters();
@@ -226,19 +91,10 @@ public:
     
     void reset() {
         // Clear all delay lines
-        for (int i = 0; i < numCombs; i++) {
-            combL[i].mute();
-            combR[i].mute();
-        }
-        
-        for (int i = 0; i < numAllpasses; i++) {
-            allpassL[i].mute();
-            allpassR[i].mute();
-        }
+        tank.reset();
         
-        // Clear predelay
-        std::fill(predelayBufferL.begin(), predelayBufferL.end(), 0.0f);
-        std::fill(predelayBufferR.begin(), predelayBufferR.end(), 0.0f);
+        // Clear predelay (lazily, see ResetHorizon)
+        predelayHorizon.reset();
         predelayIndex = 0;
         
         // Reset filter states
@@ -264,12 +120,11 @@ public:
         }
         
         // Update comb filters
-        for (int i = 0; i < numCombs; i++) {
-            combL[i].setFeedback(roomSize);
-            combR[i].setFeedback(roomSize);
-            combL[i].setDamp(damping);
-            combR[i].setDamp(damping);
-        }
+        tank.setCombFeedback(roomSize);
+        tank.setDamping(damping);
+        
+        // Diffusion maps to allpass feedback, 0.3 to 0.7
+        tank.setAllpassFeedback(0.3f + diffusionParam * 0.4f);
         
         // Width parameter affects stereo spread
         width = widthParam;
@@ -306,37 +161,27 @@ public:
                 // Write current input to buffer first
                 predelayBufferL[predelayIndex] = inputL;
                 predelayBufferR[predelayIndex] = inputR;
+                predelayHorizon.advance();
 
                 // Calculate read index (predelaySize samples ago, wrapped)
                 int readIndex = predelayIndex - predelaySize;
                 if (readIndex < 0) {
-                    readIndex += static_cast<int>(predelayBufferL.size());
+                    readIndex += predelayCapacity;
                 }
 
-                // Read delayed signal
-                delayedL = predelayBufferL[readIndex];
-                delayedR = predelayBufferR[readIndex];
+                // Read delayed signal; silence if written before the last reset
+                const bool fresh = predelayHorizon.isFresh(static_cast<size_t>(predelaySize));
+                delayedL = fresh ? predelayBufferL[readIndex] : 0.0f;
+                delayedR = fresh ? predelayBufferR[readIndex] : 0.0f;
 
-                if (++predelayIndex >= static_cast<int>(predelayBufferL.size())) {
+                if (++predelayIndex >= predelayCapacity) {
                     predelayIndex = 0;
                 }
             }
             
-            // The Freeverb algorithm - feed input to all comb filters in parallel
-            float outL = 0.0f;
-            float outR = 0.0f;
-            
-            // Accumulate comb filters in parallel
-            for (int j = 0; j < numCombs; j++) {
-                outL += combL[j].process(delayedL);
-                outR += combR[j].process(delayedR);
-            }
-            
-            // Feed through allpasses in series
-            for (int j = 0; j < numAllpasses; j++) {
-                outL = allpassL[j].process(outL);
-                outR = allpassR[j].process(outR);
-            }
+            // The Freeverb algorithm - combs in parallel, then allpasses in series
+            float outL, outR;
+            tank.processSample(delayedL, delayedR, outL, outR);
             
             // Apply gain correction
             outL *= gain;
@@ -374,6 +219,16 @@ public:
         }
     }
     
+    double getTailLengthSeconds() const {
+        if (freezeParam > 0.5f) {
+            return ChimeraConfig::ENGINE_TAIL_MAX_SECONDS;
+        }
+        // Comb tunings are in samples at 44.1 kHz and scale with the rate
+        const double longestComb = (FreeverbCore::COMB_TUNING[FreeverbCore::NUM_COMBS - 1] + stereoSpread) / 44100.0;
+        const double feedback = sizeParam * scaleRoom + offsetRoom;
+        return predelayParam * 0.1 + getFeedbackTailSeconds(longestComb, feedback);
+    }
+    
     void setParameter(int index, float value) {
         value = std::clamp(value, 0.0f, 1.0f);
 
@@ -390,15 +245,6 @@ public:
             case 9: diffusionParam = value; break; // Maps to allpass feedback
         }
         
-        // Update allpass feedback for diffusion parameter
-        if (index == 9) {
-            float feedback = 0.3f + diffusionParam * 0.4f; // 0.3 to 0.7
-            for (int i = 0; i < numAllpasses; i++) {
-                allpassL[i].setFeedback(feedback);
-                allpassR[i].setFeedback(feedback);
-            }
-        }
-        
         updateInternalParameters();
     }
 };
@@ -408,7 +254,7 @@ PlateReverb::PlateReverb() : pImpl(std::make_unique<Impl>()) {}
 PlateReverb::~PlateReverb() = default;
 
 void PlateReverb::prepareToPlay(double sampleRate, int samplesPerBlock) {
-    pImpl->init(sampleRate);
+    pImpl->init(sampleRate, m_arena);
 }
 
 void PlateReverb::process(juce::AudioBuffer<float>& buffer) {
@@ -449,4 +295,8 @@ int PlateReverb::getNumParameters() const {
 
 juce::String PlateReverb::getName() const {
     return "Plate Reverb";
+}
+
+double PlateReverb::getTailLengthSeconds() const noexcept {
+    return pImpl->getTailLengthSeconds();
 }
\ No newline at end of file
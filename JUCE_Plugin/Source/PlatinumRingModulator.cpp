@@ -141,7 +141,7 @@ void PlatinumRingModulator::process(juce::AudioBuffer<float>& buffer) {
             // Optional pitch-tracking: mix carrier to target detected frequency
             float hz = carrierHz;
             if (usePitchTrack_ && trackMix > 1e-4f) {
-                const float detected = C.yin.detectPush(x, sr_, C.yinDecim++);
+                const float detected = C.yin.push(x);
                 hz = juce::jmap(trackMix, 0.0f, 1.0f, carrierHz, detected);
                 hz = clampFinite(hz, 20.0f, float(sr_*0.45));
             }
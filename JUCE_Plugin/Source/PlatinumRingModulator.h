@@ -1,6 +1,7 @@
 // PlatinumRingModulator.h — hardened, RT-safe rewrite (APVTS unchanged)
 #pragma once
 #include "EngineBase.h"
+#include "YinPitchTracker.h"
 #include <JuceHeader.h>
 #include <array>
 #include <atomic>
@@ -27,6 +28,13 @@ public:
     void updateParameters(const std::map<int, float>& params) override;
 
     juce::String getName() const override { return "Platinum Ring Modulator"; }
+
+    // 10 ms feedback loop (soft-clipped at 0.63 of the feedback amount) plus
+    // the single 50 ms shimmer echo
+    double getTailLengthSeconds() const noexcept override {
+        const float feedback = p_feedback.target.load(std::memory_order_relaxed);
+        return getFeedbackTailSeconds(0.010, feedback * 0.63f) + 0.050;
+    }
     int getNumParameters() const override { return 12; }
     juce::String getParameterName(int index) const override;
 
@@ -151,70 +159,6 @@ private:
         void reset() { std::fill(z.begin(), z.end(), 0.0f); w=0; }
     };
 
-    // ---------- Lightweight YIN (bounded, decimated, safe) ----------
-    struct Yin {
-        static constexpr int BUF = 1024;
-        static constexpr int HALF = BUF/2;
-        static constexpr float THRESH = 0.15f;
-
-        std::array<float,BUF> x{}; int wp{0};
-        float lastHz{440.0f};
-        int filled{0};
-
-        void reset() { x.fill(0.0f); wp=0; lastHz=440.0f; filled=0; }
-
-        // run every k samples (decimation) not per sample
-        float detectPush(float s, double sr, int decimCounter) noexcept {
-            x[wp] = flushDenorm(s);
-            if (++wp == BUF) wp = 0;
-            if (filled < BUF) { ++filled; return lastHz; }
-            // do YIN only sporadically to bound CPU
-            if ((decimCounter & 31) != 0) return lastHz;
-
-            // difference
-            std::array<float,HALF> d{};
-            for (int tau=0; tau<HALF; ++tau) {
-                float sum=0.0f;
-                // cap inner loop, aligned to HALF
-                for (int i=0;i<HALF;++i) {
-                    int a = (wp - i); if (a<0) a+=BUF;
-                    int b = (wp - i - tau); if (b<0) b+=BUF;
-                    const float diff = x[a]-x[b];
-                    sum += diff*diff;
-                }
-                d[tau] = sum;
-            }
-            // cumulative mean normalize
-            float cum=0.0f;
-            std::array<float,HALF> yin{};
-            yin[0] = 1.0f;
-            for (int tau=1; tau<HALF; ++tau) {
-                cum += d[tau];
-                const float v = (cum <= 1e-20f ? 1.0f : d[tau] * (float)tau / cum);
-                yin[tau] = v;
-            }
-            // absolute threshold
-            int best=-1;
-            for (int tau=2; tau<HALF; ++tau) {
-                if (yin[tau] < THRESH) { best=tau; break; }
-            }
-            if (best < 0) return lastHz;
-
-            // parabolic refine
-            if (best <= 1 || best >= HALF-2) {
-                lastHz = clampFinite(float(sr / best), 20.0f, 20000.0f);
-                return lastHz;
-            }
-            const float s0 = yin[best-1], s1 = yin[best], s2 = yin[best+1];
-            const float denom = (s0 + s2 - 2.0f*s1);
-            const float shift = (std::abs(denom) > 1e-12f) ? 0.5f*(s0 - s2)/denom : 0.0f;
-            const float tauR = float(best) + clampFinite(shift, -1.0f, 1.0f);
-            const float hz = clampFinite(float(sr / std::max(1.0f, tauR)), 20.0f, 20000.0f);
-            lastHz = hz;
-            return lastHz;
-        }
-    };
-
     // ---------- Simple state-variable bandpass (stable) ----------
     struct SVF {
         float g{0}, k{0.5f};
@@ -240,21 +184,20 @@ private:
     // ---------- Per-channel state ----------
     struct Channel {
         HilbertFIR hilb;
-        Yin yin;
+        YinPitchTracker yin;  // carrier pitch tracking, analysed every hop
         SVF svf;
         std::array<float,8192> fbDelay{}; // feedback
         int fbW{0};
         std::array<float,8192> shim{}; // shimmer delay
         int shW{0};
         float dcX{0}, dcY{0};
-        int yinDecim{0};
 
-        void prepare(double /*sr*/) { hilb.prepare(); reset(); }
+        void prepare(double sr) { hilb.prepare(); yin.prepare(sr); reset(); }
         void reset() {
             hilb.reset(); yin.reset(); svf.reset();
             std::fill(fbDelay.begin(), fbDelay.end(), 0.0f); fbW=0;
             std::fill(shim.begin(), shim.end(), 0.0f); shW=0;
-            dcX=dcY=0; yinDecim=0;
+            dcX=dcY=0;
         }
         ALWAYS_INLINE float dcBlock(float x) noexcept {
             // y[n] = x[n] - x[n-1] + R*y[n-1]
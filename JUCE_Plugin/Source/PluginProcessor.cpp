@@ -234,30 +234,50 @@ ChimeraAudioProcessor::ChimeraAudioProcessor()
         }
     }
     
+    // Resolve raw parameter pointers before any engine is loaded
+    resolveParameterPointers();
+    
+    // Classic serial chain until the user or a saved state says otherwise
+    m_pendingRouting = SlotRoutingGraph::serial(NUM_SLOTS);
+    m_activeRouting = m_pendingRouting;
+    m_parallelProcessingEnabled.store(m_slotConfig.enableParallelProcessing);
+    for (auto& quality : m_slotQuality) {
+        quality.store(static_cast<int>(EngineBase::Quality::Ultra));
+    }
+    m_slotIdle.fill(SlotIdleState{});
+    for (auto& sleeping : m_slotSleeping) {
+        sleeping.store(false);
+    }
+    
+    // Periodic text dump of the per-slot timings, for production diagnosis
+    // without a profiler
+    const auto statsDumpPath = juce::SystemStats::getEnvironmentVariable("CHIMERA_STATS_DUMP", {});
+    if (statsDumpPath.isNotEmpty() && juce::File::isAbsolutePath(statsDumpPath)) {
+        m_telemetryDumper = std::make_unique<TelemetryDumper>(m_telemetry, juce::File(statsDumpPath));
+    }
+    
     // Initialize all slots with null engines (no processing)
     DBG("Initializing " + juce::String(NUM_SLOTS) + " slots with null engines");
     for (int i = 0; i < NUM_SLOTS; ++i) {
         DBG("Setting null engine for slot " + juce::String(i));
         m_activeEngines[i] = nullptr;  // Start with null engines (bypassed/empty slots)
+        m_publishedEngines[i].store(nullptr);
         // This is intentional - slots start empty and engines are loaded on demand
         m_slotActivityLevels[i].store(0.0f);  // Initialize activity levels
     }
     
     // Add parameter change listeners for all slots
+    // Knob values are not listened to: processBlock reads them directly each
+    // block, so automation never calls back into the engine from another thread
     for (int i = 1; i <= NUM_SLOTS; ++i) {
         // Listen for engine changes
         parameters.addParameterListener("slot" + juce::String(i) + "_engine", this);
-        
-        // Listen for parameter changes (15 params per slot)
-        for (int j = 1; j <= 15; ++j) {
-            parameters.addParameterListener("slot" + juce::String(i) + "_param" + juce::String(j), this);
-        }
     }
     
     // Initialize engines based on current parameter values
     // This is needed when the plugin is first loaded (not from saved state)
     for (int slot = 0; slot < NUM_SLOTS; ++slot) {
-        auto* engineParam = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_engine");
+        auto* engineParam = m_slotParams[slot].engine;
         if (engineParam) {
             int choiceIndex = static_cast<int>(engineParam->load());
             DBG("Constructor - Slot " + juce::String(slot) + " has engine choice index " + juce::String(choiceIndex));
@@ -276,7 +296,29 @@ ChimeraAudioProcessor::ChimeraAudioProcessor()
     // startAIServer();
 }
 
+void ChimeraAudioProcessor::resolveParameterPointers() {
+    for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+        const juce::String slotPrefix = "slot" + juce::String(slot + 1);
+        auto& ptrs = m_slotParams[slot];
+        
+        for (int i = 0; i < NUM_PARAMS_PER_SLOT; ++i) {
+            ptrs.params[i] = parameters.getRawParameterValue(slotPrefix + "_param" + juce::String(i + 1));
+            jassert(ptrs.params[i] != nullptr);
+            m_slotParamSnapshots[slot].values[i] = ptrs.params[i] != nullptr ? ptrs.params[i]->load() : 0.5f;
+        }
+        
+        ptrs.engine = parameters.getRawParameterValue(slotPrefix + "_engine");
+        ptrs.bypass = parameters.getRawParameterValue(slotPrefix + "_bypass");
+        ptrs.mix    = parameters.getRawParameterValue(slotPrefix + "_mix");
+        ptrs.solo   = parameters.getRawParameterValue(slotPrefix + "_solo");
+        jassert(ptrs.engine != nullptr && ptrs.bypass != nullptr
+                && ptrs.mix != nullptr && ptrs.solo != nullptr);
+    }
+}
+
 ChimeraAudioProcessor::~ChimeraAudioProcessor() {
+    cancelPendingUpdate();
+    
     // Remove parameter listeners for all slots
     for (int i = 1; i <= NUM_SLOTS; ++i) {
         parameters.removeParameterListener("slot" + juce::String(i) + "_engine", this);
@@ -291,43 +333,63 @@ void ChimeraAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     m_sampleRate = sampleRate;
     m_samplesPerBlock = samplesPerBlock;
     
-    // Debug: Log to file to see what's happening
-    FILE* f = fopen("/tmp/opto_debug.txt", "a");
-    if (f) {
-        fprintf(f, "=== ChimeraAudioProcessor::prepareToPlay called ===\n");
-        fprintf(f, "sampleRate=%.1f samplesPerBlock=%d\n", sampleRate, samplesPerBlock);
-        fclose(f);
+    // Preallocate the scratch buffers so processBlock never allocates
+    const int numScratchChannels = juce::jmax(2, getTotalNumInputChannels(), getTotalNumOutputChannels());
+    for (int i = 0; i < NUM_SLOTS; ++i) {
+        m_slotWetBuffers[i].setSize(numScratchChannels, juce::jmax(1, samplesPerBlock), false, true, false);
+        m_slotTailBuffers[i].setSize(numScratchChannels, juce::jmax(1, samplesPerBlock), false, true, false);
+    }
+    for (auto& branchBuffer : m_branchBuffers) {
+        branchBuffer.setSize(numScratchChannels, juce::jmax(1, samplesPerBlock), false, true, false);
+    }
+    
+    m_telemetry.prepare(sampleRate, samplesPerBlock);
+    m_cpuGovernor.reset();
+    m_outputStage.prepare(sampleRate, numScratchChannels);
+    for (auto& quality : m_slotQuality) {
+        quality.store(static_cast<int>(EngineBase::Quality::Ultra));
+    }
+    
+    // Audio is stopped here, so this is the one place the pool may be created.
+    // One worker per extra branch at most - more would only ever spin.
+    if (m_parallelProcessingEnabled.load() && m_workerPool == nullptr) {
+        const int numWorkers = juce::jmin(NUM_SLOTS - 1, juce::SystemStats::getNumCpus() - 1);
+        if (numWorkers > 0) {
+            m_workerPool = std::make_unique<RealtimeWorkerPool>(numWorkers, sampleRate, samplesPerBlock);
+            DBG("Started " + juce::String(numWorkers) + " real-time worker threads");
+        }
+    }
+    
+    // Outgoing engines were prepared for the old settings - drop any tails
+    for (int i = 0; i < NUM_SLOTS; ++i) {
+        m_slotTransitions[i].outgoing.store(nullptr);
+        m_slotTransitions[i].current = nullptr;
     }
     
     int maxLatency = 0;
     int engineCount = 0;
-    for (int i = 0; i < 6; ++i) {
+    for (int i = 0; i < NUM_SLOTS; ++i) {
         if (m_activeEngines[i]) {
             engineCount++;
             DBG("Calling prepareToPlay on engine in slot " + juce::String(i) + 
                 ": " + m_activeEngines[i]->getName());
             
-            FILE* f2 = fopen("/tmp/opto_debug.txt", "a");
-            if (f2) {
-                fprintf(f2, "Slot %d has engine: %s\n", i, 
-                    m_activeEngines[i]->getName().toRawUTF8());
-                fclose(f2);
-            }
-            
             m_activeEngines[i]->prepareToPlay(sampleRate, samplesPerBlock);
             maxLatency = std::max(maxLatency, m_activeEngines[i]->getLatencySamples());
-        } else {
-            FILE* f3 = fopen("/tmp/opto_debug.txt", "a");
-            if (f3) {
-                fprintf(f3, "Slot %d is empty\n", i);
-                fclose(f3);
-            }
         }
     }
     
+    // Re-preparing may have put the engines' parameters back to defaults;
+    // resend everything on the next block
+    m_paramEngines.fill(nullptr);
+    m_resendAllParameters.store(false);
+    
     DBG("Total engines prepared: " + juce::String(engineCount));
     
-    // Report latency to host
+    // Report latency to host; the output limiter sits after every slot
+    if (m_truePeakLimiterEnabled.load()) {
+        maxLatency += m_outputStage.getLimiterLatencySamples();
+    }
     setLatencySamples(maxLatency);
     
     // Run diagnostic on first load (only once)
@@ -356,6 +418,8 @@ void ChimeraAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
 }
 
 void ChimeraAudioProcessor::releaseResources() {
+    // Audio is stopped - destroy anything the reclaimer is still holding
+    m_engineReclaimer.reclaimNow();
 }
 
 bool ChimeraAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
@@ -373,6 +437,10 @@ void ChimeraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                         juce::MidiBuffer& midiMessages) {
     juce::ScopedNoDenormals noDenormals;
     
+    // Marks this thread as inside a block so retired engines outlive it
+    AudioEpoch::ScopedBlock epochGuard(m_audioEpoch);
+    const auto blockStartCycles = m_telemetry.beginBlock();
+    
     // Validate buffer size to prevent crashes
     const int numSamples = buffer.getNumSamples();
     if (numSamples <= 0 || numSamples > 8192) {
@@ -382,167 +450,359 @@ void ChimeraAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     }
     
     // Capture input level for metering
-    float inputLevel = buffer.getMagnitude(0, numSamples);
-    m_currentInputLevel.store(inputLevel);
+    const auto inputLevels = MasterOutputStage::measure(buffer, numSamples);
+    m_currentInputLevel.store(inputLevels.peak);
+    m_currentInputRms.store(inputLevels.rms);
+    
+    const int numChannels = buffer.getNumChannels();
+    
+    // Only grows (and therefore allocates) if the host exceeds the block size
+    // it announced in prepareToPlay; the normal path reuses existing storage
+    for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+        m_slotWetBuffers[slot].setSize(numChannels, numSamples, false, false, true);
+        m_slotTailBuffers[slot].setSize(numChannels, numSamples, false, false, true);
+    }
+    
+    // Pick up a new routing graph if the message thread is not mid-write
+    if (m_routingChanged.load()) {
+        const juce::SpinLock::ScopedTryLockType routingLock(m_routingLock);
+        if (routingLock.isLocked()) {
+            m_activeRouting = m_pendingRouting;
+            m_routingChanged.store(false);
+        }
+    }
+    
+    // A restored state resends every parameter, even to an engine that
+    // happens to reuse a previous engine's address
+    if (m_resendAllParameters.exchange(false)) {
+        m_paramEngines.fill(nullptr);
+    }
     
     // Check if any slot is soloed
     bool anySoloed = false;
     for (int slot = 0; slot < NUM_SLOTS; ++slot) {
-        bool isSoloed = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_solo")->load() > 0.5f;
-        if (isSoloed) {
+        if (m_slotParams[slot].solo->load() > 0.5f) {
             anySoloed = true;
             break;
         }
     }
     
-    // Keep a copy of the dry signal for mixing
-    juce::AudioBuffer<float> dryBuffer(buffer.getNumChannels(), numSamples);
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
-        dryBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
-    }
+    m_blockNumSamples = numSamples;
+    m_blockAnySoloed = anySoloed;
+    m_blockIsOffline = isNonRealtime();
+    m_slotProcessed.fill(false);
+    m_slotTransitionTicks.fill(0);
     
-    // Process through each slot in series
+    // Slots missing from the graph are not processed: nothing to ring out into
+    const uint32_t routedSlots = m_activeRouting.getSlotMask();
     for (int slot = 0; slot < NUM_SLOTS; ++slot) {
-        bool isBypassed = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_bypass")->load() > 0.5f;
-        bool isSoloed = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_solo")->load() > 0.5f;
-        float mixLevel = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_mix")->load();
-        
-        // Skip if bypassed or if soloing is active and this isn't soloed
-        if (isBypassed || (anySoloed && !isSoloed)) {
-            m_slotActivityLevels[slot].store(0.0f);
-            continue;
-        }
-        
-        {
-            // Get parameters for this slot
-            std::map<int, float> params;
-            juce::String slotPrefix = "slot" + juce::String(slot + 1) + "_param";
-            for (int i = 0; i < 15; ++i) {
-                auto paramID = slotPrefix + juce::String(i + 1);
-                float value = parameters.getRawParameterValue(paramID)->load();
-                params[i] = value;
-            }
-            
-            // Thread-safe engine access for both parameter update and processing
-            {
-                std::lock_guard<std::mutex> lock(m_engineMutex);
-                if (m_activeEngines[slot]) {
-                    // Check if this is the None engine (ID == 0)
-                    auto* engineParam = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_engine");
-                    int engineChoice = static_cast<int>(engineParam->load());
-                    
-                    // Skip None engines (engine ID 0)
-                    if (engineChoice == 0) {
-                        continue;
-                    }
-                    
-                    // Debug: Log parameters being sent (only for slot 1 and engine 1)
-                    if (slot == 0 && engineChoice == 1) {
-                        static int debugCounter = 0;
-                        if (++debugCounter % 100 == 0) {
-                            DBG("Slot 1 params: [0]=" + juce::String(params[0]) + 
-                                " [1]=" + juce::String(params[1]) + 
-                                " [4]=" + juce::String(params[4]));
-                            
-                            // DEBUG: Log that we're about to call process
-                            FILE* f = fopen("/tmp/process_chain.txt", "a");
-                            if (f) {
-                                fprintf(f, "About to call process on engine %p in slot %d\n",
-                                    (void*)m_activeEngines[slot].get(), slot);
-                                fclose(f);
-                            }
-                        }
-                    }
-                    
-                    // Keep a copy of the signal before processing for wet/dry mix
-                    juce::AudioBuffer<float> wetBuffer(buffer.getNumChannels(), numSamples);
-                    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
-                        wetBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
-                    }
-                    
-                    // Capture pre-process level for activity monitoring
-                    float preLevel = wetBuffer.getMagnitude(0, numSamples);
-                    
-                    // Update parameters and process the wet buffer
-                    m_activeEngines[slot]->updateParameters(params);
-                    m_activeEngines[slot]->process(wetBuffer);
-                    
-                    // Apply mix control: blend dry and wet signals
-                    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
-                        auto* bufferData = buffer.getWritePointer(ch);
-                        auto* wetData = wetBuffer.getReadPointer(ch);
-                        
-                        for (int s = 0; s < numSamples; ++s) {
-                            // Mix = 0: fully dry, Mix = 1: fully wet
-                            bufferData[s] = bufferData[s] * (1.0f - mixLevel) + wetData[s] * mixLevel;
-                        }
-                    }
-                    
-                    // Calculate activity based on difference
-                    float postLevel = wetBuffer.getMagnitude(0, numSamples);
-                    float activity = std::abs(postLevel - preLevel);
-                    m_slotActivityLevels[slot].store(activity);
-                }
+        m_slotActivityLevels[slot].store(0.0f);
+        if ((routedSlots & (1u << slot)) == 0) {
+            if (auto* outgoing = m_slotTransitions[slot].outgoing.load()) {
+                releaseSlotTransition(slot, outgoing);
             }
         }
     }
     
-    // Apply gentle gain compensation once at the end to prevent buildup
-    // Only apply if any processing occurred
+    for (int s = 0; s < m_activeRouting.numStages; ++s) {
+        processStage(m_activeRouting.stages[s], buffer);
+    }
+    
     bool anyProcessingOccurred = false;
+    juce::int64 transitionTicks = 0;
     for (int slot = 0; slot < NUM_SLOTS; ++slot) {
-        bool isBypassed = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_bypass")->load() > 0.5f;
-        auto* engineParam = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_engine");
-        int engineChoice = static_cast<int>(engineParam->load());
-        
-        if (!isBypassed && m_activeEngines[slot] && engineChoice != 0) {
-            anyProcessingOccurred = true;
-            break;
+        anyProcessingOccurred = anyProcessingOccurred || m_slotProcessed[slot];
+        transitionTicks += m_slotTransitionTicks[slot];
+    }
+    
+    // Overlap cost as a fraction of this block's deadline
+    const double blockTicks = numSamples / m_sampleRate * static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    m_transitionCpuLoad.store(static_cast<float>(transitionTicks / juce::jmax(1.0, blockTicks)));
+    
+    // Gentle gain compensation (only if any processing occurred) to prevent
+    // buildup, then soft clip or true-peak limit, metering the result - all in
+    // one pass
+    const float compensationGain = anyProcessingOccurred ? 0.99f : 1.0f;
+    const auto output = m_outputStage.process(buffer, numSamples, compensationGain,
+                                              m_truePeakLimiterEnabled.load());
+    m_currentOutputRms.store(output.output.rms);
+    m_outputGainReductionDb.store(-juce::Decibels::gainToDecibels(output.minGain));
+    
+    // Update the atomic level (only if it's higher than current)
+    if (output.output.peak > m_currentOutputLevel.load()) {
+        m_currentOutputLevel.store(output.output.peak);
+    }
+    
+    if (const auto* snapshot = m_telemetry.endBlock(blockStartCycles, numSamples)) {
+        for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+            m_cpuGovernor.setSlotPinned(slot, m_slotPinned[slot]);
+        }
+        m_cpuGovernor.update(*snapshot, m_blockIsOffline, m_cpuGovernorEnabled.load());
+        for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+            m_slotQuality[slot].store(static_cast<int>(m_cpuGovernor.getTier(slot)));
         }
     }
+}
+
+void ChimeraAudioProcessor::processStage(const SlotRoutingGraph::Stage& stage,
+                                         juce::AudioBuffer<float>& buffer) {
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
     
-    if (anyProcessingOccurred) {
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
-            auto* data = buffer.getWritePointer(ch);
-            for (int s = 0; s < buffer.getNumSamples(); ++s) {
-                data[s] *= 0.99f; // Minimal gain reduction (1% max)
-            }
+    // Serial stage at unity gain - process in place, exactly the classic chain
+    if (!stage.isParallel() && stage.branches[0].gain == 1.0f) {
+        const auto& branch = stage.branches[0];
+        for (int i = 0; i < branch.numSlots; ++i) {
+            processSlot(branch.slots[i], buffer);
         }
+        return;
     }
     
-    // Apply output limiting to prevent clipping and distortion
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
-        auto* channelData = buffer.getWritePointer(channel);
-        
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
-            float& sampleValue = channelData[sample];
-            
-            // Soft clipping to prevent harsh distortion
-            if (std::abs(sampleValue) > 0.98f) {
-                sampleValue = std::tanh(sampleValue * 0.7f) * 1.3f;
-            }
-            
-            // Hard limit at -0.2dB to prevent digital clipping
-            sampleValue = juce::jlimit(-0.98f, 0.98f, sampleValue);
+    // Split: every branch gets its own copy of the stage input
+    for (int b = 0; b < stage.numBranches; ++b) {
+        auto& branchBuffer = m_branchBuffers[b];
+        branchBuffer.setSize(numChannels, numSamples, false, false, true);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            branchBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        }
+    }
+    
+    // Branches are independent, so they can run on any core. The audio thread
+    // takes part and returns once every branch has finished.
+    m_currentStage = &stage;
+    if (m_workerPool != nullptr && m_parallelProcessingEnabled.load()) {
+        m_workerPool->run(&ChimeraAudioProcessor::runBranchTask, this, stage.numBranches);
+    } else {
+        for (int b = 0; b < stage.numBranches; ++b) {
+            processBranch(b);
+        }
+    }
+    m_currentStage = nullptr;
+    
+    // Merge
+    buffer.clear();
+    for (int b = 0; b < stage.numBranches; ++b) {
+        const float gain = stage.branches[b].gain;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            buffer.addFrom(ch, 0, m_branchBuffers[b], ch, 0, numSamples, gain);
+        }
+    }
+}
+
+void ChimeraAudioProcessor::runBranchTask(void* processor, int branchIndex) {
+    static_cast<ChimeraAudioProcessor*>(processor)->processBranch(branchIndex);
+}
+
+void ChimeraAudioProcessor::processBranch(int branchIndex) {
+    // Worker threads start with the default FP mode
+    juce::ScopedNoDenormals noDenormals;
+    
+    const auto& branch = m_currentStage->branches[branchIndex];
+    for (int i = 0; i < branch.numSlots; ++i) {
+        processSlot(branch.slots[i], m_branchBuffers[branchIndex]);
+    }
+}
+
+bool ChimeraAudioProcessor::processSlot(int slot, juce::AudioBuffer<float>& buffer) {
+    const int numSamples = m_blockNumSamples;
+    const int numChannels = buffer.getNumChannels();
+    auto& wetBuffer = m_slotWetBuffers[slot];
+    
+    const auto& slotParams = m_slotParams[slot];
+    bool isBypassed = slotParams.bypass->load() > 0.5f;
+    bool isSoloed = slotParams.solo->load() > 0.5f;
+    float mixLevel = slotParams.mix->load();
+    
+    // Lock-free engine access - the pointers stay valid until this block ends.
+    // Load order matters: publishEngine stores `outgoing` before the new engine.
+    auto* engine = m_publishedEngines[slot].load();
+    auto* outgoing = m_slotTransitions[slot].outgoing.load();
+    if (outgoing == engine) {
+        outgoing = nullptr;  // Caught a publish in flight - the fade starts next block
+    }
+    
+    // Skip if bypassed or if soloing is active and this isn't soloed
+    if (isBypassed || (m_blockAnySoloed && !isSoloed)) {
+        if (outgoing != nullptr) {
+            releaseSlotTransition(slot, outgoing);  // Nothing audible to ring out into
         }
+        return false;
     }
     
-    // Calculate output level for metering (after limiting)
-    float maxLevel = 0.0f;
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
-        auto* channelData = buffer.getReadPointer(channel);
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
-            float absValue = std::abs(channelData[sample]);
-            if (absValue > maxLevel) {
-                maxLevel = absValue;
+    // None engines (engine ID 0) pass audio through untouched
+    if (static_cast<int>(slotParams.engine->load()) == 0) {
+        engine = nullptr;
+    }
+    
+    if (engine == nullptr && outgoing == nullptr) {
+        m_slotTailSeconds[slot].store(0.0f);
+        return false;
+    }
+    
+    // Idle slots sleep: once the input has been silent for longer than the
+    // engine's tail and its output has died away, the engine is no longer
+    // called. Its state is left at rest, so the first block with signal
+    // simply resumes processing - there is nothing to fade back in.
+    static const float silenceThreshold = juce::Decibels::decibelsToGain(ChimeraConfig::ENGINE_SLEEP_SILENCE_DB);
+    auto& idle = m_slotIdle[slot];
+    if (idle.engine != engine || outgoing != nullptr) {
+        idle = SlotIdleState{};
+        idle.engine = engine;
+        m_slotSleeping[slot].store(false);
+    }
+    const bool inputSilent = buffer.getMagnitude(0, numSamples) < silenceThreshold;
+    if (idle.asleep) {
+        if (inputSilent) {
+            m_slotActivityLevels[slot].store(0.0f);
+            return false;
+        }
+        idle.asleep = false;
+        idle.silentInputSamples = 0;
+        idle.quietOutputSamples = 0;
+        m_slotSleeping[slot].store(false);
+    }
+    
+    // Offline renders bypass the governor so bounces never lose quality, and
+    // live tracking pins realtime blocks to Draft. Engines whose latency
+    // follows the tier otherwise stay at Ultra; checking the engine here
+    // rather than at the governor's next publish means a newly published
+    // engine gets its slot's tier before it first runs.
+    m_slotPinned[slot] = engine != nullptr && engine->qualityChangesLatency();
+    const auto quality = m_blockIsOffline ? EngineBase::Quality::Ultra
+                       : m_liveTrackingEnabled.load() ? EngineBase::Quality::Draft
+                       : m_slotPinned[slot] ? EngineBase::Quality::Ultra
+                       : m_cpuGovernor.getTier(slot);
+    if (engine != nullptr && (engine != m_qualityEngines[slot] || quality != m_appliedQuality[slot])) {
+        engine->setQuality(quality);
+        m_qualityEngines[slot] = engine;
+        m_appliedQuality[slot] = quality;
+    }
+    
+    // Deliver parameters only when a knob moved or the engine is new
+    auto& params = m_slotParamSnapshots[slot];
+    params.dirtyMask = 0;
+    if (engine != nullptr) {
+        for (int i = 0; i < NUM_PARAMS_PER_SLOT; ++i) {
+            const float value = slotParams.params[i]->load();
+            if (value != params.values[i]) {
+                params.values[i] = value;
+                params.dirtyMask |= 1u << i;
             }
         }
+        if (engine != m_paramEngines[slot]) {
+            params.dirtyMask = EngineBase::ParameterSnapshot::ALL_DIRTY;
+            m_paramEngines[slot] = engine;
+        }
+        if (params.dirtyMask != 0) {
+            ++params.version;
+        }
     }
     
-    // Update the atomic level (only if it's higher than current)
-    float currentLevel = m_currentOutputLevel.load();
-    if (maxLevel > currentLevel) {
-        m_currentOutputLevel.store(maxLevel);
+    // Keep a copy of the signal before processing for wet/dry mix
+    for (int ch = 0; ch < numChannels; ++ch) {
+        wetBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+    }
+    
+    // Capture pre-process level for activity monitoring
+    float preLevel = wetBuffer.getMagnitude(0, numSamples);
+    
+    // Outgoing engine: input fades out over the crossfade window, its
+    // output (including any tail) is kept and summed below
+    float incomingGainStart = 1.0f, incomingGainEnd = 1.0f;
+    const auto outgoingStartCycles = CycleClock::now();
+    if (outgoing != nullptr) {
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        renderOutgoingEngine(slot, outgoing, buffer, numSamples, incomingGainStart, incomingGainEnd);
+        m_slotTransitionTicks[slot] += juce::Time::getHighResolutionTicks() - startTicks;
+    }
+    
+    // Update parameters and process the wet buffer. The outgoing engine's
+    // render is charged to the slot's process time.
+    const auto updateStartCycles = CycleClock::now();
+    if (engine != nullptr && params.dirtyMask != 0) {
+        engine->updateParameterSnapshot(params);
+    }
+    const auto processStartCycles = CycleClock::now();
+    if (engine != nullptr) {
+        engine->process(wetBuffer);
+    }
+    const auto processEndCycles = CycleClock::now();
+    
+    // A tier or parameter change can move the engine's latency (pitch
+    // shifters switching algorithm); the host hears about it asynchronously
+    if (engine != nullptr) {
+        const int latency = engine->getLatencySamples();
+        if (latency != m_observedLatency[slot]) {
+            m_observedLatency[slot] = latency;
+            triggerAsyncUpdate();
+        }
+
+        // Likewise a mode switch that needs buffers the engine has not
+        // allocated yet; asked once per request
+        const bool needsAllocation = engine->needsDeferredAllocation();
+        if (needsAllocation && !m_deferredAllocationRequested[slot]) {
+            triggerAsyncUpdate();
+        }
+        m_deferredAllocationRequested[slot] = needsAllocation;
+    }
+    m_telemetry.recordSlot(slot, processStartCycles - updateStartCycles,
+                           (processEndCycles - processStartCycles) + (updateStartCycles - outgoingStartCycles));
+    m_slotProcessed[slot] = true;
+    
+    if (outgoing != nullptr) {
+        const auto& tailBuffer = m_slotTailBuffers[slot];
+        for (int ch = 0; ch < numChannels; ++ch) {
+            wetBuffer.applyGainRamp(ch, 0, numSamples, incomingGainStart, incomingGainEnd);
+            wetBuffer.addFrom(ch, 0, tailBuffer, ch, 0, numSamples);
+        }
+    }
+    
+    // Apply mix control: blend dry and wet signals
+    // Mix = 0: fully dry, Mix = 1: fully wet
+    for (int ch = 0; ch < numChannels; ++ch) {
+        auto* bufferData = buffer.getWritePointer(ch);
+        const auto* wetData = wetBuffer.getReadPointer(ch);
+        
+        if (mixLevel >= 1.0f) {
+            juce::FloatVectorOperations::copy(bufferData, wetData, numSamples);
+        } else {
+            juce::FloatVectorOperations::multiply(bufferData, 1.0f - mixLevel, numSamples);
+            juce::FloatVectorOperations::addWithMultiply(bufferData, wetData, mixLevel, numSamples);
+        }
+    }
+    
+    // Calculate activity based on difference
+    float postLevel = wetBuffer.getMagnitude(0, numSamples);
+    float activity = std::abs(postLevel - preLevel);
+    m_slotActivityLevels[slot].store(activity);
+    
+    if (engine != nullptr && outgoing == nullptr) {
+        updateSlotIdleState(slot, engine, inputSilent, postLevel, numSamples);
+    }
+    return true;
+}
+
+void ChimeraAudioProcessor::updateSlotIdleState(int slot, EngineBase* engine, bool inputSilent,
+                                                float outputLevel, int numSamples) {
+    static const float tailThreshold = juce::Decibels::decibelsToGain(ChimeraConfig::ENGINE_TAIL_THRESHOLD_DB);
+    const juce::int64 quietLimit = static_cast<juce::int64>(ChimeraConfig::ENGINE_TAIL_QUIET_MS * 0.001 * m_sampleRate);
+    
+    // Tails are re-read every block because they follow the parameters
+    // (delay time, feedback, decay...)
+    const double tailSeconds = engine->getTailLengthSeconds();
+    m_slotTailSeconds[slot].store(static_cast<float>(tailSeconds));
+    const juce::int64 silenceLimit = static_cast<juce::int64>(tailSeconds * m_sampleRate)
+                                   + engine->getLatencySamples() + quietLimit;
+    
+    auto& idle = m_slotIdle[slot];
+    idle.silentInputSamples = inputSilent ? idle.silentInputSamples + numSamples : 0;
+    idle.quietOutputSamples = outputLevel < tailThreshold ? idle.quietOutputSamples + numSamples : 0;
+    
+    // Engines that make sound from silence (generators, frozen spectra,
+    // self-oscillation) never go quiet and so never sleep
+    if (idle.silentInputSamples >= silenceLimit && idle.quietOutputSamples >= quietLimit) {
+        idle.asleep = true;
+        m_slotSleeping[slot].store(true);
     }
 }
 
@@ -590,11 +850,19 @@ void ChimeraAudioProcessor::setStateInformation(const void* data, int sizeInByte
         if (xmlState->hasTagName(parameters.state.getType())) {
             parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
             
+            // Older sessions have no routing property and keep the serial chain
+            SlotRoutingGraph routing = SlotRoutingGraph::serial(NUM_SLOTS);
+            if (parameters.state.hasProperty("routing")
+                && !SlotRoutingGraph::fromString(parameters.state.getProperty("routing").toString(), routing)) {
+                DBG("setStateInformation: ignoring malformed routing graph");
+            }
+            setRoutingGraph(routing);
+            
             // CRITICAL FIX: After loading state, recreate engines based on saved parameters
             // This ensures engines are initialized when the plugin loads from saved state
             DBG("setStateInformation: Recreating engines from saved state");
             for (int slot = 0; slot < NUM_SLOTS; ++slot) {
-                auto* engineParam = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_engine");
+                auto* engineParam = m_slotParams[slot].engine;
                 if (engineParam) {
                     int choiceIndex = static_cast<int>(engineParam->load());
                     int engineID = choiceIndexToEngineID(choiceIndex);
@@ -605,12 +873,22 @@ void ChimeraAudioProcessor::setStateInformation(const void* data, int sizeInByte
                     if (engineID >= 0 && engineID < ENGINE_COUNT) {
                         std::unique_ptr<EngineBase> engine = EngineFactory::createEngine(engineID);
                         if (engine) {
-                            // Store engine (prepareToPlay will be called later by the host)
-                            m_activeEngines[slot] = std::move(engine);
+                            // Prepare with the current settings before publishing: some hosts
+                            // restore state while audio is running. The host's own
+                            // prepareToPlay will re-prepare it if the settings change.
+                            engine->prepareToPlay(m_sampleRate, m_samplesPerBlock);
+                            applyCurrentParameters(*engine, slot);
+                            EnginePrimer::primeNow(*engine, juce::jmax(2, getTotalNumOutputChannels()), m_samplesPerBlock,
+                                                   static_cast<int>(ChimeraConfig::ENGINE_PRIME_MAX_SECONDS * m_sampleRate));
+                            ++m_slotLoadGeneration[slot];
+                            publishEngine(slot, std::move(engine));
                         }
                     }
                 }
             }
+            
+            // Audio may be running, so the audio thread clears its own record
+            m_resendAllParameters.store(true);
         }
     }
 }
@@ -633,30 +911,6 @@ void ChimeraAudioProcessor::parameterChanged(const juce::String& parameterID, fl
             loadEngine(slot - 1, engineID);
             break;
         }
-        
-        // Check if it's a parameter knob change
-        for (int param = 1; param <= 15; ++param) {
-            if (parameterID == "slot" + slotStr + "_param" + juce::String(param)) {
-                // Special handling for parameter 2 (index 1) - only snap for specific engines
-                if (param == 2) {
-                    // Check which engine is loaded
-                    auto* engineParam = parameters.getRawParameterValue("slot" + slotStr + "_engine");
-                    int engineChoice = static_cast<int>(engineParam->load());
-                    int engineID = choiceIndexToEngineID(engineChoice);
-                    
-                    // Only allow snapping for IntelligentHarmonizer (engine ID 12)
-                    // All other engines should have smooth parameter control
-                    if (engineID != ENGINE_INTELLIGENT_HARMONIZER) {
-                        // For non-harmonizer engines, ensure smooth parameter values
-                        // Don't modify the value - just pass it through
-                    }
-                }
-                
-                // Update the engine parameters for this slot
-                updateEngineParameters(slot - 1);
-                break;
-            }
-        }
     }
 }
 
@@ -678,34 +932,237 @@ void ChimeraAudioProcessor::loadEngine(int slot, int engineID) {
             " with " + juce::String(newEngine->getNumParameters()) + " parameters");
         newEngine->prepareToPlay(m_sampleRate, m_samplesPerBlock);
         
-        // Apply default parameters for this engine
+        // Apply default parameters for this engine, then hand them to it
+        // before it becomes visible to the audio thread
         applyDefaultParameters(slot, engineID);
+        applyCurrentParameters(*newEngine, slot);
+        
+        const uint32_t generation = ++m_slotLoadGeneration[slot];
+        
+        if (newEngine->getWarmupSamples() > 0) {
+            // Pre-roll on the primer thread so the engine is warm when it goes
+            // live; the old engine keeps playing until then
+            const int maxPrimeSamples = static_cast<int>(ChimeraConfig::ENGINE_PRIME_MAX_SECONDS * m_sampleRate);
+            m_enginePrimer.prime(std::move(newEngine), juce::jmax(2, getTotalNumOutputChannels()),
+                                 m_samplesPerBlock, maxPrimeSamples,
+                                 [this, slot, generation](std::unique_ptr<EngineBase> primed) {
+                                     publishEngine(slot, std::move(primed), generation);
+                                 });
+            DBG("Priming engine for slot " + juce::String(slot) + " in the background");
+        } else {
+            publishEngine(slot, std::move(newEngine), generation);
+            DBG("Successfully loaded engine into slot " + juce::String(slot));
+        }
+    } else {
+        ++m_slotLoadGeneration[slot];
+        publishEngine(slot, nullptr);
+        DBG("ERROR: Failed to create engine for ID " + juce::String(engineID));
+    }
+}
+
+void ChimeraAudioProcessor::publishEngine(int slot, std::unique_ptr<EngineBase> newEngine,
+                                          uint32_t expectedGeneration) {
+    {
+        std::lock_guard<std::mutex> lock(m_engineMutex);
         
-        // Lock only for the actual swap
-        {
-            std::lock_guard<std::mutex> lock(m_engineMutex);
-            m_activeEngines[slot] = std::move(newEngine);
-            DBG("  Engine stored in slot " + juce::String(slot) + " at address: " + 
-                juce::String::toHexString((juce::int64)m_activeEngines[slot].get()));
+        // A primed engine can arrive after a newer load for the same slot -
+        // it was never visible to the audio thread, so just let it go
+        if (expectedGeneration != ANY_GENERATION
+            && m_slotLoadGeneration[slot].load() != expectedGeneration) {
+            DBG("  Discarding superseded engine for slot " + juce::String(slot));
+            return;
         }
         
-        // Update latency reporting
-        int maxLatency = 0;
+        std::unique_ptr<EngineBase> retiredEngine = std::move(m_activeEngines[slot]);
+        m_activeEngines[slot] = std::move(newEngine);
+        
+        const bool crossfade = retiredEngine != nullptr && m_engineCrossfadeMs.load() > 0.0f;
+        if (crossfade) {
+            // Hand the old engine to the audio thread as the outgoing half of
+            // the transition *before* the new engine becomes visible. Any engine
+            // still ringing out from an earlier transition is cut here.
+            m_slotTransitions[slot].outgoing.store(retiredEngine.get());
+        }
+        
+        // The only thing the audio thread ever waits for: one pointer store
+        m_publishedEngines[slot].store(m_activeEngines[slot].get());
+        
+        DBG("  Engine published in slot " + juce::String(slot) + " at address: " + 
+            juce::String::toHexString((juce::int64)m_activeEngines[slot].get()));
+        
+        // The audio thread may still be mid-block with the old pointer (or is
+        // ringing it out); the reclaimer destroys it on its own thread once
+        // that is over
+        if (crossfade) {
+            m_engineReclaimer.retireWhenReleased(std::move(retiredEngine), m_slotTransitions[slot].outgoing);
+        } else {
+            m_engineReclaimer.retire(std::move(retiredEngine));
+        }
+    }
+    
+    // A primed engine is published from the primer thread; hosts expect
+    // latency changes on the message thread, so that case goes through
+    // handleAsyncUpdate
+    if (juce::MessageManager::existsAndIsCurrentThread()) {
+        updateReportedLatency();
+    } else {
+        triggerAsyncUpdate();
+    }
+}
+
+void ChimeraAudioProcessor::updateReportedLatency() {
+    int maxLatency = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_engineMutex);
         for (const auto& engine : m_activeEngines) {
             if (engine) {
                 maxLatency = std::max(maxLatency, engine->getLatencySamples());
             }
         }
-        setLatencySamples(maxLatency);
-        
-        updateEngineParameters(slot);
-        
-        DBG("Successfully loaded engine into slot " + juce::String(slot));
-    } else {
+    }
+    if (m_truePeakLimiterEnabled.load()) {
+        maxLatency += m_outputStage.getLimiterLatencySamples();
+    }
+    setLatencySamples(maxLatency);
+}
+
+void ChimeraAudioProcessor::handleAsyncUpdate() {
+    {
         std::lock_guard<std::mutex> lock(m_engineMutex);
-        m_activeEngines[slot].reset();
-        DBG("ERROR: Failed to create engine for ID " + juce::String(engineID));
+        for (const auto& engine : m_activeEngines) {
+            if (engine && engine->needsDeferredAllocation()) {
+                engine->performDeferredAllocation();
+            }
+        }
+    }
+    updateReportedLatency();
+}
+
+void ChimeraAudioProcessor::setTruePeakLimiterEnabled(bool enabled) {
+    if (m_truePeakLimiterEnabled.exchange(enabled) != enabled) {
+        updateReportedLatency();
+    }
+}
+
+void ChimeraAudioProcessor::setEngineCrossfadeMs(float milliseconds) {
+    m_engineCrossfadeMs.store(juce::jlimit(0.0f, 1000.0f, milliseconds));
+}
+
+bool ChimeraAudioProcessor::setRoutingGraph(const SlotRoutingGraph& graph) {
+    if (!graph.isValid(NUM_SLOTS)) {
+        DBG("Rejected invalid routing graph: " + graph.toString());
+        return false;
+    }
+    
+    {
+        const juce::SpinLock::ScopedLockType routingLock(m_routingLock);
+        m_pendingRouting = graph;
+        m_routingChanged.store(true);
+    }
+    
+    // Saved with the rest of the state
+    parameters.state.setProperty("routing", graph.toString(), nullptr);
+    return true;
+}
+
+SlotRoutingGraph ChimeraAudioProcessor::getRoutingGraph() const {
+    const juce::SpinLock::ScopedLockType routingLock(m_routingLock);
+    return m_pendingRouting;
+}
+
+void ChimeraAudioProcessor::setParallelProcessingEnabled(bool enabled) {
+    m_slotConfig.enableParallelProcessing = enabled;
+    m_parallelProcessingEnabled.store(enabled);
+}
+
+EngineBase::Quality ChimeraAudioProcessor::getSlotQuality(int slot) const {
+    if (slot < 0 || slot >= NUM_SLOTS) return EngineBase::Quality::Ultra;
+    return static_cast<EngineBase::Quality>(m_slotQuality[slot].load());
+}
+
+bool ChimeraAudioProcessor::isSlotSleeping(int slot) const {
+    if (slot < 0 || slot >= NUM_SLOTS) return false;
+    return m_slotSleeping[slot].load();
+}
+
+uint32_t ChimeraAudioProcessor::getSlotParameterVersion(int slot) const {
+    if (slot < 0 || slot >= NUM_SLOTS) return 0;
+    return m_slotParamSnapshots[slot].version;
+}
+
+double ChimeraAudioProcessor::getTailLengthSeconds() const {
+    // Slots run in series by default, so tails add up
+    double tail = 0.0;
+    for (const auto& slotTail : m_slotTailSeconds) {
+        tail += slotTail.load();
     }
+    return tail;
+}
+
+bool ChimeraAudioProcessor::isSlotTransitioning(int slot) const {
+    if (slot < 0 || slot >= NUM_SLOTS) return false;
+    return m_slotTransitions[slot].outgoing.load() != nullptr;
+}
+
+void ChimeraAudioProcessor::renderOutgoingEngine(int slot, EngineBase* outgoing,
+                                                 const juce::AudioBuffer<float>& input, int numSamples,
+                                                 float& incomingGainStart, float& incomingGainEnd) {
+    auto& transition = m_slotTransitions[slot];
+    auto& tailBuffer = m_slotTailBuffers[slot];
+    if (transition.current != outgoing) {
+        // A new transition started since the last block
+        transition.current = outgoing;
+        transition.fadePosition = 0;
+        transition.tailSamples = 0;
+        transition.quietSamples = 0;
+    }
+    
+    const int fadeLength = juce::jmax(1, static_cast<int>(m_engineCrossfadeMs.load() * 0.001 * m_sampleRate));
+    incomingGainStart = juce::jmin(1.0f, transition.fadePosition / static_cast<float>(fadeLength));
+    incomingGainEnd = juce::jmin(1.0f, (transition.fadePosition + numSamples) / static_cast<float>(fadeLength));
+    
+    // Feed the outgoing engine a fading copy of the input (silence once faded)
+    for (int ch = 0; ch < input.getNumChannels(); ++ch) {
+        if (incomingGainStart >= 1.0f) {
+            tailBuffer.clear(ch, 0, numSamples);
+        } else {
+            tailBuffer.copyFrom(ch, 0, input, ch, 0, numSamples);
+            tailBuffer.applyGainRamp(ch, 0, numSamples, 1.0f - incomingGainStart, 1.0f - incomingGainEnd);
+        }
+    }
+    
+    // Parameters are deliberately not updated - the slot's values now belong
+    // to the incoming engine
+    outgoing->process(tailBuffer);
+    
+    transition.fadePosition = juce::jmin(fadeLength, transition.fadePosition + numSamples);
+    if (transition.fadePosition < fadeLength) {
+        return;
+    }
+    
+    // Crossfade done - ring out until the tail stays below the threshold
+    static const float tailThreshold = juce::Decibels::decibelsToGain(ChimeraConfig::ENGINE_TAIL_THRESHOLD_DB);
+    const int quietLimit = static_cast<int>(ChimeraConfig::ENGINE_TAIL_QUIET_MS * 0.001 * m_sampleRate);
+    const int tailLimit = static_cast<int>(ChimeraConfig::ENGINE_TAIL_MAX_SECONDS * m_sampleRate);
+    
+    transition.tailSamples += numSamples;
+    if (tailBuffer.getMagnitude(0, numSamples) < tailThreshold) {
+        transition.quietSamples += numSamples;
+    } else {
+        transition.quietSamples = 0;
+    }
+    
+    if (transition.quietSamples >= quietLimit || transition.tailSamples >= tailLimit) {
+        releaseSlotTransition(slot, outgoing);
+    }
+}
+
+void ChimeraAudioProcessor::releaseSlotTransition(int slot, EngineBase* outgoing) {
+    // Fails harmlessly if publishEngine already replaced it with a newer one
+    auto& transition = m_slotTransitions[slot];
+    EngineBase* expected = outgoing;
+    transition.outgoing.compare_exchange_strong(expected, nullptr);
+    transition.current = nullptr;
 }
 
 void ChimeraAudioProcessor::applyDefaultParameters(int slot, int engineID) {
@@ -744,24 +1201,20 @@ void ChimeraAudioProcessor::applyDefaultParameters(int slot, int engineID) {
         juce::String(engineID) + " in slot " + juce::String(slot));
 }
 
-void ChimeraAudioProcessor::updateEngineParameters(int slot) {
-    std::map<int, float> params;
-    juce::String slotPrefix = "slot" + juce::String(slot + 1) + "_param";
-    
-    for (int i = 0; i < 15; ++i) {
-        auto paramID = slotPrefix + juce::String(i + 1);
-        float value = parameters.getRawParameterValue(paramID)->load();
-        params[i] = value;
+void ChimeraAudioProcessor::applyCurrentParameters(EngineBase& engine, int slot) {
+    // Only used on engines that are not yet published; live engines receive
+    // their parameters from processBlock on the audio thread
+    EngineBase::ParameterSnapshot params;
+    for (int i = 0; i < NUM_PARAMS_PER_SLOT; ++i) {
+        params.values[i] = m_slotParams[slot].params[i]->load();
     }
+    params.dirtyMask = EngineBase::ParameterSnapshot::ALL_DIRTY;
     
-    // Validate parameters to ensure consistency
-    // Note: ParameterValidator ensures all values are in 0-1 range
-    // and provides defaults for any missing parameters
-    
-    // Thread-safe parameter update
-    std::lock_guard<std::mutex> lock(m_engineMutex);
-    if (m_activeEngines[slot]) {
-        m_activeEngines[slot]->updateParameters(params);
+    engine.updateParameterSnapshot(params);
+
+    // Buffers the restored mode needs, so the engine goes live with them
+    if (engine.needsDeferredAllocation()) {
+        engine.performDeferredAllocation();
     }
 }
 
@@ -4,13 +4,21 @@
 #include "EngineBase.h"
 #include "ParameterDefinitions.h"
 #include "SlotConfiguration.h"
+#include "EngineHandoff.h"
+#include "SlotRoutingGraph.h"
+#include "RealtimeWorkerPool.h"
+#include "PerformanceTelemetry.h"
+#include "CpuGovernor.h"
+#include "MasterOutputStage.h"
 #include <array>
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <map>
 
 class ChimeraAudioProcessor : public juce::AudioProcessor,
-                              private juce::AudioProcessorValueTreeState::Listener {
+                              private juce::AudioProcessorValueTreeState::Listener,
+                              private juce::AsyncUpdater {
 public:
     ChimeraAudioProcessor();
     ~ChimeraAudioProcessor() override;
@@ -30,7 +38,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override;
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -65,9 +73,18 @@ public:
     };
     std::vector<DiagnosticResult> getLastDiagnosticResults() const { return m_diagnosticResults; }
     
-    // Level metering (public for UI)
+    // Level metering (public for UI). Peak levels hold their maximum; RMS and
+    // limiter gain reduction are per block.
     float getCurrentOutputLevel() const { return m_currentOutputLevel.load(); }
     float getCurrentInputLevel() const { return m_currentInputLevel.load(); }
+    float getCurrentOutputRms() const { return m_currentOutputRms.load(); }
+    float getCurrentInputRms() const { return m_currentInputRms.load(); }
+    float getOutputGainReductionDb() const { return m_outputGainReductionDb.load(); }
+    
+    // True-peak lookahead limiter on the master output instead of the
+    // zero-latency soft clip. Changes the latency reported to the host.
+    void setTruePeakLimiterEnabled(bool enabled);
+    bool isTruePeakLimiterEnabled() const { return m_truePeakLimiterEnabled.load(); }
     
     // Slot management for UI
     float getSlotActivity(int slot) const;
@@ -77,8 +94,7 @@ public:
         if (m_activeEngines[slot]) {
             // Get engine ID from the actual engine instance
             // For now, get from parameter value
-            auto* param = parameters.getRawParameterValue("slot" + juce::String(slot + 1) + "_engine");
-            if (param) {
+            if (auto* param = m_slotParams[slot].engine) {
                 int choiceIndex = static_cast<int>(param->load());
                 return choiceIndexToEngineID(choiceIndex);
             }
@@ -86,8 +102,52 @@ public:
         return 0;
     }
     
-    // Performance monitoring
-    float getCpuUsage() const { return 0.0f; } // TODO: Implement actual CPU measurement
+    // Performance monitoring. getCpuUsage is the mean whole-chain load in
+    // percent of the block deadline (same scale as CPU_THRESHOLD_*); the
+    // snapshot has per-slot mean/p99/max. Both are safe from any non-audio thread.
+    float getCpuUsage() const { return m_telemetry.getChainLoad() * 100.0f; }
+    PerformanceTelemetry::Snapshot getTelemetry() const { return m_telemetry.getSnapshot(); }
+    
+    // Engine replacement transitions (0 ms = hard swap)
+    void setEngineCrossfadeMs(float milliseconds);
+    float getEngineCrossfadeMs() const { return m_engineCrossfadeMs.load(); }
+    bool isSlotTransitioning(int slot) const;
+    
+    // True while a slot's engine is asleep: its input has been silent past
+    // the engine's tail, so it is skipped until signal returns
+    bool isSlotSleeping(int slot) const;
+    
+    // Number of parameter deliveries made to a slot's engine so far. Written
+    // by the audio thread; only meaningful between blocks.
+    uint32_t getSlotParameterVersion(int slot) const;
+    
+    // Fraction of the block deadline spent running outgoing engines during
+    // transitions - lets hosts and the CPU governor budget for the overlap
+    float getTransitionCpuLoad() const { return m_transitionCpuLoad.load(); }
+    
+    // Slot routing (all slots in series by default). Returns false and keeps
+    // the current graph if the new one is invalid.
+    bool setRoutingGraph(const SlotRoutingGraph& graph);
+    SlotRoutingGraph getRoutingGraph() const;
+    
+    // Runs parallel branches on the worker pool. The pool is created in
+    // prepareToPlay, so enabling this while playing takes effect from the next
+    // prepareToPlay; until then branches run on the audio thread.
+    void setParallelProcessingEnabled(bool enabled);
+    bool isParallelProcessingEnabled() const { return m_parallelProcessingEnabled.load(); }
+    
+    // Adaptive quality: under sustained load the CPU governor steps the most
+    // expensive slots down EngineBase::Quality tiers and restores them once
+    // headroom returns. Offline renders always run at Ultra.
+    void setCpuGovernorEnabled(bool enabled) { m_cpuGovernorEnabled.store(enabled); }
+    bool isCpuGovernorEnabled() const { return m_cpuGovernorEnabled.load(); }
+    EngineBase::Quality getSlotQuality(int slot) const;
+    
+    // Live tracking: realtime blocks run every engine at Draft, which picks
+    // the low-latency algorithms (e.g. PSOLA pitch shifting, ~7 ms). Offline
+    // renders still run at Ultra. The reported latency follows.
+    void setLiveTrackingEnabled(bool enabled) { m_liveTrackingEnabled.store(enabled); }
+    bool isLiveTrackingEnabled() const { return m_liveTrackingEnabled.load(); }
     
 private:
     std::vector<DiagnosticResult> m_diagnosticResults;
@@ -108,16 +168,140 @@ private:
 private:
     juce::AudioProcessorValueTreeState parameters;
     static constexpr int NUM_SLOTS = CHIMERA_NUM_SLOTS;  // Using centralized configuration
+    
+    // Engine ownership lives on the message thread. The audio thread only reads
+    // m_publishedEngines; replaced engines are destroyed by m_engineReclaimer.
     std::array<std::unique_ptr<EngineBase>, NUM_SLOTS> m_activeEngines;
+    std::array<std::atomic<EngineBase*>, NUM_SLOTS> m_publishedEngines{};
+    AudioEpoch m_audioEpoch;
+    
+    // Per-slot crossfade/tail state. `outgoing` is written by publishEngine and
+    // cleared by the audio thread once the tail has died away; the remaining
+    // fields belong to the audio thread.
+    struct SlotTransition {
+        std::atomic<EngineBase*> outgoing{nullptr};
+        EngineBase* current = nullptr;   // outgoing engine the counters belong to
+        int fadePosition = 0;
+        int tailSamples = 0;
+        int quietSamples = 0;
+    };
+    std::array<SlotTransition, NUM_SLOTS> m_slotTransitions;
+    
+    // Idle tracking per slot (audio/worker thread that runs the slot). Reset
+    // whenever the engine changes or a transition is running.
+    struct SlotIdleState {
+        EngineBase* engine = nullptr;    // engine the counters belong to
+        juce::int64 silentInputSamples = 0;
+        juce::int64 quietOutputSamples = 0;
+        bool asleep = false;
+    };
+    std::array<SlotIdleState, NUM_SLOTS> m_slotIdle;
+    std::array<std::atomic<bool>, NUM_SLOTS> m_slotSleeping{};
+    std::array<std::atomic<float>, NUM_SLOTS> m_slotTailSeconds{};
+    std::array<std::atomic<uint32_t>, NUM_SLOTS> m_slotLoadGeneration{};
+    std::atomic<float> m_engineCrossfadeMs{ChimeraConfig::ENGINE_CROSSFADE_MS_DEFAULT};
+    std::atomic<float> m_transitionCpuLoad{0.0f};
+    
+    // Declared after everything they touch so they are stopped first
+    EngineReclaimer m_engineReclaimer{ m_audioEpoch };
 
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     void loadEngine(int slot, int engineID);
-    void updateEngineParameters(int slot);
+    static constexpr uint32_t ANY_GENERATION = 0xffffffffu;
+    void publishEngine(int slot, std::unique_ptr<EngineBase> newEngine,
+                       uint32_t expectedGeneration = ANY_GENERATION);
+    void updateReportedLatency();
+    void handleAsyncUpdate() override;
+    void renderOutgoingEngine(int slot, EngineBase* outgoing, const juce::AudioBuffer<float>& input,
+                              int numSamples, float& incomingGainStart, float& incomingGainEnd);
+    void releaseSlotTransition(int slot, EngineBase* outgoing);
+    void applyCurrentParameters(EngineBase& engine, int slot);
+    bool processSlot(int slot, juce::AudioBuffer<float>& buffer);
+    void updateSlotIdleState(int slot, EngineBase* engine, bool inputSilent, float outputLevel, int numSamples);
+    void processStage(const SlotRoutingGraph::Stage& stage, juce::AudioBuffer<float>& buffer);
+    void processBranch(int branchIndex);
+    static void runBranchTask(void* processor, int branchIndex);
     void applyDefaultParameters(int slot, int engineID);
     
     double m_sampleRate = 44100.0;
     int m_samplesPerBlock = 512;
     
+    // Real-time parameter access: raw pointers are resolved once in the
+    // constructor so processBlock never builds "slotN_paramM" strings
+    static constexpr int NUM_PARAMS_PER_SLOT = 15;
+    struct SlotParameterPointers {
+        std::array<std::atomic<float>*, NUM_PARAMS_PER_SLOT> params{};
+        std::atomic<float>* engine = nullptr;
+        std::atomic<float>* bypass = nullptr;
+        std::atomic<float>* mix = nullptr;
+        std::atomic<float>* solo = nullptr;
+    };
+    std::array<SlotParameterPointers, NUM_SLOTS> m_slotParams;
+    void resolveParameterPointers();
+    
+    // Last parameter values delivered to each slot's engine (audio thread).
+    // Dirty bits are computed against these, and a slot whose engine changed
+    // since the last delivery gets every bit set.
+    static_assert(NUM_PARAMS_PER_SLOT == EngineBase::ParameterSnapshot::NUM_PARAMS,
+                  "Parameter snapshot must cover every slot parameter");
+    std::array<EngineBase::ParameterSnapshot, NUM_SLOTS> m_slotParamSnapshots;
+    std::array<EngineBase*, NUM_SLOTS> m_paramEngines{};
+    std::atomic<bool> m_resendAllParameters{false};  // Set by setStateInformation
+    
+    // Scratch buffers sized in prepareToPlay (audio thread and workers). Each
+    // slot owns its wet/tail pair so parallel branches never share one; the
+    // tail buffer carries the outgoing engine's output during transitions.
+    std::array<juce::AudioBuffer<float>, NUM_SLOTS> m_slotWetBuffers;
+    std::array<juce::AudioBuffer<float>, NUM_SLOTS> m_slotTailBuffers;
+    std::array<juce::AudioBuffer<float>, SlotRoutingGraph::MAX_BRANCHES> m_branchBuffers;
+    
+    // Routing. The message thread writes m_pendingRouting under the spin lock;
+    // the audio thread takes it with a try-lock at the top of the block and
+    // keeps its previous copy if a writer happens to hold the lock.
+    SlotRoutingGraph m_pendingRouting;
+    SlotRoutingGraph m_activeRouting;   // audio thread only
+    mutable juce::SpinLock m_routingLock;
+    std::atomic<bool> m_routingChanged{false};
+    
+    ChimeraConfig::SlotConfig m_slotConfig;
+    std::atomic<bool> m_parallelProcessingEnabled{false};
+    std::unique_ptr<RealtimeWorkerPool> m_workerPool;
+    
+    // Per-block state shared with branch tasks. Written by the audio thread
+    // before the pool is released; each task only touches its own slots.
+    const SlotRoutingGraph::Stage* m_currentStage = nullptr;
+    int m_blockNumSamples = 0;
+    bool m_blockAnySoloed = false;
+    std::array<bool, NUM_SLOTS> m_slotProcessed{};
+    std::array<juce::int64, NUM_SLOTS> m_slotTransitionTicks{};
+    
+    // Per-slot cycle-counter timing, published lock-free for the editor and
+    // the optional CHIMERA_STATS_DUMP file
+    PerformanceTelemetry m_telemetry;
+    std::unique_ptr<TelemetryDumper> m_telemetryDumper;
+    
+    // Quality tiers. The governor runs on the audio thread at each telemetry
+    // publish; processSlot hands a slot's tier to its engine whenever the tier
+    // or the engine changes. m_slotQuality mirrors the tiers for the UI.
+    // m_slotPinned marks slots whose engine's latency follows its tier.
+    CpuGovernor m_cpuGovernor;
+    std::atomic<bool> m_cpuGovernorEnabled{true};
+    std::atomic<bool> m_liveTrackingEnabled{false};
+    bool m_blockIsOffline = false;
+    std::array<EngineBase*, NUM_SLOTS> m_qualityEngines{};
+    std::array<EngineBase::Quality, NUM_SLOTS> m_appliedQuality{};
+    std::array<bool, NUM_SLOTS> m_slotPinned{};
+    std::array<std::atomic<int>, NUM_SLOTS> m_slotQuality{};
+    
+    // Engine latency as of each slot's last block. Quality tiers and some
+    // parameters change it; the audio thread then asks the message thread
+    // to report the new total to the host.
+    std::array<int, NUM_SLOTS> m_observedLatency{};
+
+    // Whether each slot's engine was waiting for mode buffers last block
+    // (EngineBase::needsDeferredAllocation), so the request is posted once
+    std::array<bool, NUM_SLOTS> m_deferredAllocationRequested{};
+    
     // AI Server management
     std::unique_ptr<juce::ChildProcess> m_aiServerProcess;
     void startAIServer();
@@ -126,11 +310,24 @@ private:
     // Level metering
     std::atomic<float> m_currentOutputLevel{0.0f};
     std::atomic<float> m_currentInputLevel{0.0f};
+    std::atomic<float> m_currentOutputRms{0.0f};
+    std::atomic<float> m_currentInputRms{0.0f};
+    std::atomic<float> m_outputGainReductionDb{0.0f};
+    
+    // Compensation gain, clip protection or true-peak limiting, and output
+    // metering in one pass at the end of processBlock
+    MasterOutputStage m_outputStage;
+    std::atomic<bool> m_truePeakLimiterEnabled{false};
     std::array<std::atomic<float>, NUM_SLOTS> m_slotActivityLevels;
     
-    // Thread safety for engine management
+    // Serialises engine replacement between writers (message thread, host
+    // state restore). Never taken on the audio thread.
     mutable std::mutex m_engineMutex;
     std::atomic<bool> m_engineChangePending{false};
+    
+    // Background pre-roll for engines with warmup; its callbacks publish into
+    // the slots, so it is the last member and therefore destroyed first
+    EnginePrimer m_enginePrimer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChimeraAudioProcessor)
 };
\ No newline at end of file
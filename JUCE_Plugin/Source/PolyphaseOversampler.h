@@ -0,0 +1,391 @@
+// PolyphaseOversampler.h - Shared 2x/4x/8x oversampling for nonlinear engines
+//
+// A cascade of 2x half-band stages, each in one of two flavours:
+//  - Linear:  Kaiser-windowed half-band FIR in polyphase form. Only the
+//             non-zero taps are evaluated (SSE dot products where available)
+//             and the centre phase is a plain delay. Constant, exact latency.
+//  - Minimum: polyphase IIR half-band made of two first-order allpass chains
+//             (coefficient design after Laurent de Soras' HIIR). A few samples
+//             of latency at most, at the cost of phase linearity.
+// Stages after the first only have to reject images of an already band-limited
+// signal, so they use progressively shorter filters.
+//
+// prepare() allocates for the largest factor an engine will use; setFactor()
+// then switches between 1x and that maximum without allocating, so it can be
+// driven from EngineBase::setQuality() on the audio thread.
+#pragma once
+
+#include "EngineBase.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+#if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    #include <xmmintrin.h>
+#endif
+
+class PolyphaseOversampler {
+public:
+    enum class Phase { Linear, Minimum };
+
+    static constexpr int MAX_FACTOR = 8;
+    static constexpr int MAX_STAGES = 3;
+
+    // Message thread: allocates state for numChannels at up to maxFactor
+    // (rounded up to a power of two, clamped to MAX_FACTOR). Starts at maxFactor.
+    void prepare(int numChannels, int maxBlockSize, int maxFactor, Phase newPhase = Phase::Linear) {
+        phase = newPhase;
+        maxStages = 0;
+        while ((1 << maxStages) < juce::jlimit(1, MAX_FACTOR, maxFactor))
+            ++maxStages;
+
+        for (int s = 0; s < maxStages; ++s)
+            designStage(s);
+
+        channels.resize((size_t) juce::jmax(1, numChannels));
+        for (auto& channel : channels)
+            for (int s = 0; s < maxStages; ++s)
+                channel.stages[(size_t) s].allocate(designs[(size_t) s]);
+
+        blockCapacity = juce::jmax(1, maxBlockSize);
+        oversampledData.assign(channels.size(), std::vector<float>((size_t) (blockCapacity << maxStages), 0.0f));
+
+        numStages = maxStages;
+        reset();
+    }
+
+    void reset() noexcept {
+        for (auto& channel : channels)
+            for (auto& stage : channel.stages)
+                stage.reset();
+    }
+
+    // Audio thread safe. Factors are powers of two up to the prepared maximum;
+    // filter state is cleared when the factor actually changes.
+    void setFactor(int newFactor) noexcept {
+        int stages = 0;
+        while (stages < maxStages && (1 << stages) < newFactor)
+            ++stages;
+
+        if (stages != numStages) {
+            numStages = stages;
+            reset();
+        }
+    }
+
+    int getFactor() const noexcept    { return 1 << numStages; }
+    int getMaxFactor() const noexcept { return 1 << maxStages; }
+    Phase getPhase() const noexcept   { return phase; }
+
+    // Up plus down delay in base-rate samples at the current factor. Exact for
+    // Linear; for Minimum it is the group delay at DC.
+    float getLatencySamples() const noexcept {
+        float latency = 0.0f;
+        for (int s = 0; s < numStages; ++s)
+            latency += designs[(size_t) s].roundTripDelay / (float) (1 << s);
+        return latency;
+    }
+
+    int getLatencyInSamples() const noexcept { return juce::roundToInt(getLatencySamples()); }
+
+    // Factor for a quality tier: Draft runs at the base rate, Normal at 2x,
+    // High at half the maximum (at least 2x) and Ultra at the maximum.
+    static int factorForQuality(EngineBase::Quality quality, int maxFactor) noexcept {
+        switch (quality) {
+            case EngineBase::Quality::Draft:  return 1;
+            case EngineBase::Quality::Normal: return juce::jmin(2, maxFactor);
+            case EngineBase::Quality::High:   return juce::jmin(maxFactor, juce::jmax(2, maxFactor / 2));
+            case EngineBase::Quality::Ultra:  break;
+        }
+        return maxFactor;
+    }
+
+    //==============================================================================
+    // Per-sample interface for engines whose loops run sample by sample.
+    // output/input hold getFactor() samples.
+    void upsampleSample(int channel, float input, float* output) noexcept {
+        auto& stages = channels[(size_t) channel].stages;
+        float scratch[MAX_FACTOR];
+        output[0] = input;
+
+        for (int s = 0, n = 1; s < numStages; ++s, n <<= 1) {
+            std::copy(output, output + n, scratch);
+            for (int i = 0; i < n; ++i)
+                stages[(size_t) s].upsample(designs[(size_t) s], phase, scratch[i], output + 2 * i);
+        }
+    }
+
+    float downsampleSample(int channel, const float* input) noexcept {
+        auto& stages = channels[(size_t) channel].stages;
+        float scratch[MAX_FACTOR];
+        std::copy(input, input + getFactor(), scratch);
+
+        for (int s = numStages - 1, n = getFactor() / 2; s >= 0; --s, n >>= 1)
+            for (int i = 0; i < n; ++i)
+                scratch[i] = stages[(size_t) s].downsample(designs[(size_t) s], phase, scratch + 2 * i);
+
+        return scratch[0];
+    }
+
+    // Runs fn on every oversampled sample of one input sample
+    template <typename Fn>
+    float processSample(int channel, float input, Fn&& fn) noexcept {
+        float up[MAX_FACTOR];
+        upsampleSample(channel, input, up);
+        for (int i = 0; i < getFactor(); ++i)
+            up[i] = fn(up[i]);
+        return downsampleSample(channel, up);
+    }
+
+    //==============================================================================
+    // Block interface: upsampleBlock() fills getOversampledData() with
+    // numSamples * getFactor() samples per channel; process those in place and
+    // call downsampleBlock(). numSamples must not exceed the prepared block size.
+    void upsampleBlock(const juce::AudioBuffer<float>& input, int numSamples) noexcept {
+        jassert(numSamples <= blockCapacity);
+        const int factor = getFactor();
+        const int numChannels = juce::jmin(input.getNumChannels(), (int) channels.size());
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const auto* in = input.getReadPointer(ch);
+            auto* out = oversampledData[(size_t) ch].data();
+            for (int i = 0; i < numSamples; ++i)
+                upsampleSample(ch, in[i], out + i * factor);
+        }
+    }
+
+    float* getOversampledData(int channel) noexcept { return oversampledData[(size_t) channel].data(); }
+
+    void downsampleBlock(juce::AudioBuffer<float>& output, int numSamples) noexcept {
+        jassert(numSamples <= blockCapacity);
+        const int factor = getFactor();
+        const int numChannels = juce::jmin(output.getNumChannels(), (int) channels.size());
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const auto* in = oversampledData[(size_t) ch].data();
+            auto* out = output.getWritePointer(ch);
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = downsampleSample(ch, in + i * factor);
+        }
+    }
+
+private:
+    // Non-zero side taps per FIR branch, and allpass coefficients per IIR
+    // filter, for each stage of the cascade
+    static constexpr int FIR_TAPS[MAX_STAGES] = { 48, 16, 8 };
+    static constexpr int IIR_COEFS[MAX_STAGES] = { 12, 6, 4 };
+    static constexpr double IIR_TRANSITION[MAX_STAGES] = { 0.02, 0.12, 0.2 };
+    static constexpr int MAX_IIR_COEFS = 12;
+    static constexpr double FIR_KAISER_BETA = 9.0;   // ~90 dB stopband
+
+    struct StageDesign {
+        // FIR: the 2K odd-index taps of the half-band (even-rate branch), in
+        // history order (newest sample first)
+        std::vector<float> firTaps;
+        int firHalfLength = 0;    // K
+
+        std::array<float, MAX_IIR_COEFS> iirCoefs{};
+        int numIirCoefs = 0;
+
+        float roundTripDelay = 0.0f;    // up + down, in this stage's input-rate samples
+    };
+
+    struct StageState {
+        // FIR histories are written twice (at i and i + size) so the newest
+        // `size` samples are always contiguous for the dot product
+        std::vector<float> upHistory, downHistory, oddDelay;
+        int upPos = 0, downPos = 0, oddPos = 0;
+
+        // IIR allpass states: one x/y pair per coefficient, for each direction
+        std::array<float, MAX_IIR_COEFS> upX{}, upY{}, downX{}, downY{};
+
+        void allocate(const StageDesign& design) {
+            const auto taps = (size_t) design.firTaps.size();
+            upHistory.assign(taps * 2, 0.0f);
+            downHistory.assign(taps * 2, 0.0f);
+            oddDelay.assign((size_t) design.firHalfLength, 0.0f);
+        }
+
+        void reset() noexcept {
+            std::fill(upHistory.begin(), upHistory.end(), 0.0f);
+            std::fill(downHistory.begin(), downHistory.end(), 0.0f);
+            std::fill(oddDelay.begin(), oddDelay.end(), 0.0f);
+            upPos = downPos = oddPos = 0;
+            upX.fill(0.0f); upY.fill(0.0f);
+            downX.fill(0.0f); downY.fill(0.0f);
+        }
+
+        static int push(std::vector<float>& history, int pos, float x) noexcept {
+            const int size = (int) history.size() / 2;
+            pos = (pos == 0 ? size : pos) - 1;
+            history[(size_t) pos] = history[(size_t) (pos + size)] = x;
+            return pos;
+        }
+
+        void upsample(const StageDesign& design, Phase phase, float x, float* out) noexcept {
+            if (phase == Phase::Minimum) {
+                float even = x, odd = x;
+                runAllpassPair(design, upX, upY, even, odd);
+                out[0] = even;
+                out[1] = odd;
+                return;
+            }
+
+            // Zero-stuffed input through 2x the half-band: the even phase is
+            // the odd-tap branch, the odd phase is the centre tap (a delay)
+            upPos = push(upHistory, upPos, x);
+            const int taps = (int) design.firTaps.size();
+            out[0] = 2.0f * dot(design.firTaps.data(), upHistory.data() + upPos, taps);
+            out[1] = upHistory[(size_t) (upPos + design.firHalfLength - 1)];
+        }
+
+        float downsample(const StageDesign& design, Phase phase, const float* in) noexcept {
+            if (phase == Phase::Minimum) {
+                float a = in[1], b = in[0];
+                runAllpassPair(design, downX, downY, a, b);
+                return 0.5f * (a + b);
+            }
+
+            downPos = push(downHistory, downPos, in[0]);
+            const int taps = (int) design.firTaps.size();
+            const float branch = dot(design.firTaps.data(), downHistory.data() + downPos, taps);
+
+            // Centre tap: odd-phase input delayed by K samples
+            const int delaySize = (int) oddDelay.size();
+            const float centre = oddDelay[(size_t) oddPos];
+            oddDelay[(size_t) oddPos] = in[1];
+            oddPos = (oddPos + 1) % delaySize;
+
+            return branch + 0.5f * centre;
+        }
+
+        // Even coefficients filter `a`, odd ones filter `b` (HIIR layout)
+        static void runAllpassPair(const StageDesign& design, std::array<float, MAX_IIR_COEFS>& xs,
+                                   std::array<float, MAX_IIR_COEFS>& ys, float& a, float& b) noexcept {
+            for (int i = 0; i < design.numIirCoefs; i += 2) {
+                const float ya = (a - ys[(size_t) i]) * design.iirCoefs[(size_t) i] + xs[(size_t) i];
+                xs[(size_t) i] = a;
+                ys[(size_t) i] = ya;
+                a = ya;
+
+                if (i + 1 < design.numIirCoefs) {
+                    const float yb = (b - ys[(size_t) i + 1]) * design.iirCoefs[(size_t) i + 1] + xs[(size_t) i + 1];
+                    xs[(size_t) i + 1] = b;
+                    ys[(size_t) i + 1] = yb;
+                    b = yb;
+                }
+            }
+        }
+
+        static float dot(const float* a, const float* b, int n) noexcept {
+           #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+            __m128 acc = _mm_setzero_ps();
+            for (int i = 0; i < n; i += 4)
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+            acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+            acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+            return _mm_cvtss_f32(acc);
+           #else
+            float sum = 0.0f;
+            for (int i = 0; i < n; ++i)
+                sum += a[i] * b[i];
+            return sum;
+           #endif
+        }
+    };
+
+    struct ChannelState {
+        std::array<StageState, MAX_STAGES> stages;
+    };
+
+    void designStage(int s) {
+        auto& design = designs[(size_t) s];
+
+        // FIR: h[n] = sin(pi n / 2) / (pi n) for odd n, windowed; h[0] = 0.5
+        const int halfLength = FIR_TAPS[s] / 2;    // K; taps are a multiple of 4 for SSE
+        const int centre = 2 * halfLength - 1;
+        design.firHalfLength = halfLength;
+        design.firTaps.assign((size_t) FIR_TAPS[s], 0.0f);
+
+        for (int i = 0; i < FIR_TAPS[s]; ++i) {
+            const int n = 2 * i - centre;    // odd, -(2K-1)..(2K-1)
+            const double t = (double) n / (double) (centre + 1);
+            const double window = besselI0(FIR_KAISER_BETA * std::sqrt(juce::jmax(0.0, 1.0 - t * t))) / besselI0(FIR_KAISER_BETA);
+            design.firTaps[(size_t) i] = (float) (std::sin(juce::MathConstants<double>::halfPi * n)
+                                                  / (juce::MathConstants<double>::pi * n) * window);
+        }
+
+        // IIR: two allpass chains, first-order in the low-rate domain
+        design.numIirCoefs = IIR_COEFS[s];
+        double pathDelay[2] = { 0.0, 0.0 };
+        const double k = transitionParameter(IIR_TRANSITION[s]);
+        const double q = ellipticNome(k);
+        for (int i = 0; i < design.numIirCoefs; ++i) {
+            const double c = allpassCoefficient(i, k, q, design.numIirCoefs * 2 + 1);
+            design.iirCoefs[(size_t) i] = (float) c;
+            pathDelay[i & 1] += 2.0 * (1.0 - c) / (1.0 + c);    // DC group delay in high-rate samples
+        }
+
+        // Up and down each delay by D high-rate samples (FIR), or by the mean of
+        // the two paths with the odd one a sample late (IIR); twice that at the
+        // high rate is the same number of input-rate samples. The IIR decimator
+        // emits on the odd input phase, which is half an input sample earlier.
+        if (phase == Phase::Linear)
+            design.roundTripDelay = (float) centre;
+        else
+            design.roundTripDelay = (float) (0.5 * (pathDelay[0] + pathDelay[1] + 1.0) - 0.5);
+    }
+
+    static double besselI0(double x) noexcept {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 50 && term > 1.0e-12 * sum; ++k) {
+            const double f = x / (2.0 * k);
+            term *= f * f;
+            sum += term;
+        }
+        return sum;
+    }
+
+    // HIIR coefficient design (elliptic half-band, given order and transition)
+    static double transitionParameter(double transition) noexcept {
+        double k = std::tan((1.0 - transition * 2.0) * juce::MathConstants<double>::pi / 4.0);
+        return k * k;
+    }
+
+    static double ellipticNome(double k) noexcept {
+        const double kksqrt = std::pow(1.0 - k * k, 0.25);
+        const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+        const double e4 = e * e * e * e;
+        return e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+    }
+
+    static double allpassCoefficient(int index, double k, double q, int order) noexcept {
+        const double pi = juce::MathConstants<double>::pi;
+        const int c = index + 1;
+
+        double num = 0.0, term = 0.0;
+        for (int i = 0, sign = 1; i == 0 || std::abs(term) > 1.0e-100; ++i, sign = -sign) {
+            term = std::pow(q, (double) (i * (i + 1))) * std::sin((i * 2 + 1) * c * pi / order) * sign;
+            num += term;
+        }
+
+        double den = 0.0;
+        for (int i = 1, sign = -1; i == 1 || std::abs(term) > 1.0e-100; ++i, sign = -sign) {
+            term = std::pow(q, (double) (i * i)) * std::cos(i * 2 * c * pi / order) * sign;
+            den += term;
+        }
+
+        const double ww = num * std::pow(q, 0.25) / (den + 0.5);
+        const double wwsq = ww * ww;
+        const double x = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+        return (1.0 - x) / (1.0 + x);
+    }
+
+    Phase phase = Phase::Linear;
+    std::array<StageDesign, MAX_STAGES> designs;
+    std::vector<ChannelState> channels;
+    std::vector<std::vector<float>> oversampledData;
+    int blockCapacity = 0;
+    int maxStages = 0;
+    int numStages = 0;
+};
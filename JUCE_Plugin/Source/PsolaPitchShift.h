@@ -0,0 +1,285 @@
+#pragma once
+#include "IPitchShiftStrategy.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * PsolaPitchShift - Low-latency time-domain pitch shifting (TD-PSOLA)
+ *
+ * The live/tracking tier. A YIN detector on a ~12 kHz decimated copy of the
+ * input finds the period P. Analysis marks sit one period apart, lined up
+ * with the waveform's peaks; synthesis marks are spaced P / ratio, and each
+ * synthesis mark overlap-adds a Hann grain cut around the nearest analysis
+ * mark. Grains are read progressively
+ * as output advances, so a grain may start as soon as its analysis mark is in
+ * the past: the lookback never exceeds half of the longest period, and that
+ * is the whole latency (about 7 ms at any sample rate).
+ *
+ * At unity ratio the marks coincide and the output is the input delayed by
+ * exactly getLatencySamples(). Unvoiced input keeps the last detected period,
+ * which is harmless for noise.
+ *
+ * Everything is allocated in prepare(); process() is real-time safe.
+ */
+class PsolaPitchShift : public IPitchShiftStrategy {
+public:
+    static constexpr double MIN_FREQUENCY_HZ = 70.0;
+    static constexpr double MAX_FREQUENCY_HZ = 1000.0;
+    static constexpr double DETECTOR_RATE_HZ = 12000.0;
+    static constexpr float MIN_RATIO = 0.25f;
+    static constexpr float MAX_RATIO = 4.0f;
+
+    void prepare(double sr, int maxBlockSize) override {
+        (void) maxBlockSize;
+        sampleRate = sr;
+        maxPeriod = std::ceil(sr / MIN_FREQUENCY_HZ);
+        latency = (int) std::ceil(maxPeriod * 0.5) + 1;
+
+        // Deepest read: the latency, half a period of mark rounding and the
+        // grain's first half
+        const int reach = latency + (int) std::ceil(maxPeriod * 1.5) + 4;
+        int size = 1;
+        while (size < reach) size <<= 1;
+        history.assign((size_t) size, 0.0f);
+        historyMask = size - 1;
+
+        // Pitch detector runs on an integer decimation of the input
+        decimation = std::max(1, (int) std::lround(sr / DETECTOR_RATE_HZ));
+        const double detectorRate = sr / decimation;
+        minLag = std::max(2, (int) std::floor(detectorRate / MAX_FREQUENCY_HZ));
+        maxLag = ((int) std::ceil(detectorRate / MIN_FREQUENCY_HZ) + 3) & ~3;
+        int detectorSize = 1;
+        while (detectorSize < 2 * maxLag + 2) detectorSize <<= 1;
+        detectorHistory.assign((size_t) detectorSize, 0.0f);
+        detectorMask = detectorSize - 1;
+        detectorFrame.assign((size_t) detectorSize, 0.0f);
+        difference.assign((size_t) maxLag + 2, 0.0f);
+        detectorSmoothing = (float) std::exp(-2.0 * 3.14159265358979 * DETECTOR_CUTOFF_HZ / sr);
+
+        for (int i = 0; i <= WINDOW_TABLE_SIZE; ++i)
+            windowTable[(size_t) i] = 0.5f - 0.5f * (float) std::cos(2.0 * 3.14159265358979 * i / WINDOW_TABLE_SIZE);
+
+        reset();
+    }
+
+    void reset() override {
+        std::fill(history.begin(), history.end(), 0.0f);
+        std::fill(detectorHistory.begin(), detectorHistory.end(), 0.0f);
+        for (auto& grain : grains) grain.active = false;
+
+        now = 0;
+        period = sampleRate / 200.0;
+        nextSynthesisMark = (double) latency;
+        epoch = 0;
+        cycleStart = 0;
+        cyclePeakPosition = 0;
+        cyclePeak = 0.0f;
+        detectorState = { 0.0f, 0.0f };
+        detectorAccumulator = 0.0f;
+        detectorPhase = 0;
+        detectorWritePos = 0;
+        detectorCountdown = DETECTOR_INTERVAL;
+    }
+
+    void process(const float* input, float* output, int numSamples, float pitchRatio) override {
+        const double ratio = std::clamp(pitchRatio, MIN_RATIO, MAX_RATIO);
+        const float normaliseFloor = ratio < 1.0 ? (float) ratio : 1.0e-6f;
+
+        for (int i = 0; i < numSamples; ++i) {
+            const float x = input[i];
+            history[(size_t) (now & historyMask)] = x;
+            pushDetector(x);
+            trackEpoch();
+
+            // Grains start half their length ahead of their synthesis mark
+            while ((double) now >= nextSynthesisMark - period) {
+                startGrain(nextSynthesisMark, ratio == 1.0);
+                nextSynthesisMark += period / ratio;
+            }
+
+            float sum = 0.0f, windowSum = 0.0f;
+            for (auto& grain : grains) {
+                if (!grain.active) continue;
+
+                const float position = (float) grain.windowPosition;
+                const int index = (int) position;
+                const float w = windowTable[(size_t) index]
+                              + (position - (float) index) * (windowTable[(size_t) index + 1] - windowTable[(size_t) index]);
+
+                const double source = std::floor(grain.sourcePosition);
+                const int64_t s = (int64_t) source;
+                const float frac = (float) (grain.sourcePosition - source);
+                const float a = history[(size_t) (s & historyMask)];
+                const float b = history[(size_t) ((s + 1) & historyMask)];
+
+                sum += w * (a + frac * (b - a));
+                windowSum += w;
+
+                grain.sourcePosition += 1.0;
+                grain.windowPosition += grain.windowIncrement;
+                if (grain.windowPosition >= (double) WINDOW_TABLE_SIZE) grain.active = false;
+            }
+
+            // Normalised overlap-add keeps the level wherever grains overlap.
+            // Below unity the floor leaves the gaps between grains as gaps
+            // (they carry the new, longer period) while still making up the
+            // average level.
+            output[i] = sum / std::max(windowSum, normaliseFloor);
+            ++now;
+        }
+    }
+
+    int getLatencySamples() const override { return latency; }
+
+    const char* getName() const override { return "PSOLA (Low Latency)"; }
+    bool isHighQuality() const override { return false; }
+    int getQualityRating() const override { return 60; }
+    int getCpuUsage() const override { return 5; }
+
+private:
+    static constexpr int WINDOW_TABLE_SIZE = 2048;
+    static constexpr int MAX_GRAINS = 16;
+    static constexpr int DETECTOR_INTERVAL = 64;  // Decimated samples between estimates
+    static constexpr float YIN_THRESHOLD = 0.15f;
+    static constexpr double DETECTOR_CUTOFF_HZ = 1500.0;
+
+    struct Grain {
+        double sourcePosition = 0.0;   // Absolute input index read this sample
+        double windowPosition = 0.0;   // Into windowTable
+        double windowIncrement = 0.0;
+        bool active = false;
+    };
+
+    // Grains are two periods long, centred on their synthesis mark
+    void startGrain(double synthesisMark, bool unity) {
+        // Nearest analysis mark to (mark - latency) on the lattice of periods
+        // through the last epoch, so every grain is centred on a waveform peak
+        // and its neighbours fall where the window is small. At unity it is
+        // exactly the target, so the output is a pure delay.
+        const double target = synthesisMark - latency;
+        const double analysisMark = unity ? target
+                                          : std::min((double) epoch + std::round((target - (double) epoch) / period) * period,
+                                                     target + maxPeriod * 0.5);
+
+        for (auto& grain : grains) {
+            if (grain.active) continue;
+            const double offset = (double) now - synthesisMark;
+            grain.sourcePosition = analysisMark + offset;
+            grain.windowIncrement = WINDOW_TABLE_SIZE / (2.0 * period);
+            grain.windowPosition = (offset + period) * grain.windowIncrement;
+            grain.active = grain.windowPosition < (double) WINDOW_TABLE_SIZE;
+            return;
+        }
+    }
+
+    // Epochs: the largest peak of the smoothed input in each period-long
+    // stretch. Any one peak per period will do; the lattice repeats.
+    void trackEpoch() {
+        if (detectorState[1] > cyclePeak) {
+            cyclePeak = detectorState[1];
+            cyclePeakPosition = now;
+        }
+        if ((double) (now - cycleStart) < period) return;
+        epoch = cyclePeakPosition;
+        cycleStart = now;
+        cyclePeak = detectorState[1];
+        cyclePeakPosition = now;
+    }
+
+    void pushDetector(float x) {
+        // Two one-pole lowpasses, then average down to the detector rate
+        detectorState[0] = x + detectorSmoothing * (detectorState[0] - x);
+        detectorState[1] = detectorState[0] + detectorSmoothing * (detectorState[1] - detectorState[0]);
+        detectorAccumulator += detectorState[1];
+        if (++detectorPhase < decimation) return;
+
+        detectorHistory[(size_t) (detectorWritePos & detectorMask)] = detectorAccumulator / (float) decimation;
+        ++detectorWritePos;
+        detectorAccumulator = 0.0f;
+        detectorPhase = 0;
+
+        if (--detectorCountdown > 0) return;
+        detectorCountdown = DETECTOR_INTERVAL;
+        detectPeriod();
+    }
+
+    // YIN over the latest maxLag decimated samples
+    void detectPeriod() {
+        const int window = maxLag;
+        const int64_t start = detectorWritePos - window - maxLag;
+        if (start < 0) return;
+
+        // Unwrap into a linear frame so the lag loop vectorises
+        float energy = 0.0f;
+        for (int j = 0; j < window + maxLag; ++j) {
+            const float v = detectorHistory[(size_t) ((start + j) & detectorMask)];
+            detectorFrame[(size_t) j] = v;
+            energy += j < window ? v * v : 0.0f;
+        }
+        if (energy < 1.0e-8f) return;
+
+        const float* frame = detectorFrame.data();
+        float runningSum = 0.0f;
+        for (int tau = 1; tau <= maxLag; ++tau) {
+            // Four partial sums (window is padded to a multiple of four)
+            float partial[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for (int j = 0; j < window; j += 4) {
+                for (int k = 0; k < 4; ++k) {
+                    const float delta = frame[j + k] - frame[j + k + tau];
+                    partial[k] += delta * delta;
+                }
+            }
+            const float d = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+            runningSum += d;
+            difference[(size_t) tau] = runningSum > 0.0f ? d * (float) tau / runningSum : 1.0f;
+        }
+
+        for (int tau = minLag; tau < maxLag; ++tau) {
+            if (difference[(size_t) tau] >= YIN_THRESHOLD) continue;
+            while (tau + 1 < maxLag && difference[(size_t) tau + 1] < difference[(size_t) tau]) ++tau;
+
+            // Parabolic refinement around the dip
+            const float a = difference[(size_t) tau - 1], b = difference[(size_t) tau], c = difference[(size_t) tau + 1];
+            const float curvature = a - 2.0f * b + c;
+            const float shift = curvature > 0.0f ? 0.5f * (a - c) / curvature : 0.0f;
+            period = std::min(((double) tau + std::clamp(shift, -0.5f, 0.5f)) * decimation, maxPeriod);
+            return;
+        }
+    }
+
+    // Input
+    std::vector<float> history;
+    int64_t historyMask = 0;
+    int64_t now = 0;
+
+    // Marks and grains
+    double sampleRate = 44100.0;
+    double maxPeriod = 630.0;
+    double period = 220.0;
+    double nextSynthesisMark = 0.0;
+    int64_t epoch = 0;
+    int64_t cycleStart = 0;
+    int64_t cyclePeakPosition = 0;
+    float cyclePeak = 0.0f;
+    int latency = 0;
+    std::array<Grain, MAX_GRAINS> grains;
+    std::array<float, WINDOW_TABLE_SIZE + 1> windowTable{};
+
+    // Pitch detector
+    std::vector<float> detectorHistory;
+    std::vector<float> detectorFrame;
+    std::vector<float> difference;
+    int64_t detectorMask = 0;
+    int64_t detectorWritePos = 0;
+    int decimation = 4;
+    int minLag = 12;
+    int maxLag = 172;
+    int detectorPhase = 0;
+    int detectorCountdown = DETECTOR_INTERVAL;
+    float detectorSmoothing = 0.0f;
+    std::array<float, 2> detectorState{};
+    float detectorAccumulator = 0.0f;
+};
@@ -0,0 +1,116 @@
+// RealFFT.h - Real-input FFT used by the spectral and convolution engines
+//
+// One interface over two backends, picked at build time:
+//  - SignalsmithRealFFT: the vendored signalsmith-linear real FFT, a split
+//    radix-4 transform on half-size complex data whose inner loops vectorise.
+//  - JuceRealFFT:        juce::dsp::FFT. Only fast when JUCE was built with
+//                        a platform engine (vDSP, IPP/MKL or FFTW); otherwise
+//                        it is JUCE's generic fallback.
+// RealFFT is JuceRealFFT where JUCE has such an engine and SignalsmithRealFFT
+// everywhere else, which includes plain Linux builds. Define
+// CHIMERA_FFT_USE_JUCE to 0 or 1 to override that choice.
+//
+// Both take size = 2^order real samples to the size / 2 + 1
+// non-negative-frequency bins and back. The inverse ignores the imaginary
+// parts of DC and Nyquist, assumes the negative frequencies mirror the
+// positive ones, and is scaled by 1/size, so forward then inverse is the
+// identity. The bins may overlay the samples (size + 2 floats), so either
+// transform can run in place.
+//
+// The constructor allocates; forward() and inverse() are real-time safe.
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <complex>
+#include <cstring>
+#include <vector>
+#include "signalsmith-linear/fft.h"
+
+#ifndef CHIMERA_FFT_USE_JUCE
+   #if JUCE_MAC || JUCE_IOS || JUCE_DSP_USE_INTEL_MKL || JUCE_DSP_USE_SHARED_FFTW || JUCE_DSP_USE_STATIC_FFTW
+    #define CHIMERA_FFT_USE_JUCE 1
+   #else
+    #define CHIMERA_FFT_USE_JUCE 0
+   #endif
+#endif
+
+class SignalsmithRealFFT {
+public:
+    explicit SignalsmithRealFFT(int order)
+        : size(1 << order), fft((size_t) size), packed((size_t) size / 2) {}
+
+    static const char* getName() noexcept { return "signalsmith-linear"; }
+
+    int getSize() const noexcept { return size; }
+    int getNumBins() const noexcept { return size / 2 + 1; }
+
+    void forward(const float* input, std::complex<float>* bins) noexcept {
+        fft.fft(input, packed.data());
+
+        // signalsmith packs the Nyquist bin into the imaginary part of DC
+        const int half = size / 2;
+        const float nyquist = packed[0].imag();
+        bins[0] = { packed[0].real(), 0.0f };
+        std::copy(packed.begin() + 1, packed.end(), bins + 1);
+        bins[half] = { nyquist, 0.0f };
+    }
+
+    void inverse(const std::complex<float>* bins, float* output) noexcept {
+        const int half = size / 2;
+        const float scale = 1.0f / (float) size;
+
+        packed[0] = { bins[0].real() * scale, bins[half].real() * scale };
+        for (int k = 1; k < half; ++k)
+            packed[(size_t) k] = bins[k] * scale;
+
+        fft.ifft(packed.data(), output);
+    }
+
+private:
+    int size;
+    signalsmith::linear::RealFFT<float> fft;
+    std::vector<std::complex<float>> packed;
+};
+
+class JuceRealFFT {
+public:
+    explicit JuceRealFFT(int order)
+        : size(1 << order), fft(order), workspace((size_t) size * 2) {}
+
+    static const char* getName() noexcept { return "juce::dsp::FFT"; }
+
+    int getSize() const noexcept { return size; }
+    int getNumBins() const noexcept { return size / 2 + 1; }
+
+    void forward(const float* input, std::complex<float>* bins) noexcept {
+        std::copy(input, input + size, workspace.begin());
+        fft.performRealOnlyForwardTransform(workspace.data(), true);
+        std::memcpy(bins, workspace.data(), sizeof(std::complex<float>) * (size_t) getNumBins());
+    }
+
+    void inverse(const std::complex<float>* bins, float* output) noexcept {
+        const int half = size / 2;
+        auto* full = reinterpret_cast<std::complex<float>*>(workspace.data());
+
+        full[0] = { bins[0].real(), 0.0f };
+        full[half] = { bins[half].real(), 0.0f };
+        for (int k = 1; k < half; ++k) {
+            full[k] = bins[k];
+            full[size - k] = std::conj(bins[k]);
+        }
+
+        fft.performRealOnlyInverseTransform(workspace.data());
+        std::copy(workspace.begin(), workspace.begin() + size, output);
+    }
+
+private:
+    int size;
+    juce::dsp::FFT fft;
+    std::vector<float> workspace;
+};
+
+#if CHIMERA_FFT_USE_JUCE
+using RealFFT = JuceRealFFT;
+#else
+using RealFFT = SignalsmithRealFFT;
+#endif
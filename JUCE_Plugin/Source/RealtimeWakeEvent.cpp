@@ -0,0 +1,94 @@
+#include "RealtimeWakeEvent.h"
+
+#if JUCE_MAC || JUCE_IOS
+    #include <dispatch/dispatch.h>
+#elif JUCE_WINDOWS
+    #include <windows.h>
+    #include <climits>
+#else
+    #include <cerrno>
+    #include <ctime>
+    #include <semaphore.h>
+#endif
+
+// Platform semaphore, created with a count of zero
+RealtimeWakeEvent::RealtimeWakeEvent() {
+   #if JUCE_MAC || JUCE_IOS
+    semaphore = dispatch_semaphore_create(0);
+   #elif JUCE_WINDOWS
+    semaphore = CreateSemaphoreW(nullptr, 0, LONG_MAX, nullptr);
+   #else
+    auto* sem = new sem_t;
+    sem_init(sem, 0, 0);
+    semaphore = sem;
+   #endif
+}
+
+RealtimeWakeEvent::~RealtimeWakeEvent() {
+   #if JUCE_MAC || JUCE_IOS
+    dispatch_release(static_cast<dispatch_semaphore_t>(semaphore));
+   #elif JUCE_WINDOWS
+    CloseHandle(semaphore);
+   #else
+    auto* sem = static_cast<sem_t*>(semaphore);
+    sem_destroy(sem);
+    delete sem;
+   #endif
+}
+
+bool RealtimeWakeEvent::wait(int timeoutMs) noexcept {
+    if (count.fetch_sub(1, std::memory_order_acquire) > 0)
+        return true;  // Consumed a pending wake
+
+    if (waitSemaphore(timeoutMs))
+        return true;
+
+    // Timed out: withdraw, unless a signal() has already counted us and is
+    // about to post - then that post has to be consumed here
+    int state = count.load(std::memory_order_relaxed);
+    while (state < 0) {
+        if (count.compare_exchange_weak(state, state + 1, std::memory_order_relaxed))
+            return false;
+    }
+    waitSemaphore(-1);
+    return true;
+}
+
+void RealtimeWakeEvent::postSemaphore() noexcept {
+   #if JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(semaphore));
+   #elif JUCE_WINDOWS
+    ReleaseSemaphore(semaphore, 1, nullptr);
+   #else
+    sem_post(static_cast<sem_t*>(semaphore));
+   #endif
+}
+
+bool RealtimeWakeEvent::waitSemaphore(int timeoutMs) noexcept {
+   #if JUCE_MAC || JUCE_IOS
+    const auto deadline = timeoutMs < 0 ? DISPATCH_TIME_FOREVER
+                                        : dispatch_time(DISPATCH_TIME_NOW, (int64_t) timeoutMs * (int64_t) NSEC_PER_MSEC);
+    return dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(semaphore), deadline) == 0;
+   #elif JUCE_WINDOWS
+    return WaitForSingleObject(semaphore, timeoutMs < 0 ? INFINITE : (DWORD) timeoutMs) == WAIT_OBJECT_0;
+   #else
+    auto* sem = static_cast<sem_t*>(semaphore);
+    if (timeoutMs < 0) {
+        while (sem_wait(sem) != 0)
+            if (errno != EINTR) return false;
+        return true;
+    }
+
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (long) (timeoutMs % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    while (sem_timedwait(sem, &deadline) != 0)
+        if (errno != EINTR) return false;
+    return true;
+   #endif
+}
@@ -0,0 +1,42 @@
+// RealtimeWakeEvent.h - Auto-reset event the audio thread can signal
+//
+// juce::WaitableEvent::signal() takes a mutex, so the audio thread can end up
+// waiting on whichever thread holds it. Here an atomic count records either a
+// pending wake (1) or a thread asleep in wait() (-1). signal() is a CAS on
+// that count, and it posts the OS semaphore only when a thread is actually
+// asleep; the post never blocks (a futex wake on Linux, a dispatch semaphore
+// on Apple platforms). Intended for one waiting thread; any thread may signal.
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
+
+class RealtimeWakeEvent {
+public:
+    RealtimeWakeEvent();
+    ~RealtimeWakeEvent();
+
+    // Wakes the waiting thread, or makes its next wait() return at once.
+    // Lock-free, so safe on the audio thread.
+    void signal() noexcept {
+        int state = count.load(std::memory_order_relaxed);
+        do {
+            if (state > 0) return;  // A wake is already pending
+        } while (!count.compare_exchange_weak(state, state + 1, std::memory_order_release,
+                                              std::memory_order_relaxed));
+        if (state < 0) postSemaphore();
+    }
+
+    // Waits until signalled or `timeoutMs` has passed (negative waits
+    // forever). Returns true if signalled.
+    bool wait(int timeoutMs = -1) noexcept;
+
+private:
+    void postSemaphore() noexcept;
+    bool waitSemaphore(int timeoutMs) noexcept;
+
+    std::atomic<int> count { 0 };
+    void* semaphore = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE(RealtimeWakeEvent)
+};
@@ -0,0 +1,209 @@
+// RealtimeWorkerPool.h - Fork/join worker pool for the audio thread
+//
+// The audio thread submits a small batch of independent tasks (parallel slot
+// branches), runs tasks itself, and then waits on a lock-free completion
+// barrier. Tasks are dealt round-robin into one bounded queue per participant
+// before the workers are released; a participant drains its own queue first
+// and then steals from the others. Because every queue is filled before the
+// batch starts, "pop" and "steal" are the same atomic fetch_add on the queue
+// head, so no locks or CAS loops are involved.
+//
+// Idle workers spin briefly after each batch (consecutive audio blocks arrive
+// quickly) and then sleep on a RealtimeWakeEvent, so the pool costs nothing
+// while the transport is stopped and waking them never takes a lock. Workers
+// run at realtime priority: the audio thread spins until the tasks they took
+// are done, so a worker preempted by ordinary threads would stall the block.
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "RealtimeWakeEvent.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    #include <xmmintrin.h>
+#endif
+
+class RealtimeWorkerPool {
+public:
+    static constexpr int MAX_TASKS = 16;
+    static constexpr int MAX_WORKERS = 7;
+
+    // Tasks are plain function pointers + context so submitting never allocates
+    using TaskFunction = void(*)(void* context, int taskIndex);
+
+    // The rate and block size tell the OS scheduler how much work each
+    // audio callback period brings
+    RealtimeWorkerPool(int numWorkers, double sampleRate, int blockSize) {
+        numWorkers = juce::jlimit(0, MAX_WORKERS, numWorkers);
+        for (int i = 0; i < numWorkers; ++i)
+            workers.push_back(std::make_unique<Worker>(*this, i + 1));
+
+        const auto options = juce::Thread::RealtimeOptions{}
+                                 .withApproximateAudioProcessingTime(juce::jmax(1, blockSize), sampleRate);
+        for (auto& w : workers)
+            if (!w->startRealtimeThread(options))
+                w->startThread(juce::Thread::Priority::highest);  // e.g. no realtime permission
+    }
+
+    ~RealtimeWorkerPool() {
+        shuttingDown.store(true);
+        for (auto& w : workers) {
+            w->signalThreadShouldExit();
+            w->wake.signal();
+        }
+        for (auto& w : workers)
+            w->stopThread(1000);
+    }
+
+    int getNumWorkers() const noexcept { return (int) workers.size(); }
+
+    // Audio thread: runs `numTasks` calls of fn(context, i) across the pool and
+    // returns once all have completed. Never blocks on a lock; the only wait is
+    // a spin on the completion counter while the last tasks finish.
+    void run(TaskFunction fn, void* context, int numTasks) noexcept {
+        numTasks = juce::jmin(numTasks, MAX_TASKS);
+        if (numTasks <= 0)
+            return;
+
+        const int numParticipants = getNumWorkers() + 1;
+        if (numParticipants == 1 || numTasks == 1) {
+            for (int i = 0; i < numTasks; ++i)
+                fn(context, i);
+            return;
+        }
+
+        // Deal tasks round-robin; participant 0 is the audio thread
+        for (auto& q : queues) {
+            q.count = 0;
+            q.head.store(0, std::memory_order_relaxed);
+        }
+        for (int i = 0; i < numTasks; ++i) {
+            auto& q = queues[(size_t) (i % numParticipants)];
+            q.tasks[(size_t) q.count++] = (int8_t) i;
+        }
+
+        taskFunction = fn;
+        taskContext = context;
+        remaining.store(numTasks, std::memory_order_relaxed);
+
+        // Publish the batch, then wake anyone who has gone to sleep. Store then
+        // load on both sides (see Worker::run), so both must be seq_cst: with
+        // acquire/release each side could miss the other's store.
+        batchOpen.store(true);
+        batchGeneration.fetch_add(1);
+        for (auto& w : workers)
+            if (w->sleeping.load())
+                w->wake.signal();
+
+        runTasks(0);
+
+        // Lock-free barrier: wait for tasks stolen/run by workers to finish
+        while (remaining.load(std::memory_order_acquire) > 0)
+            spinPause();
+
+        // A worker may still be scanning the (now empty) queues; the next
+        // batch must not reset them underneath it
+        batchOpen.store(false);
+        while (busyWorkers.load() > 0)
+            spinPause();
+    }
+
+private:
+    struct alignas(64) TaskQueue {
+        std::atomic<int> head{0};
+        int count = 0;
+        std::array<int8_t, MAX_TASKS> tasks{};
+    };
+
+    class Worker : public juce::Thread {
+    public:
+        Worker(RealtimeWorkerPool& p, int index)
+            : juce::Thread("Chimera RT Worker " + juce::String(index)), pool(p), participant(index) {}
+
+        void run() override {
+            uint32_t seenGeneration = pool.batchGeneration.load(std::memory_order_acquire);
+
+            while (!threadShouldExit()) {
+                // Spin for a short while - the next block is usually imminent
+                const auto spinUntil = juce::Time::getHighResolutionTicks()
+                                     + juce::Time::getHighResolutionTicksPerSecond() / 5000; // ~200 us
+                uint32_t generation = pool.batchGeneration.load(std::memory_order_acquire);
+
+                while (generation == seenGeneration && juce::Time::getHighResolutionTicks() < spinUntil
+                       && !threadShouldExit()) {
+                    spinPause();
+                    generation = pool.batchGeneration.load(std::memory_order_acquire);
+                }
+
+                if (generation == seenGeneration) {
+                    // Go to sleep; re-check after announcing so a batch published
+                    // in between is not missed. Both seq_cst, as in the pool's
+                    // run(): either the re-check sees the new batch or the audio
+                    // thread sees us asleep.
+                    sleeping.store(true);
+                    if (pool.batchGeneration.load() == seenGeneration
+                        && !pool.shuttingDown.load())
+                        wake.wait(100);
+                    sleeping.store(false, std::memory_order_release);
+                    continue;
+                }
+
+                seenGeneration = generation;
+
+                // Announce before checking, so run() either sees us busy or
+                // we see the batch closed (all sequentially consistent)
+                pool.busyWorkers.fetch_add(1);
+                if (pool.batchOpen.load() && pool.batchGeneration.load() == generation)
+                    pool.runTasks(participant);
+                pool.busyWorkers.fetch_sub(1);
+            }
+        }
+
+        RealtimeWorkerPool& pool;
+        const int participant;
+        std::atomic<bool> sleeping{false};
+        RealtimeWakeEvent wake;
+    };
+
+    static void spinPause() noexcept {
+       #if JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+        _mm_pause();
+       #else
+        std::this_thread::yield();
+       #endif
+    }
+
+    // Own queue first, then steal round the ring
+    void runTasks(int participant) noexcept {
+        const int numParticipants = getNumWorkers() + 1;
+
+        for (int offset = 0; offset < numParticipants; ++offset) {
+            auto& q = queues[(size_t) ((participant + offset) % numParticipants)];
+            for (;;) {
+                const int slot = q.head.fetch_add(1, std::memory_order_acq_rel);
+                if (slot >= q.count)
+                    break;
+
+                taskFunction(taskContext, q.tasks[(size_t) slot]);
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+    }
+
+    std::array<TaskQueue, MAX_WORKERS + 1> queues;
+    TaskFunction taskFunction = nullptr;
+    void* taskContext = nullptr;
+    std::atomic<int> remaining{0};
+    std::atomic<uint32_t> batchGeneration{0};
+    std::atomic<bool> batchOpen{false};
+    std::atomic<int> busyWorkers{0};
+    std::atomic<bool> shuttingDown{false};
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    JUCE_DECLARE_NON_COPYABLE(RealtimeWorkerPool)
+};
@@ -0,0 +1,43 @@
+// ResetHorizon.h - Constant-time reset for delay memory
+//
+// Clearing a delay line in reset() used to mean zero-filling it, O(size) in
+// one go on whichever thread asked - megabytes at once for the long delays and
+// reverbs. A ResetHorizon makes the clear lazy instead: it counts the samples
+// written to a ring since the last reset(), and a position last written
+// before then is read as silence, which is exactly what a zero-filled ring
+// would have returned. reset() itself only zeroes the count.
+//
+// Once the ring has been written all the way round, every stale position has
+// been overwritten and isSettled() is true; readers branch on that once per
+// read (or per block) and take their plain path, so the steady state costs
+// nothing extra.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+class ResetHorizon {
+public:
+    // The ring was just zeroed, so there is nothing stale to hide
+    void prepare(size_t ringSize) noexcept {
+        size = ringSize;
+        written = ringSize;
+    }
+
+    void reset() noexcept { written = 0; }
+
+    // After writing `numWritten` more samples
+    void advance(size_t numWritten = 1) noexcept { written = std::min(size, written + numWritten); }
+
+    bool isSettled() const noexcept { return written >= size; }
+
+    // Whether the sample written `age` writes ago (0 = the latest) postdates
+    // the last reset
+    bool isFresh(size_t age) const noexcept { return age < written; }
+
+    size_t getNumWritten() const noexcept { return written; }
+
+private:
+    size_t size = 0;
+    size_t written = 0;
+};
@@ -104,6 +104,8 @@ public:
             m_target = static_cast<double>(value);
         }
         
+        float getTarget() const noexcept { return static_cast<float>(m_target); }
+        
         float process() noexcept {
             m_current = m_target + (m_current - m_target) * m_coeff;
             return static_cast<float>(m_current);
@@ -784,6 +786,17 @@ public:
     
     void setConfig(const Config& config) { m_config = config; }
     Config getConfig() const { return m_config; }
+    
+    // The longest voice delay (45 ms) recirculated by the output feedback,
+    // plus the voice filters' ring: the SVF envelope decays at k*pi*f per second
+    double getTailLengthSeconds() const noexcept {
+        const double loopSeconds = 0.045;
+        const double loopGain = std::abs((m_params.feedback.getTarget() - 0.5) * 2.0) * 0.3;
+        const double k = 2.0 - 2.0 * std::clamp(static_cast<double>(m_params.resonance.getTarget()), 0.0, 0.99);
+        const double freq = 20.0 + m_params.filterFreq.getTarget() * 19980.0;
+        const double ringSeconds = (-ChimeraConfig::ENGINE_TAIL_THRESHOLD_DB / 20.0) * std::log(10.0) / (k * M_PI * freq);
+        return EngineBase::getFeedbackTailSeconds(loopSeconds, loopGain) + ringSeconds;
+    }
 };
 
 // Initialize static members of TableLFO
@@ -878,6 +891,10 @@ ResonantChorus_Platinum::Config ResonantChorus_Platinum::getConfig() const {
     return pImpl->getConfig();
 }
 
+double ResonantChorus_Platinum::getTailLengthSeconds() const noexcept {
+    return pImpl->getTailLengthSeconds();
+}
+
 void ResonantChorus_Platinum::setLFOShape(LFOShape shape) {
     pImpl->setLFOShape(shape);
 }
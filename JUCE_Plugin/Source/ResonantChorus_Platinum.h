@@ -40,6 +40,7 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    double getTailLengthSeconds() const noexcept override;
     
     // Parameter interface
     int getNumParameters() const override { return 8; }
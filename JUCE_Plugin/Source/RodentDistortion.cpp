@@ -26,111 +26,10 @@ RodentDistortion::RodentDistortion() {
     m_distortionType->reset(0.0); // RAT mode
     m_presence->reset(0.3);       // Subtle presence
     
-    // Initialize oversamplers
-    for (int i = 0; i < 2; ++i) {
-        m_oversamplers[i] = std::make_unique<Oversampler>();
-    }
-    
     // Initialize feedback arrays and processing buffers
     m_fuzzFaceFeedback.fill(0.0);
 }
 
-// ==================== ELLIPTIC FILTER DESIGN ====================
-
-void RodentDistortion::EllipticFilter::design(double normalizedFreq, double passbandRipple, double stopbandAtten) {
-    // 8th-order elliptic filter design
-    // This is a simplified version - in production, use a proper filter design library
-    
-    // Pre-warped frequency
-    double wp = 2.0 * std::tan(M_PI * normalizedFreq);
-    
-    // For an 8th order elliptic with 0.1dB ripple and 80dB stopband
-    // These are pre-calculated coefficients for common case
-    if (std::abs(normalizedFreq - 0.1125) < 0.001) { // 0.45/4 for 4x oversampling
-        // Stage 1
-        coeffs[0] = {
-            0.0009441, 0.0018881, 0.0009441,
-            -1.911198, 0.914974
-        };
-        
-        // Stage 2
-        coeffs[1] = {
-            0.003789, 0.007578, 0.003789,
-            -1.815893, 0.831049
-        };
-        
-        // Stage 3
-        coeffs[2] = {
-            0.013657, 0.027314, 0.013657,
-            -1.632993, 0.687621
-        };
-        
-        // Stage 4
-        coeffs[3] = {
-            0.042659, 0.085318, 0.042659,
-            -1.378091, 0.548728
-        };
-    } else {
-        // Generic butterworth as fallback
-        double Q[4] = {0.5412, 1.3065, 0.5412, 1.3065};
-        
-        for (int i = 0; i < 4; ++i) {
-            double w0 = wp;
-            double cosw0 = std::cos(w0);
-            double sinw0 = std::sin(w0);
-            double alpha = sinw0 / (2.0 * Q[i]);
-            
-            double b0 = (1.0 - cosw0) / 2.0;
-            double b1 = 1.0 - cosw0;
-            double b2 = (1.0 - cosw0) / 2.0;
-            double a0 = 1.0 + alpha;
-            double a1 = -2.0 * cosw0;
-            double a2 = 1.0 - alpha;
-            
-            // Normalize
-            coeffs[i] = {
-                b0/a0, b1/a0, b2/a0,
-                a1/a0, a2/a0
-            };
-        }
-    }
-}
-
-// ==================== OVERSAMPLER ====================
-
-void RodentDistortion::Oversampler::upsample(const double* input, double* output, int numSamples) {
-    // Zero-stuff and filter
-    int outputIdx = 0;
-    
-    for (int i = 0; i < numSamples; ++i) {
-        // Insert input sample
-        output[outputIdx] = upsampleFilter.process(input[i] * FACTOR);
-        outputIdx++;
-        
-        // Insert zeros
-        for (int j = 1; j < FACTOR; ++j) {
-            output[outputIdx] = upsampleFilter.process(0.0);
-            outputIdx++;
-        }
-    }
-}
-
-void RodentDistortion::Oversampler::downsample(const double* input, double* output, int numSamples) {
-    // Filter and decimate
-    int inputIdx = 0;
-    
-    for (int i = 0; i < numSamples; ++i) {
-        // Apply anti-aliasing filter to all samples
-        double filtered = 0.0;
-        for (int j = 0; j < FACTOR; ++j) {
-            filtered = downsampleFilter.process(input[inputIdx++]);
-        }
-        
-        // Take only the last filtered sample (after the zeros have been processed)
-        output[i] = filtered;
-    }
-}
-
 // ==================== MAIN PROCESSING ====================
 
 void RodentDistortion::prepareToPlay(double sampleRate, int samplesPerBlock) {
@@ -158,23 +57,58 @@ void RodentDistortion::prepareToPlay(double sampleRate, int samplesPerBlock) {
     
     // Initialize filters
     // Pre-allocate processing buffers to avoid dynamic allocation in audio thread
-    const int oversampledSize = samplesPerBlock * DistortionConstants::OVERSAMPLE_FACTOR;
     m_inputDouble.resize(samplesPerBlock);
-    m_oversampledInput.resize(oversampledSize);
-    m_oversampledOutput.resize(oversampledSize);
     m_outputDouble.resize(samplesPerBlock);
     
+    // Prepare oversampling (minimum phase: no added latency worth reporting)
+    m_oversampler.prepare(2, samplesPerBlock, DistortionConstants::MAX_OVERSAMPLE_FACTOR,
+                          PolyphaseOversampler::Phase::Minimum);
+    
     for (int ch = 0; ch < 2; ++ch) {
         m_inputFilters[ch].updateCoefficients(2000.0, 0.7, sampleRate);
         m_toneFilters[ch].updateCoefficients(5000.0, 0.5, sampleRate);
+        m_midHumpFilters[ch].updateCoefficients(2000.0, 0.7, sampleRate);
+        m_presenceFilters[ch].updateCoefficients(5000.0, 0.5, sampleRate);
         
-        // Prepare oversampling
-        m_oversamplers[ch]->prepare(samplesPerBlock, sampleRate);
+        // ADAA curves
+        auto& shapers = m_shapers[ch];
+        shapers.ratInput.setCurve(AdaaCurves::tanh());
+        shapers.ratDiodes.setCurve(ratDiodeTable());
+        for (int stage = 0; stage < 3; ++stage) {
+            shapers.muffStages[stage].setCurve(muffStageTable(stage));
+        }
+        shapers.softLimit.setCurve(softLimitTable());
+        shapers.outputLimit.setCurve(AdaaCurves::tanh());
         
         // DC blockers - 20Hz highpass
         m_inputDCBlockers[ch].setCutoff(20.0, sampleRate);
         m_outputDCBlockers[ch].setCutoff(20.0, sampleRate);
     }
+    
+    applyAntialiasingPlan();
+}
+
+void RodentDistortion::setQuality(Quality q) {
+    m_quality = q;
+    applyAntialiasingPlan();
+}
+
+void RodentDistortion::setAntialiasingMode(AntialiasingMode mode) {
+    m_antialiasingMode = mode;
+    applyAntialiasingPlan();
+}
+
+void RodentDistortion::applyAntialiasingPlan() {
+    const auto plan = antialiasingForQuality(m_quality, m_antialiasingMode,
+                                             DistortionConstants::MAX_OVERSAMPLE_FACTOR);
+    m_oversampler.setFactor(plan.factor);
+    m_oversampledRate = m_sampleRate * m_oversampler.getFactor();
+    m_adaaOrder = plan.adaaOrder;
+    
+    for (int ch = 0; ch < 2; ++ch) {
+        m_shapers[ch].forEach([this](auto& shaper) { shaper.setOrder(m_adaaOrder); });
+        m_coeffCounters[ch] = 0; // filters pick up the new rate on the next sample
+    }
 }
 
 void RodentDistortion::reset() {
@@ -182,19 +116,21 @@ void RodentDistortion::reset() {
     for (int ch = 0; ch < 2; ++ch) {
         m_inputFilters[ch].reset();
         m_toneFilters[ch].reset();
-        m_oversamplers[ch]->reset();
+        m_midHumpFilters[ch].reset();
+        m_presenceFilters[ch].reset();
         m_inputDCBlockers[ch].reset();
         m_outputDCBlockers[ch].reset();
         m_opAmps[ch].reset();
+        m_shapers[ch].forEach([](auto& shaper) { shaper.reset(); });
+        m_coeffCounters[ch] = 0;
     }
+    m_oversampler.reset();
     
     // Clear fuzz face feedback
     m_fuzzFaceFeedback.fill(0.0);
     
     // Clear processing buffers
     std::fill(m_inputDouble.begin(), m_inputDouble.end(), 0.0);
-    std::fill(m_oversampledInput.begin(), m_oversampledInput.end(), 0.0);
-    std::fill(m_oversampledOutput.begin(), m_oversampledOutput.end(), 0.0);
     std::fill(m_outputDouble.begin(), m_outputDouble.end(), 0.0);
 }
 
@@ -216,18 +152,10 @@ void RodentDistortion::process(juce::AudioBuffer<float>& buffer) {
     }
     
     // Use pre-allocated buffers (no dynamic allocation in audio thread)
-    const int oversampledSize = numSamples * DistortionConstants::OVERSAMPLE_FACTOR;
-    
     // Ensure buffers are large enough (shouldn't need to resize in normal operation)
     if (m_inputDouble.size() < static_cast<size_t>(numSamples)) {
         m_inputDouble.resize(numSamples);
     }
-    if (m_oversampledInput.size() < static_cast<size_t>(oversampledSize)) {
-        m_oversampledInput.resize(oversampledSize);
-    }
-    if (m_oversampledOutput.size() < static_cast<size_t>(oversampledSize)) {
-        m_oversampledOutput.resize(oversampledSize);
-    }
     if (m_outputDouble.size() < static_cast<size_t>(numSamples)) {
         m_outputDouble.resize(numSamples);
     }
@@ -246,115 +174,27 @@ void RodentDistortion::process(juce::AudioBuffer<float>& buffer) {
             m_inputDouble[i] = m_inputDCBlockers[ch].process(m_inputDouble[i]);
         }
         
-        // Upsample
-        m_oversamplers[ch]->upsample(m_inputDouble.data(), m_oversampledInput.data(), numSamples);
-        
-        // Process at oversampled rate
-        for (int i = 0; i < oversampledSize; ++i) {
-            // Update parameters (at oversampled rate for smooth operation)
-            double gain = m_gain->process();
-            double filterFreq = DistortionConstants::MIN_FILTER_HZ + 
-                               m_filter->process() * (DistortionConstants::MAX_FILTER_HZ - 
-                                                     DistortionConstants::MIN_FILTER_HZ);
-            double clipping = m_clipping->process();
-            double toneFreq = DistortionConstants::MIN_TONE_HZ + 
-                             m_tone->process() * (DistortionConstants::MAX_TONE_HZ - 
-                                                 DistortionConstants::MIN_TONE_HZ);
-            double outputGain = m_output->process();
-            double presence = m_presence->process();
-            double distMode = m_distortionType->process();
-            
-            // Update filter frequencies (only when changed significantly)
-            if (i % 16 == 0) { // Update every 16 samples to save CPU
-                m_inputFilters[ch].updateCoefficients(filterFreq, 0.7, m_sampleRate * DistortionConstants::OVERSAMPLE_FACTOR);
-                m_toneFilters[ch].updateCoefficients(toneFreq, 0.5, m_sampleRate * DistortionConstants::OVERSAMPLE_FACTOR);
-            }
-            
-            // Get sample
-            double sample = m_oversampledInput[i];
-            
-            // Input filter (highpass to remove mud)
-            auto filterOut = m_inputFilters[ch].process(sample);
-            sample = filterOut.highpass;
-            
-            // Apply gain with safety limits
-            double gainDB = DistortionConstants::MIN_GAIN_DB + 
-                           gain * (DistortionConstants::MAX_GAIN_DB - DistortionConstants::MIN_GAIN_DB);
-            // Clamp gain to safe range to prevent std::pow overflow
-            gainDB = std::clamp(gainDB, -60.0, 60.0);
-            double gainLinear = std::pow(10.0, gainDB / 20.0);
-            // Additional safety clamp on linear gain
-            gainLinear = std::clamp(gainLinear, 0.001, 1000.0);
-            sample *= gainLinear;
-            
-            // Safety check for NaN/Inf
-            if (!std::isfinite(sample)) {
-                sample = 0.0;
-            }
-            
-            // Distortion based on mode with bounds checking
-            int mode = std::clamp(static_cast<int>(distMode * 3.99), 0, 3);
-            switch (static_cast<VintageMode>(mode)) {
-                case VintageMode::RAT:
-                    sample = processRATCircuit(sample, ch);
-                    break;
-                case VintageMode::TUBE_SCREAMER:
-                    sample = processTubeScreamerCircuit(sample, ch);
-                    break;
-                case VintageMode::BIG_MUFF:
-                    sample = processBigMuffCircuit(sample, ch);
-                    break;
-                case VintageMode::FUZZ_FACE:
-                    sample = processFuzzFaceCircuit(sample, ch);
-                    break;
-                default:
-                    // Fallback to RAT mode if something goes wrong
-                    sample = processRATCircuit(sample, ch);
-                    break;
-            }
-            
-            // Presence control (high frequency emphasis)
-            if (presence > 0.01) {
-                auto toneOut = m_toneFilters[ch].process(sample);
-                double highFreq = toneOut.highpass;
-                sample += highFreq * presence * 2.0;
-            }
-            
-            // Tone control (lowpass)
-            auto toneOut = m_toneFilters[ch].process(sample);
-            sample = toneOut.lowpass;
-            
-            // Output gain with proper scaling
-            sample *= outputGain * 1.5; // 0-1.5 range for more reasonable output
-            
-            // Final safety check before output
-            if (!std::isfinite(sample)) {
-                sample = 0.0;
-            }
-            
-            // Soft limiting for safety
-            sample = tanhApproximation(sample * 0.5) * 2.0;
-            
-            // Final NaN/Inf check
-            if (!std::isfinite(sample)) {
-                sample = 0.0;
-            }
-            
-            // Store processed wet signal (no mixing here - will be mixed at final output)
-            m_oversampledOutput[i] = sample;
+        // Circuit at the oversampled rate
+        for (int i = 0; i < numSamples; ++i) {
+            m_outputDouble[i] = m_oversampler.processSample(ch, static_cast<float>(m_inputDouble[i]),
+                [this, ch](float x) { return static_cast<float>(processOversampledSample(x, ch)); });
         }
         
-        // Downsample
-        m_oversamplers[ch]->downsample(m_oversampledOutput.data(), m_outputDouble.data(), numSamples);
-        
         // DC blocking on output
         for (int i = 0; i < numSamples; ++i) {
             m_outputDouble[i] = m_outputDCBlockers[ch].process(m_outputDouble[i]);
         }
         
         // Final soft limiting for safety
-        for (int i = 0; i < numSamples; ++i) {
-            m_outputDouble[i] = std::tanh(m_outputDouble[i] * 0.8) * 1.25;
+        if (m_adaaOrder > 0) {
+            auto& outputLimit = m_shapers[ch].outputLimit;
+            for (int i = 0; i < numSamples; ++i) {
+                m_outputDouble[i] = outputLimit.process(m_outputDouble[i] * 0.8) * 1.25;
+            }
+        } else {
+            for (int i = 0; i < numSamples; ++i) {
+                m_outputDouble[i] = std::tanh(m_outputDouble[i] * 0.8) * 1.25;
+            }
         }
         
         // Mix dry/wet and convert back to float
@@ -373,6 +213,109 @@ void RodentDistortion::process(juce::AudioBuffer<float>& buffer) {
     scrubBuffer(buffer);
 }
 
+double RodentDistortion::processOversampledSample(double sample, int ch) {
+    // Update parameters (at oversampled rate for smooth operation)
+    double gain = m_gain->process();
+    double filterFreq = DistortionConstants::MIN_FILTER_HZ + 
+                       m_filter->process() * (DistortionConstants::MAX_FILTER_HZ - 
+                                             DistortionConstants::MIN_FILTER_HZ);
+    m_clipping->process();
+    double toneFreq = DistortionConstants::MIN_TONE_HZ + 
+                     m_tone->process() * (DistortionConstants::MAX_TONE_HZ - 
+                                         DistortionConstants::MIN_TONE_HZ);
+    double outputGain = m_output->process();
+    double presence = m_presence->process();
+    double distMode = m_distortionType->process();
+    
+    // Update filter frequencies (only when changed significantly)
+    if (m_coeffCounters[ch]++ % 16 == 0) { // Update every 16 samples to save CPU
+        m_inputFilters[ch].updateCoefficients(filterFreq, 0.7, m_oversampledRate);
+        m_toneFilters[ch].updateCoefficients(toneFreq, 0.5, m_oversampledRate);
+        m_midHumpFilters[ch].updateCoefficients(filterFreq, 0.7, m_oversampledRate);
+        m_presenceFilters[ch].updateCoefficients(toneFreq, 0.5, m_oversampledRate);
+    }
+    
+    // Input filter (highpass to remove mud)
+    auto filterOut = m_inputFilters[ch].process(sample);
+    sample = filterOut.highpass;
+    
+    // Apply gain with safety limits
+    double gainDB = DistortionConstants::MIN_GAIN_DB + 
+                   gain * (DistortionConstants::MAX_GAIN_DB - DistortionConstants::MIN_GAIN_DB);
+    // Clamp gain to safe range to prevent std::pow overflow
+    gainDB = std::clamp(gainDB, -60.0, 60.0);
+    double gainLinear = std::pow(10.0, gainDB / 20.0);
+    // Additional safety clamp on linear gain
+    gainLinear = std::clamp(gainLinear, 0.001, 1000.0);
+    sample *= gainLinear;
+    
+    // Safety check for NaN/Inf
+    if (!std::isfinite(sample)) {
+        sample = 0.0;
+    }
+    
+    // Distortion based on mode with bounds checking
+    int mode = std::clamp(static_cast<int>(distMode * 3.99), 0, 3);
+    if (mode != m_lastMode[ch]) {
+        // The circuit shapers hold stale history from their last use
+        auto& shapers = m_shapers[ch];
+        shapers.ratInput.reset();
+        shapers.ratDiodes.reset();
+        for (auto& stage : shapers.muffStages) stage.reset();
+        m_lastMode[ch] = mode;
+    }
+    switch (static_cast<VintageMode>(mode)) {
+        case VintageMode::RAT:
+            sample = processRATCircuit(sample, ch);
+            break;
+        case VintageMode::TUBE_SCREAMER:
+            sample = processTubeScreamerCircuit(sample, ch);
+            break;
+        case VintageMode::BIG_MUFF:
+            sample = processBigMuffCircuit(sample, ch);
+            break;
+        case VintageMode::FUZZ_FACE:
+            sample = processFuzzFaceCircuit(sample, ch);
+            break;
+        default:
+            // Fallback to RAT mode if something goes wrong
+            sample = processRATCircuit(sample, ch);
+            break;
+    }
+    
+    // Presence control (high frequency emphasis). Its own filter: through the
+    // tone filter the boost fed back into itself and ran away below 4x.
+    if (presence > 0.01) {
+        auto toneOut = m_presenceFilters[ch].process(sample);
+        double highFreq = toneOut.highpass;
+        sample += highFreq * presence * 2.0;
+    }
+    
+    // Tone control (lowpass)
+    auto toneOut = m_toneFilters[ch].process(sample);
+    sample = toneOut.lowpass;
+    
+    // Output gain with proper scaling
+    sample *= outputGain * 1.5; // 0-1.5 range for more reasonable output
+    
+    // Final safety check before output
+    if (!std::isfinite(sample)) {
+        sample = 0.0;
+    }
+    
+    // Soft limiting for safety
+    sample = (m_adaaOrder > 0 ? m_shapers[ch].softLimit.process(sample * 0.5)
+                              : tanhApproximation(sample * 0.5)) * 2.0;
+    
+    // Final NaN/Inf check
+    if (!std::isfinite(sample)) {
+        sample = 0.0;
+    }
+    
+    // Processed wet signal (no mixing here - will be mixed at final output)
+    return sample;
+}
+
 // ==================== CIRCUIT MODELS ====================
 
 double RodentDistortion::processRATCircuit(double input, int channel) {
@@ -382,25 +325,15 @@ double RodentDistortion::processRATCircuit(double input, int channel) {
     double opAmpGain = 1.0 + clippingAmount * 20.0; // Reduced to reasonable 20x max gain
     opAmpGain = std::clamp(opAmpGain, 1.0, 25.0); // Hard limit to prevent extreme values
     
+    auto& shapers = m_shapers[channel];
+    
     // Soft saturation before op-amp to prevent excessive peaks
-    input = std::tanh(input * 0.7) * 1.43;
+    input = (m_adaaOrder > 0 ? shapers.ratInput.process(input * 0.7) : std::tanh(input * 0.7)) * 1.43;
     
-    double output = m_opAmps[channel].process(input, opAmpGain, 
-                                              m_sampleRate * DistortionConstants::OVERSAMPLE_FACTOR);
+    double output = m_opAmps[channel].process(input, opAmpGain, m_oversampledRate);
     
     // Asymmetric clipping diodes (more musical)
-    const double diodeThresholdPos = 0.7;
-    const double diodeThresholdNeg = -0.65; // Slight asymmetry
-    
-    if (output > diodeThresholdPos) {
-        // Soft knee clipping
-        double excess = output - diodeThresholdPos;
-        output = diodeThresholdPos + std::tanh(excess * 2.0) * 0.1;
-    } else if (output < diodeThresholdNeg) {
-        // Soft knee clipping
-        double excess = output - diodeThresholdNeg;
-        output = diodeThresholdNeg + std::tanh(excess * 2.0) * 0.1;
-    }
+    output = m_adaaOrder > 0 ? shapers.ratDiodes.process(output) : ratDiodeKnee(output);
     
     // Gain compensation based on clipping amount
     double compensation = 1.0 / (1.0 + clippingAmount * 0.5);
@@ -415,8 +348,9 @@ double RodentDistortion::processRATCircuit(double input, int channel) {
 
 double RodentDistortion::processTubeScreamerCircuit(double input, int channel) {
     // Ibanez Tube Screamer circuit emulation
-    // Characteristic mid-hump EQ (before clipping)
-    auto filtered = m_inputFilters[channel].process(input);
+    // Characteristic mid-hump EQ (before clipping). Its own filter: sharing
+    // the input highpass fed the amplified signal back into the gain stage.
+    auto filtered = m_midHumpFilters[channel].process(input);
     double midBoosted = filtered.bandpass * 2.0 + input * 0.5;
     
     // Op-amp gain stage (lower gain than RAT)
@@ -431,11 +365,14 @@ double RodentDistortion::processTubeScreamerCircuit(double input, int channel) {
         clipped = m_diodeClippers[channel].process(clipped * 0.9, false);
     }
     
-    // Safety check
+    // Safety check. The exponential diode runs away past a volt (to 1e300
+    // and beyond); anything past a few volts ends at the output limiter's
+    // ceiling regardless, so bound it before it overflows the filters and
+    // the limiter's antiderivatives.
     if (!std::isfinite(clipped)) {
         clipped = 0.0;
     }
-    return clipped * 0.3;
+    return std::clamp(clipped, -100.0, 100.0) * 0.3;
 }
 
 double RodentDistortion::processBigMuffCircuit(double input, int channel) {
@@ -443,13 +380,16 @@ double RodentDistortion::processBigMuffCircuit(double input, int channel) {
     // Multiple gain stages with clipping
     double signal = input;
     
+    auto& stages = m_shapers[channel].muffStages;
+    const bool adaa = m_adaaOrder > 0;
+    
     // First gain stage
     signal *= 50.0 * (0.5 + m_clipping->getCurrent());
-    signal = softClipAsymmetric(signal, 0.3);
+    signal = adaa ? stages[0].process(signal) : softClipAsymmetric(signal, 0.3);
     
     // Second gain stage
     signal *= 20.0;
-    signal = softClipAsymmetric(signal, 0.5);
+    signal = adaa ? stages[1].process(signal) : softClipAsymmetric(signal, 0.5);
     
     // Tone control (special Big Muff style)
     // This is a simplified version of the actual tone stack
@@ -459,7 +399,7 @@ double RodentDistortion::processBigMuffCircuit(double input, int channel) {
     
     // Final gain stage
     signal *= 10.0;
-    signal = softClipAsymmetric(signal, 0.2);
+    signal = adaa ? stages[2].process(signal) : softClipAsymmetric(signal, 0.2);
     
     // Safety check
     if (!std::isfinite(signal)) {
@@ -528,6 +468,43 @@ double RodentDistortion::softClipAsymmetric(double x, double amount) {
     return positive - negative;
 }
 
+double RodentDistortion::ratDiodeKnee(double x) {
+    const double diodeThresholdPos = 0.7;
+    const double diodeThresholdNeg = -0.65; // Slight asymmetry
+    
+    // Soft knee clipping
+    if (x > diodeThresholdPos) {
+        return diodeThresholdPos + std::tanh((x - diodeThresholdPos) * 2.0) * 0.1;
+    }
+    if (x < diodeThresholdNeg) {
+        return diodeThresholdNeg + std::tanh((x - diodeThresholdNeg) * 2.0) * 0.1;
+    }
+    return x;
+}
+
+// ==================== ADAA TABLES ====================
+// The op-amp saturates inside +-7.5 V; the Big Muff stages and the limiter
+// have flattened out by +-4.
+
+const AdaaTable& RodentDistortion::ratDiodeTable() {
+    static const AdaaTable table(ratDiodeKnee, 8.0);
+    return table;
+}
+
+const AdaaTable& RodentDistortion::muffStageTable(int stage) {
+    static const AdaaTable tables[3] = {
+        AdaaTable([](double x) { return softClipAsymmetric(x, 0.3); }, 4.0),
+        AdaaTable([](double x) { return softClipAsymmetric(x, 0.5); }, 4.0),
+        AdaaTable([](double x) { return softClipAsymmetric(x, 0.2); }, 4.0)
+    };
+    return tables[stage];
+}
+
+const AdaaTable& RodentDistortion::softLimitTable() {
+    static const AdaaTable table(tanhApproximation, 4.0);
+    return table;
+}
+
 // ==================== PARAMETER HANDLING ====================
 
 void RodentDistortion::updateParameters(const std::map<int, float>& params) {
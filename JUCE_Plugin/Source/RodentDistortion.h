@@ -1,5 +1,7 @@
 #pragma once
 #include "EngineBase.h"
+#include "PolyphaseOversampler.h"
+#include "AntiderivativeShaper.h"
 #include <vector>
 #include <array>
 #include <memory>
@@ -31,8 +33,7 @@ namespace DistortionConstants {
     constexpr double TS_DIODE_N = 1.752;          // 1N4148 ideality factor
     
     // Oversampling
-    constexpr int OVERSAMPLE_FACTOR = 4;
-    constexpr double OVERSAMPLE_CUTOFF = 0.45;     // Normalized frequency
+    constexpr int MAX_OVERSAMPLE_FACTOR = 4;
     
     // Parameter ranges
     constexpr double MIN_GAIN_DB = 0.0;
@@ -55,6 +56,12 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override;
+    
+    // Antiderivative (default): ADAA on the RAT and Big Muff clippers and the
+    // output limiters, at 1x up to Normal and 2x from High (2nd order at Ultra).
+    // Oversampling: the plain curves at up to 4x, as before ADAA.
+    void setAntialiasingMode(AntialiasingMode mode);
     
     juce::String getName() const override { return "Rodent Distortion"; }
     int getNumParameters() const override { return 8; }
@@ -146,88 +153,6 @@ private:
         }
     };
     
-    // Professional 8th-order Elliptic Filter for anti-aliasing
-    class EllipticFilter {
-        struct BiquadCoeffs {
-            double b0, b1, b2, a1, a2;
-        };
-        
-        struct BiquadState {
-            double x1 = 0.0, x2 = 0.0;
-            double y1 = 0.0, y2 = 0.0;
-            
-            FORCE_INLINE double process(double input, const BiquadCoeffs& c) {
-                double output = c.b0 * input + c.b1 * x1 + c.b2 * x2
-                               - c.a1 * y1 - c.a2 * y2;
-
-                x2 = x1; x1 = input;
-                y2 = y1; y1 = output;
-
-                // Denormal prevention for all states
-                x1 += DistortionConstants::DENORMAL_PREVENTION;
-                x1 -= DistortionConstants::DENORMAL_PREVENTION;
-                x2 += DistortionConstants::DENORMAL_PREVENTION;
-                x2 -= DistortionConstants::DENORMAL_PREVENTION;
-                y1 += DistortionConstants::DENORMAL_PREVENTION;
-                y1 -= DistortionConstants::DENORMAL_PREVENTION;
-                y2 += DistortionConstants::DENORMAL_PREVENTION;
-                y2 -= DistortionConstants::DENORMAL_PREVENTION;
-
-                return output;
-            }
-            
-            void reset() {
-                x1 = x2 = y1 = y2 = 0.0;
-            }
-        };
-        
-        std::array<BiquadCoeffs, 4> coeffs;
-        std::array<BiquadState, 4> states;
-        
-    public:
-        void design(double normalizedFreq, double passbandRipple = 0.1, double stopbandAtten = 80.0);
-        
-        FORCE_INLINE double process(double input) {
-            double output = input;
-            for (size_t i = 0; i < 4; ++i) {
-                output = states[i].process(output, coeffs[i]);
-            }
-            return output;
-        }
-        
-        void reset() {
-            for (auto& state : states) {
-                state.reset();
-            }
-        }
-    };
-    
-    // High-quality oversampler
-    class Oversampler {
-        static constexpr int FACTOR = DistortionConstants::OVERSAMPLE_FACTOR;
-        EllipticFilter upsampleFilter;
-        EllipticFilter downsampleFilter;
-        std::vector<double> oversampledBuffer;
-        
-    public:
-        void prepare(int blockSize, double sampleRate) {
-            oversampledBuffer.resize(blockSize * FACTOR);
-            
-            // Design steep elliptic filters
-            double normalizedCutoff = DistortionConstants::OVERSAMPLE_CUTOFF / FACTOR;
-            upsampleFilter.design(normalizedCutoff);
-            downsampleFilter.design(normalizedCutoff);
-        }
-        
-        void upsample(const double* input, double* output, int numSamples);
-        void downsample(const double* input, double* output, int numSamples);
-        
-        void reset() {
-            upsampleFilter.reset();
-            downsampleFilter.reset();
-        }
-    };
-    
     // Accurate analog component models
     class AnalogComponents {
     public:
@@ -382,9 +307,32 @@ private:
     // Filters (stereo)
     std::array<ZDFStateVariable, 2> m_inputFilters;
     std::array<ZDFStateVariable, 2> m_toneFilters;
+    std::array<ZDFStateVariable, 2> m_midHumpFilters; // Tube Screamer, after the gain
+    std::array<ZDFStateVariable, 2> m_presenceFilters;
     
-    // Oversampling
-    std::array<std::unique_ptr<Oversampler>, 2> m_oversamplers;
+    // Oversampling and ADAA
+    PolyphaseOversampler m_oversampler;
+    Quality m_quality = Quality::Ultra;
+    AntialiasingMode m_antialiasingMode = AntialiasingMode::Antiderivative;
+    int m_adaaOrder = 0;
+    double m_oversampledRate = 44100.0 * DistortionConstants::MAX_OVERSAMPLE_FACTOR;
+    
+    struct CircuitShapers {
+        AntiderivativeShaper<> ratInput, ratDiodes;
+        std::array<AntiderivativeShaper<>, 3> muffStages;
+        AntiderivativeShaper<> softLimit, outputLimit;
+        
+        template <typename Fn> void forEach(Fn&& fn) {
+            fn(ratInput); fn(ratDiodes);
+            for (auto& stage : muffStages) fn(stage);
+            fn(softLimit); fn(outputLimit);
+        }
+    };
+    std::array<CircuitShapers, 2> m_shapers;
+    std::array<int, 2> m_lastMode{{-1, -1}};
+    std::array<int, 2> m_coeffCounters{{0, 0}};
+    
+    void applyAntialiasingPlan();
     
     // Analog models
     std::array<AnalogComponents::OpAmpLM308, 2> m_opAmps;
@@ -423,10 +371,11 @@ private:
     
     // Pre-allocated processing buffers (thread-safe, no dynamic allocation)
     std::vector<double> m_inputDouble;
-    std::vector<double> m_oversampledInput;
-    std::vector<double> m_oversampledOutput;
     std::vector<double> m_outputDouble;
     
+    // One sample at the oversampled rate: filters, gain, circuit, tone, limiter
+    double processOversampledSample(double sample, int channel);
+    
     // Circuit-specific processing
     double processRATCircuit(double input, int channel);
     double processTubeScreamerCircuit(double input, int channel);
@@ -439,4 +388,10 @@ private:
     // Helper functions
     static double tanhApproximation(double x);
     static double softClipAsymmetric(double x, double amount);
+    static double ratDiodeKnee(double x);
+    
+    // ADAA tables of the static curves above, built on first use
+    static const AdaaTable& ratDiodeTable();
+    static const AdaaTable& muffStageTable(int stage);
+    static const AdaaTable& softLimitTable();
 };
\ No newline at end of file
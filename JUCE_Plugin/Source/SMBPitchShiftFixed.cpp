@@ -71,13 +71,8 @@ public:
     }
 
     void processWithRatio(const float* input, float* output, int numSamples, float pitchRatio) {
-        if (std::abs(pitchRatio - 1.0f) < 0.001f) {
-            // No pitch shift - just copy
-            if (input != output) {
-                std::copy(input, input + numSamples, output);
-            }
-            return;
-        }
+        // Unity still runs through the stretcher: copying would drop the
+        // latency this reports and jump the signal on the way in and out
 
         // Update transpose factor if changed
         if (std::abs(pitchRatio - currentPitchRatio) > 0.0001f) {
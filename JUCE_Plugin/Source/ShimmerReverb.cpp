@@ -3,119 +3,26 @@
 // Based on established DSP techniques used in commercial shimmer reverbs
 
 #include "ShimmerReverb.h"
+#include "FreeverbCore.h"
+#include "ResetHorizon.h"
 #include <JuceHeader.h>
 #include <cmath>
 #include <algorithm>
 
 namespace {
     // Freeverb constants for the reverb engine
-    const int numCombs = 8;
-    const int numAllpasses = 4;
     const float fixedGain = 0.015f;
     const float scaleDamp = 0.4f;
     const float scaleRoom = 0.28f;
     const float offsetRoom = 0.7f;
     const int stereoSpread = 89;  // Increased from 67 to 89 for even wider stereo image
     
-    // Freeverb delay times (44100Hz)
-    const int combTuning[8] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
-    const int allpassTuning[4] = { 556, 441, 341, 225 };
-    
     // Pitch shifter constants
     const int pitchBufferSize = 4096;
     const int grainSize = 1024;
     const int numGrains = 2;
 }
 
-// Simple comb filter from Freeverb
-class Comb {
-public:
-    void setBuffer(float *buf, int size) {
-        buffer = buf;
-        bufferSize = size;
-        bufferIndex = 0;
-    }
-    
-    void mute() {
-        if (buffer) {
-            std::fill(buffer, buffer + bufferSize, 0.0f);
-        }
-        filterStore = 0.0f;
-    }
-    
-    void setDamp(float val) {
-        damp1 = val;
-        damp2 = 1.0f - val;
-    }
-    
-    void setFeedback(float val) {
-        feedback = val;
-    }
-    
-    float process(float input) {
-        if (!buffer || bufferSize == 0) return 0.0f;
-        
-        float output = buffer[bufferIndex];
-        filterStore = (output * damp2) + (filterStore * damp1);
-        buffer[bufferIndex] = input + (filterStore * feedback);
-        
-        if (++bufferIndex >= bufferSize) {
-            bufferIndex = 0;
-        }
-        
-        return output;
-    }
-    
-private:
-    float *buffer = nullptr;
-    int bufferSize = 0;
-    int bufferIndex = 0;
-    float filterStore = 0.0f;
-    float damp1 = 0.0f;
-    float damp2 = 1.0f;
-    float feedback = 0.0f;
-};
-
-// Simple allpass filter from Freeverb
-class Allpass {
-public:
-    void setBuffer(float *buf, int size) {
-        buffer = buf;
-        bufferSize = size;
-        bufferIndex = 0;
-    }
-    
-    void mute() {
-        if (buffer) {
-            std::fill(buffer, buffer + bufferSize, 0.0f);
-        }
-    }
-    
-    void setFeedback(float val) {
-        feedback = val;
-    }
-    
-    float process(float input) {
-        if (!buffer || bufferSize == 0) return 0.0f;
-        
-        float bufout = buffer[bufferIndex];
-        float output = -input + bufout;
-        buffer[bufferIndex] = input + (bufout * feedback);
-        
-        if (++bufferIndex >= bufferSize) {
-            bufferIndex = 0;
-        }
-        
-        return output;
-    }
-    
-private:
-    float *buffer = nullptr;
-    int bufferSize = 0;
-    int bufferIndex = 0;
-    float feedback = 0.5f;
-};
-
 // Simple pitch shifter using granular technique
 class SimplePitchShifter {
 public:
@@ -197,17 +104,8 @@ private:
 // Main ShimmerReverb implementation
 class ShimmerReverb::Impl {
 public:
-    // Freeverb components
-    Comb combL[numCombs];
-    Comb combR[numCombs];
-    Allpass allpassL[numAllpasses];
-    Allpass allpassR[numAllpasses];
-    
-    // Buffers for Freeverb
-    std::vector<float> combBufferL[numCombs];
-    std::vector<float> combBufferR[numCombs];
-    std::vector<float> allpassBufferL[numAllpasses];
-    std::vector<float> allpassBufferR[numAllpasses];
+    // Freeverb combs and allpasses, both channels
+    FreeverbCore tank;
     
     // Pitch shifters for shimmer - initialize with different phase offsets for stereo width
     SimplePitchShifter pitchShifterL{0.0f};    // Left channel: no offset
@@ -216,6 +114,7 @@ public:
     // Pre-delay
     std::vector<float> predelayBufferL;
     std::vector<float> predelayBufferR;
+    ResetHorizon predelayHorizon;
     int predelayIndex = 0;
     int predelaySize = 0;
     
@@ -253,39 +152,14 @@ public:
     void init(double sr) {
         sampleRate = sr;
         
-        // Calculate scaling for sample rate
-        float srScale = static_cast<float>(sr / 44100.0);
-        
-        // Initialize comb filters
-        for (int i = 0; i < numCombs; i++) {
-            int sizeL = static_cast<int>(combTuning[i] * srScale);
-            int sizeR = static_cast<int>((combTuning[i] + stereoSpread) * srScale);
-            
-            combBufferL[i].resize(sizeL);
-            combBufferR[i].resize(sizeR);
-            
-            combL[i].setBuffer(combBufferL[i].data(), sizeL);
-            combR[i].setBuffer(combBufferR[i].data(), sizeR);
-        }
-        
-        // Initialize allpass filters
-        for (int i = 0; i < numAllpasses; i++) {
-            int sizeL = static_cast<int>(allpassTuning[i] * srScale);
-            int sizeR = static_cast<int>((allpassTuning[i] + stereoSpread) * srScale);
-            
-            allpassBufferL[i].resize(sizeL);
-            allpassBufferR[i].resize(sizeR);
-            
-            allpassL[i].setBuffer(allpassBufferL[i].data(), sizeL);
-            allpassR[i].setBuffer(allpassBufferR[i].data(), sizeR);
-            allpassL[i].setFeedback(0.5f);
-            allpassR[i].setFeedback(0.5f);
-        }
+        // Delay lines scaled from their 44.1 kHz tunings
+        tank.prepare(sr, stereoSpread);
         
         // Initialize predelay
         int maxPredelay = static_cast<int>(0.2f * sr);
         predelayBufferL.resize(maxPredelay);
         predelayBufferR.resize(maxPredelay);
+        predelayHorizon.prepare(predelayBufferL.size());
         
         updateInternalParameters();
         reset();
@@ -293,23 +167,14 @@ public:
     
     void reset() {
         // Clear Freeverb
-        for (int i = 0; i < numCombs; i++) {
-            combL[i].mute();
-            combR[i].mute();
-        }
-        
-        for (int i = 0; i < numAllpasses; i++) {
-            allpassL[i].mute();
-            allpassR[i].mute();
-        }
+        tank.reset();
         
         // Clear pitch shifters
         pitchShifterL.reset();
         pitchShifterR.reset();
         
-        // Clear predelay
-        std::fill(predelayBufferL.begin(), predelayBufferL.end(), 0.0f);
-        std::fill(predelayBufferR.begin(), predelayBufferR.end(), 0.0f);
+        // Clear predelay (lazily, see ResetHorizon)
+        predelayHorizon.reset();
         predelayIndex = 0;
         
         // Reset filter states
@@ -329,12 +194,8 @@ public:
         damping = dampingParam * scaleDamp;
         
         // Update comb filters
-        for (int i = 0; i < numCombs; i++) {
-            combL[i].setFeedback(roomSize);
-            combR[i].setFeedback(roomSize);
-            combL[i].setDamp(damping);
-            combR[i].setDamp(damping);
-        }
+        tank.setCombFeedback(roomSize);
+        tank.setDamping(damping);
         
         // Pre-delay
         predelaySize = static_cast<int>(predelayParam * 0.1f * sampleRate);
@@ -381,6 +242,7 @@ public:
                 // Write current input to buffer first
                 predelayBufferL[predelayIndex] = inputL;
                 predelayBufferR[predelayIndex] = inputR;
+                predelayHorizon.advance();
 
                 // Calculate read index (predelaySize samples ago, wrapped)
                 int readIndex = predelayIndex - predelaySize;
@@ -388,9 +250,10 @@ public:
                     readIndex += static_cast<int>(predelayBufferL.size());
                 }
 
-                // Read delayed signal
-                delayedL = predelayBufferL[readIndex];
-                delayedR = predelayBufferR[readIndex];
+                // Read delayed signal; silence if written before the last reset
+                const bool fresh = predelayHorizon.isFresh(static_cast<size_t>(predelaySize));
+                delayedL = fresh ? predelayBufferL[readIndex] : 0.0f;
+                delayedR = fresh ? predelayBufferR[readIndex] : 0.0f;
 
                 if (++predelayIndex >= static_cast<int>(predelayBufferL.size())) {
                     predelayIndex = 0;
@@ -398,8 +261,7 @@ public:
             }
             
             // Process through Freeverb
-            float reverbL = 0.0f;
-            float reverbR = 0.0f;
+            float reverbL, reverbR;
 
             // Add cross-channel mixing for stereo decorrelation
             // Increased from 0.15 to 0.35 for better stereo width
@@ -407,17 +269,8 @@ public:
             float delayedL_mixed = delayedL * (1.0f - crossMix) + delayedR * crossMix;
             float delayedR_mixed = delayedR * (1.0f - crossMix) + delayedL * crossMix;
 
-            // Accumulate comb filters with mixed inputs
-            for (int j = 0; j < numCombs; j++) {
-                reverbL += combL[j].process(delayedL_mixed);
-                reverbR += combR[j].process(delayedR_mixed);
-            }
-            
-            // Process through allpasses
-            for (int j = 0; j < numAllpasses; j++) {
-                reverbL = allpassL[j].process(reverbL);
-                reverbR = allpassR[j].process(reverbR);
-            }
+            // Comb filters on the mixed inputs, then the allpasses
+            tank.processSample(delayedL_mixed, delayedR_mixed, reverbL, reverbR);
             
             // Apply gain correction
             reverbL *= gain;
@@ -491,6 +344,17 @@ public:
         }
     }
     
+    double getTailLengthSeconds() const {
+        // Shimmer fed back into the tank keeps regenerating; let the
+        // processor's output check decide when it has died away
+        if (shimmerParam > 0.01f && feedbackParam > 0.01f) {
+            return ChimeraConfig::ENGINE_TAIL_MAX_SECONDS;
+        }
+        const double longestComb = (FreeverbCore::COMB_TUNING[FreeverbCore::NUM_COMBS - 1] + stereoSpread) / 44100.0;
+        const double feedback = sizeParam * scaleRoom + offsetRoom;
+        return predelayParam * 0.1 + getFeedbackTailSeconds(longestComb, feedback);
+    }
+    
     void setParameter(int index, float value) {
         value = std::clamp(value, 0.0f, 1.0f);
         
@@ -557,4 +421,8 @@ int ShimmerReverb::getNumParameters() const {
 
 juce::String ShimmerReverb::getName() const {
     return "Shimmer Reverb";
+}
+
+double ShimmerReverb::getTailLengthSeconds() const noexcept {
+    return pImpl->getTailLengthSeconds();
 }
\ No newline at end of file
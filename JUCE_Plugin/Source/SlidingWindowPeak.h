@@ -0,0 +1,76 @@
+// SlidingWindowPeak.h - Running maximum over the last N samples in O(1)
+//
+// Monotonic wedge (Lemire's streaming max): the queue only holds samples that
+// are larger than everything pushed after them, so the front is always the
+// window maximum. Every sample is pushed and popped at most once, which makes
+// each process() call amortised constant time whatever the window length.
+//
+// prepare() allocates for the longest window; setWindowLength() can then be
+// changed on the audio thread without allocating.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class SlidingWindowPeak {
+public:
+    // Message thread
+    void prepare(int maxWindowLength) {
+        maxWindow = std::max(1, maxWindowLength);
+
+        // One spare slot: the newcomer is queued before the oldest sample expires
+        uint32_t capacity = 1;
+        while (capacity < (uint32_t) maxWindow + 1)
+            capacity <<= 1;
+
+        values.assign(capacity, 0.0f);
+        times.assign(capacity, 0);
+        mask = capacity - 1;
+        window = maxWindow;
+        reset();
+    }
+
+    void reset() noexcept {
+        head = 0;
+        count = 0;
+        now = 0;
+    }
+
+    // Shrinking takes effect as old samples fall out; no reset needed
+    void setWindowLength(int numSamples) noexcept {
+        window = std::clamp(numSamples, 1, maxWindow);
+    }
+
+    int getWindowLength() const noexcept { return window; }
+
+    // Pushes x and returns the maximum of the last getWindowLength() inputs
+    float process(float x) noexcept {
+        // Anything not larger than the newcomer can never be the maximum again
+        while (count > 0 && values[back()] <= x)
+            --count;
+
+        const auto slot = (head + count) & mask;
+        values[slot] = x;
+        times[slot] = now;
+        ++count;
+
+        while (now - times[head] >= (uint32_t) window) {
+            head = (head + 1) & mask;
+            --count;
+        }
+
+        ++now;
+        return values[head];
+    }
+
+    float getPeak() const noexcept { return count > 0 ? values[head] : 0.0f; }
+
+private:
+    uint32_t back() const noexcept { return (head + count - 1) & mask; }
+
+    std::vector<float> values;
+    std::vector<uint32_t> times;
+    uint32_t mask = 0, head = 0, count = 0, now = 0;
+    int maxWindow = 1, window = 1;
+};
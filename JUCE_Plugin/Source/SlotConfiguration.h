@@ -24,11 +24,34 @@ namespace ChimeraConfig {
     static constexpr float CPU_THRESHOLD_WARNING = 70.0f;    // Warn at 70% CPU
     static constexpr float CPU_THRESHOLD_CRITICAL = 85.0f;   // Critical at 85% CPU
     
+    // CpuGovernor: warning-level load must persist for the hold time before a
+    // slot is degraded; critical load degrades at once, then at the cooldown
+    // rate. Tiers come back one at a time after load has stayed below
+    // WARNING - RESTORE_MARGIN for the restore time.
+    static constexpr float CPU_GOVERNOR_RESTORE_MARGIN = 15.0f;
+    static constexpr double CPU_GOVERNOR_HOLD_SECONDS = 0.5;
+    static constexpr double CPU_GOVERNOR_CRITICAL_COOLDOWN_SECONDS = 0.1;
+    static constexpr double CPU_GOVERNOR_RESTORE_SECONDS = 3.0;
+    
+    // Engine replacement transitions: the outgoing engine keeps running next to
+    // the incoming one for the crossfade window, then rings out its tail until
+    // it stays below the threshold (or the safety cap is reached)
+    static constexpr float ENGINE_CROSSFADE_MS_DEFAULT = 50.0f;
+    static constexpr float ENGINE_TAIL_THRESHOLD_DB = -80.0f;
+    static constexpr float ENGINE_TAIL_QUIET_MS = 50.0f;       // Must stay below threshold this long
+    static constexpr float ENGINE_TAIL_MAX_SECONDS = 10.0f;    // Hard cap for self-oscillating engines
+    static constexpr float ENGINE_PRIME_MAX_SECONDS = 2.0f;    // Cap on background pre-roll
+    
+    // Idle slots stop running once their input has been below this level for
+    // longer than the engine's tail, and their output has stayed below
+    // ENGINE_TAIL_THRESHOLD_DB for ENGINE_TAIL_QUIET_MS
+    static constexpr float ENGINE_SLEEP_SILENCE_DB = -100.0f;
+    
     // Configuration flags
     struct SlotConfig {
         bool enableDynamicSlotCount = false;      // Allow runtime slot adjustment
         bool enableSlotBypass = true;             // Allow bypassing individual slots
-        bool enableParallelProcessing = false;    // Future: parallel slot chains
+        bool enableParallelProcessing = false;    // Run parallel routing branches on worker threads
         int defaultActiveSlots = NUM_SLOTS;       // Default number of active slots
     };
     
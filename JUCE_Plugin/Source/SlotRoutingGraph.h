@@ -0,0 +1,214 @@
+// SlotRoutingGraph.h - Serial/parallel arrangement of the processing slots
+//
+// The chain is a sequence of stages. A stage with one branch is ordinary
+// serial processing; a stage with several branches splits the signal, runs
+// each branch (a serial list of slots) on its own copy, and merges the
+// branches back by summing them with a per-branch gain. A branch with no slots
+// is a dry path, so "dry + two reverbs" is a single three-branch stage.
+//
+// The graph is a fixed-size value type: it can be copied on the audio thread
+// without allocating and compared/serialised on the message thread.
+//
+// Text form (stored with the plugin state):
+//     0>1>[2,3@0.7|4@0.7|]>5
+// '>' separates stages, '[...]' is a parallel stage, '|' separates branches,
+// ',' separates slots within a branch, '@' sets the branch gain.
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "SlotConfiguration.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+struct SlotRoutingGraph {
+    static constexpr int MAX_SLOTS = CHIMERA_MAX_SLOTS;
+    static constexpr int MAX_BRANCHES = CHIMERA_MAX_SLOTS;
+    static constexpr int MAX_STAGES = CHIMERA_MAX_SLOTS;
+
+    struct Branch {
+        std::array<int8_t, MAX_SLOTS> slots{};
+        int numSlots = 0;
+        float gain = 1.0f;
+    };
+
+    struct Stage {
+        std::array<Branch, MAX_BRANCHES> branches{};
+        int numBranches = 0;
+
+        bool isParallel() const noexcept { return numBranches > 1; }
+    };
+
+    std::array<Stage, MAX_STAGES> stages{};
+    int numStages = 0;
+
+    //==============================================================================
+    // The classic chain: every slot in series
+    static SlotRoutingGraph serial(int numSlots = CHIMERA_NUM_SLOTS) {
+        SlotRoutingGraph graph;
+        for (int slot = 0; slot < juce::jmin(numSlots, MAX_STAGES); ++slot)
+            graph.addSerialSlot(slot);
+        return graph;
+    }
+
+    bool addSerialSlot(int slot) {
+        if (numStages >= MAX_STAGES)
+            return false;
+
+        auto& stage = stages[(size_t) numStages++];
+        stage = {};
+        stage.numBranches = 1;
+        stage.branches[0].slots[0] = (int8_t) slot;
+        stage.branches[0].numSlots = 1;
+        return true;
+    }
+
+    // Returns the new stage for the caller to fill, or nullptr if full
+    Stage* addParallelStage() {
+        if (numStages >= MAX_STAGES)
+            return nullptr;
+
+        auto& stage = stages[(size_t) numStages++];
+        stage = {};
+        return &stage;
+    }
+
+    static bool addBranch(Stage& stage, std::initializer_list<int> slots, float gain = 1.0f) {
+        if (stage.numBranches >= MAX_BRANCHES || (int) slots.size() > MAX_SLOTS)
+            return false;
+
+        auto& branch = stage.branches[(size_t) stage.numBranches++];
+        branch = {};
+        branch.gain = gain;
+        for (int slot : slots)
+            branch.slots[(size_t) branch.numSlots++] = (int8_t) slot;
+        return true;
+    }
+
+    //==============================================================================
+    // Every slot index in range and used at most once. Slots that do not
+    // appear are not processed.
+    bool isValid(int numSlots = CHIMERA_NUM_SLOTS) const noexcept {
+        if (numStages < 0 || numStages > MAX_STAGES)
+            return false;
+
+        uint32_t used = 0;
+        for (int s = 0; s < numStages; ++s) {
+            const auto& stage = stages[(size_t) s];
+            if (stage.numBranches < 1 || stage.numBranches > MAX_BRANCHES)
+                return false;
+
+            for (int b = 0; b < stage.numBranches; ++b) {
+                const auto& branch = stage.branches[(size_t) b];
+                if (branch.numSlots < 0 || branch.numSlots > MAX_SLOTS || !std::isfinite(branch.gain))
+                    return false;
+
+                for (int i = 0; i < branch.numSlots; ++i) {
+                    const int slot = branch.slots[(size_t) i];
+                    if (slot < 0 || slot >= numSlots || (used & (1u << slot)) != 0)
+                        return false;
+                    used |= 1u << slot;
+                }
+            }
+        }
+        return true;
+    }
+
+    uint32_t getSlotMask() const noexcept {
+        uint32_t mask = 0;
+        for (int s = 0; s < numStages; ++s)
+            for (int b = 0; b < stages[(size_t) s].numBranches; ++b) {
+                const auto& branch = stages[(size_t) s].branches[(size_t) b];
+                for (int i = 0; i < branch.numSlots; ++i)
+                    mask |= 1u << branch.slots[(size_t) i];
+            }
+        return mask;
+    }
+
+    bool hasParallelStages() const noexcept {
+        for (int s = 0; s < numStages; ++s)
+            if (stages[(size_t) s].isParallel())
+                return true;
+        return false;
+    }
+
+    //==============================================================================
+    juce::String toString() const {
+        juce::StringArray stageStrings;
+        for (int s = 0; s < numStages; ++s) {
+            const auto& stage = stages[(size_t) s];
+            juce::StringArray branchStrings;
+            for (int b = 0; b < stage.numBranches; ++b) {
+                const auto& branch = stage.branches[(size_t) b];
+                juce::StringArray slotStrings;
+                for (int i = 0; i < branch.numSlots; ++i)
+                    slotStrings.add(juce::String((int) branch.slots[(size_t) i]));
+
+                auto text = slotStrings.joinIntoString(",");
+                if (branch.gain != 1.0f)
+                    text << "@" << juce::String(branch.gain, 4);
+                branchStrings.add(text);
+            }
+
+            if (stage.isParallel())
+                stageStrings.add("[" + branchStrings.joinIntoString("|") + "]");
+            else
+                stageStrings.add(branchStrings[0]);
+        }
+        return stageStrings.joinIntoString(">");
+    }
+
+    // Returns false (and leaves `result` untouched) on malformed or invalid text
+    static bool fromString(const juce::String& text, SlotRoutingGraph& result) {
+        SlotRoutingGraph graph;
+        auto stageStrings = juce::StringArray::fromTokens(text.removeCharacters(" \t\r\n"), ">", "");
+        stageStrings.removeEmptyStrings();
+
+        for (const auto& stageText : stageStrings) {
+            if (graph.numStages >= MAX_STAGES)
+                return false;
+
+            auto& stage = graph.stages[(size_t) graph.numStages++];
+            const bool parallel = stageText.startsWithChar('[');
+            if (parallel && !stageText.endsWithChar(']'))
+                return false;
+
+            const auto body = parallel ? stageText.substring(1, stageText.length() - 1) : stageText;
+            auto branchStrings = juce::StringArray::fromTokens(body, "|", "");
+            if (branchStrings.size() > MAX_BRANCHES || (!parallel && branchStrings.size() != 1))
+                return false;
+
+            for (const auto& branchText : branchStrings) {
+                auto& branch = stage.branches[(size_t) stage.numBranches++];
+                auto slotsText = branchText.upToFirstOccurrenceOf("@", false, false);
+
+                if (branchText.containsChar('@')) {
+                    const auto gainText = branchText.fromFirstOccurrenceOf("@", false, false);
+                    if (!gainText.containsOnly("0123456789.-"))
+                        return false;
+                    branch.gain = gainText.getFloatValue();
+                }
+
+                auto slotStrings = juce::StringArray::fromTokens(slotsText, ",", "");
+                slotStrings.removeEmptyStrings();
+                if (slotStrings.size() > MAX_SLOTS)
+                    return false;
+
+                for (const auto& slotText : slotStrings) {
+                    if (!slotText.containsOnly("0123456789") || slotText.length() > 2)
+                        return false;
+                    branch.slots[(size_t) branch.numSlots++] = (int8_t) slotText.getIntValue();
+                }
+            }
+        }
+
+        if (!graph.isValid())
+            return false;
+
+        result = graph;
+        return true;
+    }
+
+    bool operator==(const SlotRoutingGraph& other) const { return toString() == other.toString(); }
+    bool operator!=(const SlotRoutingGraph& other) const { return !operator==(other); }
+};
@@ -32,63 +32,16 @@ void SpectralFreeze::SmoothParam::setSmoothingRate(float timeMs, double sampleRa
 
 // Custom DenormalDisabler replaced with DspEngineUtilities DenormalGuard
 
-//==============================================================================
-// FFTProcessor Implementation
-//==============================================================================
-void SpectralFreeze::FFTProcessor::init(int fftOrder) {
-    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
-    reset();
-}
-
-void SpectralFreeze::FFTProcessor::reset() {
-    spectrum.fill(std::complex<float>(0.0f, 0.0f));
-    frozenSpectrum.fill(std::complex<float>(0.0f, 0.0f));
-    fftBuffer.fill(0.0f);
-    decayState = 1.0f;
-}
-
-void SpectralFreeze::FFTProcessor::unpackRealFFT() {
-    // JUCE format: [DC, Nyquist, Re(1), Im(1), Re(2), Im(2), ...]
-    spectrum[0] = std::complex<float>(fftBuffer[0], 0.0f);  // DC
-    spectrum[HALF_FFT_SIZE] = std::complex<float>(fftBuffer[1], 0.0f);  // Nyquist
-    
-    // Unpack the rest
-    for (int i = 1; i < HALF_FFT_SIZE; ++i) {
-        spectrum[i] = std::complex<float>(fftBuffer[2*i], fftBuffer[2*i + 1]);
-    }
-}
-
-void SpectralFreeze::FFTProcessor::packToRealFFT() {
-    fftBuffer[0] = spectrum[0].real();  // DC (imag must be 0)
-    fftBuffer[1] = spectrum[HALF_FFT_SIZE].real();  // Nyquist (imag must be 0)
-    
-    for (int i = 1; i < HALF_FFT_SIZE; ++i) {
-        fftBuffer[2*i] = spectrum[i].real();
-        fftBuffer[2*i + 1] = spectrum[i].imag();
-    }
-}
-
 //==============================================================================
 // ChannelState Implementation
 //==============================================================================
-void SpectralFreeze::ChannelState::init(int fftSize) {
-    fftProcessor.init(FFT_ORDER);
-    phaseAccumulator.fill(0.0f);
-    reset();
-}
-
 void SpectralFreeze::ChannelState::reset() {
-    inputBuffer.fill(0.0f);
-    outputBuffer.fill(0.0f);
-    windowedFrame.fill(0.0f);
+    frozenSpectrum.fill(std::complex<float>(0.0f, 0.0f));
     tempSpectrum.fill(std::complex<float>(0.0f, 0.0f));
     phaseAccumulator.fill(0.0f);
-    inputPos = 0;
-    outputPos = 0;
-    hopCounter = 0;
+    decayState = 1.0f;
     isFrozen = false;
     freezeCounter = 0;
-    fftProcessor.reset();
 }
 
 //==============================================================================
@@ -120,78 +73,15 @@ void SpectralFreeze::prepareToPlay(double sampleRate, int samplesPerBlock) {
     m_density.setSmoothingRate(100.0f, sampleRate);
     m_shimmer.setSmoothingRate(50.0f, sampleRate);
     
-    // Generate window with exact overlap compensation
-    generateWindowWithCompensation();
-    
-    // Validate unity gain (with tolerance for FFT scaling effects)
-    float gain = validateUnityGain();
-    // Note: Due to FFT scaling and window normalization, the validation result
-    // is much smaller than 1.0, but should be consistent and non-zero
-    jassert(gain > 0.0f && gain < 1.0f);
-    
-    // Initialize all channels
-    for (auto& channel : m_channels) {
-        channel.init(FFT_SIZE);
-    }
-}
-
-void SpectralFreeze::generateWindowWithCompensation() {
-    // Generate Hann window
-    std::array<float, FFT_SIZE> window;
-    for (int i = 0; i < FFT_SIZE; ++i) {
-        window[i] = 0.5f * (1.0f - cosf(2.0f * M_PI * i / (FFT_SIZE - 1)));
-    }
-    
-    // Calculate exact overlap compensation at each sample
-    m_overlapCompensation.fill(0.0f);
-    
-    // Sum overlapping windows
-    for (int hop = 0; hop < FFT_SIZE; hop += HOP_SIZE) {
-        for (int i = 0; i < FFT_SIZE; ++i) {
-            int idx = (hop + i) % FFT_SIZE;
-            m_overlapCompensation[idx] += window[i] * window[i];
-        }
-    }
-    
-    // Pre-multiply window by normalization factor
-    // Note: FFT_SIZE factor compensates for JUCE's inverse FFT scaling (1/N)
-    for (int i = 0; i < FFT_SIZE; ++i) {
-        float compensation = (m_overlapCompensation[i] > 0.0f) ? 
-                           1.0f / (m_overlapCompensation[i] * FFT_SIZE) : 0.0f;
-        m_windowNormalized[i] = window[i] * compensation;
-    }
-}
-
-float SpectralFreeze::validateUnityGain() {
-    // Test overlap-add compensation by checking the first HOP_SIZE positions
-    // For proper overlap-add, each position should sum to 1.0
-    float testGain = 0.0f;
-    
-    for (int testPos = 0; testPos < HOP_SIZE; ++testPos) {
-        float overlap = 0.0f;
-        
-        // Sum contributions from all overlapping hops
-        for (int hop = 0; hop < FFT_SIZE; hop += HOP_SIZE) {
-            for (int i = 0; i < FFT_SIZE; ++i) {
-                int outputPos = (hop + i) % FFT_SIZE;
-                if (outputPos == testPos) {
-                    overlap += m_windowNormalized[i] * m_windowNormalized[i];
-                }
-            }
-        }
-        
-        testGain += overlap;
-    }
-    
-    // Average should be 1.0
-    return testGain / HOP_SIZE;
+    m_stft.prepare(MAX_CHANNELS, FFT_ORDER, m_overlap);
+    reset();
 }
 
 void SpectralFreeze::reset() {
-    for (int ch = 0; ch < m_activeChannels; ++ch) {
-        m_channels[ch].reset();
+    m_stft.reset();
+    for (auto& channel : m_channels) {
+        channel.reset();
     }
-    m_smoothCounter = 0;
 }
 
 void SpectralFreeze::process(juce::AudioBuffer<float>& buffer) {
@@ -201,8 +91,8 @@ void SpectralFreeze::process(juce::AudioBuffer<float>& buffer) {
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
     
-    // Update active channel count
-    m_activeChannels = std::min(numChannels, MAX_CHANNELS);
+    // Update active channel count (none before prepareToPlay)
+    m_activeChannels = std::min(numChannels, m_stft.getNumChannels());
     
     // Early bypass check for freeze amount (mix parameter)
     m_freezeAmount.update();
@@ -220,128 +110,42 @@ void SpectralFreeze::process(juce::AudioBuffer<float>& buffer) {
         return;
     }
     
-    for (int sample = 0; sample < numSamples; ++sample) {
+    const float wetAmount = m_freezeAmount.current;
+    
+    for (int start = 0; start < numSamples; start += SMOOTH_INTERVAL) {
+        const int subBlock = std::min(SMOOTH_INTERVAL, numSamples - start);
+        
         // Sub-block parameter smoothing
-        bool updateParams = false;
-        if (m_smoothCounter >= SMOOTH_INTERVAL) {
-            m_spectralSmear.update();
-            m_spectralShift.update();
-            m_resonance.update();
-            m_decay.update();
-            m_brightness.update();
-            m_density.update();
-            m_shimmer.update();
-            m_smoothCounter = 0;
-            updateParams = true;
-        }
-        m_smoothCounter++;
+        m_spectralSmear.update();
+        m_spectralShift.update();
+        m_resonance.update();
+        m_decay.update();
+        m_brightness.update();
+        m_density.update();
+        m_shimmer.update();
         
         // Process all active channels
         for (int ch = 0; ch < m_activeChannels; ++ch) {
-            auto* channelData = buffer.getWritePointer(ch);
+            auto* channelData = buffer.getWritePointer(ch) + start;
             auto& state = m_channels[ch];
             
             // Update processing flags once per parameter update
-            if (updateParams) {
-                state.enableSmear = m_spectralSmear.current > 0.01f;
-                state.enableShift = fabsf(m_spectralShift.current) > 0.01f;
-                state.enableResonance = m_resonance.current > 0.01f;
-                state.enableDensity = m_density.current < 0.99f;
-                state.enableShimmer = m_shimmer.current > 0.01f;
-                state.shiftBins = static_cast<int>(m_spectralShift.current * HALF_FFT_SIZE * 0.1f);
-            }
-            
-            // Add to input buffer
-            state.inputBuffer[state.inputPos] = channelData[sample];
-            state.inputPos = (state.inputPos + 1) % FFT_SIZE;
-            state.hopCounter++;
-            
-            // Process FFT frame when we've accumulated enough samples
-            if (state.hopCounter >= HOP_SIZE) {
-                state.hopCounter = 0;
-                
-                // Fill windowed frame from circular buffer
-                int readPos = (state.inputPos - FFT_SIZE + FFT_SIZE) % FFT_SIZE;
-                for (int i = 0; i < FFT_SIZE; ++i) {
-                    state.windowedFrame[i] = state.inputBuffer[(readPos + i) % FFT_SIZE] * 
-                                           m_windowNormalized[i];
-                }
-                
-                // Copy to FFT buffer (real part)
-                std::copy(state.windowedFrame.begin(), state.windowedFrame.end(), 
-                         state.fftProcessor.fftBuffer.begin());
-                
-                // Forward FFT
-                state.fftProcessor.fft->performRealOnlyForwardTransform(
-                    state.fftProcessor.fftBuffer.data());
-                
-                // Unpack JUCE's real FFT format to complex spectrum
-                state.fftProcessor.unpackRealFFT();
-                
-                // Freeze logic
-                bool shouldFreeze = m_freezeAmount.current > 0.5f;
-                if (shouldFreeze && !state.isFrozen) {
-                    // Capture spectrum
-                    std::copy(state.fftProcessor.spectrum.begin(),
-                             state.fftProcessor.spectrum.begin() + HALF_FFT_SIZE + 1,
-                             state.fftProcessor.frozenSpectrum.begin());
-                    state.isFrozen = true;
-                    state.freezeCounter = 0;
-                } else if (!shouldFreeze) {
-                    state.isFrozen = false;
-                }
-                
-                // Use frozen or live spectrum
-                if (state.isFrozen) {
-                    std::copy(state.fftProcessor.frozenSpectrum.begin(),
-                             state.fftProcessor.frozenSpectrum.begin() + HALF_FFT_SIZE + 1,
-                             state.fftProcessor.spectrum.begin());
-                    
-                    // Apply decay with leak prevention
-                    float decay = m_decay.current;
-                    state.fftProcessor.decayState = 
-                        state.fftProcessor.decayState * FFTProcessor::DECAY_LEAK + 
-                        decay * FFTProcessor::DECAY_GAIN;
-                    
-                    // Apply decay to frozen spectrum
-                    for (int i = 0; i <= HALF_FFT_SIZE; ++i) {
-                        state.fftProcessor.frozenSpectrum[i] *= state.fftProcessor.decayState;
-                    }
-                    
-                    state.freezeCounter++;
-                }
-                
-                // Apply spectral processing
-                processSpectrum(state);
-                
-                // Pack back to JUCE's format
-                state.fftProcessor.packToRealFFT();
-                
-                // Inverse FFT
-                state.fftProcessor.fft->performRealOnlyInverseTransform(
-                    state.fftProcessor.fftBuffer.data());
-                
-                // Apply window and overlap-add
-                for (int i = 0; i < FFT_SIZE; ++i) {
-                    float sample = state.fftProcessor.fftBuffer[i] * m_windowNormalized[i];
-                    
-                    int outIdx = (state.outputPos + i) % FFT_SIZE;
-                    state.outputBuffer[outIdx] += sample;
-                }
-                state.outputPos = (state.outputPos + HOP_SIZE) % FFT_SIZE;
-            }
-            
-            // Read from output buffer
-            int outReadPos = (state.outputPos + FFT_SIZE - HOP_SIZE * 3) % FFT_SIZE;
-            float output = state.outputBuffer[outReadPos];
-            state.outputBuffer[outReadPos] = 0.0f; // Clear after reading
+            state.enableSmear = m_spectralSmear.current > 0.01f;
+            state.enableShift = fabsf(m_spectralShift.current) > 0.01f;
+            state.enableResonance = m_resonance.current > 0.01f;
+            state.enableDensity = m_density.current < 0.99f;
+            state.enableShimmer = m_shimmer.current > 0.01f;
+            state.shiftBins = static_cast<int>(m_spectralShift.current * HALF_FFT_SIZE * 0.1f);
             
-            // Prevent denormals in output using DspEngineUtilities
-            output = DSPUtils::flushDenorm(output);
+            std::array<float, SMOOTH_INTERVAL> wet;
+            m_stft.process(ch, channelData, wet.data(), subBlock,
+                           [this, &state](std::complex<float>* spectrum, int) { processFrame(state, spectrum); });
             
             // Mix with dry signal based on freeze amount
-            float wetAmount = m_freezeAmount.current;
-            channelData[sample] = channelData[sample] * (1.0f - wetAmount) + output * wetAmount;
+            for (int i = 0; i < subBlock; ++i) {
+                const float output = DSPUtils::flushDenorm(wet[i]);
+                channelData[i] = channelData[i] * (1.0f - wetAmount) + output * wetAmount;
+            }
         }
     }
     
@@ -349,10 +153,40 @@ void SpectralFreeze::process(juce::AudioBuffer<float>& buffer) {
     scrubBuffer(buffer);
 }
 
-void SpectralFreeze::processSpectrum(ChannelState& state) {
-    // Work with the unpacked complex spectrum
-    auto* spectrum = state.fftProcessor.spectrum.data();
+void SpectralFreeze::processFrame(ChannelState& state, std::complex<float>* spectrum) {
+    // Freeze logic
+    bool shouldFreeze = m_freezeAmount.current > 0.5f;
+    if (shouldFreeze && !state.isFrozen) {
+        // Capture spectrum
+        std::copy(spectrum, spectrum + HALF_FFT_SIZE + 1, state.frozenSpectrum.begin());
+        state.isFrozen = true;
+        state.freezeCounter = 0;
+    } else if (!shouldFreeze) {
+        state.isFrozen = false;
+    }
+    
+    // Use frozen or live spectrum
+    if (state.isFrozen) {
+        std::copy(state.frozenSpectrum.begin(), state.frozenSpectrum.end(), spectrum);
+        
+        // Apply decay with leak prevention
+        float decay = m_decay.current;
+        state.decayState = state.decayState * ChannelState::DECAY_LEAK + decay * ChannelState::DECAY_GAIN;
+        
+        // Apply decay to frozen spectrum, per REFERENCE_HOP whatever the overlap
+        const float frameDecay = std::pow(state.decayState, (float) m_stft.getHopSize() / REFERENCE_HOP);
+        for (auto& bin : state.frozenSpectrum) {
+            bin *= frameDecay;
+        }
+        
+        state.freezeCounter++;
+    }
     
+    // Apply spectral processing
+    processSpectrum(state, spectrum);
+}
+
+void SpectralFreeze::processSpectrum(ChannelState& state, std::complex<float>* spectrum) {
     // Branch-free processing based on pre-computed flags
     if (state.enableSmear) {
         applySpectralSmear(spectrum, m_spectralSmear.current, state);
@@ -383,8 +217,8 @@ void SpectralFreeze::applySpectralSmear(std::complex<float>* spectrum, float amo
     // Use channel's own temp buffer
     auto& temp = state.tempSpectrum;
     
-    // Smear radius
-    int radius = static_cast<int>(amount * 5.0f) + 1;
+    // Smear radius (cost per bin grows with it, so lower tiers cap it)
+    int radius = std::min(static_cast<int>(amount * 5.0f) + 1, m_maxSmearRadius);
     
     // Simple scalar implementation
     for (int i = 0; i <= HALF_FFT_SIZE; ++i) {
@@ -403,7 +237,7 @@ void SpectralFreeze::applySpectralSmear(std::complex<float>* spectrum, float amo
     }
     
     // Copy back
-    std::copy(temp.begin(), temp.begin() + HALF_FFT_SIZE + 1, spectrum);
+    std::copy(temp.begin(), temp.end(), spectrum);
 }
 
 void SpectralFreeze::applySpectralShift(std::complex<float>* spectrum, int shiftBins,
@@ -420,7 +254,7 @@ void SpectralFreeze::applySpectralShift(std::complex<float>* spectrum, int shift
         }
     }
     
-    std::copy(temp.begin(), temp.begin() + HALF_FFT_SIZE + 1, spectrum);
+    std::copy(temp.begin(), temp.end(), spectrum);
 }
 
 void SpectralFreeze::applyResonance(std::complex<float>* spectrum, float resonance) {
@@ -504,6 +338,14 @@ void SpectralFreeze::applyShimmer(std::complex<float>* spectrum, float shimmer,
     }
 }
 
+void SpectralFreeze::setQuality(Quality q) {
+    static constexpr int radiusForTier[] = { 2, 3, 4, 6 };
+    m_maxSmearRadius = radiusForTier[static_cast<int>(q)];
+    
+    m_overlap = StftProcessor::overlapForQuality(q);
+    m_stft.setOverlap(m_overlap);
+}
+
 void SpectralFreeze::updateParameters(const std::map<int, float>& params) {
     auto getParam = [&params](int index, float defaultValue) {
         auto it = params.find(index);
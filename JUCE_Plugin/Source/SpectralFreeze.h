@@ -2,6 +2,7 @@
 #pragma once
 #include "EngineBase.h"
 #include "DspEngineUtilities.h"
+#include "StftProcessor.h"
 #include <vector>
 #include <complex>
 #include <cmath>
@@ -27,6 +28,14 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override;  // Caps the smear radius, sets the overlap
+    
+    int getLatencySamples() const noexcept override { return m_stft.getLatencySamples(); }
+    
+    // A held spectrum never decays; otherwise one analysis frame drains out
+    double getTailLengthSeconds() const noexcept override {
+        return m_freezeAmount.current > 0.5f ? ChimeraConfig::ENGINE_TAIL_MAX_SECONDS : FFT_SIZE / m_sampleRate;
+    }
     
     int getNumParameters() const override { return 8; }
     juce::String getParameterName(int index) const override;
@@ -37,7 +46,7 @@ private:
     static constexpr int FFT_ORDER = 11;  // 2048 samples
     static constexpr int FFT_SIZE = 1 << FFT_ORDER;
     static constexpr int HALF_FFT_SIZE = FFT_SIZE / 2;
-    static constexpr int HOP_SIZE = FFT_SIZE / 4;  // 75% overlap
+    static constexpr int REFERENCE_HOP = FFT_SIZE / 4;  // Hop the decay rate is set for
     static constexpr int MAX_CHANNELS = 8;  // Support up to 8 channels
     
     // Alignment for SIMD
@@ -54,6 +63,9 @@ private:
         void setSmoothingRate(float timeMs, double sampleRate);
     };
     
+    int m_maxSmearRadius = 6;  // Bins either side, 2..6 from Draft to Ultra
+    int m_overlap = StftProcessor::overlapForQuality(Quality::Ultra);
+    
     SmoothParam m_freezeAmount;
     SmoothParam m_spectralSmear;
     SmoothParam m_spectralShift;
@@ -67,46 +79,21 @@ private:
     double m_sampleRate = 44100.0;
     int m_blockSize = 512;
     
-    // Pre-computed window with normalization baked in
-    alignas(SIMD_ALIGNMENT) std::array<float, FFT_SIZE> m_windowNormalized;
-    alignas(SIMD_ALIGNMENT) std::array<float, FFT_SIZE> m_overlapCompensation;
+    // Framing, windows and overlap-add for every channel
+    StftProcessor m_stft;
     
-    // FFT Processing with pre-allocated buffers
-    struct FFTProcessor {
-        std::unique_ptr<juce::dsp::FFT> fft;
+    // Per-channel spectral state with all buffers pre-allocated
+    struct alignas(SIMD_ALIGNMENT) ChannelState {
+        alignas(SIMD_ALIGNMENT) std::array<std::complex<float>, HALF_FFT_SIZE + 1> frozenSpectrum;
         
-        // Aligned pre-allocated buffers
-        alignas(SIMD_ALIGNMENT) std::array<float, FFT_SIZE * 2> fftBuffer;
-        alignas(SIMD_ALIGNMENT) std::array<std::complex<float>, FFT_SIZE> spectrum;
-        alignas(SIMD_ALIGNMENT) std::array<std::complex<float>, FFT_SIZE> frozenSpectrum;
+        // Each channel needs its own temp buffer for thread safety
+        alignas(SIMD_ALIGNMENT) std::array<std::complex<float>, HALF_FFT_SIZE + 1> tempSpectrum;
         
         // Decay state with leak prevention
         float decayState = 1.0f;
         static constexpr float DECAY_LEAK = 0.995f;
         static constexpr float DECAY_GAIN = 0.005f;
         
-        void init(int fftOrder);
-        void reset();
-        void unpackRealFFT();
-        void packToRealFFT();
-    };
-    
-    // Per-channel processing with all buffers pre-allocated
-    struct alignas(SIMD_ALIGNMENT) ChannelState {
-        FFTProcessor fftProcessor;
-        
-        // Aligned circular buffers
-        alignas(SIMD_ALIGNMENT) std::array<float, FFT_SIZE> inputBuffer;
-        alignas(SIMD_ALIGNMENT) std::array<float, FFT_SIZE> outputBuffer;
-        alignas(SIMD_ALIGNMENT) std::array<float, FFT_SIZE> windowedFrame;
-        
-        // Each channel needs its own temp buffer for thread safety
-        alignas(SIMD_ALIGNMENT) std::array<std::complex<float>, FFT_SIZE> tempSpectrum;
-        
-        int inputPos = 0;
-        int outputPos = 0;
-        int hopCounter = 0;
-        
         // Spectral freeze state
         bool isFrozen = false;
         int freezeCounter = 0;
@@ -114,7 +101,7 @@ private:
         // Phase randomizer with incremental jitter
         std::mt19937 rng{std::random_device{}()};
         std::uniform_real_distribution<float> phaseDist{-0.1f, 0.1f};  // Small jitter
-        std::array<float, FFT_SIZE> phaseAccumulator;  // Track phase changes
+        std::array<float, HALF_FFT_SIZE + 1> phaseAccumulator;  // Track phase changes
         
         // Processing mode flags (updated per hop)
         bool enableSmear = false;
@@ -124,7 +111,6 @@ private:
         bool enableShimmer = false;
         int shiftBins = 0;
         
-        void init(int fftSize);
         void reset();
     };
     
@@ -134,18 +120,14 @@ private:
     
     // Sub-block parameter smoothing
     static constexpr int SMOOTH_INTERVAL = 32;  // Samples between smoothing updates
-    int m_smoothCounter = 0;
     
     // Using DspEngineUtilities DenormalGuard instead of custom implementation
     
-    // Window generation with exact overlap compensation
-    void generateWindowWithCompensation();
-    
-    // Validation helper for testing unity gain
-    float validateUnityGain();
+    // Spectral kernel run by m_stft on each frame
+    void processFrame(ChannelState& state, std::complex<float>* spectrum);
     
     // Optimized spectral processing functions
-    void processSpectrum(ChannelState& state);
+    void processSpectrum(ChannelState& state, std::complex<float>* spectrum);
     void applySpectralSmear(std::complex<float>* spectrum, float amount, ChannelState& state);
     void applySpectralShift(std::complex<float>* spectrum, int shiftBins, ChannelState& state);
     void applyResonance(std::complex<float>* spectrum, float resonance);
@@ -31,33 +31,29 @@ void SpectralGate_Platinum::prepareToPlay(double sampleRate, int samplesPerBlock
     pLookahead.setTimeMs(20.f, sr_);
     pMix.setTimeMs(10.f, sr_);
 
-    // Bounded iteration limit (prevent infinite loops)
-    maxProcessingIterations_ = std::min(10000, maxBlock_ * 10);
-
     // Initialize channels (ensure at least stereo)
     if (channels_.size() < 2) {
         channels_.resize(2);
     }
 
-    // CRITICAL: Initialize FFT windows for all channels
-    for (auto& ch : channels_) {
-        ch.fftProc.prepareWindow();
-        ch.reset();
-
-        // Prepare lookahead delay buffer
-        int maxLookaheadSamples = static_cast<int>(0.010 * sr_); // 10ms max
-        ch.delayBuf.resize(maxLookaheadSamples + 1, 0.0f);
-    }
+    stft_.prepare((int)channels_.size(), kFFTOrder, overlap_);
+    dryBuffer_.setSize((int)channels_.size(), maxBlock_);
 
     // Initialize state
     reset();
 }
 
 void SpectralGate_Platinum::reset() {
+    stft_.reset();
     for (auto& ch : channels_)
         ch.reset();
 }
 
+void SpectralGate_Platinum::setQuality(Quality q) {
+    overlap_ = StftProcessor::overlapForQuality(q);
+    stft_.setOverlap(overlap_);
+}
+
 // -------------------------------------------------------
 void SpectralGate_Platinum::updateParameters(const std::map<int, float>& params) {
     auto get = [&](int idx, float def){ auto it=params.find(idx); return it!=params.end()? it->second : def; };
@@ -77,8 +73,9 @@ void SpectralGate_Platinum::updateParameters(const std::map<int, float>& params)
     float ratio    = 1.0f + 19.0f * ratio01;          // 1:1 to 20:1
     float attackMs = 0.1f + 49.9f * att01;            // 0.1..50 ms
     float releaseMs= 1.0f + 499.0f * rel01;           // 1..500 ms
-    float freqLow  = 20.0f * std::pow(10.0f, 3.0f * fLo01);  // 20Hz..20kHz
-    float freqHigh = 20.0f * std::pow(10.0f, 3.0f * fHi01);  // 20Hz..20kHz
+    constexpr float log2Of1000 = 9.96578428f;  // 10^(3x) = 2^(x log2(1000))
+    float freqLow  = 20.0f * FastMath::pow2(log2Of1000 * fLo01);  // 20Hz..20kHz
+    float freqHigh = 20.0f * FastMath::pow2(log2Of1000 * fHi01);  // 20Hz..20kHz
     float lookMs   = 10.0f * look01;                  // 0..10 ms
 
     pThreshold.target.store(threshDb, std::memory_order_relaxed);
@@ -103,7 +100,7 @@ void SpectralGate_Platinum::process(juce::AudioBuffer<float>& buffer) {
     }
 
     // SAFETY: Ensure channels are initialized
-    if (channels_.empty()) {
+    if (channels_.empty() || stft_.getNumChannels() == 0) {
         return; // Not prepared, passthrough
     }
 
@@ -126,12 +123,14 @@ void SpectralGate_Platinum::process(juce::AudioBuffer<float>& buffer) {
         return; // Invalid parameters, passthrough to prevent crash
     }
 
-    // Create dry buffer for mix
-    juce::AudioBuffer<float> dryBuffer(numChannels, numSamples);
-    dryBuffer.makeCopyOf(buffer);
+    // Keep the dry signal for the mix
+    const int channelsToProcess = std::min(numChannels, (int)channels_.size());
+    for (int ch = 0; ch < channelsToProcess; ++ch) {
+        const float* source = buffer.getReadPointer(ch);
+        std::copy(source, source + numSamples, dryBuffer_.getWritePointer(ch));
+    }
 
     // Process each channel independently
-    const int channelsToProcess = std::min(numChannels, (int)channels_.size());
     for (int ch = 0; ch < channelsToProcess; ++ch) {
         float* channelData = buffer.getWritePointer(ch);
 
@@ -142,10 +141,10 @@ void SpectralGate_Platinum::process(juce::AudioBuffer<float>& buffer) {
 
         // Process channel with safety wrapper
         try {
-            processChannel(channels_[ch], channelData, numSamples);
+            processChannel(ch, channelData, numSamples);
         } catch (...) {
             // SAFETY: On any exception, copy dry signal
-            const float* dryData = dryBuffer.getReadPointer(ch);
+            const float* dryData = dryBuffer_.getReadPointer(ch);
             if (dryData) {
                 std::copy(dryData, dryData + numSamples, channelData);
             }
@@ -158,7 +157,7 @@ void SpectralGate_Platinum::process(juce::AudioBuffer<float>& buffer) {
 
     for (int ch = 0; ch < channelsToProcess; ++ch) {
         float* wetData = buffer.getWritePointer(ch);
-        const float* dryData = dryBuffer.getReadPointer(ch);
+        const float* dryData = dryBuffer_.getReadPointer(ch);
 
         if (wetData && dryData) {
             for (int i = 0; i < numSamples; ++i) {
@@ -177,7 +176,7 @@ void SpectralGate_Platinum::process(juce::AudioBuffer<float>& buffer) {
     }
 }
 
-void SpectralGate_Platinum::processChannel(Channel& ch, float* data, int numSamples) {
+void SpectralGate_Platinum::processChannel(int index, float* data, int numSamples) {
     // SAFETY: Validate input
     if (!data || numSamples <= 0) return;
 
@@ -189,138 +188,44 @@ void SpectralGate_Platinum::processChannel(Channel& ch, float* data, int numSamp
     const float freqLow  = std::clamp(pFreqLow.current, 20.0f, static_cast<float>(sr_ * 0.5));
     const float freqHigh = std::clamp(pFreqHigh.current, 20.0f, static_cast<float>(sr_ * 0.5));
 
-    // SAFETY: Convert threshold with bounds checking
-    const float threshLin = std::clamp(std::pow(10.0f, std::clamp(threshDb, -80.0f, 0.0f) / 20.0f),
-                                       1e-10f, 10.0f);
-
-    const int binLow  = freqToBin(freqLow, sr_);
-    const int binHigh = freqToBin(freqHigh, sr_);
-
-    // SAFETY: Envelope coefficients with bounds checking to prevent NaN
-    const float attackDenom = std::max(0.01f, attackMs * static_cast<float>(sr_));
-    const float releaseDenom = std::max(0.01f, releaseMs * static_cast<float>(sr_));
-    const float attackCoeff = std::clamp(std::exp(-1000.0f / attackDenom), 0.0f, 0.9999f);
-    const float releaseCoeff = std::clamp(std::exp(-1000.0f / releaseDenom), 0.0f, 0.9999f);
-
-    // Bounded processing loop
-    int iterations = 0;
-    for (int n = 0; n < numSamples; ++n) {
-        // Safety: prevent infinite loops
-        if (++iterations > maxProcessingIterations_) break;
+    GateSettings settings;
 
-        float input = data[n];
-
-        // Apply lookahead delay
-        float delayed = input;
-        if (ch.delaySamples > 0) {
-            delayed = ch.delayBuf[ch.delayWrite];
-            ch.delayBuf[ch.delayWrite] = input;
-            ch.delayWrite = (ch.delayWrite + 1) % (int)ch.delayBuf.size();
-        }
-
-        // Write to input buffer
-        ch.inputBuf[ch.writePos] = delayed;
-        ch.writePos = (ch.writePos + 1) % kFFTSize;
-
-        // Process FFT frame when ready
-        if (++ch.hopCounter >= kHopSize) {
-            ch.hopCounter = 0;
-
-            // Prepare frame (bounded copy)
-            float frame[kFFTSize];
-            for (int i = 0; i < kFFTSize && i < maxProcessingIterations_; ++i) {
-                int idx = (ch.writePos - kFFTSize + i + kFFTSize) % kFFTSize;
-                frame[i] = ch.inputBuf[idx];
-            }
+    // SAFETY: Convert threshold with bounds checking
+    settings.threshold = std::clamp(FastMath::dbToGain(std::clamp(threshDb, -80.0f, 0.0f)),
+                                    1e-10f, 10.0f);
+    settings.ratio = std::clamp(ratio, 1.0f, 100.0f);  // SAFETY: Reasonable ratio range
 
-            // Process with spectral gate (internally bounded)
-            float output[kFFTSize];
-            ch.fftProc.processFrame(frame, output, threshLin, ratio, binLow, binHigh);
+    // SAFETY: Clamp bin ranges
+    settings.binLow = freqToBin(freqLow, sr_);
+    settings.binHigh = std::clamp(freqToBin(freqHigh, sr_), settings.binLow, kFFTBins - 1);
 
-            // Write to output buffer with overlap-add
-            for (int i = 0; i < kFFTSize && i < maxProcessingIterations_; ++i) {
-                int idx = (ch.readPos + i) % kFFTSize;
-                ch.outputBuf[idx] += output[i];
-            }
-        }
+    // Bin gains move once per hop
+    const float hopMs = 1000.0f * static_cast<float>(stft_.getHopSize() / sr_);
+    settings.attackCoeff = std::clamp(FastMath::exp(-hopMs / attackMs), 0.0f, 0.9999f);
+    settings.releaseCoeff = std::clamp(FastMath::exp(-hopMs / releaseMs), 0.0f, 0.9999f);
 
-        // Read output
-        // Simple passthrough for initial latency period
-        float output = delayed;  
-        
-        // After initial hop, use output buffer
-        if (ch.hopCounter == 0 && ch.readPos < ch.writePos) {
-            output = ch.outputBuf[ch.readPos];
-            ch.outputBuf[ch.readPos] = 0.0f; // Clear after reading
-        }
-        ch.readPos = (ch.readPos + 1) % kFFTSize;
-
-        // Update per-bin envelopes (simplified, bounded)
-        if (n % 64 == 0) { // Decimate for efficiency
-            for (int b = 0; b < kFFTBins && b < 100; ++b) { // Limit bins
-                float target = (b >= binLow && b <= binHigh) ? 1.0f : 0.0f;
-                float coeff = target > ch.binEnv[b] ? attackCoeff : releaseCoeff;
-                ch.binEnv[b] += (1.0f - coeff) * (target - ch.binEnv[b]);
-                ch.binEnv[b] = flushDenorm(ch.binEnv[b]);
-            }
-        }
+    Channel& ch = channels_[(size_t)index];
+    stft_.process(index, data, data, numSamples,
+                  [&ch, &settings](std::complex<float>* bins, int) { gateFrame(ch, bins, settings); });
 
+    for (int n = 0; n < numSamples; ++n) {
         // Safety and denormal protection
-        output = flushDenorm(output);
+        float output = flushDenorm(data[n]);
         if (!std::isfinite(output)) output = 0.0f;
-        output = clamp(output, -2.0f, 2.0f);
-
-        data[n] = output;
+        data[n] = clamp(output, -2.0f, 2.0f);
     }
 }
 
-// -------------------------------------------------------
-void SpectralGate_Platinum::FFTProcessor::prepareWindow() {
-    // Hann window for smooth overlap
-    for (int i = 0; i < kFFTSize; ++i) {
-        window[i] = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / (kFFTSize - 1.0f)));
-    }
-}
-
-void SpectralGate_Platinum::FFTProcessor::processFrame(const float* input, float* output,
-                                                       float threshold, float ratio,
-                                                       int binLow, int binHigh) {
-    // SAFETY: Validate inputs
-    if (!input || !output) {
-        if (output) {
-            std::fill(output, output + kFFTSize, 0.0f);
-        }
-        return;
-    }
-
-    // SAFETY: Clamp bin ranges
-    binLow = std::clamp(binLow, 0, kFFTBins - 1);
-    binHigh = std::clamp(binHigh, binLow, kFFTBins - 1);
-    threshold = std::max(1e-10f, threshold);  // SAFETY: Prevent division by zero
-    ratio = std::clamp(ratio, 1.0f, 100.0f);  // SAFETY: Reasonable ratio range
-
-    // Copy and window input with NaN protection
-    for (int i = 0; i < kFFTSize; ++i) {
-        float sample = input[i];
-        // SAFETY: NaN/Inf check
-        if (!std::isfinite(sample)) {
-            sample = 0.0f;
-        }
-        fftData[i] = sample * window[i];
-    }
-
-    // Forward FFT
-    fft.performFrequencyOnlyForwardTransform(fftData.data());
-
+void SpectralGate_Platinum::gateFrame(Channel& ch, std::complex<float>* bins,
+                                      const GateSettings& settings) noexcept {
     // Apply spectral gating with full safety checks
     for (int bin = 0; bin < kFFTBins; ++bin) {
-        float real = fftData[bin * 2];
-        float imag = fftData[bin * 2 + 1];
+        float real = bins[bin].real();
+        float imag = bins[bin].imag();
 
         // SAFETY: NaN check on FFT output
         if (!std::isfinite(real) || !std::isfinite(imag)) {
-            fftData[bin * 2] = 0.0f;
-            fftData[bin * 2 + 1] = 0.0f;
+            bins[bin] = 0.0f;
             continue;
         }
 
@@ -331,68 +236,32 @@ void SpectralGate_Platinum::FFTProcessor::processFrame(const float* input, float
             mag = 0.0f;
         }
 
-        float gain = 1.0f;
+        float target = 1.0f;
 
         // Gate logic: only process bins in frequency range
-        if (bin >= binLow && bin <= binHigh) {
-            if (mag < threshold) {
+        if (bin >= settings.binLow && bin <= settings.binHigh) {
+            if (mag < settings.threshold) {
                 // Below threshold: apply full gating
-                gain = 0.0f;
-            } else if (ratio > 1.0f) {
+                target = 0.0f;
+            } else if (settings.ratio > 1.0f) {
                 // Above threshold: apply ratio
-                float excess = mag - threshold;
-                float gated = threshold + excess / ratio;
+                float excess = mag - settings.threshold;
+                float gated = settings.threshold + excess / settings.ratio;
                 // SAFETY: Prevent division by zero
-                gain = gated / std::max(mag, 1e-10f);
+                target = gated / std::max(mag, 1e-10f);
                 // SAFETY: Clamp gain to valid range
-                gain = std::clamp(gain, 0.0f, 1.0f);
+                target = std::clamp(target, 0.0f, 1.0f);
             }
         }
 
-        // Apply gain to complex components
-        fftData[bin * 2] *= gain;
-        fftData[bin * 2 + 1] *= gain;
-    }
-
-    // Inverse FFT
-    fft.performRealOnlyInverseTransform(fftData.data());
-
-    // Overlap-add with windowing and safety checks
-    // JUCE FFT includes 1/N scaling; Hann window with 75% overlap sums to ~1.5
-    const float scaleFactor = 1.0f / 1.5f;
-
-    for (int i = 0; i < kFFTSize; ++i) {
-        float ifftSample = fftData[i];
-
-        // SAFETY: NaN check on IFFT output
-        if (!std::isfinite(ifftSample)) {
-            ifftSample = 0.0f;
-        }
-
-        float windowed = ifftSample * window[i] * scaleFactor;
+        // Attack opens the bin, release closes it
+        float& gain = ch.binGain[bin];
+        const float coeff = target > gain ? settings.attackCoeff : settings.releaseCoeff;
+        gain = flushDenorm(target + (gain - target) * coeff);
 
-        // SAFETY: Clamp windowed output
-        windowed = std::clamp(windowed, -10.0f, 10.0f);
-
-        // Overlap-add
-        int pos = (overlapPos + i) % kFFTSize;
-        if (i < kHopSize) {
-            output[i] = overlapBuf[pos] + windowed;
-            // SAFETY: Final output sanitation
-            if (!std::isfinite(output[i])) {
-                output[i] = 0.0f;
-            }
-            output[i] = std::clamp(output[i], -2.0f, 2.0f);
-            overlapBuf[pos] = 0.0f;
-        } else {
-            overlapBuf[pos] += windowed;
-            // SAFETY: Clamp overlap buffer to prevent accumulation
-            overlapBuf[pos] = std::clamp(overlapBuf[pos], -10.0f, 10.0f);
-            output[i] = 0.0f;
-        }
+        // Apply gain to complex components
+        bins[bin] *= gain;
     }
-
-    overlapPos = (overlapPos + kHopSize) % kFFTSize;
 }
 
 // -------------------------------------------------------
@@ -411,12 +280,11 @@ juce::String SpectralGate_Platinum::getParameterName(int index) const {
 }
 
 int SpectralGate_Platinum::getLatencySamples() const noexcept {
-    // FFT processing latency is the hop size plus any lookahead delay
-    int fftLatency = kHopSize;
-    
-    // Add lookahead delay if enabled
-    float lookaheadMs = pLookahead.current;
-    int lookaheadSamples = static_cast<int>(lookaheadMs * 0.001 * sr_);
-    
-    return fftLatency + lookaheadSamples;
+    // One STFT frame
+    return stft_.getLatencySamples();
+}
+
+double SpectralGate_Platinum::getTailLengthSeconds() const noexcept {
+    // The last frame drains out of the overlap-add
+    return stft_.getLatencySamples() / sr_;
 }
\ No newline at end of file
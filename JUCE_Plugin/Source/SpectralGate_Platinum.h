@@ -3,6 +3,7 @@
 #include "EngineBase.h"
 #include <JuceHeader.h>
 #include "DspEngineUtilities.h"
+#include "StftProcessor.h"
 #include <array>
 #include <atomic>
 #include <memory>
@@ -17,6 +18,7 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override;  // Sets the STFT overlap
 
     int getNumParameters() const override { return 8; }
     juce::String getParameterName(int index) const override;
@@ -24,6 +26,7 @@ public:
     
     // Extended API - latency reporting
     int getLatencySamples() const noexcept override;
+    double getTailLengthSeconds() const noexcept override;
 
     // Must match APVTS parameter order
     enum class ParamID : int {
@@ -33,7 +36,7 @@ public:
         Release = 3,       // ms
         FreqLow = 4,       // Hz
         FreqHigh = 5,      // Hz
-        Lookahead = 6,     // ms
+        Lookahead = 6,     // ms (the STFT frame already looks ahead; kept for mapping)
         Mix = 7            // dry/wet
     };
 
@@ -72,54 +75,27 @@ private:
     };
 
     // --------- DSP components ----------
-    // Simple, stable FFT without hanging (bounded iteration counts)
-    static constexpr int kFFTOrder = 10;       // 1024 points (reduced for stability)
+    // Framing, windows and overlap-add are the shared StftProcessor's; the
+    // gate is its per-frame kernel
+    static constexpr int kFFTOrder = 10;       // 1024 points
     static constexpr int kFFTSize = 1 << kFFTOrder;
     static constexpr int kFFTBins = kFFTSize / 2 + 1;
-    static constexpr int kOverlap = 4;         // 75% overlap
-    static constexpr int kHopSize = kFFTSize / kOverlap;
 
-    struct FFTProcessor {
-        juce::dsp::FFT fft{kFFTOrder};
-        std::array<float, kFFTSize * 2> fftData{};
-        std::array<float, kFFTSize> window{};
-        std::array<float, kFFTSize> overlapBuf{};
-        int overlapPos{0};
-
-        void prepareWindow();
-        void processFrame(const float* input, float* output,
-                         float threshold, float ratio,
-                         int binLow, int binHigh);
-        void reset() {
-            std::fill(fftData.begin(), fftData.end(), 0.0f);
-            std::fill(overlapBuf.begin(), overlapBuf.end(), 0.0f);
-            overlapPos = 0;
-        }
+    // Per-frame gate settings, worked out once per block
+    struct GateSettings {
+        float threshold{1.0f};
+        float ratio{1.0f};
+        int binLow{0}, binHigh{0};
+        float attackCoeff{0.0f};   // per hop, gain rising
+        float releaseCoeff{0.0f};  // per hop, gain falling
     };
 
     struct Channel {
-        FFTProcessor fftProc;
-        std::array<float, kFFTSize> inputBuf{};
-        std::array<float, kFFTSize> outputBuf{};
-        int writePos{0}, readPos{0};
-        int hopCounter{0};
-
-        // Simple lookahead delay
-        std::vector<float> delayBuf;
-        int delayWrite{0};
-        int delaySamples{0};
-
-        // Per-bin envelope followers (bounded)
-        std::array<float, kFFTBins> binEnv{};
+        // Per-bin gain followers, smoothed across frames
+        std::array<float, kFFTBins> binGain{};
 
         void reset() {
-            fftProc.reset();
-            std::fill(inputBuf.begin(), inputBuf.end(), 0.0f);
-            std::fill(outputBuf.begin(), outputBuf.end(), 0.0f);
-            std::fill(binEnv.begin(), binEnv.end(), 0.0f);
-            writePos = readPos = hopCounter = 0;
-            if (!delayBuf.empty()) std::fill(delayBuf.begin(), delayBuf.end(), 0.0f);
-            delayWrite = 0;
+            std::fill(binGain.begin(), binGain.end(), 1.0f);
         }
     };
 
@@ -133,12 +109,15 @@ private:
 
     // DSP channels
     std::vector<Channel> channels_;
+    StftProcessor stft_;
+    int overlap_{StftProcessor::overlapForQuality(Quality::Ultra)};
 
-    // Bounded iteration guard
-    int maxProcessingIterations_{0};
+    // Dry copy for the mix, sized in prepareToPlay
+    juce::AudioBuffer<float> dryBuffer_;
 
     // --------- Methods ----------
-    void processChannel(Channel& ch, float* data, int numSamples);
+    void processChannel(int index, float* data, int numSamples);
+    static void gateFrame(Channel& ch, std::complex<float>* bins, const GateSettings& settings) noexcept;
     static int freqToBin(float hz, double sr) {
         const float binHz = float(sr) / float(kFFTSize);
         return clamp(int(hz / binHz), 0, kFFTBins - 1);
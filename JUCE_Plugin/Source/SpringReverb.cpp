@@ -131,6 +131,7 @@ public:
     std::vector<float> predelayBufferL;
     std::vector<float> predelayBufferR;
     int predelayIndex = 0;
+    int predelayHighWater = 0;  // Slots written since reset(); the rest read as silence
     int predelaySize = 0;
     
     // Filters
@@ -185,9 +186,10 @@ public:
             springs[i].reset();
         }
         
-        std::fill(predelayBufferL.begin(), predelayBufferL.end(), 0.0f);
-        std::fill(predelayBufferR.begin(), predelayBufferR.end(), 0.0f);
+        // Predelay clears lazily: writes restart from slot 0, and slots at or
+        // above the high-water mark read as silence
         predelayIndex = 0;
+        predelayHighWater = 0;
         
         lowCutStateL = 0.0f;
         lowCutStateR = 0.0f;
@@ -265,10 +267,12 @@ public:
             float delayedR = inputR;
             
             if (predelaySize > 0) {
-                delayedL = predelayBufferL[predelayIndex];
-                delayedR = predelayBufferR[predelayIndex];
+                const bool fresh = predelayIndex < predelayHighWater;
+                delayedL = fresh ? predelayBufferL[predelayIndex] : 0.0f;
+                delayedR = fresh ? predelayBufferR[predelayIndex] : 0.0f;
                 predelayBufferL[predelayIndex] = inputL;
                 predelayBufferR[predelayIndex] = inputR;
+                predelayHighWater = std::max(predelayHighWater, predelayIndex + 1);
                 
                 if (++predelayIndex >= predelaySize) {
                     predelayIndex = 0;
@@ -342,6 +346,13 @@ public:
         }
     }
     
+    double getTailLengthSeconds() const {
+        // Longest spring delay at maximum tension, as a safe upper bound
+        const double longestSpring = springDelays[numSprings - 1] * (1.0 + (numSprings - 1) * 0.1) * 1.5 / 1000.0;
+        const double feedback = 0.7 + decayParam * 0.28;
+        return predelayParam * 0.1 + getFeedbackTailSeconds(longestSpring, feedback);
+    }
+    
     void setParameter(int index, float value) {
         value = std::clamp(value, 0.0f, 1.0f);
         
@@ -408,4 +419,8 @@ int SpringReverb::getNumParameters() const {
 
 juce::String SpringReverb::getName() const {
     return "Spring Reverb";
+}
+
+double SpringReverb::getTailLengthSeconds() const noexcept {
+    return pImpl->getTailLengthSeconds();
 }
\ No newline at end of file
@@ -40,6 +40,8 @@ public:
     juce::String getParameterName(int index) const override;
     juce::String getName() const override;
     
+    double getTailLengthSeconds() const noexcept override;
+    
 private:
     // Implementation class (Pimpl idiom)
     class Impl;
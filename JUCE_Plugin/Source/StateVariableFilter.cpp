@@ -172,18 +172,26 @@ StateVariableFilter::MultiModeFilter::Type StateVariableFilter::getFilterTypeFro
 
 void StateVariableFilter::updateParameters(const std::map<int, float>& params) {
     for (const auto& [index, value] : params) {
-        switch (index) {
-            case 0: m_frequency->setTarget(value); break;
-            case 1: m_resonance->setTarget(value); break;
-            case 2: m_drive->setTarget(value); break;
-            case 3: m_filterType->setTarget(value); break;
-            case 4: m_slope->setTarget(value); break;
-            case 5: m_envelope->setTarget(value); break;
-            case 6: m_envAttack->setTarget(value); break;
-            case 7: m_envRelease->setTarget(value); break;
-            case 8: m_analog->setTarget(value); break;
-            case 9: m_mix->setTarget(value); break;
-        }
+        setParameter(index, value);
+    }
+}
+
+void StateVariableFilter::updateParameterSnapshot(const ParameterSnapshot& snapshot) {
+    snapshot.forEachDirty([this](int index, float value) { setParameter(index, value); });
+}
+
+void StateVariableFilter::setParameter(int index, float value) {
+    switch (index) {
+        case 0: m_frequency->setTarget(value); break;
+        case 1: m_resonance->setTarget(value); break;
+        case 2: m_drive->setTarget(value); break;
+        case 3: m_filterType->setTarget(value); break;
+        case 4: m_slope->setTarget(value); break;
+        case 5: m_envelope->setTarget(value); break;
+        case 6: m_envAttack->setTarget(value); break;
+        case 7: m_envRelease->setTarget(value); break;
+        case 8: m_analog->setTarget(value); break;
+        case 9: m_mix->setTarget(value); break;
     }
 }
 
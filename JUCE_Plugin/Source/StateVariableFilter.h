@@ -21,12 +21,15 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void updateParameterSnapshot(const ParameterSnapshot& snapshot) override;
     
     juce::String getName() const override { return "State Variable Filter"; }
     int getNumParameters() const override { return 10; }
     juce::String getParameterName(int index) const override;
     
 private:
+    void setParameter(int index, float value);
+    
     // Simple parameter smoother
     class ParameterSmoother {
         float m_currentValue = 0.0f;
@@ -14,6 +14,11 @@ public:
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
     
+    // Up to 50 ms of delay, recirculated by the feedback plus 30% crossfeed
+    double getTailLengthSeconds() const noexcept override {
+        return getFeedbackTailSeconds(0.05, m_feedback.target * 1.3);
+    }
+    
     int getNumParameters() const override { return 6; }
     juce::String getParameterName(int index) const override;
     juce::String getName() const override { return "StereoChorus"; }
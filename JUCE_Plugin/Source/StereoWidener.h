@@ -20,6 +20,9 @@ public:
     juce::String getParameterName(int index) const override;
     juce::String getName() const override { return "Stereo Widener"; }
     
+    // The Haas delay holds up to 30 ms; nothing recirculates
+    double getTailLengthSeconds() const noexcept override { return m_delayTime.target * 0.030; }
+    
 private:
     // Smoothed parameters for boutique quality
     struct SmoothParam {
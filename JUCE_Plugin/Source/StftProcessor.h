@@ -0,0 +1,217 @@
+// StftProcessor.h - Shared short-time Fourier transform for the spectral engines
+//
+// Frames, windows and overlap-adds a stream so that an engine only supplies
+// its spectral kernel: a callable given each frame's non-negative-frequency
+// bins (numBins = fftSize / 2 + 1), in place, once per hop. A kernel that
+// returns false leaves that frame out of the output and skips its inverse
+// transform.
+//
+// Each channel keeps its input history and its overlap-add accumulator in
+// power-of-two rings, so framing a hop is a masked copy in at most two runs
+// rather than a modulo per sample. The analysis window and the synthesis
+// window, with the overlap-add normalisation for the current hop folded in
+// per position, are tables, so any overlap of two or more reconstructs the
+// input exactly when the kernel leaves the bins alone.
+//
+// The FFT size is fixed by prepare() and so is the latency: one frame. The
+// overlap can be changed on the audio thread; that is how the engines trade
+// cost for quality (overlapForQuality()) without moving their latency.
+//
+// Everything is allocated in prepare(); process() is real-time safe.
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "EngineBase.h"
+#include "RealFFT.h"
+#include <complex>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+class StftProcessor {
+public:
+    static constexpr int MIN_OVERLAP = 2;
+    static constexpr int MAX_OVERLAP = 8;
+
+    // Frames per FFT size for each tier: cost scales with it, latency doesn't.
+    // The top tiers keep the 75% overlap the engines were tuned at.
+    static int overlapForQuality(EngineBase::Quality quality) noexcept {
+        switch (quality) {
+            case EngineBase::Quality::Draft:
+            case EngineBase::Quality::Normal: return 2;
+            case EngineBase::Quality::High:
+            case EngineBase::Quality::Ultra:  return 4;
+        }
+        return 4;
+    }
+
+    // Message thread: frames of 2^fftOrder samples, overlap a power of two
+    // from MIN_OVERLAP to MAX_OVERLAP
+    void prepare(int numChannels, int fftOrder, int overlap) {
+        if (fft == nullptr || fft->getSize() != (1 << fftOrder))
+            fft = std::make_unique<RealFFT>(fftOrder);
+
+        fftSize = 1 << fftOrder;
+        numBins = fftSize / 2 + 1;
+
+        analysisWindow.resize((size_t) fftSize);
+        synthesisWindow.resize((size_t) fftSize);
+        for (int i = 0; i < fftSize; ++i)
+            analysisWindow[(size_t) i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float) i / (float) fftSize);
+
+        frame.resize((size_t) fftSize + 2);
+        channels.resize((size_t) numChannels);
+        for (auto& channel : channels) {
+            channel.input.resize((size_t) fftSize);
+            channel.output.resize((size_t) fftSize * 2);
+        }
+
+        hopSize = 0;
+        setOverlap(overlap);
+        reset();
+    }
+
+    void reset() noexcept {
+        for (auto& channel : channels) {
+            std::fill(channel.input.begin(), channel.input.end(), 0.0f);
+            std::fill(channel.output.begin(), channel.output.end(), 0.0f);
+            channel.position = 0;
+            channel.untilFrame = hopSize;
+        }
+    }
+
+    // Audio thread. The frames already overlapping when the hop changes were
+    // normalised for the old one, so the next frame's worth of output is only
+    // approximately reconstructed.
+    void setOverlap(int overlap) noexcept {
+        overlap = juce::jlimit(MIN_OVERLAP, MAX_OVERLAP, juce::nextPowerOfTwo(overlap));
+        const int newHop = fftSize / overlap;
+        if (newHop == hopSize)
+            return;
+
+        hopSize = newHop;
+
+        // Analysis and synthesis windows overlapping at each position of the
+        // hop must sum to one (the inverse transform already scales by 1/N)
+        for (int i = 0; i < hopSize; ++i) {
+            float sumOfSquares = 0.0f;
+            for (int j = i; j < fftSize; j += hopSize)
+                sumOfSquares += analysisWindow[(size_t) j] * analysisWindow[(size_t) j];
+
+            for (int j = i; j < fftSize; j += hopSize)
+                synthesisWindow[(size_t) j] = analysisWindow[(size_t) j] / sumOfSquares;
+        }
+
+        for (auto& channel : channels)
+            channel.untilFrame = juce::jmin(channel.untilFrame, hopSize);
+    }
+
+    int getFftSize() const noexcept { return fftSize; }
+    int getHopSize() const noexcept { return hopSize; }
+    int getOverlap() const noexcept { return fftSize / hopSize; }
+    int getNumBins() const noexcept { return numBins; }
+    int getNumChannels() const noexcept { return (int) channels.size(); }
+
+    // A sample enters at the end of a frame and is complete once the last
+    // frame overlapping it has been added
+    int getLatencySamples() const noexcept { return fftSize; }
+
+    // Bytes held by the rings, windows and frame
+    size_t getMemoryBytes() const noexcept {
+        size_t floats = analysisWindow.size() + synthesisWindow.size() + frame.size();
+        for (const auto& channel : channels)
+            floats += channel.input.size() + channel.output.size();
+        return floats * sizeof(float);
+    }
+
+    // Runs one channel through the kernel, called as kernel (bins, numBins)
+    // with bins a std::complex<float>*. output may alias input.
+    template <typename Kernel>
+    void process(int channel, const float* input, float* output, int numSamples, Kernel&& kernel) noexcept {
+        auto& state = channels[(size_t) channel];
+        const int inputMask = fftSize - 1;
+        const int outputMask = fftSize * 2 - 1;
+
+        for (int done = 0; done < numSamples;) {
+            const int todo = juce::jmin(numSamples - done, state.untilFrame);
+
+            copyIntoRing(state.input.data(), inputMask, state.position & inputMask, input + done, todo);
+            state.untilFrame -= todo;
+
+            // The frame ends with this run's last sample; its output starts
+            // just after, so the run below reads nothing it writes
+            if (state.untilFrame == 0) {
+                processFrame(state, (state.position + todo) & outputMask, kernel);
+                state.untilFrame = hopSize;
+            }
+
+            readOutOfRing(state.output.data(), outputMask, state.position, output + done, todo);
+            state.position = (state.position + todo) & outputMask;
+            done += todo;
+        }
+    }
+
+private:
+    struct Channel {
+        std::vector<float> input;   // last fftSize samples
+        std::vector<float> output;  // overlap-add accumulator, two frames long
+        int position = 0;           // next sample's slot in the output ring
+        int untilFrame = 0;         // samples still to come before the next frame
+    };
+
+    static void copyIntoRing(float* ring, int mask, int start, const float* source, int count) noexcept {
+        const int first = juce::jmin(count, mask + 1 - start);
+        std::copy(source, source + first, ring + start);
+        std::copy(source + first, source + count, ring);
+    }
+
+    static void readOutOfRing(float* ring, int mask, int start, float* destination, int count) noexcept {
+        const int first = juce::jmin(count, mask + 1 - start);
+        std::copy(ring + start, ring + start + first, destination);
+        std::fill(ring + start, ring + start + first, 0.0f);
+        std::copy(ring, ring + count - first, destination + first);
+        std::fill(ring, ring + count - first, 0.0f);
+    }
+
+    template <typename Kernel>
+    void processFrame(Channel& state, int outputStart, Kernel& kernel) noexcept {
+        // The input ring holds exactly one frame; its oldest sample sits where
+        // the next will be written
+        const int oldest = outputStart & (fftSize - 1);
+        const int firstRun = fftSize - oldest;
+        const float* history = state.input.data();
+        float* data = frame.data();
+
+        for (int i = 0; i < firstRun; ++i)
+            data[i] = history[oldest + i] * analysisWindow[(size_t) i];
+        for (int i = firstRun; i < fftSize; ++i)
+            data[i] = history[i - firstRun] * analysisWindow[(size_t) i];
+
+        auto* bins = reinterpret_cast<std::complex<float>*>(data);
+        fft->forward(data, bins);
+
+        if constexpr (std::is_same_v<decltype(kernel(bins, numBins)), bool>) {
+            if (!kernel(bins, numBins))
+                return;
+        } else {
+            kernel(bins, numBins);
+        }
+
+        fft->inverse(bins, data);
+
+        float* accumulator = state.output.data();
+        const int outputMask = fftSize * 2 - 1;
+        const int run = juce::jmin(fftSize, outputMask + 1 - outputStart);
+
+        for (int i = 0; i < run; ++i)
+            accumulator[outputStart + i] += data[i] * synthesisWindow[(size_t) i];
+        for (int i = run; i < fftSize; ++i)
+            accumulator[i - run] += data[i] * synthesisWindow[(size_t) i];
+    }
+
+    std::unique_ptr<RealFFT> fft;
+    int fftSize = 0, hopSize = 0, numBins = 0;
+
+    std::vector<float> analysisWindow, synthesisWindow, frame;
+    std::vector<Channel> channels;
+};
@@ -202,14 +202,18 @@ void TapeEcho::process(juce::AudioBuffer<float>& buffer)
         const float lpHz = 6000.0f * (1.0f - 0.3f * fbAmt);
         cs.lpAlpha = 1.0f - std::exp(-2.0f * juce::MathConstants<float>::pi * lpHz / (float)sampleRate_);
 
+        float speedMods[Modulators::kChunk];
         for (int i = 0; i < n; ++i)
         {
+            if (i % Modulators::kChunk == 0)
+                cs.mod.render(modAmt, speedMods, std::min(Modulators::kChunk, n - i), mathAccuracy_);
+
             // safe input
             float in = rd[i];
             if (!std::isfinite(in)) in = 0.0f;
 
             // per-sample modulation of delay (speed-based mapping)
-            const float speedMod = cs.mod.process(modAmt); // ~[-small..small]
+            const float speedMod = speedMods[i % Modulators::kChunk]; // ~[-small..small]
             const float modDelayMs = baseDelayMs * (1.0f + speedMod); // simple & musical
             float delaySamples = juce::jlimit(1.0f,
                 (float) cs.delay.capacity(),
@@ -274,6 +278,18 @@ bool TapeEcho::supportsFeature(Feature f) const noexcept
     }
 }
 
+double TapeEcho::getTailLengthSeconds() const noexcept
+{
+    // Wow/flutter stretches the loop by a few percent at most
+    const double loopSeconds = calculateSyncedDelayTime(pTime_.current, pSync_.current) * 0.001 * 1.05;
+    return getFeedbackTailSeconds(loopSeconds, pFeedback_.current);
+}
+
+void TapeEcho::setQuality(Quality q)
+{
+    mathAccuracy_ = FastMath::accuracyForQuality(q);
+}
+
 float TapeEcho::calculateSyncedDelayTime(float timeParam, float syncParam) const
 {
     // Sync is off if syncParam < 0.5, use manual time
@@ -36,6 +36,8 @@ public:
     // Extended EngineBase API
     void setTransportInfo(const TransportInfo& info) override;
     bool supportsFeature(Feature f) const noexcept override;
+    double getTailLengthSeconds() const noexcept override;
+    void setQuality(Quality q) override;  // Sets the saturation and modulation math accuracy
 
     // Param order: 0 Time, 1 Feedback, 2 WowFlutter, 3 Saturation, 4 Mix, 5 Sync
 
@@ -175,35 +177,44 @@ private:
 
         inline void updateRandomOncePerBlock() { rndTarget = 0.3f * fastRandBi(); }
 
-        inline float process(float amt) {
-            phWow    += kWowRate   * inc;
-            phFlut1  += kFl1       * inc;
-            phFlut2  += kFl2       * inc;
-            phDrift  += kDrift     * inc;
-            phScrape += kScrape    * inc;
-            auto wrap = [](float& p){ 
-                p = std::fmod(p, 2.0f * juce::MathConstants<float>::pi);
-                if (p < 0.0f) p += 2.0f * juce::MathConstants<float>::pi;
-                if (!std::isfinite(p)) p = 0.0f; // Safety check
-            };
-            wrap(phWow); wrap(phFlut1); wrap(phFlut2); wrap(phDrift); wrap(phScrape);
-
-            rndState += (rndTarget - rndState) * 0.001f;
-
-            const float sum =
-                std::sin(phWow)   * dWow +
-                std::sin(phFlut1) * dFl1 +
-                std::sin(phFlut2) * dFl2 +
-                std::sin(phDrift) * dDrift +
-                std::sin(phScrape)* dScr +
-                rndState * 0.002f;
-
-            // Safety check for NaN/Inf
-            if (!std::isfinite(sum)) return 0.0f;
-            
-            // Map as tape speed modulation: delay ∝ 1/speed -> approx (1 / (1 + s))
-            const float s = juce::jlimit(-0.05f, 0.05f, sum * amt);
-            return -s; // negative for delay change (increase speed -> shorter delay)
+        static constexpr int kChunk = 64;  // samples of modulation rendered at a time
+
+        // Speed modulation for the next numSamples (at most kChunk) samples.
+        // The phases advance sample by sample; their sines then go through
+        // FastMath's block sincos rather than five libm calls per sample.
+        inline void render(float amt, float* out, int numSamples, FastMath::Accuracy accuracy) noexcept {
+            constexpr float twoPi = 2.0f * juce::MathConstants<float>::pi;
+            constexpr float rates[]  = { kWowRate, kFl1, kFl2, kDrift, kScrape };
+            constexpr float depths[] = { dWow, dFl1, dFl2, dDrift, dScr };
+            float* const phases[] = { &phWow, &phFlut1, &phFlut2, &phDrift, &phScrape };
+
+            float sines[5][kChunk], phase[kChunk], cosines[kChunk];
+            for (int k = 0; k < 5; ++k) {
+                float p = *phases[k];
+                const float step = rates[k] * inc;
+                for (int i = 0; i < numSamples; ++i) {
+                    p += step;
+                    if (p >= twoPi) p -= twoPi;  // steps are far below 2π
+                    phase[i] = p;
+                }
+                *phases[k] = std::isfinite(p) ? p : 0.0f; // Safety check
+                FastMath::sincos(phase, sines[k], cosines, numSamples, accuracy);
+            }
+
+            for (int i = 0; i < numSamples; ++i) {
+                rndState += (rndTarget - rndState) * 0.001f;
+
+                float sum = rndState * 0.002f;
+                for (int k = 0; k < 5; ++k)
+                    sum += sines[k][i] * depths[k];
+
+                // Safety check for NaN/Inf
+                if (!std::isfinite(sum)) sum = 0.0f;
+
+                // Map as tape speed modulation: delay ∝ 1/speed -> approx (1 / (1 + s))
+                const float s = juce::jlimit(-0.05f, 0.05f, sum * amt);
+                out[i] = -s; // negative for delay change (increase speed -> shorter delay)
+            }
         }
     };
 
@@ -255,6 +266,7 @@ private:
     // --------------------------------- runtime
     double sampleRate_ = 44100.0;
     std::array<ChannelState, kMaxChannels> ch_{};
+    FastMath::Accuracy mathAccuracy_ = FastMath::Accuracy::Fine;
     
     // --------------------------------- transport sync
     TransportInfo transportInfo_;
@@ -279,12 +291,12 @@ private:
     // --------------------------------- helpers
     inline float softSaturate(float x) noexcept {
         // mild symmetric limiter
-        return std::tanh(x * 1.5f) * (1.0f / 1.5f);
+        return FastMath::tanh(x * 1.5f, mathAccuracy_) * (1.0f / 1.5f);
     }
     inline float saturateTape(float x, float amt) noexcept {
         // simple tape-ish curve with bias-less soft knee
         const float drive = 1.0f + 4.0f * juce::jlimit(0.0f, 1.0f, amt);
-        const float y = std::tanh(x * drive * 0.8f);
+        const float y = FastMath::tanh(x * drive * 0.8f, mathAccuracy_);
         return y / (0.9f * drive);
     }
 
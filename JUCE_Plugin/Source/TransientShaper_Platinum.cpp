@@ -1,4 +1,5 @@
 #include "TransientShaper_Platinum.h"
+#include "SlidingWindowPeak.h"
 #include <JuceHeader.h>
 
 // Platform-specific SIMD includes
@@ -159,6 +160,10 @@ public:
     inline float getBlockValue() const noexcept {
         return blockValue;
     }
+    
+    float getTarget() const noexcept {
+        return target.load(std::memory_order_relaxed);
+    }
 
 private:
     std::atomic<float> target{0.0f};
@@ -584,24 +589,43 @@ private:
     float inverseRatio = 0.25f;
 };
 
-// Lookahead delay line
+// Lookahead delay line. A new delay is crossfaded in from the old tap over
+// FADE_SAMPLES rather than jumping to it; getDelay() is the delay being
+// moved to, which is what the engine reports as latency.
 class LookaheadProcessor {
 public:
+    static constexpr int FADE_SAMPLES = 64;
+    
     void prepare(int maxSamples) noexcept {
         buffer.resize(maxSamples, 0.0f);
         writeIndex = 0;
         delaySamples = 0;
+        previousDelay = 0;
+        targetDelay = 0;
+        fadeRemaining = 0;
     }
     
     void setDelay(int samples) noexcept {
-        delaySamples = std::min(samples, static_cast<int>(buffer.size()));
+        targetDelay = std::clamp(samples, 0, static_cast<int>(buffer.size()) - 1);
     }
     
+    int getDelay() const noexcept { return targetDelay; }
+    
     inline float process(float input) noexcept {
         buffer[writeIndex] = input;
-        int readIndex = static_cast<int>((writeIndex - delaySamples + buffer.size()) % buffer.size());
+        if (fadeRemaining == 0 && targetDelay != delaySamples) {
+            previousDelay = delaySamples;
+            delaySamples = targetDelay;
+            fadeRemaining = FADE_SAMPLES;
+        }
+        float output = read(delaySamples);
+        if (fadeRemaining > 0) {
+            const float oldWeight = static_cast<float>(fadeRemaining) / FADE_SAMPLES;
+            output += (read(previousDelay) - output) * oldWeight;
+            --fadeRemaining;
+        }
         writeIndex = (writeIndex + 1) % buffer.size();
-        return buffer[readIndex];
+        return output;
     }
     
     inline float peek(int samplesAhead) const noexcept {
@@ -612,12 +636,21 @@ public:
     void reset() noexcept {
         std::fill(buffer.begin(), buffer.end(), 0.0f);
         writeIndex = 0;
+        delaySamples = targetDelay;
+        fadeRemaining = 0;
     }
 
 private:
+    inline float read(int delay) const noexcept {
+        return buffer[static_cast<int>((writeIndex - delay + buffer.size()) % buffer.size())];
+    }
+    
     std::vector<float> buffer;
     int writeIndex = 0;
     int delaySamples = 0;
+    int previousDelay = 0;
+    int targetDelay = 0;
+    int fadeRemaining = 0;
 };
 
 // Main implementation
@@ -641,6 +674,7 @@ struct TransientShaper_Platinum::Impl {
         TransientSeparator separator;
         SoftKneeProcessor kneeProcessor;
         LookaheadProcessor lookaheadProc;
+        SlidingWindowPeak lookaheadPeak;  // detector input: peak of the window ahead
         
         // Simple envelope followers for SPL algorithm
         float fastEnv = 0.0f;
@@ -655,6 +689,7 @@ struct TransientShaper_Platinum::Impl {
             diffDetector.prepare(sampleRate);
             separator.prepare(sampleRate);
             lookaheadProc.prepare(2048); // ~46ms at 44.1kHz
+            lookaheadPeak.prepare(2048);
             
             juce::dsp::ProcessSpec spec;
             spec.sampleRate = sampleRate;
@@ -668,6 +703,7 @@ struct TransientShaper_Platinum::Impl {
             diffDetector.reset();
             separator.reset();
             lookaheadProc.reset();
+            lookaheadPeak.reset();
             oversampler.reset();
             fastEnv = 0.0f;
             slowEnv = 0.0f;
@@ -762,7 +798,9 @@ struct TransientShaper_Platinum::Impl {
         cache.attackMs = 0.1f + attackTime.getBlockValue() * 49.9f;  // 0.1 to 50ms
         cache.releaseMs = 1.0f + releaseTime.getBlockValue() * 499.0f; // 1 to 500ms
         cache.separationAmount = separation.getBlockValue();
-        cache.lookaheadSamples = static_cast<int>(lookahead.getBlockValue() * 2048);
+        // The delay follows the target, not the smoother: every distinct
+        // length is a crossfade and a host latency change
+        cache.lookaheadSamples = static_cast<int>(lookahead.getTarget() * 2048);
         cache.kneeWidth = softKnee.getBlockValue();
         cache.mixAmount = mix.getBlockValue();
         
@@ -789,6 +827,7 @@ struct TransientShaper_Platinum::Impl {
             ch.detector.updateBlockCache(); // Update detector's block cache
             ch.separator.setSeparation(cache.separationAmount);
             ch.lookaheadProc.setDelay(cache.lookaheadSamples);
+            ch.lookaheadPeak.setWindowLength(ch.lookaheadProc.getDelay() + 1);
             ch.kneeProcessor.setThreshold(0.7f);
             ch.kneeProcessor.setKnee(cache.kneeWidth);
             ch.kneeProcessor.setRatio(2.0f + cache.separationAmount * 8.0f);
@@ -805,9 +844,17 @@ struct TransientShaper_Platinum::Impl {
         // Allow processing at very low mix values for subtle mixing (removed 0.001f threshold)
         // The mix calculation will naturally handle blending, even at very low values
         
-        // Early bypass if mix is 0
+        // Early bypass if mix is 0: only the lookahead delay runs, so the
+        // output stays aligned with the latency reported to the host
         if (cache.mixAmount < 0.001f) {
-            // Complete bypass - don't process at all
+            for (int ch = 0; ch < numChannels; ++ch) {
+                float* data = buffer.getWritePointer(ch);
+                auto& processor = channels[ch];
+                for (int i = 0; i < numSamples; ++i) {
+                    processor.lookaheadPeak.process(std::abs(data[i]));
+                    data[i] = processor.lookaheadProc.process(data[i]);
+                }
+            }
             return;
         }
         
@@ -815,13 +862,12 @@ struct TransientShaper_Platinum::Impl {
             float* data = buffer.getWritePointer(ch);
             auto& processor = channels[ch];
             
-            // Store dry signal if needed for wet/dry mixing
-            if (cache.mixAmount < 0.999f) {
-                std::copy_n(data, numSamples, dryBuffer.data());
-            }
-            
+            // processSample() hands back the delayed input as the dry signal,
+            // so wet and dry stay aligned at any lookahead
             if (cache.oversampleFactor > 1) {
 #if TRANSIENT_SHAPER_ENABLE_OVERSAMPLING
+                std::copy_n(data, numSamples, dryBuffer.data());
+                
                 // Oversampled processing
                 juce::dsp::AudioBlock<float> block(&data, 1, numSamples);
                 juce::dsp::AudioBlock<float> osBlock = processor.oversampler.processSamplesUp(block);
@@ -837,13 +883,13 @@ struct TransientShaper_Platinum::Impl {
 #else
                 // Oversampling disabled - process normally
                 for (int i = 0; i < numSamples; ++i) {
-                    processSample(data[i], processor);
+                    dryBuffer[i] = processSample(data[i], processor);
                 }
 #endif
             } else {
                 // Normal processing
                 for (int i = 0; i < numSamples; ++i) {
-                    processSample(data[i], processor);
+                    dryBuffer[i] = processSample(data[i], processor);
                 }
             }
             
@@ -856,13 +902,21 @@ struct TransientShaper_Platinum::Impl {
         }
     }
     
-    inline void processSample(float& sample, ChannelProcessor& processor) {
+    // Returns the delayed, unprocessed input for the dry path
+    inline float processSample(float& sample, ChannelProcessor& processor) {
         // SPL-style differential envelope transient detection
         float transientAmount = 0.0f;
         float sustainAmount = 0.0f;
 
+        // The detector sees the peak of the window ahead while the gains are
+        // applied to the delayed sample. The delay always runs (zero is a
+        // passthrough) so lookahead changes crossfade instead of switching
+        const float detectorInput = processor.lookaheadPeak.process(std::abs(sample));
+        sample = processor.lookaheadProc.process(sample);
+        const float delayedInput = sample;
+
         // Get transient and sustain amounts from differential envelope
-        processor.diffDetector.process(sample, transientAmount, sustainAmount);
+        processor.diffDetector.process(detectorInput, transientAmount, sustainAmount);
 
         // Apply gains to respective portions
         // At unity (0.5), both gains are 1.0, so signal passes unchanged
@@ -877,6 +931,7 @@ struct TransientShaper_Platinum::Impl {
         processedSample = std::max(-10.0f, std::min(10.0f, processedSample));
 
         sample = processedSample;
+        return delayedInput;
     }
 };
 
@@ -899,6 +954,10 @@ void TransientShaper_Platinum::reset() {
     }
 }
 
+int TransientShaper_Platinum::getLatencySamples() const noexcept {
+    return pimpl->channels[0].lookaheadProc.getDelay();
+}
+
 void TransientShaper_Platinum::updateParameters(const std::map<int, float>& params) {
     auto it = params.find(Attack);
     if (it != params.end()) pimpl->attack.setImmediate(it->second);  // Use immediate for testing
@@ -31,6 +31,9 @@ public:
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
     
+    // The lookahead delay, which the dry path shares
+    int getLatencySamples() const noexcept override;
+    
     // Parameter interface
     int getNumParameters() const override { return 10; }
     juce::String getParameterName(int index) const override;
@@ -22,12 +22,30 @@ void VintageTubePreamp_Studio::prepareToPlay(double sampleRate,int samplesPerBlo
 
     V1_.reset(); V2_.reset(); V3_.reset();
     os4_.reset(); dc_[0].reset(); dc_[1].reset(); micro_.reset();
+    for (auto& shaper : otShapers_) shaper.setCurve(AdaaCurves::tanh());
+    applyAntialiasingPlan();
 
     ctrlPhase_ = 0; rnd_=0x1234567u;
 }
 
 void VintageTubePreamp_Studio::reset(){ prepareToPlay(fs_, blockSize_); }
 
+void VintageTubePreamp_Studio::setQuality(Quality q){
+    quality_ = q;
+    applyAntialiasingPlan();
+}
+
+void VintageTubePreamp_Studio::setAntialiasingMode(AntialiasingMode mode){
+    antialiasingMode_ = mode;
+    applyAntialiasingPlan();
+}
+
+void VintageTubePreamp_Studio::applyAntialiasingPlan(){
+    draftQuality_ = (quality_ == Quality::Draft);
+    adaaOrder_ = antialiasingForQuality(quality_, antialiasingMode_, 1).adaaOrder;
+    for (auto& shaper : otShapers_) shaper.setOrder(adaaOrder_);
+}
+
 void VintageTubePreamp_Studio::updateParameters(const std::map<int,float>& p){
     // Helper to get parameter value with default
     auto getParam = [&p](int id, float defaultVal) -> float {
@@ -118,8 +136,10 @@ void VintageTubePreamp_Studio::process(juce::AudioBuffer<float>& buffer){
 
     if (bypass_){ scrubBuffer(buffer); return; }
 
-    // decide OS
-    const bool needOS = (osMode_==1) || (osMode_==0 && fs_<96000.0);
+    // decide OS (auto mode drops it at Draft quality and for ADAA; an explicit On is honoured)
+    const bool needOS = (osMode_==1) || (osMode_==0 && fs_<96000.0 && !draftQuality_ && adaaOrder_==0);
+    if (needOS && !wasOversampling_) os4_.reset(); // filters hold stale state
+    wasOversampling_ = needOS;
 
     const float inTrim = dbToLin(inTrim_);
     const float outTrim= dbToLin(outTrim_);
@@ -167,7 +187,8 @@ void VintageTubePreamp_Studio::process(juce::AudioBuffer<float>& buffer){
                     float v3 = V3_.process(a_inc3, (float)fs_);
 
                     // OT + NFB
-                    float y = ot_.process(v3, (float)fs_);
+                    float y = adaaOrder_>0 ? ot_.process(v3, (float)fs_, otShapers_[ch])
+                                           : ot_.process(v3, (float)fs_);
                     // Simple global NFB: subtract fraction of output from V2 input on next sample (one-sample delay implicit)
                     V2_.Vbias -= 0.02f * ot_.nfb * y;
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "EngineBase.h"
 #include "DspEngineUtilities.h" // DenormalGuard, DCBlocker, scrubBuffer, ParamAccess
+#include "AntiderivativeShaper.h"
 #include <array>
 #include <atomic>
 #include <cmath>
@@ -36,6 +37,11 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override; // Draft: auto OS off
+
+    // Oversampling (default): the 4x path as before. Antiderivative: auto OS
+    // mode runs at 1x with 1st-order ADAA on the output transformer's tanh.
+    void setAntialiasingMode(AntialiasingMode mode);
     juce::String getName() const override { return "Vintage Tube Preamp Studio"; }
     int getNumParameters() const override { return 14; }
     juce::String getParameterName(int index) const override;
@@ -329,16 +335,20 @@ private:
         inline void setNFB(float amt){ nfb = std::clamp(amt,0.f,0.5f); }
         inline void setTilt(float lowGain, float highGain){ gLow=lowGain; gHigh=highGain; }
 
-        inline float process(float x, float fs){
+        inline float tilt(float x, float fs){
             // one-pole HF tilt (eddy/stray); presence lifts top by reducing NFB at HF
             const float a = std::exp(-2.0f*float(M_PI)*3000.0f/fs);
             stateHF = a*stateHF + (1.f-a)*x;
             float hf = x - stateHF;                   // HF component
             float lf = stateHF;                       // LF component
-            float y = lf*gLow + hf*(gHigh + 0.2f*presence);
+            return lf*gLow + hf*(gHigh + 0.2f*presence);
+        }
+        inline float process(float x, float fs){
             // soft saturation for iron/OT core
-            y = fast_tanh(sat*y);
-            return y;
+            return fast_tanh(sat*tilt(x, fs));
+        }
+        inline float process(float x, float fs, AntiderivativeShaper<>& core){
+            return (float)core.process(sat*tilt(x, fs));
         }
     };
 
@@ -390,6 +400,12 @@ private:
     // =================== State ===================
     double fs_=48000.0; int blockSize_=0;
     bool bypass_=false; int osMode_=0;
+    bool draftQuality_=false, wasOversampling_=false;
+    Quality quality_=Quality::Ultra;
+    AntialiasingMode antialiasingMode_=AntialiasingMode::Oversampling;
+    int adaaOrder_=0;
+    AntiderivativeShaper<> otShapers_[2];
+    void applyAntialiasingPlan();
     Voicing voicing_=FENDER_DLUX;
 
     float inTrim_=0.f, outTrim_=0.f, drive_=0.f, bright_=0.f;
@@ -343,6 +343,13 @@ struct WaveFolder::Impl {
     WaveFolderParam harmonics;
     WaveFolderParam mix;
     
+    bool allowOversampling = true;  // false at Draft quality
+    
+    // Antiderivative mode folds at 1x through ADAA instead of oversampling
+    EngineBase::Quality quality = EngineBase::Quality::Ultra;
+    AntialiasingMode antialiasingMode = AntialiasingMode::Antiderivative;
+    int adaaOrder = 1;
+    
     // Per-channel state
     struct alignas(64) ChannelState {
         DCBlocker inputDC;
@@ -354,6 +361,12 @@ struct WaveFolder::Impl {
         float lastInput{0.0f};
         float smoothState{0.0f};
         
+        // ADAA fold; thresholds cached to skip curveChanged() once settled
+        AdaaCurves::TriangleFold foldCurve;
+        AntiderivativeShaper<AdaaCurves::TriangleFold> foldShaper;
+        float foldLow{0.0f};
+        float foldHigh{0.0f};
+        
         // Oversampling buffers - dynamically sized but pre-allocated
         std::vector<float> oversampleBuffer;
         std::vector<float> processBuffer;
@@ -366,6 +379,7 @@ struct WaveFolder::Impl {
             outputDC.reset();
             harmonicFilter.reset();
             oversampler.reset();
+            foldShaper.reset();
             lastInput = 0.0f;
             smoothState = 0.0f;
             
@@ -449,6 +463,8 @@ struct WaveFolder::Impl {
             ch.harmonicFilter.setSampleRate(sr);
             ch.inputDC.prepare(sr);
             ch.outputDC.prepare(sr);
+            ch.foldShaper.setCurve(ch.foldCurve);
+            ch.foldShaper.setOrder(adaaOrder);
             ch.reset();
         }
         
@@ -457,15 +473,30 @@ struct WaveFolder::Impl {
         denormalFlushCounter = 0;
     }
     
+    void applyAntialiasingPlan() noexcept {
+        const auto plan = antialiasingForQuality(quality, antialiasingMode, 1);
+        allowOversampling = antialiasingMode == AntialiasingMode::Oversampling
+                            && quality != EngineBase::Quality::Draft;
+        adaaOrder = plan.adaaOrder;
+        for (auto& ch : channels) {
+            ch.foldShaper.setOrder(adaaOrder);
+        }
+    }
+    
+    static ALWAYS_INLINE void foldThresholds(float amount, float asym, float& posThresh, float& negThresh) noexcept {
+        // Adjusted threshold calculation to prevent too-small values
+        const float threshold = std::max(0.1f, 1.0f - amount * 0.9f); // Never go below 0.1
+        posThresh = threshold * (1.0f + asym * 0.5f); // Reduce asymmetry effect
+        negThresh = -threshold * (1.0f - asym * 0.5f);
+    }
+    
     ALWAYS_INLINE float processWavefolding(float input, float amount, float asym) noexcept {
         // Pre-clamp input to prevent extreme values
         input = std::max(-4.0f, std::min(4.0f, input));
         
         // Optimized folding with guaranteed termination
-        // Adjusted threshold calculation to prevent too-small values
-        const float threshold = std::max(0.1f, 1.0f - amount * 0.9f); // Never go below 0.1
-        const float posThresh = threshold * (1.0f + asym * 0.5f); // Reduce asymmetry effect
-        const float negThresh = -threshold * (1.0f - asym * 0.5f);
+        float posThresh, negThresh;
+        foldThresholds(amount, asym, posThresh, negThresh);
         
         float output = input;
         
@@ -486,6 +517,22 @@ struct WaveFolder::Impl {
         return flushDenorm(fastTanh(output));
     }
     
+    // The same fold as an exact triangle wave (no iteration cap) through
+    // ADAA; input is already clamped to +-2, the curve's own limit
+    ALWAYS_INLINE float processWavefoldingAdaa(ChannelState& ch, float input, float amount, float asym) noexcept {
+        float posThresh, negThresh;
+        foldThresholds(amount, asym, posThresh, negThresh);
+        
+        if (posThresh != ch.foldHigh || negThresh != ch.foldLow) {
+            ch.foldHigh = posThresh;
+            ch.foldLow = negThresh;
+            ch.foldCurve.setThresholds(negThresh, posThresh);
+            ch.foldShaper.curveChanged();
+        }
+        
+        return flushDenorm(fastTanh((float) ch.foldShaper.process(input)));
+    }
+    
     ALWAYS_INLINE float smoothTransition(float input, float& lastInput, float smooth) noexcept {
         // Anti-derivative anti-aliasing
         const float maxDelta = (1.0f - smooth) * 0.1f;
@@ -507,7 +554,7 @@ struct WaveFolder::Impl {
         // Check if oversampling is needed based on current fold amount
         const float currentFold = foldAmount.tick();
         foldAmount.setImmediate(currentFold); // Reset for next check
-        const bool useOversampling = currentFold > 0.3f;
+        const bool useOversampling = adaaOrder == 0 && allowOversampling && currentFold > 0.3f;
         
         if (useOversampling) {
             // Block-based oversampling for efficiency
@@ -569,7 +616,7 @@ struct WaveFolder::Impl {
                 data[i] = ch.outputDC.process(data[i]);
             }
         } else {
-            // Direct processing without oversampling (low fold amounts)
+            // Direct processing: ADAA, or no oversampling at low fold amounts
             for (int i = 0; i < numSamples; ++i) {
                 // Per-sample parameter updates for smooth automation
                 const float fold = foldAmount.tick();
@@ -595,7 +642,8 @@ struct WaveFolder::Impl {
                 }
                 
                 // Wave folding (already includes denormal prevention)
-                x = processWavefolding(x, fold, asym);
+                x = adaaOrder > 0 ? processWavefoldingAdaa(ch, x, fold, asym)
+                                  : processWavefolding(x, fold, asym);
                 x = std::max(-1.5f, std::min(1.5f, x)); // Hard limit after folding
                 
                 // Harmonic emphasis (already includes denormal prevention)
@@ -656,6 +704,16 @@ void WaveFolder::process(juce::AudioBuffer<float>& buffer) {
     scrubBuffer(buffer);
 }
 
+void WaveFolder::setQuality(Quality q) {
+    pimpl->quality = q;
+    pimpl->applyAntialiasingPlan();
+}
+
+void WaveFolder::setAntialiasingMode(AntialiasingMode mode) {
+    pimpl->antialiasingMode = mode;
+    pimpl->applyAntialiasingPlan();
+}
+
 void WaveFolder::updateParameters(const std::map<int, float>& params) {
     // Thread-safe parameter updates
     for (const auto& [index, value] : params) {
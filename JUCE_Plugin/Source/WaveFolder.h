@@ -1,6 +1,7 @@
 #pragma once
 #include "EngineBase.h"
 #include "DspEngineUtilities.h"
+#include "AntiderivativeShaper.h"
 #include <memory>
 #include <juce_core/juce_core.h>
 
@@ -14,7 +15,7 @@ namespace juce {
  * 
  * Features:
  * - Real-time safe with zero allocations
- * - 4x oversampling for alias-free folding
+ * - 1x antiderivative anti-aliasing (default) or 4x oversampling
  * - Lock-free parameter updates
  * - Comprehensive denormal prevention
  * - < 1ms latency @ 48kHz
@@ -30,6 +31,11 @@ public:
     void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     void updateParameters(const std::map<int, float>& params) override;
+    void setQuality(Quality q) override;  // Draft never oversamples
+    
+    // Antiderivative (default): 1st-order ADAA on the fold at 1x.
+    // Oversampling: the legacy 4x path, skipped at Draft and low fold.
+    void setAntialiasingMode(AntialiasingMode mode);
     
     int getNumParameters() const override { return 8; }
     juce::String getParameterName(int index) const override;
@@ -0,0 +1,192 @@
+// YinPitchTracker.h - Monophonic YIN pitch tracker on a hop schedule
+//
+// de Cheveigné and Kawahara's YIN over a window of WINDOW_SIZE samples: the
+// difference function compares the newest half of the window with every lag
+// up to half the window, is normalised by its cumulative mean, and the first
+// dip under the threshold, refined by a parabola, gives the period.
+//
+// Summed directly the difference function costs half a window squared
+// multiply-adds per analysis. Expanded instead,
+//     d(tau) = e_new + e(tau) - 2 r(tau)
+// where e_new is the newest half's energy, e(tau) the energy of the same span
+// tau samples earlier and r(tau) their cross-correlation. r comes from one
+// real FFT of each span and one inverse of their product, and e(tau) is a
+// running sum, so an analysis costs three FFTs and a few linear passes.
+//
+// Samples go into a power-of-two ring as they arrive and an analysis runs
+// once per hop; between hops the last estimate holds, as it does through
+// unvoiced input. Nothing here is specific to an engine: push() audio,
+// read getFrequency() and getConfidence().
+//
+// prepare() allocates; push() and reset() are real-time safe.
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "RealFFT.h"
+#include <complex>
+#include <memory>
+#include <vector>
+
+class YinPitchTracker {
+public:
+    static constexpr int WINDOW_ORDER = 10;
+    static constexpr int WINDOW_SIZE = 1 << WINDOW_ORDER;
+    static constexpr int MAX_LAG = WINDOW_SIZE / 2;
+    static constexpr int DEFAULT_HOP = WINDOW_SIZE / 4;
+    static constexpr float THRESHOLD = 0.15f;
+
+    // Message thread: hop in samples between analyses, up to WINDOW_SIZE
+    void prepare(double newSampleRate, int newHopSize = DEFAULT_HOP) {
+        sampleRate = newSampleRate;
+        hopSize = juce::jlimit(1, WINDOW_SIZE, newHopSize);
+
+        if (fft == nullptr)
+            fft = std::make_unique<RealFFT>(WINDOW_ORDER);
+
+        ring.assign((size_t) WINDOW_SIZE, 0.0f);
+        newest.assign((size_t) WINDOW_SIZE + 2, 0.0f);
+        whole.assign((size_t) WINDOW_SIZE + 2, 0.0f);
+        difference.assign((size_t) MAX_LAG, 0.0f);
+        reset();
+    }
+
+    void reset() noexcept {
+        std::fill(ring.begin(), ring.end(), 0.0f);
+        position = 0;
+        filled = 0;
+        untilAnalysis = hopSize;
+        frequency = 440.0f;
+        confidence = 0.0f;
+    }
+
+    // Audio thread, one sample at a time; returns the current estimate
+    float push(float sample) noexcept {
+        ring[(size_t) position] = sample;
+        position = (position + 1) & (WINDOW_SIZE - 1);
+        filled = juce::jmin(filled + 1, WINDOW_SIZE);
+
+        if (--untilAnalysis == 0) {
+            untilAnalysis = hopSize;
+            if (filled == WINDOW_SIZE)
+                analyse();
+        }
+        return frequency;
+    }
+
+    // Audio thread, a block at a time
+    void push(const float* samples, int numSamples) noexcept {
+        for (int done = 0; done < numSamples;) {
+            const int todo = juce::jmin(numSamples - done, untilAnalysis);
+            const int first = juce::jmin(todo, WINDOW_SIZE - position);
+            std::copy(samples + done, samples + done + first, ring.begin() + position);
+            std::copy(samples + done + first, samples + done + todo, ring.begin());
+
+            position = (position + todo) & (WINDOW_SIZE - 1);
+            filled = juce::jmin(filled + todo, WINDOW_SIZE);
+            untilAnalysis -= todo;
+            done += todo;
+
+            if (untilAnalysis == 0) {
+                untilAnalysis = hopSize;
+                if (filled == WINDOW_SIZE)
+                    analyse();
+            }
+        }
+    }
+
+    // Hz, from the last voiced analysis (440 until there has been one)
+    float getFrequency() const noexcept { return frequency; }
+
+    // 1 - the normalised difference at the chosen lag for the last analysis;
+    // 0 when it found no period
+    float getConfidence() const noexcept { return confidence; }
+
+    int getHopSize() const noexcept { return hopSize; }
+
+private:
+    void analyse() noexcept {
+        // Oldest sample first: the newest half is [MAX_LAG, WINDOW_SIZE)
+        const int run = WINDOW_SIZE - position;
+        std::copy(ring.begin() + position, ring.end(), whole.begin());
+        std::copy(ring.begin(), ring.begin() + position, whole.begin() + run);
+
+        std::fill(newest.begin(), newest.begin() + MAX_LAG, 0.0f);
+        std::copy(whole.begin() + MAX_LAG, whole.begin() + WINDOW_SIZE, newest.begin() + MAX_LAG);
+
+        // Energies before the transforms overwrite the samples
+        const float* x = whole.data();
+        float newestEnergy = 0.0f;
+        for (int k = MAX_LAG; k < WINDOW_SIZE; ++k)
+            newestEnergy += x[k] * x[k];
+
+        // e(tau) for every lag, stashed in difference[] until r is known
+        float laggedEnergy = newestEnergy;
+        for (int tau = 0; tau < MAX_LAG; ++tau) {
+            difference[(size_t) tau] = laggedEnergy;
+            const float entering = x[MAX_LAG - tau - 1];
+            const float leaving = x[WINDOW_SIZE - 1 - tau];
+            laggedEnergy += entering * entering - leaving * leaving;
+        }
+
+        // r(tau) = sum_k newest[k] whole[k - tau]: inverse of N * conj(W)
+        auto* n = reinterpret_cast<std::complex<float>*>(newest.data());
+        auto* w = reinterpret_cast<std::complex<float>*>(whole.data());
+        fft->forward(newest.data(), n);
+        fft->forward(whole.data(), w);
+        for (int k = 0; k <= WINDOW_SIZE / 2; ++k)
+            n[k] *= std::conj(w[k]);
+        fft->inverse(n, newest.data());
+
+        for (int tau = 0; tau < MAX_LAG; ++tau)
+            difference[(size_t) tau] = juce::jmax(0.0f, newestEnergy + difference[(size_t) tau] - 2.0f * newest[(size_t) tau]);
+
+        // Cumulative mean normalisation, in place
+        float sum = 0.0f;
+        difference[0] = 1.0f;
+        for (int tau = 1; tau < MAX_LAG; ++tau) {
+            sum += difference[(size_t) tau];
+            difference[(size_t) tau] = sum <= 1.0e-20f ? 1.0f : difference[(size_t) tau] * (float) tau / sum;
+        }
+
+        // The first dip under the threshold, followed down to its minimum
+        int best = -1;
+        for (int tau = 2; tau < MAX_LAG && best < 0; ++tau)
+            if (difference[(size_t) tau] < THRESHOLD)
+                best = tau;
+
+        if (best < 0) {
+            confidence = 0.0f;
+            return;
+        }
+
+        while (best + 1 < MAX_LAG && difference[(size_t) best + 1] < difference[(size_t) best])
+            ++best;
+
+        float period = (float) best;
+        if (best < MAX_LAG - 1) {
+            const float s0 = difference[(size_t) best - 1], s1 = difference[(size_t) best], s2 = difference[(size_t) best + 1];
+            const float denominator = s0 + s2 - 2.0f * s1;
+            if (std::abs(denominator) > 1.0e-12f)
+                period += juce::jlimit(-1.0f, 1.0f, 0.5f * (s0 - s2) / denominator);
+        }
+
+        confidence = 1.0f - juce::jlimit(0.0f, 1.0f, difference[(size_t) best]);
+        frequency = juce::jlimit(20.0f, 20000.0f, (float) (sampleRate / juce::jmax(1.0f, period)));
+    }
+
+    double sampleRate = 44100.0;
+    int hopSize = DEFAULT_HOP;
+
+    std::unique_ptr<RealFFT> fft;
+    std::vector<float> ring;        // last WINDOW_SIZE samples
+    std::vector<float> newest;      // newest half, zero-padded; then r(tau)
+    std::vector<float> whole;       // the window, oldest first; then its spectrum
+    std::vector<float> difference;  // d(tau), then its normalised form
+
+    int position = 0;        // next write in the ring
+    int filled = 0;          // samples in the ring, up to WINDOW_SIZE
+    int untilAnalysis = DEFAULT_HOP;
+
+    float frequency = 440.0f;
+    float confidence = 0.0f;
+};
@@ -0,0 +1,293 @@
+/**
+ * Aliasing Benchmark
+ * Compares antiderivative anti-aliasing (ADAA) against oversampling for the
+ * distortion family, in CPU and in aliasing.
+ *
+ * - Bare shapers: tanh at a fixed drive through AntiderivativeShaper at each
+ *   order, at 1x and inside the shared 2x oversampler, against plain tanh at
+ *   1x to 8x.
+ * - Engines: every distortion engine in each AntialiasingMode at each quality
+ *   tier. Aliasing is the energy that a 7 kHz tone puts on the 1 kHz grid
+ *   away from its in-band harmonics (every folded harmonic lands there at
+ *   48 kHz), relative to the fundamental.
+ * - A chain of three saturators, the case ADAA is meant to make affordable.
+ */
+
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/AntiderivativeShaper.h"
+#include "../../JUCE_Plugin/Source/PolyphaseOversampler.h"
+#include "../../JUCE_Plugin/Source/KStyleOverdrive.h"
+#include "../../JUCE_Plugin/Source/RodentDistortion.h"
+#include "../../JUCE_Plugin/Source/MuffFuzz.h"
+#include "../../JUCE_Plugin/Source/WaveFolder.h"
+#include "../../JUCE_Plugin/Source/VintageTubePreamp_Studio.h"
+#include "../../JUCE_Plugin/Source/MultibandSaturator.h"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr int kBlockSize = 256;
+constexpr int kBlocks = 2000;
+constexpr double kToneHz = 7000.0;
+
+using Quality = EngineBase::Quality;
+constexpr Quality kQualities[] = { Quality::Draft, Quality::Normal, Quality::High, Quality::Ultra };
+
+double nanosecondsPerSample(const std::function<void()>& processBlock) {
+    for (int i = 0; i < 50; ++i)
+        processBlock();  // warm caches and branch predictors
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kBlocks; ++i)
+        processBlock();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double(kBlocks) * kBlockSize);
+}
+
+void fillSine(juce::AudioBuffer<float>& buffer, double frequency, float amplitude, int64_t& position) {
+    for (int i = 0; i < buffer.getNumSamples(); ++i, ++position) {
+        const float x = amplitude * (float) std::sin(juce::MathConstants<double>::twoPi * frequency * (double) position / kSampleRate);
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            buffer.setSample(ch, i, x);
+    }
+}
+
+// Alias-to-fundamental ratio of a rendered 7 kHz tone: Hann-windowed bins on
+// the 1 kHz grid, skipping DC and the true harmonics at 7, 14 and 21 kHz
+double aliasLevelDb(const std::vector<float>& y) {
+    const auto n = y.size();
+    auto binPower = [&](double frequency) {
+        double re = 0, im = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const double w = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * (double) i / (double) n);
+            const double phase = juce::MathConstants<double>::twoPi * frequency * (double) i / kSampleRate;
+            re += w * y[i] * std::cos(phase);
+            im += w * y[i] * std::sin(phase);
+        }
+        return re * re + im * im;
+    };
+
+    double aliasPower = 0;
+    for (int k = 1; k < 24; ++k)
+        if (k % 7 != 0)
+            aliasPower += binPower(1000.0 * k);
+    return 10.0 * std::log10(aliasPower / (binPower(kToneHz) + 1.0e-30) + 1.0e-12);
+}
+
+// 2^15 samples of the tone through a per-sample shaper, after settling
+double aliasLevelDb(const std::function<float(float)>& shapeOneSample, float amplitude = 0.9f) {
+    std::vector<float> y(1 << 15);
+    for (int i = 0; i < 4096 + (int) y.size(); ++i) {
+        const float out = shapeOneSample(amplitude * (float) std::sin(juce::MathConstants<double>::twoPi * kToneHz * i / kSampleRate));
+        if (i >= 4096)
+            y[(size_t) (i - 4096)] = out;
+    }
+    return aliasLevelDb(y);
+}
+
+//==============================================================================
+void benchmarkShapers() {
+    constexpr float drive = 3.0f;
+    const auto& table = AdaaCurves::tanh();
+
+    std::printf("\nBare tanh at drive %.0f (stereo), ADAA vs. oversampling\n", drive);
+    std::printf("%-28s %12s %12s\n", "configuration", "ns/sample", "alias dB");
+
+    for (int factor : { 1, 2 }) {
+        for (int order : { 0, 1, 2 }) {
+            if (factor == 1 && order == 0)
+                continue;  // plain 1x is the first oversampling row
+
+            PolyphaseOversampler os;
+            os.prepare(2, kBlockSize, factor, PolyphaseOversampler::Phase::Minimum);
+            AntiderivativeShaper<> shapers[2];
+            for (auto& shaper : shapers) {
+                shaper.setCurve(table);
+                shaper.setOrder(order);
+            }
+
+            auto run = [&](int ch, float x) {
+                auto shape = [&](float u) { return (float) shapers[ch].process(drive * u); };
+                return factor > 1 ? os.processSample(ch, x, shape) : shape(x);
+            };
+
+            juce::AudioBuffer<float> buffer(2, kBlockSize);
+            int64_t position = 0;
+            const double ns = nanosecondsPerSample([&] {
+                fillSine(buffer, 1000.0, 0.8f, position);
+                for (int ch = 0; ch < 2; ++ch) {
+                    auto* data = buffer.getWritePointer(ch);
+                    for (int i = 0; i < kBlockSize; ++i)
+                        data[i] = run(ch, data[i]);
+                }
+            });
+
+            os.reset();
+            shapers[0].reset();
+            const double alias = aliasLevelDb([&](float x) { return run(0, x); });
+            char name[64];
+            std::snprintf(name, sizeof(name), "ADAA%d at %dx", order, factor);
+            std::printf("%-28s %12.1f %12.1f\n", name, ns, alias);
+        }
+    }
+
+    for (int factor : { 1, 2, 4, 8 }) {
+        PolyphaseOversampler os;
+        os.prepare(2, kBlockSize, factor, PolyphaseOversampler::Phase::Minimum);
+        auto shape = [&](float u) { return std::tanh(drive * u); };
+
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        int64_t position = 0;
+        const double ns = nanosecondsPerSample([&] {
+            fillSine(buffer, 1000.0, 0.8f, position);
+            for (int ch = 0; ch < 2; ++ch) {
+                auto* data = buffer.getWritePointer(ch);
+                for (int i = 0; i < kBlockSize; ++i)
+                    data[i] = factor > 1 ? os.processSample(ch, data[i], shape) : shape(data[i]);
+            }
+        });
+
+        os.reset();
+        const double alias = aliasLevelDb([&](float x) { return factor > 1 ? os.processSample(0, x, shape) : shape(x); });
+        char name[64];
+        std::snprintf(name, sizeof(name), "plain tanh at %dx", factor);
+        std::printf("%-28s %12.1f %12.1f\n", name, ns, alias);
+    }
+}
+
+//==============================================================================
+struct EngineEntry {
+    const char* name;
+    std::function<std::unique_ptr<EngineBase>(AntialiasingMode)> make;
+    std::map<int, float> overrides;  // parameters other than the 0.7 default
+};
+
+template <typename Engine>
+std::unique_ptr<EngineBase> makeEngine(AntialiasingMode mode) {
+    auto engine = std::make_unique<Engine>();
+    engine->setAntialiasingMode(mode);
+    return engine;
+}
+
+std::vector<EngineEntry> distortionEngines() {
+    using VTP = VintageTubePreamp_Studio;
+    return {
+        { "KStyleOverdrive",          makeEngine<KStyleOverdrive>,    {} },
+        { "RodentDistortion",         makeEngine<RodentDistortion>,   { { 5, 1.0f } } },  // full wet
+        { "MuffFuzz",                 makeEngine<MuffFuzz>,           {} },
+        // Harmonics off: its emphasis filter bank is unstable when engaged
+        { "WaveFolder",               makeEngine<WaveFolder>,         { { WaveFolder::kMix, 1.0f },
+                                                                        { WaveFolder::kHarmonics, 0.0f } } },
+        // Bypass off, no hiss/microphonics, auto oversampling
+        { "VintageTubePreamp_Studio", makeEngine<VTP>,                { { VTP::kBypass, 0.0f }, { VTP::kNoise, 0.0f },
+                                                                        { VTP::kMicMech, 0.0f }, { VTP::kGhost, 0.0f },
+                                                                        { VTP::kOSMode, 0.0f } } },
+        { "MultibandSaturator",       makeEngine<MultibandSaturator>, {} },
+    };
+}
+
+void prepareEngine(EngineBase& engine, Quality quality, const std::map<int, float>& overrides) {
+    engine.prepareToPlay(kSampleRate, kBlockSize);
+    engine.setQuality(quality);
+
+    std::map<int, float> params;
+    for (int i = 0; i < engine.getNumParameters(); ++i)
+        params[i] = 0.7f;
+    for (const auto& [index, value] : overrides)
+        params[index] = value;
+    engine.updateParameters(params);
+}
+
+double timeChain(const std::vector<EngineBase*>& chain) {
+    juce::AudioBuffer<float> buffer(2, kBlockSize);
+    int64_t position = 0;
+    return nanosecondsPerSample([&] {
+        fillSine(buffer, 220.0, 0.5f, position);
+        for (auto* engine : chain)
+            engine->process(buffer);
+    });
+}
+
+double chainAliasDb(const std::vector<EngineBase*>& chain) {
+    for (auto* engine : chain)
+        engine->reset();
+
+    juce::AudioBuffer<float> buffer(2, kBlockSize);
+    std::vector<float> y;
+    const int settle = 16 * kBlockSize, length = 1 << 15;
+    int64_t position = 0;
+    while ((int) y.size() < length) {
+        fillSine(buffer, kToneHz, 0.5f, position);
+        for (auto* engine : chain)
+            engine->process(buffer);
+        if (position > settle)
+            y.insert(y.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + kBlockSize);
+    }
+    y.resize((size_t) length);
+    return aliasLevelDb(y);
+}
+
+const char* modeName(AntialiasingMode mode) {
+    return mode == AntialiasingMode::Oversampling ? "oversampling" : "antiderivative";
+}
+
+void benchmarkEngines() {
+    std::printf("\nDistortion engines per mode and tier: ns/sample / alias dB\n");
+    std::printf("%-26s %-15s %14s %14s %14s %14s\n", "engine", "mode", "Draft", "Normal", "High", "Ultra");
+
+    for (const auto& entry : distortionEngines()) {
+        for (auto mode : { AntialiasingMode::Oversampling, AntialiasingMode::Antiderivative }) {
+            std::printf("%-26s %-15s", entry.name, modeName(mode));
+            for (auto quality : kQualities) {
+                auto engine = entry.make(mode);
+                prepareEngine(*engine, quality, entry.overrides);
+                const double ns = timeChain({ engine.get() });
+                const double alias = chainAliasDb({ engine.get() });
+                std::printf("  %6.1f/%6.1f", ns, alias);
+            }
+            std::printf("\n");
+        }
+    }
+}
+
+void benchmarkChain() {
+    std::printf("\nThree saturators in series (KStyle -> Rodent -> MultibandSaturator)\n");
+    std::printf("%-15s %-8s %12s %12s\n", "mode", "tier", "ns/sample", "alias dB");
+
+    const auto engines = distortionEngines();
+    const EngineEntry* stages[] = { &engines[0], &engines[1], &engines[5] };
+
+    for (auto mode : { AntialiasingMode::Oversampling, AntialiasingMode::Antiderivative }) {
+        for (auto quality : { Quality::Normal, Quality::Ultra }) {
+            std::vector<std::unique_ptr<EngineBase>> owned;
+            std::vector<EngineBase*> chain;
+            for (const auto* stage : stages) {
+                owned.push_back(stage->make(mode));
+                prepareEngine(*owned.back(), quality, stage->overrides);
+                chain.push_back(owned.back().get());
+            }
+            std::printf("%-15s %-8s %12.1f %12.1f\n", modeName(mode),
+                        quality == Quality::Normal ? "Normal" : "Ultra",
+                        timeChain(chain), chainAliasDb(chain));
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ignoreUnused(argc, argv);
+    juce::ScopedJuceInitialiser_GUI juce_init;
+
+    std::printf("Aliasing benchmark: %.0f Hz, %d-sample blocks, %.0f Hz test tone\n", kSampleRate, kBlockSize, kToneHz);
+    benchmarkShapers();
+    benchmarkEngines();
+    benchmarkChain();
+    return 0;
+}
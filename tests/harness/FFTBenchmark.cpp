@@ -0,0 +1,112 @@
+/**
+ * FFT Benchmark
+ * Times the two real FFT backends in RealFFT.h side by side at the sizes the
+ * engines use: juce::dsp::FFT (JUCE's generic fallback unless it was built
+ * with vDSP, IPP/MKL or FFTW) and the vendored signalsmith-linear transform.
+ * Each figure is one forward plus one inverse transform, in place, as
+ * StftProcessor and the partitioned convolver run them.
+ *
+ * The spectral engines are then timed whole on whichever backend this build
+ * selected; configure with -DCHIMERA_FFT_BACKEND=juce or =signalsmith and
+ * compare the two runs for the engine-level difference.
+ */
+
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/RealFFT.h"
+#include "../../JUCE_Plugin/Source/SpectralFreeze.h"
+#include "../../JUCE_Plugin/Source/SpectralGate_Platinum.h"
+#include "../../JUCE_Plugin/Source/PhasedVocoder.h"
+#include "../../JUCE_Plugin/Source/ConvolutionReverb.h"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int kBlockSize = 256;
+constexpr int kBlocks = 2000;
+
+double nanosecondsPer(int iterations, const std::function<void()>& body) {
+    for (int i = 0; i < iterations / 20 + 1; ++i)
+        body();  // warm caches and branch predictors
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / double(iterations);
+}
+
+// ns per forward + inverse pair
+template <typename FFT>
+double benchmarkTransform(int order) {
+    FFT fft(order);
+    juce::Random random(1);
+    std::vector<float> buffer((size_t) (1 << order) + 2);
+    for (auto& sample : buffer)
+        sample = random.nextFloat() - 0.5f;
+    auto* bins = reinterpret_cast<std::complex<float>*>(buffer.data());
+
+    const int iterations = juce::jmax(200, (1 << 22) >> order);
+    return nanosecondsPer(iterations, [&] {
+        fft.forward(buffer.data(), bins);
+        fft.inverse(bins, buffer.data());
+    });
+}
+
+void benchmarkTransforms() {
+    std::printf("\nForward + inverse real FFT, ns\n");
+    std::printf("%-8s %14s %20s %10s\n", "size", JuceRealFFT::getName(), SignalsmithRealFFT::getName(), "speedup");
+
+    // 128..8192: convolver head to tail partitions (doubled), STFT frames in between
+    for (int order = 8; order <= 14; ++order) {
+        const double juceNs = benchmarkTransform<JuceRealFFT>(order);
+        const double signalsmithNs = benchmarkTransform<SignalsmithRealFFT>(order);
+        std::printf("%-8d %14.0f %20.0f %9.2fx\n", 1 << order, juceNs, signalsmithNs, juceNs / signalsmithNs);
+    }
+}
+
+void benchmarkEngines() {
+    std::printf("\nFFT engines on %s (whole engine, stereo, 48 kHz), ns/sample\n", RealFFT::getName());
+
+    const std::pair<const char*, std::function<std::unique_ptr<EngineBase>()>> engines[] = {
+        { "SpectralFreeze",        [] { return std::make_unique<SpectralFreeze>(); } },
+        { "SpectralGate_Platinum", [] { return std::make_unique<SpectralGate_Platinum>(); } },
+        { "PhasedVocoder",         [] { return std::make_unique<PhasedVocoder>(); } },
+        { "ConvolutionReverb",     [] { return std::make_unique<ConvolutionReverb>(); } },
+    };
+    for (const auto& [name, make] : engines) {
+        auto engine = make();
+        engine->prepareToPlay(48000.0, kBlockSize);
+
+        std::map<int, float> params;
+        for (int i = 0; i < engine->getNumParameters(); ++i)
+            params[i] = 0.5f;
+        engine->updateParameters(params);
+
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        juce::Random random(2);
+        const double ns = nanosecondsPer(kBlocks, [&] {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < kBlockSize; ++i)
+                    buffer.setSample(ch, i, random.nextFloat() - 0.5f);
+            engine->process(buffer);
+        }) / kBlockSize;
+        std::printf("%-28s %10.1f\n", name, ns);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ignoreUnused(argc, argv);
+    juce::ScopedJuceInitialiser_GUI juce_init;
+
+    std::printf("FFT benchmark: engines built on %s\n", RealFFT::getName());
+    benchmarkTransforms();
+    benchmarkEngines();
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * Fast Math Benchmark
+ * Times the FastMath functions in DspEngineUtilities.h against the C library
+ * calls they replace, in the two shapes engines use them: a block form over
+ * a buffer, and a scalar form called once per sample, as a feedback loop has
+ * to. Every accuracy tier is timed, so the cost of each step up in Quality
+ * can be read off.
+ *
+ * The engines that saturate per sample are then timed whole at each Quality.
+ */
+
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/DspEngineUtilities.h"
+#include "../../JUCE_Plugin/Source/TapeEcho.h"
+#include "../../JUCE_Plugin/Source/LadderFilter.h"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int kBlockSize = 256;
+constexpr int kBlocks = 4000;
+
+double nanosecondsPerSample(const std::function<void()>& processBlock) {
+    for (int i = 0; i < 50; ++i)
+        processBlock();  // warm caches and branch predictors
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kBlocks; ++i)
+        processBlock();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double(kBlocks) * kBlockSize);
+}
+
+using Accuracy = FastMath::Accuracy;
+constexpr Accuracy kTiers[] = { Accuracy::Coarse, Accuracy::Medium, Accuracy::Fine };
+
+template <typename Libm, typename Scalar, typename Block>
+void benchmarkFunction(const char* name, float lo, float hi, Libm libm, Scalar scalar, Block block) {
+    std::vector<float> in(kBlockSize), out(kBlockSize);
+    for (int i = 0; i < kBlockSize; ++i)
+        in[(size_t) i] = lo + (hi - lo) * (float) i / (float) kBlockSize;
+
+    const double libmNs = nanosecondsPerSample([&] {
+        for (int i = 0; i < kBlockSize; ++i)
+            out[(size_t) i] = libm(in[(size_t) i]);
+    });
+    double blockNs[3], scalarNs[3];
+    for (auto a : kTiers) {
+        blockNs[(int) a] = nanosecondsPerSample([&] { block(in.data(), out.data(), kBlockSize, a); });
+        scalarNs[(int) a] = nanosecondsPerSample([&] {
+            for (int i = 0; i < kBlockSize; ++i)
+                out[(size_t) i] = scalar(in[(size_t) i], a);
+        });
+    }
+    std::printf("%-8s %8.2f   %8.2f %8.2f %8.2f   %8.2f %8.2f %8.2f\n", name, libmNs,
+                blockNs[0], blockNs[1], blockNs[2], scalarNs[0], scalarNs[1], scalarNs[2]);
+}
+
+void benchmarkFunctions() {
+    std::printf("\nns/value: libm, then FastMath block and per-sample forms at each tier\n");
+    std::printf("%-8s %8s   %8s %8s %8s   %8s %8s %8s\n", "", "libm",
+                "block C", "M", "F", "scalar C", "M", "F");
+
+    benchmarkFunction("tanh", -4.0f, 4.0f, [] (float x) { return std::tanh(x); },
+                      [] (float x, Accuracy a) { return FastMath::tanh(x, a); },
+                      [] (const float* in, float* out, int n, Accuracy a) { FastMath::tanh(in, out, n, a); });
+    benchmarkFunction("exp", -10.0f, 10.0f, [] (float x) { return std::exp(x); },
+                      [] (float x, Accuracy a) { return FastMath::exp(x, a); },
+                      [] (const float* in, float* out, int n, Accuracy a) { FastMath::exp(in, out, n, a); });
+    benchmarkFunction("pow2", -10.0f, 10.0f, [] (float x) { return std::exp2(x); },
+                      [] (float x, Accuracy a) { return FastMath::pow2(x, a); },
+                      [] (const float* in, float* out, int n, Accuracy a) { FastMath::pow2(in, out, n, a); });
+    benchmarkFunction("log", 1.0e-3f, 100.0f, [] (float x) { return std::log(x); },
+                      [] (float x, Accuracy a) { return FastMath::log(x, a); },
+                      [] (const float* in, float* out, int n, Accuracy a) { FastMath::log(in, out, n, a); });
+
+    // sin alone against libm and per sample; the block form gives cos too
+    std::vector<float> cosines(kBlockSize);
+    benchmarkFunction("sincos", -10.0f, 10.0f, [] (float x) { return std::sin(x); },
+                      [] (float x, Accuracy a) { return FastMath::sin(x, a); },
+                      [&] (const float* in, float* out, int n, Accuracy a) { FastMath::sincos(in, out, cosines.data(), n, a); });
+}
+
+void benchmarkEngines() {
+    std::printf("\nSaturating engines (whole engine, stereo, 48 kHz), ns/sample\n");
+    std::printf("%-16s %10s %10s %10s %10s\n", "", "Draft", "Normal", "High", "Ultra");
+
+    const std::pair<const char*, std::function<std::unique_ptr<EngineBase>()>> engines[] = {
+        { "TapeEcho",     [] { return std::make_unique<TapeEcho>(); } },
+        { "LadderFilter", [] { return std::make_unique<LadderFilter>(); } },
+    };
+    for (const auto& [name, make] : engines) {
+        std::printf("%-16s", name);
+        for (auto quality : { EngineBase::Quality::Draft, EngineBase::Quality::Normal,
+                              EngineBase::Quality::High, EngineBase::Quality::Ultra }) {
+            auto engine = make();
+            engine->prepareToPlay(48000.0, kBlockSize);
+            engine->setQuality(quality);
+
+            // Drive and saturation up, so the curves are doing work
+            std::map<int, float> params;
+            for (int i = 0; i < engine->getNumParameters(); ++i)
+                params[i] = 0.8f;
+            engine->updateParameters(params);
+
+            juce::AudioBuffer<float> buffer(2, kBlockSize);
+            juce::Random random(1);
+            const double ns = nanosecondsPerSample([&] {
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < kBlockSize; ++i)
+                        buffer.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+                engine->process(buffer);
+            });
+            std::printf(" %10.1f", ns);
+        }
+        std::printf("\n");
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ignoreUnused(argc, argv);
+    juce::ScopedJuceInitialiser_GUI juce_init;
+
+    std::printf("Fast math benchmark\n");
+    benchmarkFunctions();
+    benchmarkEngines();
+    return 0;
+}
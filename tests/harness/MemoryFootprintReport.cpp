@@ -0,0 +1,128 @@
+/**
+ * Memory Footprint Report
+ * Heap bytes each engine holds, so a buffer sized for the worst case (or
+ * embedded by value in the engine object) shows up before it ships 40 times
+ * in a session.
+ *
+ * - Prepared: construction plus prepareToPlay at each sample rate, i.e. what
+ *   an idle instance costs. Delay memory should scale with the rate.
+ * - All modes: bytes added on top by visiting every parameter at 0, 0.5 and
+ *   1 for a block each and servicing EngineBase::needsDeferredAllocation()
+ *   the way the processor does - the cost once every mode has been used.
+ *
+ * Bytes are the requested sizes of every allocation made on this thread
+ * (AllocationTracker); frees are not subtracted, so transient allocations
+ * during prepareToPlay count too.
+ *
+ * Usage: MemoryFootprintReport [--budget-kb N]
+ * With a budget, exits with 1 if any engine's prepared footprint at 48 kHz
+ * exceeds it.
+ */
+
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/EngineFactory.h"
+#include "../../JUCE_Plugin/Source/EngineTypes.h"
+#include "../unit/AllocationTracker.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int kBlockSize = 512;
+constexpr double kSampleRates[] = { 44100.0, 48000.0, 96000.0, 192000.0 };
+constexpr int kReferenceRate = 1;  // 48 kHz, the rate the budget applies to
+
+double kilobytes(std::size_t bytes) { return (double) bytes / 1024.0; }
+
+std::size_t preparedBytes(int engineID, double sampleRate, std::unique_ptr<EngineBase>& engine) {
+    AllocationTracker::ScopedAllocationCheck check;
+    engine = EngineFactory::createEngine(engineID);
+    if (engine)
+        engine->prepareToPlay(sampleRate, kBlockSize);
+    return check.getBytes();
+}
+
+std::size_t allModesBytes(EngineBase& engine) {
+    juce::AudioBuffer<float> buffer(2, kBlockSize);
+    const int numParams = juce::jmin(engine.getNumParameters(), EngineBase::ParameterSnapshot::NUM_PARAMS);
+
+    // Built up front so the maps' own nodes are not counted
+    std::vector<std::map<int, float>> settings;
+    for (int index = 0; index < numParams; ++index)
+        for (float value : { 0.0f, 0.5f, 1.0f })
+            settings.push_back({ { index, value } });
+
+    AllocationTracker::ScopedAllocationCheck check;
+    for (const auto& params : settings) {
+        engine.updateParameters(params);
+        buffer.clear();
+        engine.process(buffer);
+        if (engine.needsDeferredAllocation())
+            engine.performDeferredAllocation();
+    }
+    return check.getBytes();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ScopedJuceInitialiser_GUI juce_init;
+
+    double budgetKb = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--budget-kb") == 0 && i + 1 < argc)
+            budgetKb = std::atof(argv[++i]);
+    }
+
+    std::printf("Engine memory footprint (KB), %d-sample blocks\n\n", kBlockSize);
+    std::printf("%-3s %-28s", "ID", "Engine");
+    for (double rate : kSampleRates)
+        std::printf(" %9.0fHz", rate);
+    std::printf(" %11s\n", "+all modes");
+
+    std::size_t total[std::size(kSampleRates)] {};
+    std::vector<juce::String> overBudget;
+
+    for (int engineID = 1; engineID < ENGINE_COUNT; ++engineID) {
+        std::unique_ptr<EngineBase> engine;
+        std::size_t bytes[std::size(kSampleRates)] {};
+        for (size_t r = 0; r < std::size(kSampleRates); ++r) {
+            bytes[r] = preparedBytes(engineID, kSampleRates[r], engine);
+            total[r] += bytes[r];
+            if (r + 1 < std::size(kSampleRates))
+                engine.reset();
+        }
+        if (!engine)
+            continue;
+
+        // Measured at the highest rate, the engine left prepared last
+        const std::size_t modeBytes = allModesBytes(*engine);
+
+        const juce::String name = engine->getName();
+        std::printf("%-3d %-28s", engineID, name.toRawUTF8());
+        for (std::size_t b : bytes)
+            std::printf(" %11.1f", kilobytes(b));
+        std::printf(" %11.1f\n", kilobytes(modeBytes));
+
+        if (budgetKb > 0.0 && kilobytes(bytes[kReferenceRate]) > budgetKb)
+            overBudget.push_back(name);
+    }
+
+    std::printf("\n%-32s", "Total");
+    for (std::size_t t : total)
+        std::printf(" %11.1f", kilobytes(t));
+    std::printf("\n");
+
+    if (!overBudget.empty()) {
+        std::printf("\nOver the %.0f KB budget at 48 kHz:\n", budgetKb);
+        for (const auto& name : overBudget)
+            std::printf("  %s\n", name.toRawUTF8());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * Reverb Benchmark
+ * Times the shared FreeverbCore tank against the one-object-per-filter
+ * Freeverb the plate, shimmer and gated reverbs used to carry: eight Comb and
+ * four Allpass objects per channel, each with its own std::vector, processed
+ * one filter and one channel at a time. That form is kept here as the
+ * "before" reference, so the two columns are the same tank at the same
+ * settings and only the data layout and SIMD differ.
+ *
+ * The engines built on the core are then timed whole, so the tank's share of
+ * each engine's cost can be read off.
+ */
+
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/FreeverbCore.h"
+#include "../../JUCE_Plugin/Source/PlateReverb.h"
+#include "../../JUCE_Plugin/Source/ShimmerReverb.h"
+#include "../../JUCE_Plugin/Source/GatedReverb.h"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int kBlockSize = 256;
+constexpr int kBlocks = 2000;
+
+double nanosecondsPerSample(const std::function<void()>& processBlock) {
+    for (int i = 0; i < 50; ++i)
+        processBlock();  // warm caches and branch predictors
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kBlocks; ++i)
+        processBlock();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double(kBlocks) * kBlockSize);
+}
+
+// The engines' former per-filter Freeverb
+class LegacyComb {
+public:
+    void setBuffer(float* buf, int size) { buffer = buf; bufferSize = size; bufferIndex = 0; }
+    void setDamp(float val) { damp1 = val; damp2 = 1.0f - val; }
+    void setFeedback(float val) { feedback = val; }
+
+    float process(float input) {
+        if (!buffer || bufferSize == 0) return 0.0f;
+        float output = buffer[bufferIndex];
+        filterStore = (output * damp2) + (filterStore * damp1);
+        buffer[bufferIndex] = input + (filterStore * feedback);
+        if (++bufferIndex >= bufferSize) bufferIndex = 0;
+        return output;
+    }
+
+private:
+    float* buffer = nullptr;
+    int bufferSize = 0;
+    int bufferIndex = 0;
+    float filterStore = 0.0f;
+    float damp1 = 0.0f;
+    float damp2 = 1.0f;
+    float feedback = 0.0f;
+};
+
+class LegacyAllpass {
+public:
+    void setBuffer(float* buf, int size) { buffer = buf; bufferSize = size; bufferIndex = 0; }
+    void setFeedback(float val) { feedback = val; }
+
+    float process(float input) {
+        if (!buffer || bufferSize == 0) return 0.0f;
+        float bufout = buffer[bufferIndex];
+        float output = -input + bufout;
+        buffer[bufferIndex] = input + (bufout * feedback);
+        if (++bufferIndex >= bufferSize) bufferIndex = 0;
+        return output;
+    }
+
+private:
+    float* buffer = nullptr;
+    int bufferSize = 0;
+    int bufferIndex = 0;
+    float feedback = 0.5f;
+};
+
+struct LegacyTank {
+    LegacyComb comb[2][FreeverbCore::NUM_COMBS];
+    LegacyAllpass allpass[2][FreeverbCore::NUM_ALLPASSES];
+    std::vector<float> combBuffer[2][FreeverbCore::NUM_COMBS];
+    std::vector<float> allpassBuffer[2][FreeverbCore::NUM_ALLPASSES];
+
+    void prepare(double sampleRate, int stereoSpread) {
+        const float srScale = static_cast<float>(sampleRate / 44100.0);
+        for (int ch = 0; ch < 2; ++ch) {
+            for (int i = 0; i < FreeverbCore::NUM_COMBS; ++i) {
+                const int size = static_cast<int>((FreeverbCore::COMB_TUNING[i] + ch * stereoSpread) * srScale);
+                combBuffer[ch][i].assign((size_t) size, 0.0f);
+                comb[ch][i].setBuffer(combBuffer[ch][i].data(), size);
+                comb[ch][i].setFeedback(0.84f);
+                comb[ch][i].setDamp(0.2f);
+            }
+            for (int i = 0; i < FreeverbCore::NUM_ALLPASSES; ++i) {
+                const int size = static_cast<int>((FreeverbCore::ALLPASS_TUNING[i] + ch * stereoSpread) * srScale);
+                allpassBuffer[ch][i].assign((size_t) size, 0.0f);
+                allpass[ch][i].setBuffer(allpassBuffer[ch][i].data(), size);
+            }
+        }
+    }
+
+    void processSample(float inL, float inR, float& outL, float& outR) {
+        outL = outR = 0.0f;
+        for (int j = 0; j < FreeverbCore::NUM_COMBS; ++j) {
+            outL += comb[0][j].process(inL);
+            outR += comb[1][j].process(inR);
+        }
+        for (int j = 0; j < FreeverbCore::NUM_ALLPASSES; ++j) {
+            outL = allpass[0][j].process(outL);
+            outR = allpass[1][j].process(outR);
+        }
+    }
+};
+
+const char* simdPath() {
+   #if defined(__AVX2__)
+    return "AVX2";
+   #elif JUCE_USE_SSE_INTRINSICS || defined(__SSE__)
+    return "SSE";
+   #else
+    return "scalar";
+   #endif
+}
+
+// Stereo noise through a tank; ns per stereo sample
+template <typename Tank>
+double benchmarkTank(Tank& tank) {
+    juce::AudioBuffer<float> buffer(2, kBlockSize);
+    juce::Random random(1);
+    return nanosecondsPerSample([&] {
+        auto* left = buffer.getWritePointer(0);
+        auto* right = buffer.getWritePointer(1);
+        for (int i = 0; i < kBlockSize; ++i) {
+            const float inL = random.nextFloat() - 0.5f, inR = random.nextFloat() - 0.5f;
+            tank.processSample(inL, inR, left[i], right[i]);
+        }
+    });
+}
+
+void benchmarkTanks() {
+    std::printf("\nFreeverb tank, stereo (8 combs + 4 allpasses a side), ns/sample\n");
+    std::printf("%-10s %-8s %12s %12s %10s\n", "rate", "spread", "before", "after", "speedup");
+
+    for (double sampleRate : { 44100.0, 48000.0, 96000.0 }) {
+        for (int spread : { 23, 89 }) {
+            LegacyTank legacy;
+            legacy.prepare(sampleRate, spread);
+            const double before = benchmarkTank(legacy);
+
+            FreeverbCore core;
+            core.prepare(sampleRate, spread);
+            core.setCombFeedback(0.84f);
+            core.setDamping(0.2f);
+            const double after = benchmarkTank(core);
+
+            std::printf("%-10.0f %-8d %12.1f %12.1f %9.2fx\n", sampleRate, spread, before, after, before / after);
+        }
+    }
+}
+
+void benchmarkEngines() {
+    std::printf("\nReverbs on the shared core (whole engine, 48 kHz), ns/sample\n");
+
+    const std::pair<const char*, std::function<std::unique_ptr<EngineBase>()>> engines[] = {
+        { "PlateReverb",   [] { return std::make_unique<PlateReverb>(); } },
+        { "ShimmerReverb", [] { return std::make_unique<ShimmerReverb>(); } },
+        { "GatedReverb",   [] { return std::make_unique<GatedReverb>(); } },
+    };
+    for (const auto& [name, make] : engines) {
+        auto engine = make();
+        engine->prepareToPlay(48000.0, kBlockSize);
+
+        std::map<int, float> params;
+        for (int i = 0; i < engine->getNumParameters(); ++i)
+            params[i] = 0.5f;
+        engine->updateParameters(params);
+
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        juce::Random random(2);
+        const double ns = nanosecondsPerSample([&] {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < kBlockSize; ++i)
+                    buffer.setSample(ch, i, random.nextFloat() - 0.5f);
+            engine->process(buffer);
+        });
+        std::printf("%-28s %10.1f\n", name, ns);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ignoreUnused(argc, argv);
+    juce::ScopedJuceInitialiser_GUI juce_init;
+
+    std::printf("Reverb benchmark: %d-sample blocks, FreeverbCore %s path\n", kBlockSize, simdPath());
+    benchmarkTanks();
+    benchmarkEngines();
+    return 0;
+}
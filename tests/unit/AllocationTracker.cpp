@@ -0,0 +1,126 @@
+#include "AllocationTracker.h"
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+// juce::HeapBlock (and therefore juce::AudioBuffer) allocates through malloc
+// rather than operator new, so on glibc we also interpose the C allocator.
+// Elsewhere only operator new/new[] are counted.
+#if defined(__GLIBC__)
+    #define CHIMERA_TRACK_MALLOC 1
+    extern "C" {
+        void* __libc_malloc(std::size_t);
+        void* __libc_calloc(std::size_t, std::size_t);
+        void* __libc_realloc(void*, std::size_t);
+        void* __libc_memalign(std::size_t, std::size_t);
+        void  __libc_free(void*);
+    }
+#else
+    #define CHIMERA_TRACK_MALLOC 0
+#endif
+
+namespace {
+    thread_local bool tlsArmed = false;
+    thread_local std::size_t tlsAllocationCount = 0;
+    thread_local std::size_t tlsAllocatedBytes = 0;
+
+    inline void recordAllocation(std::size_t size) noexcept {
+        if (tlsArmed) {
+            ++tlsAllocationCount;
+            tlsAllocatedBytes += size;
+        }
+    }
+
+    inline void* rawAllocate(std::size_t size) noexcept {
+       #if CHIMERA_TRACK_MALLOC
+        return __libc_malloc(size == 0 ? 1 : size);
+       #else
+        return std::malloc(size == 0 ? 1 : size);
+       #endif
+    }
+
+    inline void* rawAlignedAllocate(std::size_t size, std::size_t alignment) noexcept {
+       #if CHIMERA_TRACK_MALLOC
+        return __libc_memalign(alignment, size == 0 ? 1 : size);
+       #else
+        void* ptr = nullptr;
+        return posix_memalign(&ptr, alignment, size == 0 ? 1 : size) == 0 ? ptr : nullptr;
+       #endif
+    }
+
+    inline void rawFree(void* ptr) noexcept {
+       #if CHIMERA_TRACK_MALLOC
+        __libc_free(ptr);
+       #else
+        std::free(ptr);
+       #endif
+    }
+
+    void* trackedNew(std::size_t size) {
+        recordAllocation(size);
+        if (void* ptr = rawAllocate(size))
+            return ptr;
+        throw std::bad_alloc();
+    }
+
+    void* trackedAlignedNew(std::size_t size, std::align_val_t alignment) {
+        recordAllocation(size);
+        if (void* ptr = rawAlignedAllocate(size, static_cast<std::size_t>(alignment)))
+            return ptr;
+        throw std::bad_alloc();
+    }
+}
+
+namespace AllocationTracker {
+    std::size_t getAllocationCount() noexcept { return tlsAllocationCount; }
+    std::size_t getAllocatedBytes() noexcept { return tlsAllocatedBytes; }
+    void resetAllocationCount() noexcept { tlsAllocationCount = 0; tlsAllocatedBytes = 0; }
+    bool isArmed() noexcept { return tlsArmed; }
+    void setArmed(bool shouldBeArmed) noexcept { tlsArmed = shouldBeArmed; }
+}
+
+#if CHIMERA_TRACK_MALLOC
+extern "C" {
+    void* malloc(std::size_t size)                  { recordAllocation(size); return __libc_malloc(size); }
+    void* calloc(std::size_t count, std::size_t size) { recordAllocation(count * size); return __libc_calloc(count, size); }
+    void* realloc(void* ptr, std::size_t size)      { recordAllocation(size); return __libc_realloc(ptr, size); }
+
+    // _mm_malloc and the engines' aligned buffers come through here
+    int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) {
+        recordAllocation(size);
+        void* allocated = __libc_memalign(alignment, size == 0 ? 1 : size);
+        if (allocated == nullptr)
+            return ENOMEM;
+        *ptr = allocated;
+        return 0;
+    }
+
+    void* aligned_alloc(std::size_t alignment, std::size_t size) { recordAllocation(size); return __libc_memalign(alignment, size); }
+    void  free(void* ptr)                           { __libc_free(ptr); }
+}
+#endif
+
+// Global replacements - every new/delete in the test binary goes through here
+void* operator new(std::size_t size)   { return trackedNew(size); }
+void* operator new[](std::size_t size) { return trackedNew(size); }
+void* operator new(std::size_t size, std::align_val_t al)   { return trackedAlignedNew(size, al); }
+void* operator new[](std::size_t size, std::align_val_t al) { return trackedAlignedNew(size, al); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    recordAllocation(size);
+    return rawAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    recordAllocation(size);
+    return rawAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept                        { rawFree(ptr); }
+void operator delete[](void* ptr) noexcept                      { rawFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept           { rawFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept         { rawFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept      { rawFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept    { rawFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept   { rawFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { rawFree(ptr); }
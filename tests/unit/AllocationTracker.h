@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * AllocationTracker - counts heap allocations made while a scope is armed.
+ *
+ * The global operator new/delete replacements live in AllocationTracker.cpp,
+ * so link that file exactly once into any test binary that uses this header.
+ * Counting is per-thread: only allocations made by the thread that armed the
+ * scope are recorded, which keeps message-thread or worker activity out of
+ * audio-thread measurements. Requested bytes are summed alongside the count
+ * (frees are not subtracted), which is what the memory-footprint report uses.
+ */
+namespace AllocationTracker {
+
+    // Number of allocations recorded on this thread since the last reset
+    std::size_t getAllocationCount() noexcept;
+    std::size_t getAllocatedBytes() noexcept;
+    void resetAllocationCount() noexcept;  // Resets the byte total too
+
+    bool isArmed() noexcept;
+    void setArmed(bool shouldBeArmed) noexcept;
+
+    // RAII helper: arms tracking for the current thread for its lifetime
+    class ScopedAllocationCheck {
+    public:
+        ScopedAllocationCheck() noexcept {
+            resetAllocationCount();
+            setArmed(true);
+        }
+
+        ~ScopedAllocationCheck() noexcept { setArmed(false); }
+
+        std::size_t getCount() const noexcept { return getAllocationCount(); }
+        std::size_t getBytes() const noexcept { return getAllocatedBytes(); }
+
+        ScopedAllocationCheck(const ScopedAllocationCheck&) = delete;
+        ScopedAllocationCheck& operator=(const ScopedAllocationCheck&) = delete;
+    };
+}
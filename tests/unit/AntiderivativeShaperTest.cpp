@@ -0,0 +1,226 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/AntiderivativeShaper.h"
+#include "../../JUCE_Plugin/Source/PolyphaseOversampler.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks antiderivative anti-aliasing: the tabulated tanh and its integrals
+ * against closed forms, that constant input passes through the curve exactly,
+ * the averaging each order applies to a linear curve, that each order buys
+ * alias rejection on a driven tanh, the closed-form triangle fold, the
+ * Quality-to-plan mapping, and that processing never allocates.
+ */
+class AntiderivativeShaperTest : public juce::UnitTest {
+public:
+    AntiderivativeShaperTest() : UnitTest("Antiderivative Shaper Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Tabulated tanh matches tanh and log cosh");
+        testTanhTable();
+
+        beginTest("Constant input returns the curve value");
+        testConstantInput();
+
+        beginTest("Linear curve is averaged over one or two samples");
+        testLinearCurve();
+
+        beginTest("Each order lowers aliasing of a driven tanh");
+        testAliasRejection();
+
+        beginTest("Triangle fold integrals are consistent");
+        testTriangleFold();
+
+        beginTest("Quality tiers map onto antialiasing plans");
+        testPlans();
+
+        beginTest("Processing does not allocate");
+        testNoAllocation();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+
+    // f(x) = x as a table, so ADAA's averaging can be read off directly
+    static const AdaaTable& identityTable() {
+        static const AdaaTable table([](double x) { return x; }, 4.0);
+        return table;
+    }
+
+    void testTanhTable() {
+        const auto& table = AdaaCurves::tanh();
+        double shapeError = 0.0, F1Error = 0.0, F2Error = 0.0;
+
+        for (double x = -12.0; x <= 12.0; x += 0.0137) {
+            shapeError = std::max(shapeError, std::abs(table.shape(x) - std::tanh(x)));
+
+            // log cosh(x) = |x| + log1p(exp(-2|x|)) - log 2, stable for large x
+            const double logCosh = std::abs(x) + std::log1p(std::exp(-2.0 * std::abs(x))) - std::log(2.0);
+            F1Error = std::max(F1Error, std::abs(table.antiderivative1(x) - logCosh));
+
+            const double h = 1.0e-4;
+            const double dF2 = (table.antiderivative2(x + h) - table.antiderivative2(x - h)) / (2.0 * h);
+            F2Error = std::max(F2Error, std::abs(dF2 - table.antiderivative1(x)));
+        }
+
+        expectLessThan(shapeError, 1.0e-6);
+        expectLessThan(F1Error, 1.0e-6);
+        expectLessThan(F2Error, 1.0e-6);
+    }
+
+    void testConstantInput() {
+        const auto& table = AdaaCurves::tanh();
+        for (int order : { 1, 2 }) {
+            AntiderivativeShaper<> shaper;
+            shaper.setCurve(table);
+            shaper.setOrder(order);
+
+            for (double x : { -3.0, -0.4, 0.0, 0.25, 1.7, 14.0 }) {
+                shaper.reset();
+                double y = 0.0;
+                for (int i = 0; i < 4; ++i)
+                    y = shaper.process(x);
+                expectWithinAbsoluteError(y, table.shape(x), 1.0e-12);
+            }
+        }
+    }
+
+    void testLinearCurve() {
+        const double x[] = { 0.1, -0.7, 1.3, 0.4, 0.4004, -1.9, 0.9 };
+
+        AntiderivativeShaper<> first, second;
+        first.setCurve(identityTable());
+        second.setCurve(identityTable());
+        first.setOrder(1);
+        second.setOrder(2);
+        expectEquals(first.getDelaySamples(), 0.5);
+        expectEquals(second.getDelaySamples(), 1.0);
+
+        for (size_t n = 0; n < std::size(x); ++n) {
+            const double y1 = first.process(x[n]);
+            const double y2 = second.process(x[n]);
+            if (n < 2)
+                continue;  // primed from the first input
+            expectWithinAbsoluteError(y1, 0.5 * (x[n] + x[n - 1]), 1.0e-9);
+            expectWithinAbsoluteError(y2, (x[n] + x[n - 1] + x[n - 2]) / 3.0, 1.0e-9);
+        }
+    }
+
+    // Energy on the 1 kHz grid away from the in-band harmonics of a 7 kHz
+    // tone, relative to the fundamental: where every folded harmonic lands
+    double aliasLevelDb(AntiderivativeShaper<>& shaper, double drive) {
+        const int n = 1 << 14, settle = 512;
+        std::vector<double> y((size_t) n);
+        for (int i = 0; i < n + settle; ++i) {
+            const double x = 0.9 * std::sin(juce::MathConstants<double>::twoPi * 7000.0 * i / kSampleRate);
+            const double out = shaper.process(drive * x);
+            if (i >= settle)
+                y[(size_t) (i - settle)] = out;
+        }
+
+        auto binPower = [&](double frequency) {
+            double re = 0.0, im = 0.0;
+            for (int i = 0; i < n; ++i) {
+                const double w = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / n);
+                re += w * y[(size_t) i] * std::cos(juce::MathConstants<double>::twoPi * frequency * i / kSampleRate);
+                im += w * y[(size_t) i] * std::sin(juce::MathConstants<double>::twoPi * frequency * i / kSampleRate);
+            }
+            return re * re + im * im;
+        };
+
+        double aliasPower = 0.0;
+        for (int k = 1; k < 24; ++k)
+            if (k % 7 != 0)
+                aliasPower += binPower(1000.0 * k);
+        return 10.0 * std::log10(aliasPower / binPower(7000.0) + 1.0e-30);
+    }
+
+    void testAliasRejection() {
+        double level[3];
+        for (int order = 0; order <= 2; ++order) {
+            AntiderivativeShaper<> shaper;
+            shaper.setCurve(AdaaCurves::tanh());
+            shaper.setOrder(order);
+            level[order] = aliasLevelDb(shaper, 3.0);
+        }
+
+        // About -23, -36 and -62 dB
+        expectLessThan(level[1], level[0] - 10.0);
+        expectLessThan(level[2], level[1] - 20.0);
+    }
+
+    void testTriangleFold() {
+        AdaaCurves::TriangleFold fold;
+        juce::Random random(7);
+
+        for (int trial = 0; trial < 20; ++trial) {
+            fold.setThresholds(-0.1 - 0.9 * random.nextDouble(), 0.1 + 0.9 * random.nextDouble());
+
+            double F1Error = 0.0, F2Error = 0.0, foldError = 0.0;
+            for (double x = -3.0; x <= 3.0; x += 0.01) {
+                const double h = 1.0e-5;
+                F1Error = std::max(F1Error, std::abs((fold.antiderivative1(x + h) - fold.antiderivative1(x - h)) / (2.0 * h)
+                                                     - fold.shape(x)));
+                F2Error = std::max(F2Error, std::abs((fold.antiderivative2(x + h) - fold.antiderivative2(x - h)) / (2.0 * h)
+                                                     - fold.antiderivative1(x)));
+
+                // Reflecting off the thresholds until inside them
+                double reflected = juce::jlimit(-fold.limit, fold.limit, x);
+                while (reflected > fold.high || reflected < fold.low)
+                    reflected = reflected > fold.high ? 2.0 * fold.high - reflected : 2.0 * fold.low - reflected;
+                foldError = std::max(foldError, std::abs(fold.shape(x) - reflected));
+            }
+
+            // The first differences straddle the corners, where they are off by h / 4
+            expectLessThan(F1Error, 1.0e-5);
+            expectLessThan(F2Error, 1.0e-6);
+            expectLessThan(foldError, 1.0e-9);
+        }
+    }
+
+    void testPlans() {
+        using Q = EngineBase::Quality;
+        auto plan = [](Q q, AntialiasingMode mode, int maxFactor) {
+            const auto p = antialiasingForQuality(q, mode, maxFactor);
+            return juce::String(p.factor) + "/" + juce::String(p.adaaOrder);
+        };
+
+        // Oversampling keeps PolyphaseOversampler::factorForQuality()
+        for (int maxFactor : { 1, 2, 4, 8 })
+            for (auto q : { Q::Draft, Q::Normal, Q::High, Q::Ultra })
+                expectEquals(antialiasingForQuality(q, AntialiasingMode::Oversampling, maxFactor).factor,
+                             juce::jmax(1, PolyphaseOversampler::factorForQuality(q, maxFactor)));
+
+        expectEquals(plan(Q::Draft,  AntialiasingMode::Antiderivative, 4), juce::String("1/1"));
+        expectEquals(plan(Q::Normal, AntialiasingMode::Antiderivative, 4), juce::String("1/1"));
+        expectEquals(plan(Q::High,   AntialiasingMode::Antiderivative, 4), juce::String("2/1"));
+        expectEquals(plan(Q::Ultra,  AntialiasingMode::Antiderivative, 4), juce::String("2/2"));
+        expectEquals(plan(Q::Ultra,  AntialiasingMode::Antiderivative, 1), juce::String("1/1"));
+    }
+
+    void testNoAllocation() {
+        AntiderivativeShaper<> shaper;
+        shaper.setCurve(AdaaCurves::tanh());
+        AdaaCurves::TriangleFold fold;
+        AntiderivativeShaper<AdaaCurves::TriangleFold> folder;
+        folder.setCurve(fold);
+
+        AllocationTracker::ScopedAllocationCheck check;
+        double sum = 0.0;
+        for (int order : { 0, 1, 2 }) {
+            shaper.setOrder(order);
+            folder.setOrder(order);
+            for (int i = 0; i < 4096; ++i) {
+                const double x = 4.0 * std::sin(0.01 * i);
+                sum += shaper.process(x);
+                fold.setThresholds(-0.5, 0.4 + 0.0001 * (i % 100));
+                folder.curveChanged();
+                sum += folder.process(x);
+            }
+        }
+        expectEquals((int) check.getCount(), 0);
+        expect(std::isfinite(sum));
+    }
+};
+
+// Register the test
+static AntiderivativeShaperTest antiderivativeShaperTest;
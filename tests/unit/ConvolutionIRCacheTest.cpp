@@ -0,0 +1,91 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/ConvolutionIRCache.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks the convolution reverb's IR cache: reverbs with the same settings
+ * and sample rate share one partitioned IR, and a rebuild asked for on the
+ * audio thread is built on the loader thread and handed back without the
+ * audio thread locking or allocating.
+ */
+class ConvolutionIRCacheTest : public juce::UnitTest {
+public:
+    ConvolutionIRCacheTest() : UnitTest("Convolution IR Cache Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Settings survive packing");
+        testPacking();
+
+        beginTest("Identical settings share one IR");
+        testSharing();
+
+        beginTest("Rebuilds run on the loader thread");
+        testBackgroundRebuild();
+    }
+
+private:
+    using Settings = ConvolutionIRCache::Settings;
+    using Quality = EngineBase::Quality;
+
+    void testPacking() {
+        const auto settings = Settings::fromParameters(0.8f, 0.37f, 1.0f, 0.9f, 0.0f, Quality::High);
+        const auto unpacked = Settings::unpack(settings.pack());
+        expectEquals(unpacked.irIndex, 3);
+        expect(unpacked.reversed);
+        expectEquals(unpacked.size, 7);
+        expectEquals(unpacked.damping, Settings::STEPS);
+        expectEquals(unpacked.earlyLate, 0);
+        expect(unpacked.quality == Quality::High);
+        expectEquals(unpacked.pack(), settings.pack());
+    }
+
+    void testSharing() {
+        auto cache = ConvolutionIRCache::getShared();
+        expect(cache == ConvolutionIRCache::getShared(), "One cache per process");
+
+        // Short IRs keep the test quick: 10% of the 2 s plate, capped by Draft
+        const auto a = Settings::fromParameters(0.3f, 0.1f, 0.2f, 0.0f, 0.5f, Quality::Draft);
+        const auto nudged = Settings::fromParameters(0.3f, 0.11f, 0.21f, 0.0f, 0.5f, Quality::Draft);
+        const auto darker = Settings::fromParameters(0.3f, 0.1f, 0.6f, 0.0f, 0.5f, Quality::Draft);
+
+        const auto first = cache->get(a, 48000.0);
+        expect(first != nullptr && first->getLength() == 9600, "10% of a 2 s IR at 48 kHz");
+        expect(cache->get(a, 48000.0) == first, "Same settings, same IR");
+        expect(cache->get(nudged, 48000.0) == first, "Moves within a 5% step reuse the IR");
+        expect(cache->get(darker, 48000.0) != first, "Different damping, different IR");
+        expect(cache->get(a, 44100.0) != first, "Different sample rate, different IR");
+    }
+
+    void testBackgroundRebuild() {
+        auto cache = ConvolutionIRCache::getShared();
+        const double sampleRate = 48000.0;
+        const auto initial = Settings::fromParameters(0.0f, 0.1f, 0.0f, 0.0f, 0.5f, Quality::Draft);
+        const auto changed = Settings::fromParameters(0.0f, 0.15f, 0.0f, 0.0f, 0.5f, Quality::Draft);
+
+        ConvolutionIRCache::Request request;
+        cache->attach(request, sampleRate, initial);
+        expect(request.collect() == nullptr, "Nothing to collect before a change");
+
+        ConvolutionIRCache::IRPtr collected;
+        size_t allocations = 0;
+        {
+            // Stands in for the audio thread: post once, then poll each "block"
+            AllocationTracker::ScopedAllocationCheck check;
+            request.post(changed);
+            for (int block = 0; block < 1000 && collected == nullptr; ++block) {
+                collected = request.collect();
+                if (collected == nullptr) juce::Thread::sleep(5);
+            }
+            allocations = check.getCount();
+        }
+        cache->detach(request);
+
+        expectEquals((int) allocations, 0);
+        expect(collected != nullptr, "The loader never delivered");
+        expect(collected == cache->get(changed, sampleRate), "Delivered IR is the cached one");
+        expect(request.collect() == nullptr, "Each IR is collected once");
+    }
+};
+
+// Register the test
+static ConvolutionIRCacheTest convolutionIRCacheTest;
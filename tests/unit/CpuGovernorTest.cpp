@@ -0,0 +1,202 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/CpuGovernor.h"
+#include <deque>
+#include <numeric>
+
+/**
+ * Drives the CPU governor with synthetic telemetry snapshots: degradation
+ * under sustained and critical load, the hysteresis band, restoration order,
+ * the offline override, pinned slots, and a chain whose load responds to the
+ * tiers while the long telemetry window lags behind.
+ */
+class CpuGovernorTest : public juce::UnitTest {
+public:
+    CpuGovernorTest() : UnitTest("CPU Governor Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Sustained warning load degrades the most expensive slot");
+        testWarningLoad();
+
+        beginTest("Critical load degrades immediately");
+        testCriticalLoad();
+
+        beginTest("Hysteresis band holds tiers, low load restores them in reverse order");
+        testHysteresisAndRestore();
+
+        beginTest("Offline rendering and disabling force Ultra");
+        testOfflineAndDisabled();
+
+        beginTest("One step that relieves the load is the only step");
+        testLoadDropsAfterStep();
+
+        beginTest("Pinned slots stay at Ultra and are passed over");
+        testPinnedSlot();
+    }
+
+private:
+    using Quality = EngineBase::Quality;
+
+    // 10 ms blocks, published every 5 blocks (as PerformanceTelemetry would at ~50 ms)
+    static constexpr float kBlockMs = 10.0f;
+    static constexpr int kBlocksPerPublish = 5;
+
+    struct Feed {
+        CpuGovernor governor;
+        PerformanceTelemetry::Snapshot snapshot;
+
+        Feed() {
+            snapshot.blockDeadlineMs = kBlockMs;
+            // Slot 1 is the most expensive, then slot 3; slot 5 is idle
+            const float slotLoads[] = { 0.05f, 0.30f, 0.05f, 0.20f, 0.10f, 0.0f };
+            for (int slot = 0; slot < CpuGovernor::NUM_SLOTS; ++slot) {
+                snapshot.slots[(size_t) slot].active = slotLoads[slot] > 0.0f;
+                snapshot.slots[(size_t) slot].recentLoad = slotLoads[slot];
+            }
+        }
+
+        void run(float chainLoadPercent, double seconds, bool offline = false, bool enabled = true) {
+            snapshot.chainRecentLoad = chainLoadPercent * 0.01f;
+            const int publishes = juce::roundToInt(seconds * 1000.0 / (kBlockMs * kBlocksPerPublish));
+            for (int i = 0; i < publishes; ++i) {
+                snapshot.blockCount += kBlocksPerPublish;
+                governor.update(snapshot, offline, enabled);
+            }
+        }
+
+        // The governor ranks slots by measured cost, so a degraded slot's
+        // telemetry has to reflect its cheaper tier
+        void setSlotLoad(int slot, float load) { snapshot.slots[(size_t) slot].recentLoad = load; }
+    };
+
+    void expectAllUltra(const CpuGovernor& governor, const juce::String& context) {
+        for (int slot = 0; slot < CpuGovernor::NUM_SLOTS; ++slot)
+            expect(governor.getTier(slot) == Quality::Ultra, context + ": slot " + juce::String(slot));
+    }
+
+    void testWarningLoad() {
+        Feed feed;
+
+        // Below the hold time nothing changes
+        feed.run(ChimeraConfig::CPU_THRESHOLD_WARNING + 2.0f, ChimeraConfig::CPU_GOVERNOR_HOLD_SECONDS * 0.5);
+        expectAllUltra(feed.governor, "Before hold time");
+
+        feed.run(ChimeraConfig::CPU_THRESHOLD_WARNING + 2.0f, ChimeraConfig::CPU_GOVERNOR_HOLD_SECONDS);
+        expect(feed.governor.getTier(1) == Quality::High, "Most expensive slot should drop one tier");
+        expect(feed.governor.getTier(3) == Quality::Ultra);
+
+        // Still over warning: keeps walking slot 1 down until it bottoms out
+        feed.run(ChimeraConfig::CPU_THRESHOLD_WARNING + 2.0f, ChimeraConfig::CPU_GOVERNOR_HOLD_SECONDS * 6.0);
+        expect(feed.governor.getTier(1) == Quality::Draft);
+        expect(feed.governor.getTier(3) != Quality::Ultra, "Next most expensive slot should follow");
+        expect(feed.governor.getTier(5) == Quality::Ultra, "Idle slots are never degraded");
+    }
+
+    void testCriticalLoad() {
+        Feed feed;
+        feed.run(ChimeraConfig::CPU_THRESHOLD_CRITICAL + 5.0f, 0.05);
+        expect(feed.governor.getTier(1) == Quality::High, "First critical snapshot should degrade");
+
+        feed.run(ChimeraConfig::CPU_THRESHOLD_CRITICAL + 5.0f, ChimeraConfig::CPU_GOVERNOR_CRITICAL_COOLDOWN_SECONDS * 2.0);
+        expect(static_cast<int>(feed.governor.getTier(1)) <= static_cast<int>(Quality::Normal),
+               "Critical load should keep stepping at the cooldown rate");
+    }
+
+    void testHysteresisAndRestore() {
+        Feed feed;
+        feed.run(ChimeraConfig::CPU_THRESHOLD_CRITICAL + 5.0f, 0.05);
+        feed.setSlotLoad(1, 0.15f);
+        feed.run(ChimeraConfig::CPU_THRESHOLD_CRITICAL + 5.0f, ChimeraConfig::CPU_GOVERNOR_CRITICAL_COOLDOWN_SECONDS * 1.5);
+        expect(feed.governor.getTier(1) == Quality::High);
+        expect(feed.governor.getTier(3) == Quality::High, "Second step goes to the now most expensive slot");
+
+        // Between the restore line and the warning threshold: no movement
+        const float band = ChimeraConfig::CPU_THRESHOLD_WARNING - ChimeraConfig::CPU_GOVERNOR_RESTORE_MARGIN * 0.5f;
+        feed.run(band, ChimeraConfig::CPU_GOVERNOR_RESTORE_SECONDS * 3.0);
+        expect(feed.governor.getTier(1) == Quality::High && feed.governor.getTier(3) == Quality::High,
+               "Tiers should hold inside the hysteresis band");
+
+        // Headroom: most recently degraded slot comes back first
+        const float low = ChimeraConfig::CPU_THRESHOLD_WARNING - ChimeraConfig::CPU_GOVERNOR_RESTORE_MARGIN - 10.0f;
+        feed.run(low, ChimeraConfig::CPU_GOVERNOR_RESTORE_SECONDS + 0.1);
+        expect(feed.governor.getTier(3) == Quality::Ultra, "Last degraded slot restores first");
+        expect(feed.governor.getTier(1) == Quality::High);
+
+        feed.run(low, ChimeraConfig::CPU_GOVERNOR_RESTORE_SECONDS * 2.0 + 0.1);
+        expectAllUltra(feed.governor, "After sustained headroom");
+    }
+
+    void testOfflineAndDisabled() {
+        Feed feed;
+        feed.run(ChimeraConfig::CPU_THRESHOLD_CRITICAL + 5.0f, 0.5);
+        expect(feed.governor.getTier(1) != Quality::Ultra);
+
+        feed.run(ChimeraConfig::CPU_THRESHOLD_CRITICAL + 5.0f, 0.05, true);
+        expectAllUltra(feed.governor, "Offline");
+
+        feed.run(ChimeraConfig::CPU_THRESHOLD_CRITICAL + 5.0f, 1.0, false, false);
+        expectAllUltra(feed.governor, "Disabled");
+    }
+
+    void testLoadDropsAfterStep() {
+        Feed feed;
+
+        // 90% at Ultra, dominated by slot 1; its High tier costs 40% as much,
+        // which leaves the chain at 63% - between the restore line and warning
+        const float ultraLoads[] = { 0.05f, 0.45f, 0.05f, 0.10f, 0.05f, 0.0f };
+        const float tierCost[] = { 0.15f, 0.25f, 0.4f, 1.0f };  // Draft..Ultra
+        const float overhead = 0.2f;
+
+        // The rolling means span 512 blocks (~5 s here) and lag every change;
+        // the chain ran at 50% for that long before the overload arrived
+        const int windowPublishes = RollingCostStats::WINDOW / kBlocksPerPublish;
+        std::deque<float> chainHistory((size_t) windowPublishes, 0.5f);
+
+        for (int publish = 0; publish < 200; ++publish) {  // 10 s
+            float chain = overhead;
+            for (int slot = 0; slot < CpuGovernor::NUM_SLOTS; ++slot) {
+                const float load = ultraLoads[slot] * tierCost[static_cast<int>(feed.governor.getTier(slot))];
+                auto& stats = feed.snapshot.slots[(size_t) slot];
+                stats.active = load > 0.0f;
+                stats.recentLoad = load;
+                stats.meanLoad = ultraLoads[slot];
+                chain += load;
+            }
+
+            chainHistory.push_back(chain);
+            if ((int) chainHistory.size() > windowPublishes)
+                chainHistory.pop_front();
+
+            feed.snapshot.chainRecentLoad = chain;
+            feed.snapshot.chainMeanLoad = std::accumulate(chainHistory.begin(), chainHistory.end(), 0.0f)
+                                        / (float) chainHistory.size();
+            feed.snapshot.blockCount += kBlocksPerPublish;
+            feed.governor.update(feed.snapshot, false, true);
+        }
+
+        int degradedSlots = 0;
+        for (int slot = 0; slot < CpuGovernor::NUM_SLOTS; ++slot)
+            degradedSlots += feed.governor.getTier(slot) != Quality::Ultra ? 1 : 0;
+        expectEquals(degradedSlots, 1);
+        expect(feed.governor.getTier(1) == Quality::High, "Slot 1 should have dropped exactly one tier");
+    }
+
+    void testPinnedSlot() {
+        Feed feed;
+        feed.governor.setSlotPinned(1, true);
+        feed.run(ChimeraConfig::CPU_THRESHOLD_CRITICAL + 5.0f, 0.05);
+        expect(feed.governor.getTier(1) == Quality::Ultra, "Pinned slot was degraded");
+        expect(feed.governor.getTier(3) == Quality::High, "The next most expensive slot should go instead");
+
+        // A slot degraded before it was pinned reports Ultra, and its own
+        // tier again once unpinned
+        Feed earlier;
+        earlier.run(ChimeraConfig::CPU_THRESHOLD_CRITICAL + 5.0f, 0.05);
+        earlier.governor.setSlotPinned(1, true);
+        expect(earlier.governor.getTier(1) == Quality::Ultra);
+        earlier.governor.setSlotPinned(1, false);
+        expect(earlier.governor.getTier(1) == Quality::High);
+    }
+};
+
+// Register the test
+static CpuGovernorTest cpuGovernorTest;
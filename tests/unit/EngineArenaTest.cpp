@@ -0,0 +1,152 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/EngineArena.h"
+#include "../../JUCE_Plugin/Source/PlateReverb.h"
+#include "../../JUCE_Plugin/Source/FrequencyShifter.h"
+#include "../../JUCE_Plugin/Source/PhaseAlign_Platinum.h"
+#include "AllocationTracker.h"
+#include <cstdint>
+#include <functional>
+
+/**
+ * Checks EngineArena's layout contract (aligned, zeroed blocks; overflow
+ * chunks merged on rewind so a repeated layout reuses one block) and that
+ * the engines built on it reach the heap only in prepareToPlay - and, once
+ * the arena has settled, not even there when re-prepared at the same
+ * settings.
+ */
+class EngineArenaTest : public juce::UnitTest {
+public:
+    EngineArenaTest() : UnitTest("Engine Arena Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Blocks are aligned and zeroed");
+        testAlignmentAndZeroing();
+
+        beginTest("Rewind merges overflow chunks");
+        testConsolidation();
+
+        beginTest("Repeating a layout does not allocate");
+        testRepeatedLayout();
+
+        beginTest("Plate reverb allocates only in prepareToPlay");
+        testEngine([] { return std::make_unique<PlateReverb>(); });
+
+        beginTest("Frequency shifter allocates only in prepareToPlay");
+        testEngine([] { return std::make_unique<FrequencyShifter>(); });
+
+        beginTest("Phase align allocates only in prepareToPlay");
+        testEngine([] { return std::make_unique<PhaseAlign_Platinum>(); });
+    }
+
+private:
+    static constexpr int kBlockSize = 512;
+
+    static bool isAligned(const void* p) {
+        return reinterpret_cast<std::uintptr_t>(p) % EngineArena::ALIGNMENT == 0;
+    }
+
+    void testAlignmentAndZeroing() {
+        EngineArena arena;
+        for (size_t count : { (size_t) 1, (size_t) 3, (size_t) 100, (size_t) 0, (size_t) 5000 }) {
+            auto* block = arena.allocate<float>(count);
+            expect(isAligned(block), "Block of " + juce::String((int) count) + " floats is misaligned");
+            for (size_t i = 0; i < count; ++i)
+                block[i] = 1.0f;
+        }
+
+        // A rewound arena hands the same storage out again, cleared
+        arena.rewind();
+        auto* reused = arena.allocate<float>(5000);
+        bool allZero = true;
+        for (size_t i = 0; i < 5000; ++i)
+            allZero = allZero && reused[i] == 0.0f;
+        expect(allZero, "Rewound block was not cleared");
+    }
+
+    void testConsolidation() {
+        EngineArena arena;
+        for (int i = 0; i < 10; ++i)
+            arena.allocate<float>(8192);
+        expect(arena.getNumChunks() > 1, "Layout should have overflowed the first chunk");
+        const size_t used = arena.getUsedBytes();
+
+        arena.rewind();
+        expectEquals((int) arena.getNumChunks(), 1);
+        expect(arena.getCapacityBytes() >= used);
+
+        for (int i = 0; i < 10; ++i)
+            arena.allocate<float>(8192);
+        expectEquals((int) arena.getNumChunks(), 1);
+
+        arena.release();
+        expectEquals((int) arena.getCapacityBytes(), 0);
+    }
+
+    void testRepeatedLayout() {
+        EngineArena arena;
+        auto layout = [&arena] {
+            arena.rewind();
+            arena.allocate<float>(9600);
+            arena.allocate<double>(33);
+            arena.allocate<float>(20000);
+        };
+        layout();  // Overflowed into three chunks
+        layout();  // Merged them into one
+
+        AllocationTracker::ScopedAllocationCheck check;
+        layout();
+        expectEquals((int) check.getCount(), 0);
+    }
+
+    void testEngine(const std::function<std::unique_ptr<EngineBase>()>& create) {
+        auto engine = create();
+        engine->prepareToPlay(48000.0, kBlockSize);
+        engine->prepareToPlay(48000.0, kBlockSize);  // Arena settled into one block
+        expect(engine->getArenaBytes() > 0, engine->getName() + " keeps its buffers elsewhere");
+
+        // Every parameter at both extremes and centred; built up front so
+        // the maps' own nodes are not counted
+        std::vector<std::map<int, float>> settings;
+        for (float value : { 1.0f, 0.0f, 0.5f }) {
+            std::map<int, float> params;
+            for (int i = 0; i < engine->getNumParameters(); ++i)
+                params[i] = value;
+            settings.push_back(params);
+        }
+
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        juce::Random random(11);
+        auto fill = [&] {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < kBlockSize; ++i)
+                    buffer.setSample(ch, i, random.nextFloat() - 0.5f);
+        };
+
+        {
+            AllocationTracker::ScopedAllocationCheck check;
+            for (const auto& params : settings) {
+                engine->updateParameters(params);
+                for (int block = 0; block < 8; ++block) {
+                    fill();
+                    engine->process(buffer);
+                }
+                engine->reset();
+                fill();
+                engine->process(buffer);
+            }
+            expectEquals((int) check.getCount(), 0);
+        }
+
+        // Same rate and block size: the arena's block is reused as is
+        const size_t arenaBytes = engine->getArenaBytes();
+        {
+            AllocationTracker::ScopedAllocationCheck check;
+            engine->prepareToPlay(48000.0, kBlockSize);
+            expectEquals((int) check.getCount(), 0);
+        }
+        expectEquals((int) engine->getArenaBytes(), (int) arenaBytes);
+    }
+};
+
+// Register the test
+static EngineArenaTest engineArenaTest;
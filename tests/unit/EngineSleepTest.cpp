@@ -0,0 +1,105 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/PluginProcessor.h"
+#include "../../JUCE_Plugin/Source/EngineTypes.h"
+
+/**
+ * Checks that idle slots go to sleep once their input is silent and their
+ * tail has rung out, that they wake on the first block with signal, and that
+ * engines with a tail stay awake while it is still decaying.
+ */
+class EngineSleepTest : public juce::UnitTest {
+public:
+    EngineSleepTest() : UnitTest("Engine Sleep Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Tail-free engine sleeps after silence and wakes on signal");
+        testSleepAndWake();
+
+        beginTest("Engine with a tail stays awake while ringing");
+        testTailKeepsAwake();
+
+        beginTest("Modulation engine reports its delay lines as a tail");
+        testBufferingEngineKeepsAwake(ENGINE_STEREO_CHORUS, 0.02);
+
+        beginTest("Spectral engine reports its STFT buffering as a tail");
+        testBufferingEngineKeepsAwake(ENGINE_SPECTRAL_GATE, 0.0);
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kBlockSize = 256;
+
+    void runSeconds(ChimeraAudioProcessor& processor, double seconds, bool withSignal) {
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        juce::MidiBuffer midi;
+        const int blocks = juce::roundToInt(seconds * kSampleRate / kBlockSize);
+
+        for (int b = 0; b < blocks; ++b) {
+            buffer.clear();
+            if (withSignal) {
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+                    auto* data = buffer.getWritePointer(ch);
+                    for (int i = 0; i < kBlockSize; ++i)
+                        data[i] = 0.25f * static_cast<float>(std::sin(2.0 * juce::MathConstants<double>::pi * 440.0 * i / kSampleRate));
+                }
+            }
+            processor.processBlock(buffer, midi);
+        }
+    }
+
+    void testSleepAndWake() {
+        ChimeraAudioProcessor processor;
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+        processor.setSlotEngine(0, ENGINE_GAIN_UTILITY);
+
+        // Let the engine crossfade in, then feed it signal
+        runSeconds(processor, 0.5, true);
+        expect(! processor.isSlotSleeping(0), "Slot must be awake while it has input");
+
+        // Quiet window plus a margin for the engine's own smoothing
+        runSeconds(processor, ChimeraConfig::ENGINE_TAIL_QUIET_MS * 0.001 * 2.0 + 0.1, false);
+        expect(processor.isSlotSleeping(0), "Silent tail-free slot should be asleep");
+
+        // Silence passes through a sleeping slot unchanged
+        juce::AudioBuffer<float> silence(2, kBlockSize);
+        silence.clear();
+        juce::MidiBuffer midi;
+        processor.processBlock(silence, midi);
+        expectEquals(silence.getMagnitude(0, kBlockSize), 0.0f);
+
+        runSeconds(processor, static_cast<double>(kBlockSize) / kSampleRate, true);
+        expect(! processor.isSlotSleeping(0), "First block with signal should wake the slot");
+    }
+
+    void testTailKeepsAwake() {
+        ChimeraAudioProcessor processor;
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+        processor.setSlotEngine(0, ENGINE_DIGITAL_DELAY);
+
+        runSeconds(processor, 0.5, true);
+        expect(processor.getTailLengthSeconds() > 0.0, "Delay slot should report a tail");
+
+        // Longer than the quiet window but well inside the delay's tail
+        runSeconds(processor, ChimeraConfig::ENGINE_TAIL_QUIET_MS * 0.001 * 2.0, false);
+        expect(! processor.isSlotSleeping(0), "Delay must keep running while its repeats decay");
+    }
+
+    // Engines without feedback still hold audio in delay lines or analysis
+    // frames once the input stops, and must not sleep before it has played out
+    void testBufferingEngineKeepsAwake(int engineId, double minTailSeconds) {
+        ChimeraAudioProcessor processor;
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+        processor.setSlotEngine(0, engineId);
+
+        runSeconds(processor, 0.5, true);
+        const double tail = processor.getTailLengthSeconds();
+        expect(tail > minTailSeconds, "Slot should report its buffered audio as a tail, got " + juce::String(tail));
+
+        // One quiet window of silence leaves the buffered audio still to play
+        runSeconds(processor, ChimeraConfig::ENGINE_TAIL_QUIET_MS * 0.001, false);
+        expect(! processor.isSlotSleeping(0), "Slot must stay awake while its buffered audio plays out");
+    }
+};
+
+// Register the test
+static EngineSleepTest engineSleepTest;
@@ -0,0 +1,160 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/DspEngineUtilities.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks FastMath against the C library at every accuracy: each function's
+ * scalar and block forms stay inside the error bound DspEngineUtilities.h
+ * documents for it over its stated range (odd lengths exercise the tail after
+ * the SIMD lanes), out-of-range inputs clamp rather than overflow, Quality
+ * maps onto the tiers, and nothing allocates.
+ */
+class FastMathTest : public juce::UnitTest {
+public:
+    FastMathTest() : UnitTest("Fast Math Test", "RealTime") {}
+
+    void runTest() override {
+        using A = FastMath::Accuracy;
+        for (auto accuracy : { A::Coarse, A::Medium, A::Fine }) {
+            const auto tier = (size_t) accuracy;
+            beginTest(juce::String("Error bounds at ") + kTierNames[tier]);
+
+            testFunction("tanh", accuracy, -20.0, 20.0, kTanhBound[tier], Error::Absolute,
+                         [] (double x) { return std::tanh(x); },
+                         [] (float x, A a) { return FastMath::tanh(x, a); },
+                         [] (const float* in, float* out, int n, A a) { FastMath::tanh(in, out, n, a); });
+
+            testFunction("exp", accuracy, -87.0, 88.0, kExpBound[tier], Error::Relative,
+                         [] (double x) { return std::exp(x); },
+                         [] (float x, A a) { return FastMath::exp(x, a); },
+                         [] (const float* in, float* out, int n, A a) { FastMath::exp(in, out, n, a); });
+
+            testFunction("pow2", accuracy, -126.0, 127.0, kExpBound[tier], Error::Relative,
+                         [] (double x) { return std::exp2(x); },
+                         [] (float x, A a) { return FastMath::pow2(x, a); },
+                         [] (const float* in, float* out, int n, A a) { FastMath::pow2(in, out, n, a); });
+
+            // Densely around 1, then through every binade
+            for (bool geometric : { false, true })
+                testFunction("log", accuracy, geometric ? 1.0e-37 : 1.0e-4, geometric ? 1.0e38 : 4.0,
+                             kLogBound[tier], Error::AbsoluteThenRelative,
+                             [] (double x) { return std::log(x); },
+                             [] (float x, A a) { return FastMath::log(x, a); },
+                             [] (const float* in, float* out, int n, A a) { FastMath::log(in, out, n, a); },
+                             geometric);
+
+            const double range = 8192.0 * juce::MathConstants<double>::pi;
+            testFunction("sin", accuracy, -range, range, kTrigBound[tier], Error::Absolute,
+                         [] (double x) { return std::sin(x); },
+                         [] (float x, A a) { return FastMath::sin(x, a); },
+                         [] (const float* in, float* out, int n, A a) {
+                             std::vector<float> cosines((size_t) n);
+                             FastMath::sincos(in, out, cosines.data(), n, a);
+                         });
+            testFunction("cos", accuracy, -range, range, kTrigBound[tier], Error::Absolute,
+                         [] (double x) { return std::cos(x); },
+                         [] (float x, A a) { return FastMath::cos(x, a); },
+                         [] (const float* in, float* out, int n, A a) {
+                             std::vector<float> sines((size_t) n);
+                             FastMath::sincos(in, sines.data(), out, n, a);
+                         });
+        }
+
+        beginTest("Out-of-range inputs clamp");
+        testClamping();
+
+        beginTest("Quality selects the accuracy");
+        expect(FastMath::accuracyForQuality(EngineBase::Quality::Draft) == FastMath::Accuracy::Coarse);
+        expect(FastMath::accuracyForQuality(EngineBase::Quality::Normal) == FastMath::Accuracy::Medium);
+        expect(FastMath::accuracyForQuality(EngineBase::Quality::High) == FastMath::Accuracy::Fine);
+        expect(FastMath::accuracyForQuality(EngineBase::Quality::Ultra) == FastMath::Accuracy::Fine);
+
+        beginTest("Block forms do not allocate");
+        testNoAllocation();
+    }
+
+private:
+    // Coarse, Medium, Fine: the table in DspEngineUtilities.h
+    static constexpr const char* kTierNames[] = { "Coarse", "Medium", "Fine" };
+    static constexpr double kTanhBound[] = { 2.5e-2, 1.0e-4, 1.0e-6 };
+    static constexpr double kExpBound[] = { 1.0e-3, 5.0e-6, 3.0e-7 };   // exp and pow2, relative
+    static constexpr double kLogBound[] = { 1.0e-4, 3.0e-6, 3.0e-7 };
+    static constexpr double kTrigBound[] = { 5.0e-5, 1.0e-6, 5.0e-7 };
+    static constexpr int kPoints = 200003;  // odd, so every block ends in a scalar tail
+
+    enum class Error { Absolute, Relative, AbsoluteThenRelative };
+
+    // Sweeps [lo, hi], evenly or geometrically, comparing both forms with the
+    // double-precision reference
+    template <typename Reference, typename Scalar, typename Block>
+    void testFunction(const char* name, FastMath::Accuracy accuracy, double lo, double hi, double bound, Error error,
+                      Reference reference, Scalar scalar, Block block, bool geometric = false) {
+        std::vector<float> x((size_t) kPoints), blockOut((size_t) kPoints);
+        for (int i = 0; i < kPoints; ++i) {
+            const double t = (double) i / (kPoints - 1);
+            x[(size_t) i] = (float) (geometric ? lo * std::pow(hi / lo, t) : lo + (hi - lo) * t);
+        }
+        block(x.data(), blockOut.data(), kPoints, accuracy);
+
+        double worst[2] = {}, worstAt[2] = {};
+        for (int i = 0; i < kPoints; ++i) {
+            const double e = reference((double) x[(size_t) i]);
+            const float y[2] = { scalar(x[(size_t) i], accuracy), blockOut[(size_t) i] };
+
+            for (int form = 0; form < 2; ++form) {
+                double err = std::abs((double) y[form] - e);
+                if (error == Error::Relative)
+                    err /= std::abs(e);
+                else if (error == Error::AbsoluteThenRelative)
+                    err /= std::max(1.0, std::abs(e));
+
+                if (err > worst[form]) {
+                    worst[form] = err;
+                    worstAt[form] = x[(size_t) i];
+                }
+            }
+        }
+        for (int form = 0; form < 2; ++form)
+            expect(worst[form] <= bound, juce::String(name) + (form == 0 ? " scalar" : " block") + " error "
+                                         + juce::String(worst[form]) + " at " + juce::String(worstAt[form])
+                                         + ", bound " + juce::String(bound));
+    }
+
+    void testClamping() {
+        for (auto a : { FastMath::Accuracy::Coarse, FastMath::Accuracy::Medium, FastMath::Accuracy::Fine }) {
+            expectWithinAbsoluteError(FastMath::tanh(1000.0f, a), 1.0f, 2.0e-7f);
+            expectWithinAbsoluteError(FastMath::tanh(-1000.0f, a), -1.0f, 2.0e-7f);
+            expectEquals(FastMath::tanh(0.0f, a), 0.0f);
+
+            // Normal floats at both ends: no infinities, no denormals
+            expect(std::isnormal(FastMath::exp(-1000.0f, a)) && std::isnormal(FastMath::exp(1000.0f, a)));
+            expect(std::isnormal(FastMath::pow2(-1000.0f, a)) && std::isnormal(FastMath::pow2(1000.0f, a)));
+            expectEquals(FastMath::pow2(0.0f, a), 1.0f);
+
+            expect(std::isfinite(FastMath::log(0.0f, a)) && std::isfinite(FastMath::log(-1.0f, a)));
+            expectWithinAbsoluteError(FastMath::log(0.0f, a), std::log(1.17549435e-38f), 1.0e-4f);
+            expectEquals(FastMath::log(1.0f, a), 0.0f);
+        }
+        expectWithinAbsoluteError(FastMath::dbToGain(-6.0f), 0.501187f, 1.0e-6f);
+        expectWithinAbsoluteError(FastMath::gainToDb(0.5f), -6.0206f, 1.0e-4f);
+    }
+
+    void testNoAllocation() {
+        std::vector<float> x(509), y(509), z(509);
+        for (size_t i = 0; i < x.size(); ++i)
+            x[i] = (float) i * 0.01f - 2.0f;
+
+        AllocationTracker::ScopedAllocationCheck check;
+        for (auto a : { FastMath::Accuracy::Coarse, FastMath::Accuracy::Medium, FastMath::Accuracy::Fine }) {
+            FastMath::tanh(x.data(), y.data(), (int) x.size(), a);
+            FastMath::exp(x.data(), y.data(), (int) x.size(), a);
+            FastMath::pow2(x.data(), y.data(), (int) x.size(), a);
+            FastMath::log(y.data(), y.data(), (int) x.size(), a);
+            FastMath::sincos(x.data(), y.data(), z.data(), (int) x.size(), a);
+        }
+        expectEquals((int) check.getCount(), 0);
+    }
+};
+
+// Register the test
+static FastMathTest fastMathTest;
@@ -0,0 +1,159 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/FreeverbCore.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks the shared Freeverb tank against Jezar's one-object-per-filter form
+ * (as the plate, shimmer and gated reverbs used to run it): same output for
+ * both stereo spreads in use, across sample rates and parameter changes, and
+ * processing never allocates.
+ */
+class FreeverbCoreTest : public juce::UnitTest {
+public:
+    FreeverbCoreTest() : UnitTest("Freeverb Core Test", "RealTime") {}
+
+    void runTest() override {
+        for (double sampleRate : { 44100.0, 48000.0, 96000.0 }) {
+            for (int spread : { 23, 89 }) {
+                beginTest("Matches the reference at " + juce::String(sampleRate / 1000.0, 1)
+                          + " kHz, spread " + juce::String(spread));
+                testAgainstReference(sampleRate, spread);
+            }
+        }
+
+        beginTest("Reset clears the tail");
+        testReset();
+
+        beginTest("Processing does not allocate");
+        testNoAllocation();
+    }
+
+private:
+    static constexpr int kNumSamples = 48000;
+
+    // Freeverb's filters, one buffer each
+    struct Comb {
+        std::vector<float> buffer;
+        int index = 0;
+        float filterStore = 0.0f;
+
+        float process(float input, float feedback, float damp) {
+            const float output = buffer[(size_t) index];
+            filterStore = output * (1.0f - damp) + filterStore * damp;
+            buffer[(size_t) index] = input + filterStore * feedback;
+            if (++index >= (int) buffer.size()) index = 0;
+            return output;
+        }
+    };
+
+    struct Allpass {
+        std::vector<float> buffer;
+        int index = 0;
+
+        float process(float input, float feedback) {
+            const float bufout = buffer[(size_t) index];
+            buffer[(size_t) index] = input + bufout * feedback;
+            if (++index >= (int) buffer.size()) index = 0;
+            return bufout - input;
+        }
+    };
+
+    struct Reference {
+        Comb combs[2][FreeverbCore::NUM_COMBS];
+        Allpass allpasses[2][FreeverbCore::NUM_ALLPASSES];
+
+        Reference(double sampleRate, int spread) {
+            const float srScale = static_cast<float>(sampleRate / 44100.0);
+            for (int ch = 0; ch < 2; ++ch) {
+                for (int i = 0; i < FreeverbCore::NUM_COMBS; ++i)
+                    combs[ch][i].buffer.resize((size_t) static_cast<int>((FreeverbCore::COMB_TUNING[i] + ch * spread) * srScale));
+                for (int i = 0; i < FreeverbCore::NUM_ALLPASSES; ++i)
+                    allpasses[ch][i].buffer.resize((size_t) static_cast<int>((FreeverbCore::ALLPASS_TUNING[i] + ch * spread) * srScale));
+            }
+        }
+
+        float process(int ch, float input, float feedback, float damp, float allpassFeedback) {
+            float out = 0.0f;
+            for (auto& comb : combs[ch]) out += comb.process(input, feedback, damp);
+            for (auto& allpass : allpasses[ch]) out = allpass.process(out, allpassFeedback);
+            return out;
+        }
+    };
+
+    static std::vector<float> burst(int length, juce::Random& random) {
+        std::vector<float> x((size_t) length, 0.0f);
+        for (int i = 0; i < length / 8; ++i)
+            x[(size_t) i] = random.nextFloat() * 2.0f - 1.0f;
+        return x;
+    }
+
+    void testAgainstReference(double sampleRate, int spread) {
+        juce::Random random(spread);
+        const auto inL = burst(kNumSamples, random), inR = burst(kNumSamples, random);
+
+        FreeverbCore core;
+        core.prepare(sampleRate, spread);
+        Reference reference(sampleRate, spread);
+
+        // Room size, damping and diffusion change halfway, as automation would
+        float feedback = 0.84f, damp = 0.2f, allpassFeedback = 0.5f;
+        double maxError = 0.0, peak = 0.0;
+        for (int i = 0; i < kNumSamples; ++i) {
+            if (i == kNumSamples / 2) {
+                feedback = 0.98f;
+                damp = 0.05f;
+                allpassFeedback = 0.7f;
+            }
+            core.setCombFeedback(feedback);
+            core.setDamping(damp);
+            core.setAllpassFeedback(allpassFeedback);
+
+            float outL, outR;
+            core.processSample(inL[(size_t) i], inR[(size_t) i], outL, outR);
+            const float refL = reference.process(0, inL[(size_t) i], feedback, damp, allpassFeedback);
+            const float refR = reference.process(1, inR[(size_t) i], feedback, damp, allpassFeedback);
+            maxError = std::max({ maxError, (double) std::abs(outL - refL), (double) std::abs(outR - refR) });
+            peak = std::max({ peak, (double) std::abs(refL), (double) std::abs(refR) });
+        }
+
+        // Only the order the combs are summed in differs
+        expect(peak > 1.0, "Reference tank stayed silent");
+        expect(maxError < 1.0e-5 * peak, "Error " + juce::String(maxError) + " against a peak of " + juce::String(peak));
+    }
+
+    void testReset() {
+        FreeverbCore core;
+        core.prepare(48000.0, 23);
+        core.setCombFeedback(0.9f);
+
+        float outL, outR;
+        for (int i = 0; i < 4000; ++i)
+            core.processSample(i < 100 ? 1.0f : 0.0f, 0.0f, outL, outR);
+        expect(std::abs(outL) > 0.0f, "Tank should be ringing");
+
+        core.reset();
+        float energy = 0.0f;
+        for (int i = 0; i < 8000; ++i) {
+            core.processSample(0.0f, 0.0f, outL, outR);
+            energy += outL * outL + outR * outR;
+        }
+        expectEquals(energy, 0.0f);
+    }
+
+    void testNoAllocation() {
+        FreeverbCore core;
+        core.prepare(48000.0, 89);
+        juce::Random random(3);
+
+        AllocationTracker::ScopedAllocationCheck check;
+        float outL, outR;
+        for (int i = 0; i < kNumSamples; ++i) {
+            core.setDamping(random.nextFloat() * 0.4f);
+            core.processSample(random.nextFloat() - 0.5f, random.nextFloat() - 0.5f, outL, outR);
+        }
+        expectEquals((int) check.getCount(), 0);
+    }
+};
+
+// Register the test
+static FreeverbCoreTest freeverbCoreTest;
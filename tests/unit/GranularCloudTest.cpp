@@ -0,0 +1,122 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/GranularCloud.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks GranularCloud's grain pool: a dense cloud sustains well over the old
+ * 64-grain cap, unpitched grains play the captured input back at its own
+ * pitch, and processing never allocates, whatever the host block size.
+ */
+class GranularCloudTest : public juce::UnitTest {
+public:
+    GranularCloudTest() : UnitTest("Granular Cloud Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Dense clouds sustain hundreds of grains");
+        testDenseCloud();
+
+        beginTest("Unpitched grains keep the input's pitch");
+        testUnpitchedGrains();
+
+        beginTest("Processing does not allocate");
+        testNoAllocation();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kBlockSize = 512;
+
+    using Param = GranularCloud::ParamID;
+
+    static void setParameters(GranularCloud& cloud, float size, float density, float scatter) {
+        cloud.updateParameters({ { (int) Param::GrainSize, size },
+                                 { (int) Param::Density, density },
+                                 { (int) Param::PitchScatter, scatter },
+                                 { (int) Param::CloudPosition, 0.5f },
+                                 { (int) Param::Mix, 1.0f } });
+    }
+
+    // Mono input on both channels, block by block; returns the left output
+    template <typename Signal>
+    static std::vector<float> run(GranularCloud& cloud, int numSamples, Signal&& signal,
+                                  int* peakGrains = nullptr) {
+        std::vector<float> output((size_t) numSamples);
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        for (int start = 0; start + kBlockSize <= numSamples; start += kBlockSize) {
+            for (int i = 0; i < kBlockSize; ++i) {
+                const float x = signal(start + i);
+                buffer.setSample(0, i, x);
+                buffer.setSample(1, i, x);
+            }
+            cloud.process(buffer);
+            std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + kBlockSize, output.begin() + start);
+            if (peakGrains != nullptr)
+                *peakGrains = std::max(*peakGrains, cloud.getActiveGrainCount());
+        }
+        return output;
+    }
+
+    void testDenseCloud() {
+        GranularCloud cloud;
+        cloud.prepareToPlay(kSampleRate, kBlockSize);
+        setParameters(cloud, 1.0f, 1.0f, 0.5f);  // 300 ms grains at 200 a second
+
+        juce::Random random(1);
+        int peakGrains = 0;
+        const auto output = run(cloud, (int) kSampleRate * 3,
+                                [&] (int) { return random.nextFloat() - 0.5f; }, &peakGrains);
+
+        expect(peakGrains > 64, "Peak of " + juce::String(peakGrains) + " grains");
+
+        bool finite = true;
+        for (float sample : output)
+            finite = finite && std::isfinite(sample) && std::abs(sample) <= 1.5f;
+        expect(finite, "Output is finite and within the output clamp");
+    }
+
+    void testUnpitchedGrains() {
+        GranularCloud cloud;
+        cloud.prepareToPlay(kSampleRate, kBlockSize);
+        setParameters(cloud, 0.5f, 0.3f, 0.0f);
+
+        const double frequency = 1000.0;
+        const auto output = run(cloud, (int) kSampleRate * 3, [&] (int i) {
+            return 0.5f * (float) std::sin(juce::MathConstants<double>::twoPi * frequency * i / kSampleRate);
+        });
+
+        // Overlapping grains at any start point still sum to a 1 kHz tone,
+        // so it crosses zero twice a cycle wherever the cloud is sounding
+        const size_t first = (size_t) kSampleRate;
+        int crossings = 0, audible = 0;
+        for (size_t i = first + 1; i < output.size(); ++i) {
+            if ((output[i - 1] < 0.0f) != (output[i] < 0.0f))
+                ++crossings;
+            if (std::abs(output[i]) > 1.0e-3f)
+                ++audible;
+        }
+        const double seconds = (double) (output.size() - first) / kSampleRate;
+        expect(audible > (int) (output.size() - first) / 2, "Cloud is sounding");
+        expect(std::abs(crossings / seconds - 2.0 * frequency) < 0.05 * 2.0 * frequency,
+               juce::String(crossings / seconds / 2.0, 1) + " Hz");
+    }
+
+    void testNoAllocation() {
+        GranularCloud cloud;
+        cloud.prepareToPlay(kSampleRate, kBlockSize);
+        setParameters(cloud, 1.0f, 1.0f, 1.0f);
+
+        juce::Random random(2);
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        AllocationTracker::ScopedAllocationCheck check;
+        for (int block = 0; block < 400; ++block) {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < kBlockSize; ++i)
+                    buffer.setSample(ch, i, random.nextFloat() - 0.5f);
+            cloud.process(buffer);
+        }
+        expectEquals((int) check.getCount(), 0);
+    }
+};
+
+// Register the test
+static GranularCloudTest granularCloudTest;
@@ -0,0 +1,119 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/MasterOutputStage.h"
+
+/**
+ * Checks the fused master output stage: the soft clip path reproduces the
+ * old gain/std::tanh/limit passes to within FastMath's tanh error, with
+ * matching meters, and the true-peak limiter delays by the latency it reports
+ * and holds inter-sample peaks at its ceiling.
+ */
+class MasterOutputStageTest : public juce::UnitTest {
+public:
+    MasterOutputStageTest() : UnitTest("Master Output Stage Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Soft clip matches the legacy per-sample passes");
+        testSoftClipMatchesLegacy();
+
+        beginTest("Limiter latency matches what it reports");
+        testLimiterLatency();
+
+        beginTest("Limiter holds inter-sample peaks at the ceiling");
+        testTruePeakCeiling();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+
+    void testSoftClipMatchesLegacy() {
+        // Odd length exercises the scalar tail after the vector loop
+        const int numSamples = 509;
+        juce::AudioBuffer<float> buffer(2, numSamples), legacy(2, numSamples);
+        juce::Random random(42);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 1.5f);
+        legacy.makeCopyOf(buffer);
+
+        const auto input = MasterOutputStage::measure(buffer, numSamples);
+        expectWithinAbsoluteError(input.peak, buffer.getMagnitude(0, numSamples), 1.0e-7f);
+
+        MasterOutputStage stage;
+        stage.prepare(kSampleRate, 2);
+        const auto result = stage.process(buffer, numSamples, 0.99f, false);
+
+        legacy.applyGain(0.99f);
+        float peak = 0.0f;
+        double sumSquares = 0.0;
+        float maxError = 0.0f;
+        for (int ch = 0; ch < 2; ++ch) {
+            for (int i = 0; i < numSamples; ++i) {
+                float x = legacy.getSample(ch, i);
+                if (std::abs(x) > 0.98f)
+                    x = std::tanh(x * 0.7f) * 1.3f;
+                x = juce::jlimit(-0.98f, 0.98f, x);
+                maxError = juce::jmax(maxError, std::abs(x - buffer.getSample(ch, i)));
+                peak = juce::jmax(peak, std::abs(x));
+                sumSquares += (double) x * x;
+            }
+        }
+
+        expect(maxError <= 2.0e-6f, "Soft clip output is " + juce::String(maxError) + " from the legacy curve");
+        expectWithinAbsoluteError(result.output.peak, peak, 2.0e-6f);
+        expectWithinAbsoluteError(result.output.rms, (float) std::sqrt(sumSquares / (2.0 * numSamples)), 1.0e-5f);
+        expectEquals(result.minGain, 1.0f);
+    }
+
+    void testLimiterLatency() {
+        MasterOutputStage stage;
+        stage.prepare(kSampleRate, 2);
+        const int latency = stage.getLimiterLatencySamples();
+        expect(latency > 0);
+
+        // Below the ceiling the limiter is a pure delay
+        const int numSamples = 512;
+        juce::AudioBuffer<float> buffer(2, numSamples);
+        buffer.clear();
+        buffer.setSample(0, 100, 0.25f);
+        buffer.setSample(1, 100, -0.25f);
+
+        const auto result = stage.process(buffer, numSamples, 1.0f, true);
+        expectEquals(result.minGain, 1.0f);
+        expectEquals(buffer.getSample(0, 100 + latency), 0.25f);
+        expectEquals(buffer.getSample(1, 100 + latency), -0.25f);
+        expectWithinAbsoluteError(result.output.peak, 0.25f, 1.0e-7f);
+    }
+
+    void testTruePeakCeiling() {
+        MasterOutputStage stage;
+        stage.prepare(kSampleRate, 1);
+
+        // fs/4 at 45 degrees: every sample is 0.707 of the peak, which falls
+        // exactly between samples, so a sample-peak limiter would let the
+        // true peak through 3 dB over
+        const int numSamples = 256, blocks = 40;
+        const float amplitude = 2.0f;
+        const float ceiling = juce::Decibels::decibelsToGain(MasterOutputStage::LIMITER_CEILING_DB);
+        float settledPeak = 0.0f, minGain = 1.0f;
+        int64_t position = 0;
+
+        juce::AudioBuffer<float> buffer(1, numSamples);
+        for (int block = 0; block < blocks; ++block) {
+            for (int i = 0; i < numSamples; ++i, ++position)
+                buffer.setSample(0, i, amplitude * (float) std::sin(juce::MathConstants<double>::halfPi * (double) position
+                                                                      + juce::MathConstants<double>::pi / 4.0));
+            const auto result = stage.process(buffer, numSamples, 1.0f, true);
+            minGain = juce::jmin(minGain, result.minGain);
+            if (block >= blocks / 2)
+                settledPeak = juce::jmax(settledPeak, result.output.peak);
+        }
+
+        const float truePeak = settledPeak * juce::MathConstants<float>::sqrt2;
+        expect(truePeak <= ceiling * 1.02f, "True peak " + juce::String(truePeak) + " over the ceiling");
+        expect(truePeak >= ceiling * 0.9f, "Over-limited to " + juce::String(truePeak));
+        expect(minGain < 0.5f);
+    }
+};
+
+// Register the test
+static MasterOutputStageTest masterOutputStageTest;
@@ -0,0 +1,122 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/MultiVoicePitchShift.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks the harmonizer's shared-analysis pitch shifter: voices land on the
+ * requested pitch, unity reconstructs the input after the reported latency,
+ * silent voices are skipped without changing the rest of the mix, and
+ * processing never touches the heap.
+ */
+class MultiVoicePitchShiftTest : public juce::UnitTest {
+public:
+    MultiVoicePitchShiftTest() : UnitTest("Multi Voice Pitch Shift Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Unity ratio reconstructs the input after the reported latency");
+        testUnityReconstruction();
+
+        beginTest("Each voice lands on its own pitch");
+        testVoicePitches();
+
+        beginTest("Silent voices are skipped without changing the mix");
+        testSilentVoicesSkipped();
+
+        beginTest("Processing does not allocate");
+        testNoAllocation();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kBlockSize = 256;
+    static constexpr int kLength = 1 << 15;
+
+    static std::vector<float> sine(double frequency, float amplitude) {
+        std::vector<float> x((size_t) kLength);
+        for (int i = 0; i < kLength; ++i)
+            x[(size_t) i] = amplitude * (float) std::sin(juce::MathConstants<double>::twoPi * frequency * i / kSampleRate);
+        return x;
+    }
+
+    static std::vector<float> run(MultiVoicePitchShift& shifter, const std::vector<float>& input,
+                                  std::initializer_list<float> ratios, std::initializer_list<float> gains) {
+        std::vector<float> output(input.size());
+        for (size_t start = 0; start < input.size(); start += kBlockSize)
+            shifter.process(input.data() + start, output.data() + start, kBlockSize,
+                            ratios.begin(), gains.begin(), (int) ratios.size());
+        return output;
+    }
+
+    // Single-bin DFT amplitude over a Hann window on the second half
+    static double amplitudeAt(const std::vector<float>& x, double frequency) {
+        double re = 0.0, im = 0.0, windowSum = 0.0;
+        const size_t first = x.size() / 2, n = x.size() - first;
+        for (size_t i = first; i < x.size(); ++i) {
+            const double w = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * (double) (i - first) / (double) n);
+            const double arg = juce::MathConstants<double>::twoPi * frequency * (double) i / kSampleRate;
+            re += w * x[i] * std::cos(arg);
+            im += w * x[i] * std::sin(arg);
+            windowSum += w;
+        }
+        return 2.0 * std::sqrt(re * re + im * im) / windowSum;
+    }
+
+    void testUnityReconstruction() {
+        MultiVoicePitchShift shifter;
+        shifter.prepare(kSampleRate);
+        const int latency = shifter.getLatencySamples();
+        expect(latency > 0);
+
+        const auto input = sine(440.0, 0.5f);
+        const auto output = run(shifter, input, { 1.0f }, { 1.0f });
+
+        float maxError = 0.0f;
+        for (int i = kLength / 2; i < kLength; ++i)
+            maxError = juce::jmax(maxError, std::abs(output[(size_t) i] - input[(size_t) (i - latency)]));
+        expect(maxError < 1.0e-3f, "Reconstruction error " + juce::String(maxError));
+    }
+
+    void testVoicePitches() {
+        MultiVoicePitchShift shifter;
+        shifter.prepare(kSampleRate);
+
+        // Major triad above 220 Hz, each voice at its own level
+        const auto input = sine(220.0, 0.5f);
+        const auto output = run(shifter, input, { 1.25f, 1.5f, 2.0f }, { 1.0f, 0.5f, 0.25f });
+
+        expectWithinAbsoluteError(amplitudeAt(output, 275.0), 0.5, 0.05);
+        expectWithinAbsoluteError(amplitudeAt(output, 330.0), 0.25, 0.025);
+        expectWithinAbsoluteError(amplitudeAt(output, 440.0), 0.125, 0.0125);
+        expect(amplitudeAt(output, 220.0) < 0.01, "Input pitch leaks into the voices");
+    }
+
+    void testSilentVoicesSkipped() {
+        MultiVoicePitchShift a, b;
+        a.prepare(kSampleRate);
+        b.prepare(kSampleRate);
+
+        const auto input = sine(330.0, 0.5f);
+        const auto withSilentVoice = run(a, input, { 1.5f, 0.5f }, { 0.8f, 0.0f });
+        const auto singleVoice = run(b, input, { 1.5f }, { 0.8f });
+        expect(withSilentVoice == singleVoice, "A silent voice changed the output");
+    }
+
+    void testNoAllocation() {
+        MultiVoicePitchShift shifter;
+        shifter.prepare(kSampleRate);
+
+        const auto input = sine(440.0, 0.5f);
+        std::vector<float> output(input.size());
+        const float ratios[] = { 1.25f, 1.5f, 2.0f };
+        const float gains[] = { 1.0f, 0.7f, 0.5f };
+
+        AllocationTracker::ScopedAllocationCheck check;
+        for (size_t start = 0; start < input.size(); start += kBlockSize)
+            shifter.process(input.data() + start, output.data() + start, kBlockSize, ratios, gains, 3);
+        shifter.reset();
+        expectEquals((int) check.getCount(), 0);
+    }
+};
+
+// Register the test
+static MultiVoicePitchShiftTest multiVoicePitchShiftTest;
@@ -0,0 +1,128 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/EngineBase.h"
+#include "../../JUCE_Plugin/Source/PluginProcessor.h"
+#include "../../JUCE_Plugin/Source/EngineTypes.h"
+
+/**
+ * Covers EngineBase::ParameterSnapshot delivery: dirty-bit iteration and the
+ * compatibility path that forwards snapshots to map-based engines only when
+ * something changed, and the processor resending every parameter after the
+ * engines are re-prepared or a state is restored.
+ */
+class ParameterSnapshotTest : public juce::UnitTest {
+public:
+    ParameterSnapshotTest() : UnitTest("Parameter Snapshot Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("forEachDirty visits exactly the dirty parameters");
+        testForEachDirty();
+
+        beginTest("Legacy engines receive the full set only when something changed");
+        testLegacyShim();
+
+        beginTest("Processor resends parameters after re-prepare and state restore");
+        testResendAfterPrepare();
+    }
+
+private:
+    using Snapshot = EngineBase::ParameterSnapshot;
+
+    // Not-yet-migrated engine: only implements the map-based API
+    class LegacyEngine : public EngineBase {
+    public:
+        void prepareToPlay(double, int) override {}
+        void process(juce::AudioBuffer<float>&) override {}
+        void reset() override {}
+        void updateParameters(const std::map<int, float>& params) override {
+            ++calls;
+            lastParams = params;
+        }
+        juce::String getName() const override { return "Legacy"; }
+        int getNumParameters() const override { return Snapshot::NUM_PARAMS; }
+        juce::String getParameterName(int) const override { return {}; }
+
+        int calls = 0;
+        std::map<int, float> lastParams;
+    };
+
+    void testForEachDirty() {
+        Snapshot snapshot;
+        snapshot.dirtyMask = (1u << 0) | (1u << 7) | (1u << 14);
+        for (int i = 0; i < Snapshot::NUM_PARAMS; ++i)
+            snapshot.values[(size_t) i] = i * 0.05f;
+
+        juce::Array<int> visited;
+        snapshot.forEachDirty([&](int index, float value) {
+            visited.add(index);
+            expectWithinAbsoluteError(value, index * 0.05f, 1.0e-6f);
+        });
+        expect(visited == juce::Array<int>({ 0, 7, 14 }));
+
+        snapshot.dirtyMask = 0;
+        int count = 0;
+        snapshot.forEachDirty([&](int, float) { ++count; });
+        expectEquals(count, 0);
+
+        snapshot.dirtyMask = Snapshot::ALL_DIRTY;
+        snapshot.forEachDirty([&](int, float) { ++count; });
+        expectEquals(count, Snapshot::NUM_PARAMS);
+    }
+
+    void testLegacyShim() {
+        LegacyEngine engine;
+        Snapshot snapshot;
+        snapshot.values.fill(0.25f);
+
+        // Knob-idle block: nothing delivered
+        engine.updateParameterSnapshot(snapshot);
+        expectEquals(engine.calls, 0);
+
+        // One change still forwards every key, as the old per-block map did
+        snapshot.values[3] = 0.9f;
+        snapshot.dirtyMask = 1u << 3;
+        engine.updateParameterSnapshot(snapshot);
+        expectEquals(engine.calls, 1);
+        expectEquals(static_cast<int>(engine.lastParams.size()), Snapshot::NUM_PARAMS);
+        expectWithinAbsoluteError(engine.lastParams[3], 0.9f, 1.0e-6f);
+        expectWithinAbsoluteError(engine.lastParams[0], 0.25f, 1.0e-6f);
+    }
+
+    static void runBlocks(ChimeraAudioProcessor& processor, int numBlocks) {
+        constexpr int blockSize = 256;
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        for (int b = 0; b < numBlocks; ++b) {
+            // Signal keeps the slot awake, so its parameters are delivered
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), 0.25f, blockSize);
+            processor.processBlock(buffer, midi);
+        }
+    }
+
+    void testResendAfterPrepare() {
+        ChimeraAudioProcessor processor;
+        processor.prepareToPlay(48000.0, 256);
+        processor.setSlotEngine(0, ENGINE_GAIN_UTILITY);
+        runBlocks(processor, 100);
+
+        // Knobs idle: nothing more is delivered
+        const auto settled = processor.getSlotParameterVersion(0);
+        expect(settled > 0, "The new engine should have received its parameters");
+        runBlocks(processor, 10);
+        expectEquals(processor.getSlotParameterVersion(0), settled);
+
+        // Same engine, re-prepared: every parameter goes out again, once
+        processor.prepareToPlay(48000.0, 256);
+        runBlocks(processor, 10);
+        expectEquals(processor.getSlotParameterVersion(0), settled + 1);
+
+        juce::MemoryBlock state;
+        processor.getStateInformation(state);
+        processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        runBlocks(processor, 10);
+        expectEquals(processor.getSlotParameterVersion(0), settled + 2);
+    }
+};
+
+// Register the test
+static ParameterSnapshotTest parameterSnapshotTest;
@@ -0,0 +1,201 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/NonUniformPartitionedConvolution.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks the convolution reverb's engine: the non-uniform partitioned output
+ * matches direct convolution (delayed by the reported latency) for IRs that
+ * end in the head, the middle level and the tail, whatever the host block
+ * size, swapping IRs on the audio thread crossfades to the new one with its
+ * full tail, and processing never allocates.
+ */
+class PartitionedConvolutionTest : public juce::UnitTest {
+public:
+    PartitionedConvolutionTest() : UnitTest("Partitioned Convolution Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Matches direct convolution");
+        for (int irLength : { 100, 2048, 5000, 40000 })
+            testAgainstDirectConvolution(irLength);
+
+        beginTest("Complex multiply-accumulate");
+        testComplexMultiplyAccumulate();
+
+        beginTest("Processing does not allocate");
+        testNoAllocation();
+
+        beginTest("Swapping IRs crossfades without allocating");
+        testCrossfade();
+    }
+
+private:
+    static constexpr int kNumSamples = 60000;
+
+    static std::vector<float> noise(int length, juce::Random& random, float decayTime = 0.0f) {
+        std::vector<float> x((size_t) length);
+        for (int i = 0; i < length; ++i) {
+            const float envelope = decayTime > 0.0f ? std::exp(-(float) i / decayTime) : 1.0f;
+            x[(size_t) i] = (random.nextFloat() * 2.0f - 1.0f) * envelope;
+        }
+        return x;
+    }
+
+    // Stereo IR with an exponential decay; channels are also returned separately
+    static juce::AudioBuffer<float> decayingNoise(int length, juce::Random& random, std::vector<float> (&channels)[2]) {
+        juce::AudioBuffer<float> ir(2, length);
+        for (int ch = 0; ch < 2; ++ch) {
+            channels[ch] = noise(length, random, (float) length / 3.0f);
+            std::copy(channels[ch].begin(), channels[ch].end(), ir.getWritePointer(ch));
+        }
+        return ir;
+    }
+
+    // Largest difference from direct convolution, delayed by latency, over [from, to)
+    static double maxErrorAgainstDirect(const std::vector<float> (&ir)[2], const std::vector<float> (&input)[2],
+                                        const std::vector<float> (&output)[2], int from, int to) {
+        const int latency = NonUniformPartitionedConvolution::HEAD_PARTITION_SIZE;
+        double maxError = 0.0;
+        for (int t = std::max(from, latency); t < to; t += 31) {
+            const int m = t - latency;
+            for (int ch = 0; ch < 2; ++ch) {
+                double expected = 0.0;
+                for (int k = 0; k < (int) ir[ch].size() && k <= m; ++k)
+                    expected += (double) ir[ch][(size_t) k] * input[ch][(size_t) (m - k)];
+                maxError = std::max(maxError, std::abs(expected - output[ch][(size_t) t]));
+            }
+        }
+        return maxError;
+    }
+
+    void testAgainstDirectConvolution(int irLength) {
+        juce::Random random(irLength);
+        std::vector<float> irChannels[2], input[2], output[2];
+        const auto ir = decayingNoise(irLength, random, irChannels);
+        for (int ch = 0; ch < 2; ++ch) {
+            input[ch] = noise(kNumSamples, random);
+            output[ch].resize((size_t) kNumSamples);
+        }
+
+        NonUniformPartitionedConvolution convolution;
+        convolution.prepare(48000.0, 512, 2);
+        convolution.loadImpulseResponse(ir);
+        expect(convolution.isReady());
+
+        // Irregular host blocks, processed in place
+        juce::AudioBuffer<float> block(2, 700);
+        for (int start = 0; start < kNumSamples;) {
+            const int n = std::min(kNumSamples - start, 1 + random.nextInt(700));
+            block.setSize(2, n, false, false, true);
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy(input[ch].begin() + start, input[ch].begin() + start + n, block.getWritePointer(ch));
+            convolution.processBlock(block);
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy(block.getReadPointer(ch), block.getReadPointer(ch) + n, output[ch].begin() + start);
+            start += n;
+        }
+
+        const double maxError = maxErrorAgainstDirect(irChannels, input, output, convolution.getLatency(), kNumSamples);
+        expect(maxError < 1.0e-3, "IR of " + juce::String(irLength) + " samples: error " + juce::String(maxError));
+
+        const auto stats = convolution.getTailStats();
+        expect(stats.missedDeadlines <= stats.jobs);
+        expect((irLength > 2048) == (stats.jobs > 0), "Background jobs only for IRs past the head");
+    }
+
+    void testComplexMultiplyAccumulate() {
+        juce::Random random(5);
+        const size_t count = 36;
+        auto aRe = noise((int) count, random), aIm = noise((int) count, random);
+        auto bRe = noise((int) count, random), bIm = noise((int) count, random);
+        auto re = noise((int) count, random), im = noise((int) count, random);
+        const auto re0 = re, im0 = im;
+
+        OptimizedConvolutionSegment::complexMultiplyAccumulate(re.data(), im.data(), aRe.data(), aIm.data(),
+                                                               bRe.data(), bIm.data(), count);
+        float maxError = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            const auto expected = std::complex<float>(re0[i], im0[i])
+                                + std::complex<float>(aRe[i], aIm[i]) * std::complex<float>(bRe[i], bIm[i]);
+            maxError = std::max({ maxError, std::abs(expected.real() - re[i]), std::abs(expected.imag() - im[i]) });
+        }
+        expect(maxError < 1.0e-6f);
+    }
+
+    void testNoAllocation() {
+        juce::Random random(9);
+        juce::AudioBuffer<float> ir(2, 48000);
+        for (int ch = 0; ch < 2; ++ch) {
+            const auto data = noise(48000, random, 16000.0f);
+            std::copy(data.begin(), data.end(), ir.getWritePointer(ch));
+        }
+
+        NonUniformPartitionedConvolution convolution;
+        convolution.prepare(48000.0, 256, 2);
+        convolution.loadImpulseResponse(ir);
+
+        juce::AudioBuffer<float> block(2, 256);
+        AllocationTracker::ScopedAllocationCheck check;
+        for (int i = 0; i < 400; ++i) {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int s = 0; s < 256; ++s)
+                    block.setSample(ch, s, random.nextFloat() - 0.5f);
+            convolution.processBlock(block);
+        }
+        expectEquals((int) check.getCount(), 0);
+    }
+
+    // Before the swap the output is the old IR's; once every level has faded
+    // it is exactly the new IR's, tail included, as both share one input history
+    void testCrossfade() {
+        juce::Random random(11);
+        std::vector<float> oldChannels[2], newChannels[2], input[2], output[2];
+        const auto oldIR = decayingNoise(20000, random, oldChannels);
+        const auto newIR = std::make_shared<const PartitionedImpulseResponse>(decayingNoise(30000, random, newChannels), 2);
+        for (int ch = 0; ch < 2; ++ch) {
+            input[ch] = noise(kNumSamples, random);
+            output[ch].resize((size_t) kNumSamples);
+        }
+
+        NonUniformPartitionedConvolution convolution;
+        convolution.prepare(48000.0, 256, 2, 30000);
+        convolution.loadImpulseResponse(oldIR);
+
+        const int swapAt = 10240;
+        const int numSamples = kNumSamples - kNumSamples % 256;
+        juce::AudioBuffer<float> block(2, 256);
+        bool fadeEnded = false;
+        {
+            AllocationTracker::ScopedAllocationCheck check;
+            for (int start = 0; start < numSamples; start += 256) {
+                if (start == swapAt) {
+                    auto ir = newIR;
+                    convolution.setImpulseResponse(std::move(ir));
+                    expect(convolution.isCrossfading());
+                }
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int s = 0; s < 256; ++s)
+                        block.setSample(ch, s, input[ch][(size_t) (start + s)]);
+                convolution.processBlock(block);
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int s = 0; s < 256; ++s)
+                        output[ch][(size_t) (start + s)] = block.getSample(ch, s);
+            }
+            fadeEnded = !convolution.isCrossfading();
+            expectEquals((int) check.getCount(), 0);
+        }
+        expect(fadeEnded, "Crossfade never finished");
+
+        const int latency = convolution.getLatency();
+        const double before = maxErrorAgainstDirect(oldChannels, input, output, 0, swapAt + latency);
+        expect(before < 1.0e-3, "Old IR before the swap: error " + juce::String(before));
+
+        // The 8192-sample level is the last to fade: it starts with the
+        // output of the first frame issued after the swap
+        const int fadeEnd = (swapAt / 8192 + 2) * 8192 + NonUniformPartitionedConvolution::CROSSFADE_LENGTH;
+        const double after = maxErrorAgainstDirect(newChannels, input, output, fadeEnd + latency, numSamples);
+        expect(after < 1.0e-3, "New IR after the crossfade: error " + juce::String(after));
+    }
+};
+
+// Register the test
+static PartitionedConvolutionTest partitionedConvolutionTest;
@@ -0,0 +1,83 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/PluginProcessor.h"
+#include "../../JUCE_Plugin/Source/PerformanceTelemetry.h"
+#include "../../JUCE_Plugin/Source/EngineTypes.h"
+
+/**
+ * Checks the rolling cost statistics and that the processor's telemetry
+ * snapshot attributes time to the slots that actually ran.
+ */
+class PerformanceTelemetryTest : public juce::UnitTest {
+public:
+    PerformanceTelemetryTest() : UnitTest("Performance Telemetry Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Rolling window mean, p99 and max");
+        testRollingStats();
+
+        beginTest("Processor snapshot reports active slots");
+        testProcessorSnapshot();
+    }
+
+private:
+    void testRollingStats() {
+        RollingCostStats stats;
+        stats.reset();
+
+        for (int i = 0; i < RollingCostStats::WINDOW; ++i)
+            stats.push(1000);
+        expectWithinAbsoluteError(stats.getMeanNs(), 1000.0, 1.0e-9);
+        expectEquals(static_cast<int>(stats.getMaxNs()), 1000);
+
+        // Three outliers in 512 blocks sit above the 99th percentile...
+        for (int i = 0; i < 3; ++i)
+            stats.push(100000);
+        expectEquals(static_cast<int>(stats.getMaxNs()), 100000);
+        expect(stats.getPercentileNs(99.0) < 1300, "p99 should ignore three outliers");
+
+        // ...eight do not
+        for (int i = 0; i < 5; ++i)
+            stats.push(100000);
+        expect(stats.getPercentileNs(99.0) > 80000, "p99 should include eight outliers");
+
+        // Outliers leave the window and take the max with them
+        for (int i = 0; i < RollingCostStats::WINDOW; ++i)
+            stats.push(2000);
+        expectEquals(static_cast<int>(stats.getMaxNs()), 2000);
+        expectEquals(static_cast<int>(stats.getPercentileNs(99.0)), 2000);
+    }
+
+    void testProcessorSnapshot() {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 256;
+
+        ChimeraAudioProcessor processor;
+        processor.prepareToPlay(sampleRate, blockSize);
+        processor.setSlotEngine(0, ENGINE_GAIN_UTILITY);
+        processor.setSlotEngine(2, ENGINE_MID_SIDE_PROCESSOR);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        for (int b = 0; b < 200; ++b) {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(ch, i, 0.1f * std::sin(0.01f * static_cast<float>(b * blockSize + i)));
+            processor.processBlock(buffer, midi);
+        }
+
+        const auto snapshot = processor.getTelemetry();
+        expect(snapshot.blockCount > 0, "No snapshot was published");
+        expect(snapshot.slots[0].active && snapshot.slots[2].active, "Loaded slots should be active");
+        expect(!snapshot.slots[1].active && !snapshot.slots[3].active, "Empty slots should be idle");
+        expect(snapshot.slots[0].meanMs > 0.0f);
+        expect(snapshot.slots[0].maxMs >= snapshot.slots[0].meanMs);
+        expect(snapshot.chainMeanLoad > 0.0f);
+        expect(snapshot.chainRecentLoad > 0.0f);
+        expectWithinAbsoluteError(snapshot.blockDeadlineMs, 1000.0f * blockSize / static_cast<float>(sampleRate), 1.0e-3f);
+        expect(processor.getCpuUsage() > 0.0f);
+        expect(snapshot.toString().contains("Slot 1"));
+    }
+};
+
+// Register the test
+static PerformanceTelemetryTest performanceTelemetryTest;
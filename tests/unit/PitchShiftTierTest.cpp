@@ -0,0 +1,218 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/PitchShiftTiers.h"
+#include "../../JUCE_Plugin/Source/PsolaPitchShift.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks the pitch shift quality tiers: each quality level gets the intended
+ * algorithm, every algorithm delays by exactly the latency it reports, the
+ * live tier stays under 10 ms and lands on the requested pitch, switching
+ * tiers on the audio thread never allocates, and a switch crossfades instead
+ * of dropping out while the new algorithm fills.
+ */
+class PitchShiftTierTest : public juce::UnitTest {
+public:
+    PitchShiftTierTest() : UnitTest("Pitch Shift Tier Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Quality tiers map to algorithms");
+        testTierMapping();
+
+        beginTest("Reported latency matches the measured delay");
+        for (auto algorithm : { Algorithm::PSOLA, Algorithm::PhaseVocoder, Algorithm::Signalsmith })
+            testLatency(algorithm);
+
+        beginTest("PSOLA latency is single-digit milliseconds");
+        for (double sampleRate : { 44100.0, 48000.0, 96000.0 }) {
+            PsolaPitchShift shifter;
+            shifter.prepare(sampleRate, kBlockSize);
+            expect(shifter.getLatencySamples() < sampleRate * 0.01,
+                   juce::String(shifter.getLatencySamples()) + " samples at " + juce::String(sampleRate));
+        }
+
+        beginTest("PSOLA lands on the requested pitch");
+        for (float ratio : { 0.75f, 1.25f, 1.5f, 2.0f })
+            testPsolaPitch(ratio);
+
+        beginTest("Switching tiers does not allocate");
+        testSwitchingDoesNotAllocate();
+
+        beginTest("Switching tiers crossfades without a gap");
+        testSwitchHasNoGap();
+    }
+
+private:
+    using Algorithm = PitchShiftFactory::Algorithm;
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kBlockSize = 256;
+
+    static std::vector<float> run(IPitchShiftStrategy& shifter, const std::vector<float>& input, float ratio) {
+        std::vector<float> output(input.size());
+        for (size_t start = 0; start + kBlockSize <= input.size(); start += kBlockSize)
+            shifter.process(input.data() + start, output.data() + start, kBlockSize, ratio);
+        return output;
+    }
+
+    // Band-limited pulse train: every harmonic at the same level, so PSOLA's
+    // formant preservation leaves the new fundamental as strong as the old
+    static std::vector<float> pulseTrain(double frequency, int length) {
+        std::vector<float> x((size_t) length, 0.0f);
+        for (int h = 1; h * frequency < 6000.0; ++h)
+            for (int i = 0; i < length; ++i)
+                x[(size_t) i] += 0.1f * (float) std::cos(juce::MathConstants<double>::twoPi * h * frequency * i / kSampleRate);
+        return x;
+    }
+
+    // Single-bin DFT amplitude over a Hann window on the second half
+    static double amplitudeAt(const std::vector<float>& x, double frequency) {
+        double re = 0.0, im = 0.0, windowSum = 0.0;
+        const size_t first = x.size() / 2, n = x.size() - first;
+        for (size_t i = first; i < x.size(); ++i) {
+            const double w = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * (double) (i - first) / (double) n);
+            const double arg = juce::MathConstants<double>::twoPi * frequency * (double) i / kSampleRate;
+            re += w * x[i] * std::cos(arg);
+            im += w * x[i] * std::sin(arg);
+            windowSum += w;
+        }
+        return 2.0 * std::sqrt(re * re + im * im) / windowSum;
+    }
+
+    void testTierMapping() {
+        expect(PitchShiftFactory::forQuality(0) == Algorithm::PSOLA);
+        expect(PitchShiftFactory::forQuality(1) == Algorithm::PhaseVocoder);
+        expect(PitchShiftFactory::forQuality(2) == Algorithm::PhaseVocoder);
+        expect(PitchShiftFactory::forQuality(3) == Algorithm::Signalsmith);
+
+        // Cost and latency both rise with the tier
+        int previousCost = 0, previousLatency = 0;
+        for (auto algorithm : { Algorithm::PSOLA, Algorithm::PhaseVocoder, Algorithm::Signalsmith }) {
+            expect(PitchShiftFactory::isAvailable(algorithm));
+            auto shifter = PitchShiftFactory::create(algorithm);
+            shifter->prepare(kSampleRate, kBlockSize);
+            expect(shifter->getCpuUsage() > previousCost, shifter->getName());
+            expect(shifter->getLatencySamples() > previousLatency, shifter->getName());
+            previousCost = shifter->getCpuUsage();
+            previousLatency = shifter->getLatencySamples();
+        }
+    }
+
+    // At unity every tier should be a delay of exactly getLatencySamples():
+    // the cross-correlation with the input peaks there
+    void testLatency(Algorithm algorithm) {
+        auto shifter = PitchShiftFactory::create(algorithm);
+        shifter->prepare(kSampleRate, kBlockSize);
+        const int latency = shifter->getLatencySamples();
+
+        const int length = 1 << 16;
+        std::vector<float> input((size_t) length);
+        juce::Random random(7);
+        for (auto& x : input)
+            x = random.nextFloat() * 2.0f - 1.0f;
+        const auto output = run(*shifter, input, 1.0f);
+
+        int bestLag = -1;
+        double bestCorrelation = 0.0;
+        const int maxLag = latency + 4096;
+        for (int lag = 0; lag <= maxLag; ++lag) {
+            double correlation = 0.0;
+            for (int i = length / 2; i < length - kBlockSize; i += 3)
+                correlation += (double) output[(size_t) i] * input[(size_t) (i - lag)];
+            if (correlation > bestCorrelation) {
+                bestCorrelation = correlation;
+                bestLag = lag;
+            }
+        }
+        expectEquals(bestLag, latency, shifter->getName());
+    }
+
+    void testPsolaPitch(float ratio) {
+        PsolaPitchShift shifter;
+        shifter.prepare(kSampleRate, kBlockSize);
+
+        const double f0 = 220.0;
+        const auto input = pulseTrain(f0, 1 << 15);
+        const auto output = run(shifter, input, ratio);
+
+        // Each harmonic of the input is 0.1; below unity the gaps between
+        // grains cost a little level
+        const double shifted = amplitudeAt(output, f0 * ratio);
+        expect(shifted > 0.05, "Fundamental at " + juce::String(f0 * ratio) + " Hz is " + juce::String(shifted));
+        expect(amplitudeAt(output, f0) < shifted * 0.25, "Input pitch leaks through at ratio " + juce::String(ratio));
+    }
+
+    void testSwitchingDoesNotAllocate() {
+        PitchShiftTiers tiers;
+        tiers.prepare(kSampleRate, kBlockSize);
+        const int ultraLatency = tiers.getLatencySamples();
+
+        const auto input = pulseTrain(180.0, kBlockSize * 64);
+        std::vector<float> output(input.size());
+
+        // Ultra -> High and Normal -> Draft change algorithm; High and
+        // Normal share the phase vocoder
+        const bool expectedChange[] = { false, true, false, true };
+        std::array<int, 4> latencies{};
+        bool switched = true;
+
+        AllocationTracker::ScopedAllocationCheck check;
+        for (int block = 0; block < 64; ++block) {
+            const int tier = 3 - block / 16;
+            const bool changed = tiers.setQuality(tier);
+            switched = switched && changed == (block % 16 == 0 && expectedChange[block / 16]);
+            latencies[(size_t) tier] = tiers.getLatencySamples();
+            tiers.process(input.data() + block * kBlockSize, output.data() + block * kBlockSize, kBlockSize, 1.5f);
+        }
+        expectEquals((int) check.getCount(), 0);
+
+        expect(switched, "setQuality() did not report the algorithm changes");
+        expectEquals(latencies[3], ultraLatency);
+        expect(latencies[0] < latencies[1] && latencies[1] == latencies[2] && latencies[2] < latencies[3]);
+        expect(!tiers.setQuality(0), "Same tier twice reported a change");
+        expect(!tiers.setQuality(-1), "Out-of-range tiers clamp");
+    }
+
+    // A freshly reset algorithm is silent for its latency; the outgoing one
+    // has to cover that and then fade out, so no block of noise goes quiet
+    void testSwitchHasNoGap() {
+        PitchShiftTiers tiers;
+        tiers.prepare(kSampleRate, kBlockSize);
+
+        const int numBlocks = 96;
+        std::vector<float> input((size_t) (numBlocks * kBlockSize));
+        juce::Random random(11);
+        for (auto& x : input)
+            x = random.nextFloat() * 2.0f - 1.0f;
+
+        // Past Ultra's latency, then Ultra -> Draft -> High
+        const int switchBlocks[] = { 48, 64 };
+        const int switchTiers[] = { 0, 2 };
+        float quietest = 1.0f;
+        bool faded = true;
+        for (int block = 0; block < numBlocks; ++block) {
+            for (int s = 0; s < 2; ++s) {
+                if (block == switchBlocks[s]) {
+                    tiers.setQuality(switchTiers[s]);
+                    faded = faded && tiers.isSwitching();
+                }
+            }
+
+            float* data = input.data() + block * kBlockSize;
+            tiers.process(data, data, kBlockSize, 1.0f);
+            if (block >= switchBlocks[0]) {
+                double sum = 0.0;
+                for (int i = 0; i < kBlockSize; ++i)
+                    sum += (double) data[i] * data[i];
+                quietest = juce::jmin(quietest, (float) std::sqrt(sum / kBlockSize));
+            }
+        }
+
+        // Uniform noise has an RMS of 0.577; two uncorrelated halves mixed
+        // equally still leave 0.41
+        expect(faded, "setQuality() cut straight over");
+        expect(quietest > 0.3f, "Output dropped to RMS " + juce::String(quietest) + " during a switch");
+        expect(!tiers.isSwitching(), "The crossfade never finished");
+    }
+};
+
+// Register the test
+static PitchShiftTierTest pitchShiftTierTest;
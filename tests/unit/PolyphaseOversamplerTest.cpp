@@ -0,0 +1,107 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/PolyphaseOversampler.h"
+
+/**
+ * Checks the shared oversampler: unity passband, image rejection, that the
+ * reported latency matches the measured delay in both phase modes, and that
+ * quality tiers map onto factors without reallocation.
+ */
+class PolyphaseOversamplerTest : public juce::UnitTest {
+public:
+    PolyphaseOversamplerTest() : UnitTest("Polyphase Oversampler Test", "RealTime") {}
+
+    void runTest() override {
+        using Phase = PolyphaseOversampler::Phase;
+
+        for (auto phase : { Phase::Linear, Phase::Minimum }) {
+            for (int factor : { 2, 4, 8 }) {
+                beginTest(juce::String(phase == Phase::Linear ? "Linear" : "Minimum")
+                          + " phase " + juce::String(factor) + "x");
+                testRoundTrip(phase, factor);
+            }
+        }
+
+        beginTest("Quality tiers select factors up to the prepared maximum");
+        testQualityFactors();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kLength = 1 << 15;
+    static constexpr int kSettle = 4096;
+
+    struct Tone {
+        double amplitude, phase;
+    };
+
+    // Single-bin DFT over a Hann window, from kSettle onwards
+    static Tone measure(const std::vector<float>& x, double frequency, double rate) {
+        double re = 0.0, im = 0.0, windowSum = 0.0;
+        const auto n = x.size() - (size_t) kSettle;
+        for (size_t i = (size_t) kSettle; i < x.size(); ++i) {
+            const double w = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * (double) (i - (size_t) kSettle) / (double) n);
+            const double arg = juce::MathConstants<double>::twoPi * frequency * (double) i / rate;
+            re += w * x[i] * std::cos(arg);
+            im += w * x[i] * std::sin(arg);
+            windowSum += w;
+        }
+        return { 2.0 * std::sqrt(re * re + im * im) / windowSum, std::atan2(re, im) };
+    }
+
+    void testRoundTrip(PolyphaseOversampler::Phase phase, int factor) {
+        PolyphaseOversampler os;
+        os.prepare(1, 64, factor, phase);
+        expectEquals(os.getFactor(), factor);
+
+        const double frequency = 100.0;    // low enough that the phase does not wrap
+        const double image = kSampleRate - 5000.0;
+        std::vector<float> out((size_t) kLength), upImage((size_t) kLength * (size_t) factor);
+        float up[PolyphaseOversampler::MAX_FACTOR];
+
+        for (int i = 0; i < kLength; ++i) {
+            os.upsampleSample(0, (float) std::sin(juce::MathConstants<double>::twoPi * frequency * i / kSampleRate), up);
+            out[(size_t) i] = os.downsampleSample(0, up);
+        }
+
+        // Round trip keeps the level; its delay is what getLatencySamples() says
+        const auto tone = measure(out, frequency, kSampleRate);
+        expectWithinAbsoluteError(tone.amplitude, 1.0, 1.0e-3);
+        const double delay = -tone.phase / (juce::MathConstants<double>::twoPi * frequency / kSampleRate);
+        expectWithinAbsoluteError(delay, (double) os.getLatencySamples(), 0.05);
+
+        // A 5 kHz tone's first image (fs - 5 kHz) must be gone after upsampling
+        os.reset();
+        for (int i = 0; i < kLength; ++i) {
+            os.upsampleSample(0, (float) std::sin(juce::MathConstants<double>::twoPi * 5000.0 * i / kSampleRate), up);
+            std::copy(up, up + factor, upImage.begin() + (ptrdiff_t) i * factor);
+        }
+        const double rate = kSampleRate * factor;
+        const double imageDb = juce::Decibels::gainToDecibels(measure(upImage, image, rate).amplitude, -200.0);
+        expect(imageDb < -85.0, "Image at " + juce::String(imageDb, 1) + " dB");
+    }
+
+    void testQualityFactors() {
+        using Quality = EngineBase::Quality;
+        expectEquals(PolyphaseOversampler::factorForQuality(Quality::Draft, 8), 1);
+        expectEquals(PolyphaseOversampler::factorForQuality(Quality::Normal, 8), 2);
+        expectEquals(PolyphaseOversampler::factorForQuality(Quality::High, 8), 4);
+        expectEquals(PolyphaseOversampler::factorForQuality(Quality::Ultra, 8), 8);
+        expectEquals(PolyphaseOversampler::factorForQuality(Quality::High, 2), 2);
+
+        PolyphaseOversampler os;
+        os.prepare(2, 64, 4, PolyphaseOversampler::Phase::Minimum);
+        os.setFactor(8);
+        expectEquals(os.getFactor(), 4, "Factor is capped at the prepared maximum");
+        os.setFactor(1);
+        expectEquals(os.getFactor(), 1);
+        expectEquals(os.getLatencySamples(), 0.0f);
+
+        // Factor 1 is a straight pass
+        float up[PolyphaseOversampler::MAX_FACTOR];
+        os.upsampleSample(0, 0.25f, up);
+        expectEquals(os.downsampleSample(0, up), 0.25f);
+    }
+};
+
+// Register the test
+static PolyphaseOversamplerTest polyphaseOversamplerTest;
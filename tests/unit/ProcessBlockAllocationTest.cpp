@@ -0,0 +1,126 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/PluginProcessor.h"
+#include "../../JUCE_Plugin/Source/EngineTypes.h"
+#include "AllocationTracker.h"
+
+/**
+ * Guards the real-time contract of ChimeraAudioProcessor::processBlock:
+ * once prepareToPlay has run, the slot pipeline must not touch the heap.
+ * Requires AllocationTracker.cpp to be linked into the test binary.
+ */
+class ProcessBlockAllocationTest : public juce::UnitTest {
+public:
+    ProcessBlockAllocationTest() : UnitTest("ProcessBlock Allocation Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Empty chain does not allocate");
+        testChain({});
+
+        beginTest("Loaded chain does not allocate");
+        testChain({ ENGINE_GAIN_UTILITY, ENGINE_MID_SIDE_PROCESSOR, ENGINE_MONO_MAKER });
+
+        beginTest("Mixed bypass/solo/mix states do not allocate");
+        testSlotStates();
+
+        beginTest("Parallel routing does not allocate");
+        testParallelRouting();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kBlockSize = 64;
+    static constexpr int kWarmupBlocks = 16;
+    static constexpr int kMeasuredBlocks = 256;
+
+    void setParam(ChimeraAudioProcessor& processor, const juce::String& id, float normalisedValue) {
+        if (auto* param = processor.getValueTreeState().getParameter(id))
+            param->setValueNotifyingHost(normalisedValue);
+    }
+
+    void fillWithSine(juce::AudioBuffer<float>& buffer, int blockIndex) {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+            auto* data = buffer.getWritePointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i) {
+                const double t = (blockIndex * buffer.getNumSamples() + i) / kSampleRate;
+                data[i] = 0.25f * static_cast<float>(std::sin(2.0 * juce::MathConstants<double>::pi * 440.0 * t));
+            }
+        }
+    }
+
+    // Runs warmup blocks (engines may lazily size internal state) and then
+    // counts allocations over the measured blocks
+    std::size_t runBlocks(ChimeraAudioProcessor& processor) {
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        juce::MidiBuffer midi;
+
+        for (int b = 0; b < kWarmupBlocks; ++b) {
+            fillWithSine(buffer, b);
+            processor.processBlock(buffer, midi);
+        }
+
+        // Buffers are filled outside the armed region so only processBlock is measured
+        std::size_t allocations = 0;
+        for (int b = 0; b < kMeasuredBlocks; ++b) {
+            fillWithSine(buffer, kWarmupBlocks + b);
+
+            AllocationTracker::ScopedAllocationCheck check;
+            processor.processBlock(buffer, midi);
+            allocations += check.getCount();
+        }
+        return allocations;
+    }
+
+    void testChain(std::initializer_list<int> engineIDs) {
+        ChimeraAudioProcessor processor;
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+
+        int slot = 0;
+        for (int engineID : engineIDs)
+            processor.setSlotEngine(slot++, engineID);
+
+        const auto allocations = runBlocks(processor);
+        expectEquals(static_cast<int>(allocations), 0,
+                     "processBlock allocated " + juce::String(static_cast<int>(allocations))
+                     + " times over " + juce::String(kMeasuredBlocks) + " blocks");
+    }
+
+    void testSlotStates() {
+        ChimeraAudioProcessor processor;
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+
+        processor.setSlotEngine(0, ENGINE_GAIN_UTILITY);
+        processor.setSlotEngine(1, ENGINE_MID_SIDE_PROCESSOR);
+        processor.setSlotEngine(2, ENGINE_MONO_MAKER);
+
+        setParam(processor, "slot1_mix", 0.5f);
+        setParam(processor, "slot2_bypass", 1.0f);
+        setParam(processor, "slot3_solo", 1.0f);
+
+        const auto allocations = runBlocks(processor);
+        expectEquals(static_cast<int>(allocations), 0,
+                     "processBlock allocated with bypass/solo/mix active");
+    }
+
+    // Only the audio thread's own allocations are counted; worker threads run
+    // the same slot code that the serial tests already cover
+    void testParallelRouting() {
+        ChimeraAudioProcessor processor;
+        processor.setParallelProcessingEnabled(true);
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+
+        processor.setSlotEngine(0, ENGINE_GAIN_UTILITY);
+        processor.setSlotEngine(1, ENGINE_MID_SIDE_PROCESSOR);
+        processor.setSlotEngine(2, ENGINE_MONO_MAKER);
+
+        SlotRoutingGraph graph;
+        expect(SlotRoutingGraph::fromString("[0|1@0.5|2@0.5]", graph));
+        expect(processor.setRoutingGraph(graph));
+
+        const auto allocations = runBlocks(processor);
+        expectEquals(static_cast<int>(allocations), 0,
+                     "processBlock allocated with parallel branches");
+    }
+};
+
+// Register the test
+static ProcessBlockAllocationTest processBlockAllocationTest;
@@ -0,0 +1,120 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/RealFFT.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks both real FFT backends against a direct DFT and against each other:
+ * the forward transform gives the non-negative-frequency bins with real DC
+ * and Nyquist, the inverse is scaled so the round trip is the identity, both
+ * run in place over one buffer, and neither allocates once constructed.
+ */
+class RealFFTTest : public juce::UnitTest {
+public:
+    RealFFTTest() : UnitTest("Real FFT Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("signalsmith-linear matches a direct DFT");
+        testAgainstDFT<SignalsmithRealFFT>();
+
+        beginTest("juce::dsp::FFT matches a direct DFT");
+        testAgainstDFT<JuceRealFFT>();
+
+        for (int order : { 7, 10, 13 }) {
+            beginTest("Backends agree and round-trip in place: " + juce::String(1 << order) + " points");
+            testRoundTrip(order);
+        }
+
+        beginTest("Transforms do not allocate");
+        testNoAllocation<SignalsmithRealFFT>();
+        testNoAllocation<JuceRealFFT>();
+    }
+
+private:
+    static std::vector<float> noise(int length, juce::Random& random) {
+        std::vector<float> x((size_t) length);
+        for (auto& sample : x)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+        return x;
+    }
+
+    template <typename FFT>
+    void testAgainstDFT() {
+        constexpr int order = 6, size = 1 << order;
+        juce::Random random(1);
+        const auto input = noise(size, random);
+
+        FFT fft(order);
+        expectEquals(fft.getNumBins(), size / 2 + 1);
+
+        std::vector<std::complex<float>> bins((size_t) fft.getNumBins());
+        fft.forward(input.data(), bins.data());
+
+        float maxError = 0.0f;
+        for (int k = 0; k <= size / 2; ++k) {
+            std::complex<double> expected;
+            for (int n = 0; n < size; ++n)
+                expected += (double) input[(size_t) n]
+                          * std::polar(1.0, -2.0 * juce::MathConstants<double>::pi * k * n / size);
+            maxError = std::max(maxError, (float) std::abs(std::complex<double>(bins[(size_t) k]) - expected));
+        }
+        expect(maxError < 1.0e-4f, "DFT error " + juce::String(maxError));
+        expectEquals(bins[0].imag(), 0.0f);
+        expectEquals(bins[size / 2].imag(), 0.0f);
+    }
+
+    void testRoundTrip(int order) {
+        const int size = 1 << order;
+        juce::Random random(order);
+        const auto input = noise(size, random);
+
+        SignalsmithRealFFT signalsmith(order);
+        JuceRealFFT juceFFT(order);
+
+        // Bins overlay the samples, as StftProcessor and the convolver use them
+        std::vector<float> a(input), b(input);
+        a.resize((size_t) size + 2);
+        b.resize((size_t) size + 2);
+        auto* binsA = reinterpret_cast<std::complex<float>*>(a.data());
+        auto* binsB = reinterpret_cast<std::complex<float>*>(b.data());
+        signalsmith.forward(a.data(), binsA);
+        juceFFT.forward(b.data(), binsB);
+
+        float binError = 0.0f;
+        for (int k = 0; k <= size / 2; ++k)
+            binError = std::max(binError, std::abs(binsA[k] - binsB[k]));
+        expect(binError < 1.0e-3f, "Backends differ by " + juce::String(binError));
+
+        // The inverse ignores whatever sits in the imaginary parts of DC and Nyquist
+        binsA[0].imag(123.0f);
+        binsA[size / 2].imag(-45.0f);
+        signalsmith.inverse(binsA, a.data());
+        juceFFT.inverse(binsB, b.data());
+
+        float errorA = 0.0f, errorB = 0.0f;
+        for (int n = 0; n < size; ++n) {
+            errorA = std::max(errorA, std::abs(a[(size_t) n] - input[(size_t) n]));
+            errorB = std::max(errorB, std::abs(b[(size_t) n] - input[(size_t) n]));
+        }
+        expect(errorA < 1.0e-5f, "signalsmith-linear round trip error " + juce::String(errorA));
+        expect(errorB < 1.0e-5f, "juce::dsp::FFT round trip error " + juce::String(errorB));
+    }
+
+    template <typename FFT>
+    void testNoAllocation() {
+        constexpr int order = 11;
+        juce::Random random(2);
+        FFT fft(order);
+        auto buffer = noise((1 << order) + 2, random);
+        auto* bins = reinterpret_cast<std::complex<float>*>(buffer.data());
+
+        AllocationTracker::ScopedAllocationCheck check;
+        for (int i = 0; i < 100; ++i) {
+            fft.forward(buffer.data(), bins);
+            fft.inverse(bins, buffer.data());
+        }
+        expectEquals((int) check.getCount(), 0);
+    }
+};
+
+// Register the test
+static RealFFTTest realFFTTest;
@@ -0,0 +1,27 @@
+/**
+ * Real-time Safety Test Runner
+ * Runs the juce::UnitTest suites in the "RealTime" category (allocation
+ * guards, lock-free structures) and returns non-zero on any failure.
+ */
+
+#include <JuceHeader.h>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    juce::ignoreUnused(argc, argv);
+    juce::ScopedJuceInitialiser_GUI juce_init;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory("RealTime");
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i) {
+        if (auto* result = runner.getResult(i))
+            failures += result->failures;
+    }
+
+    std::cout << (failures == 0 ? "All real-time tests passed\n"
+                                : "Real-time tests FAILED: " + std::to_string(failures) + " failure(s)\n");
+    return failures == 0 ? 0 : 1;
+}
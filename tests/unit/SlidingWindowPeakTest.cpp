@@ -0,0 +1,88 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/SlidingWindowPeak.h"
+
+/**
+ * Compares the shared lookahead peak detector against a brute-force scan,
+ * including window changes mid-stream and windows up to tens of milliseconds.
+ */
+class SlidingWindowPeakTest : public juce::UnitTest {
+public:
+    SlidingWindowPeakTest() : UnitTest("Sliding Window Peak Test", "RealTime") {}
+
+    void runTest() override {
+        for (int window : { 1, 2, 7, 64, 512, 4800 }) {
+            beginTest("Window of " + juce::String(window) + " samples");
+            testAgainstBruteForce(window);
+        }
+
+        beginTest("Window length changes without a reset");
+        testWindowChanges();
+    }
+
+private:
+    // Deterministic noise with occasional spikes so the maximum moves around
+    static float nextSample(uint32_t& seed) {
+        seed = seed * 1664525u + 1013904223u;
+        const float x = (float) (seed >> 8) / 16777216.0f;
+        return (seed & 0x3ff) == 0 ? 4.0f * x : x;
+    }
+
+    static float bruteForcePeak(const std::vector<float>& history, int window) {
+        float peak = history.back();
+        const int first = juce::jmax(0, (int) history.size() - window);
+        for (int i = first; i < (int) history.size(); ++i)
+            peak = juce::jmax(peak, history[(size_t) i]);
+        return peak;
+    }
+
+    void testAgainstBruteForce(int window) {
+        SlidingWindowPeak peak;
+        peak.prepare(window);
+        expectEquals(peak.getWindowLength(), window);
+
+        std::vector<float> history;
+        uint32_t seed = 12345u;
+        int mismatches = 0;
+        for (int i = 0; i < 20000; ++i) {
+            history.push_back(nextSample(seed));
+            if (peak.process(history.back()) != bruteForcePeak(history, window))
+                ++mismatches;
+        }
+        expectEquals(mismatches, 0);
+    }
+
+    void testWindowChanges() {
+        SlidingWindowPeak peak;
+        peak.prepare(256);
+
+        std::vector<float> history;
+        uint32_t seed = 777u;
+        int mismatches = 0;
+        int window = 256;
+        for (int block = 0; block < 64; ++block) {
+            // Shrinking is exact at once; lengthening can only look back over
+            // samples still queued, so it may read low until the window
+            // refills. Blocks are longer than any window so each ends exact.
+            const int previous = window;
+            window = 1 + (int) (nextSample(seed) * 255.0f) % 256;
+            peak.setWindowLength(window);
+
+            for (int i = 0; i < 300; ++i) {
+                history.push_back(nextSample(seed));
+                const float result = peak.process(history.back());
+                if (window <= previous && result != bruteForcePeak(history, window))
+                    ++mismatches;
+                if (window > previous && result > bruteForcePeak(history, window))
+                    ++mismatches;
+            }
+        }
+        expectEquals(mismatches, 0);
+
+        peak.reset();
+        expectEquals(peak.getPeak(), 0.0f);
+        expectEquals(peak.process(0.5f), 0.5f);
+    }
+};
+
+// Register the test
+static SlidingWindowPeakTest slidingWindowPeakTest;
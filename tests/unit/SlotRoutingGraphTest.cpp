@@ -0,0 +1,130 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/PluginProcessor.h"
+#include "../../JUCE_Plugin/Source/SlotRoutingGraph.h"
+#include "../../JUCE_Plugin/Source/EngineTypes.h"
+
+/**
+ * Covers the slot routing graph: text form, validation, split/merge gain and
+ * that running branches on the worker pool gives the same audio as running
+ * them one after another on the audio thread.
+ */
+class SlotRoutingGraphTest : public juce::UnitTest {
+public:
+    SlotRoutingGraphTest() : UnitTest("Slot Routing Graph Test", "RealTime") {}
+
+    void runTest() override {
+        beginTest("Text form round-trips");
+        testRoundTrip();
+
+        beginTest("Invalid graphs are rejected");
+        testValidation();
+
+        beginTest("Split and merge apply branch gains");
+        testMergeGain();
+
+        beginTest("Worker pool matches single-threaded processing");
+        testParallelMatchesSerial();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr int kBlockSize = 128;
+    static constexpr int kNumBlocks = 32;
+
+    void testRoundTrip() {
+        const juce::String texts[] = { "0>1>2>3>4>5", "0>1>[2,3@0.7|4@0.7|]>5", "[0|1|2|3|4|5]" };
+        for (const auto& text : texts) {
+            SlotRoutingGraph graph, reparsed;
+            expect(SlotRoutingGraph::fromString(text, graph), "Failed to parse " + text);
+            expect(SlotRoutingGraph::fromString(graph.toString(), reparsed), "Failed to reparse " + text);
+            expect(graph == reparsed, "Round trip changed " + text);
+        }
+
+        expect(SlotRoutingGraph::serial() == SlotRoutingGraph::serial(CHIMERA_NUM_SLOTS));
+        expect(!SlotRoutingGraph::serial().hasParallelStages());
+    }
+
+    void testValidation() {
+        SlotRoutingGraph graph;
+        const juce::String invalid[] = { "0>0", "9", "[1|2", "0>x", "[0@abc|1]", "257" };
+        for (const auto& text : invalid)
+            expect(!SlotRoutingGraph::fromString(text, graph), "Accepted " + text);
+
+        ChimeraAudioProcessor processor;
+        SlotRoutingGraph duplicate;
+        auto* stage = duplicate.addParallelStage();
+        SlotRoutingGraph::addBranch(*stage, { 0, 1 });
+        SlotRoutingGraph::addBranch(*stage, { 1 });
+        expect(!processor.setRoutingGraph(duplicate));
+        expect(processor.getRoutingGraph() == SlotRoutingGraph::serial());
+    }
+
+    // Two dry branches: the merge is the sum of the branch gains
+    void testMergeGain() {
+        ChimeraAudioProcessor processor;
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+
+        SlotRoutingGraph graph;
+        expect(SlotRoutingGraph::fromString("[@0.25|@0.25]", graph));
+        expect(processor.setRoutingGraph(graph));
+
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        juce::MidiBuffer midi;
+        fillWithSine(buffer, 0);
+        const float inputSample = buffer.getSample(0, 10);
+
+        processor.processBlock(buffer, midi);
+        expectWithinAbsoluteError(buffer.getSample(0, 10), inputSample * 0.5f, 1.0e-6f);
+    }
+
+    void testParallelMatchesSerial() {
+        SlotRoutingGraph graph;
+        expect(SlotRoutingGraph::fromString("0>[1@0.5|2@0.5|3,4@0.5]>5", graph));
+
+        auto serial = render(graph, false);
+        auto parallel = render(graph, true);
+
+        float maxDifference = 0.0f;
+        for (int ch = 0; ch < serial.getNumChannels(); ++ch)
+            for (int i = 0; i < serial.getNumSamples(); ++i)
+                maxDifference = juce::jmax(maxDifference, std::abs(serial.getSample(ch, i) - parallel.getSample(ch, i)));
+
+        expectEquals(maxDifference, 0.0f, "Parallel branches changed the output");
+    }
+
+    juce::AudioBuffer<float> render(const SlotRoutingGraph& graph, bool parallel) {
+        ChimeraAudioProcessor processor;
+        processor.setParallelProcessingEnabled(parallel);
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+
+        const int engines[] = { ENGINE_GAIN_UTILITY, ENGINE_MID_SIDE_PROCESSOR, ENGINE_GAIN_UTILITY,
+                                ENGINE_MONO_MAKER, ENGINE_GAIN_UTILITY, ENGINE_MID_SIDE_PROCESSOR };
+        for (int slot = 0; slot < CHIMERA_NUM_SLOTS; ++slot)
+            processor.setSlotEngine(slot, engines[slot]);
+        processor.setRoutingGraph(graph);
+
+        juce::AudioBuffer<float> output(2, kBlockSize * kNumBlocks);
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        juce::MidiBuffer midi;
+        for (int b = 0; b < kNumBlocks; ++b) {
+            fillWithSine(buffer, b);
+            processor.processBlock(buffer, midi);
+            for (int ch = 0; ch < 2; ++ch)
+                output.copyFrom(ch, b * kBlockSize, buffer, ch, 0, kBlockSize);
+        }
+        return output;
+    }
+
+    void fillWithSine(juce::AudioBuffer<float>& buffer, int blockIndex) {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+            auto* data = buffer.getWritePointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i) {
+                const double t = (blockIndex * buffer.getNumSamples() + i) / kSampleRate;
+                data[i] = 0.25f * static_cast<float>(std::sin(2.0 * juce::MathConstants<double>::pi * (220.0 + 110.0 * ch) * t));
+            }
+        }
+    }
+};
+
+// Register the test
+static SlotRoutingGraphTest slotRoutingGraphTest;
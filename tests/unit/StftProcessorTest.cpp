@@ -0,0 +1,172 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/StftProcessor.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks the spectral engines' shared STFT: with the bins left alone every
+ * frame size and overlap reconstructs the input exactly one frame late,
+ * whatever the host block size, the kernel runs once per hop, frames it
+ * drops are left out of the output, changing the overlap mid-stream settles
+ * back to exact reconstruction, and processing never allocates.
+ */
+class StftProcessorTest : public juce::UnitTest {
+public:
+    StftProcessorTest() : UnitTest("STFT Processor Test", "RealTime") {}
+
+    void runTest() override {
+        for (int order : { 9, 11 }) {
+            for (int overlap : { 2, 4, 8 }) {
+                beginTest("Reconstructs the input: " + juce::String(1 << order) + "-point frames, overlap "
+                          + juce::String(overlap));
+                testReconstruction(order, overlap);
+            }
+        }
+
+        beginTest("Kernel runs once per hop");
+        testKernelCalls();
+
+        beginTest("Dropped frames are left out");
+        testDroppedFrames();
+
+        beginTest("Changing the overlap settles");
+        testOverlapChange();
+
+        beginTest("Processing does not allocate");
+        testNoAllocation();
+    }
+
+private:
+    static constexpr int kNumSamples = 20000;
+
+    static std::vector<float> noise(int length, juce::Random& random) {
+        std::vector<float> x((size_t) length);
+        for (auto& sample : x)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+        return x;
+    }
+
+    // Irregular host blocks, in place, through an untouched spectrum
+    static std::vector<float> run(StftProcessor& stft, const std::vector<float>& input, juce::Random& random,
+                                  int channel = 0) {
+        std::vector<float> output(input);
+        for (int start = 0; start < (int) output.size();) {
+            const int n = std::min((int) output.size() - start, 1 + random.nextInt(700));
+            stft.process(channel, output.data() + start, output.data() + start, n,
+                         [] (std::complex<float>*, int) {});
+            start += n;
+        }
+        return output;
+    }
+
+    // Largest difference from the input delayed by latency, over [from, end)
+    static float maxErrorAgainstDelayed(const std::vector<float>& input, const std::vector<float>& output,
+                                        int latency, int from) {
+        float maxError = 0.0f;
+        for (int t = std::max(from, latency); t < (int) output.size(); ++t)
+            maxError = std::max(maxError, std::abs(output[(size_t) t] - input[(size_t) (t - latency)]));
+        return maxError;
+    }
+
+    void testReconstruction(int order, int overlap) {
+        juce::Random random(order * 10 + overlap);
+        const auto input = noise(kNumSamples, random);
+
+        StftProcessor stft;
+        stft.prepare(2, order, overlap);
+        expectEquals(stft.getFftSize(), 1 << order);
+        expectEquals(stft.getHopSize(), (1 << order) / overlap);
+        expectEquals(stft.getLatencySamples(), 1 << order);
+
+        // Both channels, interleaved block by block, with their own state
+        const auto left = run(stft, input, random, 0);
+        const auto right = run(stft, input, random, 1);
+
+        // Exact from the first sample out: the history starts as silence
+        const float errorL = maxErrorAgainstDelayed(input, left, stft.getLatencySamples(), 0);
+        const float errorR = maxErrorAgainstDelayed(input, right, stft.getLatencySamples(), 0);
+        expect(errorL < 1.0e-4f, "Left error " + juce::String(errorL));
+        expect(errorR < 1.0e-4f, "Right error " + juce::String(errorR));
+    }
+
+    void testKernelCalls() {
+        StftProcessor stft;
+        stft.prepare(1, 10, 4);
+
+        std::vector<float> buffer(5000, 0.0f);
+        int calls = 0, bins = 0;
+        stft.process(0, buffer.data(), buffer.data(), (int) buffer.size(),
+                     [&] (std::complex<float>*, int numBins) { ++calls; bins = numBins; });
+
+        expectEquals(calls, 5000 / 256);
+        expectEquals(bins, 513);
+    }
+
+    void testDroppedFrames() {
+        juce::Random random(3);
+        const auto input = noise(kNumSamples, random);
+
+        StftProcessor stft;
+        stft.prepare(1, 10, 4);
+
+        // Every frame dropped: nothing reaches the output
+        std::vector<float> output(input);
+        stft.process(0, output.data(), output.data(), (int) output.size(),
+                     [] (std::complex<float>*, int) { return false; });
+
+        float peak = 0.0f;
+        for (float sample : output)
+            peak = std::max(peak, std::abs(sample));
+        expectEquals(peak, 0.0f);
+    }
+
+    void testOverlapChange() {
+        juce::Random random(4);
+        const auto input = noise(kNumSamples, random);
+
+        StftProcessor stft;
+        stft.prepare(1, 10, 4);
+
+        std::vector<float> output(input);
+        const int switchAt = 6000;
+        stft.process(0, output.data(), output.data(), switchAt, [] (std::complex<float>*, int) {});
+
+        AllocationTracker::ScopedAllocationCheck check;
+        stft.setOverlap(StftProcessor::overlapForQuality(EngineBase::Quality::Draft));
+        stft.process(0, output.data() + switchAt, output.data() + switchAt, kNumSamples - switchAt,
+                     [] (std::complex<float>*, int) {});
+        expectEquals((int) check.getCount(), 0);
+
+        expectEquals(stft.getOverlap(), 2);
+        expectEquals(stft.getLatencySamples(), 1024);
+
+        const float before = maxErrorAgainstDelayed(input, std::vector<float>(output.begin(), output.begin() + switchAt),
+                                                    1024, 0);
+        const float after = maxErrorAgainstDelayed(input, output, 1024, switchAt + 2 * 1024);
+        expect(before < 1.0e-4f, "Error before the switch " + juce::String(before));
+        expect(after < 1.0e-4f, "Error once settled " + juce::String(after));
+    }
+
+    void testNoAllocation() {
+        juce::Random random(5);
+        StftProcessor stft;
+        stft.prepare(2, 11, 4);
+
+        std::vector<float> buffer(256);
+        AllocationTracker::ScopedAllocationCheck check;
+        for (int block = 0; block < 200; ++block) {
+            for (int ch = 0; ch < 2; ++ch) {
+                for (auto& sample : buffer)
+                    sample = random.nextFloat() - 0.5f;
+                stft.process(ch, buffer.data(), buffer.data(), (int) buffer.size(),
+                             [] (std::complex<float>* bins, int numBins) {
+                                 for (int k = numBins / 2; k < numBins; ++k)
+                                     bins[k] *= 0.5f;
+                             });
+            }
+        }
+        expectEquals((int) check.getCount(), 0);
+    }
+};
+
+// Register the test
+static StftProcessorTest stftProcessorTest;
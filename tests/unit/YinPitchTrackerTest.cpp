@@ -0,0 +1,190 @@
+#include <JuceHeader.h>
+#include "../../JUCE_Plugin/Source/YinPitchTracker.h"
+#include "AllocationTracker.h"
+
+/**
+ * Checks the FFT-based YIN tracker: it finds the fundamental of pure and
+ * harmonic tones, agrees with YIN's difference function summed directly,
+ * only moves its estimate on hop boundaries, gives the same answers fed a
+ * sample or a block at a time, holds through noise, and never allocates.
+ */
+class YinPitchTrackerTest : public juce::UnitTest {
+public:
+    YinPitchTrackerTest() : UnitTest("YIN Pitch Tracker Test", "RealTime") {}
+
+    void runTest() override {
+        for (double sampleRate : { 44100.0, 48000.0 }) {
+            beginTest("Finds the fundamental at " + juce::String(sampleRate / 1000.0, 1) + " kHz");
+            for (double frequency : { 110.0, 220.0, 440.0, 1000.0 })
+                testTone(sampleRate, frequency);
+        }
+
+        beginTest("Agrees with the direct difference function");
+        for (double frequency : { 130.0, 310.0, 777.0 })
+            testAgainstDirect(frequency);
+
+        beginTest("Updates once per hop");
+        testHopSchedule();
+
+        beginTest("Block and per-sample pushes agree");
+        testBlockPush();
+
+        beginTest("Noise leaves the estimate alone");
+        testNoise();
+
+        beginTest("Tracking does not allocate");
+        testNoAllocation();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+
+    // A few harmonics falling off, so the octave below is a tempting wrong answer
+    static std::vector<float> tone(double frequency, double sampleRate, int length, int harmonics = 4) {
+        std::vector<float> x((size_t) length, 0.0f);
+        for (int h = 1; h <= harmonics; ++h)
+            for (int i = 0; i < length; ++i)
+                x[(size_t) i] += (0.5f / (float) h)
+                               * (float) std::sin(juce::MathConstants<double>::twoPi * h * frequency * i / sampleRate);
+        return x;
+    }
+
+    // YIN with the difference function summed directly, as the ring
+    // modulator used to run it, on the newest WINDOW_SIZE samples
+    static float directYin(const float* newestLast, double sampleRate) {
+        constexpr int W = YinPitchTracker::WINDOW_SIZE, H = YinPitchTracker::MAX_LAG;
+        const float* x = newestLast - W + 1;  // oldest first
+
+        std::vector<float> d((size_t) H, 0.0f);
+        for (int tau = 0; tau < H; ++tau)
+            for (int k = H; k < W; ++k)
+                d[(size_t) tau] += (x[k] - x[k - tau]) * (x[k] - x[k - tau]);
+
+        float sum = 0.0f;
+        d[0] = 1.0f;
+        for (int tau = 1; tau < H; ++tau) {
+            sum += d[(size_t) tau];
+            d[(size_t) tau] = sum <= 1.0e-20f ? 1.0f : d[(size_t) tau] * (float) tau / sum;
+        }
+
+        int best = -1;
+        for (int tau = 2; tau < H && best < 0; ++tau)
+            if (d[(size_t) tau] < YinPitchTracker::THRESHOLD)
+                best = tau;
+        if (best < 0)
+            return 0.0f;
+        while (best + 1 < H && d[(size_t) best + 1] < d[(size_t) best])
+            ++best;
+
+        const float s0 = d[(size_t) best - 1], s1 = d[(size_t) best], s2 = d[(size_t) best + 1];
+        const float period = (float) best + 0.5f * (s0 - s2) / (s0 + s2 - 2.0f * s1);
+        return (float) (sampleRate / period);
+    }
+
+    void testTone(double sampleRate, double frequency) {
+        YinPitchTracker tracker;
+        tracker.prepare(sampleRate);
+
+        const auto x = tone(frequency, sampleRate, (int) sampleRate / 2);
+        tracker.push(x.data(), (int) x.size());
+
+        const float error = std::abs(tracker.getFrequency() / (float) frequency - 1.0f);
+        expect(error < 0.005f, juce::String(frequency) + " Hz read as " + juce::String(tracker.getFrequency()));
+        expect(tracker.getConfidence() > 0.85f, "Confidence " + juce::String(tracker.getConfidence()));
+    }
+
+    void testAgainstDirect(double frequency) {
+        juce::Random random((int) frequency);
+        auto x = tone(frequency, kSampleRate, YinPitchTracker::WINDOW_SIZE * 4, 6);
+        for (auto& sample : x)
+            sample += 0.05f * (random.nextFloat() - 0.5f);
+
+        // A whole number of hops, so the last analysis ends on the last sample
+        YinPitchTracker tracker;
+        tracker.prepare(kSampleRate);
+        tracker.push(x.data(), (int) x.size());
+
+        const float direct = directYin(x.data() + x.size() - 1, kSampleRate);
+        expect(std::abs(tracker.getFrequency() - direct) < 0.001f * direct,
+               "FFT " + juce::String(tracker.getFrequency(), 3) + " Hz, direct " + juce::String(direct, 3) + " Hz");
+    }
+
+    void testHopSchedule() {
+        YinPitchTracker tracker;
+        tracker.prepare(kSampleRate, 100);
+
+        // A glide, so every analysis has something new to say
+        std::vector<float> x(20000);
+        double phase = 0.0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            phase += juce::MathConstants<double>::twoPi * (200.0 + 0.02 * (double) i) / kSampleRate;
+            x[i] = 0.5f * (float) std::sin(phase);
+        }
+
+        float last = tracker.getFrequency();
+        int changes = 0;
+        bool offHop = false;
+        for (size_t i = 0; i < x.size(); ++i) {
+            const float estimate = tracker.push(x[i]);
+            if (estimate != last) {
+                ++changes;
+                offHop = offHop || ((i + 1) % 100) != 0;
+                last = estimate;
+            }
+        }
+        expect(! offHop, "Estimate moved between hops");
+        expect(changes > 150 && changes <= (int) x.size() / 100, juce::String(changes) + " updates");
+    }
+
+    void testBlockPush() {
+        const auto x = tone(247.0, kSampleRate, 30000);
+
+        YinPitchTracker bySample, byBlock;
+        bySample.prepare(kSampleRate, 192);
+        byBlock.prepare(kSampleRate, 192);
+
+        juce::Random random(5);
+        for (size_t start = 0; start < x.size();) {
+            const size_t n = std::min(x.size() - start, (size_t) (1 + random.nextInt(600)));
+            byBlock.push(x.data() + start, (int) n);
+            for (size_t i = start; i < start + n; ++i)
+                bySample.push(x[i]);
+            start += n;
+            expectEquals(byBlock.getFrequency(), bySample.getFrequency());
+        }
+    }
+
+    void testNoise() {
+        YinPitchTracker tracker;
+        tracker.prepare(kSampleRate);
+
+        const auto x = tone(330.0, kSampleRate, 8192);
+        tracker.push(x.data(), (int) x.size());
+        const float voiced = tracker.getFrequency();
+
+        juce::Random random(6);
+        std::vector<float> noise(8192);
+        for (auto& sample : noise)
+            sample = random.nextFloat() - 0.5f;
+        tracker.push(noise.data(), (int) noise.size());
+
+        expectEquals(tracker.getFrequency(), voiced);
+        expectEquals(tracker.getConfidence(), 0.0f);
+    }
+
+    void testNoAllocation() {
+        YinPitchTracker tracker;
+        tracker.prepare(kSampleRate);
+        const auto x = tone(196.0, kSampleRate, 20000);
+
+        AllocationTracker::ScopedAllocationCheck check;
+        for (float sample : x)
+            tracker.push(sample);
+        tracker.reset();
+        tracker.push(x.data(), (int) x.size());
+        expectEquals((int) check.getCount(), 0);
+    }
+};
+
+// Register the test
+static YinPitchTrackerTest yinPitchTrackerTest;